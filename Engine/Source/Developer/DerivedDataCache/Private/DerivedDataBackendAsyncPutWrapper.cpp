@@ -190,6 +190,29 @@ bool FDerivedDataBackendAsyncPutWrapper::GetCachedData(const TCHAR* CacheKey, TA
 	return bSuccess;
 }
 
+void FDerivedDataBackendAsyncPutWrapper::GetCachedDataBatch(TArrayView<const FString> CacheKeys, TArrayView<TArray<uint8>> OutData, TBitArray<>& OutHits)
+{
+	COOK_STAT(auto Timer = UsageStats.TimeGet());
+	COOK_STAT(Timer.TrackCyclesOnly());
+	const TBitArray<> HitsBefore = OutHits;
+
+	// Keys still in flight are served from memory, the rest goes to the inner backend in one batch
+	if (InflightCache)
+	{
+		InflightCache->GetCachedDataBatch(CacheKeys, OutData, OutHits);
+	}
+	InnerBackend->GetCachedDataBatch(CacheKeys, OutData, OutHits);
+
+	for (int32 Index = 0; Index < CacheKeys.Num(); Index++)
+	{
+		if (!HitsBefore[Index])
+		{
+			UE_LOG(LogDerivedDataCache, Verbose, TEXT("%s Cache %s on %s"), *GetName(), OutHits[Index] ? TEXT("hit") : TEXT("miss"), *CacheKeys[Index]);
+			COOK_STAT(UsageStats.AddGetHitOrMiss(OutHits[Index], OutHits[Index] ? OutData[Index].Num() : 0));
+		}
+	}
+}
+
 void FDerivedDataBackendAsyncPutWrapper::PutCachedData(const TCHAR* CacheKey, TArrayView<const uint8> InData, bool bPutEvenIfExists)
 {
 	COOK_STAT(auto Timer = PutSyncUsageStats.TimePut());
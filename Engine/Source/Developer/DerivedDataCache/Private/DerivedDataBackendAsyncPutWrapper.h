@@ -104,6 +104,7 @@ public:
 	 * @return				true if any data was found, and in this case OutData is non-empty
 	 */
 	virtual bool GetCachedData(const TCHAR* CacheKey, TArray<uint8>& OutData) override;
+	virtual void GetCachedDataBatch(TArrayView<const FString> CacheKeys, TArrayView<TArray<uint8>> OutData, TBitArray<>& OutHits) override;
 
 	/**
 	 * Asynchronous, fire-and-forget placement of a cache item
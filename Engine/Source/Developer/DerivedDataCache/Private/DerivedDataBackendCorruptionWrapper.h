@@ -125,36 +125,7 @@ public:
 	virtual bool GetCachedData(const TCHAR* CacheKey, TArray<uint8>& OutData) override
 	{
 		COOK_STAT(auto Timer = UsageStats.TimeGet());
-		bool bOk = InnerBackend->GetCachedData(CacheKey, OutData);
-		if (bOk)
-		{
-			if (OutData.Num() < sizeof(FDerivedDataTrailer))
-			{
-				UE_LOG(LogDerivedDataCache, Display, TEXT("FDerivedDataBackendCorruptionWrapper: Corrupted file (short), ignoring and deleting %s."),CacheKey);
-				bOk	= false;
-			}
-			else
-			{
-				FDerivedDataTrailer Trailer;
-				FMemory::Memcpy(&Trailer,&OutData[OutData.Num() - sizeof(FDerivedDataTrailer)], sizeof(FDerivedDataTrailer));
-				OutData.RemoveAt(OutData.Num() - sizeof(FDerivedDataTrailer),sizeof(FDerivedDataTrailer), false);
-				FDerivedDataTrailer RecomputedTrailer(OutData);
-				if (Trailer == RecomputedTrailer)
-				{
-					UE_LOG(LogDerivedDataCache, VeryVerbose, TEXT("FDerivedDataBackendCorruptionWrapper: cache hit, footer is ok %s"),CacheKey);
-				}
-				else
-				{
-					UE_LOG(LogDerivedDataCache, Display, TEXT("FDerivedDataBackendCorruptionWrapper: Corrupted file, ignoring and deleting %s."),CacheKey);
-					bOk	= false;
-				}
-			}
-			if (!bOk)
-			{
-				// _we_ detected corruption, so _we_ will force a flush of the corrupted data
-				InnerBackend->RemoveCachedData(CacheKey, /*bTransient=*/ false);
-			}
-		}
+		bool bOk = InnerBackend->GetCachedData(CacheKey, OutData) && VerifyAndStripTrailer(CacheKey, OutData);
 		if (!bOk)
 		{
 			OutData.Empty();
@@ -165,6 +136,30 @@ public:
 		}
 		return bOk;
 	}
+
+	virtual void GetCachedDataBatch(TArrayView<const FString> CacheKeys, TArrayView<TArray<uint8>> OutData, TBitArray<>& OutHits) override
+	{
+		COOK_STAT(auto Timer = UsageStats.TimeGet());
+		COOK_STAT(Timer.TrackCyclesOnly());
+		const TBitArray<> HitsBefore = OutHits;
+		InnerBackend->GetCachedDataBatch(CacheKeys, OutData, OutHits);
+		for (int32 Index = 0; Index < CacheKeys.Num(); Index++)
+		{
+			if (!HitsBefore[Index])
+			{
+				if (OutHits[Index] && !VerifyAndStripTrailer(*CacheKeys[Index], OutData[Index]))
+				{
+					OutHits[Index] = false;
+				}
+				if (!OutHits[Index])
+				{
+					OutData[Index].Empty();
+				}
+				COOK_STAT(UsageStats.AddGetHitOrMiss(OutHits[Index], OutData[Index].Num()));
+			}
+		}
+	}
+
 	/**
 	 * Asynchronous, fire-and-forget placement of a cache item
 	 *
@@ -229,6 +224,39 @@ public:
 	}
 
 private:
+	/** Checks and removes the trailer of data returned by the inner backend, removing corrupted entries from it */
+	bool VerifyAndStripTrailer(const TCHAR* CacheKey, TArray<uint8>& Data)
+	{
+		bool bOk = true;
+		if (Data.Num() < sizeof(FDerivedDataTrailer))
+		{
+			UE_LOG(LogDerivedDataCache, Display, TEXT("FDerivedDataBackendCorruptionWrapper: Corrupted file (short), ignoring and deleting %s."),CacheKey);
+			bOk	= false;
+		}
+		else
+		{
+			FDerivedDataTrailer Trailer;
+			FMemory::Memcpy(&Trailer,&Data[Data.Num() - sizeof(FDerivedDataTrailer)], sizeof(FDerivedDataTrailer));
+			Data.RemoveAt(Data.Num() - sizeof(FDerivedDataTrailer),sizeof(FDerivedDataTrailer), false);
+			FDerivedDataTrailer RecomputedTrailer(Data);
+			if (Trailer == RecomputedTrailer)
+			{
+				UE_LOG(LogDerivedDataCache, VeryVerbose, TEXT("FDerivedDataBackendCorruptionWrapper: cache hit, footer is ok %s"),CacheKey);
+			}
+			else
+			{
+				UE_LOG(LogDerivedDataCache, Display, TEXT("FDerivedDataBackendCorruptionWrapper: Corrupted file, ignoring and deleting %s."),CacheKey);
+				bOk	= false;
+			}
+		}
+		if (!bOk)
+		{
+			// _we_ detected corruption, so _we_ will force a flush of the corrupted data
+			InnerBackend->RemoveCachedData(CacheKey, /*bTransient=*/ false);
+		}
+		return bOk;
+	}
+
 	FDerivedDataCacheUsageStats UsageStats;
 
 	/** Backend to use for storage, my responsibilities are about corruption **/
@@ -318,6 +318,46 @@ class FDerivedDataCache : public FDerivedDataCacheInterface
 		TArray<uint8>					Data;
 	};
 
+	/** Async worker that runs the highest priority batch waiting, which is not necessarily the batch it was started for **/
+	friend class FBatchGetWorker;
+	class FBatchGetWorker : public FNonAbandonableTask
+	{
+	public:
+		FBatchGetWorker(FDerivedDataCache& InCache)
+		: Cache(InCache)
+		{
+		}
+
+		void DoWork()
+		{
+			Cache.ExecuteNextBatch();
+		}
+
+		FORCEINLINE TStatId GetStatId() const
+		{
+			RETURN_QUICK_DECLARE_CYCLE_STAT(FBatchGetWorker, STATGROUP_ThreadPoolAsyncTasks);
+		}
+
+	private:
+		FDerivedDataCache& Cache;
+	};
+
+	/** Batch request waiting for a worker **/
+	struct FPendingBatch
+	{
+		TArray<FString>		CacheKeys;
+		FOnGetBatchComplete	OnComplete;
+		EPriority			Priority = EPriority::Normal;
+		/** Keeps batches of the same priority in submission order **/
+		uint32				Sequence = 0;
+
+		/** The top of the heap is the batch to run next **/
+		bool operator<(const FPendingBatch& Other) const
+		{
+			return Priority != Other.Priority ? Priority > Other.Priority : Sequence < Other.Sequence;
+		}
+	};
+
 public:
 
 	/** Constructor, called once to cereate a singleton **/
@@ -341,6 +381,12 @@ public:
 			delete It.Value();
 		}
 		PendingTasks.Empty();
+
+		// Batch workers delete themselves, but they still reference the cache until they are done
+		while (NumBatchWorkers.GetValue() > 0)
+		{
+			FPlatformProcess::Sleep(0.001f);
+		}
 	}
 
 	virtual bool GetSynchronous(FDerivedDataPluginInterface* DataDeriver, TArray<uint8>& OutData, bool* bDataWasBuilt = nullptr) override
@@ -505,6 +551,66 @@ public:
 		return bResult;
 	}
 
+	virtual int32 GetSynchronousBatch(TArrayView<const FString> CacheKeys, TArray<TArray<uint8>>& OutData, FStringView DataContext) override
+	{
+		DDC_SCOPE_CYCLE_COUNTER(DDC_GetSynchronousBatch);
+		UE_LOG(LogDerivedDataCache, VeryVerbose, TEXT("GetSynchronousBatch %d keys from '%.*s'"), CacheKeys.Num(), DataContext.Len(), DataContext.GetData());
+		for (const FString& CacheKey : CacheKeys)
+		{
+			ValidateCacheKey(*CacheKey);
+		}
+		int32 NumHits;
+		STAT(double ThisTime = 0);
+		{
+			SCOPE_SECONDS_COUNTER(ThisTime);
+			NumHits = GetBatch(CacheKeys, OutData);
+		}
+		INC_FLOAT_STAT_BY(STAT_DDC_SyncGetTime, (float)ThisTime);
+		return NumHits;
+	}
+
+	virtual void GetAsynchronousBatch(TArrayView<const FString> CacheKeys, FStringView DataContext, EPriority Priority, FOnGetBatchComplete&& OnComplete) override
+	{
+		DDC_SCOPE_CYCLE_COUNTER(DDC_GetAsynchronousBatch);
+		UE_LOG(LogDerivedDataCache, VeryVerbose, TEXT("GetAsynchronousBatch %d keys from '%.*s'"), CacheKeys.Num(), DataContext.Len(), DataContext.GetData());
+		FPendingBatch Batch;
+		Batch.CacheKeys = TArray<FString>(CacheKeys.GetData(), CacheKeys.Num());
+		Batch.OnComplete = MoveTemp(OnComplete);
+		Batch.Priority = Priority;
+		for (const FString& CacheKey : Batch.CacheKeys)
+		{
+			ValidateCacheKey(*CacheKey);
+		}
+
+		AddToAsyncCompletionCounter(1);
+		NumBatchWorkers.Increment();
+		{
+			FScopeLock ScopeLock(&BatchSynchronizationObject);
+			Batch.Sequence = NextBatchSequence++;
+			PendingBatches.HeapPush(MoveTemp(Batch));
+		}
+		(new FAutoDeleteAsyncTask<FBatchGetWorker>(*this))->StartBackgroundTask();
+	}
+
+	virtual void PutBatch(TArrayView<const FString> CacheKeys, TArrayView<const TArray<uint8>> Data, FStringView DataContext, bool bPutEvenIfExists = false) override
+	{
+		DDC_SCOPE_CYCLE_COUNTER(DDC_PutBatch);
+		check(CacheKeys.Num() == Data.Num());
+		UE_LOG(LogDerivedDataCache, VeryVerbose, TEXT("PutBatch %d keys from '%.*s'"), CacheKeys.Num(), DataContext.Len(), DataContext.GetData());
+		// The root backend queues puts on its own, so there is nothing to gain from handing it the whole batch
+		STAT(double ThisTime = 0);
+		{
+			SCOPE_SECONDS_COUNTER(ThisTime);
+			for (int32 Index = 0; Index < CacheKeys.Num(); Index++)
+			{
+				ValidateCacheKey(*CacheKeys[Index]);
+				FDerivedDataBackend::Get().GetRoot().PutCachedData(*CacheKeys[Index], Data[Index], bPutEvenIfExists);
+			}
+		}
+		INC_FLOAT_STAT_BY(STAT_DDC_PutTime,(float)ThisTime);
+		INC_DWORD_STAT_BY(STAT_DDC_NumPuts, CacheKeys.Num());
+	}
+
 	void NotifyBootComplete() override
 	{
 		DDC_SCOPE_CYCLE_COUNTER(DDC_NotifyBootComplete);
@@ -584,6 +690,51 @@ private:
 		return Result;
 	}
 
+	/** Gets a batch of keys from the backends, leaving the buffers of the keys that were not found empty **/
+	static int32 GetBatch(TArrayView<const FString> CacheKeys, TArray<TArray<uint8>>& OutData)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(DDC_GetBatch);
+		INC_DWORD_STAT_BY(STAT_DDC_NumGets, CacheKeys.Num());
+
+		OutData.Reset(CacheKeys.Num());
+		OutData.SetNum(CacheKeys.Num());
+		TBitArray<> Hits(false, CacheKeys.Num());
+		FDerivedDataBackend::Get().GetRoot().GetCachedDataBatch(CacheKeys, OutData, Hits);
+
+		int32 NumHits = 0;
+		for (int32 Index = 0; Index < CacheKeys.Num(); Index++)
+		{
+			if (Hits[Index])
+			{
+				check(OutData[Index].Num());
+				NumHits++;
+			}
+			else
+			{
+				OutData[Index].Empty();
+			}
+		}
+		return NumHits;
+	}
+
+	/** Runs the highest priority batch that is waiting, called once by every batch worker **/
+	void ExecuteNextBatch()
+	{
+		FPendingBatch Batch;
+		{
+			FScopeLock ScopeLock(&BatchSynchronizationObject);
+			check(PendingBatches.Num());
+			PendingBatches.HeapPop(Batch, /*bAllowShrinking=*/ false);
+		}
+
+		TArray<TArray<uint8>> Results;
+		GetBatch(Batch.CacheKeys, Results);
+		Batch.OnComplete(MoveTemp(Results));
+
+		AddToAsyncCompletionCounter(-1);
+		NumBatchWorkers.Decrement();
+	}
+
 	static void ValidateCacheKey(const TCHAR* CacheKey)
 	{
 		checkf(Algo::AllOf(FStringView(CacheKey), [](TCHAR C) { return FChar::IsAlnum(C) || FChar::IsUnderscore(C) || C == TEXT('$'); }),
@@ -597,6 +748,15 @@ private:
 	/** Map of handle to pending task **/
 	TMap<uint32,FAsyncTask<FBuildAsyncWorker>*>	PendingTasks;
 
+	/** Object used to synchronize access to the pending batches **/
+	FCriticalSection			BatchSynchronizationObject;
+	/** Heap of batches waiting for a worker, highest priority first **/
+	TArray<FPendingBatch>		PendingBatches;
+	/** Sequence number of the next batch **/
+	uint32						NextBatchSequence = 0;
+	/** Number of batch workers that have been started and not finished **/
+	FThreadSafeCounter			NumBatchWorkers;
+
 	/** Cache notification delegate */
 	FOnDDCNotification DDCNotificationEvent;
 };
@@ -117,35 +117,7 @@ public:
 		}
 		else
 		{
-			bOk = InnerBackend->GetCachedData(*NewKey, OutData);
-			if (bOk)
-			{
-				int32 KeyLen = FCString::Strlen(CacheKey) + 1;
-				if (OutData.Num() < KeyLen)
-				{
-					UE_LOG(LogDerivedDataCache, Display, TEXT("FDerivedDataLimitKeyLengthWrapper: Short file or Hash Collision, ignoring and deleting %s."), CacheKey);
-					bOk	= false;
-				}
-				else
-				{
-					int32 Compare = FCStringAnsi::Strcmp(TCHAR_TO_ANSI(CacheKey), (char*)&OutData[OutData.Num() - KeyLen]);
-					OutData.RemoveAt(OutData.Num() - KeyLen, KeyLen);
-					if (Compare == 0)
-					{
-						UE_LOG(LogDerivedDataCache, VeryVerbose, TEXT("FDerivedDataLimitKeyLengthWrapper: cache hit, key match is ok %s"), CacheKey);
-					}
-					else
-					{
-						UE_LOG(LogDerivedDataCache, Warning, TEXT("FDerivedDataLimitKeyLengthWrapper: HASH COLLISION, ignoring and deleting %s."), CacheKey);
-						bOk	= false;
-					}
-				}
-				if (!bOk)
-				{
-					// _we_ detected corruption, so _we_ will force a flush of the corrupted data
-					InnerBackend->RemoveCachedData(*NewKey, /*bTransient=*/ false);
-				}
-			}
+			bOk = InnerBackend->GetCachedData(*NewKey, OutData) && VerifyAndStripKey(CacheKey, *NewKey, OutData);
 		}
 		if (!bOk)
 		{
@@ -157,6 +129,39 @@ public:
 		}
 		return bOk;
 	}
+
+	virtual void GetCachedDataBatch(TArrayView<const FString> CacheKeys, TArrayView<TArray<uint8>> OutData, TBitArray<>& OutHits) override
+	{
+		COOK_STAT(auto Timer = UsageStats.TimeGet());
+		COOK_STAT(Timer.TrackCyclesOnly());
+		const TBitArray<> HitsBefore = OutHits;
+
+		TArray<FString> NewKeys;
+		TBitArray<> Shortened(false, CacheKeys.Num());
+		NewKeys.Reserve(CacheKeys.Num());
+		for (int32 Index = 0; Index < CacheKeys.Num(); Index++)
+		{
+			Shortened[Index] = ShortenKey(*CacheKeys[Index], NewKeys.AddDefaulted_GetRef());
+		}
+
+		InnerBackend->GetCachedDataBatch(NewKeys, OutData, OutHits);
+		for (int32 Index = 0; Index < CacheKeys.Num(); Index++)
+		{
+			if (!HitsBefore[Index])
+			{
+				if (OutHits[Index] && Shortened[Index] && !VerifyAndStripKey(*CacheKeys[Index], *NewKeys[Index], OutData[Index]))
+				{
+					OutHits[Index] = false;
+				}
+				if (!OutHits[Index])
+				{
+					OutData[Index].Empty();
+				}
+				COOK_STAT(UsageStats.AddGetHitOrMiss(OutHits[Index], OutData[Index].Num()));
+			}
+		}
+	}
+
 	/**
 	 * Asynchronous, fire-and-forget placement of a cache item
 	 *
@@ -212,6 +217,38 @@ public:
 	}
 
 private:
+	/** Checks and removes the full key appended to data stored under a shortened key, removing collisions from the inner backend */
+	bool VerifyAndStripKey(const TCHAR* CacheKey, const TCHAR* NewKey, TArray<uint8>& Data)
+	{
+		bool bOk = true;
+		int32 KeyLen = FCString::Strlen(CacheKey) + 1;
+		if (Data.Num() < KeyLen)
+		{
+			UE_LOG(LogDerivedDataCache, Display, TEXT("FDerivedDataLimitKeyLengthWrapper: Short file or Hash Collision, ignoring and deleting %s."), CacheKey);
+			bOk	= false;
+		}
+		else
+		{
+			int32 Compare = FCStringAnsi::Strcmp(TCHAR_TO_ANSI(CacheKey), (char*)&Data[Data.Num() - KeyLen]);
+			Data.RemoveAt(Data.Num() - KeyLen, KeyLen);
+			if (Compare == 0)
+			{
+				UE_LOG(LogDerivedDataCache, VeryVerbose, TEXT("FDerivedDataLimitKeyLengthWrapper: cache hit, key match is ok %s"), CacheKey);
+			}
+			else
+			{
+				UE_LOG(LogDerivedDataCache, Warning, TEXT("FDerivedDataLimitKeyLengthWrapper: HASH COLLISION, ignoring and deleting %s."), CacheKey);
+				bOk	= false;
+			}
+		}
+		if (!bOk)
+		{
+			// _we_ detected corruption, so _we_ will force a flush of the corrupted data
+			InnerBackend->RemoveCachedData(NewKey, /*bTransient=*/ false);
+		}
+		return bOk;
+	}
+
 	FDerivedDataCacheUsageStats UsageStats;
 
 	/** Shorten the cache key and return true if shortening was required **/
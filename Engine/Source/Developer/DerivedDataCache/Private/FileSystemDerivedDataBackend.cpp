@@ -13,10 +13,12 @@
 #include "Misc/ScopeLock.h"
 #include "Async/TaskGraphInterfaces.h"
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
 
 #include "DerivedDataCacheInterface.h"
 #include "DerivedDataBackendInterface.h"
 #include "DDCCleanup.h"
+#include "PackedDerivedDataStore.h"
 
 #include "ProfilingDebugging/CookStats.h"
 #include "DerivedDataCacheUsageStats.h"
@@ -203,6 +205,22 @@ public:
 				}
 			}
 			
+			// Packed=true appends to large segment files instead of writing a file per key, see FPackedDerivedDataStore
+			if (GetParsedBool(InParams, TEXT("Packed=")))
+			{
+				FPackedDerivedDataStore::FParams PackedParams;
+				int32 SegmentSizeMB = 0;
+				if (FParse::Value(InParams, TEXT("SegmentSizeMB="), SegmentSizeMB))
+				{
+					PackedParams.SegmentSize = int64(SegmentSizeMB) * 1024 * 1024;
+				}
+				FParse::Value(InParams, TEXT("CompactAt="), PackedParams.CompactAt);
+				FParse::Bool(InParams, TEXT("Compact="), PackedParams.bCompact);
+				PackedParams.DaysToDeleteUnused = DaysToDeleteUnusedFiles;
+				PackedParams.bReadOnly = bReadOnly;
+				PackedStore = MakeUnique<FPackedDerivedDataStore>(CachePath / TEXT("Packed"), PackedParams);
+			}
+
 			if (IsUsable() && InAccessLogFileName != nullptr && *InAccessLogFileName != 0)
 			{
 				AccessLogWriter.Reset(new FAccessLogWriter(InAccessLogFileName));
@@ -492,21 +510,29 @@ public:
 			return false;
 		}
 
-		FString Filename = BuildFilename(CacheKey);
-
-		FFileStatData FileStat = IFileManager::Get().GetStatData(*Filename);
-
-		if (FileStat.bIsValid)
+		bool bExists = false;
+		if (PackedStore.IsValid())
+		{
+			// Refreshes old entries under the same conditions as the timestamp update below
+			bExists = PackedStore->Exists(CacheKey, bTouch);
+		}
+		else
 		{
-			FDateTime TimeStamp = FileStat.ModificationTime;
+			FString Filename = BuildFilename(CacheKey);
+
+			FFileStatData FileStat = IFileManager::Get().GetStatData(*Filename);
+			bExists = FileStat.bIsValid;
 
 			// Update file timestamp to prevent it from being deleted by DDC Cleanup.
-			if (bTouch || 
-				 (!bReadOnly && (FDateTime::UtcNow() - TimeStamp).GetDays() > (DaysToDeleteUnusedFiles / 4)))
+			if (FileStat.bIsValid && (bTouch ||
+				 (!bReadOnly && (FDateTime::UtcNow() - FileStat.ModificationTime).GetDays() > (DaysToDeleteUnusedFiles / 4))))
 			{
 				IFileManager::Get().SetTimeStamp(*Filename, FDateTime::UtcNow());
 			}
+		}
 
+		if (bExists)
+		{
 			if (AccessLogWriter.IsValid())
 			{
 				AccessLogWriter->Append(CacheKey);
@@ -516,7 +542,7 @@ public:
 		}
 
 		// If not using a shared cache, record a (probable) miss
-		if (!FileStat.bIsValid && !GetDerivedDataCacheRef().GetUsingSharedDDC())
+		if (!bExists && !GetDerivedDataCacheRef().GetUsingSharedDDC())
 		{
 			// store a cache miss
 			FScopeLock ScopeLock(&SynchronizationObject);
@@ -526,9 +552,9 @@ public:
 			}
 		}
 
-		UE_LOG(LogDerivedDataCache, Verbose, TEXT("%s CachedDataProbablyExists=%d for %s"), *GetName(), FileStat.bIsValid, CacheKey);
+		UE_LOG(LogDerivedDataCache, Verbose, TEXT("%s CachedDataProbablyExists=%d for %s"), *GetName(), bExists, CacheKey);
 
-		return FileStat.bIsValid;
+		return bExists;
 	}	
 
 	/**
@@ -553,7 +579,7 @@ public:
 			return false;
 		}
 
-		if (FFileHelper::LoadFileToArray(Data,*Filename,FILEREAD_Silent))
+		if (PackedStore.IsValid() ? PackedStore->Get(CacheKey, Data) : FFileHelper::LoadFileToArray(Data,*Filename,FILEREAD_Silent))
 		{
 			double ReadDuration = FPlatformTime::Seconds() - StartTime;
 			double ReadSpeed = (Data.Num() / ReadDuration) / (1024.0 * 1024.0);
@@ -591,6 +617,34 @@ public:
 		return false;
 	}
 
+	virtual void GetCachedDataBatch(TArrayView<const FString> CacheKeys, TArrayView<TArray<uint8>> OutData, TBitArray<>& OutHits) override
+	{
+		check(OutData.Num() == CacheKeys.Num() && OutHits.Num() == CacheKeys.Num());
+		TArray<int32> Pending;
+		Pending.Reserve(CacheKeys.Num());
+		for (int32 Index = 0; Index < CacheKeys.Num(); Index++)
+		{
+			if (!OutHits[Index])
+			{
+				Pending.Add(Index);
+			}
+		}
+
+		// Each get is dominated by the latency of opening the file, more so on a network share, so they are overlapped
+		TArray<bool> Hits;
+		Hits.SetNumZeroed(Pending.Num());
+		ParallelFor(Pending.Num(), [this, &Pending, &Hits, CacheKeys, OutData](int32 PendingIndex)
+		{
+			const int32 Index = Pending[PendingIndex];
+			Hits[PendingIndex] = GetCachedData(*CacheKeys[Index], OutData[Index]);
+		});
+
+		for (int32 PendingIndex = 0; PendingIndex < Pending.Num(); PendingIndex++)
+		{
+			OutHits[Pending[PendingIndex]] = Hits[PendingIndex];
+		}
+	}
+
 	/**
 	 * Would we cache this? Say yes so long as we aren't read-only.
 	 */
@@ -628,52 +682,59 @@ public:
 			{
 				COOK_STAT(Timer.AddHit(Data.Num()));
 				check(Data.Num());
-				FString Filename = BuildFilename(CacheKey);
-				FString TempFilename(TEXT("temp.")); 
-				TempFilename += FGuid::NewGuid().ToString();
-				TempFilename = FPaths::GetPath(Filename) / TempFilename;
-				bool bResult;
+				if (PackedStore.IsValid())
 				{
-					bResult = FFileHelper::SaveArrayToFile(Data, *TempFilename, &IFileManager::Get(), FILEWRITE_Silent);
+					PackedStore->Put(CacheKey, Data);
 				}
-				if (bResult)
+				else
 				{
-					if (IFileManager::Get().FileSize(*TempFilename) == Data.Num())
+					FString Filename = BuildFilename(CacheKey);
+					FString TempFilename(TEXT("temp.")); 
+					TempFilename += FGuid::NewGuid().ToString();
+					TempFilename = FPaths::GetPath(Filename) / TempFilename;
+					bool bResult;
 					{
-						bool DoMove = !CachedDataProbablyExists(CacheKey);
-						if (bPutEvenIfExists && !DoMove)
-						{
-							DoMove = true;
-							RemoveCachedData(CacheKey, /*bTransient=*/ false);
-						}
-						if (DoMove) 
+						bResult = FFileHelper::SaveArrayToFile(Data, *TempFilename, &IFileManager::Get(), FILEWRITE_Silent);
+					}
+					if (bResult)
+					{
+						if (IFileManager::Get().FileSize(*TempFilename) == Data.Num())
 						{
-							if (!IFileManager::Get().Move(*Filename, *TempFilename, true, true, false, true))
+							bool DoMove = !CachedDataProbablyExists(CacheKey);
+							if (bPutEvenIfExists && !DoMove)
 							{
-								UE_LOG(LogDerivedDataCache, Log, TEXT("%s: Move collision, attempt at redundant update, OK %s."), *GetName(),*Filename);
+								DoMove = true;
+								RemoveCachedData(CacheKey, /*bTransient=*/ false);
 							}
-							else
+							if (DoMove) 
 							{
-								UE_LOG(LogDerivedDataCache, Verbose, TEXT("%s: Successful cache put of %s to %s"),*GetName(), CacheKey, *Filename);
+								if (!IFileManager::Get().Move(*Filename, *TempFilename, true, true, false, true))
+								{
+									UE_LOG(LogDerivedDataCache, Log, TEXT("%s: Move collision, attempt at redundant update, OK %s."), *GetName(),*Filename);
+								}
+								else
+								{
+									UE_LOG(LogDerivedDataCache, Verbose, TEXT("%s: Successful cache put of %s to %s"),*GetName(), CacheKey, *Filename);
+								}
 							}
 						}
+						else
+						{
+							UE_LOG(LogDerivedDataCache, Warning, TEXT("%s: Temp file is short %s!"), *GetName(), *TempFilename);
+						}
 					}
 					else
 					{
-						UE_LOG(LogDerivedDataCache, Warning, TEXT("%s: Temp file is short %s!"), *GetName(), *TempFilename);
+						uint32 ErrorCode = FPlatformMisc::GetLastError();
+						TCHAR ErrorBuffer[1024];
+						FPlatformMisc::GetSystemErrorMessage(ErrorBuffer, 1024, ErrorCode);
+						UE_LOG(LogDerivedDataCache, Warning, TEXT("FFileSystemDerivedDataBackend: Could not write temp file %s! Error: %u (%s)"), *TempFilename, ErrorCode, ErrorBuffer);
+					}
+					// if everything worked, this is not necessary, but we will make every effort to avoid leaving junk in the cache
+					if (FPaths::FileExists(TempFilename))
+					{
+						IFileManager::Get().Delete(*TempFilename, false, false, true);
 					}
-				}
-				else
-				{
-					uint32 ErrorCode = FPlatformMisc::GetLastError();
-					TCHAR ErrorBuffer[1024];
-					FPlatformMisc::GetSystemErrorMessage(ErrorBuffer, 1024, ErrorCode);
-					UE_LOG(LogDerivedDataCache, Warning, TEXT("FFileSystemDerivedDataBackend: Could not write temp file %s! Error: %u (%s)"), *TempFilename, ErrorCode, ErrorBuffer);
-				}
-				// if everything worked, this is not necessary, but we will make every effort to avoid leaving junk in the cache
-				if (FPaths::FileExists(TempFilename))
-				{
-					IFileManager::Get().Delete(*TempFilename, false, false, true);
 				}
 			}
 			else
@@ -731,6 +792,12 @@ public:
 		check(IsUsable());
 		if (IsWritable() && (!bTransient || bPurgeTransient))
 		{
+			if (PackedStore.IsValid())
+			{
+				PackedStore->Remove(CacheKey);
+				return;
+			}
+
 			FString Filename = BuildFilename(CacheKey);
 			if (bTransient)
 			{
@@ -804,6 +871,9 @@ private:
 	/** Access log to write to */
 	TUniquePtr<FAccessLogWriter> AccessLogWriter;
 
+	/** Segment files the entries are appended to with Packed=true, otherwise there is a file per key */
+	TUniquePtr<FPackedDerivedDataStore> PackedStore;
+
 	/** Debug Options */
 	FBackendDebugOptions DebugOptions;
 
@@ -218,68 +218,7 @@ public:
 			// just try and get the cached data. It's faster to try and fail than it is to check and succeed. 			
 			if (GetInterface->GetCachedData(CacheKey, OutData))
 			{
-				// if this hierarchy is writable..
-				if (bIsWritable)
-				{
-					// fill in the higher level caches (start with the highest level as that should be the biggest 
-					// !/$ if any of our puts get interrupted or fail)
-					for (int32 MissedCacheIndex = 0; MissedCacheIndex < CacheIndex; MissedCacheIndex++)
-					{
-						FDerivedDataBackendInterface* MissedCache = InnerBackends[MissedCacheIndex];
-
-						if (MissedCache->IsWritable())
-						{
-							// We want to make sure that the relationship between ProbablyExists and GetCachedData is valid but
-							// only if we have a fast cache. Mismatches are edge cases caused by failed writes or corruption. 
-							// They get handled, so can be left to eventually be rectified by a faster machine
-							bool bFastCache = MissedCache->GetSpeedClass() >= ESpeedClass::Fast;
-							bool bDidExist = bFastCache ? MissedCache->CachedDataProbablyExists(CacheKey) : false;
-							bool bForcePut = false;
-
-							// the cache failed to return data it thinks it has, so clean it up. (todo - can it just be stomped?)
-							if (bDidExist)
-							{
-								MissedCache->RemoveCachedData(CacheKey, /*bTransient=*/ false); // it apparently failed, so lets delete what is there				
-								bForcePut = true;
-							}
-
-							// use the async interface to perform the put
-							AsyncPutInnerBackends[MissedCacheIndex]->PutCachedData(CacheKey, OutData, bForcePut);
-							UE_LOG(LogDerivedDataCache, Verbose, TEXT("Forward-filling cache %s with: %s (%d bytes) (force=%d)"), *MissedCache->GetName(), CacheKey, OutData.Num(), bForcePut);
-						}
-					}
-
-					// cascade this data to any lower level back ends that may be missing the data
-					if (InnerBackends[CacheIndex]->BackfillLowerCacheLevels())
-					{
-						// fill in the lower level caches
-						for (int32 PutCacheIndex = CacheIndex + 1; PutCacheIndex < AsyncPutInnerBackends.Num(); PutCacheIndex++)
-						{
-							FDerivedDataBackendInterface* PutBackend = InnerBackends[PutCacheIndex];
-
-							// If the key is in a distributed cache (e.g. Pak or S3) then don't backfill any further. 
-							bool IsInDistributedCache = !PutBackend->IsWritable() && !PutBackend->BackfillLowerCacheLevels() && PutBackend->CachedDataProbablyExists(CacheKey);
-
-							if (!IsInDistributedCache)
-							{
-								// only backfill to fast caches (todo - need a way to put data that was created locally into the cache for other people)
-								bool bFastCache = PutBackend->GetSpeedClass() >= ESpeedClass::Fast;
-
-								// No need to validate that the cache data might exist since the check can be expensive, the async put will do the check and early out in that case
-								if (bFastCache && PutBackend->IsWritable())
-								{								
-									AsyncPutInnerBackends[PutCacheIndex]->PutCachedData(CacheKey, OutData, false); // we do not need to force a put here
-									UE_LOG(LogDerivedDataCache, Verbose, TEXT("Back-filling cache %s with: %s (%d bytes) (force=%d)"), *PutBackend->GetName(), CacheKey, OutData.Num(), false);
-								}
-							}
-							else
-							{ 
-								UE_LOG(LogDerivedDataCache, Verbose, TEXT("Item %s exists in distributed cache %s. Skipping any further backfills."), CacheKey, *PutBackend->GetName());
-								break;
-							}
-						}
-					}
-				}
+				FillCacheLevels(CacheKey, CacheIndex, OutData);
 				COOK_STAT(Timer.AddHit(OutData.Num()));
 				return true;
 			}
@@ -296,6 +235,47 @@ public:
 		}
 		return false;
 	}
+
+	virtual void GetCachedDataBatch(TArrayView<const FString> CacheKeys, TArrayView<TArray<uint8>> OutData, TBitArray<>& OutHits) override
+	{
+		COOK_STAT(auto Timer = UsageStats.TimeGet());
+		COOK_STAT(Timer.TrackCyclesOnly());
+		const TBitArray<> HitsBefore = OutHits;
+
+		// Each level gets the keys that all faster levels missed in one batch
+		for (int32 CacheIndex = 0; CacheIndex < InnerBackends.Num() && OutHits.Find(false) != INDEX_NONE; CacheIndex++)
+		{
+			const TBitArray<> LevelHitsBefore = OutHits;
+			InnerBackends[CacheIndex]->GetCachedDataBatch(CacheKeys, OutData, OutHits);
+
+			for (int32 Index = 0; Index < CacheKeys.Num(); Index++)
+			{
+				if (OutHits[Index] && !LevelHitsBefore[Index])
+				{
+					FillCacheLevels(*CacheKeys[Index], CacheIndex, OutData[Index]);
+				}
+				else if (!OutHits[Index])
+				{
+					extern bool GVerifyDDC;
+
+					if (GVerifyDDC)
+					{
+						TArray<uint8> TempData;
+						ensureMsgf(!AsyncPutInnerBackends[CacheIndex]->GetCachedData(*CacheKeys[Index], TempData), TEXT("CacheKey %s did not exist in sync interface for GetCachedDataBatch but was found in async wrapper"), *CacheKeys[Index]);
+					}
+				}
+			}
+		}
+
+		for (int32 Index = 0; Index < CacheKeys.Num(); Index++)
+		{
+			if (!HitsBefore[Index])
+			{
+				COOK_STAT(UsageStats.AddGetHitOrMiss(OutHits[Index], OutHits[Index] ? OutData[Index].Num() : 0));
+			}
+		}
+	}
+
 	/**
 	 * Asynchronous, fire-and-forget placement of a cache item
 	 *
@@ -372,6 +352,73 @@ public:
 
 
 private:
+	/** Forward-fills the faster levels and back-fills the slower ones after a hit in the level CacheIndex */
+	void FillCacheLevels(const TCHAR* CacheKey, int32 CacheIndex, TArrayView<const uint8> Data)
+	{
+		// if this hierarchy is writable..
+		if (bIsWritable)
+		{
+			// fill in the higher level caches (start with the highest level as that should be the biggest 
+			// !/$ if any of our puts get interrupted or fail)
+			for (int32 MissedCacheIndex = 0; MissedCacheIndex < CacheIndex; MissedCacheIndex++)
+			{
+				FDerivedDataBackendInterface* MissedCache = InnerBackends[MissedCacheIndex];
+
+				if (MissedCache->IsWritable())
+				{
+					// We want to make sure that the relationship between ProbablyExists and GetCachedData is valid but
+					// only if we have a fast cache. Mismatches are edge cases caused by failed writes or corruption. 
+					// They get handled, so can be left to eventually be rectified by a faster machine
+					bool bFastCache = MissedCache->GetSpeedClass() >= ESpeedClass::Fast;
+					bool bDidExist = bFastCache ? MissedCache->CachedDataProbablyExists(CacheKey) : false;
+					bool bForcePut = false;
+
+					// the cache failed to return data it thinks it has, so clean it up. (todo - can it just be stomped?)
+					if (bDidExist)
+					{
+						MissedCache->RemoveCachedData(CacheKey, /*bTransient=*/ false); // it apparently failed, so lets delete what is there				
+						bForcePut = true;
+					}
+
+					// use the async interface to perform the put
+					AsyncPutInnerBackends[MissedCacheIndex]->PutCachedData(CacheKey, Data, bForcePut);
+					UE_LOG(LogDerivedDataCache, Verbose, TEXT("Forward-filling cache %s with: %s (%d bytes) (force=%d)"), *MissedCache->GetName(), CacheKey, Data.Num(), bForcePut);
+				}
+			}
+
+			// cascade this data to any lower level back ends that may be missing the data
+			if (InnerBackends[CacheIndex]->BackfillLowerCacheLevels())
+			{
+				// fill in the lower level caches
+				for (int32 PutCacheIndex = CacheIndex + 1; PutCacheIndex < AsyncPutInnerBackends.Num(); PutCacheIndex++)
+				{
+					FDerivedDataBackendInterface* PutBackend = InnerBackends[PutCacheIndex];
+
+					// If the key is in a distributed cache (e.g. Pak or S3) then don't backfill any further. 
+					bool IsInDistributedCache = !PutBackend->IsWritable() && !PutBackend->BackfillLowerCacheLevels() && PutBackend->CachedDataProbablyExists(CacheKey);
+
+					if (!IsInDistributedCache)
+					{
+						// only backfill to fast caches (todo - need a way to put data that was created locally into the cache for other people)
+						bool bFastCache = PutBackend->GetSpeedClass() >= ESpeedClass::Fast;
+
+						// No need to validate that the cache data might exist since the check can be expensive, the async put will do the check and early out in that case
+						if (bFastCache && PutBackend->IsWritable())
+						{								
+							AsyncPutInnerBackends[PutCacheIndex]->PutCachedData(CacheKey, Data, false); // we do not need to force a put here
+							UE_LOG(LogDerivedDataCache, Verbose, TEXT("Back-filling cache %s with: %s (%d bytes) (force=%d)"), *PutBackend->GetName(), CacheKey, Data.Num(), false);
+						}
+					}
+					else
+					{ 
+						UE_LOG(LogDerivedDataCache, Verbose, TEXT("Item %s exists in distributed cache %s. Skipping any further backfills."), CacheKey, *PutBackend->GetName());
+						break;
+					}
+				}
+			}
+		}
+	}
+
 	FDerivedDataCacheUsageStats UsageStats;
 
 	/** Array of backends forming the hierarchical cache...the first element is the fastest cache. **/
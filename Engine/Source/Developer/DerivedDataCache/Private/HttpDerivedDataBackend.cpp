@@ -234,6 +234,72 @@ public:
 		return PerformBlocking(Uri, Get, 0u);
 	}
 
+	/**
+	 * Download several urls at once. The requests are driven by one multi handle so that they overlap instead of
+	 * waiting for each other, and are multiplexed over a shared connection when the server supports HTTP/2.
+	 * @param Requests Requests to use, one per url.
+	 * @param Uris Urls to use.
+	 * @param Buffers Buffers where data should be downloaded to, one per url.
+	 */
+	static void PerformBlockingDownloads(TArrayView<FRequest* const> Requests, TArrayView<const FString> Uris, TArrayView<TArray<uint8>* const> Buffers)
+	{
+		check(Requests.Num() == Uris.Num() && Requests.Num() == Buffers.Num());
+		TRACE_CPUPROFILER_EVENT_SCOPE(HttpDDC_CurlMultiPerform);
+
+		CURLM* Multi = curl_multi_init();
+		curl_multi_setopt(Multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+
+		TArray<curl_slist*, TInlineAllocator<UE_HTTPDDC_REQUEST_POOL_SIZE>> CurlHeaders;
+		for (int32 Index = 0; Index < Requests.Num(); Index++)
+		{
+			FRequest* Request = Requests[Index];
+			curl_easy_setopt(Request->Curl, CURLOPT_HTTPGET, 1L);
+			// Prefer waiting for a connection that can be multiplexed over opening one per request
+			curl_easy_setopt(Request->Curl, CURLOPT_PIPEWAIT, 1L);
+			Request->WriteDataBufferPtr = Buffers[Index];
+			CurlHeaders.Add(Request->PrepareRequest(*Uris[Index], 0u));
+			curl_multi_add_handle(Multi, Request->Curl);
+		}
+
+		// Shots fired!
+		int NumRunning = Requests.Num();
+		while (NumRunning > 0)
+		{
+			if (curl_multi_perform(Multi, &NumRunning) != CURLM_OK)
+			{
+				break;
+			}
+			if (NumRunning > 0)
+			{
+				curl_multi_wait(Multi, nullptr, 0, 100, nullptr);
+			}
+		}
+
+		int NumMessages = 0;
+		while (CURLMsg* Message = curl_multi_info_read(Multi, &NumMessages))
+		{
+			if (Message->msg == CURLMSG_DONE)
+			{
+				for (FRequest* Request : Requests)
+				{
+					if (Request->Curl == Message->easy_handle)
+					{
+						Request->CurlResult = Message->data.result;
+						break;
+					}
+				}
+			}
+		}
+
+		// Requests that did not finish keep CURL_LAST and fail
+		for (int32 Index = 0; Index < Requests.Num(); Index++)
+		{
+			curl_multi_remove_handle(Multi, Requests[Index]->Curl);
+			Requests[Index]->FinishRequest(*Uris[Index], Get, CurlHeaders[Index]);
+		}
+		curl_multi_cleanup(Multi);
+	}
+
 	/**
 	 * Query an url using the request. Queries can use either "Head" or "Delete" verbs.
 	 * @param Uri Url to use.
@@ -360,14 +426,28 @@ private:
 	 * If unset the response body will be stored in the request.
 	 */
 	Result PerformBlocking(const TCHAR* Uri, RequestVerb Verb, uint32 ContentLength)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(HttpDDC_CurlPerform);
+
+		curl_slist* CurlHeaders = PrepareRequest(Uri, ContentLength);
+
+		// Shots fired!
+		CurlResult = curl_easy_perform(Curl);
+
+		return FinishRequest(Uri, Verb, CurlHeaders);
+	}
+
+	/**
+	 * Sets the options shared by blocking and multi requests.
+	 * @return Header list that has to be passed to FinishRequest once the request is done
+	 */
+	curl_slist* PrepareRequest(const TCHAR* Uri, uint32 ContentLength)
 	{
 		static const char* CommonHeaders[] = {
 			"User-Agent: UE4",
 			nullptr
 		};
 
-		TRACE_CPUPROFILER_EVENT_SCOPE(HttpDDC_CurlPerform);
-
 		// Setup request options
 		FString Url = FString::Printf(TEXT("%s/%s"), *Domain, Uri);
 		curl_easy_setopt(Curl, CURLOPT_URL, TCHAR_TO_ANSI(*Url));
@@ -402,9 +482,12 @@ private:
 		}
 		curl_easy_setopt(Curl, CURLOPT_HTTPHEADER, CurlHeaders);
 
-		// Shots fired!
-		CurlResult = curl_easy_perform(Curl);
+		return CurlHeaders;
+	}
 
+	/** Reads the response code and logs the result once CurlResult is set */
+	Result FinishRequest(const TCHAR* Uri, RequestVerb Verb, curl_slist* CurlHeaders)
+	{
 		// Get response code
 		bool bRedirected = false;
 		if (CURLE_OK == curl_easy_getinfo(Curl, CURLINFO_RESPONSE_CODE, &ResponseCode))
@@ -687,19 +770,32 @@ struct FRequestPool
 		TRACE_CPUPROFILER_EVENT_SCOPE(HttpDDC_WaitForConnPool);
 		while (true)
 		{
-			for (uint8 i = 0; i < Pool.Num(); ++i)
+			if (FRequest* Request = TryGetFreeRequest())
+			{
+				return Request;
+			}
+			FPlatformProcess::Sleep(UE_HTTPDDC_BACKEND_WAIT_INTERVAL);
+		}
+	}
+
+	/**
+	 * Returns a free request without waiting, or null if all of them are in use. Like with
+	 * \ref WaitForFreeRequest the caller needs to release it to the pool.
+	 */
+	FRequest* TryGetFreeRequest()
+	{
+		for (uint8 i = 0; i < Pool.Num(); ++i)
+		{
+			if (!Pool[i].Usage.Load(EMemoryOrder::Relaxed))
 			{
-				if (!Pool[i].Usage.Load(EMemoryOrder::Relaxed))
+				uint8 Expected = 0u;
+				if (Pool[i].Usage.CompareExchange(Expected, 1u))
 				{
-					uint8 Expected = 0u;
-					if (Pool[i].Usage.CompareExchange(Expected, 1u))
-					{
-						return Pool[i].Request;
-					}
+					return Pool[i].Request;
 				}
 			}
-			FPlatformProcess::Sleep(UE_HTTPDDC_BACKEND_WAIT_INTERVAL);
 		}
+		return nullptr;
 	}
 
 	/**
@@ -1191,6 +1287,88 @@ bool FHttpDerivedDataBackend::GetCachedData(const TCHAR* CacheKey, TArray<uint8>
 	return false;
 }
 
+void FHttpDerivedDataBackend::GetCachedDataBatch(TArrayView<const FString> CacheKeys, TArrayView<TArray<uint8>> OutData, TBitArray<>& OutHits)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(HttpDDC_GetBatch);
+	check(OutData.Num() == CacheKeys.Num() && OutHits.Num() == CacheKeys.Num());
+
+	TArray<int32> Pending;
+	TArray<uint32> Attempts;
+	for (int32 Index = 0; Index < CacheKeys.Num(); Index++)
+	{
+		if (!OutHits[Index])
+		{
+			Pending.Add(Index);
+		}
+	}
+	Attempts.SetNumZeroed(CacheKeys.Num());
+
+	while (Pending.Num() > 0)
+	{
+		// Wait for one request, then take as many more as are free without waiting for other threads to release theirs
+		TArray<FRequest*, TInlineAllocator<UE_HTTPDDC_REQUEST_POOL_SIZE>> Requests;
+		Requests.Add(RequestPool->WaitForFreeRequest());
+		while (Requests.Num() < Pending.Num())
+		{
+			FRequest* Request = RequestPool->TryGetFreeRequest();
+			if (!Request)
+			{
+				break;
+			}
+			Requests.Add(Request);
+		}
+
+		TArray<FString, TInlineAllocator<UE_HTTPDDC_REQUEST_POOL_SIZE>> Uris;
+		TArray<TArray<uint8>*, TInlineAllocator<UE_HTTPDDC_REQUEST_POOL_SIZE>> Buffers;
+		for (int32 RequestIndex = 0; RequestIndex < Requests.Num(); RequestIndex++)
+		{
+			const int32 Index = Pending[RequestIndex];
+			Uris.Add(FString::Printf(TEXT("api/v1/c/ddc/%s/%s/%s.raw"), *Namespace, *DefaultBucket, *CacheKeys[Index]));
+			Buffers.Add(&OutData[Index]);
+			TRACE_COUNTER_ADD(HttpDDC_Get, int64(1));
+		}
+
+		{
+			COOK_STAT(auto Timer = UsageStats.TimeGet());
+			COOK_STAT(Timer.TrackCyclesOnly());
+			FRequest::PerformBlockingDownloads(Requests, Uris, Buffers);
+		}
+
+		TArray<int32> Retries;
+		for (int32 RequestIndex = 0; RequestIndex < Requests.Num(); RequestIndex++)
+		{
+			const int32 Index = Pending[RequestIndex];
+			FRequest* Request = Requests[RequestIndex];
+			const int64 ResponseCode = Request->GetResponseCode();
+
+			// Request was successful, make sure we got all the expected data.
+			if (ResponseCode == 200 && VerifyRequest(Request, OutData[Index]))
+			{
+				TRACE_COUNTER_ADD(HttpDDC_GetHit, int64(1));
+				TRACE_COUNTER_ADD(HttpDDC_BytesReceived, int64(Request->GetBytesReceived()));
+				COOK_STAT(UsageStats.AddGetHitOrMiss(true, Request->GetBytesReceived()));
+				OutHits[Index] = true;
+			}
+			else
+			{
+				OutData[Index].Reset();
+				if (ShouldRetryOnError(ResponseCode) && ++Attempts[Index] < UE_HTTPDDC_MAX_ATTEMPTS - 1)
+				{
+					Retries.Add(Index);
+				}
+				else
+				{
+					COOK_STAT(UsageStats.AddGetHitOrMiss(false, 0));
+				}
+			}
+			RequestPool->ReleaseRequestToPool(Request);
+		}
+
+		Pending.RemoveAt(0, Requests.Num(), false);
+		Pending.Append(Retries);
+	}
+}
+
 void FHttpDerivedDataBackend::PutCachedData(const TCHAR* CacheKey, TArrayView<const uint8> InData, bool bPutEvenIfExists)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(HttpDDC_Put);
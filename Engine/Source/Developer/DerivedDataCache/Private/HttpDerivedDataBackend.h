@@ -52,6 +52,7 @@ public:
 	virtual bool IsWritable() const override { return true; }
 	virtual bool CachedDataProbablyExists(const TCHAR* CacheKey) override;
 	virtual bool GetCachedData(const TCHAR* CacheKey, TArray<uint8>& OutData) override;
+	virtual void GetCachedDataBatch(TArrayView<const FString> CacheKeys, TArrayView<TArray<uint8>> OutData, TBitArray<>& OutHits) override;
 	virtual void PutCachedData(const TCHAR* CacheKey, TArrayView<const uint8> InData, bool bPutEvenIfExists) override;
 	virtual void RemoveCachedData(const TCHAR* CacheKey, bool bTransient) override;
 	virtual TSharedRef<FDerivedDataCacheStatsNode> GatherUsageStats() const override;
@@ -0,0 +1,1197 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PackedDerivedDataStore.h"
+#include "Async/Async.h"
+#include "Async/MappedFileHandle.h"
+#include "DerivedDataBackendInterface.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Hash/xxhash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+/*
+ * Segment files (.uds) are a sequence of entries, each 8 byte aligned:
+ *
+ *   FEntryHeader, the uppercase ANSI cache key, the data, padding
+ *
+ * A removal is an entry without data. The header CRC covers the header and the key, so that a scan stops at an entry
+ * torn by a crash, the data CRC is checked when the entry is read. The write time of the entry decides which of the
+ * entries for a key wins, within a segment and across segments. It is kept when an entry is refreshed or compacted.
+ *
+ * Index files (.udx) are written when a segment is sealed, to a temporary file that is renamed into place, so an index
+ * is either complete or missing. They are an open addressing hash table of FIndexSlot with linear probing and at most
+ * half of the slots used, holding the winning entry of the segment for each key. The index maps the key hash to the entry,
+ * a 64 bit hash collision costs a miss as the key is compared when reading, never wrong data.
+ *
+ * Both are in native byte order, which is little endian on all platforms that run the editor.
+ */
+namespace PackedDerivedDataStore
+{
+	static const uint32 EntryMagic = 0x32434444;	// DDC2
+	static const uint32 IndexMagic = 0x58434444;	// DDCX
+	static const uint32 IndexVersion = 2;
+	static const uint32 EntryAlignment = 8;
+	static const uint32 MaxKeyLength = 1024;
+	/** Index slots flag removals in the top bit of the entry size */
+	static const uint32 RemovedFlag = 0x80000000u;
+	/** Offsets are 32 bit, compaction output has to fit too */
+	static const int64 MaxSegmentSize = MAX_uint32;
+	static const int64 MaxCompactionSize = MaxSegmentSize / 2;
+
+	struct FEntryHeader
+	{
+		uint32 Magic;
+		uint32 KeyLength;
+		uint32 DataSize;
+		uint32 DataCrc;
+		uint64 KeyHash;
+		/** UTC ticks of the write, the latest write of a key wins */
+		int64 WriteTicks;
+		/** Day the entry was written or refreshed, in days since 0001-01-01 UTC */
+		uint32 WriteDay;
+		/** CRC of the fields above and the key */
+		uint32 HeaderCrc;
+	};
+	static_assert(sizeof(FEntryHeader) == 40, "Entry header is part of the file format");
+
+	struct FIndexHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 NumSlots;
+		uint32 NumEntries;
+		/** Size of the segment when the index was written, entries after it are not indexed */
+		uint64 SegmentSize;
+	};
+	static_assert(sizeof(FIndexHeader) == 24, "Index header is part of the file format");
+
+	struct FIndexSlot
+	{
+		/** Zero for an empty slot */
+		uint64 KeyHash;
+		uint32 Offset;
+		/** Size of the whole entry, and RemovedFlag */
+		uint32 Size;
+		int64 WriteTicks;
+		uint32 WriteDay;
+		uint32 Reserved;
+	};
+	static_assert(sizeof(FIndexSlot) == 32, "Index slot is part of the file format");
+
+	static uint32 GetDay(const FDateTime& Time)
+	{
+		return uint32(Time.GetTicks() / ETimespan::TicksPerDay);
+	}
+
+	/** Write times are unique and increasing within the process even if the clock is coarse */
+	static int64 NextWriteTicks()
+	{
+		static std::atomic<int64> LastWriteTicks{ 0 };
+		int64 Last = LastWriteTicks.load();
+		int64 Ticks;
+		do
+		{
+			Ticks = FMath::Max(FDateTime::UtcNow().GetTicks(), Last + 1);
+		}
+		while (!LastWriteTicks.compare_exchange_weak(Last, Ticks));
+		return Ticks;
+	}
+
+	static uint32 GetEntrySize(uint32 KeyLength, uint32 DataSize)
+	{
+		return Align(uint32(sizeof(FEntryHeader)) + KeyLength + DataSize, EntryAlignment);
+	}
+
+	static uint32 GetHeaderCrc(const FEntryHeader& Header, const ANSICHAR* Key)
+	{
+		const uint32 Crc = FCrc::MemCrc32(&Header, STRUCT_OFFSET(FEntryHeader, HeaderCrc));
+		return FCrc::MemCrc32(Key, Header.KeyLength, Crc);
+	}
+
+	/** Checks the header of an entry followed by its key */
+	static bool IsValidHeader(const FEntryHeader& Header, const ANSICHAR* Key)
+	{
+		return Header.Magic == EntryMagic && Header.KeyLength <= MaxKeyLength && Header.DataSize < RemovedFlag && Header.HeaderCrc == GetHeaderCrc(Header, Key);
+	}
+
+	static FString GetSegmentPath(const FString& Directory, const FString& Name)
+	{
+		return Directory / Name + TEXT(".uds");
+	}
+
+	static FString GetIndexPath(const FString& Directory, const FString& Name)
+	{
+		return Directory / Name + TEXT(".udx");
+	}
+}
+
+using namespace PackedDerivedDataStore;
+
+struct FPackedDerivedDataStore::FKey
+{
+	explicit FKey(const TCHAR* CacheKey)
+	{
+		// The same keys as the per file layout, which uppercases them for case insensitive filesystems
+		for (const TCHAR* Char = CacheKey; *Char; ++Char)
+		{
+			Chars.Add(ANSICHAR(FChar::ToUpper(*Char)));
+		}
+		check(Chars.Num() <= int32(MaxKeyLength));
+		Hash = FXxHash::HashBuffer64(Chars.GetData(), Chars.Num());
+		Hash = Hash ? Hash : 1;
+	}
+
+	TArray<ANSICHAR, TInlineAllocator<128>> Chars;
+	uint64 Hash;
+};
+
+struct FPackedDerivedDataStore::FEntryLocation
+{
+	uint32 Offset = 0;
+	/** Size of the whole entry */
+	uint32 Size = 0;
+	bool bRemoved = false;
+	int64 WriteTicks = 0;
+	uint32 WriteDay = 0;
+};
+
+class FPackedDerivedDataStore::FSegment
+{
+public:
+	enum class EReadResult
+	{
+		Ok,
+		/** The segment was deleted by compaction in another process */
+		Missing,
+		Corrupt,
+	};
+
+	FSegment(const FString& InDirectory, const FString& InName)
+		: Directory(InDirectory)
+		, Name(InName)
+		, Ticks(int64(FCString::Strtoui64(*InName.Left(16), nullptr, 16)))
+	{
+	}
+
+	FString GetSegmentPath() const { return PackedDerivedDataStore::GetSegmentPath(Directory, Name); }
+	FString GetIndexPath() const { return PackedDerivedDataStore::GetIndexPath(Directory, Name); }
+
+	/** Keeps the latest write of the key, a refresh of an older write can be appended after a newer write */
+	static void AddEntry(TMap<uint64, FEntryLocation>& InOutEntries, uint64 KeyHash, const FEntryLocation& Location)
+	{
+		const FEntryLocation* Existing = InOutEntries.Find(KeyHash);
+		if (!Existing || Location.WriteTicks >= Existing->WriteTicks)
+		{
+			InOutEntries.Add(KeyHash, Location);
+		}
+	}
+
+	bool Find(uint64 KeyHash, FEntryLocation& OutLocation) const
+	{
+		if (!bSealed)
+		{
+			const FEntryLocation* Location = Entries.Find(KeyHash);
+			if (Location)
+			{
+				OutLocation = *Location;
+			}
+			return Location != nullptr;
+		}
+
+		for (uint32 Probe = 0, Slot = uint32(KeyHash) & SlotMask; Probe <= SlotMask; ++Probe, Slot = (Slot + 1) & SlotMask)
+		{
+			if (Slots[Slot].KeyHash == KeyHash)
+			{
+				ReadSlot(Slots[Slot], OutLocation);
+				return true;
+			}
+			if (Slots[Slot].KeyHash == 0)
+			{
+				break;
+			}
+		}
+		return false;
+	}
+
+	template<typename FunctionType>
+	void ForEachIndexed(FunctionType&& Function) const
+	{
+		check(bSealed);
+		for (uint32 Slot = 0; Slot <= SlotMask; ++Slot)
+		{
+			if (Slots[Slot].KeyHash)
+			{
+				FEntryLocation Location;
+				ReadSlot(Slots[Slot], Location);
+				Function(Slots[Slot].KeyHash, Location);
+			}
+		}
+	}
+
+	EReadResult Read(const FEntryLocation& Location, const FKey& Key, TArray<uint8>& OutData)
+	{
+		FScopeLock Lock(&ReadCS);
+		if (!ReadHandle)
+		{
+			ReadHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*GetSegmentPath(), /*bAllowWrite*/ true));
+			if (!ReadHandle)
+			{
+				return EReadResult::Missing;
+			}
+		}
+
+		FEntryHeader Header;
+		ANSICHAR EntryKey[MaxKeyLength];
+		if (!ReadHandle->Seek(Location.Offset) || !ReadHandle->Read(reinterpret_cast<uint8*>(&Header), sizeof(Header)) ||
+			Header.KeyLength > MaxKeyLength || !ReadHandle->Read(reinterpret_cast<uint8*>(EntryKey), Header.KeyLength))
+		{
+			return EReadResult::Corrupt;
+		}
+		if (!IsValidHeader(Header, EntryKey) || GetEntrySize(Header.KeyLength, Header.DataSize) != Location.Size)
+		{
+			return EReadResult::Corrupt;
+		}
+		if (Header.KeyLength != uint32(Key.Chars.Num()) || FMemory::Memcmp(EntryKey, Key.Chars.GetData(), Header.KeyLength) != 0)
+		{
+			// Another key with the same hash, treated as a miss
+			OutData.Reset();
+			return EReadResult::Ok;
+		}
+
+		OutData.SetNumUninitialized(Header.DataSize);
+		if (!ReadHandle->Read(OutData.GetData(), Header.DataSize) || FCrc::MemCrc32(OutData.GetData(), OutData.Num()) != Header.DataCrc)
+		{
+			OutData.Reset();
+			return EReadResult::Corrupt;
+		}
+		return EReadResult::Ok;
+	}
+
+	/** Adds the complete entries between StartOffset and EndOffset to OutEntries, returns the offset after the last one */
+	int64 Scan(int64 StartOffset, int64 EndOffset, TMap<uint64, FEntryLocation>& OutEntries) const
+	{
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*GetSegmentPath(), FILEREAD_Silent | FILEREAD_AllowWrite));
+		if (!Reader)
+		{
+			return StartOffset;
+		}
+
+		EndOffset = FMath::Min(FMath::Min(EndOffset, Reader->TotalSize()), MaxSegmentSize);
+		int64 Offset = StartOffset;
+		FEntryHeader Header;
+		ANSICHAR Key[MaxKeyLength];
+		while (Offset + int64(sizeof(FEntryHeader)) <= EndOffset)
+		{
+			Reader->Seek(Offset);
+			Reader->Serialize(&Header, sizeof(Header));
+			if (Reader->IsError() || Header.Magic != EntryMagic || Header.KeyLength > MaxKeyLength)
+			{
+				break;
+			}
+			Reader->Serialize(Key, Header.KeyLength);
+			const uint32 EntrySize = GetEntrySize(Header.KeyLength, Header.DataSize);
+			if (Reader->IsError() || !IsValidHeader(Header, Key) || Offset + EntrySize > EndOffset)
+			{
+				// Torn by a crash or still being written
+				break;
+			}
+
+			FEntryLocation Location;
+			Location.Offset = uint32(Offset);
+			Location.Size = EntrySize;
+			Location.bRemoved = Header.DataSize == 0;
+			Location.WriteTicks = Header.WriteTicks;
+			Location.WriteDay = Header.WriteDay;
+			AddEntry(OutEntries, Header.KeyHash, Location);
+			Offset += EntrySize;
+		}
+		return Offset;
+	}
+
+	bool LoadIndex()
+	{
+		const FString IndexPath = GetIndexPath();
+		const uint8* IndexData = nullptr;
+		int64 IndexSize = 0;
+
+		MappedIndex.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*IndexPath));
+		if (MappedIndex && MappedIndex->GetFileSize() > 0)
+		{
+			MappedRegion.Reset(MappedIndex->MapRegion());
+			IndexData = MappedRegion->GetMappedPtr();
+			IndexSize = MappedRegion->GetMappedSize();
+		}
+		else
+		{
+			// Not all platforms can map files
+			MappedIndex.Reset();
+			if (FFileHelper::LoadFileToArray(LoadedIndex, *IndexPath, FILEREAD_Silent))
+			{
+				IndexData = LoadedIndex.GetData();
+				IndexSize = LoadedIndex.Num();
+			}
+		}
+
+		const FIndexHeader* Header = reinterpret_cast<const FIndexHeader*>(IndexData);
+		if (!IndexData || IndexSize < int64(sizeof(FIndexHeader)) || Header->Magic != IndexMagic || Header->Version != IndexVersion ||
+			!FMath::IsPowerOfTwo(Header->NumSlots) || IndexSize != int64(sizeof(FIndexHeader)) + int64(Header->NumSlots) * int64(sizeof(FIndexSlot)))
+		{
+			UE_LOG(LogDerivedDataCache, Warning, TEXT("Ignoring invalid index %s."), *IndexPath);
+			ReleaseIndex();
+			return false;
+		}
+
+		Slots = reinterpret_cast<const FIndexSlot*>(IndexData + sizeof(FIndexHeader));
+		SlotMask = Header->NumSlots - 1;
+		NumIndexed = Header->NumEntries;
+		Size = int64(Header->SegmentSize);
+		return true;
+	}
+
+	/** Called once the segment is no longer in the list, so that its files can be deleted */
+	void CloseReadHandle()
+	{
+		FScopeLock Lock(&ReadCS);
+		ReadHandle.Reset();
+	}
+
+	/** Only safe once the segment is no longer in the list and nothing iterates the index */
+	void ReleaseIndex()
+	{
+		Slots = nullptr;
+		SlotMask = 0;
+		MappedRegion.Reset();
+		MappedIndex.Reset();
+		LoadedIndex.Empty();
+	}
+
+	/** Writes the index for Entries, through a temporary file renamed into place */
+	static bool WriteIndex(const FString& IndexPath, const TMap<uint64, FEntryLocation>& IndexEntries, int64 SegmentSize)
+	{
+		const uint32 NumSlots = FMath::RoundUpToPowerOfTwo(FMath::Max(uint32(IndexEntries.Num()) * 2, 16u));
+		TArray<uint8> Buffer;
+		Buffer.SetNumZeroed(sizeof(FIndexHeader) + NumSlots * sizeof(FIndexSlot));
+
+		FIndexHeader& Header = *reinterpret_cast<FIndexHeader*>(Buffer.GetData());
+		Header.Magic = IndexMagic;
+		Header.Version = IndexVersion;
+		Header.NumSlots = NumSlots;
+		Header.NumEntries = IndexEntries.Num();
+		Header.SegmentSize = SegmentSize;
+
+		FIndexSlot* IndexSlots = reinterpret_cast<FIndexSlot*>(Buffer.GetData() + sizeof(FIndexHeader));
+		for (const TPair<uint64, FEntryLocation>& Pair : IndexEntries)
+		{
+			uint32 Slot = uint32(Pair.Key) & (NumSlots - 1);
+			while (IndexSlots[Slot].KeyHash)
+			{
+				Slot = (Slot + 1) & (NumSlots - 1);
+			}
+			IndexSlots[Slot].KeyHash = Pair.Key;
+			IndexSlots[Slot].Offset = Pair.Value.Offset;
+			IndexSlots[Slot].Size = Pair.Value.Size | (Pair.Value.bRemoved ? RemovedFlag : 0);
+			IndexSlots[Slot].WriteTicks = Pair.Value.WriteTicks;
+			IndexSlots[Slot].WriteDay = Pair.Value.WriteDay;
+		}
+
+		const FString TempPath = FString::Printf(TEXT("%s.%s.tmp"), *IndexPath, *FGuid::NewGuid().ToString());
+		TUniquePtr<IFileHandle> Writer(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*TempPath));
+		bool bWritten = Writer && Writer->Write(Buffer.GetData(), Buffer.Num()) && Writer->Flush(/*bFullFlush*/ true);
+		Writer.Reset();
+
+		bWritten = bWritten && IFileManager::Get().Move(*IndexPath, *TempPath, /*Replace*/ true, false, false, /*bDoNotRetryOrError*/ true);
+		if (!bWritten)
+		{
+			UE_LOG(LogDerivedDataCache, Warning, TEXT("Failed to write index %s."), *IndexPath);
+			IFileManager::Get().Delete(*TempPath, false, false, true);
+		}
+		return bWritten;
+	}
+
+	const FString Directory;
+	/** Creation time in hex followed by a guid, so that names sort by creation time */
+	const FString Name;
+	const int64 Ticks;
+
+	/** Sealed segments are looked up in their index, others in the entries scanned or written so far */
+	bool bSealed = false;
+	/** Written by this process */
+	bool bOwned = false;
+	TMap<uint64, FEntryLocation> Entries;
+	int64 ScannedSize = 0;
+
+	/** Size covered by the index */
+	int64 Size = 0;
+	uint32 NumIndexed = 0;
+
+private:
+	static void ReadSlot(const FIndexSlot& Slot, FEntryLocation& OutLocation)
+	{
+		OutLocation.Offset = Slot.Offset;
+		OutLocation.Size = Slot.Size & ~RemovedFlag;
+		OutLocation.bRemoved = (Slot.Size & RemovedFlag) != 0;
+		OutLocation.WriteTicks = Slot.WriteTicks;
+		OutLocation.WriteDay = Slot.WriteDay;
+	}
+
+	/** The region has to be released before the file */
+	TUniquePtr<IMappedFileHandle> MappedIndex;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray<uint8> LoadedIndex;
+	const FIndexSlot* Slots = nullptr;
+	uint32 SlotMask = 0;
+
+	FCriticalSection ReadCS;
+	TUniquePtr<IFileHandle> ReadHandle;
+};
+
+FPackedDerivedDataStore::FPackedDerivedDataStore(const FString& InDirectory, const FParams& InParams)
+	: Directory(InDirectory)
+	, Params(InParams)
+{
+	Params.SegmentSize = FMath::Clamp<int64>(Params.SegmentSize, 64 * 1024, MaxCompactionSize);
+	Params.CompactAt = FMath::Max(Params.CompactAt, 1);
+	if (!Params.bReadOnly)
+	{
+		IFileManager::Get().MakeDirectory(*Directory, true);
+	}
+
+	{
+		FScopeLock Lock(&RescanCS);
+		Rescan();
+	}
+
+	int64 TotalSize = 0;
+	for (const FSegmentRef& Segment : Segments)
+	{
+		TotalSize += Segment->bSealed ? Segment->Size : Segment->ScannedSize;
+	}
+	UE_LOG(LogDerivedDataCache, Display, TEXT("Packed cache %s has %d segments, %.1fMB."), *Directory, Segments.Num(), TotalSize / (1024.0 * 1024.0));
+
+	// The core ticker is only safe to use from the game thread
+	if (!Params.bReadOnly && IsInGameThread())
+	{
+		TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FPackedDerivedDataStore::Tick), float(FMath::Clamp(Params.SealSeconds / 4.0, 1.0, 60.0)));
+	}
+
+	StartCompaction();
+}
+
+FPackedDerivedDataStore::~FPackedDerivedDataStore()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	}
+
+	bStopping = true;
+	{
+		FScopeLock Lock(&CompactionTaskCS);
+		if (CompactionTask.IsValid())
+		{
+			CompactionTask.Wait();
+		}
+	}
+
+	FScopeLock Lock(&WriterCS);
+	if (ActiveSegment)
+	{
+		SealSegment();
+	}
+}
+
+bool FPackedDerivedDataStore::Exists(const TCHAR* CacheKey, bool bTouch)
+{
+	const FKey Key(CacheKey);
+	FSegmentRef Segment;
+	FEntryLocation Location;
+	const bool bFound = FindEntry(Key.Hash, Segment, Location) || (TryRescan(false) && FindEntry(Key.Hash, Segment, Location));
+	if (!bFound || Location.bRemoved)
+	{
+		return false;
+	}
+
+	// Entries that are only ever probed are kept like those that are read
+	if (NeedsRefresh(Location.WriteDay, bTouch))
+	{
+		TArray<uint8> Data;
+		if (Segment->Read(Location, Key, Data) == FSegment::EReadResult::Ok && Data.Num())
+		{
+			Append(Key, Data, false, Location.WriteTicks);
+		}
+	}
+	return true;
+}
+
+bool FPackedDerivedDataStore::Get(const TCHAR* CacheKey, TArray<uint8>& OutData)
+{
+	const FKey Key(CacheKey);
+	for (int32 Attempt = 0; Attempt < 2; ++Attempt)
+	{
+		FSegmentRef Segment;
+		FEntryLocation Location;
+		if (!FindEntry(Key.Hash, Segment, Location))
+		{
+			// Written by another process since the last scan
+			if (Attempt == 0 && TryRescan(false))
+			{
+				continue;
+			}
+			return false;
+		}
+		if (Location.bRemoved)
+		{
+			return false;
+		}
+
+		const FSegment::EReadResult Result = Segment->Read(Location, Key, OutData);
+		if (Result == FSegment::EReadResult::Missing)
+		{
+			// Compacted by another process, its output is found after a scan
+			if (Attempt == 0 && TryRescan(true))
+			{
+				continue;
+			}
+			return false;
+		}
+		if (Result == FSegment::EReadResult::Corrupt)
+		{
+			UE_LOG(LogDerivedDataCache, Warning, TEXT("Corrupt entry for %s in %s."), CacheKey, *Segment->GetSegmentPath());
+			return false;
+		}
+		if (OutData.Num() == 0)
+		{
+			return false;
+		}
+
+		if (NeedsRefresh(Location.WriteDay, false))
+		{
+			Append(Key, OutData, false, Location.WriteTicks);
+		}
+		return true;
+	}
+	return false;
+}
+
+bool FPackedDerivedDataStore::Put(const TCHAR* CacheKey, TArrayView<const uint8> Data)
+{
+	check(Data.Num());
+	return Append(FKey(CacheKey), Data, false, NextWriteTicks());
+}
+
+void FPackedDerivedDataStore::Remove(const TCHAR* CacheKey)
+{
+	Append(FKey(CacheKey), TArrayView<const uint8>(), true, NextWriteTicks());
+}
+
+void FPackedDerivedDataStore::Flush()
+{
+	{
+		FScopeLock Lock(&WriterCS);
+		if (ActiveSegment)
+		{
+			SealSegment();
+		}
+	}
+
+	FScopeLock Lock(&CompactionTaskCS);
+	if (CompactionTask.IsValid())
+	{
+		CompactionTask.Wait();
+	}
+}
+
+int32 FPackedDerivedDataStore::GetNumSegments()
+{
+	FReadScopeLock Lock(SegmentsLock);
+	return Segments.Num();
+}
+
+bool FPackedDerivedDataStore::NeedsRefresh(uint32 WriteDay, bool bTouch) const
+{
+	// Like touching the files of the per file layout, used entries are written again before compaction drops them,
+	// or every day if touching is on. The copy keeps the write time, so that it doesn't hide later writes.
+	const uint32 Today = GetDay(FDateTime::UtcNow());
+	return !Params.bReadOnly && (bTouch ? WriteDay < Today : WriteDay + uint32(Params.DaysToDeleteUnused / 4) < Today);
+}
+
+bool FPackedDerivedDataStore::Append(const FKey& Key, TArrayView<const uint8> Data, bool bRemove, int64 WriteTicks)
+{
+	if (Params.bReadOnly)
+	{
+		return false;
+	}
+
+	FEntryHeader Header;
+	Header.Magic = EntryMagic;
+	Header.KeyLength = Key.Chars.Num();
+	Header.DataSize = Data.Num();
+	Header.DataCrc = FCrc::MemCrc32(Data.GetData(), Data.Num());
+	Header.KeyHash = Key.Hash;
+	Header.WriteTicks = WriteTicks;
+	Header.WriteDay = GetDay(FDateTime::UtcNow());
+	Header.HeaderCrc = GetHeaderCrc(Header, Key.Chars.GetData());
+
+	const uint32 EntrySize = GetEntrySize(Header.KeyLength, Header.DataSize);
+	const uint32 PaddingSize = EntrySize - sizeof(Header) - Header.KeyLength - Header.DataSize;
+	static const uint8 Padding[EntryAlignment] = {};
+
+	FScopeLock Lock(&WriterCS);
+
+	// Never appends to an old segment, so that other processes don't take it for the segment of a crashed writer
+	if (ActiveSegment && (ActiveOffset + EntrySize > MaxSegmentSize || FPlatformTime::Seconds() - ActiveStartTime >= Params.SealSeconds))
+	{
+		SealSegment();
+		StartCompaction();
+	}
+	if (!ActiveSegment && !StartSegment())
+	{
+		return false;
+	}
+
+	// A crash can leave a partial entry at the end, scans stop there and reads check the data CRC
+	if (!ActiveWriter->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header)) ||
+		!ActiveWriter->Write(reinterpret_cast<const uint8*>(Key.Chars.GetData()), Header.KeyLength) ||
+		!ActiveWriter->Write(Data.GetData(), Data.Num()) ||
+		!ActiveWriter->Write(Padding, PaddingSize))
+	{
+		UE_LOG(LogDerivedDataCache, Warning, TEXT("Failed to write to %s, starting a new segment."), *ActiveSegment->GetSegmentPath());
+		SealSegment();
+		return false;
+	}
+
+	{
+		FEntryLocation Location;
+		Location.Offset = uint32(ActiveOffset);
+		Location.Size = EntrySize;
+		Location.bRemoved = bRemove;
+		Location.WriteTicks = Header.WriteTicks;
+		Location.WriteDay = Header.WriteDay;
+
+		FWriteScopeLock SegmentsWriteLock(SegmentsLock);
+		FSegment::AddEntry(ActiveSegment->Entries, Key.Hash, Location);
+		ActiveOffset += EntrySize;
+		ActiveSegment->ScannedSize = ActiveOffset;
+	}
+
+	if (ActiveOffset >= Params.SegmentSize)
+	{
+		SealSegment();
+		StartCompaction();
+	}
+	return true;
+}
+
+FString FPackedDerivedDataStore::MakeSegmentName(int64 Ticks) const
+{
+	return FString::Printf(TEXT("%016llx_%s"), uint64(Ticks), *FGuid::NewGuid().ToString());
+}
+
+bool FPackedDerivedDataStore::StartSegment()
+{
+	// Names have to be unique and increasing within this process even if the clock is coarse
+	LastSegmentTicks = FMath::Max(FDateTime::UtcNow().GetTicks(), LastSegmentTicks + 1);
+	FSegmentRef Segment = MakeShared<FSegment, ESPMode::ThreadSafe>(Directory, MakeSegmentName(LastSegmentTicks));
+	Segment->bOwned = true;
+
+	ActiveWriter.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*Segment->GetSegmentPath(), /*bAppend*/ false, /*bAllowRead*/ true));
+	if (!ActiveWriter)
+	{
+		UE_LOG(LogDerivedDataCache, Warning, TEXT("Failed to create %s."), *Segment->GetSegmentPath());
+		return false;
+	}
+
+	ActiveSegment = Segment;
+	ActiveOffset = 0;
+	ActiveStartTime = FPlatformTime::Seconds();
+
+	FWriteScopeLock Lock(SegmentsLock);
+	Segments.Insert(MoveTemp(Segment), 0);
+	return true;
+}
+
+void FPackedDerivedDataStore::SealSegment()
+{
+	// Only this thread changes the entries of the active segment, they can be read without the lock
+	ActiveWriter.Reset();
+	FSegmentRef Segment = MoveTemp(ActiveSegment);
+	if (FSegment::WriteIndex(Segment->GetIndexPath(), Segment->Entries, ActiveOffset) && Segment->LoadIndex())
+	{
+		FWriteScopeLock Lock(SegmentsLock);
+		Segment->bSealed = true;
+		Segment->Entries.Empty();
+	}
+}
+
+void FPackedDerivedDataStore::SealOldSegment()
+{
+	FScopeLock Lock(&WriterCS);
+	if (ActiveSegment && FPlatformTime::Seconds() - ActiveStartTime >= Params.SealSeconds)
+	{
+		SealSegment();
+	}
+}
+
+bool FPackedDerivedDataStore::Tick(float DeltaTime)
+{
+	// Append only checks the age of the active segment on the next write. A writer that went idle would keep it unsealed
+	// until another process takes it for the segment of a crashed writer, while this one still holds it.
+	bool bOld = false;
+	if (WriterCS.TryLock())
+	{
+		bOld = ActiveSegment && FPlatformTime::Seconds() - ActiveStartTime >= Params.SealSeconds;
+		WriterCS.Unlock();
+	}
+	if (bOld)
+	{
+		// Sealing writes the index, which is too slow for the game thread on a network share
+		StartCompaction(/*bSealOld*/ true);
+	}
+	return true;
+}
+
+void FPackedDerivedDataStore::StartCompaction(bool bSealOld)
+{
+	if (!(Params.bCompact || bSealOld) || Params.bReadOnly || bStopping)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&CompactionTaskCS);
+	if (!CompactionTask.IsValid() || CompactionTask.IsReady())
+	{
+		// A thread of its own rather than the pool, merging can take minutes on a network share
+		CompactionTask = Async(EAsyncExecution::Thread, [this]()
+		{
+			if (!Params.bCompact)
+			{
+				SealOldSegment();
+				return 0;
+			}
+			return Compact();
+		});
+	}
+}
+
+bool FPackedDerivedDataStore::FindEntry(uint64 KeyHash, FSegmentRef& OutSegment, FEntryLocation& OutLocation)
+{
+	// The latest write wins, not the newest segment, so every segment is probed
+	FReadScopeLock Lock(SegmentsLock);
+	bool bFound = false;
+	FEntryLocation Location;
+	for (const FSegmentRef& Segment : Segments)
+	{
+		if (Segment->Find(KeyHash, Location) && (!bFound || Location.WriteTicks > OutLocation.WriteTicks))
+		{
+			OutSegment = Segment;
+			OutLocation = Location;
+			bFound = true;
+		}
+	}
+	return bFound;
+}
+
+bool FPackedDerivedDataStore::TryRescan(bool bForce)
+{
+	if (!RescanCS.TryLock())
+	{
+		return false;
+	}
+
+	bool bChanged = false;
+	if (bForce || FPlatformTime::Seconds() - LastRescanTime >= Params.RescanSeconds)
+	{
+		bChanged = Rescan();
+	}
+	RescanCS.Unlock();
+
+	if (bChanged)
+	{
+		StartCompaction();
+	}
+	return bChanged;
+}
+
+bool FPackedDerivedDataStore::Rescan()
+{
+	// Taken before listing, so that segments compacted away meanwhile are not added again
+	TArray<FSegmentRef> Known;
+	TArray<bool> KnownActive;
+	{
+		FReadScopeLock Lock(SegmentsLock);
+		Known = Segments;
+		for (const FSegmentRef& Segment : Segments)
+		{
+			KnownActive.Add(Segment->bOwned && !Segment->bSealed);
+		}
+	}
+
+	// Only the thread holding RescanCS changes segments of other processes, which are read here without the lock
+	TMap<FString, int64> SegmentSizes;
+	TSet<FString> Indexed;
+	IFileManager::Get().IterateDirectoryStat(*Directory, [&SegmentSizes, &Indexed](const TCHAR* Filename, const FFileStatData& Stat)
+	{
+		if (!Stat.bIsDirectory)
+		{
+			const FString Extension = FPaths::GetExtension(Filename);
+			if (Extension == TEXT("uds"))
+			{
+				SegmentSizes.Add(FPaths::GetBaseFilename(Filename), Stat.FileSize);
+			}
+			else if (Extension == TEXT("udx"))
+			{
+				Indexed.Add(FPaths::GetBaseFilename(Filename));
+			}
+		}
+		return true;
+	});
+
+	struct FScanned
+	{
+		FSegmentRef Segment;
+		TMap<uint64, FEntryLocation> Entries;
+		int64 ScannedSize;
+	};
+	TArray<FSegmentRef> Removed;
+	TArray<FSegmentRef> Sealed;
+	TArray<FScanned> Scanned;
+	for (int32 Index = 0; Index < Known.Num(); ++Index)
+	{
+		const FSegmentRef& Segment = Known[Index];
+		int64 FileSize = 0;
+		if (KnownActive[Index])
+		{
+			SegmentSizes.Remove(Segment->Name);
+		}
+		else if (!SegmentSizes.RemoveAndCopyValue(Segment->Name, FileSize))
+		{
+			Removed.Add(Segment);
+		}
+		else if (!Segment->bSealed)
+		{
+			if (Indexed.Contains(Segment->Name) && Segment->LoadIndex())
+			{
+				Sealed.Add(Segment);
+			}
+			else if (FileSize > Segment->ScannedSize)
+			{
+				FScanned& Scan = Scanned.AddDefaulted_GetRef();
+				Scan.Segment = Segment;
+				Scan.ScannedSize = Segment->Scan(Segment->ScannedSize, FileSize, Scan.Entries);
+			}
+		}
+	}
+
+	TArray<FSegmentRef> Added;
+	for (const TPair<FString, int64>& Pair : SegmentSizes)
+	{
+		FSegmentRef Segment = MakeShared<FSegment, ESPMode::ThreadSafe>(Directory, Pair.Key);
+		if (Indexed.Contains(Pair.Key) && Segment->LoadIndex())
+		{
+			Segment->bSealed = true;
+		}
+		else
+		{
+			Segment->ScannedSize = Segment->Scan(0, Pair.Value, Segment->Entries);
+		}
+		Added.Add(MoveTemp(Segment));
+	}
+
+	bool bChanged = Removed.Num() || Sealed.Num() || Added.Num();
+	{
+		FWriteScopeLock Lock(SegmentsLock);
+		for (const FSegmentRef& Segment : Removed)
+		{
+			Segments.Remove(Segment);
+		}
+		for (const FSegmentRef& Segment : Sealed)
+		{
+			Segment->bSealed = true;
+			Segment->Entries.Empty();
+		}
+		for (FScanned& Scan : Scanned)
+		{
+			bChanged |= Scan.Entries.Num() > 0;
+			for (const TPair<uint64, FEntryLocation>& Pair : Scan.Entries)
+			{
+				FSegment::AddEntry(Scan.Segment->Entries, Pair.Key, Pair.Value);
+			}
+			Scan.Segment->ScannedSize = Scan.ScannedSize;
+		}
+		for (FSegmentRef& Segment : Added)
+		{
+			// Compaction in this process may have added its output meanwhile
+			if (!Segments.ContainsByPredicate([&Segment](const FSegmentRef& Existing) { return Existing->Name == Segment->Name; }))
+			{
+				Segments.Add(MoveTemp(Segment));
+			}
+		}
+		Segments.Sort([](const FSegmentRef& A, const FSegmentRef& B) { return A->Name > B->Name; });
+	}
+
+	for (const FSegmentRef& Segment : Removed)
+	{
+		Segment->CloseReadHandle();
+	}
+
+	LastRescanTime = FPlatformTime::Seconds();
+	return bChanged;
+}
+
+bool FPackedDerivedDataStore::SealOrphans()
+{
+	TArray<FSegmentRef> Unsealed;
+	{
+		FReadScopeLock Lock(SegmentsLock);
+		for (const FSegmentRef& Segment : Segments)
+		{
+			if (!Segment->bSealed && !Segment->bOwned)
+			{
+				Unsealed.Add(Segment);
+			}
+		}
+	}
+
+	bool bSealedAny = false;
+	for (const FSegmentRef& Segment : Unsealed)
+	{
+		const FDateTime ModificationTime = IFileManager::Get().GetTimeStamp(*Segment->GetSegmentPath());
+		if (ModificationTime != FDateTime::MinValue() && (FDateTime::UtcNow() - ModificationTime).GetTotalSeconds() >= Params.OrphanSeconds)
+		{
+			UE_LOG(LogDerivedDataCache, Log, TEXT("Sealing %s, its writer stopped without sealing it."), *Segment->GetSegmentPath());
+			bSealedAny |= FSegment::WriteIndex(Segment->GetIndexPath(), Segment->Entries, Segment->ScannedSize);
+		}
+	}
+	return bSealedAny;
+}
+
+int32 FPackedDerivedDataStore::Compact()
+{
+	FScopeLock CompactLock(&CompactCS);
+	SealOldSegment();
+
+	// Up to date entries for the orphans, their index is loaded by the scan after sealing them
+	{
+		FScopeLock Lock(&RescanCS);
+		Rescan();
+		if (SealOrphans())
+		{
+			Rescan();
+		}
+	}
+
+	// The oldest run of sealed segments that fits into one. Entries keep their write time, so the output can take
+	// the place of its newest input without hiding later writes in the unsealed segments around it.
+	TArray<FSegmentRef> Sealed;
+	{
+		FReadScopeLock Lock(SegmentsLock);
+		for (int32 Index = Segments.Num() - 1; Index >= 0; --Index)
+		{
+			if (Segments[Index]->bSealed)
+			{
+				Sealed.Add(Segments[Index]);
+			}
+		}
+	}
+
+	// Entries are written shortly after their segment is created, with a margin for the day granularity of their time
+	const int64 ExpiredTicks = (FDateTime::UtcNow() - FTimespan::FromDays(Params.DaysToDeleteUnused + 2)).GetTicks();
+	const bool bTooMany = Sealed.Num() > Params.CompactAt;
+	const bool bExpired = Sealed.Num() && Sealed[0]->Ticks < ExpiredTicks;
+	TArray<FSegmentRef> Inputs;
+	for (int32 Start = 0; Start < Sealed.Num() && (bTooMany || bExpired) && Inputs.Num() == 0; ++Start)
+	{
+		int64 RunSize = 0;
+		int32 End = Start;
+		while (End < Sealed.Num() && (End == Start || RunSize + Sealed[End]->Size <= MaxCompactionSize))
+		{
+			RunSize += Sealed[End++]->Size;
+		}
+		if (End - Start >= 2 || (bExpired && Start == 0))
+		{
+			Inputs.Append(&Sealed[Start], End - Start);
+		}
+	}
+	if (Inputs.Num() == 0 || bStopping)
+	{
+		return 0;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	FSegmentRef Output = MergeSegments(Inputs);
+	if (!Output)
+	{
+		return 0;
+	}
+
+	// The output is in the list before the inputs are deleted, so that nothing goes missing in between.
+	// Another process compacting the same segments leaves a duplicate, which the next compaction drops.
+	const bool bEmpty = Output->NumIndexed == 0;
+	if (bEmpty)
+	{
+		IFileManager::Get().Delete(*Output->GetIndexPath(), false, false, true);
+		IFileManager::Get().Delete(*Output->GetSegmentPath(), false, false, true);
+	}
+	{
+		FWriteScopeLock Lock(SegmentsLock);
+		for (const FSegmentRef& Input : Inputs)
+		{
+			Segments.Remove(Input);
+		}
+		if (!bEmpty && !Segments.ContainsByPredicate([&Output](const FSegmentRef& Existing) { return Existing->Name == Output->Name; }))
+		{
+			Segments.Add(Output);
+		}
+		Segments.Sort([](const FSegmentRef& A, const FSegmentRef& B) { return A->Name > B->Name; });
+	}
+
+	int64 InputSize = 0;
+	for (const FSegmentRef& Input : Inputs)
+	{
+		InputSize += Input->Size;
+		Input->CloseReadHandle();
+		Input->ReleaseIndex();
+		// Segments still open in other processes can't be deleted on some platforms, they are merged again next time
+		if (IFileManager::Get().Delete(*Input->GetSegmentPath(), false, false, true))
+		{
+			IFileManager::Get().Delete(*Input->GetIndexPath(), false, false, true);
+		}
+	}
+	DeleteStaleTempFiles();
+
+	UE_LOG(LogDerivedDataCache, Log, TEXT("Compacted %d segments of %s from %.1fMB to %.1fMB in %.2fs."), Inputs.Num(), *Directory,
+		InputSize / (1024.0 * 1024.0), bEmpty ? 0.0 : Output->Size / (1024.0 * 1024.0), FPlatformTime::Seconds() - StartTime);
+	return Inputs.Num();
+}
+
+FPackedDerivedDataStore::FSegmentRef FPackedDerivedDataStore::MergeSegments(const TArray<FSegmentRef>& Inputs)
+{
+	// Named like the newest input so that it takes its place in the order
+	FSegmentRef Output = MakeShared<FSegment, ESPMode::ThreadSafe>(Directory, MakeSegmentName(Inputs.Last()->Ticks));
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Output->GetSegmentPath(), FILEWRITE_Silent | FILEWRITE_AllowRead));
+	if (!Writer)
+	{
+		return FSegmentRef();
+	}
+
+	// The latest write of each key across the inputs, ties go to the newer input
+	TMap<uint64, TPair<int32, FEntryLocation>> Latest;
+	for (int32 InputIndex = Inputs.Num() - 1; InputIndex >= 0; --InputIndex)
+	{
+		Inputs[InputIndex]->ForEachIndexed([&Latest, InputIndex](uint64 KeyHash, const FEntryLocation& Location)
+		{
+			const TPair<int32, FEntryLocation>* Existing = Latest.Find(KeyHash);
+			if (!Existing || Location.WriteTicks > Existing->Value.WriteTicks)
+			{
+				Latest.Add(KeyHash, TPair<int32, FEntryLocation>(InputIndex, Location));
+			}
+		});
+	}
+
+	// Removals can only be dropped if no other segment has an older entry that they hide
+	TArray<FSegmentRef> Others;
+	{
+		FReadScopeLock Lock(SegmentsLock);
+		for (const FSegmentRef& Segment : Segments)
+		{
+			if (!Inputs.Contains(Segment))
+			{
+				Others.Add(Segment);
+			}
+		}
+	}
+	TArray<TArray<TPair<uint64, FEntryLocation>>> KeptPerInput;
+	KeptPerInput.SetNum(Inputs.Num());
+	for (const TPair<uint64, TPair<int32, FEntryLocation>>& Pair : Latest)
+	{
+		bool bKeep = !Pair.Value.Value.bRemoved;
+		if (!bKeep)
+		{
+			FReadScopeLock Lock(SegmentsLock);
+			FEntryLocation Hidden;
+			bKeep = Others.ContainsByPredicate([&Pair, &Hidden](const FSegmentRef& Segment) { return Segment->Find(Pair.Key, Hidden); });
+		}
+		if (bKeep)
+		{
+			KeptPerInput[Pair.Value.Key].Emplace(Pair.Key, Pair.Value.Value);
+		}
+	}
+
+	const uint32 OldestDay = GetDay(FDateTime::UtcNow() - FTimespan::FromDays(Params.DaysToDeleteUnused));
+	TArray<uint8> Buffer;
+	bool bMerged = true;
+
+	for (int32 InputIndex = Inputs.Num() - 1; InputIndex >= 0 && bMerged; --InputIndex)
+	{
+		const FSegment& Input = *Inputs[InputIndex];
+		TArray<TPair<uint64, FEntryLocation>>& Kept = KeptPerInput[InputIndex];
+		Kept.Sort([](const TPair<uint64, FEntryLocation>& A, const TPair<uint64, FEntryLocation>& B) { return A.Value.Offset < B.Value.Offset; });
+
+		// Another process compacting the same segments may have deleted it already
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Input.GetSegmentPath(), FILEREAD_Silent | FILEREAD_AllowWrite));
+		bMerged = Reader.IsValid();
+		for (int32 Index = 0; Index < Kept.Num() && bMerged; ++Index)
+		{
+			const FEntryLocation& Location = Kept[Index].Value;
+			if (Location.Size < sizeof(FEntryHeader) || int64(Location.Offset) + Location.Size > Input.Size)
+			{
+				continue;
+			}
+			Buffer.SetNumUninitialized(Location.Size);
+			Reader->Seek(Location.Offset);
+			Reader->Serialize(Buffer.GetData(), Location.Size);
+			bMerged = !Reader->IsError() && !bStopping;
+
+			const FEntryHeader& Header = *reinterpret_cast<const FEntryHeader*>(Buffer.GetData());
+			const ANSICHAR* Key = reinterpret_cast<const ANSICHAR*>(Buffer.GetData() + sizeof(FEntryHeader));
+			if (!bMerged || GetEntrySize(FMath::Min(Header.KeyLength, MaxKeyLength), FMath::Min(Header.DataSize, RemovedFlag)) != Location.Size ||
+				!IsValidHeader(Header, Key) || Header.KeyHash != Kept[Index].Key ||
+				FCrc::MemCrc32(Key + Header.KeyLength, Header.DataSize) != Header.DataCrc || (!Location.bRemoved && Header.WriteDay < OldestDay))
+			{
+				continue;
+			}
+
+			FEntryLocation& OutputLocation = Output->Entries.Add(Kept[Index].Key);
+			OutputLocation = Location;
+			OutputLocation.Offset = uint32(Writer->Tell());
+			Writer->Serialize(Buffer.GetData(), Location.Size);
+		}
+	}
+
+	const int64 OutputSize = Writer->Tell();
+	bMerged = !Writer->IsError() && Writer->Close() && bMerged;
+	Writer.Reset();
+
+	if (!bMerged || !FSegment::WriteIndex(Output->GetIndexPath(), Output->Entries, OutputSize) || !Output->LoadIndex())
+	{
+		IFileManager::Get().Delete(*Output->GetIndexPath(), false, false, true);
+		IFileManager::Get().Delete(*Output->GetSegmentPath(), false, false, true);
+		return FSegmentRef();
+	}
+
+	Output->bSealed = true;
+	Output->Entries.Empty();
+	return Output;
+}
+
+void FPackedDerivedDataStore::DeleteStaleTempFiles()
+{
+	// Left by processes that crashed while writing an index
+	TArray<FString> Stale;
+	IFileManager::Get().IterateDirectoryStat(*Directory, [&Stale](const TCHAR* Filename, const FFileStatData& Stat)
+	{
+		if (!Stat.bIsDirectory && FPaths::GetExtension(Filename) == TEXT("tmp") && (FDateTime::UtcNow() - Stat.ModificationTime).GetTotalDays() > 1.0)
+		{
+			Stale.Add(Filename);
+		}
+		return true;
+	});
+
+	for (const FString& Filename : Stale)
+	{
+		IFileManager::Get().Delete(*Filename, false, false, true);
+	}
+}
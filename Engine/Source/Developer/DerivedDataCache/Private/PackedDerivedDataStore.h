@@ -0,0 +1,112 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Containers/Ticker.h"
+#include "Misc/ScopeRWLock.h"
+#include "Templates/SharedPointer.h"
+#include <atomic>
+
+class IFileHandle;
+
+/**
+ * Cache entries appended to large segment files rather than one file per key, used by the filesystem backend with Packed=true.
+ *
+ * Every process appends to a segment of its own, named by its creation time. Entries carry their write time, the latest
+ * write of a key wins whichever segment holds it, as a process can write to its older segment after another one started a
+ * newer segment. A segment is sealed by writing its hash index next to it once it is large or old enough, sealed segments
+ * are looked up through their memory mapped index. Segments of other processes that are still being written, or whose
+ * writer crashed, are scanned entry by entry on misses. Background compaction merges the oldest sealed segments, dropping
+ * removed, overwritten and unused entries.
+ *
+ * All methods can be called from any thread.
+ */
+class FPackedDerivedDataStore
+{
+public:
+	struct FParams
+	{
+		/** Size at which the active segment is sealed and a new one started */
+		int64 SegmentSize = 256 * 1024 * 1024;
+		/** Seconds after which the active segment is sealed even if it is small, so that other processes see its index. Also checked by a ticker while idle. */
+		double SealSeconds = 600.0;
+		/** Minimum seconds between scans for segments of other processes on a miss */
+		double RescanSeconds = 10.0;
+		/** Seconds a segment without index has to be unchanged before another process seals it for its crashed writer */
+		double OrphanSeconds = 3600.0;
+		/** Number of sealed segments above which the oldest are compacted */
+		int32 CompactAt = 32;
+		/** Entries not written or read for this many days are dropped by compaction */
+		int32 DaysToDeleteUnused = 15;
+		/** If false, compaction only runs when Compact is called */
+		bool bCompact = true;
+		bool bReadOnly = false;
+	};
+
+	FPackedDerivedDataStore(const FString& InDirectory, const FParams& InParams);
+	~FPackedDerivedDataStore();
+
+	/** bTouch refreshes the entry once a day, like touching the file of the per file layout, otherwise only before compaction would drop it */
+	bool Exists(const TCHAR* CacheKey, bool bTouch = false);
+	bool Get(const TCHAR* CacheKey, TArray<uint8>& OutData);
+	bool Put(const TCHAR* CacheKey, TArrayView<const uint8> Data);
+	void Remove(const TCHAR* CacheKey);
+
+	/** Seals the active segment and waits for background compaction */
+	void Flush();
+
+	/** Seals the active segment if it is old and the segments of crashed writers, and merges the oldest sealed segments if there are too many, returns the number merged */
+	int32 Compact();
+
+	/** Number of segments currently known, for stats and tests */
+	int32 GetNumSegments();
+
+private:
+	class FSegment;
+	struct FKey;
+	struct FEntryLocation;
+	using FSegmentRef = TSharedPtr<FSegment, ESPMode::ThreadSafe>;
+
+	/** WriteTicks orders the entry against other writes of the key, refreshes pass the time of the write they copy */
+	bool Append(const FKey& Key, TArrayView<const uint8> Data, bool bRemove, int64 WriteTicks);
+	bool NeedsRefresh(uint32 WriteDay, bool bTouch) const;
+	bool StartSegment();
+	void SealSegment();
+	void SealOldSegment();
+	bool Tick(float DeltaTime);
+	void StartCompaction(bool bSealOld = false);
+	bool FindEntry(uint64 KeyHash, FSegmentRef& OutSegment, FEntryLocation& OutLocation);
+	bool TryRescan(bool bForce);
+	bool Rescan();
+	bool SealOrphans();
+	FSegmentRef MergeSegments(const TArray<FSegmentRef>& Inputs);
+	void DeleteStaleTempFiles();
+	FString MakeSegmentName(int64 Ticks) const;
+
+	FString Directory;
+	FParams Params;
+
+	/** Known segments, newest first, their entries and seal state are also protected by this lock */
+	TArray<FSegmentRef> Segments;
+	FRWLock SegmentsLock;
+
+	/** The segment this process appends to */
+	FCriticalSection WriterCS;
+	FSegmentRef ActiveSegment;
+	TUniquePtr<IFileHandle> ActiveWriter;
+	int64 ActiveOffset = 0;
+	double ActiveStartTime = 0.0;
+	int64 LastSegmentTicks = 0;
+	FDelegateHandle TickerHandle;
+
+	/** Only one thread scans the directory at a time, the others carry on without waiting */
+	FCriticalSection RescanCS;
+	double LastRescanTime = 0.0;
+
+	FCriticalSection CompactCS;
+	FCriticalSection CompactionTaskCS;
+	TFuture<int32> CompactionTask;
+	std::atomic<bool> bStopping{ false };
+};
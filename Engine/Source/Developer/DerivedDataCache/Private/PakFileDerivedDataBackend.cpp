@@ -413,16 +413,36 @@ FCompressedPakFileDerivedDataBackend::FCompressedPakFileDerivedDataBackend(const
 {
 }
 
+FName FCompressedPakFileDerivedDataBackend::GetPutCompressionFormat()
+{
+	static const FName PutCompressionFormat = FCompression::IsFormatValid(NAME_Zstd) ? FName(NAME_Zstd) : FName(NAME_Zlib);
+	return PutCompressionFormat;
+}
+
+FName FCompressedPakFileDerivedDataBackend::GetCompressionFormat(TArrayView<const uint8> CompressedData)
+{
+	// zstd frame magic, zlib streams can never start with it
+	static const uint8 ZstdMagic[] = { 0x28, 0xB5, 0x2F, 0xFD };
+	if (CompressedData.Num() >= sizeof(ZstdMagic) && FMemory::Memcmp(CompressedData.GetData(), ZstdMagic, sizeof(ZstdMagic)) == 0)
+	{
+		return NAME_Zstd;
+	}
+	return NAME_Zlib;
+}
+
 void FCompressedPakFileDerivedDataBackend::PutCachedData(const TCHAR* CacheKey, TArrayView<const uint8> InData, bool bPutEvenIfExists)
 {
+	const FName CompressionFormat = GetPutCompressionFormat();
+	// BiasMemory is the zstd max level, far too slow for cache writes, zstd uses its default level instead
+	const ECompressionFlags PutCompressionFlags = CompressionFormat == NAME_Zstd ? COMPRESS_NoFlags : CompressionFlags;
 	int32 UncompressedSize = InData.Num();
-	int32 CompressedSize = FCompression::CompressMemoryBound(CompressionFormat, UncompressedSize, CompressionFlags);
+	int32 CompressedSize = FCompression::CompressMemoryBound(CompressionFormat, UncompressedSize, PutCompressionFlags);
 
 	TArray<uint8> CompressedData;
 	CompressedData.AddUninitialized(CompressedSize + sizeof(UncompressedSize));
 
 	FMemory::Memcpy(&CompressedData[0], &UncompressedSize, sizeof(UncompressedSize));
-	verify(FCompression::CompressMemory(CompressionFormat, CompressedData.GetData() + sizeof(UncompressedSize), CompressedSize, InData.GetData(), InData.Num(), CompressionFlags));
+	verify(FCompression::CompressMemory(CompressionFormat, CompressedData.GetData() + sizeof(UncompressedSize), CompressedSize, InData.GetData(), InData.Num(), PutCompressionFlags));
 	CompressedData.SetNum(CompressedSize + sizeof(UncompressedSize), false);
 
 	FPakFileDerivedDataBackend::PutCachedData(CacheKey, CompressedData, bPutEvenIfExists);
@@ -439,6 +459,7 @@ bool FCompressedPakFileDerivedDataBackend::GetCachedData(const TCHAR* CacheKey,
 	int32 UncompressedSize;
 	FMemory::Memcpy(&UncompressedSize, &CompressedData[0], sizeof(UncompressedSize));
 	OutData.SetNum(UncompressedSize);
+	const FName CompressionFormat = GetCompressionFormat(MakeArrayView(CompressedData).Slice(sizeof(UncompressedSize), CompressedData.Num() - sizeof(UncompressedSize)));
 	verify(FCompression::UncompressMemory(CompressionFormat, OutData.GetData(), UncompressedSize, CompressedData.GetData() + sizeof(UncompressedSize), CompressedData.Num() - sizeof(UncompressedSize), CompressionFlags));
 
 	return true;
@@ -148,6 +148,9 @@ public:
 	}
 
 private:
-	static const EName CompressionFormat = NAME_Zlib;
+	/** Zstd when available, entries don't store their format so reads tell zlib and zstd apart from the data */
+	static FName GetPutCompressionFormat();
+	static FName GetCompressionFormat(TArrayView<const uint8> CompressedData);
+
 	static const ECompressionFlags CompressionFlags = COMPRESS_BiasMemory;
 };
@@ -0,0 +1,349 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+#include "DerivedDataBackendInterface.h"
+#include "HAL/FileManager.h"
+#include "HAL/ThreadHeartBeat.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+#include "PackedDerivedDataStore.h"
+#include <atomic>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+FDerivedDataBackendInterface* CreateFileSystemDerivedDataBackend(const TCHAR* CacheDirectory, const TCHAR* InParams, const TCHAR* InAccessLogFileName = nullptr);
+
+namespace PackedDerivedDataStoreTest
+{
+	static FString MakeKey(int32 Index)
+	{
+		return FString::Printf(TEXT("PackedTest_%d"), Index);
+	}
+
+	static TArray<uint8> MakeData(int32 Index, int32 Version)
+	{
+		TArray<uint8> Data;
+		Data.SetNumUninitialized(1 + (Index * 7919) % 3000);
+		for (int32 Byte = 0; Byte < Data.Num(); ++Byte)
+		{
+			Data[Byte] = uint8(Index + Version * 31 + Byte);
+		}
+		return Data;
+	}
+
+	/** Number of keys the store disagrees with Expected about, keys missing from Expected were removed */
+	static int32 CountWrong(FPackedDerivedDataStore& Store, const TMap<int32, TArray<uint8>>& Expected, int32 NumKeys)
+	{
+		int32 NumWrong = 0;
+		TArray<uint8> Data;
+		for (int32 Index = 0; Index < NumKeys; ++Index)
+		{
+			const TArray<uint8>* Value = Expected.Find(Index);
+			const bool bFound = Store.Get(*MakeKey(Index), Data);
+			NumWrong += bFound != (Value != nullptr) || Store.Exists(*MakeKey(Index)) != bFound || (Value && *Value != Data);
+		}
+		return NumWrong;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPackedDerivedDataStoreTest, "System.DerivedDataCache.PackedStore", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPackedDerivedDataStoreTest::RunTest(const FString& Parameters)
+{
+	using namespace PackedDerivedDataStoreTest;
+
+	const FString Directory = FPaths::AutomationTransientDir() / TEXT("PackedDDC") / FGuid::NewGuid().ToString();
+	FPackedDerivedDataStore::FParams Params;
+	Params.SegmentSize = 64 * 1024;
+	Params.RescanSeconds = 0.0;
+	Params.CompactAt = 2;
+	Params.bCompact = false;
+
+	// Puts, removals and overwrites seen by the writer and by a second store on the same directory standing in for another process
+	const int32 NumKeys = 1000;
+	TMap<int32, TArray<uint8>> Expected;
+	{
+		FPackedDerivedDataStore Writer(Directory, Params);
+		FPackedDerivedDataStore Reader(Directory, Params);
+		for (int32 Index = 0; Index < NumKeys; ++Index)
+		{
+			Writer.Put(*MakeKey(Index), MakeData(Index, 0));
+			Expected.Add(Index, MakeData(Index, 0));
+		}
+		for (int32 Index = 0; Index < NumKeys; Index += 5)
+		{
+			Writer.Remove(*MakeKey(Index));
+			Expected.Remove(Index);
+		}
+		for (int32 Index = 0; Index < NumKeys; Index += 7)
+		{
+			Writer.Put(*MakeKey(Index), MakeData(Index, 1));
+			Expected.Add(Index, MakeData(Index, 1));
+		}
+
+		TestTrue(TEXT("Sealed segments"), Writer.GetNumSegments() > 1);
+		TestEqual(TEXT("Writer"), CountWrong(Writer, Expected, NumKeys), 0);
+		TestEqual(TEXT("Other process"), CountWrong(Reader, Expected, NumKeys), 0);
+	}
+
+	// A writer that crashed: a copy of the newest segment without index and with a partial entry at the end
+	TArray<FString> SegmentFiles;
+	IFileManager::Get().FindFiles(SegmentFiles, *(Directory / TEXT("*.uds")), true, false);
+	SegmentFiles.Sort();
+	if (!TestTrue(TEXT("Segment files"), SegmentFiles.Num() > 0))
+	{
+		return false;
+	}
+	const uint64 NewestTicks = FCString::Strtoui64(*SegmentFiles.Last().Left(16), nullptr, 16);
+	const FString OrphanPath = Directory / FString::Printf(TEXT("%016llx_%s.uds"), NewestTicks + 1, *FGuid::NewGuid().ToString());
+	IFileManager::Get().Copy(*OrphanPath, *(Directory / SegmentFiles.Last()));
+	{
+		TUniquePtr<FArchive> Orphan(IFileManager::Get().CreateFileWriter(*OrphanPath, FILEWRITE_Append));
+		uint8 Torn[20] = { 0x44, 0x44, 0x43, 0x32, 0xff };
+		Orphan->Serialize(Torn, sizeof(Torn));
+	}
+
+	Params.OrphanSeconds = 0.0;
+	{
+		FPackedDerivedDataStore Store(Directory, Params);
+		TestEqual(TEXT("After a crash"), CountWrong(Store, Expected, NumKeys), 0);
+
+		const int32 NumSegments = Store.GetNumSegments();
+		int32 NumMerged = 0;
+		while (int32 Merged = Store.Compact())
+		{
+			NumMerged += Merged;
+		}
+		TestTrue(TEXT("Compacted"), NumMerged > 0 && Store.GetNumSegments() <= Params.CompactAt && Store.GetNumSegments() < NumSegments);
+		TestEqual(TEXT("After compaction"), CountWrong(Store, Expected, NumKeys), 0);
+	}
+
+	{
+		FPackedDerivedDataStore Store(Directory, Params);
+		TestEqual(TEXT("Reopened"), CountWrong(Store, Expected, NumKeys), 0);
+	}
+	IFileManager::Get().DeleteDirectory(*Directory, false, true);
+
+	// The active segment of another process, unsealed and right after the oldest segment, overwrites and removes keys of it.
+	// Compaction merges the sealed segments around it, its output is named newer but may not bring the old values back.
+	const FString ActiveDirectory = Directory + TEXT("_Active");
+	const int32 NumActiveKeys = 10;
+	Params.OrphanSeconds = 3600.0;
+	Expected.Reset();
+	{
+		FPackedDerivedDataStore Writer(Directory, Params);
+		for (int32 Index = 0; Index < NumKeys; ++Index)
+		{
+			Writer.Put(*MakeKey(Index), MakeData(Index, 0));
+			Expected.Add(Index, MakeData(Index, 0));
+		}
+	}
+	{
+		FPackedDerivedDataStore Active(ActiveDirectory, Params);
+		for (int32 Index = 0; Index < NumActiveKeys; ++Index)
+		{
+			if (Index % 2)
+			{
+				Active.Put(*MakeKey(Index), MakeData(Index, 2));
+				Expected.Add(Index, MakeData(Index, 2));
+			}
+			else
+			{
+				Active.Remove(*MakeKey(Index));
+				Expected.Remove(Index);
+			}
+		}
+	}
+
+	TArray<FString> ActiveFiles;
+	SegmentFiles.Reset();
+	IFileManager::Get().FindFiles(SegmentFiles, *(Directory / TEXT("*.uds")), true, false);
+	IFileManager::Get().FindFiles(ActiveFiles, *(ActiveDirectory / TEXT("*.uds")), true, false);
+	SegmentFiles.Sort();
+	if (!TestTrue(TEXT("Segment files around the active one"), SegmentFiles.Num() > 2 && ActiveFiles.Num() == 1))
+	{
+		return false;
+	}
+	const uint64 OldestTicks = FCString::Strtoui64(*SegmentFiles[0].Left(16), nullptr, 16);
+	IFileManager::Get().Copy(*(Directory / FString::Printf(TEXT("%016llx_%s.uds"), OldestTicks + 1, *FGuid::NewGuid().ToString())), *(ActiveDirectory / ActiveFiles[0]));
+	IFileManager::Get().DeleteDirectory(*ActiveDirectory, false, true);
+
+	Params.CompactAt = 1;
+	{
+		FPackedDerivedDataStore Store(Directory, Params);
+		TestEqual(TEXT("With an active segment"), CountWrong(Store, Expected, NumKeys), 0);
+
+		int32 NumMerged = 0;
+		while (int32 Merged = Store.Compact())
+		{
+			NumMerged += Merged;
+		}
+		TestTrue(TEXT("Compacted around the active segment"), NumMerged > 0 && Store.GetNumSegments() == 2);
+		TestEqual(TEXT("After compaction around an active segment"), CountWrong(Store, Expected, NumKeys), 0);
+	}
+	IFileManager::Get().DeleteDirectory(*Directory, false, true);
+
+	// A process that writes to its older segment after another process started a newer one with the old value
+	Expected.Reset();
+	Params.CompactAt = 1;
+	{
+		FPackedDerivedDataStore First(Directory, Params);
+		FPackedDerivedDataStore Second(Directory, Params);
+		First.Put(*MakeKey(0), MakeData(0, 0));
+		Second.Put(*MakeKey(0), MakeData(0, 1));
+		Second.Put(*MakeKey(1), MakeData(1, 1));
+		First.Put(*MakeKey(0), MakeData(0, 2));
+		First.Remove(*MakeKey(1));
+		Expected.Add(0, MakeData(0, 2));
+		TestEqual(TEXT("Later write to the older segment"), CountWrong(First, Expected, 2), 0);
+
+		FPackedDerivedDataStore Reader(Directory, Params);
+		TestEqual(TEXT("Later write to the older segment in another process"), CountWrong(Reader, Expected, 2), 0);
+	}
+	{
+		FPackedDerivedDataStore Store(Directory, Params);
+		TestTrue(TEXT("Compacted both writers"), Store.Compact() == 2);
+		TestEqual(TEXT("Later write after compaction"), CountWrong(Store, Expected, 2), 0);
+	}
+	IFileManager::Get().DeleteDirectory(*Directory, false, true);
+
+	// An idle writer's segment is sealed without waiting for its next write
+	Params.SealSeconds = 0.0;
+	{
+		FPackedDerivedDataStore Writer(Directory, Params);
+		Writer.Put(*MakeKey(0), MakeData(0, 0));
+		TArray<FString> IndexFiles;
+		IFileManager::Get().FindFiles(IndexFiles, *(Directory / TEXT("*.udx")), true, false);
+		TestEqual(TEXT("Active segment without index"), IndexFiles.Num(), 0);
+
+		Writer.Compact();
+		IndexFiles.Reset();
+		IFileManager::Get().FindFiles(IndexFiles, *(Directory / TEXT("*.udx")), true, false);
+		TestEqual(TEXT("Idle segment sealed"), IndexFiles.Num(), 1);
+	}
+
+	IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPackedDerivedDataStoreBenchmark, "System.DerivedDataCache.PackedStore.Benchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+/**
+ * Puts, cold exists, gets and misses from many threads through the filesystem backend with a file per key and with Packed=true,
+ * and the time to list what is on disk like DDC cleanup does. -PackedDDCBenchmarkEntries= and -PackedDDCBenchmarkSize= (bytes)
+ * override the default of 1M entries of 1KB.
+ */
+bool FPackedDerivedDataStoreBenchmark::RunTest(const FString& Parameters)
+{
+	FSlowHeartBeatScope SuspendHeartBeat;
+
+	int32 NumEntries = 1000000;
+	int32 EntrySize = 1024;
+	FParse::Value(FCommandLine::Get(), TEXT("PackedDDCBenchmarkEntries="), NumEntries);
+	FParse::Value(FCommandLine::Get(), TEXT("PackedDDCBenchmarkSize="), EntrySize);
+	const int32 NumMisses = FMath::Max(NumEntries / 10, 1);
+
+	// Unique keys, in a random order for the reads
+	const FString Prefix = FGuid::NewGuid().ToString();
+	TArray<FString> Keys;
+	for (int32 Index = 0; Index < NumEntries + NumMisses; ++Index)
+	{
+		Keys.Add(FString::Printf(TEXT("BENCH_%s_%d"), *Prefix, Index));
+	}
+	TArray<int32> Order;
+	for (int32 Index = 0; Index < NumEntries; ++Index)
+	{
+		Order.Add(Index);
+	}
+	FRandomStream Random(1234);
+	for (int32 Index = Order.Num() - 1; Index > 0; --Index)
+	{
+		Order.Swap(Index, Random.RandHelper(Index + 1));
+	}
+
+	TArray<uint8> Data;
+	Data.SetNumUninitialized(EntrySize);
+	for (uint8& Byte : Data)
+	{
+		Byte = uint8(Random.RandHelper(256));
+	}
+
+	const FString Root = FPaths::AutomationTransientDir() / TEXT("PackedDDCBenchmark") / Prefix;
+	const TCHAR* Layouts[][2] = { { TEXT("Files"), TEXT("DeleteUnused=false") }, { TEXT("Packed"), TEXT("DeleteUnused=false Packed=true") } };
+	for (const TCHAR* const* Layout : Layouts)
+	{
+		const FString Directory = Root / Layout[0];
+		double PutSeconds, ExistsSeconds, GetSeconds, MissSeconds;
+		std::atomic<int32> NumFound{ 0 };
+		{
+			TUniquePtr<FDerivedDataBackendInterface> Backend(CreateFileSystemDerivedDataBackend(*Directory, Layout[1]));
+			if (!TestNotNull(TEXT("Backend"), Backend.Get()))
+			{
+				return false;
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+			ParallelFor(NumEntries, [&Backend, &Keys, &Data](int32 Index)
+			{
+				Backend->PutCachedData(*Keys[Index], Data, /*bPutEvenIfExists*/ true);
+			});
+			PutSeconds = FPlatformTime::Seconds() - StartTime;
+		}
+
+		// A new instance, so that the packed index is loaded like on startup
+		{
+			TUniquePtr<FDerivedDataBackendInterface> Backend(CreateFileSystemDerivedDataBackend(*Directory, Layout[1]));
+			if (!TestNotNull(TEXT("Backend"), Backend.Get()))
+			{
+				return false;
+			}
+
+			double StartTime = FPlatformTime::Seconds();
+			ParallelFor(NumEntries, [&Backend, &Keys, &Order, &NumFound](int32 Index)
+			{
+				NumFound += Backend->CachedDataProbablyExists(*Keys[Order[Index]]);
+			});
+			ExistsSeconds = FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			ParallelFor(NumEntries, [&Backend, &Keys, &Order, &NumFound](int32 Index)
+			{
+				TArray<uint8> Value;
+				NumFound += Backend->GetCachedData(*Keys[Order[Index]], Value);
+			});
+			GetSeconds = FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			ParallelFor(NumMisses, [&Backend, &Keys, &NumFound, NumEntries](int32 Index)
+			{
+				NumFound += Backend->CachedDataProbablyExists(*Keys[NumEntries + Index]);
+			});
+			MissSeconds = FPlatformTime::Seconds() - StartTime;
+		}
+		TestEqual(FString::Printf(TEXT("%s hits"), Layout[0]), NumFound.load(), NumEntries * 2);
+
+		int32 NumFiles = 0;
+		int64 TotalSize = 0;
+		const double StartTime = FPlatformTime::Seconds();
+		IFileManager::Get().IterateDirectoryStatRecursively(*Directory, [&NumFiles, &TotalSize](const TCHAR* Filename, const FFileStatData& Stat)
+		{
+			NumFiles += !Stat.bIsDirectory;
+			TotalSize += Stat.bIsDirectory ? 0 : Stat.FileSize;
+			return true;
+		});
+		const double ScanSeconds = FPlatformTime::Seconds() - StartTime;
+
+		AddInfo(FString::Printf(TEXT("%s, %d entries of %d bytes: put %.0f/s, cold exists %.0f/s, get %.0f/s (%.1fMB/s), miss %.0f/s, %d files of %.1fMB listed in %.2fs"),
+			Layout[0], NumEntries, EntrySize, NumEntries / PutSeconds, NumEntries / ExistsSeconds, NumEntries / GetSeconds, NumEntries * double(EntrySize) / GetSeconds / (1024.0 * 1024.0),
+			NumMisses / MissSeconds, NumFiles, TotalSize / (1024.0 * 1024.0), ScanSeconds));
+
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
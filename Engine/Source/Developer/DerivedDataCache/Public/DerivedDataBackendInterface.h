@@ -114,6 +114,24 @@ public:
 	 * @return				true if any data was found, and in this case OutData is non-empty
 	 */
 	virtual bool GetCachedData(const TCHAR* CacheKey, TArray<uint8>& OutData)=0;
+	/**
+	 * Synchronous retrieve of several cache items. Backends that can overlap the requests override this, by default the items are retrieved one at a time.
+	 *
+	 * @param	CacheKeys	Alphanumeric+underscore keys of the cache items
+	 * @param	OutData		One buffer per key to receive the results of the keys that were found
+	 * @param	OutHits		One bit per key, set for the keys that were found. Keys whose bit is already set are skipped.
+	 */
+	virtual void GetCachedDataBatch(TArrayView<const FString> CacheKeys, TArrayView<TArray<uint8>> OutData, TBitArray<>& OutHits)
+	{
+		check(OutData.Num() == CacheKeys.Num() && OutHits.Num() == CacheKeys.Num());
+		for (int32 Index = 0; Index < CacheKeys.Num(); Index++)
+		{
+			if (!OutHits[Index])
+			{
+				OutHits[Index] = GetCachedData(*CacheKeys[Index], OutData[Index]);
+			}
+		}
+	}
 	/**
 	 * Asynchronous, fire-and-forget placement of a cache item
 	 *
@@ -196,6 +196,46 @@ public:
 	 */
 	virtual bool CachedDataProbablyExists(const TCHAR* CacheKey) = 0;
 
+	/** Priority of a batch request. Batches that are waiting for a worker are started in priority order. */
+	enum class EPriority : uint8
+	{
+		Low,
+		Normal,
+		High,
+	};
+
+	/** Called once a batch request is complete, with one buffer per key that is empty for the keys that were not found. */
+	using FOnGetBatchComplete = TUniqueFunction<void(TArray<TArray<uint8>>&& Results)>;
+
+	/**
+	 * Synchronously checks the cache for several items at once, letting the backends overlap the requests.
+	 *
+	 * @param	CacheKeys		Keys to identify the data.
+	 * @param	OutData			Receives one buffer per key, empty for the keys that were not found.
+	 * @param	DebugContext	A string used to describe the data being requested.
+	 * @return	The number of keys that were found.
+	**/
+	virtual int32 GetSynchronousBatch(TArrayView<const FString> CacheKeys, TArray<TArray<uint8>>& OutData, FStringView DebugContext) = 0;
+
+	/**
+	 * Starts checking the cache for several items at once, letting the backends overlap the requests.
+	 *
+	 * @param	CacheKeys		Keys to identify the data.
+	 * @param	DebugContext	A string used to describe the data being requested.
+	 * @param	Priority		Batches with a higher priority are started first when more are waiting than there are workers.
+	 * @param	OnComplete		Called from a worker thread with the results once every key has been checked.
+	**/
+	virtual void GetAsynchronousBatch(TArrayView<const FString> CacheKeys, FStringView DebugContext, EPriority Priority, FOnGetBatchComplete&& OnComplete) = 0;
+
+	/**
+	 * Puts several items into the cache. This is fire-and-forget and typically asynchronous.
+	 *
+	 * @param	CacheKeys	Keys to identify the data.
+	 * @param	Data		Data to put in the cache, one buffer per key.
+	 * @param	DataContext	A string used to describe the data being generated.
+	**/
+	virtual void PutBatch(TArrayView<const FString> CacheKeys, TArrayView<const TArray<uint8>> Data, FStringView DataContext, bool bPutEvenIfExists = false) = 0;
+
 	//--------------------
 	// System Interface
 	//--------------------
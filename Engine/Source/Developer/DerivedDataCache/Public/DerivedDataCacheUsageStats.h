@@ -79,6 +79,15 @@ public:
 		return FCookStats::FScopedStatsCounter(PrefetchStats);
 	}
 
+	/** Call this for each key of the GetCachedDataBatch override, which times the whole batch with TimeGet() and TrackCyclesOnly(). */
+	void AddGetHitOrMiss(bool bHit, int64 BytesProcessed)
+	{
+		const FCookStats::CallStats::EHitOrMiss HitOrMiss = bHit ? FCookStats::CallStats::EHitOrMiss::Hit : FCookStats::CallStats::EHitOrMiss::Miss;
+		const bool bIsInGameThread = IsInGameThread();
+		GetStats.Accumulate(HitOrMiss, FCookStats::CallStats::EStatType::Counter, 1l, bIsInGameThread);
+		GetStats.Accumulate(HitOrMiss, FCookStats::CallStats::EStatType::Bytes, BytesProcessed, bIsInGameThread);
+	}
+
 	void LogStats(FCookStatsManager::AddStatFuncRef AddStat, const FString& StatName, const FString& NodeName) const
 	{
 		GetStats.LogStats(AddStat, StatName, NodeName, TEXT("Get"));
@@ -531,6 +531,7 @@ struct FIoStoreArguments
 	FString BasedOnReleaseVersionPath;
 	FAssetRegistryState ReleaseAssetRegistry;
 	FReleasedPackages ReleasedPackages;
+	TArray<uint8> CompressionDictionary;
 	bool bSign = false;
 	bool bRemapPluginContentToGame = false;
 	bool bCreateDirectoryIndex = true;
@@ -3817,6 +3818,7 @@ int32 CreateTarget(const FIoStoreArguments& Arguments, const FIoStoreWriterSetti
 					ContainerSettings.ContainerFlags |= EIoContainerFlags::Signed;
 				}
 				ContainerSettings.bGenerateDiffPatch = ContainerTarget->bGenerateDiffPatch;
+				ContainerSettings.CompressionDictionary = Arguments.CompressionDictionary;
 				IoStatus = ContainerTarget->IoStoreWriter->Initialize(*IoStoreWriterContext, ContainerSettings, ContainerTarget->PatchSourceReaders);
 				check(IoStatus.IsOk());
 			}
@@ -5694,6 +5696,17 @@ int32 CreateIoStoreContainerFiles(const TCHAR* CmdLine)
 	Arguments.bCreateDirectoryIndex = !FParse::Param(FCommandLine::Get(), TEXT("NoDirectoryIndex"));
 	UE_LOG(LogIoStore, Display, TEXT("Directory index - %s"), Arguments.bCreateDirectoryIndex  ? TEXT("ENABLED") : TEXT("DISABLED"));
 
+	FString CompressionDictionaryPath;
+	if (FParse::Value(FCommandLine::Get(), TEXT("-zstddictionary="), CompressionDictionaryPath))
+	{
+		if (!FFileHelper::LoadFileToArray(Arguments.CompressionDictionary, *CompressionDictionaryPath))
+		{
+			UE_LOG(LogIoStore, Error, TEXT("Failed to load zstd dictionary '%s'"), *CompressionDictionaryPath);
+			return -1;
+		}
+		UE_LOG(LogIoStore, Display, TEXT("Using zstd dictionary '%s'"), *CompressionDictionaryPath);
+	}
+
 	FString PatchReferenceCryptoKeysFilename;
 	FKeyChain PatchKeyChain;
 	if (FParse::Value(FCommandLine::Get(), TEXT("PatchCryptoKeys="), PatchReferenceCryptoKeysFilename))
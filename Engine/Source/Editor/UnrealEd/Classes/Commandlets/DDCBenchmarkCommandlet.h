@@ -0,0 +1,21 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "Commandlets/Commandlet.h"
+#include "DDCBenchmarkCommandlet.generated.h"
+
+/**
+ * Measures how many keys per second the configured DDC graph returns, comparing one async get per key to batch gets.
+ * Run with -run=DDCBenchmark [-ddc=Graph] [-keys=10000] [-size=64] [-batch=256] [-runs=3]
+ */
+UCLASS()
+class UDDCBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
@@ -19,6 +19,7 @@
 #include "CollectionManagerModule.h"
 #include "Interfaces/ITargetPlatform.h"
 #include "AssetRegistryModule.h"
+#include "AssetRegistry/AssetRegistryMappedState.h"
 #include "GameDelegates.h"
 #include "Commandlets/IChunkDataGenerator.h"
 #include "Commandlets/ChunkDependencyInfo.h"
@@ -276,6 +277,17 @@ static void AssignLayerChunkDelegate(const FAssignLayerChunkMap* ChunkManifest,
 	}
 }
 
+/** Writes State next to the registry at RegistryPath in the format FAssetRegistryMappedState reads, e.g. AssetRegistryMapped.bin */
+static void SaveMappedAssetRegistry(const FAssetRegistryState& State, const FAssetRegistrySerializationOptions& Options, const FString& RegistryPath)
+{
+	FArrayWriter SerializedMappedRegistry;
+	FAssetRegistryMappedState::Save(State, SerializedMappedRegistry, Options);
+
+	const FString MappedPath = FPaths::ChangeExtension(RegistryPath, TEXT("")) + TEXT("Mapped.bin");
+	FFileHelper::SaveArrayToFile(SerializedMappedRegistry, *MappedPath);
+	UE_LOG(LogAssetRegistryGenerator, Display, TEXT("Generated mapped asset registry %s, size is %5.2fkb"), *FPaths::GetCleanFilename(MappedPath), (float)SerializedMappedRegistry.Num() / 1024.f);
+}
+
 void IChunkDataGenerator::GenerateChunkDataFiles(const int32 InChunkId, const TSet<FName>& InPackagesInChunk, const ITargetPlatform* TargetPlatform, FSandboxPlatformFile* InSandboxFile, TArray<FString>& OutChunkFilenames)
 {
 	PRAGMA_DISABLE_DEPRECATION_WARNINGS
@@ -1380,6 +1392,10 @@ bool FAssetRegistryGenerator::SaveAssetRegistry(const FString& SandboxPath, bool
 				PlatformSandboxPath += ChunkBucketNames[ChunkBucketElement.Key] + TEXT(".") + SandboxPathExtension;
 
 				FFileHelper::SaveArrayToFile(SerializedAssetRegistry, *PlatformSandboxPath);
+				if (SaveOptions.bSerializeMapped)
+				{
+					SaveMappedAssetRegistry(NewState, SaveOptions, PlatformSandboxPath);
+				}
 
 				FString FilenameForLog;
 				if (ChunkBucketElement.Key != GenericChunkBucket)
@@ -1407,6 +1423,10 @@ bool FAssetRegistryGenerator::SaveAssetRegistry(const FString& SandboxPath, bool
 			// Save the generated registry
 			FString PlatformSandboxPath = SandboxPath.Replace(TEXT("[Platform]"), *TargetPlatform->PlatformName());
 			FFileHelper::SaveArrayToFile(SerializedAssetRegistry, *PlatformSandboxPath);
+			if (SaveOptions.bSerializeMapped)
+			{
+				SaveMappedAssetRegistry(State, SaveOptions, PlatformSandboxPath);
+			}
 			UE_LOG(LogAssetRegistryGenerator, Display, TEXT("Generated asset registry num assets %d, size is %5.2fkb"), ObjectToDataMap.Num(), (float)SerializedAssetRegistry.Num() / 1024.f);
 		}
 	}
@@ -0,0 +1,157 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Commandlets/DDCBenchmarkCommandlet.h"
+#include "DerivedDataCacheInterface.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/Guid.h"
+#include "Misc/Parse.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogDDCBenchmark, Log, All);
+
+namespace DDCBenchmark
+{
+	/** Payload of a key, the index is written at the start so that results can be checked against the key they were requested for */
+	static TArray<uint8> MakePayload(int32 Index, int32 Size)
+	{
+		TArray<uint8> Payload;
+		Payload.SetNumUninitialized(FMath::Max<int32>(Size, sizeof(int32)));
+		FRandomStream Random(Index);
+		for (uint8& Byte : Payload)
+		{
+			Byte = uint8(Random.GetUnsignedInt());
+		}
+		FMemory::Memcpy(Payload.GetData(), &Index, sizeof(int32));
+		return Payload;
+	}
+
+	static bool IsPayloadOf(const TArray<uint8>& Payload, int32 Index, int32 Size)
+	{
+		int32 PayloadIndex = INDEX_NONE;
+		if (Payload.Num() == FMath::Max<int32>(Size, sizeof(int32)))
+		{
+			FMemory::Memcpy(&PayloadIndex, Payload.GetData(), sizeof(int32));
+		}
+		return PayloadIndex == Index;
+	}
+
+	/** One GetAsynchronous per key, all of them in flight at once like the loads of a map */
+	static int32 GetPerKey(FDerivedDataCacheInterface& DDC, const TArray<FString>& Keys, int32 Size)
+	{
+		TArray<uint32> Handles;
+		Handles.Reserve(Keys.Num());
+		for (const FString& Key : Keys)
+		{
+			Handles.Add(DDC.GetAsynchronous(*Key, TEXT("DDCBenchmark")));
+		}
+
+		int32 NumValid = 0;
+		TArray<uint8> Payload;
+		for (int32 Index = 0; Index < Keys.Num(); Index++)
+		{
+			DDC.WaitAsynchronousCompletion(Handles[Index]);
+			NumValid += DDC.GetAsynchronousResults(Handles[Index], Payload) && IsPayloadOf(Payload, Index, Size);
+		}
+		return NumValid;
+	}
+
+	/** The same keys requested with GetAsynchronousBatch, BatchSize keys per request */
+	static int32 GetBatched(FDerivedDataCacheInterface& DDC, const TArray<FString>& Keys, int32 Size, int32 BatchSize)
+	{
+		std::atomic<int32> NumValid{ 0 };
+		std::atomic<int32> NumPending{ 0 };
+		for (int32 First = 0; First < Keys.Num(); First += BatchSize)
+		{
+			const int32 Num = FMath::Min(BatchSize, Keys.Num() - First);
+			++NumPending;
+			DDC.GetAsynchronousBatch(MakeArrayView(Keys).Slice(First, Num), TEXT("DDCBenchmark"), FDerivedDataCacheInterface::EPriority::Normal,
+				[First, Size, &NumValid, &NumPending](TArray<TArray<uint8>>&& Results)
+				{
+					int32 NumBatchValid = 0;
+					for (int32 Index = 0; Index < Results.Num(); Index++)
+					{
+						NumBatchValid += IsPayloadOf(Results[Index], First + Index, Size);
+					}
+					NumValid += NumBatchValid;
+					--NumPending;
+				});
+		}
+
+		while (NumPending > 0)
+		{
+			FPlatformProcess::SleepNoStats(0.0001f);
+		}
+		return NumValid;
+	}
+}
+
+int32 UDDCBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace DDCBenchmark;
+
+	int32 NumKeys = 10000;
+	int32 SizeKB = 64;
+	int32 BatchSize = 256;
+	int32 NumRuns = 3;
+	FParse::Value(*Params, TEXT("keys="), NumKeys);
+	FParse::Value(*Params, TEXT("size="), SizeKB);
+	FParse::Value(*Params, TEXT("batch="), BatchSize);
+	FParse::Value(*Params, TEXT("runs="), NumRuns);
+	NumKeys = FMath::Max(NumKeys, 1);
+	BatchSize = FMath::Max(BatchSize, 1);
+	NumRuns = FMath::Max(NumRuns, 1);
+	const int32 Size = SizeKB * 1024;
+
+	FDerivedDataCacheInterface& DDC = GetDerivedDataCacheRef();
+	UE_LOG(LogDDCBenchmark, Display, TEXT("Benchmarking graph '%s' with %d keys of %dKB, %d keys per batch, best of %d runs."), DDC.GetGraphName(), NumKeys, SizeKB, BatchSize, NumRuns);
+
+	// Keys are unique to this run so that the data of earlier runs is never what gets measured
+	const FString Prefix = FString::Printf(TEXT("DDCBENCHMARK_%s_"), *FGuid::NewGuid().ToString());
+	TArray<FString> Keys;
+	Keys.Reserve(NumKeys);
+	{
+		TArray<TArray<uint8>> Payloads;
+		Payloads.Reserve(BatchSize);
+		for (int32 First = 0; First < NumKeys; First += BatchSize)
+		{
+			Payloads.Reset();
+			const int32 Num = FMath::Min(BatchSize, NumKeys - First);
+			for (int32 Index = First; Index < First + Num; Index++)
+			{
+				Keys.Add(Prefix + FString::FromInt(Index));
+				Payloads.Add(MakePayload(Index, Size));
+			}
+			DDC.PutBatch(MakeArrayView(Keys).Slice(First, Num), Payloads, TEXT("DDCBenchmark"));
+		}
+		DDC.WaitForQuiescence();
+	}
+
+	// Alternate between the two so that neither always runs on the warmer cache
+	double PerKeySeconds = MAX_dbl;
+	double BatchedSeconds = MAX_dbl;
+	int32 NumPerKeyValid = NumKeys;
+	int32 NumBatchedValid = NumKeys;
+	for (int32 Run = 0; Run < NumRuns; Run++)
+	{
+		double StartTime = FPlatformTime::Seconds();
+		NumPerKeyValid = FMath::Min(NumPerKeyValid, GetPerKey(DDC, Keys, Size));
+		PerKeySeconds = FMath::Min(PerKeySeconds, FPlatformTime::Seconds() - StartTime);
+
+		StartTime = FPlatformTime::Seconds();
+		NumBatchedValid = FMath::Min(NumBatchedValid, GetBatched(DDC, Keys, Size, BatchSize));
+		BatchedSeconds = FMath::Min(BatchedSeconds, FPlatformTime::Seconds() - StartTime);
+	}
+
+	const double MB = double(NumKeys) * Size / (1024.0 * 1024.0);
+	UE_LOG(LogDDCBenchmark, Display, TEXT("Per key: %.3fs, %.0f keys/s, %.1fMB/s, %d of %d keys valid."), PerKeySeconds, NumKeys / PerKeySeconds, MB / PerKeySeconds, NumPerKeyValid, NumKeys);
+	UE_LOG(LogDDCBenchmark, Display, TEXT("Batched: %.3fs, %.0f keys/s, %.1fMB/s, %d of %d keys valid (%.2fx)."), BatchedSeconds, NumKeys / BatchedSeconds, MB / BatchedSeconds, NumBatchedValid, NumKeys, PerKeySeconds / BatchedSeconds);
+
+	if (NumPerKeyValid != NumKeys || NumBatchedValid != NumKeys)
+	{
+		UE_LOG(LogDDCBenchmark, Error, TEXT("Some keys were missing or returned the wrong data, is the graph writable?"));
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,35 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+[SupportedPlatforms(UnrealPlatformClass.Desktop)]
+public class MallocReplayTarget : TargetRules
+{
+	public MallocReplayTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Program;
+		LinkType = TargetLinkType.Monolithic;
+		LaunchModuleName = "MallocReplay";
+
+		// Lean and mean
+		bBuildDeveloperTools = false;
+
+		// The allocators have to be measured without the malloc profiler in front of them
+		bUseMallocProfiler = false;
+
+		// Keeps FMallocPoisonProxy, which fills every allocation, out of Development builds
+		bBuildWithEditorOnlyData = true;
+
+		// Compile out references from Core to the rest of the engine
+		bCompileAgainstEngine = false;
+		bCompileAgainstCoreUObject = false;
+		bCompileAgainstApplicationCore = false;
+
+		// Logs are still useful to print the results
+		bUseLoggingInShipping = true;
+
+		// Make a console application under Windows, so entry point is main() everywhere
+		bIsBuildingConsoleApplication = true;
+	}
+}
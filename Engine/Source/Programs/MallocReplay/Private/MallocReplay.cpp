@@ -0,0 +1,196 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MallocReplay.h"
+#include "ReplayTrace.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+
+#include "RequiredProgramMainCPPInclude.h"
+
+DEFINE_LOG_CATEGORY(LogMallocReplay);
+
+IMPLEMENT_APPLICATION(MallocReplay, "MallocReplay");
+
+namespace MallocReplay
+{
+	struct FAllocator
+	{
+		/** Name used in -allocators= and the report */
+		const TCHAR* Name;
+		/** Command line switch that makes FPlatformMemory::BaseAllocator() pick it */
+		const TCHAR* Switch;
+		/** What GMalloc->GetDescriptiveName() returns when it did */
+		const TCHAR* DescriptiveName;
+	};
+
+	static const FAllocator Allocators[] =
+	{
+		{ TEXT("binned2"),	TEXT("binnedmalloc2"),	TEXT("binned2") },
+		{ TEXT("binned3"),	TEXT("binnedmalloc3"),	TEXT("Binned3") },
+		{ TEXT("mimalloc"),	TEXT("mimalloc"),		TEXT("Mimalloc") },
+		{ TEXT("jemalloc"),	TEXT("jemalloc"),		TEXT("jemalloc") },
+		{ TEXT("tbb"),		TEXT("tbbmalloc"),		TEXT("TBB") },
+		{ TEXT("ansi"),		TEXT("ansimalloc"),		TEXT("ANSI") },
+		{ TEXT("binned"),	TEXT("binnedmalloc"),	TEXT("binned") },
+	};
+
+	static const TCHAR* ReportHeader = TEXT("Allocator,DescriptiveName,ReplayThreads,RecordedThreads,Ops,UntrackedOps,CrossThreadWaits,Seconds,MOpsPerSecond,")
+		TEXT("PeakLiveMB,PeakRSSMB,PeakOverhead,EndLiveMB,EndRSSMB,EndOverhead,TrimmedRSSMB,ReleasedRSSMB,ProcessPeakRSSMB\n");
+
+	/** Exit code of a child that was not started with the allocator it was asked to replay against */
+	static const int32 ExitCodeAllocatorUnavailable = 2;
+
+	static const FAllocator* FindAllocator(const FString& Name)
+	{
+		for (const FAllocator& Allocator : Allocators)
+		{
+			if (Name.Equals(Allocator.Name, ESearchCase::IgnoreCase))
+			{
+				return &Allocator;
+			}
+		}
+		return nullptr;
+	}
+
+	static double ToMB(int64 Bytes)
+	{
+		return Bytes / (1024.0 * 1024.0);
+	}
+
+	static void AppendToReport(const FString& ReportFile, const FString& Row)
+	{
+		FFileHelper::SaveStringToFile(Row, *ReportFile, FFileHelper::EEncodingOptions::ForceAnsi, &IFileManager::Get(), FILEWRITE_Append);
+	}
+
+	/** Replays the trace against the allocator this process was started with and appends a row to the report */
+	static int32 RunChild(const TCHAR* CommandLine, const FAllocator& Allocator, const FString& ReplayFile, const FString& ReportFile)
+	{
+		const TCHAR* DescriptiveName = GMalloc->GetDescriptiveName();
+		if (FCString::Stricmp(DescriptiveName, Allocator.DescriptiveName))
+		{
+			UE_LOG(LogMallocReplay, Warning, TEXT("Started with -%s but got allocator '%s', %s is not available on this platform or configuration."), Allocator.Switch, DescriptiveName, Allocator.Name);
+			return ExitCodeAllocatorUnavailable;
+		}
+
+		int32 NumReplayThreads = 0;
+		uint64 MaxOps = MAX_uint64;
+		FParse::Value(CommandLine, TEXT("threads="), NumReplayThreads);
+		FParse::Value(CommandLine, TEXT("stopafter="), MaxOps);
+		const bool bTouchMemory = !FParse::Param(CommandLine, TEXT("notouch"));
+
+		FReplayTrace Trace;
+		if (!Trace.Load(ReplayFile, NumReplayThreads, MaxOps))
+		{
+			return 1;
+		}
+
+		const FReplayStats Stats = ReplayTrace(Trace, bTouchMemory);
+		const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+
+		// Overhead is physical memory per requested byte, including the allocator's fragmentation, caches and bookkeeping
+		const double PeakOverhead = Trace.PeakLiveBytes ? double(Stats.PeakUsedPhysical) / double(Trace.PeakLiveBytes) : 0.0;
+		const double EndOverhead = Trace.EndLiveBytes ? double(Stats.EndUsedPhysical) / double(Trace.EndLiveBytes) : 0.0;
+		const double MOpsPerSecond = Stats.Seconds > 0.0 ? Trace.NumOps / Stats.Seconds / 1e6 : 0.0;
+
+		UE_LOG(LogMallocReplay, Display, TEXT("%s: %llu operations on %d threads in %.3fs (%.2f Mops/s), %llu waits for other threads."),
+			Allocator.Name, Trace.NumOps, Trace.Threads.Num(), Stats.Seconds, MOpsPerSecond, Stats.NumCrossThreadWaits);
+		UE_LOG(LogMallocReplay, Display, TEXT("%s: peak %.1fMB physical for %.1fMB live (%.2fx), end %.1fMB for %.1fMB live (%.2fx), %.1fMB after trim, %.1fMB after freeing everything."),
+			Allocator.Name, ToMB(Stats.PeakUsedPhysical), ToMB(Trace.PeakLiveBytes), PeakOverhead, ToMB(Stats.EndUsedPhysical), ToMB(Trace.EndLiveBytes), EndOverhead,
+			ToMB(Stats.TrimmedUsedPhysical), ToMB(Stats.ReleasedUsedPhysical));
+
+		AppendToReport(ReportFile, FString::Printf(TEXT("%s,%s,%d,%d,%llu,%llu,%llu,%.4f,%.3f,%.1f,%.1f,%.3f,%.1f,%.1f,%.3f,%.1f,%.1f,%.1f\n"),
+			Allocator.Name, DescriptiveName, Trace.Threads.Num(), Trace.NumRecordedThreads, Trace.NumOps, Trace.NumUntrackedOps, Stats.NumCrossThreadWaits,
+			Stats.Seconds, MOpsPerSecond, ToMB(Trace.PeakLiveBytes), ToMB(Stats.PeakUsedPhysical), PeakOverhead, ToMB(Trace.EndLiveBytes), ToMB(Stats.EndUsedPhysical), EndOverhead,
+			ToMB(Stats.TrimmedUsedPhysical), ToMB(Stats.ReleasedUsedPhysical), ToMB(MemoryStats.PeakUsedPhysical)));
+		return 0;
+	}
+
+	/** Runs one child process per allocator, one after the other so they don't disturb each other's measurements */
+	static int32 RunParent(const TCHAR* CommandLine, const FString& ReportFile)
+	{
+		FString AllocatorList = TEXT("binned2,binned3,mimalloc,jemalloc,tbb,ansi");
+		FParse::Value(CommandLine, TEXT("allocators="), AllocatorList, false);
+		TArray<FString> AllocatorNames;
+		AllocatorList.ParseIntoArray(AllocatorNames, TEXT(","));
+
+		if (!FFileHelper::SaveStringToFile(ReportHeader, *ReportFile, FFileHelper::EEncodingOptions::ForceAnsi))
+		{
+			UE_LOG(LogMallocReplay, Error, TEXT("Unable to write report '%s'."), *ReportFile);
+			return 1;
+		}
+
+		for (const FString& Name : AllocatorNames)
+		{
+			const FAllocator* Allocator = FindAllocator(Name);
+			if (!Allocator)
+			{
+				UE_LOG(LogMallocReplay, Error, TEXT("Unknown allocator '%s'."), *Name);
+				continue;
+			}
+
+			// The allocator switch has to be an argument of its own, BaseAllocator() runs before the command line is parsed
+			const FString Params = FString::Printf(TEXT("-%s -child=%s %s"), Allocator->Switch, Allocator->Name, CommandLine);
+			FProcHandle Proc = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Params, false, true, true, nullptr, 0, nullptr, nullptr);
+			if (!Proc.IsValid())
+			{
+				UE_LOG(LogMallocReplay, Error, TEXT("Unable to start '%s %s'."), FPlatformProcess::ExecutablePath(), *Params);
+				return 1;
+			}
+
+			int32 ReturnCode = 1;
+			FPlatformProcess::WaitForProc(Proc);
+			FPlatformProcess::GetProcReturnCode(Proc, &ReturnCode);
+			FPlatformProcess::CloseProc(Proc);
+
+			if (ReturnCode != 0)
+			{
+				AppendToReport(ReportFile, FString::Printf(TEXT("%s,%s\n"), Allocator->Name, ReturnCode == ExitCodeAllocatorUnavailable ? TEXT("unavailable") : TEXT("failed")));
+			}
+		}
+
+		UE_LOG(LogMallocReplay, Display, TEXT("Wrote '%s'."), *ReportFile);
+		return 0;
+	}
+}
+
+INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
+{
+	using namespace MallocReplay;
+
+	GEngineLoop.PreInit(ArgC, ArgV);
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	int32 ReturnCode = 0;
+	FString ReplayFile;
+	if (FParse::Value(CommandLine, TEXT("replayfile="), ReplayFile))
+	{
+		FString ReportFile = TEXT("MallocReplay.csv");
+		FParse::Value(CommandLine, TEXT("report="), ReportFile);
+
+		FString ChildAllocator;
+		if (FParse::Value(CommandLine, TEXT("child="), ChildAllocator))
+		{
+			const FAllocator* Allocator = FindAllocator(ChildAllocator);
+			ReturnCode = Allocator ? RunChild(CommandLine, *Allocator, ReplayFile, ReportFile) : 1;
+		}
+		else
+		{
+			ReturnCode = RunParent(CommandLine, ReportFile);
+		}
+	}
+	else
+	{
+		UE_LOG(LogMallocReplay, Display, TEXT("Replays a malloc history saved by -mallocsavereplay against several allocators and writes a CSV report comparing them."));
+		UE_LOG(LogMallocReplay, Display, TEXT("Usage: MallocReplay -replayfile=File [-report=MallocReplay.csv] [-allocators=binned2,binned3,mimalloc,jemalloc,tbb,ansi,binned]"));
+		UE_LOG(LogMallocReplay, Display, TEXT("  -threads=N replays on N threads instead of one per recorded thread, -stopafter=N stops after N operations,"));
+		UE_LOG(LogMallocReplay, Display, TEXT("  -notouch doesn't write to allocated memory, so physical memory only shows what the allocators touch themselves."));
+		ReturnCode = 1;
+	}
+
+	FEngineLoop::AppPreExit();
+	FEngineLoop::AppExit();
+	return ReturnCode;
+}
@@ -0,0 +1,302 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ReplayTrace.h"
+#include "MallocReplay.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Templates/UniquePtr.h"
+#include <atomic>
+
+namespace MallocReplay
+{
+	/** Stored for allocations that returned nullptr, so that waiting threads can tell them from allocations not made yet */
+	static uint8 NullAllocation;
+
+	static void* WaitForAllocation(const std::atomic<void*>& Allocation, uint64& NumWaits)
+	{
+		void* Ptr = Allocation.load(std::memory_order_acquire);
+		if (!Ptr)
+		{
+			++NumWaits;
+			do
+			{
+				FPlatformProcess::Yield();
+				Ptr = Allocation.load(std::memory_order_acquire);
+			}
+			while (!Ptr);
+		}
+		return Ptr == &NullAllocation ? nullptr : Ptr;
+	}
+
+	/** One write per page makes an allocation resident like real use would, without measuring memset bandwidth */
+	static void TouchMemory(void* Ptr, uint64 Size)
+	{
+		uint8* Bytes = static_cast<uint8*>(Ptr);
+		for (uint64 Offset = 0; Offset < Size; Offset += 4096)
+		{
+			Bytes[Offset] = uint8(Offset >> 12);
+		}
+	}
+
+	static int64 GetUsedPhysical()
+	{
+		return (int64)FPlatformMemory::GetStats().UsedPhysical;
+	}
+
+	class FReplayThread : public FRunnable
+	{
+	public:
+		FReplayThread(const TArray<FReplayOp>& InOps, std::atomic<void*>* InAllocations, std::atomic<int32>& InNumReady, std::atomic<bool>& bInStart, bool bInTouchMemory)
+			: Ops(InOps)
+			, Allocations(InAllocations)
+			, NumReady(InNumReady)
+			, bStart(bInStart)
+			, bTouchMemory(bInTouchMemory)
+		{
+		}
+
+		virtual uint32 Run() override
+		{
+			FMemory::SetupTLSCachesOnCurrentThread();
+
+			++NumReady;
+			while (!bStart)
+			{
+				FPlatformProcess::Yield();
+			}
+
+			for (const FReplayOp& Op : Ops)
+			{
+				void* In = Op.In != INDEX_NONE ? WaitForAllocation(Allocations[Op.In], NumWaits) : nullptr;
+				void* Out = nullptr;
+				switch (Op.Type)
+				{
+				case FReplayOp::EType::Malloc:	Out = FMemory::Malloc(Op.Size, Op.Alignment);		break;
+				case FReplayOp::EType::Realloc:	Out = FMemory::Realloc(In, Op.Size, Op.Alignment);	break;
+				default:						FMemory::Free(In);									break;
+				}
+
+				if (Op.Out != INDEX_NONE)
+				{
+					if (bTouchMemory && Out)
+					{
+						TouchMemory(Out, Op.Size);
+					}
+					Allocations[Op.Out].store(Out ? Out : &NullAllocation, std::memory_order_release);
+				}
+			}
+			FinishTime = FPlatformTime::Seconds();
+			bFinished.store(true, std::memory_order_release);
+
+			// Thread caches go back to the allocator, so that they show up in the end measurements like a finished thread's would
+			FMemory::ClearAndDisableTLSCachesOnCurrentThread();
+			return 0;
+		}
+
+		double FinishTime = 0.0;
+		uint64 NumWaits = 0;
+		std::atomic<bool> bFinished{ false };
+
+	private:
+		const TArray<FReplayOp>& Ops;
+		std::atomic<void*>* Allocations;
+		std::atomic<int32>& NumReady;
+		std::atomic<bool>& bStart;
+		bool bTouchMemory;
+	};
+}
+
+bool FReplayTrace::Load(const FString& Filename, int32 NumReplayThreads, uint64 MaxOps)
+{
+#if PLATFORM_WINDOWS
+	FILE* File = nullptr;
+	if (fopen_s(&File, TCHAR_TO_UTF8(*Filename), "rb") != 0 || File == nullptr)
+#else
+	FILE* File = fopen(TCHAR_TO_UTF8(*Filename), "rb");
+	if (File == nullptr)
+#endif // PLATFORM_WINDOWS
+	{
+		UE_LOG(LogMallocReplay, Error, TEXT("Unable to open replay file '%s'."), *Filename);
+		return false;
+	}
+
+	// For file format, see FMallocReplayProxy. Skip the first line since it contains column headers.
+	char LineBuffer[512];
+	if (fgets(LineBuffer, sizeof(LineBuffer), File) == nullptr)
+	{
+		fclose(File);
+		return false;
+	}
+
+	TMap<uint64, int32> LiveAllocations;
+	TArray<uint64> AllocationSizes;
+	TMap<uint32, int32> RecordedToReplayThread;
+	uint64 LiveBytes = 0;
+
+	while (NumOps < MaxOps && fgets(LineBuffer, sizeof(LineBuffer), File))
+	{
+		// Older files don't have the thread id and replay on a single thread
+		char OpBuffer[128] = {0};
+		uint64 PtrOut, PtrIn, Size;
+		uint32 Alignment;
+		uint32 ThreadId = 0;
+#if PLATFORM_WINDOWS
+		if (sscanf_s(LineBuffer, "%s %llu %llu %llu %u %u", OpBuffer, static_cast<unsigned int>(sizeof(OpBuffer)), &PtrOut, &PtrIn, &Size, &Alignment, &ThreadId) < 5)
+#else
+		if (sscanf(LineBuffer, "%127s %llu %llu %llu %u %u", OpBuffer, &PtrOut, &PtrIn, &Size, &Alignment, &ThreadId) < 5)
+#endif // PLATFORM_WINDOWS
+		{
+			break;
+		}
+
+		const bool bMalloc = !FCStringAnsi::Strcmp(OpBuffer, "Malloc");
+		const bool bRealloc = !bMalloc && !FCStringAnsi::Strcmp(OpBuffer, "Realloc");
+		if (!bMalloc && !bRealloc && FCStringAnsi::Strcmp(OpBuffer, "Free"))
+		{
+			UE_LOG(LogMallocReplay, Warning, TEXT("Replay file contains unknown operation '%s', skipping."), ANSI_TO_TCHAR(OpBuffer));
+			continue;
+		}
+
+		FReplayOp Op;
+		Op.Size = Size;
+		Op.Alignment = Alignment;
+		Op.In = INDEX_NONE;
+		Op.Out = INDEX_NONE;
+		Op.Type = bMalloc ? FReplayOp::EType::Malloc : bRealloc ? FReplayOp::EType::Realloc : FReplayOp::EType::Free;
+
+		if (!bMalloc && PtrIn)
+		{
+			if (LiveAllocations.RemoveAndCopyValue(PtrIn, Op.In))
+			{
+				LiveBytes -= AllocationSizes[Op.In];
+			}
+			else
+			{
+				// Allocated before the recording started, the free is dropped and the realloc becomes a malloc
+				++NumUntrackedOps;
+				if (!bRealloc)
+				{
+					continue;
+				}
+			}
+		}
+		else if (!bMalloc && !bRealloc)
+		{
+			continue;
+		}
+
+		if (PtrOut && Op.Type != FReplayOp::EType::Free)
+		{
+			if (AllocationSizes.Num() == MAX_int32)
+			{
+				UE_LOG(LogMallocReplay, Warning, TEXT("Replay file has more allocations than supported, stopping after %llu operations."), NumOps);
+				break;
+			}
+
+			// A pointer returned while still live means its free was not recorded, keep the old allocation until the end
+			int32 Unfreed;
+			if (LiveAllocations.RemoveAndCopyValue(PtrOut, Unfreed))
+			{
+				EndLiveAllocations.Add(Unfreed);
+				LiveBytes -= AllocationSizes[Unfreed];
+			}
+
+			Op.Out = AllocationSizes.Add(Size);
+			LiveAllocations.Add(PtrOut, Op.Out);
+			LiveBytes += Size;
+			PeakLiveBytes = FMath::Max(PeakLiveBytes, LiveBytes);
+		}
+
+		int32* ReplayThread = RecordedToReplayThread.Find(ThreadId);
+		if (!ReplayThread)
+		{
+			const int32 NumRecorded = RecordedToReplayThread.Num();
+			ReplayThread = &RecordedToReplayThread.Add(ThreadId, NumReplayThreads > 0 ? NumRecorded % NumReplayThreads : NumRecorded);
+			Threads.SetNum(FMath::Max(Threads.Num(), *ReplayThread + 1));
+		}
+		Threads[*ReplayThread].Add(Op);
+		++NumOps;
+	}
+	fclose(File);
+
+	for (const TPair<uint64, int32>& Pair : LiveAllocations)
+	{
+		EndLiveAllocations.Add(Pair.Value);
+	}
+	NumAllocations = AllocationSizes.Num();
+	NumRecordedThreads = RecordedToReplayThread.Num();
+	EndLiveBytes = LiveBytes;
+
+	UE_LOG(LogMallocReplay, Display, TEXT("Loaded %llu operations of %d threads from '%s' (%llu on pointers allocated before the recording), peak live %.1fMB."),
+		NumOps, NumRecordedThreads, *Filename, NumUntrackedOps, PeakLiveBytes / (1024.0 * 1024.0));
+	return NumOps > 0;
+}
+
+FReplayStats ReplayTrace(const FReplayTrace& Trace, bool bTouchMemory)
+{
+	using namespace MallocReplay;
+
+	FReplayStats Stats;
+
+	// Value-initialized, so that the memory is resident before the baseline is taken
+	TUniquePtr<std::atomic<void*>[]> Allocations = MakeUnique<std::atomic<void*>[]>(Trace.NumAllocations);
+	std::atomic<int32> NumReady{ 0 };
+	std::atomic<bool> bStart{ false };
+
+	TArray<TUniquePtr<FReplayThread>> Runnables;
+	TArray<FRunnableThread*> RunnableThreads;
+	for (const TArray<FReplayOp>& Ops : Trace.Threads)
+	{
+		Runnables.Add(MakeUnique<FReplayThread>(Ops, Allocations.Get(), NumReady, bStart, bTouchMemory));
+		RunnableThreads.Add(FRunnableThread::Create(Runnables.Last().Get(), *FString::Printf(TEXT("MallocReplay%d"), RunnableThreads.Num())));
+	}
+	while (NumReady < Runnables.Num())
+	{
+		FPlatformProcess::Yield();
+	}
+
+	FMemory::Trim();
+	const int64 Baseline = GetUsedPhysical();
+	Stats.PeakUsedPhysical = 0;
+
+	const double StartTime = FPlatformTime::Seconds();
+	bStart = true;
+
+	// Sample while the replay threads run, GetStats() is too slow to call more often
+	bool bFinished = false;
+	while (!bFinished)
+	{
+		Stats.PeakUsedPhysical = FMath::Max(Stats.PeakUsedPhysical, GetUsedPhysical() - Baseline);
+		FPlatformProcess::Sleep(0.001f);
+
+		bFinished = true;
+		for (const TUniquePtr<FReplayThread>& Runnable : Runnables)
+		{
+			bFinished &= Runnable->bFinished.load(std::memory_order_acquire);
+		}
+	}
+
+	for (int32 Index = 0; Index < Runnables.Num(); ++Index)
+	{
+		RunnableThreads[Index]->WaitForCompletion();
+		delete RunnableThreads[Index];
+		Stats.Seconds = FMath::Max(Stats.Seconds, Runnables[Index]->FinishTime - StartTime);
+		Stats.NumCrossThreadWaits += Runnables[Index]->NumWaits;
+	}
+
+	Stats.EndUsedPhysical = GetUsedPhysical() - Baseline;
+	FMemory::Trim();
+	Stats.TrimmedUsedPhysical = GetUsedPhysical() - Baseline;
+
+	for (int32 Allocation : Trace.EndLiveAllocations)
+	{
+		void* Ptr = Allocations[Allocation].load(std::memory_order_relaxed);
+		FMemory::Free(Ptr == &NullAllocation ? nullptr : Ptr);
+	}
+	FMemory::Trim();
+	Stats.ReleasedUsedPhysical = GetUsedPhysical() - Baseline;
+
+	return Stats;
+}
@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** One operation of a trace saved by FMallocReplayProxy, with the recorded pointers replaced by allocation indices */
+struct FReplayOp
+{
+	enum class EType : uint8
+	{
+		Malloc,
+		Realloc,
+		Free,
+	};
+
+	/** Size as passed in - only valid for malloc/realloc */
+	uint64 Size;
+	/** Alignment as passed in - only valid for malloc/realloc */
+	uint32 Alignment;
+	/** Allocation passed in to realloc/free, INDEX_NONE for malloc and realloc of nullptr */
+	int32 In;
+	/** Allocation returned by malloc/realloc, INDEX_NONE for free */
+	int32 Out;
+	EType Type;
+};
+
+/**
+ * A trace saved by -mallocsavereplay, split into one operation stream per replay thread.
+ *
+ * Every pointer the trace returns becomes a new allocation index. A replay thread that frees or reallocates
+ * an allocation made on another thread waits until that thread has made it, everything else runs in parallel.
+ * Streams keep the recorded order, so waits always resolve even with fewer replay threads than recorded threads.
+ */
+struct FReplayTrace
+{
+	/** Operations of each replay thread */
+	TArray<TArray<FReplayOp>> Threads;
+	/** Allocations still live at the end of the trace, they are freed after measuring */
+	TArray<int32> EndLiveAllocations;
+
+	int32 NumAllocations = 0;
+	int32 NumRecordedThreads = 0;
+	uint64 NumOps = 0;
+	/** Frees and reallocs of pointers allocated before the recording started */
+	uint64 NumUntrackedOps = 0;
+
+	/** Requested bytes live at the busiest point of the trace and at its end */
+	uint64 PeakLiveBytes = 0;
+	uint64 EndLiveBytes = 0;
+
+	/**
+	 * Loads a trace, with or without recorded thread ids.
+	 *
+	 * @param NumReplayThreads recorded threads are assigned round robin to this many replay threads, 0 replays each on its own thread
+	 * @param MaxOps stop after this many operations
+	 */
+	bool Load(const FString& Filename, int32 NumReplayThreads, uint64 MaxOps);
+};
+
+/** Results of replaying a trace, physical memory is relative to the process before the replay started */
+struct FReplayStats
+{
+	double Seconds = 0.0;
+	/** Operations that waited for an allocation made on another replay thread */
+	uint64 NumCrossThreadWaits = 0;
+	/** Highest sample taken during the replay */
+	int64 PeakUsedPhysical = 0;
+	/** After the replay, with the allocations still live at the end of the trace */
+	int64 EndUsedPhysical = 0;
+	/** Same after FMemory::Trim() */
+	int64 TrimmedUsedPhysical = 0;
+	/** After freeing everything and trimming again, what the allocator keeps for itself */
+	int64 ReleasedUsedPhysical = 0;
+};
+
+/**
+ * Replays the trace through FMemory, which is whatever allocator the process was started with.
+ *
+ * @param bTouchMemory write to every page that gets allocated, so that physical memory use is comparable to real use
+ */
+FReplayStats ReplayTrace(const FReplayTrace& Trace, bool bTouchMemory);
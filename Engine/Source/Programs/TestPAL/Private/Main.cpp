@@ -1070,18 +1070,23 @@ void ReplayMallocFile(const FString& ReplayFileName, uint64 OperationToStopAfter
 	{
 		FSimpleScopeSecondsCounter Duration(WallTimeDuration);
 
+		// Newer files record the calling thread after the alignment, it is not needed for a single-threaded replay
+		char LineBuffer[512] = {0};
 		char OpBuffer[128] = {0};
-		uint64 PtrOut, PtrIn, Size, Ordinal;
+		uint64 PtrOut, PtrIn, Size;
 		uint32 Alignment;
+		if (fgets(LineBuffer, sizeof(LineBuffer), ReplayFile) == nullptr ||
 #if PLATFORM_WINDOWS
-		if (fscanf_s(ReplayFile, "%s %llu %llu %llu %u\t# %llu\n", OpBuffer, static_cast<unsigned int>(sizeof(OpBuffer)), &PtrOut, &PtrIn, &Size, &Alignment, &Ordinal) != 6)
+			sscanf_s(LineBuffer, "%s %llu %llu %llu %u", OpBuffer, static_cast<unsigned int>(sizeof(OpBuffer)), &PtrOut, &PtrIn, &Size, &Alignment) != 5)
 #else
-		if (fscanf(ReplayFile, "%s %llu %llu %llu %u\t# %llu\n", OpBuffer, &PtrOut, &PtrIn, &Size, &Alignment, &Ordinal) != 6)
+			sscanf(LineBuffer, "%127s %llu %llu %llu %u", OpBuffer, &PtrOut, &PtrIn, &Size, &Alignment) != 5)
 #endif // PLATFORM_WINDOWS
 		{
 			UE_LOG(LogTestPAL, Display, TEXT("Hit end of the replay file on %llu-th operation."), OperationNumber);
 			break;
 		}
+		const char* OrdinalStart = FCStringAnsi::Strchr(LineBuffer, '#');
+		const uint64 Ordinal = OrdinalStart ? FCStringAnsi::Strtoui64(OrdinalStart + 1, nullptr, 10) : OperationNumber + 1;
 
 		if (!FCStringAnsi::Strcmp(OpBuffer, "Malloc"))
 		{
@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "AssetDataGatherer.h"
+#include "HAL/IConsoleManager.h"
 #include "HAL/PlatformProcess.h"
 #include "HAL/RunnableThread.h"
 #include "Misc/AsciiSet.h"
@@ -15,11 +16,22 @@
 
 namespace AssetDataGathererConstants
 {
-	static const int32 MaxFilesToDiscoverBeforeFlush = 2500;
-	static const int32 MaxFilesToGatherBeforeFlush = 250;
 	static const int32 MinSecondsToElapseBeforeCacheWrite = 60;
 }
 
+static int32 GAssetDiscoveryMaxDirectoriesInFlight = 32;
+static FAutoConsoleVariableRef CVarAssetDiscoveryMaxDirectoriesInFlight(
+	TEXT("AssetRegistry.Discovery.MaxDirectoriesInFlight"),
+	GAssetDiscoveryMaxDirectoriesInFlight,
+	TEXT("Number of directories the asset discovery lists in parallel. 1 lists one directory at a time."));
+
+static int32 GAssetGatherMaxFilesInFlight = 1000;
+static FAutoConsoleVariableRef CVarAssetGatherMaxFilesInFlight(
+	TEXT("AssetRegistry.Gather.MaxFilesInFlight"),
+	GAssetGatherMaxFilesInFlight,
+	TEXT("Number of package files the asset gatherer looks up in the cache or reads the header of in parallel. ")
+	TEXT("Results and priority changes are handed over between batches of this size."));
+
 namespace
 {
 	class FLambdaDirectoryStatVisitor : public IPlatformFile::FDirectoryStatVisitor
@@ -168,60 +180,70 @@ uint32 FAssetDataDiscovery::Run()
 		return !bIsSynchronous && !LocalFilenamePathToPrioritize.IsEmpty() && InPackageFilename.StartsWith(LocalFilenamePathToPrioritize);
 	};
 
-	auto OnIterateDirectoryItem = [&](const TCHAR* InPackageFilename, const FFileStatData& InPackageStatData) -> bool
+	/** What was found in one directory. Directories are listed in parallel and their results merged in the order they were popped */
+	struct FDirectoryResults
 	{
-		if (StopTaskCounter.GetValue() != 0)
-		{
-			// Requested to stop - break out of the directory iteration
-			return false;
-		}
+		FString Directory;
+		TArray<FString> SubDirectories;
+		TArray<FString> Paths;
+		TArray<FDiscoveredPackageFile> PriorityFiles;
+		TArray<FDiscoveredPackageFile> NonPriorityFiles;
+	};
+	TArray<FDirectoryResults> DirectoryResults;
 
-		const FString PackageFilenameStr = InPackageFilename;
-		FString PackagePath;
-		bool bIsLongPackagePath = ConvertToValidLongPackageName(PackageFilenameStr, PackagePath);
-		if (AssetDataDiscoveryUtil::PassesScanFilters(LocalBlacklistScanFilters, PackagePath))
+	// Called from worker threads, everything it reads from the outer scope is only modified between parallel listings
+	auto ListDirectory = [&](FDirectoryResults& Results)
+	{
+		auto OnIterateDirectoryItem = [&](const TCHAR* InPackageFilename, const FFileStatData& InPackageStatData) -> bool
 		{
-			if (InPackageStatData.bIsDirectory)
+			if (StopTaskCounter.GetValue() != 0)
 			{
-				LocalDiscoveredDirectories.Add(PackageFilenameStr / TEXT(""));
-				if (bIsLongPackagePath && !PathsToHideIfEmpty.Contains(PackagePath))
-				{
-					LocalDiscoveredPathsSet.Add(PackagePath);
-				}
+				// Requested to stop - break out of the directory iteration
+				return false;
 			}
-			else if (FPackageName::IsPackageFilename(PackageFilenameStr))
+
+			const FString PackageFilenameStr = InPackageFilename;
+			FString PackagePath;
+			bool bIsLongPackagePath = ConvertToValidLongPackageName(PackageFilenameStr, PackagePath);
+			if (AssetDataDiscoveryUtil::PassesScanFilters(LocalBlacklistScanFilters, PackagePath))
 			{
-				if (bIsLongPackagePath)
+				if (InPackageStatData.bIsDirectory)
 				{
-					if (IsPriorityFile(PackageFilenameStr))
+					Results.SubDirectories.Add(PackageFilenameStr / TEXT(""));
+					if (bIsLongPackagePath && !PathsToHideIfEmpty.Contains(PackagePath))
 					{
-						LocalPriorityFilesToSearch.Add(FDiscoveredPackageFile(PackageFilenameStr, InPackageStatData.ModificationTime));
+						Results.Paths.Add(MoveTemp(PackagePath));
 					}
-					else
+				}
+				else if (FPackageName::IsPackageFilename(PackageFilenameStr))
+				{
+					if (bIsLongPackagePath)
 					{
-						LocalNonPriorityFilesToSearch.Add(FDiscoveredPackageFile(PackageFilenameStr, InPackageStatData.ModificationTime));
-					}
-
-					LocalDiscoveredPathsSet.Add(FPackageName::GetLongPackagePath(PackagePath));
-
-					++NumDiscoveredFiles;
+						Results.Paths.Add(FPackageName::GetLongPackagePath(PackagePath));
 
-					// Flush the data if we've processed enough
-					if (!bIsSynchronous && (LocalPriorityFilesToSearch.Num() + LocalNonPriorityFilesToSearch.Num()) >= AssetDataGathererConstants::MaxFilesToDiscoverBeforeFlush)
-					{
-						FlushLocalResultsIfRequired();
+						if (IsPriorityFile(PackageFilenameStr))
+						{
+							Results.PriorityFiles.Add(FDiscoveredPackageFile(PackageFilenameStr, InPackageStatData.ModificationTime));
+						}
+						else
+						{
+							Results.NonPriorityFiles.Add(FDiscoveredPackageFile(PackageFilenameStr, InPackageStatData.ModificationTime));
+						}
 					}
 				}
 			}
-		}
-		return true;
+			return true;
+		};
+
+		FLambdaDirectoryStatVisitor Visitor(OnIterateDirectoryItem);
+		IFileManager::Get().IterateDirectoryStat(*Results.Directory, Visitor);
 	};
 
 	bool bIsIdle = true;
 
 	while (StopTaskCounter.GetValue() == 0)
 	{
-		FString LocalDirectoryToSearch;
+		DirectoryResults.Reset();
 		{
 			FScopeLock CritSectionLock(&WorkerThreadCriticalSection);
 
@@ -231,9 +253,13 @@ uint32 FAssetDataDiscovery::Run()
 
 				LocalFilenamePathToPrioritize = FilenamePathToPrioritize;
 
-				// Pop off the first path to search
-				LocalDirectoryToSearch = DirectoriesToSearch[0];
-				DirectoriesToSearch.RemoveAt(0, 1, false);
+				// Pop off the first paths to search
+				const int32 NumToList = FMath::Min(DirectoriesToSearch.Num(), FMath::Max(GAssetDiscoveryMaxDirectoriesInFlight, 1));
+				for (int32 DirIdx = 0; DirIdx < NumToList; ++DirIdx)
+				{
+					DirectoryResults.AddDefaulted_GetRef().Directory = MoveTemp(DirectoriesToSearch[DirIdx]);
+				}
+				DirectoriesToSearch.RemoveAt(0, NumToList, false);
 			}
 
 			if (BlacklistScanFilters.Num() > 0)
@@ -242,7 +268,7 @@ uint32 FAssetDataDiscovery::Run()
 			}
 		}
 
-		if (LocalDirectoryToSearch.Len() > 0)
+		if (DirectoryResults.Num() > 0)
 		{
 			if (bIsIdle)
 			{
@@ -253,9 +279,26 @@ uint32 FAssetDataDiscovery::Run()
 				NumDiscoveredFiles = 0;
 			}
 
-			// Iterate the current search directory
-			FLambdaDirectoryStatVisitor Visitor(OnIterateDirectoryItem);
-			IFileManager::Get().IterateDirectoryStat(*LocalDirectoryToSearch, Visitor);
+			// Iterate the current search directories
+			const double ListStartTime = FPlatformTime::Seconds();
+			ParallelFor(DirectoryResults.Num(),
+				[&DirectoryResults, &ListDirectory](int32 Index)
+				{
+					ListDirectory(DirectoryResults[Index]);
+				},
+				EParallelForFlags::Unbalanced | EParallelForFlags::BackgroundPriority
+			);
+
+			int32 NumFilesInDirectories = 0;
+			for (FDirectoryResults& Results : DirectoryResults)
+			{
+				LocalDiscoveredDirectories.Append(MoveTemp(Results.SubDirectories));
+				LocalDiscoveredPathsSet.Append(MoveTemp(Results.Paths));
+				NumFilesInDirectories += Results.PriorityFiles.Num() + Results.NonPriorityFiles.Num();
+				LocalPriorityFilesToSearch.Append(MoveTemp(Results.PriorityFiles));
+				LocalNonPriorityFilesToSearch.Append(MoveTemp(Results.NonPriorityFiles));
+			}
+			NumDiscoveredFiles += NumFilesInDirectories;
 
 			{
 				FScopeLock CritSectionLock(&WorkerThreadCriticalSection);
@@ -270,6 +313,10 @@ uint32 FAssetDataDiscovery::Run()
 				}
 				LocalDiscoveredDirectories.Reset();
 
+				Stats.NumDirectories += DirectoryResults.Num();
+				Stats.NumDiscoveredFiles += NumFilesInDirectories;
+				Stats.DiscoverySeconds += FPlatformTime::Seconds() - ListStartTime;
+
 				if (!bIsSynchronous)
 				{
 					FlushLocalResultsIfRequired();
@@ -388,6 +435,12 @@ void FAssetDataDiscovery::SetBlacklistScanFilters(const TArray<FString>& InBlack
 	BlacklistScanFilters = InBlacklistScanFilters;
 }
 
+FAssetGatherStats FAssetDataDiscovery::GetStats()
+{
+	FScopeLock CritSectionLock(&WorkerThreadCriticalSection);
+	return Stats;
+}
+
 void FAssetDataDiscovery::SortPathsByPriority(const int32 MaxNumToSort)
 {
 	FScopeLock CritSectionLock(&WorkerThreadCriticalSection);
@@ -471,6 +524,7 @@ FAssetDataGatherer::FAssetDataGatherer(const TArray<FString>& InPaths, const TAr
 		// Run the package file discovery synchronously
 		FAssetDataDiscovery PackageFileDiscovery(InPaths, BlacklistScanFilters, bIsSynchronous);
 		PackageFileDiscovery.GetAndTrimSearchResults(DiscoveredPaths, FilesToSearch, NumPathsToSearchAtLastSyncPoint);
+		Stats = PackageFileDiscovery.GetStats();
 
 		Run();
 	}
@@ -612,7 +666,7 @@ uint32 FAssetDataGatherer::Run()
 					SearchStartTime = FPlatformTime::Seconds();
 				}
 
-				const int32 NumFilesToProcess = FMath::Min<int32>(AssetDataGathererConstants::MaxFilesToGatherBeforeFlush, FilesToSearch.Num());
+				const int32 NumFilesToProcess = FMath::Min<int32>(FMath::Max(GAssetGatherMaxFilesInFlight, 1), FilesToSearch.Num());
 				LocalFilesToSearch.Append(FilesToSearch.GetData(), NumFilesToProcess);
 				FilesToSearch.RemoveAt(0, NumFilesToProcess, false);
 			}
@@ -627,105 +681,105 @@ uint32 FAssetDataGatherer::Run()
 
 		if (LocalFilesToSearch.Num() > 0)
 		{
+			const double GatherStartTime = FPlatformTime::Seconds();
+
 			struct FReadContext
 			{
 				FName PackageName;
 				FName Extension;
-				const FDiscoveredPackageFile& AssetFileData;
+				FDiskCachedAssetData* DiskCachedAssetData = nullptr;
 				TArray<FAssetData*> AssetDataFromFile;
 				FPackageDependencyData DependencyData;
 				TArray<FString> CookedPackageNamesWithoutAssetData;
 				bool bCanAttemptAssetRetry = false;
 				bool bResult = false;
-
-				FReadContext(FName InPackageName, FName InExtension, const FDiscoveredPackageFile& InAssetFileData)
-					: PackageName(InPackageName)
-					, Extension(InExtension)
-					, AssetFileData(InAssetFileData)
-				{
-				}
 			};
 
+			// Each file is looked up in the cache, and its header read if it is not cached, on a worker thread. The results are
+			// merged below in the order of the files so that the order of the gathered data does not depend on thread timing.
 			TArray<FReadContext> ReadContexts;
-			FString LongPackageNameString;
-			for (const FDiscoveredPackageFile& AssetFileData : LocalFilesToSearch)
-			{
-				if (StopTaskCounter.GetValue() != 0)
-				{
-					// We have been asked to stop, so don't read any more files
-					break;
-				}
-
-				LongPackageNameString.Reset();
-				if (!FPackageName::TryConvertFilenameToLongPackageName(AssetFileData.PackageFilename, LongPackageNameString))
-				{
-					// Conversion is expected to fail when the path has recently been unmounted, fail silent instead of fatal crash
-					continue;
-				}
-
-				const FName PackageName = *LongPackageNameString;
-				const FName Extension = FName(*FPaths::GetExtension(AssetFileData.PackageFilename));
-
-				bool bLoadedFromCache = false;
-				if (bLoadAndSaveCache)
+			ReadContexts.SetNum(LocalFilesToSearch.Num());
+			ParallelFor(ReadContexts.Num(),
+				[this, &ReadContexts, &LocalFilesToSearch](int32 Index)
 				{
-					FDiskCachedAssetData* DiskCachedAssetData = DiskCachedAssetDataMap.Find(PackageName);
-					if (DiskCachedAssetData)
+					if (StopTaskCounter.GetValue() != 0)
 					{
-						const FDateTime& CachedTimestamp = DiskCachedAssetData->Timestamp;
-						if (AssetFileData.PackageTimestamp != CachedTimestamp)
-						{
-							DiskCachedAssetData = nullptr;
-						}
-						else if ((DiskCachedAssetData->DependencyData.PackageName != PackageName && DiskCachedAssetData->DependencyData.PackageName != NAME_None) ||
-								DiskCachedAssetData->Extension != Extension)
-						{
-							UE_LOG(LogAssetRegistry, Display, TEXT("Cached dependency data for package '%s' is invalid. Discarding cached data."), *PackageName.ToString());
-							DiskCachedAssetData = nullptr;
-						}
+						// We have been asked to stop, so don't read any more files
+						return;
 					}
 
-					if (DiskCachedAssetData)
+					const FDiscoveredPackageFile& AssetFileData = LocalFilesToSearch[Index];
+					FReadContext& ReadContext = ReadContexts[Index];
+
+					FString LongPackageNameString;
+					if (!FPackageName::TryConvertFilenameToLongPackageName(AssetFileData.PackageFilename, LongPackageNameString))
 					{
-						bLoadedFromCache = true;
+						// Conversion is expected to fail when the path has recently been unmounted, fail silent instead of fatal crash
+						return;
+					}
 
-						++NumCachedFiles;
+					ReadContext.PackageName = *LongPackageNameString;
+					ReadContext.Extension = FName(*FPaths::GetExtension(AssetFileData.PackageFilename));
 
-						LocalAssetResults.Reserve(LocalAssetResults.Num() + DiskCachedAssetData->AssetDataList.Num());
-						for (const FAssetData& AssetData : DiskCachedAssetData->AssetDataList)
+					if (bLoadAndSaveCache)
+					{
+						// DiskCachedAssetDataMap is not modified after the cache is loaded, so it can be searched from any thread
+						FDiskCachedAssetData* DiskCachedAssetData = DiskCachedAssetDataMap.Find(ReadContext.PackageName);
+						if (DiskCachedAssetData)
 						{
-							LocalAssetResults.Add(new FAssetData(AssetData));
+							const FDateTime& CachedTimestamp = DiskCachedAssetData->Timestamp;
+							if (AssetFileData.PackageTimestamp != CachedTimestamp)
+							{
+								DiskCachedAssetData = nullptr;
+							}
+							else if ((DiskCachedAssetData->DependencyData.PackageName != ReadContext.PackageName && DiskCachedAssetData->DependencyData.PackageName != NAME_None) ||
+									DiskCachedAssetData->Extension != ReadContext.Extension)
+							{
+								UE_LOG(LogAssetRegistry, Display, TEXT("Cached dependency data for package '%s' is invalid. Discarding cached data."), *LongPackageNameString);
+								DiskCachedAssetData = nullptr;
+							}
 						}
 
-						if (bGatherDependsData)
+						if (DiskCachedAssetData)
 						{
-							LocalDependencyResults.Add(DiskCachedAssetData->DependencyData);
-						}
+							ReadContext.DiskCachedAssetData = DiskCachedAssetData;
 
-						AddToCache(PackageName, DiskCachedAssetData);
+							ReadContext.AssetDataFromFile.Reserve(DiskCachedAssetData->AssetDataList.Num());
+							for (const FAssetData& AssetData : DiskCachedAssetData->AssetDataList)
+							{
+								ReadContext.AssetDataFromFile.Add(new FAssetData(AssetData));
+							}
+							return;
+						}
 					}
-				}
-
-				if (!bLoadedFromCache)
-				{
-					ReadContexts.Emplace(PackageName, Extension, AssetFileData);
-				}
-			}
 
-			ParallelFor(ReadContexts.Num(),
-				[this, &ReadContexts](int32 Index)
-				{
-					FReadContext& ReadContext = ReadContexts[Index];
-					ReadContext.bResult = ReadAssetFile(ReadContext.AssetFileData.PackageFilename, ReadContext.AssetDataFromFile, ReadContext.DependencyData, ReadContext.CookedPackageNamesWithoutAssetData, ReadContext.bCanAttemptAssetRetry);
+					ReadContext.bResult = ReadAssetFile(AssetFileData.PackageFilename, ReadContext.AssetDataFromFile, ReadContext.DependencyData, ReadContext.CookedPackageNamesWithoutAssetData, ReadContext.bCanAttemptAssetRetry);
 				},
 				EParallelForFlags::Unbalanced | EParallelForFlags::BackgroundPriority
 			);
 
-			for (FReadContext& ReadContext : ReadContexts)
+			int32 NumReadFiles = 0;
+			int32 NumCachedFilesInBatch = 0;
+			for (int32 ContextIdx = 0; ContextIdx < ReadContexts.Num(); ++ContextIdx)
 			{
-				if (ReadContext.bResult)
+				FReadContext& ReadContext = ReadContexts[ContextIdx];
+				const FDiscoveredPackageFile& AssetFileData = LocalFilesToSearch[ContextIdx];
+
+				if (ReadContext.DiskCachedAssetData)
 				{
-					++NumUncachedFiles;
+					++NumCachedFilesInBatch;
+
+					LocalAssetResults.Append(MoveTemp(ReadContext.AssetDataFromFile));
+					if (bGatherDependsData)
+					{
+						LocalDependencyResults.Add(ReadContext.DiskCachedAssetData->DependencyData);
+					}
+
+					AddToCache(ReadContext.PackageName, ReadContext.DiskCachedAssetData);
+				}
+				else if (ReadContext.bResult)
+				{
+					++NumReadFiles;
 
 					LocalCookedPackageNamesWithoutAssetDataResults.Append(MoveTemp(ReadContext.CookedPackageNamesWithoutAssetData));
 
@@ -746,7 +800,7 @@ uint32 FAssetDataGatherer::Run()
 					if (bCachePackage)
 					{
 						// Update the cache
-						FDiskCachedAssetData* NewData = new FDiskCachedAssetData(ReadContext.AssetFileData.PackageTimestamp, ReadContext.Extension);
+						FDiskCachedAssetData* NewData = new FDiskCachedAssetData(AssetFileData.PackageTimestamp, ReadContext.Extension);
 						NewData->AssetDataList.Reserve(ReadContext.AssetDataFromFile.Num());
 						for (const FAssetData* BackgroundAssetData : ReadContext.AssetDataFromFile)
 						{
@@ -775,10 +829,19 @@ uint32 FAssetDataGatherer::Run()
 				}
 				else if (ReadContext.bCanAttemptAssetRetry)
 				{
-					LocalFilesToRetry.Add(ReadContext.AssetFileData);
+					LocalFilesToRetry.Add(AssetFileData);
 				}
 			}
 
+			NumCachedFiles += NumCachedFilesInBatch;
+			NumUncachedFiles += NumReadFiles;
+			{
+				FScopeLock CritSectionLock(&WorkerThreadCriticalSection);
+				Stats.NumCachedFiles += NumCachedFilesInBatch;
+				Stats.NumReadFiles += NumReadFiles;
+				Stats.GatherSeconds += FPlatformTime::Seconds() - GatherStartTime;
+			}
+
 			LocalFilesToSearch.Reset();
 			LocalFilesToSearch.Append(LocalFilesToRetry);
 			LocalFilesToRetry.Reset();
@@ -970,6 +1033,24 @@ void FAssetDataGatherer::SetBlacklistScanFilters(const TArray<FString>& InBlackl
 	}
 }
 
+FAssetGatherStats FAssetDataGatherer::GetStats()
+{
+	FAssetGatherStats OutStats;
+	{
+		FScopeLock CritSectionLock(&WorkerThreadCriticalSection);
+		OutStats = Stats;
+	}
+
+	if (BackgroundPackageFileDiscovery.IsValid())
+	{
+		const FAssetGatherStats DiscoveryStats = BackgroundPackageFileDiscovery->GetStats();
+		OutStats.NumDirectories = DiscoveryStats.NumDirectories;
+		OutStats.NumDiscoveredFiles = DiscoveryStats.NumDiscoveredFiles;
+		OutStats.DiscoverySeconds = DiscoveryStats.DiscoverySeconds;
+	}
+	return OutStats;
+}
+
 void FAssetDataGatherer::SortPathsByPriority(const int32 MaxNumToSort)
 {
 	FScopeLock CritSectionLock(&WorkerThreadCriticalSection);
@@ -66,6 +66,32 @@ struct FDiscoveredPackageFile
 	FDateTime PackageTimestamp;
 };
 
+/**
+ * Throughput of the asset discovery and gather, summed over all the work they did so far
+ */
+struct FAssetGatherStats
+{
+	/** Directories listed and package files found by the discovery, and the time it spent listing */
+	int32 NumDirectories = 0;
+	int32 NumDiscoveredFiles = 0;
+	double DiscoverySeconds = 0.0;
+
+	/** Package files gathered from the cache or by reading their header, and the time spent gathering them */
+	int32 NumCachedFiles = 0;
+	int32 NumReadFiles = 0;
+	double GatherSeconds = 0.0;
+
+	double GetDiscoveredFilesPerSecond() const
+	{
+		return DiscoverySeconds > 0.0 ? NumDiscoveredFiles / DiscoverySeconds : 0.0;
+	}
+
+	double GetGatheredFilesPerSecond() const
+	{
+		return GatherSeconds > 0.0 ? (NumCachedFiles + NumReadFiles) / GatherSeconds : 0.0;
+	}
+};
+
 namespace AssetDataDiscoveryUtil
 {
 	bool PassesScanFilters(const TArray<FString>& InBlacklistFilters, const FString& InPath);
@@ -102,6 +128,9 @@ public:
 	/** Set the blacklist filters to use during scanning. */
 	void SetBlacklistScanFilters(const TArray<FString>& InBlacklistScanFilters);
 
+	/** Gets the discovery throughput so far */
+	FAssetGatherStats GetStats();
+
 private:
 	/** Sort the paths so that items belonging to the current priority path is processed first */
 	void SortPathsByPriority(const int32 MaxNumToSort);
@@ -138,6 +167,9 @@ private:
 	/** > 0 if we've been asked to abort work in progress at the next opportunity */
 	FThreadSafeCounter StopTaskCounter;
 
+	/** Discovery throughput, the gather fields are unused */
+	FAssetGatherStats Stats;
+
 	/** Thread to run the discovery FRunnable on */
 	FRunnableThread* Thread;
 };
@@ -193,6 +225,9 @@ public:
 	/** Set the blacklist filters to use during scanning. */
 	void SetBlacklistScanFilters(const TArray<FString>& InBlacklistScanFilters);
 
+	/** Gets the discovery and gather throughput so far */
+	FAssetGatherStats GetStats();
+
 private:
 	/** Sort the paths so that items belonging to the current priority path is processed first */
 	void SortPathsByPriority(const int32 MaxNumToSort);
@@ -265,6 +300,9 @@ private:
 	/** Background package file discovery (when running async) */
 	TSharedPtr<FAssetDataDiscovery> BackgroundPackageFileDiscovery;
 
+	/** Gather throughput, and discovery throughput when the discovery ran synchronously */
+	FAssetGatherStats Stats;
+
 	///////////////////////////////////////////////////////////////
 	// Asset discovery caching
 	///////////////////////////////////////////////////////////////
@@ -579,6 +579,7 @@ static void InitializeSerializationOptionsFromIni(FAssetRegistrySerializationOpt
 	EngineIni->GetBool(TEXT("AssetRegistry"), TEXT("bSerializeNameDependencies"), Options.bSerializeSearchableNameDependencies);
 	EngineIni->GetBool(TEXT("AssetRegistry"), TEXT("bSerializeManageDependencies"), Options.bSerializeManageDependencies);
 	EngineIni->GetBool(TEXT("AssetRegistry"), TEXT("bSerializePackageData"), Options.bSerializePackageData);
+	EngineIni->GetBool(TEXT("AssetRegistry"), TEXT("bSerializeMappedAssetRegistry"), Options.bSerializeMapped);
 	EngineIni->GetBool(TEXT("AssetRegistry"), TEXT("bUseAssetRegistryTagsWhitelistInsteadOfBlacklist"), Options.bUseAssetRegistryTagsWhitelistInsteadOfBlacklist);
 	EngineIni->GetBool(TEXT("AssetRegistry"), TEXT("bFilterAssetDataWithNoTags"), Options.bFilterAssetDataWithNoTags);
 	EngineIni->GetBool(TEXT("AssetRegistry"), TEXT("bFilterDependenciesWithNoTags"), Options.bFilterDependenciesWithNoTags);
@@ -1892,6 +1893,13 @@ bool UAssetRegistryImpl::IsLoadingAssets() const
 	return !bInitialSearchCompleted;
 }
 
+static FString GetGatherStatsString(const FAssetGatherStats& Stats)
+{
+	return FString::Printf(TEXT("Asset gather listed %d directories with %d package files in %0.4f seconds (%.0f files/s), found %d packages in the cache and read %d package headers in %0.4f seconds (%.0f packages/s)"),
+		Stats.NumDirectories, Stats.NumDiscoveredFiles, Stats.DiscoverySeconds, Stats.GetDiscoveredFilesPerSecond(),
+		Stats.NumCachedFiles, Stats.NumReadFiles, Stats.GatherSeconds, Stats.GetGatheredFilesPerSecond());
+}
+
 void UAssetRegistryImpl::Tick(float DeltaTime)
 {
 	double TickStartTime = FPlatformTime::Seconds();
@@ -1991,6 +1999,10 @@ void UAssetRegistryImpl::Tick(float DeltaTime)
 #endif
 			UE_LOG(LogAssetRegistry, Verbose, TEXT("### Time spent amortizing search results: %0.4f seconds"), TotalAmortizeTime);
 			UE_LOG(LogAssetRegistry, Log, TEXT("Asset discovery search completed in %0.4f seconds"), FPlatformTime::Seconds() - FullSearchStartTime);
+			if (BackgroundAssetSearch.IsValid())
+			{
+				UE_LOG(LogAssetRegistry, Log, TEXT("%s"), *GetGatherStatsString(BackgroundAssetSearch->GetStats()));
+			}
 
 			bInitialSearchCompleted = true;
 
@@ -2219,6 +2231,7 @@ void UAssetRegistryImpl::ScanPathsAndFilesSynchronous(const TArray<FString>& InP
 		int32 NumPathsToSearch = 0;
 		bool bIsDiscoveringFiles = false;
 		AssetSearch.GetAndTrimSearchResults(AssetResults, PathResults, DependencyResults, CookedPackageNamesWithoutAssetDataResults, SearchTimes, NumFilesToSearch, NumPathsToSearch, bIsDiscoveringFiles);
+		UE_LOG(LogAssetRegistry, Verbose, TEXT("%s"), *GetGatherStatsString(AssetSearch.GetStats()));
 
 		if (OutFoundAssets)
 		{
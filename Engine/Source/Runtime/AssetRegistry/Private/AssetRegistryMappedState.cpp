@@ -0,0 +1,838 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AssetRegistry/AssetRegistryMappedState.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+#include "Algo/StableSort.h"
+#include "Algo/Unique.h"
+#include "AssetRegistry/AssetRegistryState.h"
+#include "AssetRegistryPrivate.h"
+#include "Async/MappedFileHandle.h"
+#include "DependsNode.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/StringBuilder.h"
+
+namespace AssetRegistryMappedState
+{
+	static constexpr uint32 Magic = 0x534d5241; // "ARMS"
+	static constexpr uint32 Version = 1;
+	static constexpr uint64 SectionAlignment = 8;
+
+	namespace ESection
+	{
+	enum Type
+	{
+		NameOffsets,		// uint32 per name and one past the last, offsets of the names in NameChars
+		NameChars,			// UTF-8 names, sorted with CompareNames
+		Assets,				// FAsset per asset, sorted by object path
+		AssetsByPackage,	// uint32 asset indices sorted by package name
+		AssetsByPath,		// uint32 asset indices sorted by package path
+		AssetsByClass,		// uint32 asset indices sorted by class
+		Tags,				// FTag per tag, grouped by asset and sorted by key within an asset
+		TagsByKey,			// uint32 tag indices sorted by key
+		TagValues,			// UTF-8 tag values
+		ChunkIds,			// int32 chunk ids, grouped by asset
+		Packages,			// uint32 name index per package with dependency data, sorted
+		DependencyOffsets,	// uint32 per package and one past the last, offsets of the dependencies of the package in Dependencies
+		Dependencies,		// FEdge per package dependency
+		ReferencerOffsets,	// uint32 per package and one past the last, offsets of the referencers of the package in Referencers
+		Referencers,		// FEdge per package referencer
+		PackageData,		// FPackageData per package, sorted by name
+		NumSections
+	};
+	}
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 NumNames;
+		uint32 NumAssets;
+		uint32 NumTags;
+		uint32 NumPackages;
+		uint32 NumEdges;
+		uint32 NumPackageData;
+		/** Start of each section and end of the last one */
+		uint64 SectionOffsets[ESection::NumSections + 1];
+	};
+
+	struct FAsset
+	{
+		uint32 ObjectPath;
+		uint32 PackageName;
+		uint32 PackagePath;
+		uint32 AssetName;
+		uint32 AssetClass;
+		uint32 PackageFlags;
+		uint32 FirstTag;
+		uint32 NumTags;
+		uint32 FirstChunkId;
+		uint32 NumChunkIds;
+	};
+
+	struct FTag
+	{
+		uint32 Key;
+		uint32 Asset;
+		uint32 ValueOffset;
+		uint32 ValueLength;
+	};
+
+	struct FEdge
+	{
+		/** Index in Packages of the dependency or referencer */
+		uint32 Package;
+		uint32 Properties;
+	};
+
+	struct FPackageData
+	{
+		uint32 Name;
+		uint32 bHasCookedHash;
+		int64 DiskSize;
+		uint8 CookedHash[16];
+	};
+
+	static_assert(sizeof(FHeader) % SectionAlignment == 0 && sizeof(FAsset) == 40 && sizeof(FTag) == 16 && sizeof(FEdge) == 8 && sizeof(FPackageData) == 32, "Types are written as they are in memory");
+
+	/** Order of the name table, case insensitive for ASCII like FName */
+	static int32 CompareNames(const ANSICHAR* A, int32 LenA, const ANSICHAR* B, int32 LenB)
+	{
+		const int32 Len = FMath::Min(LenA, LenB);
+		for (int32 Index = 0; Index < Len; ++Index)
+		{
+			uint8 CharA = uint8(A[Index]);
+			uint8 CharB = uint8(B[Index]);
+			CharA += (CharA >= 'A' && CharA <= 'Z') ? 'a' - 'A' : 0;
+			CharB += (CharB >= 'A' && CharB <= 'Z') ? 'a' - 'A' : 0;
+			if (CharA != CharB)
+			{
+				return CharA < CharB ? -1 : 1;
+			}
+		}
+		return LenA - LenB;
+	}
+
+	static FString ToString(const uint8* Chars, uint32 Len)
+	{
+		FUTF8ToTCHAR String(reinterpret_cast<const ANSICHAR*>(Chars), Len);
+		return FString(String.Length(), String.Get());
+	}
+
+	/** Tag values are deduplicated case sensitively */
+	struct FCaseSensitiveValueKeyFuncs : TDefaultMapKeyFuncs<FString, uint32, false>
+	{
+		static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+
+	template <typename T>
+	static void WriteSection(FArchive& Ar, const TArray<T>& Items)
+	{
+		Ar.Serialize(const_cast<T*>(Items.GetData()), Items.Num() * sizeof(T));
+
+		uint8 Padding[SectionAlignment] = {};
+		Ar.Serialize(Padding, Align(Items.Num() * sizeof(T), SectionAlignment) - Items.Num() * sizeof(T));
+	}
+}
+
+using namespace AssetRegistryMappedState;
+
+FAssetRegistryMappedState::FAssetRegistryMappedState() = default;
+
+FAssetRegistryMappedState::~FAssetRegistryMappedState()
+{
+	Close();
+}
+
+bool FAssetRegistryMappedState::Save(const FAssetRegistryState& State, FArchive& Ar, const FAssetRegistrySerializationOptions& Options)
+{
+	using namespace UE::AssetRegistry;
+
+	check(!Ar.IsLoading());
+
+	// Everything to write, before the names are replaced by their index
+	TArray<FAssetData*> SourceAssets;
+	State.CachedAssetsByObjectPath.GenerateValueArray(SourceAssets);
+
+	TMap<FName, TArray<FAssetDependency>> PackageDependencies;
+	if (Options.bSerializeDependencies)
+	{
+		for (const TPair<FAssetIdentifier, FDependsNode*>& Pair : State.CachedDependsNodes)
+		{
+			if (Pair.Key.IsPackage())
+			{
+				TArray<FAssetDependency>& Dependencies = PackageDependencies.FindOrAdd(Pair.Key.PackageName);
+				Pair.Value->GetDependencies(Dependencies, EDependencyCategory::Package);
+			}
+		}
+	}
+
+	TArray<TPair<FName, const FAssetPackageData*>> PackageDatas;
+	if (Options.bSerializePackageData)
+	{
+		for (const TPair<FName, FAssetPackageData*>& Pair : State.CachedPackageData)
+		{
+			PackageDatas.Emplace(Pair.Key, Pair.Value);
+		}
+	}
+
+	// The name table, sorted so that comparing indices compares the names
+	TMap<FName, uint32> NameIndices;
+	for (const FAssetData* AssetData : SourceAssets)
+	{
+		NameIndices.Add(AssetData->ObjectPath);
+		NameIndices.Add(AssetData->PackageName);
+		NameIndices.Add(AssetData->PackagePath);
+		NameIndices.Add(AssetData->AssetName);
+		NameIndices.Add(AssetData->AssetClass);
+		AssetData->TagsAndValues.ForEach([&NameIndices](TPair<FName, FAssetTagValueRef> Pair)
+		{
+			NameIndices.Add(Pair.Key);
+		});
+	}
+	for (const TPair<FName, TArray<FAssetDependency>>& Pair : PackageDependencies)
+	{
+		NameIndices.Add(Pair.Key);
+		for (const FAssetDependency& Dependency : Pair.Value)
+		{
+			NameIndices.Add(Dependency.AssetId.PackageName);
+		}
+	}
+	for (const TPair<FName, const FAssetPackageData*>& Pair : PackageDatas)
+	{
+		NameIndices.Add(Pair.Key);
+	}
+
+	TArray<TPair<FName, TArray<ANSICHAR>>> Names;
+	Names.Reserve(NameIndices.Num());
+	for (const TPair<FName, uint32>& Pair : NameIndices)
+	{
+		FTCHARToUTF8 String(*Pair.Key.ToString());
+		Names.Emplace(Pair.Key, TArray<ANSICHAR>(String.Get(), String.Length()));
+	}
+	Names.Sort([](const TPair<FName, TArray<ANSICHAR>>& A, const TPair<FName, TArray<ANSICHAR>>& B)
+	{
+		return CompareNames(A.Value.GetData(), A.Value.Num(), B.Value.GetData(), B.Value.Num()) < 0;
+	});
+
+	TArray<uint32> NameOffsets;
+	TArray<uint8> NameChars;
+	NameOffsets.Reserve(Names.Num() + 1);
+	for (const TPair<FName, TArray<ANSICHAR>>& Name : Names)
+	{
+		NameIndices[Name.Key] = NameOffsets.Num();
+		NameOffsets.Add(NameChars.Num());
+		NameChars.Append(reinterpret_cast<const uint8*>(Name.Value.GetData()), Name.Value.Num());
+	}
+	NameOffsets.Add(NameChars.Num());
+
+	// Assets with their tags and chunks
+	SourceAssets.Sort([&NameIndices](const FAssetData& A, const FAssetData& B)
+	{
+		return NameIndices[A.ObjectPath] < NameIndices[B.ObjectPath];
+	});
+
+	TArray<FAsset> Assets;
+	TArray<FTag> Tags;
+	TArray<uint8> TagValues;
+	TArray<int32> ChunkIds;
+	TMap<FString, uint32, FDefaultSetAllocator, FCaseSensitiveValueKeyFuncs> TagValueOffsets;
+	Assets.Reserve(SourceAssets.Num());
+	for (const FAssetData* AssetData : SourceAssets)
+	{
+		FAsset& Asset = Assets.AddDefaulted_GetRef();
+		Asset.ObjectPath = NameIndices[AssetData->ObjectPath];
+		Asset.PackageName = NameIndices[AssetData->PackageName];
+		Asset.PackagePath = NameIndices[AssetData->PackagePath];
+		Asset.AssetName = NameIndices[AssetData->AssetName];
+		Asset.AssetClass = NameIndices[AssetData->AssetClass];
+		Asset.PackageFlags = AssetData->PackageFlags;
+		Asset.FirstTag = Tags.Num();
+		Asset.NumTags = AssetData->TagsAndValues.Num();
+		Asset.FirstChunkId = ChunkIds.Num();
+		Asset.NumChunkIds = AssetData->ChunkIDs.Num();
+		ChunkIds.Append(AssetData->ChunkIDs);
+
+		AssetData->TagsAndValues.ForEach([&](TPair<FName, FAssetTagValueRef> Pair)
+		{
+			// Values are stored as strings, texts as their complex string
+			const FString Value = Pair.Value.ToLoose();
+			FTCHARToUTF8 Utf8Value(*Value);
+
+			FTag& Tag = Tags.AddDefaulted_GetRef();
+			Tag.Key = NameIndices[Pair.Key];
+			Tag.Asset = Assets.Num() - 1;
+			Tag.ValueLength = Utf8Value.Length();
+			if (const uint32* ExistingOffset = TagValueOffsets.Find(Value))
+			{
+				Tag.ValueOffset = *ExistingOffset;
+			}
+			else
+			{
+				Tag.ValueOffset = TagValues.Num();
+				TagValueOffsets.Add(Value, Tag.ValueOffset);
+				TagValues.Append(reinterpret_cast<const uint8*>(Utf8Value.Get()), Utf8Value.Length());
+			}
+		});
+		Algo::SortBy(MakeArrayView(Tags).Slice(Asset.FirstTag, Asset.NumTags), &FTag::Key);
+	}
+
+	auto MakeSortedIndices = [](int32 Num, TFunctionRef<uint32(int32)> GetKey)
+	{
+		TArray<uint32> Indices;
+		Indices.SetNumUninitialized(Num);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Indices[Index] = Index;
+		}
+		Algo::StableSortBy(Indices, [&GetKey](uint32 Index) { return GetKey(Index); });
+		return Indices;
+	};
+	const TArray<uint32> AssetsByPackage = MakeSortedIndices(Assets.Num(), [&Assets](int32 Index) { return Assets[Index].PackageName; });
+	const TArray<uint32> AssetsByPath = MakeSortedIndices(Assets.Num(), [&Assets](int32 Index) { return Assets[Index].PackagePath; });
+	const TArray<uint32> AssetsByClass = MakeSortedIndices(Assets.Num(), [&Assets](int32 Index) { return Assets[Index].AssetClass; });
+	const TArray<uint32> TagsByKey = MakeSortedIndices(Tags.Num(), [&Tags](int32 Index) { return Tags[Index].Key; });
+
+	// Every package that has or is a dependency, with its dependencies and referencers as compressed sparse rows
+	TArray<uint32> Packages;
+	for (const TPair<FName, TArray<FAssetDependency>>& Pair : PackageDependencies)
+	{
+		Packages.Add(NameIndices[Pair.Key]);
+		for (const FAssetDependency& Dependency : Pair.Value)
+		{
+			Packages.Add(NameIndices[Dependency.AssetId.PackageName]);
+		}
+	}
+	Packages.Sort();
+	Packages.SetNum(Algo::Unique(Packages));
+
+	TArray<uint32> DependencyOffsets;
+	TArray<FEdge> Dependencies;
+	TArray<uint32> ReferencerCounts;
+	DependencyOffsets.Reserve(Packages.Num() + 1);
+	ReferencerCounts.SetNumZeroed(Packages.Num());
+	for (uint32 NameIndex : Packages)
+	{
+		DependencyOffsets.Add(Dependencies.Num());
+
+		const int32 FirstDependency = Dependencies.Num();
+		if (const TArray<FAssetDependency>* PackageDependencyList = PackageDependencies.Find(Names[NameIndex].Key))
+		{
+			for (const FAssetDependency& Dependency : *PackageDependencyList)
+			{
+				FEdge& Edge = Dependencies.AddDefaulted_GetRef();
+				Edge.Package = Algo::BinarySearch(Packages, NameIndices[Dependency.AssetId.PackageName]);
+				Edge.Properties = uint32(Dependency.Properties);
+				++ReferencerCounts[Edge.Package];
+			}
+		}
+		Algo::SortBy(MakeArrayView(Dependencies).Slice(FirstDependency, Dependencies.Num() - FirstDependency), &FEdge::Package);
+	}
+	DependencyOffsets.Add(Dependencies.Num());
+
+	TArray<uint32> ReferencerOffsets;
+	ReferencerOffsets.Reserve(Packages.Num() + 1);
+	uint32 NumReferencers = 0;
+	for (uint32 Count : ReferencerCounts)
+	{
+		ReferencerOffsets.Add(NumReferencers);
+		NumReferencers += Count;
+	}
+	ReferencerOffsets.Add(NumReferencers);
+
+	// Referencers come out sorted since the packages are visited in order
+	TArray<FEdge> Referencers;
+	Referencers.SetNumUninitialized(NumReferencers);
+	TArray<uint32> NextReferencer(ReferencerOffsets.GetData(), Packages.Num());
+	for (int32 PackageIndex = 0; PackageIndex < Packages.Num(); ++PackageIndex)
+	{
+		for (uint32 EdgeIndex = DependencyOffsets[PackageIndex]; EdgeIndex < DependencyOffsets[PackageIndex + 1]; ++EdgeIndex)
+		{
+			const FEdge& Dependency = Dependencies[EdgeIndex];
+			Referencers[NextReferencer[Dependency.Package]++] = FEdge{ uint32(PackageIndex), Dependency.Properties };
+		}
+	}
+
+	TArray<FPackageData> PackageData;
+	PackageData.Reserve(PackageDatas.Num());
+	for (const TPair<FName, const FAssetPackageData*>& Pair : PackageDatas)
+	{
+		FPackageData& Package = PackageData.AddZeroed_GetRef();
+		Package.Name = NameIndices[Pair.Key];
+		Package.DiskSize = Pair.Value->DiskSize;
+		Package.bHasCookedHash = Pair.Value->CookedHash.IsValid();
+		if (Package.bHasCookedHash)
+		{
+			FMemory::Memcpy(Package.CookedHash, Pair.Value->CookedHash.GetBytes(), sizeof(Package.CookedHash));
+		}
+	}
+	Algo::SortBy(PackageData, &FPackageData::Name);
+
+	// Header and sections
+	FHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = Magic;
+	Header.Version = Version;
+	Header.NumNames = Names.Num();
+	Header.NumAssets = Assets.Num();
+	Header.NumTags = Tags.Num();
+	Header.NumPackages = Packages.Num();
+	Header.NumEdges = Dependencies.Num();
+	Header.NumPackageData = PackageData.Num();
+
+	const uint64 SectionSizes[ESection::NumSections] =
+	{
+		NameOffsets.Num() * sizeof(uint32),
+		uint64(NameChars.Num()),
+		Assets.Num() * sizeof(FAsset),
+		AssetsByPackage.Num() * sizeof(uint32),
+		AssetsByPath.Num() * sizeof(uint32),
+		AssetsByClass.Num() * sizeof(uint32),
+		Tags.Num() * sizeof(FTag),
+		TagsByKey.Num() * sizeof(uint32),
+		uint64(TagValues.Num()),
+		ChunkIds.Num() * sizeof(int32),
+		Packages.Num() * sizeof(uint32),
+		DependencyOffsets.Num() * sizeof(uint32),
+		Dependencies.Num() * sizeof(FEdge),
+		ReferencerOffsets.Num() * sizeof(uint32),
+		Referencers.Num() * sizeof(FEdge),
+		PackageData.Num() * sizeof(FPackageData),
+	};
+	uint64 Offset = sizeof(FHeader);
+	for (int32 Section = 0; Section < ESection::NumSections; ++Section)
+	{
+		Header.SectionOffsets[Section] = Offset;
+		Offset += Align(SectionSizes[Section], SectionAlignment);
+	}
+	Header.SectionOffsets[ESection::NumSections] = Offset;
+
+	Ar.Serialize(&Header, sizeof(Header));
+	WriteSection(Ar, NameOffsets);
+	WriteSection(Ar, NameChars);
+	WriteSection(Ar, Assets);
+	WriteSection(Ar, AssetsByPackage);
+	WriteSection(Ar, AssetsByPath);
+	WriteSection(Ar, AssetsByClass);
+	WriteSection(Ar, Tags);
+	WriteSection(Ar, TagsByKey);
+	WriteSection(Ar, TagValues);
+	WriteSection(Ar, ChunkIds);
+	WriteSection(Ar, Packages);
+	WriteSection(Ar, DependencyOffsets);
+	WriteSection(Ar, Dependencies);
+	WriteSection(Ar, ReferencerOffsets);
+	WriteSection(Ar, Referencers);
+	WriteSection(Ar, PackageData);
+
+	return !Ar.IsError();
+}
+
+bool FAssetRegistryMappedState::Open(const TCHAR* Filename)
+{
+	LLM_SCOPE(ELLMTag::AssetRegistry);
+	Close();
+
+	MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(Filename));
+	if (MappedFile && MappedFile->GetFileSize() > 0)
+	{
+		MappedRegion.Reset(MappedFile->MapRegion());
+	}
+
+	if (MappedRegion)
+	{
+		if (SetData(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize()))
+		{
+			return true;
+		}
+		Close();
+		return false;
+	}
+
+	// Not all platforms can map files
+	MappedFile.Reset();
+	TArray64<uint8> FileData;
+	return FFileHelper::LoadFileToArray(FileData, Filename, FILEREAD_Silent) && Open(MoveTemp(FileData));
+}
+
+bool FAssetRegistryMappedState::Open(TArray64<uint8>&& InData)
+{
+	Close();
+
+	LoadedData = MoveTemp(InData);
+	if (SetData(LoadedData.GetData(), LoadedData.Num()))
+	{
+		return true;
+	}
+	Close();
+	return false;
+}
+
+void FAssetRegistryMappedState::Close()
+{
+	{
+		FWriteScopeLock Lock(AssetDatasLock);
+		AssetDatas.Empty();
+	}
+
+	Data = nullptr;
+	DataSize = 0;
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	LoadedData.Empty();
+}
+
+bool FAssetRegistryMappedState::SetData(const uint8* InData, int64 InDataSize)
+{
+	const FHeader* Header = reinterpret_cast<const FHeader*>(InData);
+	if (!InData || !IsAligned(InData, SectionAlignment) || InDataSize < int64(sizeof(FHeader)) || Header->Magic != Magic || Header->Version != Version)
+	{
+		UE_LOG(LogAssetRegistry, Warning, TEXT("Not a mapped asset registry, or one of another version."));
+		return false;
+	}
+
+	// Only the sizes of the sections are checked, the indices in them are trusted like in the serialized format
+	const uint64 MinSectionSizes[ESection::NumSections] =
+	{
+		(Header->NumNames + 1ull) * sizeof(uint32),
+		0,
+		Header->NumAssets * uint64(sizeof(FAsset)),
+		Header->NumAssets * uint64(sizeof(uint32)),
+		Header->NumAssets * uint64(sizeof(uint32)),
+		Header->NumAssets * uint64(sizeof(uint32)),
+		Header->NumTags * uint64(sizeof(FTag)),
+		Header->NumTags * uint64(sizeof(uint32)),
+		0,
+		0,
+		Header->NumPackages * uint64(sizeof(uint32)),
+		(Header->NumPackages + 1ull) * sizeof(uint32),
+		Header->NumEdges * uint64(sizeof(FEdge)),
+		(Header->NumPackages + 1ull) * sizeof(uint32),
+		Header->NumEdges * uint64(sizeof(FEdge)),
+		Header->NumPackageData * uint64(sizeof(FPackageData)),
+	};
+	bool bValid = Header->SectionOffsets[0] == sizeof(FHeader) && Header->SectionOffsets[ESection::NumSections] == uint64(InDataSize);
+	for (int32 Section = 0; Section < ESection::NumSections && bValid; ++Section)
+	{
+		bValid = Header->SectionOffsets[Section] % SectionAlignment == 0 &&
+			Header->SectionOffsets[Section] + MinSectionSizes[Section] <= Header->SectionOffsets[Section + 1];
+	}
+	if (bValid)
+	{
+		const uint32* NameOffsetsData = reinterpret_cast<const uint32*>(InData + Header->SectionOffsets[ESection::NameOffsets]);
+		bValid = NameOffsetsData[Header->NumNames] <= Header->SectionOffsets[ESection::NameChars + 1] - Header->SectionOffsets[ESection::NameChars];
+	}
+	if (!bValid)
+	{
+		UE_LOG(LogAssetRegistry, Warning, TEXT("Ignoring a mapped asset registry with invalid sections."));
+		return false;
+	}
+
+	Data = InData;
+	DataSize = InDataSize;
+	return true;
+}
+
+namespace AssetRegistryMappedState
+{
+	static const FHeader& GetHeader(const uint8* Data)
+	{
+		return *reinterpret_cast<const FHeader*>(Data);
+	}
+
+	template <typename T>
+	static TArrayView<const T> GetSection(const uint8* Data, ESection::Type Section, uint32 Num)
+	{
+		return TArrayView<const T>(reinterpret_cast<const T*>(Data + GetHeader(Data).SectionOffsets[Section]), Num);
+	}
+
+	static TArrayView<const FAsset> GetAssets(const uint8* Data)
+	{
+		return GetSection<FAsset>(Data, ESection::Assets, GetHeader(Data).NumAssets);
+	}
+
+	static TArrayView<const FTag> GetTags(const uint8* Data)
+	{
+		return GetSection<FTag>(Data, ESection::Tags, GetHeader(Data).NumTags);
+	}
+}
+
+int32 FAssetRegistryMappedState::GetNumAssets() const
+{
+	return Data ? GetHeader(Data).NumAssets : 0;
+}
+
+int32 FAssetRegistryMappedState::FindName(FName Name) const
+{
+	if (!Data)
+	{
+		return INDEX_NONE;
+	}
+
+	TStringBuilder<FName::StringBufferSize> NameString;
+	Name.AppendString(NameString);
+	FTCHARToUTF8 Utf8Name(NameString.ToString(), NameString.Len());
+
+	const TArrayView<const uint32> Offsets = GetSection<uint32>(Data, ESection::NameOffsets, GetHeader(Data).NumNames + 1);
+	const ANSICHAR* Chars = reinterpret_cast<const ANSICHAR*>(Data + GetHeader(Data).SectionOffsets[ESection::NameChars]);
+	int32 First = 0;
+	int32 Last = GetHeader(Data).NumNames;
+	while (First < Last)
+	{
+		const int32 Middle = First + (Last - First) / 2;
+		const int32 Compare = CompareNames(Chars + Offsets[Middle], Offsets[Middle + 1] - Offsets[Middle], Utf8Name.Get(), Utf8Name.Length());
+		if (Compare == 0)
+		{
+			return Middle;
+		}
+		if (Compare < 0)
+		{
+			First = Middle + 1;
+		}
+		else
+		{
+			Last = Middle;
+		}
+	}
+	return INDEX_NONE;
+}
+
+FName FAssetRegistryMappedState::GetName(uint32 NameIndex) const
+{
+	const TArrayView<const uint32> Offsets = GetSection<uint32>(Data, ESection::NameOffsets, GetHeader(Data).NumNames + 1);
+	const ANSICHAR* Name = reinterpret_cast<const ANSICHAR*>(Data + GetHeader(Data).SectionOffsets[ESection::NameChars] + Offsets[NameIndex]);
+	const int32 Len = Offsets[NameIndex + 1] - Offsets[NameIndex];
+
+	// Most names are ASCII and need no conversion
+	for (int32 Index = 0; Index < Len; ++Index)
+	{
+		if (uint8(Name[Index]) >= 0x80)
+		{
+			FUTF8ToTCHAR WideName(Name, Len);
+			return FName(WideName.Length(), WideName.Get());
+		}
+	}
+	return FName(Len, Name);
+}
+
+int32 FAssetRegistryMappedState::FindAsset(FName ObjectPath) const
+{
+	const int32 NameIndex = FindName(ObjectPath);
+	if (NameIndex == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	const TArrayView<const FAsset> AssetsView = GetAssets(Data);
+	const int32 AssetIndex = Algo::LowerBoundBy(AssetsView, uint32(NameIndex), &FAsset::ObjectPath);
+	return AssetIndex < AssetsView.Num() && AssetsView[AssetIndex].ObjectPath == uint32(NameIndex) ? AssetIndex : INDEX_NONE;
+}
+
+void FAssetRegistryMappedState::GetAssetsSortedBy(int32 Section, FName Value, TArray<int32>& OutAssets) const
+{
+	const int32 NameIndex = FindName(Value);
+	if (NameIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const TArrayView<const FAsset> AssetsView = GetAssets(Data);
+	const TArrayView<const FTag> TagsView = GetTags(Data);
+	const TArrayView<const uint32> Sorted = GetSection<uint32>(Data, ESection::Type(Section), Section == ESection::TagsByKey ? TagsView.Num() : AssetsView.Num());
+	auto GetKey = [Section, &AssetsView, &TagsView](uint32 Index) -> uint32
+	{
+		switch (Section)
+		{
+		case ESection::AssetsByPackage:	return AssetsView[Index].PackageName;
+		case ESection::AssetsByPath:		return AssetsView[Index].PackagePath;
+		case ESection::AssetsByClass:		return AssetsView[Index].AssetClass;
+		default:				return TagsView[Index].Key;
+		}
+	};
+
+	const int32 First = Algo::LowerBoundBy(Sorted, uint32(NameIndex), GetKey);
+	const int32 Last = Algo::UpperBoundBy(Sorted, uint32(NameIndex), GetKey);
+	OutAssets.Reserve(OutAssets.Num() + Last - First);
+	for (int32 Index = First; Index < Last; ++Index)
+	{
+		OutAssets.Add(Section == ESection::TagsByKey ? TagsView[Sorted[Index]].Asset : Sorted[Index]);
+	}
+}
+
+void FAssetRegistryMappedState::GetAssetsByPackageName(FName PackageName, TArray<int32>& OutAssets) const
+{
+	GetAssetsSortedBy(ESection::AssetsByPackage, PackageName, OutAssets);
+}
+
+void FAssetRegistryMappedState::GetAssetsByPath(FName PackagePath, TArray<int32>& OutAssets) const
+{
+	GetAssetsSortedBy(ESection::AssetsByPath, PackagePath, OutAssets);
+}
+
+void FAssetRegistryMappedState::GetAssetsByClass(FName ClassName, TArray<int32>& OutAssets) const
+{
+	GetAssetsSortedBy(ESection::AssetsByClass, ClassName, OutAssets);
+}
+
+void FAssetRegistryMappedState::GetAssetsByTagName(FName TagName, TArray<int32>& OutAssets) const
+{
+	GetAssetsSortedBy(ESection::TagsByKey, TagName, OutAssets);
+}
+
+FName FAssetRegistryMappedState::GetObjectPath(int32 AssetIndex) const
+{
+	return GetName(GetAssets(Data)[AssetIndex].ObjectPath);
+}
+
+FName FAssetRegistryMappedState::GetPackageName(int32 AssetIndex) const
+{
+	return GetName(GetAssets(Data)[AssetIndex].PackageName);
+}
+
+FName FAssetRegistryMappedState::GetAssetClass(int32 AssetIndex) const
+{
+	return GetName(GetAssets(Data)[AssetIndex].AssetClass);
+}
+
+bool FAssetRegistryMappedState::GetTagValue(int32 AssetIndex, FName TagName, FString& OutValue) const
+{
+	const int32 NameIndex = FindName(TagName);
+	if (NameIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FAsset& Asset = GetAssets(Data)[AssetIndex];
+	const TArrayView<const FTag> AssetTags = GetTags(Data).Slice(Asset.FirstTag, Asset.NumTags);
+	const int32 TagIndex = Algo::LowerBoundBy(AssetTags, uint32(NameIndex), &FTag::Key);
+	if (TagIndex == AssetTags.Num() || AssetTags[TagIndex].Key != uint32(NameIndex))
+	{
+		return false;
+	}
+
+	const FTag& Tag = AssetTags[TagIndex];
+	OutValue = ToString(Data + GetHeader(Data).SectionOffsets[ESection::TagValues] + Tag.ValueOffset, Tag.ValueLength);
+	return true;
+}
+
+const FAssetData& FAssetRegistryMappedState::GetAssetData(int32 AssetIndex) const
+{
+	check(AssetIndex >= 0 && AssetIndex < GetNumAssets());
+
+	{
+		FReadScopeLock Lock(AssetDatasLock);
+		if (const TUniquePtr<FAssetData>* Existing = AssetDatas.Find(AssetIndex))
+		{
+			return **Existing;
+		}
+	}
+
+	LLM_SCOPE(ELLMTag::AssetRegistry);
+
+	const FAsset& Asset = GetAssets(Data)[AssetIndex];
+	const uint8* TagValuesData = Data + GetHeader(Data).SectionOffsets[ESection::TagValues];
+	FAssetDataTagMap TagsAndValues;
+	for (const FTag& Tag : GetTags(Data).Slice(Asset.FirstTag, Asset.NumTags))
+	{
+		TagsAndValues.Add(GetName(Tag.Key), ToString(TagValuesData + Tag.ValueOffset, Tag.ValueLength));
+	}
+
+	const TArrayView<const int32> AssetChunkIds = MakeArrayView(reinterpret_cast<const int32*>(Data + GetHeader(Data).SectionOffsets[ESection::ChunkIds]) + Asset.FirstChunkId, Asset.NumChunkIds);
+	TUniquePtr<FAssetData> AssetData = MakeUnique<FAssetData>(GetName(Asset.PackageName), GetName(Asset.PackagePath), GetName(Asset.AssetName), GetName(Asset.AssetClass),
+		MoveTemp(TagsAndValues), AssetChunkIds, Asset.PackageFlags);
+	AssetData->ObjectPath = GetName(Asset.ObjectPath);
+
+	// Another thread may have created it meanwhile, the first one is kept so that references to it stay valid
+	FWriteScopeLock Lock(AssetDatasLock);
+	TUniquePtr<FAssetData>& Existing = AssetDatas.FindOrAdd(AssetIndex);
+	if (!Existing)
+	{
+		Existing = MoveTemp(AssetData);
+	}
+	return *Existing;
+}
+
+bool FAssetRegistryMappedState::GetEdges(FName PackageName, bool bReferencers, TArray<FAssetDependency>& OutEdges, const UE::AssetRegistry::FDependencyQuery& Flags) const
+{
+	using namespace UE::AssetRegistry;
+
+	const int32 NameIndex = FindName(PackageName);
+	if (NameIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FHeader& Header = GetHeader(Data);
+	const TArrayView<const uint32> PackagesView = GetSection<uint32>(Data, ESection::Packages, Header.NumPackages);
+	const int32 PackageIndex = Algo::BinarySearch(PackagesView, uint32(NameIndex));
+	if (PackageIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const TArrayView<const uint32> Offsets = GetSection<uint32>(Data, bReferencers ? ESection::ReferencerOffsets : ESection::DependencyOffsets, Header.NumPackages + 1);
+	const TArrayView<const FEdge> Edges = GetSection<FEdge>(Data, bReferencers ? ESection::Referencers : ESection::Dependencies, Header.NumEdges);
+	const EDependencyProperty Required = Flags.Required & EDependencyProperty::PackageMask;
+	const EDependencyProperty Excluded = Flags.Excluded & EDependencyProperty::PackageMask;
+	for (const FEdge& Edge : Edges.Slice(Offsets[PackageIndex], Offsets[PackageIndex + 1] - Offsets[PackageIndex]))
+	{
+		const EDependencyProperty Properties = EDependencyProperty(Edge.Properties);
+		if ((Properties & Required) == Required && !(Properties & Excluded))
+		{
+			OutEdges.Add(FAssetDependency{ FAssetIdentifier(GetName(PackagesView[Edge.Package])), EDependencyCategory::Package, Properties });
+		}
+	}
+	return true;
+}
+
+bool FAssetRegistryMappedState::GetDependencies(FName PackageName, TArray<FAssetDependency>& OutDependencies, const UE::AssetRegistry::FDependencyQuery& Flags) const
+{
+	return GetEdges(PackageName, false, OutDependencies, Flags);
+}
+
+bool FAssetRegistryMappedState::GetReferencers(FName PackageName, TArray<FAssetDependency>& OutReferencers, const UE::AssetRegistry::FDependencyQuery& Flags) const
+{
+	return GetEdges(PackageName, true, OutReferencers, Flags);
+}
+
+bool FAssetRegistryMappedState::GetAssetPackageData(FName PackageName, FAssetPackageData& OutPackageData) const
+{
+	const int32 NameIndex = FindName(PackageName);
+	if (NameIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const TArrayView<const FPackageData> PackageDataView = GetSection<FPackageData>(Data, ESection::PackageData, GetHeader(Data).NumPackageData);
+	const int32 Index = Algo::LowerBoundBy(PackageDataView, uint32(NameIndex), &FPackageData::Name);
+	if (Index == PackageDataView.Num() || PackageDataView[Index].Name != uint32(NameIndex))
+	{
+		return false;
+	}
+
+	const FPackageData& Package = PackageDataView[Index];
+	OutPackageData = FAssetPackageData();
+	OutPackageData.DiskSize = Package.DiskSize;
+	if (Package.bHasCookedHash)
+	{
+		LexFromString(OutPackageData.CookedHash, *BytesToHex(Package.CookedHash, sizeof(Package.CookedHash)));
+	}
+	return true;
+}
+
+SIZE_T FAssetRegistryMappedState::GetAllocatedSize() const
+{
+	FReadScopeLock Lock(AssetDatasLock);
+	SIZE_T Size = LoadedData.GetAllocatedSize() + AssetDatas.GetAllocatedSize();
+	for (const TPair<int32, TUniquePtr<FAssetData>>& Pair : AssetDatas)
+	{
+		Size += sizeof(FAssetData) + Pair.Value->ChunkIDs.GetAllocatedSize();
+		Pair.Value->TagsAndValues.ForEach([&Size](TPair<FName, FAssetTagValueRef> Tag)
+		{
+			Size += sizeof(TPair<FName, FString>) + (Tag.Value.AsString().Len() + 1) * sizeof(TCHAR);
+		});
+	}
+	return Size;
+}
@@ -0,0 +1,367 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AssetRegistry/AssetRegistryMappedState.h"
+#include "AssetRegistry/AssetRegistryState.h"
+#include "DependsNode.h"
+#include "HAL/FileManager.h"
+#include "HAL/ThreadHeartBeat.h"
+#include "Math/RandomStream.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/ArrayWriter.h"
+#include "Serialization/LargeMemoryReader.h"
+
+namespace AssetRegistryMappedStateTest
+{
+	static const FName ClassNames[] = { FName(TEXT("StaticMesh")), FName(TEXT("Texture2D")), FName(TEXT("Blueprint")) };
+
+	static FName GetPackageName(int32 PackageIndex)
+	{
+		return FName(*FString::Printf(TEXT("/Game/Mapped/Dir%d/Package%d"), PackageIndex % 16, PackageIndex));
+	}
+
+	/** Two assets per package, tags with shared and unique values, and package dependencies with different properties */
+	static void MakeState(int32 NumAssets, FAssetRegistryState& OutState)
+	{
+		using namespace UE::AssetRegistry;
+
+		TMap<FName, FAssetData*> Assets;
+		for (int32 Index = 0; Index < NumAssets; ++Index)
+		{
+			const FName PackageName = GetPackageName(Index / 2);
+			FAssetDataTagMap Tags;
+			Tags.Add(TEXT("Index"), FString::FromInt(Index));
+			Tags.Add(TEXT("Kind"), Index % 2 ? TEXT("Odd") : TEXT("Even"));
+			if (Index % 3 == 0)
+			{
+				Tags.Add(TEXT("Description"), FString::Printf(TEXT("Asset \u00e9\u4e2d %d"), Index));
+			}
+			const int32 ChunkIds[] = { Index % 4, 10 + Index % 3 };
+			FAssetData* AssetData = new FAssetData(PackageName, FName(*FPaths::GetPath(PackageName.ToString())), FName(*FString::Printf(TEXT("Asset%d"), Index)),
+				ClassNames[Index % UE_ARRAY_COUNT(ClassNames)], MoveTemp(Tags), MakeArrayView(ChunkIds, 1 + Index % 2), Index % 5);
+			Assets.Add(AssetData->ObjectPath, AssetData);
+		}
+
+		const int32 NumPackages = (NumAssets + 1) / 2;
+		TMap<FAssetIdentifier, FDependsNode*> Nodes;
+		for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+		{
+			const FAssetIdentifier Identifier(GetPackageName(PackageIndex));
+			Nodes.Add(Identifier, new FDependsNode(Identifier));
+		}
+		for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+		{
+			FDependsNode* Node = Nodes[FAssetIdentifier(GetPackageName(PackageIndex))];
+			const TPair<int32, EDependencyProperty> Dependencies[] =
+			{
+				{ PackageIndex + 1, EDependencyProperty::Hard | EDependencyProperty::Game },
+				{ PackageIndex + 7, EDependencyProperty::Game },
+				{ PackageIndex / 3, EDependencyProperty::Build },
+			};
+			for (const TPair<int32, EDependencyProperty>& Dependency : Dependencies)
+			{
+				if (Dependency.Key < NumPackages && Dependency.Key != PackageIndex)
+				{
+					FDependsNode* DependencyNode = Nodes[FAssetIdentifier(GetPackageName(Dependency.Key))];
+					Node->AddDependency(DependencyNode, EDependencyCategory::Package, Dependency.Value);
+					DependencyNode->AddReferencer(Node);
+				}
+			}
+		}
+
+		TMap<FName, FAssetPackageData*> PackageDatas;
+		for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+		{
+			FAssetPackageData* PackageData = new FAssetPackageData();
+			PackageData->DiskSize = PackageIndex * 1000;
+			if (PackageIndex % 2)
+			{
+				FMD5 MD5;
+				MD5.Update(reinterpret_cast<const uint8*>(&PackageIndex), sizeof(PackageIndex));
+				PackageData->CookedHash.Set(MD5);
+			}
+			PackageDatas.Add(GetPackageName(PackageIndex), PackageData);
+		}
+
+		FAssetRegistrySerializationOptions Options;
+		Options.ModifyForDevelopment();
+		OutState.InitializeFromExisting(Assets, Nodes, PackageDatas, Options);
+
+		for (const TPair<FName, FAssetData*>& Pair : Assets)
+		{
+			delete Pair.Value;
+		}
+		for (const TPair<FAssetIdentifier, FDependsNode*>& Pair : Nodes)
+		{
+			delete Pair.Value;
+		}
+		for (const TPair<FName, FAssetPackageData*>& Pair : PackageDatas)
+		{
+			delete Pair.Value;
+		}
+	}
+
+	/** Dependencies in a comparable order */
+	static TArray<FString> ToStrings(const TArray<FAssetDependency>& Dependencies)
+	{
+		TArray<FString> Strings;
+		for (const FAssetDependency& Dependency : Dependencies)
+		{
+			Strings.Add(FString::Printf(TEXT("%s %d"), *Dependency.AssetId.ToString(), int32(Dependency.Properties)));
+		}
+		Strings.Sort();
+		return Strings;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetRegistryMappedStateTest, "System.AssetRegistry.MappedState", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter);
+
+bool FAssetRegistryMappedStateTest::RunTest(const FString& Parameters)
+{
+	using namespace AssetRegistryMappedStateTest;
+	using namespace UE::AssetRegistry;
+
+	const int32 NumAssets = 301;
+	FAssetRegistryState State;
+	MakeState(NumAssets, State);
+
+	FAssetRegistrySerializationOptions Options;
+	Options.ModifyForDevelopment();
+	FArrayWriter Writer;
+	if (!TestTrue(TEXT("Save"), FAssetRegistryMappedState::Save(State, Writer, Options)))
+	{
+		return false;
+	}
+
+	FAssetRegistryMappedState Mapped;
+	if (!TestTrue(TEXT("Open"), Mapped.Open(TArray64<uint8>(Writer.GetData(), Writer.Num()))))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Num assets"), Mapped.GetNumAssets(), State.GetNumAssets());
+
+	// Every asset and its tags, through FAssetData and without it
+	int32 NumWrongAssets = 0;
+	for (int32 AssetIndex = 0; AssetIndex < Mapped.GetNumAssets(); ++AssetIndex)
+	{
+		const FAssetData& AssetData = Mapped.GetAssetData(AssetIndex);
+		const FAssetData* Expected = State.GetAssetByObjectPath(Mapped.GetObjectPath(AssetIndex));
+		bool bWrong = !Expected || Mapped.FindAsset(AssetData.ObjectPath) != AssetIndex || &Mapped.GetAssetData(AssetIndex) != &AssetData ||
+			Expected->ObjectPath != AssetData.ObjectPath || Expected->PackageName != AssetData.PackageName || Expected->PackagePath != AssetData.PackagePath ||
+			Expected->AssetName != AssetData.AssetName || Expected->AssetClass != AssetData.AssetClass || Expected->PackageFlags != AssetData.PackageFlags ||
+			Expected->ChunkIDs != AssetData.ChunkIDs || Expected->TagsAndValues.Num() != AssetData.TagsAndValues.Num() ||
+			Mapped.GetPackageName(AssetIndex) != Expected->PackageName || Mapped.GetAssetClass(AssetIndex) != Expected->AssetClass;
+		if (Expected)
+		{
+			Expected->TagsAndValues.ForEach([&bWrong, &AssetData, &Mapped, AssetIndex](TPair<FName, FAssetTagValueRef> Tag)
+			{
+				FString Value;
+				bWrong |= !Mapped.GetTagValue(AssetIndex, Tag.Key, Value) || Value != Tag.Value.AsString() || AssetData.GetTagValueRef<FString>(Tag.Key) != Value;
+			});
+		}
+		NumWrongAssets += bWrong;
+	}
+	TestEqual(TEXT("Wrong assets"), NumWrongAssets, 0);
+
+	FString Value;
+	TestFalse(TEXT("Missing tag"), Mapped.GetTagValue(0, TEXT("Missing"), Value));
+	TestEqual(TEXT("Missing asset"), Mapped.FindAsset(TEXT("/Game/Mapped/Dir0/Package0.Missing")), int32(INDEX_NONE));
+	TestTrue(TEXT("Case insensitive"), Mapped.FindAsset(TEXT("/game/mapped/dir0/package0.asset0")) != INDEX_NONE);
+
+	// Lookups by field
+	TArray<int32> Found;
+	for (const FName ClassName : ClassNames)
+	{
+		Found.Reset();
+		Mapped.GetAssetsByClass(ClassName, Found);
+		TestEqual(*FString::Printf(TEXT("Class %s"), *ClassName.ToString()), Found.Num(), State.GetAssetsByClassName(ClassName).Num());
+	}
+	for (const TCHAR* TagName : { TEXT("Index"), TEXT("Kind"), TEXT("Description"), TEXT("Missing") })
+	{
+		Found.Reset();
+		Mapped.GetAssetsByTagName(TagName, Found);
+		TestEqual(*FString::Printf(TEXT("Tag %s"), TagName), Found.Num(), State.GetAssetsByTagName(TagName).Num());
+	}
+	for (int32 PackageIndex : { 0, 7, NumAssets / 2 })
+	{
+		Found.Reset();
+		Mapped.GetAssetsByPackageName(GetPackageName(PackageIndex), Found);
+		bool bSamePackage = true;
+		for (int32 AssetIndex : Found)
+		{
+			bSamePackage &= Mapped.GetPackageName(AssetIndex) == GetPackageName(PackageIndex);
+		}
+		TestTrue(TEXT("Package"), bSamePackage && Found.Num() == State.GetAssetsByPackageName(GetPackageName(PackageIndex)).Num());
+	}
+	Found.Reset();
+	Mapped.GetAssetsByPath(TEXT("/Game/Mapped/Dir3"), Found);
+	int32 NumInPath = 0;
+	for (int32 AssetIndex = 0; AssetIndex < NumAssets; ++AssetIndex)
+	{
+		NumInPath += (AssetIndex / 2) % 16 == 3;
+	}
+	TestEqual(TEXT("Path"), Found.Num(), NumInPath);
+
+	// Dependencies, referencers and package data of every package
+	const FDependencyQuery Queries[] = { FDependencyQuery(), FDependencyQuery(EDependencyQuery::Hard), FDependencyQuery(EDependencyQuery::NotHard | EDependencyQuery::Game) };
+	int32 NumWrongPackages = 0;
+	for (int32 PackageIndex = 0; PackageIndex < (NumAssets + 1) / 2; ++PackageIndex)
+	{
+		const FName PackageName = GetPackageName(PackageIndex);
+		bool bWrong = false;
+		for (const FDependencyQuery& Query : Queries)
+		{
+			TArray<FAssetDependency> Expected, Actual;
+			State.GetDependencies(FAssetIdentifier(PackageName), Expected, EDependencyCategory::Package, Query);
+			bWrong |= !Mapped.GetDependencies(PackageName, Actual, Query) || ToStrings(Expected) != ToStrings(Actual);
+
+			Expected.Reset();
+			Actual.Reset();
+			State.GetReferencers(FAssetIdentifier(PackageName), Expected, EDependencyCategory::Package, Query);
+			bWrong |= !Mapped.GetReferencers(PackageName, Actual, Query) || ToStrings(Expected) != ToStrings(Actual);
+		}
+
+		const FAssetPackageData* Expected = State.GetAssetPackageData(PackageName);
+		FAssetPackageData Actual;
+		bWrong |= !Expected || !Mapped.GetAssetPackageData(PackageName, Actual) || Actual.DiskSize != Expected->DiskSize || Actual.CookedHash != Expected->CookedHash;
+		NumWrongPackages += bWrong;
+	}
+	TestEqual(TEXT("Wrong packages"), NumWrongPackages, 0);
+
+	TArray<FAssetDependency> Dependencies;
+	TestFalse(TEXT("Missing package"), Mapped.GetDependencies(TEXT("/Game/Missing"), Dependencies));
+
+	// Corrupt data is rejected instead of read
+	TArray64<uint8> Truncated(Writer.GetData(), Writer.Num() / 2);
+	AddExpectedError(TEXT("mapped asset registry"), EAutomationExpectedErrorFlags::Contains, 2);
+	TestFalse(TEXT("Truncated"), Mapped.Open(MoveTemp(Truncated)));
+	TestFalse(TEXT("Not a registry"), Mapped.Open(TArray64<uint8>(Writer.GetData() + 8, Writer.Num() - 8)));
+	TestFalse(TEXT("Closed"), Mapped.IsOpen());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetRegistryMappedStateBenchmark, "System.AssetRegistry.MappedState.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter);
+
+/**
+ * Loads a registry saved in the regular format and opens the same registry in the mapped format, then does random lookups of assets
+ * and tags in both. -MappedAssetRegistryBenchmarkAssets= overrides the default of 200K assets.
+ */
+bool FAssetRegistryMappedStateBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace AssetRegistryMappedStateTest;
+
+	FSlowHeartBeatScope SuspendHeartBeat;
+
+	int32 NumAssets = 200000;
+	FParse::Value(FCommandLine::Get(), TEXT("MappedAssetRegistryBenchmarkAssets="), NumAssets);
+	const int32 NumLookups = 1000000;
+
+	const FString Directory = FPaths::AutomationTransientDir() / TEXT("MappedAssetRegistry") / FGuid::NewGuid().ToString();
+	const FString RegularPath = Directory / TEXT("AssetRegistry.bin");
+	const FString MappedPath = Directory / TEXT("AssetRegistryMapped.bin");
+
+	TArray<FName> ObjectPaths;
+	{
+		FAssetRegistryState SourceState;
+		MakeState(NumAssets, SourceState);
+		for (int32 Index = 0; Index < NumAssets; ++Index)
+		{
+			ObjectPaths.Add(FName(*FString::Printf(TEXT("%s.Asset%d"), *GetPackageName(Index / 2).ToString(), Index)));
+		}
+
+		FAssetRegistrySerializationOptions Options;
+		Options.ModifyForDevelopment();
+		FArrayWriter RegularWriter;
+		SourceState.Save(RegularWriter, Options);
+		FArrayWriter MappedWriter;
+		FAssetRegistryMappedState::Save(SourceState, MappedWriter, Options);
+		if (!TestTrue(TEXT("Write"), FFileHelper::SaveArrayToFile(RegularWriter, *RegularPath) && FFileHelper::SaveArrayToFile(MappedWriter, *MappedPath)))
+		{
+			return false;
+		}
+	}
+
+	FRandomStream Random(1234);
+	TArray<int32> Order;
+	for (int32 Index = 0; Index < NumLookups; ++Index)
+	{
+		Order.Add(Random.RandHelper(NumAssets));
+	}
+	const FName IndexTag(TEXT("Index"));
+
+	// Loaded like UAssetRegistryImpl loads the cooked registry
+	{
+		const uint64 UsedBefore = FPlatformMemory::GetStats().UsedPhysical;
+		double StartTime = FPlatformTime::Seconds();
+		FAssetRegistryState State;
+		{
+			TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*RegularPath));
+			TArray64<uint8> Data;
+			Data.SetNumUninitialized(FileReader->TotalSize());
+			FileReader->Serialize(Data.GetData(), Data.Num());
+			FLargeMemoryReader MemoryReader(Data.GetData(), Data.Num());
+			TestTrue(TEXT("Load"), State.Load(MemoryReader));
+		}
+		const double LoadSeconds = FPlatformTime::Seconds() - StartTime;
+		const int64 UsedDelta = int64(FPlatformMemory::GetStats().UsedPhysical) - int64(UsedBefore);
+
+		int32 NumFound = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 AssetIndex : Order)
+		{
+			const FAssetData* AssetData = State.GetAssetByObjectPath(ObjectPaths[AssetIndex]);
+			FString Value;
+			NumFound += AssetData && AssetData->GetTagValue(IndexTag, Value);
+		}
+		const double LookupSeconds = FPlatformTime::Seconds() - StartTime;
+		TestEqual(TEXT("Regular lookups"), NumFound, NumLookups);
+
+		AddInfo(FString::Printf(TEXT("Regular, %d assets in %.1fMB: load %.3fs, %.1fMB allocated (%.1fMB physical), %.0f asset and tag lookups/s"),
+			NumAssets, IFileManager::Get().FileSize(*RegularPath) / (1024.0 * 1024.0), LoadSeconds, State.GetAllocatedSize() / (1024.0 * 1024.0),
+			UsedDelta / (1024.0 * 1024.0), NumLookups / LookupSeconds));
+	}
+
+	{
+		const uint64 UsedBefore = FPlatformMemory::GetStats().UsedPhysical;
+		double StartTime = FPlatformTime::Seconds();
+		FAssetRegistryMappedState Mapped;
+		TestTrue(TEXT("Open"), Mapped.Open(*MappedPath));
+		const double OpenSeconds = FPlatformTime::Seconds() - StartTime;
+		const int64 UsedDelta = int64(FPlatformMemory::GetStats().UsedPhysical) - int64(UsedBefore);
+		const SIZE_T OpenAllocatedSize = Mapped.GetAllocatedSize();
+
+		int32 NumFound = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 AssetIndex : Order)
+		{
+			const int32 Found = Mapped.FindAsset(ObjectPaths[AssetIndex]);
+			FString Value;
+			NumFound += Found != INDEX_NONE && Mapped.GetTagValue(Found, IndexTag, Value);
+		}
+		const double LookupSeconds = FPlatformTime::Seconds() - StartTime;
+		TestEqual(TEXT("Mapped lookups"), NumFound, NumLookups);
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 AssetIndex : Order)
+		{
+			NumFound += Mapped.GetAssetData(Mapped.FindAsset(ObjectPaths[AssetIndex])).ChunkIDs.Num();
+		}
+		const double AssetDataSeconds = FPlatformTime::Seconds() - StartTime;
+
+		AddInfo(FString::Printf(TEXT("Mapped, %d assets in %.1fMB: open %.3fs, %.1fMB allocated (%.1fMB physical), %.0f asset and tag lookups/s, %.0f FAssetData lookups/s, %.1fMB allocated after"),
+			NumAssets, Mapped.GetFileSize() / (1024.0 * 1024.0), OpenSeconds, OpenAllocatedSize / (1024.0 * 1024.0), UsedDelta / (1024.0 * 1024.0), NumLookups / LookupSeconds,
+			NumLookups / AssetDataSeconds, Mapped.GetAllocatedSize() / (1024.0 * 1024.0)));
+	}
+
+	IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
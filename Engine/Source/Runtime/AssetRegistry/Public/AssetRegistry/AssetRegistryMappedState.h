@@ -0,0 +1,103 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/ScopeRWLock.h"
+
+class FAssetRegistryState;
+class IMappedFileHandle;
+class IMappedFileRegion;
+struct FAssetRegistrySerializationOptions;
+
+/**
+ * A cooked asset registry stored so that it can be queried where it lies in memory, usually a memory mapped file, instead of
+ * being deserialized into an FAssetRegistryState. Opening it only validates the header, FAssetData is created on demand.
+ *
+ * Every name is stored once in a sorted table and referred to by its index. Assets are sorted by object path, with index arrays
+ * sorted by package, path, class and tag key for the other lookups. Tag values are offsets into a string blob, package
+ * dependencies and referencers are stored as compressed sparse rows.
+ *
+ * Names are compared case insensitively for ASCII characters only. Only package dependencies are stored, not searchable name or
+ * manage dependencies. Files are written in native byte order.
+ *
+ * All const methods can be called from any thread.
+ */
+class ASSETREGISTRY_API FAssetRegistryMappedState
+{
+public:
+	FAssetRegistryMappedState();
+	~FAssetRegistryMappedState();
+
+	FAssetRegistryMappedState(const FAssetRegistryMappedState&) = delete;
+	FAssetRegistryMappedState& operator=(const FAssetRegistryMappedState&) = delete;
+
+	/** Writes State in this format. Dependencies and package data are written if enabled in Options, tags are written as they are in State */
+	static bool Save(const FAssetRegistryState& State, FArchive& Ar, const FAssetRegistrySerializationOptions& Options);
+
+	/** Maps the file, or loads it on platforms that cannot map files. Returns false if it is missing or invalid */
+	bool Open(const TCHAR* Filename);
+
+	/** Uses a file already loaded into memory */
+	bool Open(TArray64<uint8>&& InData);
+
+	/** Releases the file and every FAssetData created from it */
+	void Close();
+
+	bool IsOpen() const { return Data != nullptr; }
+
+	int32 GetNumAssets() const;
+
+	/** Index of the asset with the given object path, or INDEX_NONE */
+	int32 FindAsset(FName ObjectPath) const;
+
+	/** Indices of the assets in a package, in a path (not recursive), of a class or with a tag */
+	void GetAssetsByPackageName(FName PackageName, TArray<int32>& OutAssets) const;
+	void GetAssetsByPath(FName PackagePath, TArray<int32>& OutAssets) const;
+	void GetAssetsByClass(FName ClassName, TArray<int32>& OutAssets) const;
+	void GetAssetsByTagName(FName TagName, TArray<int32>& OutAssets) const;
+
+	/** Fields of an asset, read without creating its FAssetData */
+	FName GetObjectPath(int32 AssetIndex) const;
+	FName GetPackageName(int32 AssetIndex) const;
+	FName GetAssetClass(int32 AssetIndex) const;
+	bool GetTagValue(int32 AssetIndex, FName TagName, FString& OutValue) const;
+
+	/** The FAssetData of an asset, created on first use and kept until the state is closed */
+	const FAssetData& GetAssetData(int32 AssetIndex) const;
+
+	/** Package dependencies of a package that match Flags, returns false if the package has no dependency data */
+	bool GetDependencies(FName PackageName, TArray<FAssetDependency>& OutDependencies, const UE::AssetRegistry::FDependencyQuery& Flags = UE::AssetRegistry::FDependencyQuery()) const;
+
+	/** Packages that depend on a package with dependencies that match Flags, returns false if the package has no dependency data */
+	bool GetReferencers(FName PackageName, TArray<FAssetDependency>& OutReferencers, const UE::AssetRegistry::FDependencyQuery& Flags = UE::AssetRegistry::FDependencyQuery()) const;
+
+	/** Returns false if the package has no package data */
+	bool GetAssetPackageData(FName PackageName, FAssetPackageData& OutPackageData) const;
+
+	/** Size of the mapped or loaded file */
+	int64 GetFileSize() const { return DataSize; }
+
+	/** Heap memory used, mostly by the FAssetData created so far */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	bool SetData(const uint8* InData, int64 InDataSize);
+	int32 FindName(FName Name) const;
+	FName GetName(uint32 NameIndex) const;
+	void GetAssetsSortedBy(int32 Section, FName Value, TArray<int32>& OutAssets) const;
+	bool GetEdges(FName PackageName, bool bReferencers, TArray<FAssetDependency>& OutEdges, const UE::AssetRegistry::FDependencyQuery& Flags) const;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray64<uint8> LoadedData;
+
+	const uint8* Data = nullptr;
+	int64 DataSize = 0;
+
+	/** FAssetData created by GetAssetData, by asset index */
+	mutable TMap<int32, TUniquePtr<FAssetData>> AssetDatas;
+	mutable FRWLock AssetDatasLock;
+};
@@ -32,6 +32,9 @@ struct FAssetRegistrySerializationOptions
 	/** If true will read/write FAssetPackageData */
 	bool bSerializePackageData = false;
 
+	/** If true the cooker also writes the registry in the FAssetRegistryMappedState format, next to the regular one */
+	bool bSerializeMapped = false;
+
 	/** True if CookFilterlistTagsByClass is a whitelist. False if it is a blacklist. */
 	bool bUseAssetRegistryTagsWhitelistInsteadOfBlacklist = false;
 
@@ -416,4 +419,5 @@ private:
 	int32 NumPackageData = 0;
 
 	friend class UAssetRegistryImpl;
+	friend class FAssetRegistryMappedState;
 };
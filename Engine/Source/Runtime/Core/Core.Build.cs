@@ -148,6 +148,16 @@ public class Core : ModuleRules
 			PublicSystemLibraries.Add("dl");
         }
 
+		// zstd is hardcoded in FCompression like zlib and lz4, so cooked containers can use it without a plugin
+		bool bWithZstd = Target.Platform.IsInGroup(UnrealPlatformGroup.Windows)
+			|| Target.Platform == UnrealTargetPlatform.Mac
+			|| Target.IsInPlatformGroup(UnrealPlatformGroup.Unix);
+		if (bWithZstd)
+		{
+			AddEngineThirdPartyPrivateStaticDependencies(Target, "zstd");
+		}
+		PrivateDefinitions.Add("WITH_ZSTD=" + (bWithZstd ? "1" : "0"));
+
 		if ( Target.bCompileICU == true )
         {
 			AddEngineThirdPartyPrivateStaticDependencies(Target, "ICU");
@@ -17,6 +17,7 @@
 #include "Misc/NoopCounter.h"
 #include "Misc/ScopeLock.h"
 #include "Containers/LockFreeList.h"
+#include "Containers/WorkStealingQueue.h"
 #include "Templates/Function.h"
 #include "Stats/Stats.h"
 #include "Misc/CoreStats.h"
@@ -32,6 +33,9 @@
 #include "ProfilingDebugging/MiscTrace.h"
 #include "ProfilingDebugging/ScopedTimers.h"
 #include "Misc/ConfigCacheIni.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include <atomic>
 
 DEFINE_LOG_CATEGORY_STATIC(LogTaskGraph, Log, All);
 
@@ -80,6 +84,14 @@ static FAutoConsoleVariableRef CVarTestDontCompleteUntilForAlreadyComplete(
 	TEXT("If 1, then we before spawning a gather task, we just check if all of the subtasks are complete, and in that case we can skip the gather.")
 );
 
+static int32 GTaskGraphWorkStealing = 0;
+static FAutoConsoleVariableRef CVarTaskGraphWorkStealing(
+	TEXT("TaskGraph.WorkStealing"),
+	GTaskGraphWorkStealing,
+	TEXT("If 1, tasks queued from a worker thread go to a deque owned by that worker and idle workers steal from each other, instead of every worker sharing the incoming queues. ")
+	TEXT("Can be changed at any time, -TaskGraphWorkStealing enables it at startup.")
+);
+
 UE_DEPRECATED(4.26, "No longer supported") CORE_API int32 GEnablePowerSavingThreadPriorityReductionCVar = 0;
 
 CORE_API bool GAllowTaskGraphForkMultithreading = true;
@@ -1228,6 +1240,16 @@ public:
 		NumTaskThreadsPerSet = (NumThreads - NumNamedThreads) / NumTaskThreadSets;
 		check((NumThreads - NumNamedThreads) % NumTaskThreadSets == 0); // should be equal numbers of threads per priority set
 
+		if (FParse::Param(FCommandLine::Get(), TEXT("TaskGraphWorkStealing")))
+		{
+			GTaskGraphWorkStealing = 1;
+		}
+		for (int32 ThreadIndex = 0; ThreadIndex < MAX_THREADS; ThreadIndex++)
+		{
+			LocalQueues[ThreadIndex].store(nullptr, std::memory_order_relaxed);
+		}
+		bHasLocalQueues.store(false, std::memory_order_relaxed);
+
 		UE_LOG(LogTaskGraph, Log, TEXT("Started task graph with %d named threads and %d total threads with %d sets of task threads."), NumNamedThreads, NumThreads, NumTaskThreadSets);
 		check(NumThreads - NumNamedThreads >= 1);  // need at least one pure worker thread
 		check(NumThreads <= MAX_THREADS);
@@ -1347,6 +1369,7 @@ public:
 				WorkerThreads[ThreadIndex].RunnableThread = NULL;
 			}
 			WorkerThreads[ThreadIndex].bAttached = false;
+			delete LocalQueues[ThreadIndex].exchange(nullptr);
 		}
 		TaskGraphImplementationSingleton = NULL;
 		NumTaskThreadsPerSet = 0;
@@ -1384,6 +1407,10 @@ public:
 				}
 				uint32 PriIndex = TaskPriority ? 0 : 1;
 				check(Priority >= 0 && Priority < MAX_THREAD_PRIORITIES);
+				if (GTaskGraphWorkStealing && QueueTaskToLocalWorker(Task, Priority, PriIndex))
+				{
+					return;
+				}
 				{
 					TASKGRAPH_SCOPE_CYCLE_COUNTER(4, STAT_TaskGraph_QueueTask_IncomingAnyThreadTasks_Push);
 					int32 IndexToStart = IncomingAnyThreadTasks[Priority].Push(Task, PriIndex);
@@ -1629,7 +1656,45 @@ public:
 			MyIndex < (PLATFORM_64BITS ? 63 : 32) &&
 			Priority >= 0 && Priority < ENamedThreads::NumThreadPriorities);
 
-		return IncomingAnyThreadTasks[Priority].Pop(MyIndex, true);
+		if (bHasLocalQueues.load(std::memory_order_relaxed))
+		{
+			// own work first while it is still in cache, then work from outside of the pool, then steal
+			if (FWorkStealingQueues* MyQueues = LocalQueues[ThreadInNeed].load(std::memory_order_acquire))
+			{
+				for (FTaskDeque& Queue : MyQueues->Queues)
+				{
+					if (FBaseGraphTask* Task = Queue.Pop())
+					{
+						return Task;
+					}
+				}
+			}
+			if (FBaseGraphTask* Task = IncomingAnyThreadTasks[Priority].Pop(MyIndex, false))
+			{
+				return Task;
+			}
+			if (FBaseGraphTask* Task = StealWork(Priority, MyIndex))
+			{
+				return Task;
+			}
+		}
+
+		FBaseGraphTask* Task = IncomingAnyThreadTasks[Priority].Pop(MyIndex, true);
+		if (!Task && bHasLocalQueues.load(std::memory_order_seq_cst))
+		{
+			// we are marked as stalled now. A worker that pushed to its deque before that could not see us, so look again
+			// and hand the work to a stalled thread, which might be this one.
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (HasLocalWork(Priority))
+			{
+				int32 IndexToStart = IncomingAnyThreadTasks[Priority].ClaimStalledThread();
+				if (IndexToStart >= 0)
+				{
+					StartTaskThread(Priority, IndexToStart);
+				}
+			}
+		}
+		return Task;
 	}
 
 	void StallForTuning(int32 Index, bool Stall)
@@ -1694,6 +1759,86 @@ private:
 		return CurrentThreadIfKnown;
 	}
 
+	/**
+	 *	Work stealing: a task queued from a worker of the right priority set goes to that worker's deque, so the children
+	 *	of a task usually run on the thread that made them and only idle workers touch them.
+	 *	@return false if the task has to go through the incoming queue instead.
+	**/
+	bool QueueTaskToLocalWorker(FBaseGraphTask* Task, int32 Priority, uint32 PriIndex)
+	{
+		FWorkerThread* TLSPointer = (FWorkerThread*)FPlatformTLS::GetTlsValue(PerThreadIDTLSSlot);
+		if (!TLSPointer)
+		{
+			return false;
+		}
+		int32 ThreadIndex = UE_PTRDIFF_TO_INT32(TLSPointer - WorkerThreads);
+		if (ThreadIndex < NumNamedThreads || ThreadIndexToPriorityIndex(ThreadIndex) != Priority)
+		{
+			return false;
+		}
+
+		FWorkStealingQueues* MyQueues = LocalQueues[ThreadIndex].load(std::memory_order_relaxed);
+		if (!MyQueues)
+		{
+			MyQueues = new FWorkStealingQueues;
+			LocalQueues[ThreadIndex].store(MyQueues, std::memory_order_release);
+			bHasLocalQueues.store(true, std::memory_order_seq_cst);
+		}
+		if (!MyQueues->Queues[PriIndex].Push(Task))
+		{
+			return false;
+		}
+
+		// pairs with the fence in FindWork after stalling, either we see the stalled thread or it sees the task
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int32 IndexToStart = IncomingAnyThreadTasks[Priority].ClaimStalledThread();
+		if (IndexToStart >= 0)
+		{
+			StartTaskThread(Priority, IndexToStart);
+		}
+		return true;
+	}
+
+	/** Takes the oldest task of another worker in the same priority set, starting with the next one so thieves spread out. **/
+	FBaseGraphTask* StealWork(int32 Priority, int32 MyIndex)
+	{
+		for (int32 Offset = 1; Offset < NumTaskThreadsPerSet; Offset++)
+		{
+			int32 VictimIndex = (MyIndex + Offset) % NumTaskThreadsPerSet;
+			FWorkStealingQueues* VictimQueues = LocalQueues[VictimIndex + Priority * NumTaskThreadsPerSet + NumNamedThreads].load(std::memory_order_acquire);
+			if (VictimQueues)
+			{
+				for (FTaskDeque& Queue : VictimQueues->Queues)
+				{
+					if (FBaseGraphTask* Task = Queue.Steal())
+					{
+						return Task;
+					}
+				}
+			}
+		}
+		return nullptr;
+	}
+
+	bool HasLocalWork(int32 Priority)
+	{
+		for (int32 Index = 0; Index < NumTaskThreadsPerSet; Index++)
+		{
+			FWorkStealingQueues* Queues = LocalQueues[Index + Priority * NumTaskThreadsPerSet + NumNamedThreads].load(std::memory_order_acquire);
+			if (Queues)
+			{
+				for (const FTaskDeque& Queue : Queues->Queues)
+				{
+					if (!Queue.IsEmpty())
+					{
+						return true;
+					}
+				}
+			}
+		}
+		return false;
+	}
+
 	int32 ThreadIndexToPriorityIndex(int32 ThreadIndex)
 	{
 		check(ThreadIndex >= NumNamedThreads && ThreadIndex < NumThreads);
@@ -1737,6 +1882,17 @@ private:
 	TArray<TFunction<void()> > ShutdownCallbacks;
 
 	FStallingTaskQueue<FBaseGraphTask, PLATFORM_CACHE_LINE_SIZE, 2>	IncomingAnyThreadTasks[MAX_THREAD_PRIORITIES];
+
+	/** Per worker deques for TaskGraph.WorkStealing, one per task priority like the incoming queues. **/
+	typedef TWorkStealingQueue<FBaseGraphTask, 1024> FTaskDeque;
+	struct FWorkStealingQueues
+	{
+		FTaskDeque Queues[2];
+	};
+	/** Indexed by thread index, allocated by the owning worker the first time it queues a task locally. **/
+	std::atomic<FWorkStealingQueues*> LocalQueues[MAX_THREADS];
+	/** Set once any deque exists, until then finding work is exactly the same as without work stealing. **/
+	std::atomic<bool> bHasLocalQueues;
 };
 
 
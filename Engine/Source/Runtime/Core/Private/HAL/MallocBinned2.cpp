@@ -45,7 +45,7 @@ int32 GMallocBinned2MaxBundlesBeforeRecycle = BINNED2_MAX_GMallocBinned2MaxBundl
 static FAutoConsoleVariableRef GMallocBinned2MaxBundlesBeforeRecycleCVar(
 	TEXT("MallocBinned2.BundleRecycleCount"),
 	GMallocBinned2MaxBundlesBeforeRecycle,
-	TEXT("Number of freed bundles in the global recycler before it returns them to the system, per-block size. Limited by BINNED2_MAX_GMallocBinned2MaxBundlesBeforeRecycle (currently 4)")
+	TEXT("Number of freed bundles in the global recycler before it returns them to the system, per-block size. Limited by BINNED2_MAX_GMallocBinned2MaxBundlesBeforeRecycle")
 	);
 
 int32 GMallocBinned2AllocExtra = DEFAULT_GMallocBinned2AllocExtra;
@@ -57,6 +57,31 @@ static FAutoConsoleVariableRef GMallocBinned2AllocExtraCVar(
 
 #endif
 
+#if BINNED2_IDLE_THREAD_CACHE_TRIM
+float GMallocBinned2ThreadCacheIdleTrimTime = DEFAULT_GMallocBinned2ThreadCacheIdleTrimTime;
+static FAutoConsoleVariableRef GMallocBinned2ThreadCacheIdleTrimTimeCVar(
+	TEXT("MallocBinned2.ThreadCacheIdleTrimTime"),
+	GMallocBinned2ThreadCacheIdleTrimTime,
+	TEXT("Interval in seconds at which UpdateStats looks for threads that stopped using their caches and returns their cached blocks to the shared pools. 0 disables.")
+	);
+#endif
+
+#if BINNED2_LARGE_BLOCK_CACHE
+int32 GMallocBinned2LargeBlockCacheCount = DEFAULT_GMallocBinned2LargeBlockCacheCount;
+static FAutoConsoleVariableRef GMallocBinned2LargeBlockCacheCountCVar(
+	TEXT("MallocBinned2.LargeBlockCacheCount"),
+	GMallocBinned2LargeBlockCacheCount,
+	TEXT("Max number of freed OS blocks kept committed for reuse. Limited by BINNED2_MAX_LARGE_BLOCK_CACHE_COUNT, 0 disables the cache.")
+	);
+
+int32 GMallocBinned2LargeBlockCacheSizeMB = DEFAULT_GMallocBinned2LargeBlockCacheSizeMB;
+static FAutoConsoleVariableRef GMallocBinned2LargeBlockCacheSizeMBCVar(
+	TEXT("MallocBinned2.LargeBlockCacheSizeMB"),
+	GMallocBinned2LargeBlockCacheSizeMB,
+	TEXT("Max size in megabytes of the freed OS blocks kept committed for reuse. Blocks larger than a quarter of it are never cached.")
+	);
+#endif
+
 float GMallocBinned2FlushThreadCacheMaxWaitTime = 0.02f;
 static FAutoConsoleVariableRef GMallocBinned2FlushThreadCacheMaxWaitTimeCVar(
 	TEXT("MallocBinned2.FlushThreadCacheMaxWaitTime"),
@@ -484,12 +509,87 @@ struct FMallocBinned2::Private
 				DefaultConstructItems<FBundleNode*>(FreeBundles, BINNED2_MAX_GMallocBinned2MaxBundlesBeforeRecycle);
 			}
 		};
-		static_assert(sizeof(FPaddedBundlePointer) == PLATFORM_CACHE_LINE_SIZE, "FPaddedBundlePointer should be the same size as a cache line");
+		static_assert(sizeof(FPaddedBundlePointer) % PLATFORM_CACHE_LINE_SIZE == 0, "FPaddedBundlePointer should fill whole cache lines");
 		MS_ALIGN(PLATFORM_CACHE_LINE_SIZE) FPaddedBundlePointer Bundles[BINNED2_SMALL_POOL_COUNT] GCC_ALIGN(PLATFORM_CACHE_LINE_SIZE);
 	};
 
 	static FGlobalRecycler GGlobalRecycler;
 
+	/** Allocates OS pages, reusing a cached block of the same size if there is one. Allocator.Mutex must be held, Mutex is passed on to the page allocator. */
+	static void* AllocateOSPages(FMallocBinned2& Allocator, SIZE_T Size, uint32 AllocationHint, FCriticalSection* Mutex)
+	{
+#if BINNED2_LARGE_BLOCK_CACHE
+		// Most recently freed first, it is the most likely to still be in the caches and the TLB
+		for (int32 Index = int32(Allocator.NumCachedLargeBlocks) - 1; Index >= 0; --Index)
+		{
+			FCachedLargeBlock& Block = Allocator.CachedLargeBlocks[Index];
+			if (Block.ByteSize == Size)
+			{
+				void* Result = Block.Ptr;
+				Allocator.CachedLargeBlocksTotal -= Size;
+				--Allocator.NumCachedLargeBlocks;
+				FMemory::Memmove(&Block, &Block + 1, sizeof(FCachedLargeBlock) * (Allocator.NumCachedLargeBlocks - Index));
+				return Result;
+			}
+		}
+#endif
+		return Allocator.CachedOSPageAllocator.Allocate(Size, AllocationHint, Mutex);
+	}
+
+	/** Frees OS pages, keeping them committed in the large block cache if they fit. Allocator.Mutex must be held, Mutex is passed on to the page allocator. */
+	static void FreeOSPages(FMallocBinned2& Allocator, void* Ptr, SIZE_T Size, FCriticalSection* Mutex)
+	{
+#if BINNED2_LARGE_BLOCK_CACHE
+		const uint32 MaxBlocks = (uint32)FMath::Clamp(GMallocBinned2LargeBlockCacheCount, 0, BINNED2_MAX_LARGE_BLOCK_CACHE_COUNT);
+		const SIZE_T MaxBytes = SIZE_T(FMath::Max(GMallocBinned2LargeBlockCacheSizeMB, 0)) * 1024 * 1024;
+		if (MaxBlocks && Size <= MaxBytes / 4)
+		{
+			// Evict the oldest blocks to make room, without letting go of the lock while the cache is being changed
+			uint32 NumEvicted = 0;
+			SIZE_T EvictedTotal = 0;
+			while (NumEvicted < Allocator.NumCachedLargeBlocks && (Allocator.NumCachedLargeBlocks - NumEvicted >= MaxBlocks || Allocator.CachedLargeBlocksTotal - EvictedTotal + Size > MaxBytes))
+			{
+				const FCachedLargeBlock& Block = Allocator.CachedLargeBlocks[NumEvicted++];
+				EvictedTotal += Block.ByteSize;
+				Allocator.CachedOSPageAllocator.Free(Block.Ptr, Block.ByteSize);
+			}
+			if (NumEvicted)
+			{
+				Allocator.NumCachedLargeBlocks -= NumEvicted;
+				Allocator.CachedLargeBlocksTotal -= EvictedTotal;
+				FMemory::Memmove(Allocator.CachedLargeBlocks, Allocator.CachedLargeBlocks + NumEvicted, sizeof(FCachedLargeBlock) * Allocator.NumCachedLargeBlocks);
+			}
+
+			Allocator.CachedLargeBlocks[Allocator.NumCachedLargeBlocks++] = { Ptr, Size };
+			Allocator.CachedLargeBlocksTotal += Size;
+			return;
+		}
+#endif
+		Allocator.CachedOSPageAllocator.Free(Ptr, Size, Mutex);
+	}
+
+	/** Returns all cached blocks to the page allocator. Mutex must be held. */
+	static void FreeCachedOSPages(FMallocBinned2& Allocator)
+	{
+#if BINNED2_LARGE_BLOCK_CACHE
+		for (uint32 Index = 0; Index < Allocator.NumCachedLargeBlocks; ++Index)
+		{
+			Allocator.CachedOSPageAllocator.Free(Allocator.CachedLargeBlocks[Index].Ptr, Allocator.CachedLargeBlocks[Index].ByteSize);
+		}
+		Allocator.NumCachedLargeBlocks = 0;
+		Allocator.CachedLargeBlocksTotal = 0;
+#endif
+	}
+
+	static uint64 GetCachedOSPagesTotal(FMallocBinned2& Allocator)
+	{
+#if BINNED2_LARGE_BLOCK_CACHE
+		return Allocator.CachedLargeBlocksTotal;
+#else
+		return 0;
+#endif
+	}
+
 	static void FreeBundles(FMallocBinned2& Allocator, FBundleNode* BundlesToRecycle, uint32 InBlockSize, uint32 InPoolIndex)
 	{
 		FPoolTable& Table = Allocator.SmallPoolTables[InPoolIndex];
@@ -538,7 +638,7 @@ struct FMallocBinned2::Private
 
 					// Free the OS memory.
 					NodePool->Unlink();
-					Allocator.CachedOSPageAllocator.Free(BasePtrOfNode, Allocator.PageSize);
+					FreeOSPages(Allocator, BasePtrOfNode, Allocator.PageSize, nullptr);
 #if BINNED2_ALLOCATOR_STATS
 					AllocatedOSSmallPoolMemory -= ((int64)Allocator.PageSize);
 #endif
@@ -587,6 +687,40 @@ struct FMallocBinned2::Private
 		FMallocBinned2::FPerThreadFreeBlockLists::ConsolidatedMemory += FreeBlockLists->AllocatedMemory;
 #endif
 	}
+
+#if BINNED2_IDLE_THREAD_CACHE_TRIM
+	/**
+	 * Returns the cached blocks of each thread that used its caches since they were last reclaimed, and took no trip to the
+	 * shared pools since the previous call, to the shared pools. Such a thread likely sits on cached blocks nobody else can use.
+	 * Runs on the calling thread, so it reaches idle threads that are blocked, task workers and FRunnable threads included.
+	 * The owner can't be using its lists while they are locked here, it bypasses them until they are unlocked.
+	 */
+	static void ReclaimIdleThreadCaches(FMallocBinned2& Allocator)
+	{
+		FScopeLock Lock(&GetFreeBlockListsRegistrationMutex());
+		for (FPerThreadFreeBlockLists* FreeBlockLists : GetRegisteredFreeBlockLists())
+		{
+			const uint32 Activity = FreeBlockLists->ActivityCount.Load(EMemoryOrder::Relaxed);
+			if (Activity == FreeBlockLists->ActivityAtLastIdleCheck && Activity != FreeBlockLists->ActivityAtLastIdleTrim && FreeBlockLists->TryLock())
+			{
+				FreeBlockLists->ActivityAtLastIdleTrim = Activity;
+				{
+					FScopeLock PoolLock(&Allocator.Mutex);
+					for (int32 PoolIndex = 0; PoolIndex != BINNED2_SMALL_POOL_COUNT; ++PoolIndex)
+					{
+						FBundleNode* Bundles = FreeBlockLists->PopBundles(PoolIndex);
+						if (Bundles)
+						{
+							FreeBundles(Allocator, Bundles, PoolIndexToBlockSize(PoolIndex), PoolIndex);
+						}
+					}
+				}
+				FreeBlockLists->Unlock();
+			}
+			FreeBlockLists->ActivityAtLastIdleCheck = Activity;
+		}
+	}
+#endif
 };
 
 FMallocBinned2::Private::FGlobalRecycler FMallocBinned2::Private::GGlobalRecycler;
@@ -623,7 +757,7 @@ FMallocBinned2::FPoolInfo& FMallocBinned2::FPoolList::PushNewPoolToFront(FMalloc
 	const uint32 LocalPageSize = Allocator.PageSize;
 
 	// Allocate memory.
-	void* FreePtr = Allocator.CachedOSPageAllocator.Allocate(LocalPageSize, FMemory::AllocationHints::SmallPool);
+	void* FreePtr = Private::AllocateOSPages(Allocator, LocalPageSize, FMemory::AllocationHints::SmallPool, nullptr);
 	if (!FreePtr)
 	{
 		Private::OutOfMemory(LocalPageSize);
@@ -644,6 +778,10 @@ FMallocBinned2::FPoolInfo& FMallocBinned2::FPoolList::PushNewPoolToFront(FMalloc
 
 FMallocBinned2::FMallocBinned2()
 	: HashBucketFreeList(nullptr)
+#if BINNED2_LARGE_BLOCK_CACHE
+	, NumCachedLargeBlocks(0)
+	, CachedLargeBlocksTotal(0)
+#endif
 {
 	static bool bOnce = false;
 	check(!bOnce); // this is now a singleton-like thing and you cannot make multiple copies
@@ -733,14 +871,20 @@ void* FMallocBinned2::MallocExternalSmall(SIZE_T Size, uint32 Alignment)
 	FPerThreadFreeBlockLists* Lists = GMallocBinned2PerThreadCaches ? FPerThreadFreeBlockLists::Get() : nullptr;
 	if (Lists)
 	{
-		if (Lists->ObtainRecycledPartial(PoolIndex))
+		Lists->MarkActive();
+		if (Lists->TryLock())
 		{
-			if (void* Result = Lists->Malloc(PoolIndex))
-			{
+			void* Result = Lists->ObtainRecycledPartial(PoolIndex) ? Lists->Malloc(PoolIndex) : nullptr;
 #if BINNED2_ALLOCATOR_STATS
+			if (Result)
+			{
 				uint32 BlockSize = PoolIndexToBlockSize(PoolIndex);
 				Lists->AllocatedMemory += BlockSize;
+			}
 #endif
+			Lists->Unlock();
+			if (Result)
+			{
 				return Result;
 			}
 		}
@@ -767,7 +911,7 @@ void* FMallocBinned2::MallocExternalSmall(SIZE_T Size, uint32 Alignment)
 #endif // BINNED2_ALLOCATOR_STATS
 	if (GMallocBinned2AllocExtra)
 	{
-		if (Lists)
+		if (Lists && Lists->TryLock())
 		{
 			// prefill the free list with some allocations so we are less likely to hit this slow path with the mutex 
 			for (int32 Index = 0; Index < GMallocBinned2AllocExtra && Pool->HasFreeRegularBlock(); Index++)
@@ -778,6 +922,7 @@ void* FMallocBinned2::MallocExternalSmall(SIZE_T Size, uint32 Alignment)
 				}
 				Result = Pool->AllocateRegularBlock();
 			}
+			Lists->Unlock();
 		}
 	}
 	if (!Pool->HasFreeRegularBlock())
@@ -807,7 +952,7 @@ void* FMallocBinned2::MallocExternalLarge(SIZE_T Size, uint32 Alignment)
 		FScopeLock Lock(&Mutex);
 
 		// Use OS for non-pooled allocations.
-		Result = CachedOSPageAllocator.Allocate(AlignedSize, 0, &Mutex);
+		Result = Private::AllocateOSPages(*this, AlignedSize, 0, &Mutex);
 		if (!Result)
 		{
 			Private::OutOfMemory(AlignedSize);
@@ -933,6 +1078,15 @@ void FMallocBinned2::FreeExternal(void* Ptr)
 		FBundleNode* BundlesToRecycle = nullptr;
 		FPerThreadFreeBlockLists* Lists = GMallocBinned2PerThreadCaches ? FPerThreadFreeBlockLists::Get() : nullptr;
 		if (Lists)
+		{
+			Lists->MarkActive();
+			if (!Lists->TryLock())
+			{
+				// UpdateStats is reclaiming this thread's caches, free straight to the shared pools
+				Lists = nullptr;
+			}
+		}
+		if (Lists)
 		{
 			BundlesToRecycle = Lists->RecycleFullBundle(BasePtr->PoolIndex);
 			bool bPushed = Lists->Free(Ptr, PoolIndex, BlockSize);
@@ -940,6 +1094,7 @@ void FMallocBinned2::FreeExternal(void* Ptr)
 #if BINNED2_ALLOCATOR_STATS
 			Lists->AllocatedMemory -= BlockSize;
 #endif
+			Lists->Unlock();
 		}
 		else
 		{
@@ -979,7 +1134,7 @@ void FMallocBinned2::FreeExternal(void* Ptr)
 		checkf(PoolOSRequestedBytes <= PoolOsBytes, TEXT("FMallocBinned2::FreeExternal %d %d"), int32(PoolOSRequestedBytes), int32(PoolOsBytes));
 		Pool->SetCanary(FPoolInfo::ECanary::Unassigned, true, false);
 		// Free an OS allocation.
-		CachedOSPageAllocator.Free(Ptr, PoolOsBytes, &Mutex);
+		Private::FreeOSPages(*this, Ptr, PoolOsBytes, &Mutex);
 	}
 }
 
@@ -1067,7 +1222,8 @@ void FMallocBinned2::FlushCurrentThreadCache()
 	double WaitForMutexTime = 0.0;
 	double WaitForMutexAndTrimTime = 0.0;
 
-	if (Lists)
+	// Nothing to do if UpdateStats holds the lists, it is returning them to the shared pools
+	if (Lists && Lists->TryLock())
 	{
 		FScopeLock Lock(&Mutex);
 		WaitForMutexTime = FPlatformTime::Seconds() - StartTimeInner;
@@ -1080,6 +1236,7 @@ void FMallocBinned2::FlushCurrentThreadCache()
 			}
 		}
 		WaitForMutexAndTrimTime = FPlatformTime::Seconds() - StartTimeInner;
+		Lists->Unlock();
 	}
 
 	// These logs must happen outside the above mutex to avoid deadlocks
@@ -1121,6 +1278,7 @@ void FMallocBinned2::Trim(bool bTrimThreadCaches)
 	{
 		//double StartTime = FPlatformTime::Seconds();
 		FScopeLock Lock(&Mutex);
+		Private::FreeCachedOSPages(*this);
 		CachedOSPageAllocator.FreeAll(&Mutex);
 		//UE_LOG(LogTemp, Display, TEXT("Trim CachedOSPageAllocator = %6.2fms"), 1000.0f * float(FPlatformTime::Seconds() - StartTime));
 	}
@@ -1267,15 +1425,17 @@ void FMallocBinned2::GetAllocatorStats( FGenericMemoryStats& OutStats )
 	int64  LocalAllocatedLargePoolMemory           = AllocatedLargePoolMemory.Load(EMemoryOrder::Relaxed);
 	int64  LocalAllocatedLargePoolMemoryWAlignment = AllocatedLargePoolMemoryWAlignment.Load(EMemoryOrder::Relaxed);
 	uint64 OSPageAllocatorCachedFreeSize           = CachedOSPageAllocator.GetCachedFreeTotal();
+	uint64 LargeBlockCacheSize                     = Private::GetCachedOSPagesTotal(*this);
 
 	OutStats.Add(TEXT("AllocatedSmallPoolMemory"), TotalAllocatedSmallPoolMemory);
 	OutStats.Add(TEXT("AllocatedOSSmallPoolMemory"), LocalAllocatedOSSmallPoolMemory);
 	OutStats.Add(TEXT("AllocatedLargePoolMemory"), LocalAllocatedLargePoolMemory);
 	OutStats.Add(TEXT("AllocatedLargePoolMemoryWAlignment"), LocalAllocatedLargePoolMemoryWAlignment);
 	OutStats.Add(TEXT("PageAllocatorFreeCacheSize"), OSPageAllocatorCachedFreeSize);
+	OutStats.Add(TEXT("LargeBlockCacheSize"), LargeBlockCacheSize);
 
 	uint64 TotalAllocated = TotalAllocatedSmallPoolMemory + LocalAllocatedLargePoolMemory;
-	uint64 TotalOSAllocated = LocalAllocatedOSSmallPoolMemory + LocalAllocatedLargePoolMemoryWAlignment + OSPageAllocatorCachedFreeSize;
+	uint64 TotalOSAllocated = LocalAllocatedOSSmallPoolMemory + LocalAllocatedLargePoolMemoryWAlignment + OSPageAllocatorCachedFreeSize + LargeBlockCacheSize;
 
 	OutStats.Add(TEXT("TotalAllocated"), TotalAllocated);
 	OutStats.Add(TEXT("TotalOSAllocated"), TotalOSAllocated);
@@ -1309,6 +1469,7 @@ void FMallocBinned2::DumpAllocatorStats(class FOutputDevice& Ar)
 			AllocatedOSSmallPoolMemory + AllocatedLargePoolMemoryWAlignment + Binned2PoolInfoMemory + Binned2HashMemory + Binned2TLSMemory
 			) / (1024.0f * 1024.0f));
 	Ar.Logf(TEXT("Cached free OS pages: %fmb"), ((double)OSPageAllocatorCachedFreeSize) / (1024.0f * 1024.0f));
+	Ar.Logf(TEXT("Cached committed large blocks: %fmb"), ((double)Private::GetCachedOSPagesTotal(*this)) / (1024.0f * 1024.0f));
 #else
 	Ar.Logf(TEXT("Allocator Stats for binned2 are not in this build set BINNED2_ALLOCATOR_STATS 1 in MallocBinned2.cpp"));
 #endif
@@ -1324,7 +1485,22 @@ void FMallocBinned2::DumpAllocatorStats(class FOutputDevice& Ar)
 void FMallocBinned2::UpdateStats()
 {
 #if CSV_PROFILER
-	CSV_CUSTOM_STAT(FMemory, AllocatorCachedSlackMB, (int32)(CachedOSPageAllocator.GetCachedFreeTotal()/(1024*1024)), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(FMemory, AllocatorCachedSlackMB, (int32)((CachedOSPageAllocator.GetCachedFreeTotal() + Private::GetCachedOSPagesTotal(*this))/(1024*1024)), ECsvCustomStatOp::Set);
+#endif
+
+#if BINNED2_IDLE_THREAD_CACHE_TRIM
+	// Trim on idle: a thread that stopped allocating keeps its cached bundles until someone flushes them.
+	// Only the thread caches, the OS page caches stay so that large blocks are still reused.
+	if (GMallocBinned2PerThreadCaches && GMallocBinned2ThreadCacheIdleTrimTime > 0.0f)
+	{
+		static double LastIdleCheckTime = FPlatformTime::Seconds();
+		const double Now = FPlatformTime::Seconds();
+		if (Now - LastIdleCheckTime >= GMallocBinned2ThreadCacheIdleTrimTime)
+		{
+			LastIdleCheckTime = Now;
+			Private::ReclaimIdleThreadCaches(*this);
+		}
+	}
 #endif
 
 	FScopedVirtualMallocTimer::UpdateStats();
@@ -41,7 +41,7 @@ FMallocReplayProxy::FMallocReplayProxy(FMalloc* InMalloc)
 	// if it is null, we will silenty ignore saves
 	if (HistoryFile)
 	{
-		fprintf(HistoryFile, "Operation ResultPointer PointerIn SizeIn AlignmentIn\n");
+		fprintf(HistoryFile, "Operation ResultPointer PointerIn SizeIn AlignmentIn ThreadId\n");
 
 		// GMalloc may not be destroyed, close history on exit ourselves
 		MallocReplayProxyCloserOnExit.InstanceToClose = this;
@@ -72,7 +72,7 @@ void FMallocReplayProxy::DumpHistoryToDisk()
 	{
 		for (int32 Idx = 0; Idx < CurrentCacheIdx; ++Idx)
 		{
-			fprintf(HistoryFile, "%s %llu %llu %llu %u\t# %llu\n", HistoryCache[Idx].Operation, (uint64)(HistoryCache[Idx].PointerOut), (uint64)(HistoryCache[Idx].PointerIn), (uint64)HistoryCache[Idx].Size, HistoryCache[Idx].Alignment, ++OperationNumber);
+			fprintf(HistoryFile, "%s %llu %llu %llu %u %u\t# %llu\n", HistoryCache[Idx].Operation, (uint64)(HistoryCache[Idx].PointerOut), (uint64)(HistoryCache[Idx].PointerIn), (uint64)HistoryCache[Idx].Size, HistoryCache[Idx].Alignment, HistoryCache[Idx].ThreadId, ++OperationNumber);
 		}
 	}
 
@@ -93,6 +93,8 @@ void* FMallocReplayProxy::Malloc(SIZE_T Size, uint32 Alignment)
 
 void* FMallocReplayProxy::Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment)
 {
+	// Held across the call so that no other thread can log an allocation at the freed address before this Realloc
+	FScopeLock Lock(&HistoryLock);
 	void* Result = UsedMalloc->Realloc(Ptr, NewSize, Alignment);
 	AddToHistory("Realloc", Result, Ptr, NewSize, Alignment);
 	return Result;
@@ -102,8 +104,9 @@ void FMallocReplayProxy::Free(void* Ptr)
 {
 	if (LIKELY(Ptr))
 	{
-		UsedMalloc->Free(Ptr);
+		// Logged first, once freed the address can be handed out and logged by another thread
 		AddToHistory("Free", nullptr, Ptr, 0, 0);
+		UsedMalloc->Free(Ptr);
 	}
 }
 
@@ -83,6 +83,7 @@ void FFileIoStoreBufferAllocator::Initialize(uint64 MemorySize, uint64 BufferSiz
 	uint64 BufferCount = MemorySize / BufferSize;
 	MemorySize = BufferCount * BufferSize;
 	BufferMemory = reinterpret_cast<uint8*>(FMemory::Malloc(MemorySize, BufferAlignment));
+	BufferMemorySize = MemorySize;
 	for (uint64 BufferIndex = 0; BufferIndex < BufferCount; ++BufferIndex)
 	{
 		FFileIoStoreBuffer* Buffer = new FFileIoStoreBuffer();
@@ -312,6 +313,7 @@ FIoStatus FFileIoStoreReader::Initialize(const FIoStoreEnvironment& Environment)
 	{
 		return Status;
 	}
+	FIoStoreTocResource::LoadCompressionDictionary(Environment.GetPath(), TocResource);
 
 	ContainerFile.PartitionSize = TocResource.Header.PartitionSize;
 	ContainerFile.Partitions.SetNum(TocResource.Header.PartitionCount);
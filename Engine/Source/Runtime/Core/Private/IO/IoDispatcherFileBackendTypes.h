@@ -197,8 +197,20 @@ public:
 	FFileIoStoreBuffer* AllocBuffer();
 	void FreeBuffer(FFileIoStoreBuffer* Buffer);
 
+	// all buffers are carved from one block, so platforms can register it once for faster reads
+	uint8* GetBufferMemory() const
+	{
+		return BufferMemory;
+	}
+
+	uint64 GetBufferMemorySize() const
+	{
+		return BufferMemorySize;
+	}
+
 private:
 	uint8* BufferMemory = nullptr;
+	uint64 BufferMemorySize = 0;
 	FCriticalSection BuffersCritical;
 	FFileIoStoreBuffer* FirstFreeBuffer = nullptr;
 };
@@ -6,6 +6,7 @@
 #include "Templates/UniquePtr.h"
 #include "Misc/Paths.h"
 #include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
 #include "Serialization/BufferWriter.h"
 #include "Async/Async.h"
 #include "Async/Future.h"
@@ -565,6 +566,16 @@ public:
 		IPlatformFile& Ipf = IPlatformFile::GetPlatformPhysical();
 		Ipf.CreateDirectoryTree(*FPaths::GetPath(TocFilePath));
 
+		if (ContainerSettings.IsCompressed() && ContainerSettings.CompressionDictionary.Num() > 0 && InContext.GetSettings().CompressionMethod == NAME_Zstd)
+		{
+			CompressionDictionaryId = FCompression::RegisterZstdDictionary(ContainerSettings.CompressionDictionary);
+			const FString DictionaryFilePath = Environment.GetPath() + TEXT(".uzdict");
+			if (!CompressionDictionaryId || !FFileHelper::SaveArrayToFile(ContainerSettings.CompressionDictionary, *DictionaryFilePath))
+			{
+				return FIoStatusBuilder(EIoErrorCode::WriteError) << TEXT("Failed to write IoStore compression dictionary '") << *DictionaryFilePath << TEXT("'");
+			}
+		}
+
 		FIoStatus Status = FIoStatus::Ok;
 		if (InContext.GetSettings().bEnableCsvOutput)
 		{
@@ -622,7 +633,7 @@ public:
 		{
 			TRACE_CPUPROFILER_EVENT_SCOPE(CreateChunkBlocks);
 			Entry->ChunkBuffer = Entry->Request->ConsumeSourceBuffer();
-			CreateChunkBlocks(Entry, ContainerSettings, WriterContext->GetSettings());
+			CreateChunkBlocks(Entry, ContainerSettings, WriterContext->GetSettings(), CompressionDictionaryId);
 			WriterContext->CompressedChunksCount.IncrementExchange();
 		}, TStatId(), &CreateBlocksPrereqs, ENamedThreads::AnyHiPriThreadHiPriTask);
 		
@@ -1105,7 +1116,8 @@ private:
 	static void CreateChunkBlocks(
 		FIoStoreWriteQueueEntry* Entry,
 		const FIoContainerSettings& ContainerSettings,
-		const FIoStoreWriterSettings& WriterSettings)
+		const FIoStoreWriterSettings& WriterSettings,
+		uint32 CompressionDictionaryId)
 	{
 		check(WriterSettings.CompressionBlockSize > 0);
 
@@ -1169,12 +1181,19 @@ private:
 				FName CompressionMethod = WriterSettings.CompressionMethod;
 				{
 					TRACE_CPUPROFILER_EVENT_SCOPE(CompressMemory);
-					const bool bCompressed = FCompression::CompressMemory(
-						CompressionMethod,
-						CompressedBlock.Get(),
-						CompressedBlockSize,
-						UncompressedBlock,
-						UncompressedBlockSize);
+					const bool bCompressed = CompressionDictionaryId != 0
+						? FCompression::CompressMemoryWithZstdDictionary(
+							CompressionDictionaryId,
+							CompressedBlock.Get(),
+							CompressedBlockSize,
+							UncompressedBlock,
+							UncompressedBlockSize)
+						: FCompression::CompressMemory(
+							CompressionMethod,
+							CompressedBlock.Get(),
+							CompressedBlockSize,
+							UncompressedBlock,
+							UncompressedBlockSize);
 					check(bCompressed);
 				}
 				check(CompressedBlockSize > 0);
@@ -1251,6 +1270,7 @@ private:
 	FIoStoreEnvironment&		Environment;
 	FIoStoreWriterContextImpl*	WriterContext = nullptr;
 	FIoContainerSettings		ContainerSettings;
+	uint32						CompressionDictionaryId = 0;
 	FString						TocFilePath;
 	FIoStoreToc					Toc;
 	TArray<FPartition>			Partitions;
@@ -1352,6 +1372,7 @@ public:
 		{
 			return TocStatus;
 		}
+		FIoStoreTocResource::LoadCompressionDictionary(InEnvironment.GetPath(), TocResource);
 
 		Toc.Initialize();
 
@@ -1650,6 +1671,21 @@ const FIoDirectoryIndexReader& FIoStoreReader::GetDirectoryIndexReader() const
 	return Impl->GetDirectoryIndexReader();
 }
 
+void FIoStoreTocResource::LoadCompressionDictionary(const TCHAR* ContainerPath, const FIoStoreTocResource& TocResource)
+{
+	// only zstd has dictionaries, don't probe for the file otherwise
+	if (!TocResource.CompressionMethods.Contains(NAME_Zstd))
+	{
+		return;
+	}
+
+	TArray<uint8> Dictionary;
+	if (FFileHelper::LoadFileToArray(Dictionary, *(FString(ContainerPath) + TEXT(".uzdict")), FILEREAD_Silent))
+	{
+		FCompression::RegisterZstdDictionary(Dictionary);
+	}
+}
+
 FIoStatus FIoStoreTocResource::Read(const TCHAR* TocFilePath, EIoStoreTocReadOptions ReadOptions, FIoStoreTocResource& OutTocResource)
 {
 	check(TocFilePath != nullptr);
@@ -228,4 +228,7 @@ struct FIoStoreTocResource
 	UE_NODISCARD static FIoStatus Read(const TCHAR* TocFilePath, EIoStoreTocReadOptions ReadOptions, FIoStoreTocResource& OutTocResource);
 
 	UE_NODISCARD static TIoStatusOr<uint64> Write(const TCHAR* TocFilePath, FIoStoreTocResource& TocResource, const FIoContainerSettings& ContainerSettings, const FIoStoreWriterSettings& WriterSettings);
+
+	/** Registers the container compression dictionary, if the container was written with one. Must happen before any block is decompressed. */
+	static void LoadCompressionDictionary(const TCHAR* ContainerPath, const FIoStoreTocResource& TocResource);
 };
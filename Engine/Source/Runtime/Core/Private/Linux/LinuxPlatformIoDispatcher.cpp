@@ -0,0 +1,710 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Linux/LinuxPlatformIoDispatcher.h"
+#include "IO/IoDispatcherFileBackend.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define LINUX_IOSTORE_HAS_IO_URING 1
+#endif
+#endif
+
+#ifndef LINUX_IOSTORE_HAS_IO_URING
+#define LINUX_IOSTORE_HAS_IO_URING 0
+#endif
+
+// sysroots can ship io_uring.h without the syscall numbers, they are the same on all architectures
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+
+//PRAGMA_DISABLE_OPTIMIZATION
+
+TRACE_DECLARE_INT_COUNTER(IoDispatcherInflightReads, TEXT("IoDispatcher/InflightReads"));
+
+int32 GIoDispatcherLinuxBackend = 0;
+static FAutoConsoleVariableRef CVar_IoDispatcherLinuxBackend(
+	TEXT("s.IoDispatcherLinuxBackend"),
+	GIoDispatcherLinuxBackend,
+	TEXT("IoDispatcher read backend on Linux. 0: io_uring, or read threads if io_uring is not available. 1: read threads.")
+);
+
+int32 GIoDispatcherLinuxQueueDepth = 32;
+static FAutoConsoleVariableRef CVar_IoDispatcherLinuxQueueDepth(
+	TEXT("s.IoDispatcherLinuxQueueDepth"),
+	GIoDispatcherLinuxQueueDepth,
+	TEXT("IoDispatcher max number of reads in flight on Linux.")
+);
+
+int32 GIoDispatcherLinuxReadThreadCount = 4;
+static FAutoConsoleVariableRef CVar_IoDispatcherLinuxReadThreadCount(
+	TEXT("s.IoDispatcherLinuxReadThreadCount"),
+	GIoDispatcherLinuxReadThreadCount,
+	TEXT("IoDispatcher number of preadv threads on Linux when io_uring is not used.")
+);
+
+#if LINUX_IOSTORE_HAS_IO_URING
+
+/**
+ * Just enough io_uring for reads, without depending on liburing.
+ * Submission queue is only touched by the IoService thread, completion queue only by the completion thread.
+ */
+class FLinuxIoUring final : public FRunnable
+{
+public:
+	static TUniquePtr<FLinuxIoUring> Create(FLinuxFileIoStoreImpl& Owner, uint32 QueueDepth);
+	~FLinuxIoUring();
+
+	int32 GetQueueDepth() const
+	{
+		return Reads.Num();
+	}
+
+	// reads into registered memory skip mapping the pages for every request
+	void RegisterBuffer(uint8* Memory, uint64 Size);
+	bool HasTriedRegisterBuffer() const
+	{
+		return bTriedRegisterBuffer;
+	}
+
+	void PrepareRead(FFileIoStoreReadRequest* Request, uint8* Dest);
+	void Submit();
+
+	virtual uint32 Run() override;
+
+private:
+	struct FRead
+	{
+		FFileIoStoreReadRequest* Request = nullptr;
+		struct iovec Iovec;	// must live until completion, old kernels read it again when the request is punted
+	};
+
+	FLinuxIoUring(FLinuxFileIoStoreImpl& InOwner, int32 InRingFd)
+		: Owner(InOwner)
+		, RingFd(InRingFd)
+	{
+	}
+
+	bool MapRings(const io_uring_params& Params);
+	io_uring_sqe* GetSqe();
+	bool PeekCompletion(uint64& OutUserData, int32& OutResult);
+	int32 AllocRead(FFileIoStoreReadRequest* Request);
+
+	FLinuxFileIoStoreImpl& Owner;
+	int32 RingFd = -1;
+	FRunnableThread* Thread = nullptr;
+
+	void* SqRing = nullptr;
+	uint64 SqRingSize = 0;
+	uint32* SqTail = nullptr;
+	uint32* SqHead = nullptr;
+	uint32* SqArray = nullptr;
+	uint32 SqMask = 0;
+	uint32 SqEntries = 0;
+	uint32 SqLocalTail = 0;
+	io_uring_sqe* Sqes = nullptr;
+	uint64 SqesSize = 0;
+
+	void* CqRing = nullptr;
+	uint64 CqRingSize = 0;
+	uint32* CqHead = nullptr;
+	uint32* CqTail = nullptr;
+	uint32 CqMask = 0;
+	io_uring_cqe* Cqes = nullptr;
+
+	const uint8* RegisteredMemory = nullptr;
+	uint64 RegisteredMemorySize = 0;
+	bool bTriedRegisterBuffer = false;
+
+	FCriticalSection ReadsCritical;
+	TArray<FRead> Reads;
+	TArray<int32> FreeReads;
+};
+
+TUniquePtr<FLinuxIoUring> FLinuxIoUring::Create(FLinuxFileIoStoreImpl& Owner, uint32 QueueDepth)
+{
+	io_uring_params Params;
+	FMemory::Memzero(Params);
+	const int32 RingFd = int32(syscall(__NR_io_uring_setup, QueueDepth, &Params));
+	if (RingFd < 0)
+	{
+		UE_LOG(LogIoDispatcher, Log, TEXT("io_uring is not available (errno %d), using read threads"), errno);
+		return nullptr;
+	}
+
+	TUniquePtr<FLinuxIoUring> IoUring(new FLinuxIoUring(Owner, RingFd));
+	if (!IoUring->MapRings(Params))
+	{
+		UE_LOG(LogIoDispatcher, Warning, TEXT("Failed mapping io_uring (errno %d), using read threads"), errno);
+		return nullptr;
+	}
+
+	const int32 NumReads = int32(FMath::Min(QueueDepth, Params.sq_entries));
+	IoUring->Reads.SetNum(NumReads);
+	IoUring->FreeReads.Reserve(NumReads);
+	for (int32 ReadIndex = NumReads - 1; ReadIndex >= 0; --ReadIndex)
+	{
+		IoUring->FreeReads.Add(ReadIndex);
+	}
+
+	IoUring->Thread = FRunnableThread::Create(IoUring.Get(), TEXT("IoUringCompletion"), 0, TPri_AboveNormal);
+	if (!IoUring->Thread)
+	{
+		UE_LOG(LogIoDispatcher, Warning, TEXT("Failed creating the io_uring completion thread, using read threads"));
+		return nullptr;
+	}
+	UE_LOG(LogIoDispatcher, Log, TEXT("Using io_uring with queue depth %d"), NumReads);
+	return IoUring;
+}
+
+FLinuxIoUring::~FLinuxIoUring()
+{
+	if (Thread)
+	{
+		// completion thread exits when it sees a nop with no read attached
+		io_uring_sqe* Sqe = GetSqe();
+		check(Sqe);
+		Sqe->opcode = IORING_OP_NOP;
+		Sqe->user_data = 0;
+		Submit();
+
+		Thread->WaitForCompletion();
+		delete Thread;
+	}
+
+	if (Sqes)
+	{
+		munmap(Sqes, SqesSize);
+	}
+	if (CqRing)
+	{
+		munmap(CqRing, CqRingSize);
+	}
+	if (SqRing)
+	{
+		munmap(SqRing, SqRingSize);
+	}
+	close(RingFd);
+}
+
+bool FLinuxIoUring::MapRings(const io_uring_params& Params)
+{
+	SqRingSize = Params.sq_off.array + Params.sq_entries * sizeof(uint32);
+	SqRing = mmap(nullptr, SqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, RingFd, IORING_OFF_SQ_RING);
+	if (SqRing == MAP_FAILED)
+	{
+		SqRing = nullptr;
+		return false;
+	}
+
+	SqesSize = Params.sq_entries * sizeof(io_uring_sqe);
+	void* SqesMemory = mmap(nullptr, SqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, RingFd, IORING_OFF_SQES);
+	if (SqesMemory == MAP_FAILED)
+	{
+		return false;
+	}
+	Sqes = reinterpret_cast<io_uring_sqe*>(SqesMemory);
+
+	CqRingSize = Params.cq_off.cqes + Params.cq_entries * sizeof(io_uring_cqe);
+	CqRing = mmap(nullptr, CqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, RingFd, IORING_OFF_CQ_RING);
+	if (CqRing == MAP_FAILED)
+	{
+		CqRing = nullptr;
+		return false;
+	}
+
+	uint8* SqBase = reinterpret_cast<uint8*>(SqRing);
+	SqHead = reinterpret_cast<uint32*>(SqBase + Params.sq_off.head);
+	SqTail = reinterpret_cast<uint32*>(SqBase + Params.sq_off.tail);
+	SqArray = reinterpret_cast<uint32*>(SqBase + Params.sq_off.array);
+	SqMask = *reinterpret_cast<uint32*>(SqBase + Params.sq_off.ring_mask);
+	SqEntries = *reinterpret_cast<uint32*>(SqBase + Params.sq_off.ring_entries);
+	SqLocalTail = *SqTail;
+
+	uint8* CqBase = reinterpret_cast<uint8*>(CqRing);
+	CqHead = reinterpret_cast<uint32*>(CqBase + Params.cq_off.head);
+	CqTail = reinterpret_cast<uint32*>(CqBase + Params.cq_off.tail);
+	CqMask = *reinterpret_cast<uint32*>(CqBase + Params.cq_off.ring_mask);
+	Cqes = reinterpret_cast<io_uring_cqe*>(CqBase + Params.cq_off.cqes);
+	return true;
+}
+
+void FLinuxIoUring::RegisterBuffer(uint8* Memory, uint64 Size)
+{
+	bTriedRegisterBuffer = true;
+
+	struct iovec Iovec;
+	Iovec.iov_base = Memory;
+	Iovec.iov_len = Size;
+	if (syscall(__NR_io_uring_register, RingFd, IORING_REGISTER_BUFFERS, &Iovec, 1) < 0)
+	{
+		// usually RLIMIT_MEMLOCK is too small, plain reads still work
+		UE_LOG(LogIoDispatcher, Log, TEXT("Failed registering %llu bytes of read buffers with io_uring (errno %d)"), Size, errno);
+		return;
+	}
+
+	RegisteredMemory = Memory;
+	RegisteredMemorySize = Size;
+}
+
+io_uring_sqe* FLinuxIoUring::GetSqe()
+{
+	const uint32 Head = __atomic_load_n(SqHead, __ATOMIC_ACQUIRE);
+	if (SqLocalTail - Head >= SqEntries)
+	{
+		return nullptr;
+	}
+
+	const uint32 Index = SqLocalTail & SqMask;
+	SqArray[Index] = Index;
+	++SqLocalTail;
+
+	io_uring_sqe* Sqe = &Sqes[Index];
+	FMemory::Memzero(*Sqe);
+	return Sqe;
+}
+
+int32 FLinuxIoUring::AllocRead(FFileIoStoreReadRequest* Request)
+{
+	FScopeLock _(&ReadsCritical);
+	check(FreeReads.Num() > 0);
+	const int32 ReadIndex = FreeReads.Pop(false);
+	Reads[ReadIndex].Request = Request;
+	return ReadIndex;
+}
+
+void FLinuxIoUring::PrepareRead(FFileIoStoreReadRequest* Request, uint8* Dest)
+{
+	const int32 ReadIndex = AllocRead(Request);
+	FRead& Read = Reads[ReadIndex];
+
+	// never full, in flight reads are limited to the queue depth
+	io_uring_sqe* Sqe = GetSqe();
+	check(Sqe);
+	Sqe->fd = int32(Request->FileHandle);
+	Sqe->off = Request->Offset;
+	Sqe->user_data = uint64(ReadIndex) + 1;
+
+	const bool bIsRegistered = RegisteredMemory && Dest >= RegisteredMemory && Dest + Request->Size <= RegisteredMemory + RegisteredMemorySize;
+	if (bIsRegistered)
+	{
+		Sqe->opcode = IORING_OP_READ_FIXED;
+		Sqe->addr = reinterpret_cast<uint64>(Dest);
+		Sqe->len = uint32(Request->Size);
+		Sqe->buf_index = 0;
+	}
+	else
+	{
+		Read.Iovec.iov_base = Dest;
+		Read.Iovec.iov_len = Request->Size;
+		Sqe->opcode = IORING_OP_READV;
+		Sqe->addr = reinterpret_cast<uint64>(&Read.Iovec);
+		Sqe->len = 1;
+	}
+}
+
+void FLinuxIoUring::Submit()
+{
+	uint32 NumToSubmit = SqLocalTail - *SqTail;
+	__atomic_store_n(SqTail, SqLocalTail, __ATOMIC_RELEASE);
+
+	while (NumToSubmit > 0)
+	{
+		const int32 Result = int32(syscall(__NR_io_uring_enter, RingFd, NumToSubmit, 0, 0, nullptr, 0));
+		if (Result < 0)
+		{
+			if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+			{
+				UE_LOG(LogIoDispatcher, Fatal, TEXT("io_uring submit failed (errno %d)"), errno);
+			}
+			FPlatformProcess::Yield();
+			continue;
+		}
+		NumToSubmit -= uint32(Result);
+	}
+}
+
+bool FLinuxIoUring::PeekCompletion(uint64& OutUserData, int32& OutResult)
+{
+	const uint32 Head = *CqHead;
+	if (Head == __atomic_load_n(CqTail, __ATOMIC_ACQUIRE))
+	{
+		return false;
+	}
+
+	const io_uring_cqe& Cqe = Cqes[Head & CqMask];
+	OutUserData = Cqe.user_data;
+	OutResult = Cqe.res;
+	__atomic_store_n(CqHead, Head + 1, __ATOMIC_RELEASE);
+	return true;
+}
+
+uint32 FLinuxIoUring::Run()
+{
+	for (;;)
+	{
+		uint64 UserData;
+		int32 Result;
+		while (PeekCompletion(UserData, Result))
+		{
+			if (UserData == 0)
+			{
+				return 0;
+			}
+
+			const int32 ReadIndex = int32(UserData - 1);
+			FFileIoStoreReadRequest* Request = Reads[ReadIndex].Request;
+			{
+				FScopeLock _(&ReadsCritical);
+				FreeReads.Add(ReadIndex);
+			}
+
+			if (Result == int32(Request->Size))
+			{
+				Request->bFailed = false;
+			}
+			else
+			{
+				// error or short read, finish the rest the slow way
+				Owner.ReadBlocking(Request, Result > 0 ? uint64(Result) : 0);
+			}
+			Owner.CompleteRequest(Request);
+		}
+
+		TRACE_CPUPROFILER_EVENT_SCOPE(IoUringWait);
+		syscall(__NR_io_uring_enter, RingFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+	}
+}
+
+#else
+
+class FLinuxIoUring
+{
+public:
+	static TUniquePtr<FLinuxIoUring> Create(FLinuxFileIoStoreImpl& Owner, uint32 QueueDepth)
+	{
+		UE_LOG(LogIoDispatcher, Log, TEXT("Built without io_uring headers, using read threads"));
+		return nullptr;
+	}
+
+	int32 GetQueueDepth() const { return 0; }
+	void RegisterBuffer(uint8* Memory, uint64 Size) {}
+	bool HasTriedRegisterBuffer() const { return true; }
+	void PrepareRead(FFileIoStoreReadRequest* Request, uint8* Dest) {}
+	void Submit() {}
+};
+
+#endif // LINUX_IOSTORE_HAS_IO_URING
+
+class FLinuxFileIoStoreReadThread final : public FRunnable
+{
+public:
+	FLinuxFileIoStoreReadThread(FLinuxFileIoStoreImpl& InOwner, int32 Index)
+		: Owner(InOwner)
+	{
+		Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("IoServiceRead%d"), Index), 0, TPri_AboveNormal);
+	}
+
+	~FLinuxFileIoStoreReadThread()
+	{
+		if (Thread)
+		{
+			Thread->WaitForCompletion();
+			delete Thread;
+		}
+	}
+
+	virtual uint32 Run() override
+	{
+		for (;;)
+		{
+			FFileIoStoreReadRequest* Request = nullptr;
+			bool bStopping;
+			{
+				FScopeLock _(&Owner.PendingReadsCritical);
+				bStopping = Owner.bStopping;
+				if (!bStopping && Owner.PendingReads.Num() > 0)
+				{
+					Request = Owner.PendingReads[0];
+					Owner.PendingReads.RemoveAt(0, 1, false);
+				}
+			}
+
+			if (bStopping)
+			{
+				// wake the next thread so all of them see the stop
+				Owner.PendingReadsEvent->Trigger();
+				return 0;
+			}
+
+			if (!Request)
+			{
+				Owner.PendingReadsEvent->Wait();
+				continue;
+			}
+
+			Owner.ReadBlocking(Request, 0);
+			Owner.CompleteRequest(Request);
+		}
+	}
+
+private:
+	FLinuxFileIoStoreImpl& Owner;
+	FRunnableThread* Thread = nullptr;
+};
+
+FLinuxFileIoStoreImpl::FLinuxFileIoStoreImpl(FGenericIoDispatcherEventQueue& InEventQueue, FFileIoStoreBufferAllocator& InBufferAllocator, FFileIoStoreBlockCache& InBlockCache, ELinuxFileIoStoreBackend Backend)
+	: EventQueue(InEventQueue)
+	, BufferAllocator(InBufferAllocator)
+	, BlockCache(InBlockCache)
+{
+	if (Backend == ELinuxFileIoStoreBackend::Auto)
+	{
+		Backend = GIoDispatcherLinuxBackend == 1 ? ELinuxFileIoStoreBackend::ReadThreads : ELinuxFileIoStoreBackend::IoUring;
+	}
+
+	const int32 QueueDepth = FMath::Max(GIoDispatcherLinuxQueueDepth, 1);
+	const bool bMultithreaded = FPlatformProcess::SupportsMultithreading();
+	if (Backend == ELinuxFileIoStoreBackend::IoUring && bMultithreaded)
+	{
+		IoUring = FLinuxIoUring::Create(*this, uint32(QueueDepth));
+	}
+
+	if (IoUring)
+	{
+		MaxInflightRequests = IoUring->GetQueueDepth();
+	}
+	else if (!bMultithreaded)
+	{
+		// no threads to complete reads on, StartRequests reads inline
+		UE_LOG(LogIoDispatcher, Log, TEXT("Multithreading is not supported, reading synchronously"));
+		MaxInflightRequests = QueueDepth;
+	}
+	else
+	{
+		const int32 ReadThreadCount = FMath::Clamp(GIoDispatcherLinuxReadThreadCount, 1, QueueDepth);
+		MaxInflightRequests = QueueDepth;
+		PendingReadsEvent = FPlatformProcess::GetSynchEventFromPool();
+		for (int32 ThreadIndex = 0; ThreadIndex < ReadThreadCount; ++ThreadIndex)
+		{
+			ReadThreads.Add(new FLinuxFileIoStoreReadThread(*this, ThreadIndex));
+		}
+	}
+}
+
+FLinuxFileIoStoreImpl::~FLinuxFileIoStoreImpl()
+{
+	IoUring.Reset();
+
+	if (ReadThreads.Num() > 0)
+	{
+		{
+			FScopeLock _(&PendingReadsCritical);
+			bStopping = true;
+		}
+		PendingReadsEvent->Trigger();
+		for (FLinuxFileIoStoreReadThread* ReadThread : ReadThreads)
+		{
+			delete ReadThread;
+		}
+		ReadThreads.Empty();
+	}
+
+	if (PendingReadsEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(PendingReadsEvent);
+	}
+}
+
+bool FLinuxFileIoStoreImpl::OpenContainer(const TCHAR* ContainerFilePath, uint64& ContainerFileHandle, uint64& ContainerFileSize)
+{
+	IPlatformFile& Ipf = IPlatformFile::GetPlatformPhysical();
+	const FString Filename = Ipf.ConvertToAbsolutePathForExternalAppForRead(ContainerFilePath);
+	const int32 Fd = open(TCHAR_TO_UTF8(*Filename), O_RDONLY | O_CLOEXEC);
+	if (Fd < 0)
+	{
+		return false;
+	}
+
+	struct stat FileInfo;
+	if (fstat(Fd, &FileInfo) != 0)
+	{
+		close(Fd);
+		return false;
+	}
+
+	ContainerFileHandle = uint64(Fd);
+	ContainerFileSize = uint64(FileInfo.st_size);
+	return true;
+}
+
+uint8* FLinuxFileIoStoreImpl::GetRequestDest(FFileIoStoreReadRequest* Request) const
+{
+	if (Request->ImmediateScatter.Request)
+	{
+		return Request->ImmediateScatter.Request->GetIoBuffer().Data() + Request->ImmediateScatter.DstOffset;
+	}
+	check(Request->Buffer);
+	return Request->Buffer->Memory;
+}
+
+bool FLinuxFileIoStoreImpl::StartRequests(FFileIoStoreRequestQueue& RequestQueue)
+{
+	if (IoUring && !IoUring->HasTriedRegisterBuffer() && BufferAllocator.GetBufferMemory())
+	{
+		IoUring->RegisterBuffer(BufferAllocator.GetBufferMemory(), BufferAllocator.GetBufferMemorySize());
+	}
+
+	bool bStartedAny = false;
+	int32 NumPrepared = 0;
+	while (NumInflightRequests.Load() < MaxInflightRequests)
+	{
+		FFileIoStoreReadRequest* NextRequest = RequestQueue.Pop();
+		if (!NextRequest)
+		{
+			break;
+		}
+
+		if (NextRequest->bCancelled)
+		{
+			{
+				FScopeLock _(&CompletedRequestsCritical);
+				CompletedRequests.Add(NextRequest);
+			}
+			EventQueue.DispatcherNotify();
+			bStartedAny = true;
+			continue;
+		}
+
+		if (!NextRequest->ImmediateScatter.Request)
+		{
+			NextRequest->Buffer = BufferAllocator.AllocBuffer();
+			if (!NextRequest->Buffer)
+			{
+				RequestQueue.Push(*NextRequest);
+				break;
+			}
+		}
+
+		bStartedAny = true;
+		if (BlockCache.Read(NextRequest))
+		{
+			{
+				FScopeLock _(&CompletedRequestsCritical);
+				CompletedRequests.Add(NextRequest);
+			}
+			EventQueue.DispatcherNotify();
+			continue;
+		}
+
+		++NumInflightRequests;
+		if (IoUring)
+		{
+			IoUring->PrepareRead(NextRequest, GetRequestDest(NextRequest));
+			++NumPrepared;
+		}
+		else if (ReadThreads.Num() > 0)
+		{
+			{
+				FScopeLock _(&PendingReadsCritical);
+				PendingReads.Add(NextRequest);
+			}
+			PendingReadsEvent->Trigger();
+		}
+		else
+		{
+			// FFileIoStore calls StartRequests again until it returns false when not multithreaded
+			ReadBlocking(NextRequest, 0);
+			CompleteRequest(NextRequest);
+		}
+	}
+
+	// one syscall for the whole batch
+	if (NumPrepared > 0)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(IoUringSubmit);
+		IoUring->Submit();
+	}
+	TRACE_COUNTER_SET(IoDispatcherInflightReads, NumInflightRequests.Load());
+
+	return bStartedAny;
+}
+
+void FLinuxFileIoStoreImpl::ReadBlocking(FFileIoStoreReadRequest* Request, uint64 AlreadyReadSize)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(ReadBlockFromFile);
+	uint8* Dest = GetRequestDest(Request);
+	const int32 Fd = int32(Request->FileHandle);
+	uint64 ReadSize = AlreadyReadSize;
+	int32 RetryCount = 0;
+	while (ReadSize < Request->Size)
+	{
+		struct iovec Iovec;
+		Iovec.iov_base = Dest + ReadSize;
+		Iovec.iov_len = Request->Size - ReadSize;
+		const ssize_t Result = preadv(Fd, &Iovec, 1, off_t(Request->Offset + ReadSize));
+		if (Result > 0)
+		{
+			ReadSize += uint64(Result);
+			continue;
+		}
+		if (Result < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (RetryCount++ >= 10)
+		{
+			break;
+		}
+		UE_LOG(LogIoDispatcher, Warning, TEXT("Failed reading %lld bytes at offset %lld (Retries: %d)"), Request->Size - ReadSize, Request->Offset + ReadSize, (RetryCount - 1));
+	}
+	Request->bFailed = ReadSize < Request->Size;
+}
+
+void FLinuxFileIoStoreImpl::CompleteRequest(FFileIoStoreReadRequest* Request)
+{
+	if (!Request->bFailed)
+	{
+		BlockCache.Store(Request);
+	}
+	{
+		FScopeLock _(&CompletedRequestsCritical);
+		CompletedRequests.Add(Request);
+	}
+	EventQueue.DispatcherNotify();
+
+	// IoService thread only waits for a free slot when the queue is full
+	if (NumInflightRequests-- == MaxInflightRequests)
+	{
+		EventQueue.ServiceNotify();
+	}
+}
+
+void FLinuxFileIoStoreImpl::GetCompletedRequests(FFileIoStoreReadRequestList& OutRequests)
+{
+	FScopeLock _(&CompletedRequestsCritical);
+	OutRequests.Append(CompletedRequests);
+	CompletedRequests.Clear();
+}
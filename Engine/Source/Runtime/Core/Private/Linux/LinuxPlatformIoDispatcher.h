@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GenericPlatform/GenericPlatformIoDispatcher.h"
+
+typedef FGenericIoDispatcherEventQueue FIoDispatcherEventQueue;
+
+class FLinuxIoUring;
+class FLinuxFileIoStoreReadThread;
+
+enum class ELinuxFileIoStoreBackend : uint8
+{
+	// io_uring if the kernel supports it, otherwise read threads
+	Auto,
+	IoUring,
+	ReadThreads,
+};
+
+/**
+ * Reads container blocks with many requests in flight.
+ *
+ * Requests are submitted in batches to an io_uring and reaped by a completion thread. Reads into the
+ * dispatcher buffers use the buffer memory registered with the ring. When io_uring is not available
+ * (old kernel, seccomp, ...) a small pool of threads does blocking preadv calls instead. Without multithreading
+ * StartRequests does the preadv calls itself and completes requests inline.
+ */
+class FLinuxFileIoStoreImpl
+{
+public:
+	FLinuxFileIoStoreImpl(FGenericIoDispatcherEventQueue& InEventQueue, FFileIoStoreBufferAllocator& InBufferAllocator, FFileIoStoreBlockCache& InBlockCache, ELinuxFileIoStoreBackend Backend = ELinuxFileIoStoreBackend::Auto);
+	~FLinuxFileIoStoreImpl();
+	bool OpenContainer(const TCHAR* ContainerFilePath, uint64& ContainerFileHandle, uint64& ContainerFileSize);
+	bool CreateCustomRequests(FFileIoStoreRequestAllocator& RequestAllocator, FFileIoStoreResolvedRequest& ResolvedRequest, FFileIoStoreReadRequestList& OutRequests)
+	{
+		return false;
+	}
+	bool StartRequests(FFileIoStoreRequestQueue& RequestQueue);
+	void GetCompletedRequests(FFileIoStoreReadRequestList& OutRequests);
+
+	bool IsUsingIoUring() const
+	{
+		return IoUring.IsValid();
+	}
+
+	// called by the completion thread and the read threads
+	void ReadBlocking(FFileIoStoreReadRequest* Request, uint64 AlreadyReadSize);
+	void CompleteRequest(FFileIoStoreReadRequest* Request);
+
+private:
+	uint8* GetRequestDest(FFileIoStoreReadRequest* Request) const;
+
+	FGenericIoDispatcherEventQueue& EventQueue;
+	FFileIoStoreBufferAllocator& BufferAllocator;
+	FFileIoStoreBlockCache& BlockCache;
+
+	TUniquePtr<FLinuxIoUring> IoUring;
+	TArray<FLinuxFileIoStoreReadThread*> ReadThreads;
+	int32 MaxInflightRequests = 0;
+	TAtomic<int32> NumInflightRequests { 0 };
+
+	// pending reads for read threads
+	FCriticalSection PendingReadsCritical;
+	TArray<FFileIoStoreReadRequest*> PendingReads;
+	FEvent* PendingReadsEvent = nullptr;
+	bool bStopping = false;
+
+	FCriticalSection CompletedRequestsCritical;
+	FFileIoStoreReadRequestList CompletedRequests;
+
+	friend class FLinuxFileIoStoreReadThread;
+};
+
+typedef FLinuxFileIoStoreImpl FFileIoStoreImpl;
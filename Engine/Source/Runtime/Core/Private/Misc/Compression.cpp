@@ -6,6 +6,7 @@
 #include "Logging/LogMacros.h"
 #include "Misc/Parse.h"
 #include "Misc/ScopeLock.h"
+#include "Misc/ScopeRWLock.h"
 #include "Misc/CommandLine.h"
 #include "Stats/Stats.h"
 #include "Misc/ConfigCacheIni.h"
@@ -23,6 +24,13 @@ THIRD_PARTY_INCLUDES_START
 #include "Compression/lz4hc.h"
 THIRD_PARTY_INCLUDES_END
 
+#if WITH_ZSTD
+THIRD_PARTY_INCLUDES_START
+#include "zstd.h"
+#include "zdict.h"
+THIRD_PARTY_INCLUDES_END
+#endif
+
 DECLARE_LOG_CATEGORY_EXTERN(LogCompression, Log, All);
 DEFINE_LOG_CATEGORY(LogCompression);
 
@@ -372,6 +380,228 @@ bool appUncompressMemoryStreamZLIB(void* UncompressedBuffer, int32 UncompressedS
 	return bOperationSucceeded;
 }
 
+#if WITH_ZSTD
+
+/**
+ * Zstd compression level. -zstdlevel= on the command line wins, otherwise the flags pick speed or size.
+ * The default is about as fast as zlib default but compresses better and decompresses several times faster.
+ */
+static int32 GetZstdCompressionLevel(ECompressionFlags Flags)
+{
+	static int32 GCommandLineZstdLevel = 0;
+	static bool GTestedCmdLine = false;
+	if (!GTestedCmdLine && FCommandLine::IsInitialized())
+	{
+		GTestedCmdLine = true;
+		FParse::Value(FCommandLine::Get(), TEXT("-zstdlevel="), GCommandLineZstdLevel);
+	}
+
+	if (GCommandLineZstdLevel != 0)
+	{
+		return FMath::Clamp(GCommandLineZstdLevel, 1, ZSTD_maxCLevel());
+	}
+	if (Flags & COMPRESS_BiasMemory)
+	{
+		return 19;
+	}
+	if (Flags & COMPRESS_BiasSpeed)
+	{
+		return 1;
+	}
+	return ZSTD_CLEVEL_DEFAULT;
+}
+
+/** Contexts are expensive to create, keep one of each per thread */
+struct FZstdThreadContexts
+{
+	ZSTD_CCtx* CompressContext = nullptr;
+	ZSTD_DCtx* DecompressContext = nullptr;
+
+	~FZstdThreadContexts()
+	{
+		ZSTD_freeCCtx(CompressContext);
+		ZSTD_freeDCtx(DecompressContext);
+	}
+};
+static thread_local FZstdThreadContexts GZstdThreadContexts;
+
+struct FZstdDictionary
+{
+	TArray<uint8> Data;
+	ZSTD_DDict* DecompressDictionary = nullptr;
+	/** Digested per compression level on first use */
+	TMap<int32, ZSTD_CDict*> CompressDictionaries;
+};
+
+/** Registered dictionaries are never removed, so pointers handed out stay valid */
+static FRWLock GZstdDictionariesLock;
+static TMap<uint32, FZstdDictionary*> GZstdDictionaries;
+
+static const ZSTD_DDict* FindZstdDecompressDictionary(uint32 DictionaryId)
+{
+	FRWScopeLock Lock(GZstdDictionariesLock, SLT_ReadOnly);
+	FZstdDictionary* Dictionary = GZstdDictionaries.FindRef(DictionaryId);
+	return Dictionary ? Dictionary->DecompressDictionary : nullptr;
+}
+
+static const ZSTD_CDict* FindZstdCompressDictionary(uint32 DictionaryId, int32 Level)
+{
+	FZstdDictionary* Dictionary = nullptr;
+	{
+		FRWScopeLock Lock(GZstdDictionariesLock, SLT_ReadOnly);
+		Dictionary = GZstdDictionaries.FindRef(DictionaryId);
+		if (!Dictionary)
+		{
+			return nullptr;
+		}
+		if (ZSTD_CDict* const* Found = Dictionary->CompressDictionaries.Find(Level))
+		{
+			return *Found;
+		}
+	}
+
+	// first use at this level, digest it
+	FRWScopeLock Lock(GZstdDictionariesLock, SLT_Write);
+	ZSTD_CDict*& CompressDictionary = Dictionary->CompressDictionaries.FindOrAdd(Level);
+	if (!CompressDictionary)
+	{
+		CompressDictionary = ZSTD_createCDict(Dictionary->Data.GetData(), Dictionary->Data.Num(), Level);
+	}
+	return CompressDictionary;
+}
+
+static bool appCompressMemoryZstd(void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize, ECompressionFlags Flags, uint32 DictionaryId)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("Compress Memory Zstd"), STAT_appCompressMemoryZstd, STATGROUP_Compression);
+
+	FZstdThreadContexts& Contexts = GZstdThreadContexts;
+	if (!Contexts.CompressContext)
+	{
+		Contexts.CompressContext = ZSTD_createCCtx();
+	}
+
+	const int32 Level = GetZstdCompressionLevel(Flags);
+	size_t Result;
+	if (DictionaryId != 0)
+	{
+		const ZSTD_CDict* CompressDictionary = FindZstdCompressDictionary(DictionaryId, Level);
+		if (!CompressDictionary)
+		{
+			UE_LOG(LogCompression, Warning, TEXT("appCompressMemoryZstd failed: Dictionary %u is not registered"), DictionaryId);
+			return false;
+		}
+		Result = ZSTD_compress_usingCDict(Contexts.CompressContext, CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize, CompressDictionary);
+	}
+	else
+	{
+		Result = ZSTD_compressCCtx(Contexts.CompressContext, CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize, Level);
+	}
+
+	// running out of room is an expected failure, callers store uncompressed instead
+	if (ZSTD_isError(Result))
+	{
+		return false;
+	}
+	CompressedSize = int32(Result);
+	return true;
+}
+
+static bool appUncompressMemoryZstd(void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("Uncompress Memory Zstd"), STAT_appUncompressMemoryZstd, STATGROUP_Compression);
+
+	FZstdThreadContexts& Contexts = GZstdThreadContexts;
+	if (!Contexts.DecompressContext)
+	{
+		Contexts.DecompressContext = ZSTD_createDCtx();
+	}
+
+	size_t Result;
+	const uint32 DictionaryId = ZSTD_getDictID_fromFrame(CompressedBuffer, CompressedSize);
+	if (DictionaryId != 0)
+	{
+		const ZSTD_DDict* DecompressDictionary = FindZstdDecompressDictionary(DictionaryId);
+		if (!DecompressDictionary)
+		{
+			UE_LOG(LogCompression, Warning, TEXT("appUncompressMemoryZstd failed: Data was compressed with dictionary %u which is not registered"), DictionaryId);
+			return false;
+		}
+		Result = ZSTD_decompress_usingDDict(Contexts.DecompressContext, UncompressedBuffer, UncompressedSize, CompressedBuffer, CompressedSize, DecompressDictionary);
+	}
+	else
+	{
+		Result = ZSTD_decompressDCtx(Contexts.DecompressContext, UncompressedBuffer, UncompressedSize, CompressedBuffer, CompressedSize);
+	}
+
+	if (ZSTD_isError(Result))
+	{
+		UE_LOG(LogCompression, Warning, TEXT("appUncompressMemoryZstd failed: Error: %s"), ANSI_TO_TCHAR(ZSTD_getErrorName(Result)));
+		return false;
+	}
+
+	// Sanity check to make sure we uncompressed as much data as we expected to.
+	if (Result != size_t(UncompressedSize))
+	{
+		UE_LOG(LogCompression, Warning, TEXT("appUncompressMemoryZstd failed: Mismatched uncompressed size. Expected: %d, Got:%d"), UncompressedSize, int32(Result));
+		return false;
+	}
+	return true;
+}
+
+#endif // WITH_ZSTD
+
+uint32 FCompression::RegisterZstdDictionary(TArrayView<const uint8> DictionaryData)
+{
+#if WITH_ZSTD
+	const uint32 DictionaryId = ZDICT_getDictID(DictionaryData.GetData(), DictionaryData.Num());
+	if (DictionaryId == 0)
+	{
+		UE_LOG(LogCompression, Warning, TEXT("FCompression::RegisterZstdDictionary - Data is not a zstd dictionary"));
+		return 0;
+	}
+
+	FRWScopeLock Lock(GZstdDictionariesLock, SLT_Write);
+	FZstdDictionary*& Dictionary = GZstdDictionaries.FindOrAdd(DictionaryId);
+	if (!Dictionary)
+	{
+		Dictionary = new FZstdDictionary();
+		Dictionary->Data.Append(DictionaryData.GetData(), DictionaryData.Num());
+		Dictionary->DecompressDictionary = ZSTD_createDDict(Dictionary->Data.GetData(), Dictionary->Data.Num());
+	}
+	return DictionaryId;
+#else
+	return 0;
+#endif
+}
+
+bool FCompression::TrainZstdDictionary(TArrayView<const TArrayView<const uint8>> Samples, int32 MaxDictionarySize, TArray<uint8>& OutDictionary)
+{
+#if WITH_ZSTD
+	// the trainer wants all samples back to back
+	TArray<uint8> SamplesBuffer;
+	TArray<size_t> SampleSizes;
+	SampleSizes.Reserve(Samples.Num());
+	for (const TArrayView<const uint8>& Sample : Samples)
+	{
+		SamplesBuffer.Append(Sample.GetData(), Sample.Num());
+		SampleSizes.Add(Sample.Num());
+	}
+
+	OutDictionary.SetNumUninitialized(MaxDictionarySize);
+	const size_t Result = ZDICT_trainFromBuffer(OutDictionary.GetData(), OutDictionary.Num(), SamplesBuffer.GetData(), SampleSizes.GetData(), SampleSizes.Num());
+	if (ZDICT_isError(Result))
+	{
+		UE_LOG(LogCompression, Warning, TEXT("FCompression::TrainZstdDictionary - Training on %d samples failed: %s"), Samples.Num(), ANSI_TO_TCHAR(ZDICT_getErrorName(Result)));
+		OutDictionary.Reset();
+		return false;
+	}
+	OutDictionary.SetNum(int32(Result));
+	return true;
+#else
+	return false;
+#endif
+}
+
 /** Time spent compressing data in cycles. */
 TAtomic<uint64> FCompression::CompressorTimeCycles(0);
 /** Number of bytes before compression.		*/
@@ -416,6 +646,12 @@ uint32 FCompression::GetCompressorVersion(FName FormatName)
 	{
 		return appZLIBVersion();
 	}
+#if WITH_ZSTD
+	else if (FormatName == NAME_Zstd)
+	{
+		return uint32(ZSTD_versionNumber());
+	}
+#endif
 	else
 	{
 		// let the format module compress it
@@ -509,6 +745,12 @@ int32 FCompression::CompressMemoryBound(FName FormatName, int32 UncompressedSize
 		// hardcoded lz4
 		CompressionBound = LZ4_compressBound(UncompressedSize);
 	}
+#if WITH_ZSTD
+	else if (FormatName == NAME_Zstd)
+	{
+		CompressionBound = int32(ZSTD_compressBound(UncompressedSize));
+	}
+#endif
 	else
 	{
 		ICompressionFormat* Format = GetCompressionFormat(FormatName);
@@ -546,6 +788,13 @@ bool FCompression::CompressMemory(FName FormatName, void* CompressedBuffer, int3
 		CompressedSize = LZ4_compress_HC((const char*)UncompressedBuffer, (char*)CompressedBuffer, UncompressedSize, CompressedSize, LZ4HC_CLEVEL_MAX);
 		bCompressSucceeded = CompressedSize > 0;
 	}
+#if WITH_ZSTD
+	else if (FormatName == NAME_Zstd)
+	{
+		// hardcoded zstd, CompressionData is the zlib bit window for most callers so it is ignored, dictionaries go through CompressMemoryWithZstdDictionary
+		bCompressSucceeded = appCompressMemoryZstd(CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize, Flags, 0);
+	}
+#endif
 	else
 	{
 		// let the format module compress it
@@ -567,8 +816,30 @@ bool FCompression::CompressMemory(FName FormatName, void* CompressedBuffer, int3
 	return bCompressSucceeded;
 }
 
+bool FCompression::CompressMemoryWithZstdDictionary(uint32 DictionaryId, void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize, ECompressionFlags Flags)
+{
+#if WITH_ZSTD
+	uint64 CompressorStartTime = FPlatformTime::Cycles64();
+
+	Flags = CheckGlobalCompressionFlags(Flags);
+	const bool bCompressSucceeded = appCompressMemoryZstd(CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize, Flags, DictionaryId);
+
+	CompressorTimeCycles += FPlatformTime::Cycles64() - CompressorStartTime;
+	if (bCompressSucceeded)
+	{
+		CompressorSrcBytes += UncompressedSize;
+		CompressorDstBytes += CompressedSize;
+	}
+
+	return bCompressSucceeded;
+#else
+	return false;
+#endif
+}
+
 #define ZLIB_DERIVEDDATA_VER TEXT("9810EC9C5D34401CBD57AA3852417A6C")
 #define GZIP_DERIVEDDATA_VER TEXT("FB2181277DF44305ABBE03FD1751CBDE")
+#define ZSTD_DERIVEDDATA_VER TEXT("4C0D7F9E2B6A4E1F8A3D5C7B9E1F2A4D")
 
 
 FString FCompression::GetCompressorDDCSuffix(FName FormatName)
@@ -585,6 +856,10 @@ FString FCompression::GetCompressorDDCSuffix(FName FormatName)
 	{
 		DDCSuffix += GZIP_DERIVEDDATA_VER;
 	}
+	else if (FormatName == NAME_Zstd)
+	{
+		DDCSuffix += ZSTD_DERIVEDDATA_VER;
+	}
 	else
 	{
 		// let the format module compress it
@@ -623,6 +898,13 @@ bool FCompression::UncompressMemory(FName FormatName, void* UncompressedBuffer,
 		// hardcoded lz4
 		bUncompressSucceeded = LZ4_decompress_safe((const char*)CompressedBuffer, (char*)UncompressedBuffer, CompressedSize, UncompressedSize) > 0;
 	}
+#if WITH_ZSTD
+	else if (FormatName == NAME_Zstd)
+	{
+		// hardcoded zstd, the dictionary id comes from the frame
+		bUncompressSucceeded = appUncompressMemoryZstd(UncompressedBuffer, UncompressedSize, CompressedBuffer, CompressedSize);
+	}
+#endif
 	else
 	{
 		// let the format module compress it
@@ -881,6 +1163,12 @@ bool FCompression::IsFormatValid(FName FormatName)
 	{
 		return true;
 	}
+#if WITH_ZSTD
+	if (FormatName == NAME_Zstd)
+	{
+		return true;
+	}
+#endif
 
 	// otherwise, if we can get the format class, we are good!
 	return GetCompressionFormat(FormatName, false) != nullptr;
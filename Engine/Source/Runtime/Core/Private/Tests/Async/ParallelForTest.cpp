@@ -0,0 +1,169 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/ThreadHeartBeat.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Async/ParallelFor.h"
+#include <atomic>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ParallelForTest
+{
+	/** Burns roughly Work units of CPU without touching memory, the result only keeps the optimizer away */
+	static FORCENOINLINE uint32 DoWork(int32 Work)
+	{
+		uint32 Hash = uint32(Work);
+		for (int32 Index = 0; Index < Work * 64; Index++)
+		{
+			Hash = Hash * 0x9E3779B1u + 0x7F4A7C15u;
+		}
+		return Hash;
+	}
+
+	/** Cost of each index of a synthetic workload */
+	struct FWorkload
+	{
+		const TCHAR* Name;
+		TArray<int32> Costs;
+	};
+
+	static TArray<FWorkload> MakeWorkloads(int32 Num)
+	{
+		FRandomStream Random(1234);
+		TArray<FWorkload> Workloads;
+
+		FWorkload& Uniform = Workloads.Add_GetRef({ TEXT("uniform") });
+		Uniform.Costs.Init(4, Num);
+
+		// most primitives are trivially culled, a few need the expensive test
+		FWorkload& Sparse = Workloads.Add_GetRef({ TEXT("1% 100x") });
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			Sparse.Costs.Add(Random.FRand() < 0.01f ? 400 : 4);
+		}
+
+		// everything expensive sits in one block, the worst case for fixed blocks
+		FWorkload& Clustered = Workloads.Add_GetRef({ TEXT("clustered") });
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			Clustered.Costs.Add(Index >= Num - Num / 16 ? 400 : 4);
+		}
+
+		FWorkload& Ramp = Workloads.Add_GetRef({ TEXT("ramp") });
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			Ramp.Costs.Add(1 + Index * 200 / Num);
+		}
+
+		return Workloads;
+	}
+
+	template<typename FunctionType>
+	static double Time(int32 NumRuns, FunctionType&& Function)
+	{
+		double MinTime = MAX_dbl;
+		for (int32 Run = 0; Run < NumRuns; Run++)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Function();
+			MinTime = FMath::Min(MinTime, FPlatformTime::Seconds() - StartTime);
+		}
+		return MinTime;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelForAdaptiveTest, "System.Core.Async.ParallelFor.Adaptive", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FParallelForAdaptiveTest::RunTest(const FString& Parameters)
+{
+	const int32 Nums[] = { 0, 1, 2, 7, 64, 1000, 100000 };
+	const int32 MinBatchSizes[] = { 1, 3, 64 };
+	for (int32 Num : Nums)
+	{
+		for (int32 MinBatchSize : MinBatchSizes)
+		{
+			TArray<std::atomic<int32>> Visits;
+			Visits.SetNum(Num);
+			for (std::atomic<int32>& Visit : Visits)
+			{
+				Visit = 0;
+			}
+
+			ParallelForAdaptive(Num, [&Visits](int32 Index) { Visits[Index]++; }, MinBatchSize);
+			ParallelForAdaptiveWithCost(Num, [&Visits](int32 Index) { Visits[Index]++; }, [](int32 Index) { return Index % 13 == 0 ? 100.0f : 1.0f; }, MinBatchSize);
+
+			int32 NumWrong = 0;
+			for (const std::atomic<int32>& Visit : Visits)
+			{
+				NumWrong += Visit != 2;
+			}
+			TestEqual(FString::Printf(TEXT("Indices not visited exactly once, Num %d, MinBatchSize %d"), Num, MinBatchSize), NumWrong, 0);
+		}
+	}
+
+	// nested loops must complete even when every worker is busy with the outer one
+	{
+		const int32 NumOuter = 64;
+		const int32 NumInner = 1000;
+		std::atomic<int32> NumVisits{ 0 };
+		ParallelForAdaptive(NumOuter, [&NumVisits](int32)
+		{
+			ParallelForAdaptive(NumInner, [&NumVisits](int32)
+			{
+				ParallelFor(4, [&NumVisits](int32) { NumVisits++; });
+			}, 16);
+		});
+		TestEqual(TEXT("Nested visits"), NumVisits.load(), NumOuter * NumInner * 4);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelForBenchmark, "System.Core.Async.ParallelFor.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+/** ParallelFor flavors on synthetic workloads with skewed per index cost */
+bool FParallelForBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace ParallelForTest;
+
+	FSlowHeartBeatScope SuspendHeartBeat;
+
+	const int32 Num = 50000;
+	const int32 NumRuns = 5;
+	std::atomic<uint32> Sink{ 0 };
+
+	for (const FWorkload& Workload : MakeWorkloads(Num))
+	{
+		const TArray<int32>& Costs = Workload.Costs;
+		auto Body = [&Costs, &Sink](int32 Index) { Sink += DoWork(Costs[Index]); };
+		auto EstimateCost = [&Costs](int32 Index) { return float(Costs[Index]); };
+
+		const double Serial = Time(NumRuns, [&] { ParallelFor(Num, Body, EParallelForFlags::ForceSingleThread); });
+		const double Blocks = Time(NumRuns, [&] { ParallelFor(Num, Body); });
+		const double Unbalanced = Time(NumRuns, [&] { ParallelFor(Num, Body, EParallelForFlags::Unbalanced); });
+		const double Adaptive = Time(NumRuns, [&] { ParallelForAdaptive(Num, Body); });
+		const double AdaptiveBatch = Time(NumRuns, [&] { ParallelForAdaptive(Num, Body, 32); });
+		const double AdaptiveCost = Time(NumRuns, [&] { ParallelForAdaptiveWithCost(Num, Body, EstimateCost, 32); });
+
+		AddInfo(FString::Printf(TEXT("%-10s serial %7.2fms, blocks %5.2fx, unbalanced %5.2fx, adaptive %5.2fx, adaptive batch 32 %5.2fx, adaptive cost %5.2fx"),
+			Workload.Name, Serial * 1000.0, Serial / Blocks, Serial / Unbalanced, Serial / Adaptive, Serial / AdaptiveBatch, Serial / AdaptiveCost));
+	}
+
+	// inner loops too small to be worth spreading out on their own, nested in an outer one
+	{
+		const int32 NumOuter = 256;
+		const int32 NumInner = 256;
+		auto Inner = [&Sink](int32 Index) { Sink += DoWork(Index % 64 == 0 ? 200 : 2); };
+		const double Serial = Time(NumRuns, [&] { for (int32 Outer = 0; Outer < NumOuter; Outer++) { ParallelFor(NumInner, Inner, EParallelForFlags::ForceSingleThread); } });
+		const double Blocks = Time(NumRuns, [&] { ParallelFor(NumOuter, [&](int32) { ParallelFor(NumInner, Inner); }); });
+		const double Adaptive = Time(NumRuns, [&] { ParallelForAdaptive(NumOuter, [&](int32) { ParallelForAdaptive(NumInner, Inner, 8); }); });
+		AddInfo(FString::Printf(TEXT("%-10s serial %7.2fms, blocks %5.2fx, adaptive %5.2fx"), TEXT("nested"), Serial * 1000.0, Serial / Blocks, Serial / Adaptive));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "CoreGlobals.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/ThreadHeartBeat.h"
+#include "Misc/AutomationTest.h"
+#include "Async/TaskGraphInterfaces.h"
+#include <atomic>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace TaskGraphWorkStealingTest
+{
+	/** Each task spawns two children until Depth reaches zero, the shape ParallelFor and recursive culling produce */
+	static FGraphEventRef SpawnTree(int32 Depth, std::atomic<int32>& NumExecuted)
+	{
+		return FFunctionGraphTask::CreateAndDispatchWhenReady(
+			[Depth, &NumExecuted](ENamedThreads::Type, const FGraphEventRef& CompletionEvent)
+			{
+				NumExecuted.fetch_add(1, std::memory_order_relaxed);
+				if (Depth > 0)
+				{
+					CompletionEvent->DontCompleteUntil(SpawnTree(Depth - 1, NumExecuted));
+					CompletionEvent->DontCompleteUntil(SpawnTree(Depth - 1, NumExecuted));
+				}
+			});
+	}
+
+	static void SetNumWorkerThreadsToIgnore(int32 Num)
+	{
+		IConsoleManager::Get().ProcessUserConsoleInput(*FString::Printf(TEXT("TaskGraph.NumWorkerThreadsToIgnore %d"), Num), *GLog, nullptr);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTaskGraphWorkStealingScalingTest, "System.Core.Async.TaskGraph.WorkStealingScaling", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+/**
+ * Spawn/complete throughput of fine grained tasks with the shared incoming queues and with TaskGraph.WorkStealing,
+ * for 1 to 64 workers. Workers are taken out with TaskGraph.NumWorkerThreadsToIgnore, so the largest count is what
+ * the platform spawns.
+ */
+bool FTaskGraphWorkStealingScalingTest::RunTest(const FString& Parameters)
+{
+	using namespace TaskGraphWorkStealingTest;
+
+	if (!FTaskGraphInterface::IsMultithread())
+	{
+		AddInfo(TEXT("Task graph is not multithreaded"));
+		return true;
+	}
+
+	IConsoleVariable* WorkStealingVar = IConsoleManager::Get().FindConsoleVariable(TEXT("TaskGraph.WorkStealing"));
+	if (!TestNotNull(TEXT("TaskGraph.WorkStealing"), WorkStealingVar))
+	{
+		return false;
+	}
+	const int32 OldWorkStealing = WorkStealingVar->GetInt();
+
+	FSlowHeartBeatScope SuspendHeartBeat;
+
+	const int32 Depth = 16;
+	const int32 NumTasks = (2 << Depth) - 1;
+	const int32 NumRuns = 3;
+	const int32 MaxWorkers = FTaskGraphInterface::Get().GetNumWorkerThreads();
+
+	TArray<int32> WorkerCounts;
+	for (int32 NumWorkers = 1; NumWorkers < MaxWorkers && NumWorkers <= 64; NumWorkers *= 2)
+	{
+		WorkerCounts.Add(NumWorkers);
+	}
+	WorkerCounts.Add(FMath::Min(MaxWorkers, 64));
+
+	for (int32 NumWorkers : WorkerCounts)
+	{
+		SetNumWorkerThreadsToIgnore(MaxWorkers - NumWorkers);
+
+		double TasksPerSecond[2] = {};
+		for (int32 WorkStealing = 0; WorkStealing < 2; WorkStealing++)
+		{
+			WorkStealingVar->Set(WorkStealing, ECVF_SetByCode);
+
+			double MinTime = MAX_dbl;
+			for (int32 Run = 0; Run < NumRuns; Run++)
+			{
+				std::atomic<int32> NumExecuted{ 0 };
+				const double StartTime = FPlatformTime::Seconds();
+				SpawnTree(Depth, NumExecuted)->Wait(ENamedThreads::GameThread);
+				MinTime = FMath::Min(MinTime, FPlatformTime::Seconds() - StartTime);
+
+				TestEqual(FString::Printf(TEXT("Executed tasks, %d workers, work stealing %d"), NumWorkers, WorkStealing), NumExecuted.load(), NumTasks);
+			}
+			TasksPerSecond[WorkStealing] = double(NumTasks) / MinTime;
+		}
+
+		AddInfo(FString::Printf(TEXT("%2d workers: shared queues %6.2f Mtasks/s, work stealing %6.2f Mtasks/s (%.2fx)"),
+			NumWorkers, TasksPerSecond[0] / 1e6, TasksPerSecond[1] / 1e6, TasksPerSecond[1] / TasksPerSecond[0]));
+	}
+
+	SetNumWorkerThreadsToIgnore(0);
+	WorkStealingVar->Set(OldWorkStealing, ECVF_SetByCode);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,233 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Containers/Map.h"
+#include "Containers/RobinHoodHashTable.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/ThreadHeartBeat.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RobinHoodHashTableTest
+{
+	template<typename FunctionType>
+	static double Time(int32 NumRuns, FunctionType&& Function)
+	{
+		double MinTime = MAX_dbl;
+		for (int32 Run = 0; Run < NumRuns; Run++)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Function();
+			MinTime = FMath::Min(MinTime, FPlatformTime::Seconds() - StartTime);
+		}
+		return MinTime;
+	}
+
+	/** Keys spread like component ids and pointers, every other key of Keys is looked up but never added */
+	static TArray<uint32> MakeKeys(int32 Num)
+	{
+		FRandomStream Random(1234);
+		TArray<uint32> Keys;
+		Keys.Reserve(Num);
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			Keys.Add(Index % 2 ? uint32(Random.GetUnsignedInt()) | 1u : uint32(Index) << 4);
+		}
+		return Keys;
+	}
+
+	/** Insert, find and miss, iterate and remove on any map with the TMap interface, returns seconds per phase */
+	template<typename MapType>
+	static void Benchmark(const TArray<uint32>& Keys, int32 NumRuns, double OutSeconds[5], uint64& Sink)
+	{
+		MapType Map;
+		OutSeconds[0] = Time(NumRuns, [&]()
+		{
+			Map.Reset();
+			for (int32 Index = 0; Index < Keys.Num(); Index += 2)
+			{
+				Map.Add(Keys[Index], Index);
+			}
+		});
+
+		OutSeconds[1] = Time(NumRuns, [&]()
+		{
+			for (int32 Index = 0; Index < Keys.Num(); Index += 2)
+			{
+				Sink += *Map.Find(Keys[Index]);
+			}
+		});
+
+		OutSeconds[2] = Time(NumRuns, [&]()
+		{
+			for (int32 Index = 1; Index < Keys.Num(); Index += 2)
+			{
+				Sink += Map.Find(Keys[Index]) != nullptr;
+			}
+		});
+
+		OutSeconds[3] = Time(NumRuns, [&]()
+		{
+			for (const auto& Pair : Map)
+			{
+				Sink += Pair.Value;
+			}
+		});
+
+		OutSeconds[4] = Time(NumRuns, [&]()
+		{
+			MapType Copy = Map;
+			for (int32 Index = 0; Index < Keys.Num(); Index += 2)
+			{
+				Sink += Copy.Remove(Keys[Index]);
+			}
+		});
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRobinHoodHashTableTest, "System.Core.Containers.RobinHoodHashTable", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FRobinHoodHashTableTest::RunTest(const FString& Parameters)
+{
+	// Random operations against a TMap with the same contents, few keys stress removal and reuse of element ids
+	const int32 NumKeys[] = { 1, 16, 1000, 50000 };
+	for (int32 NumKey : NumKeys)
+	{
+		FRandomStream Random(NumKey);
+		TRobinHoodMap<int32, FString> Map;
+		TMap<int32, FString> Expected;
+		int32 NumWrong = 0;
+
+		for (int32 Step = 0; Step < 100000; Step++)
+		{
+			const int32 Key = Random.RandHelper(NumKey);
+			switch (Random.RandHelper(4))
+			{
+			case 0:		Map.Add(Key, FString::FromInt(Step)); Expected.Add(Key, FString::FromInt(Step));	break;
+			case 1:		NumWrong += Map.Remove(Key) != Expected.Remove(Key);								break;
+			case 2:		Map.FindOrAdd(Key); Expected.FindOrAdd(Key);										break;
+			default:	NumWrong += Map.FindRef(Key) != Expected.FindRef(Key);								break;
+			}
+
+			if (Step % 25000 == 0)
+			{
+				Map.Shrink();
+			}
+		}
+
+		NumWrong += Map.Num() != Expected.Num();
+		for (const TPair<const int32, FString>& Pair : Map)
+		{
+			const FString* Value = Expected.Find(Pair.Key);
+			NumWrong += !Value || *Value != Pair.Value;
+		}
+		TestEqual(FString::Printf(TEXT("Pairs differing from TMap, %d keys"), NumKey), NumWrong, 0);
+
+		// Copies and the TMap serialization format
+		TRobinHoodMap<int32, FString> Copy = Map;
+		TestTrue(TEXT("Copy"), Copy.Num() == Map.Num() && Copy.OrderIndependentCompareEqual(Map));
+
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		Writer << Map;
+		TMap<int32, FString> Loaded;
+		FMemoryReader Reader(Bytes);
+		Reader << Loaded;
+		TestTrue(TEXT("Loaded as TMap"), Loaded.OrderIndependentCompareEqual(Expected));
+
+		// Removing while iterating
+		for (TRobinHoodMap<int32, FString>::TIterator It = Copy.CreateIterator(); It; ++It)
+		{
+			if (It.Key() % 2)
+			{
+				It.RemoveCurrent();
+			}
+		}
+		int32 NumOdd = 0;
+		for (const TPair<const int32, FString>& Pair : Copy)
+		{
+			NumOdd += Pair.Key % 2;
+		}
+		TestEqual(TEXT("Odd keys after RemoveCurrent"), NumOdd, 0);
+	}
+
+	// Element ids stay valid until removed
+	{
+		TRobinHoodSet<FString> Set;
+		TArray<FRobinHoodElementId> Ids;
+		for (int32 Index = 0; Index < 1000; Index++)
+		{
+			Ids.Add(Set.FindOrAddId(FString::FromInt(Index)));
+		}
+		for (int32 Index = 0; Index < 1000; Index += 3)
+		{
+			Set.RemoveByElementId(Ids[Index]);
+		}
+
+		int32 NumWrong = 0;
+		for (int32 Index = 0; Index < 1000; Index++)
+		{
+			if (Index % 3)
+			{
+				NumWrong += Set.FindId(FString::FromInt(Index)) != Ids[Index] || Set.GetByElementId(Ids[Index]) != FString::FromInt(Index);
+			}
+			else
+			{
+				NumWrong += Set.Contains(FString::FromInt(Index));
+			}
+		}
+		TestEqual(TEXT("Stale element ids"), NumWrong, 0);
+
+		bool bIsAlreadyInSet = false;
+		Set.Add(TEXT("1"), &bIsAlreadyInSet);
+		TestTrue(TEXT("Add existing"), bIsAlreadyInSet);
+		Set.Add(TEXT("0"), &bIsAlreadyInSet);
+		TestFalse(TEXT("Add removed"), bIsAlreadyInSet);
+
+		Set.Reset();
+		TestTrue(TEXT("Reset"), Set.Num() == 0 && !Set.Contains(TEXT("1")));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRobinHoodHashTableBenchmark, "System.Core.Containers.RobinHoodHashTable.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+/** Insert, find, miss, iterate and remove of uint32 keys compared to TMap, from cache resident to far larger than the caches */
+bool FRobinHoodHashTableBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace RobinHoodHashTableTest;
+
+	FSlowHeartBeatScope SuspendHeartBeat;
+
+	const int32 Nums[] = { 64, 4096, 1 << 18, 1 << 22 };
+	uint64 Sink = 0;
+	for (int32 Num : Nums)
+	{
+		const TArray<uint32> Keys = MakeKeys(Num * 2);
+		const int32 NumRuns = FMath::Max(3, (1 << 20) / Num);
+
+		double MapSeconds[5];
+		double RobinHoodSeconds[5];
+		Benchmark<TMap<uint32, int32>>(Keys, NumRuns, MapSeconds, Sink);
+		Benchmark<TRobinHoodMap<uint32, int32>>(Keys, NumRuns, RobinHoodSeconds, Sink);
+
+		const TCHAR* Phases[] = { TEXT("insert"), TEXT("find"), TEXT("miss"), TEXT("iterate"), TEXT("copy+remove") };
+		FString Info = FString::Printf(TEXT("%8d keys:"), Num);
+		for (uint32 Phase = 0; Phase < UE_ARRAY_COUNT(Phases); Phase++)
+		{
+			Info += FString::Printf(TEXT(" %s %6.2fns vs TMap %6.2fns (%.2fx)"), Phases[Phase],
+				RobinHoodSeconds[Phase] * 1e9 / Num, MapSeconds[Phase] * 1e9 / Num, MapSeconds[Phase] / RobinHoodSeconds[Phase]);
+		}
+		AddInfo(Info);
+	}
+
+	TestNotEqual(TEXT("Sink"), Sink, uint64(0));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,186 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "GenericPlatform/GenericPlatformIoDispatcher.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && PLATFORM_LINUX
+
+#include "Linux/LinuxPlatformIoDispatcher.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace FileIoStoreReadBenchmark
+{
+	static constexpr uint64 FileSize = 256ull << 20;
+	static constexpr uint64 ReadSize = 256ull << 10;
+	static constexpr uint64 PageSize = 4096;
+
+	static uint64 PatternAt(uint64 Offset)
+	{
+		return (Offset + 1) * 0x9E3779B97F4A7C15ull;
+	}
+
+	static bool WriteTestFile(const FString& Filename)
+	{
+		const int32 Fd = open(TCHAR_TO_UTF8(*Filename), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		if (Fd < 0)
+		{
+			return false;
+		}
+
+		TArray<uint64> Chunk;
+		Chunk.SetNumUninitialized(ReadSize / sizeof(uint64));
+		bool bSuccess = true;
+		for (uint64 ChunkOffset = 0; bSuccess && ChunkOffset < FileSize; ChunkOffset += ReadSize)
+		{
+			for (int32 Index = 0; Index < Chunk.Num(); ++Index)
+			{
+				Chunk[Index] = PatternAt(ChunkOffset + Index * sizeof(uint64));
+			}
+			bSuccess = write(Fd, Chunk.GetData(), ReadSize) == ssize_t(ReadSize);
+		}
+
+		// dirty pages can't be dropped, make sure everything hits the disk before timing reads
+		bSuccess = bSuccess && fsync(Fd) == 0;
+		close(Fd);
+		return bSuccess;
+	}
+
+	template <typename ImplType>
+	static void ReadTestFile(FAutomationTestBase& Test, const TCHAR* Name, ImplType& Impl, FGenericIoDispatcherEventQueue& EventQueue, FFileIoStoreBufferAllocator& BufferAllocator, const FString& Filename)
+	{
+		uint64 FileHandle = 0;
+		uint64 ContainerFileSize = 0;
+		if (!Impl.OpenContainer(*Filename, FileHandle, ContainerFileSize))
+		{
+			Test.AddError(FString::Printf(TEXT("%s: failed opening %s"), Name, *Filename));
+			return;
+		}
+		Test.TestEqual(FString::Printf(TEXT("%s: file size"), Name), ContainerFileSize, FileSize);
+
+		// cold page cache, otherwise we only measure memcpy
+		const int32 AdviseFd = open(TCHAR_TO_UTF8(*Filename), O_RDONLY | O_CLOEXEC);
+		if (AdviseFd >= 0)
+		{
+			posix_fadvise(AdviseFd, 0, 0, POSIX_FADV_DONTNEED);
+			close(AdviseFd);
+		}
+
+		FFileIoStoreRequestQueue RequestQueue;
+		const uint64 NumRequests = FileSize / ReadSize;
+		for (uint64 RequestIndex = 0; RequestIndex < NumRequests; ++RequestIndex)
+		{
+			FFileIoStoreReadRequest* Request = new FFileIoStoreReadRequest();
+			Request->FileHandle = FileHandle;
+			Request->Offset = RequestIndex * ReadSize;
+			Request->Size = ReadSize;
+			RequestQueue.Push(*Request);
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		uint64 NumCompleted = 0;
+		uint64 NumFailed = 0;
+		uint64 NumCorrupt = 0;
+		while (NumCompleted < NumRequests)
+		{
+			while (Impl.StartRequests(RequestQueue));
+
+			FFileIoStoreReadRequestList CompletedRequests;
+			Impl.GetCompletedRequests(CompletedRequests);
+			if (CompletedRequests.IsEmpty())
+			{
+				EventQueue.DispatcherWait();
+				continue;
+			}
+
+			FFileIoStoreReadRequest* Request = CompletedRequests.GetHead();
+			while (Request)
+			{
+				FFileIoStoreReadRequest* NextRequest = Request->Next;
+				if (Request->bFailed)
+				{
+					++NumFailed;
+				}
+				else
+				{
+					// spot check one word per page
+					for (uint64 PageOffset = 0; PageOffset < Request->Size; PageOffset += PageSize)
+					{
+						if (*reinterpret_cast<const uint64*>(Request->Buffer->Memory + PageOffset) != PatternAt(Request->Offset + PageOffset))
+						{
+							++NumCorrupt;
+							break;
+						}
+					}
+				}
+				BufferAllocator.FreeBuffer(Request->Buffer);
+				delete Request;
+				++NumCompleted;
+				Request = NextRequest;
+			}
+		}
+		const double Duration = FPlatformTime::Seconds() - StartTime;
+
+		Test.TestEqual(FString::Printf(TEXT("%s: failed reads"), Name), NumFailed, uint64(0));
+		Test.TestEqual(FString::Printf(TEXT("%s: corrupt reads"), Name), NumCorrupt, uint64(0));
+		Test.AddInfo(FString::Printf(TEXT("%s: %.1f MB/s (%.3f s)"), Name, double(FileSize) / (1024.0 * 1024.0) / Duration, Duration));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFileIoStoreReadBenchmark, "System.Core.IO.FileIoStoreReadBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FFileIoStoreReadBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace FileIoStoreReadBenchmark;
+
+	const FString Filename = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("FileIoStoreReadBenchmark.bin"));
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Filename), true);
+	if (!WriteTestFile(Filename))
+	{
+		AddError(FString::Printf(TEXT("Failed writing %s"), *Filename));
+		return false;
+	}
+
+	// the allocator never frees its memory, share one between runs
+	static FFileIoStoreBufferAllocator BufferAllocator;
+	static bool bBufferAllocatorInitialized = false;
+	if (!bBufferAllocatorInitialized)
+	{
+		BufferAllocator.Initialize(16 << 20, ReadSize, PageSize);
+		bBufferAllocatorInitialized = true;
+	}
+	FFileIoStoreBlockCache BlockCache;
+	FGenericIoDispatcherEventQueue EventQueue;
+
+	{
+		FGenericFileIoStoreImpl Impl(EventQueue, BufferAllocator, BlockCache);
+		ReadTestFile(*this, TEXT("Generic"), Impl, EventQueue, BufferAllocator, Filename);
+	}
+
+	{
+		FLinuxFileIoStoreImpl Impl(EventQueue, BufferAllocator, BlockCache, ELinuxFileIoStoreBackend::ReadThreads);
+		ReadTestFile(*this, TEXT("ReadThreads"), Impl, EventQueue, BufferAllocator, Filename);
+	}
+
+	{
+		FLinuxFileIoStoreImpl Impl(EventQueue, BufferAllocator, BlockCache, ELinuxFileIoStoreBackend::IoUring);
+		if (Impl.IsUsingIoUring())
+		{
+			ReadTestFile(*this, TEXT("IoUring"), Impl, EventQueue, BufferAllocator, Filename);
+		}
+		else
+		{
+			AddInfo(TEXT("IoUring: not available"));
+		}
+	}
+
+	IFileManager::Get().Delete(*Filename);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && PLATFORM_LINUX
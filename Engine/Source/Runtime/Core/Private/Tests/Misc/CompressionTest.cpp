@@ -0,0 +1,263 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace CompressionTest
+{
+	/** Compresses like IoStore does, in independent blocks */
+	static constexpr int32 BlockSize = 64 << 10;
+
+	/** Text with a small vocabulary, compresses well and gives dictionaries something to learn */
+	static TArray<uint8> MakeTestData(int32 Size, int32 Seed)
+	{
+		static const ANSICHAR* Words[] = { "Actor", "Component", "Transform", "Material", "Texture", "StaticMesh", "Location", "Rotation", "Scale", "None", "/Game/", "Default__" };
+		FRandomStream Random(Seed);
+		TArray<uint8> Data;
+		Data.Reserve(Size);
+		while (Data.Num() < Size)
+		{
+			const ANSICHAR* Word = Words[Random.RandRange(0, UE_ARRAY_COUNT(Words) - 1)];
+			Data.Append(reinterpret_cast<const uint8*>(Word), FCStringAnsi::Strlen(Word));
+			Data.Add(uint8(Random.RandRange(0, 255)));
+		}
+		Data.SetNum(Size);
+		return Data;
+	}
+
+	static bool Compress(FName Format, void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize, ECompressionFlags Flags, int32 CompressionData, uint32 DictionaryId)
+	{
+		return DictionaryId != 0
+			? FCompression::CompressMemoryWithZstdDictionary(DictionaryId, CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize, Flags)
+			: FCompression::CompressMemory(Format, CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize, Flags, CompressionData);
+	}
+
+	static bool RoundTrip(FAutomationTestBase& Test, const TCHAR* What, FName Format, const TArray<uint8>& Data, ECompressionFlags Flags = COMPRESS_NoFlags, int32 CompressionData = 0, uint32 DictionaryId = 0)
+	{
+		int32 CompressedSize = FCompression::CompressMemoryBound(Format, Data.Num(), Flags, CompressionData);
+		TArray<uint8> Compressed;
+		Compressed.SetNumUninitialized(CompressedSize);
+		if (!Test.TestTrue(FString::Printf(TEXT("%s compress"), What), Compress(Format, Compressed.GetData(), CompressedSize, Data.GetData(), Data.Num(), Flags, CompressionData, DictionaryId)))
+		{
+			return false;
+		}
+
+		TArray<uint8> Uncompressed;
+		Uncompressed.SetNumUninitialized(Data.Num());
+		const bool bUncompressed = FCompression::UncompressMemory(Format, Uncompressed.GetData(), Uncompressed.Num(), Compressed.GetData(), CompressedSize);
+		return Test.TestTrue(FString::Printf(TEXT("%s uncompress"), What), bUncompressed && Uncompressed == Data);
+	}
+
+	struct FBenchmarkResult
+	{
+		int64 UncompressedSize = 0;
+		int64 CompressedSize = 0;
+		double CompressSeconds = 0.0;
+		double UncompressSeconds = 0.0;
+	};
+
+	static FBenchmarkResult Benchmark(FName Format, const TArray<TArrayView<const uint8>>& Blocks, ECompressionFlags Flags, uint32 DictionaryId)
+	{
+		FBenchmarkResult Result;
+		TArray<TArray<uint8>> CompressedBlocks;
+		CompressedBlocks.SetNum(Blocks.Num());
+
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 BlockIndex = 0; BlockIndex < Blocks.Num(); ++BlockIndex)
+		{
+			const TArrayView<const uint8>& Block = Blocks[BlockIndex];
+			TArray<uint8>& Compressed = CompressedBlocks[BlockIndex];
+			int32 CompressedSize = FCompression::CompressMemoryBound(Format, Block.Num(), Flags);
+			Compressed.SetNumUninitialized(CompressedSize);
+			if (Compress(Format, Compressed.GetData(), CompressedSize, Block.GetData(), Block.Num(), Flags, 0, DictionaryId) && CompressedSize < Block.Num())
+			{
+				Compressed.SetNum(CompressedSize, false);
+			}
+			else
+			{
+				// stored uncompressed, same as IoStore
+				Compressed.Reset();
+			}
+		}
+		Result.CompressSeconds = FPlatformTime::Seconds() - StartTime;
+
+		TArray<uint8> Uncompressed;
+		Uncompressed.SetNumUninitialized(BlockSize);
+		StartTime = FPlatformTime::Seconds();
+		for (int32 BlockIndex = 0; BlockIndex < Blocks.Num(); ++BlockIndex)
+		{
+			const TArray<uint8>& Compressed = CompressedBlocks[BlockIndex];
+			if (Compressed.Num() > 0)
+			{
+				FCompression::UncompressMemory(Format, Uncompressed.GetData(), Blocks[BlockIndex].Num(), Compressed.GetData(), Compressed.Num());
+			}
+		}
+		Result.UncompressSeconds = FPlatformTime::Seconds() - StartTime;
+
+		for (int32 BlockIndex = 0; BlockIndex < Blocks.Num(); ++BlockIndex)
+		{
+			Result.UncompressedSize += Blocks[BlockIndex].Num();
+			Result.CompressedSize += CompressedBlocks[BlockIndex].Num() > 0 ? CompressedBlocks[BlockIndex].Num() : Blocks[BlockIndex].Num();
+		}
+		return Result;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCompressionZstdTest, "System.Core.Misc.Compression.Zstd", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FCompressionZstdTest::RunTest(const FString& Parameters)
+{
+	using namespace CompressionTest;
+
+	if (!FCompression::IsFormatValid(NAME_Zstd))
+	{
+		AddInfo(TEXT("Zstd is not available on this platform"));
+		return true;
+	}
+
+	const TArray<uint8> Data = MakeTestData(BlockSize, 1);
+	RoundTrip(*this, TEXT("Zstd"), NAME_Zstd, Data);
+	RoundTrip(*this, TEXT("Zstd bias speed"), NAME_Zstd, Data, COMPRESS_BiasSpeed);
+	RoundTrip(*this, TEXT("Zstd bias memory"), NAME_Zstd, Data, COMPRESS_BiasMemory);
+	// archive paths pass the zlib bit window for every format
+	RoundTrip(*this, TEXT("Zstd zlib bit window"), NAME_Zstd, Data, COMPRESS_NoFlags, DEFAULT_ZLIB_BIT_WINDOW);
+
+	// a buffer that is too small must fail, not overrun
+	{
+		int32 CompressedSize = 16;
+		TArray<uint8> Compressed;
+		Compressed.SetNumUninitialized(CompressedSize);
+		TestFalse(TEXT("Zstd compress into small buffer"), FCompression::CompressMemory(NAME_Zstd, Compressed.GetData(), CompressedSize, Data.GetData(), Data.Num()));
+	}
+
+	// dictionaries are found again from the id stored in the frame
+	{
+		TArray<TArray<uint8>> SampleData;
+		TArray<TArrayView<const uint8>> Samples;
+		for (int32 SampleIndex = 0; SampleIndex < 256; ++SampleIndex)
+		{
+			SampleData.Add(MakeTestData(1024, 100 + SampleIndex));
+		}
+		for (const TArray<uint8>& Sample : SampleData)
+		{
+			Samples.Add(Sample);
+		}
+
+		TArray<uint8> Dictionary;
+		if (TestTrue(TEXT("Zstd train dictionary"), FCompression::TrainZstdDictionary(Samples, 16 << 10, Dictionary)))
+		{
+			const uint32 DictionaryId = FCompression::RegisterZstdDictionary(Dictionary);
+			TestNotEqual(TEXT("Zstd dictionary id"), DictionaryId, 0u);
+			TestEqual(TEXT("Zstd register dictionary twice"), FCompression::RegisterZstdDictionary(Dictionary), DictionaryId);
+			RoundTrip(*this, TEXT("Zstd dictionary"), NAME_Zstd, MakeTestData(1024, 3), COMPRESS_NoFlags, 0, DictionaryId);
+		}
+
+		const uint8 NotADictionary[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+		AddExpectedError(TEXT("Data is not a zstd dictionary"), EAutomationExpectedErrorFlags::Contains, 1);
+		TestEqual(TEXT("Zstd reject bad dictionary"), FCompression::RegisterZstdDictionary(NotADictionary), 0u);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCompressionBenchmark, "System.Core.Misc.Compression.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+/**
+ * Ratio and speed of the built in formats on cooked content, in 64KB blocks like IoStore.
+ * Parameters can name a directory, otherwise the project cooked directory is used.
+ */
+bool FCompressionBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace CompressionTest;
+
+	const FString ContentDir = Parameters.Len() > 0 ? Parameters : FPaths::ProjectSavedDir() / TEXT("Cooked");
+	const int64 MaxContentSize = 256 << 20;
+
+	TArray<FString> Filenames;
+	IFileManager::Get().FindFilesRecursive(Filenames, *ContentDir, TEXT("*.*"), true, false);
+	Filenames.Sort();
+
+	TArray<TArray<uint8>> Files;
+	int64 ContentSize = 0;
+	for (const FString& Filename : Filenames)
+	{
+		if (ContentSize >= MaxContentSize)
+		{
+			break;
+		}
+		TArray<uint8>& File = Files.AddDefaulted_GetRef();
+		if (FFileHelper::LoadFileToArray(File, *Filename, FILEREAD_Silent))
+		{
+			ContentSize += File.Num();
+		}
+	}
+
+	TArray<TArrayView<const uint8>> Blocks;
+	for (const TArray<uint8>& File : Files)
+	{
+		for (int32 Offset = 0; Offset < File.Num(); Offset += BlockSize)
+		{
+			Blocks.Add(MakeArrayView(File.GetData() + Offset, FMath::Min(BlockSize, File.Num() - Offset)));
+		}
+	}
+
+	if (Blocks.Num() == 0)
+	{
+		AddInfo(FString::Printf(TEXT("No cooked content in '%s', pass a directory as parameter"), *ContentDir));
+		return true;
+	}
+	AddInfo(FString::Printf(TEXT("%d files, %.1f MB from '%s'"), Files.Num(), double(ContentSize) / (1024.0 * 1024.0), *ContentDir));
+
+	struct FCase
+	{
+		const TCHAR* Name;
+		FName Format;
+		ECompressionFlags Flags;
+		uint32 DictionaryId;
+	};
+	TArray<FCase> Cases;
+	Cases.Add({ TEXT("Zlib"), NAME_Zlib, COMPRESS_NoFlags, 0 });
+	Cases.Add({ TEXT("LZ4HC"), NAME_LZ4, COMPRESS_NoFlags, 0 });
+	if (FCompression::IsFormatValid(NAME_Zstd))
+	{
+		Cases.Add({ TEXT("Zstd fast"), NAME_Zstd, COMPRESS_BiasSpeed, 0 });
+		Cases.Add({ TEXT("Zstd"), NAME_Zstd, COMPRESS_NoFlags, 0 });
+		Cases.Add({ TEXT("Zstd max"), NAME_Zstd, COMPRESS_BiasMemory, 0 });
+
+		// train on every 16th block, like a cook would on a sample of its containers
+		TArray<TArrayView<const uint8>> Samples;
+		for (int32 BlockIndex = 0; BlockIndex < Blocks.Num(); BlockIndex += 16)
+		{
+			Samples.Add(Blocks[BlockIndex]);
+		}
+		TArray<uint8> Dictionary;
+		if (FCompression::TrainZstdDictionary(Samples, 112 << 10, Dictionary))
+		{
+			Cases.Add({ TEXT("Zstd dictionary"), NAME_Zstd, COMPRESS_NoFlags, FCompression::RegisterZstdDictionary(Dictionary) });
+		}
+	}
+
+	for (const FCase& Case : Cases)
+	{
+		const FBenchmarkResult Result = Benchmark(Case.Format, Blocks, Case.Flags, Case.DictionaryId);
+		const double MegaBytes = double(Result.UncompressedSize) / (1024.0 * 1024.0);
+		AddInfo(FString::Printf(TEXT("%-16s ratio %.3f, compress %.1f MB/s, uncompress %.1f MB/s"),
+			Case.Name,
+			double(Result.CompressedSize) / double(Result.UncompressedSize),
+			MegaBytes / Result.CompressSeconds,
+			MegaBytes / Result.UncompressSeconds));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,262 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/ThreadHeartBeat.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/StringBuilder.h"
+#include "UObject/NameBatchSerialization.h"
+#include <atomic>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace NameBatchTest
+{
+	/** Unique prefix so repeated runs don't find names created by earlier runs */
+	static FString MakeUniquePrefix(const TCHAR* Tag)
+	{
+		static std::atomic<uint32> Counter{ 0 };
+		return FString::Printf(TEXT("NameBatchTest_%s_%u_%u_"), Tag, FPlatformTime::Cycles(), Counter++);
+	}
+
+	static TArray<FWideStringView> MakeViews(const TArray<FString>& Strings)
+	{
+		TArray<FWideStringView> Views;
+		for (const FString& String : Strings)
+		{
+			Views.Emplace(*String, String.Len());
+		}
+		return Views;
+	}
+
+	/** Names with duplicates, case variants, existing names and wide names */
+	static TArray<FString> MakeStrings(int32 Num)
+	{
+		const FString Prefix = MakeUniquePrefix(TEXT("Batch"));
+		TArray<FString> Strings;
+		for (int32 Idx = 0; Idx < Num; ++Idx)
+		{
+			switch (Idx % 8)
+			{
+			case 0:		Strings.Add(Prefix + FString::FromInt(Idx));						break;
+			case 1:		Strings.Add(Prefix.ToUpper() + FString::FromInt(Idx - 1));			break;
+			case 2:		Strings.Add(Prefix + FString::FromInt(Idx / 2));					break;
+			case 3:		Strings.Add(Prefix + TEXT("N\x00E4me_") + FString::FromInt(Idx));	break;
+			case 4:		Strings.Add(TEXT("None"));											break;
+			case 5:		Strings.Add(TEXT("Object"));										break;
+			case 6:		Strings.Add(Idx % 64 == 6 ? FString() : Prefix + TEXT("07"));		break;
+			default:	Strings.Add(Prefix + TEXT("Wide\x00C4") + FString::FromInt(Idx));	break;
+			}
+		}
+		return Strings;
+	}
+
+	template<typename FunctionType>
+	static double Time(int32 NumRuns, FunctionType&& Function)
+	{
+		double MinTime = MAX_dbl;
+		for (int32 Run = 0; Run < NumRuns; Run++)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Function();
+			MinTime = FMath::Min(MinTime, FPlatformTime::Seconds() - StartTime);
+		}
+		return MinTime;
+	}
+
+	/** Runs Body(ThreadIdx) on NumThreads dedicated threads that start together, returns seconds until all finished */
+	static double RunOnThreads(int32 NumThreads, TFunction<void(int32)> Body)
+	{
+		std::atomic<int32> NumStarted{ 0 };
+		std::atomic<double> StartTime{ 0.0 };
+		TArray<TFuture<double>> Finished;
+		for (int32 ThreadIdx = 0; ThreadIdx < NumThreads; ++ThreadIdx)
+		{
+			Finished.Add(Async(EAsyncExecution::Thread, [ThreadIdx, NumThreads, &NumStarted, &StartTime, &Body]()
+			{
+				if (++NumStarted == NumThreads)
+				{
+					StartTime = FPlatformTime::Seconds();
+				}
+				while (NumStarted < NumThreads)
+				{
+					FPlatformProcess::Yield();
+				}
+
+				Body(ThreadIdx);
+				return FPlatformTime::Seconds();
+			}));
+		}
+
+		double EndTime = 0.0;
+		for (TFuture<double>& Future : Finished)
+		{
+			EndTime = FMath::Max(EndTime, Future.Get());
+		}
+		return EndTime - StartTime;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNameBatchTest, "System.Core.Names.Batch", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FNameBatchTest::RunTest(const FString& Parameters)
+{
+	using namespace NameBatchTest;
+
+	IConsoleVariable* ParallelMinNumVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Names.BatchParallelMinNum"));
+	if (!TestNotNull(TEXT("Names.BatchParallelMinNum"), ParallelMinNumVar))
+	{
+		return false;
+	}
+	const int32 OldParallelMinNum = ParallelMinNumVar->GetInt();
+
+	// Small batches are stored one by one, large ones in shard order, serially or in parallel
+	const int32 Nums[] = { 0, 1, 100, 1000, 20000 };
+	const int32 ParallelMinNums[] = { 0, 1 };
+	for (int32 Num : Nums)
+	{
+		for (int32 ParallelMinNum : ParallelMinNums)
+		{
+			ParallelMinNumVar->Set(ParallelMinNum, ECVF_SetByCode);
+
+			TArray<FString> Strings = MakeStrings(Num);
+			TArray<FNameEntryId> Ids;
+			CreateNameBatch(MakeViews(Strings), Ids);
+
+			int32 NumWrong = 0;
+			for (int32 Idx = 0; Idx < Num; ++Idx)
+			{
+				NumWrong += Ids[Idx] != FName(*Strings[Idx], NAME_NO_NUMBER_INTERNAL).GetDisplayIndex();
+			}
+			TestEqual(FString::Printf(TEXT("Wide batch ids differing from FName, Num %d, parallel min num %d"), Num, ParallelMinNum), NumWrong, 0);
+			TestEqual(TEXT("Batch size"), Ids.Num(), Num);
+
+			// Numbers are not parsed
+			if (Num > 2)
+			{
+				TestEqual(TEXT("Batch name number"), FName::CreateFromDisplayId(Ids[0], NAME_NO_NUMBER_INTERNAL).GetNumber(), int32(NAME_NO_NUMBER_INTERNAL));
+			}
+
+			// Same strings as ANSI, except for the wide names
+			TArray<FAnsiStringView> AnsiViews;
+			TArray<int32> AnsiIndices;
+			TArray<TArray<ANSICHAR>> AnsiStrings;
+			for (int32 Idx = 0; Idx < Num; ++Idx)
+			{
+				if (FCString::IsPureAnsi(*Strings[Idx]))
+				{
+					AnsiStrings.Emplace(TCHAR_TO_ANSI(*Strings[Idx]), Strings[Idx].Len());
+					AnsiIndices.Add(Idx);
+				}
+			}
+			for (const TArray<ANSICHAR>& AnsiString : AnsiStrings)
+			{
+				AnsiViews.Emplace(AnsiString.GetData(), AnsiString.Num());
+			}
+
+			TArray<FNameEntryId> AnsiIds;
+			CreateNameBatch(AnsiViews, AnsiIds);
+
+			NumWrong = 0;
+			for (int32 AnsiIdx = 0; AnsiIdx < AnsiIds.Num(); ++AnsiIdx)
+			{
+				NumWrong += AnsiIds[AnsiIdx] != Ids[AnsiIndices[AnsiIdx]];
+			}
+			TestEqual(FString::Printf(TEXT("ANSI batch ids differing from wide batch, Num %d, parallel min num %d"), Num, ParallelMinNum), NumWrong, 0);
+		}
+	}
+
+	ParallelMinNumVar->Set(OldParallelMinNum, ECVF_SetByCode);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNameThroughputTest, "System.Core.Names.Throughput", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+/**
+ * Name creation and lookup throughput from 1 to 32 threads, with and without Names.LockFreeLookup,
+ * and batch creation compared to creating names one by one. Creates half a million names that are never freed.
+ */
+bool FNameThroughputTest::RunTest(const FString& Parameters)
+{
+	using namespace NameBatchTest;
+
+	IConsoleVariable* LockFreeVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Names.LockFreeLookup"));
+	if (!TestNotNull(TEXT("Names.LockFreeLookup"), LockFreeVar))
+	{
+		return false;
+	}
+	const int32 OldLockFree = LockFreeVar->GetInt();
+
+	FSlowHeartBeatScope SuspendHeartBeat;
+
+	const int32 NumNames = 1 << 16;
+	const int32 NumLookupRuns = 3;
+
+	for (int32 NumThreads = 1; NumThreads <= 32; NumThreads *= 2)
+	{
+		const FString Prefix = MakeUniquePrefix(TEXT("Threads"));
+		TArray<FString> Strings;
+		for (int32 Idx = 0; Idx < NumNames; ++Idx)
+		{
+			Strings.Add(Prefix + FString::FromInt(Idx));
+		}
+
+		const int32 NumPerThread = NumNames / NumThreads;
+		auto ForEachOfThread = [&](int32 ThreadIdx, TFunctionRef<void(const FString&)> Function)
+		{
+			for (int32 Idx = ThreadIdx * NumPerThread, End = Idx + NumPerThread; Idx < End; ++Idx)
+			{
+				Function(Strings[Idx]);
+			}
+		};
+
+		// Every thread creates its own new names, then looks up names created by the others
+		const double Create = RunOnThreads(NumThreads, [&](int32 ThreadIdx) { ForEachOfThread(ThreadIdx, [](const FString& String) { FName Name(*String); }); });
+
+		double Lookup[2];
+		for (int32 LockFree = 0; LockFree < 2; ++LockFree)
+		{
+			LockFreeVar->Set(LockFree, ECVF_SetByCode);
+			Lookup[LockFree] = Time(NumLookupRuns, [&]()
+			{
+				RunOnThreads(NumThreads, [&](int32 ThreadIdx) { ForEachOfThread((ThreadIdx + 1) % NumThreads, [](const FString& String) { FName Name(*String, FNAME_Find); }); });
+			});
+		}
+
+		AddInfo(FString::Printf(TEXT("%2d threads: create %6.2f Mnames/s, find locked %6.2f Mnames/s, find lock-free %6.2f Mnames/s (%.2fx)"),
+			NumThreads, NumNames / Create / 1e6, NumNames / Lookup[0] / 1e6, NumNames / Lookup[1] / 1e6, Lookup[0] / Lookup[1]));
+	}
+
+	LockFreeVar->Set(OldLockFree, ECVF_SetByCode);
+
+	// A large name map, new and then existing names
+	{
+		TArray<FString> Strings[2];
+		for (TArray<FString>& Batch : Strings)
+		{
+			const FString Prefix = MakeUniquePrefix(TEXT("Map"));
+			for (int32 Idx = 0; Idx < NumNames; ++Idx)
+			{
+				Batch.Add(Prefix + FString::FromInt(Idx));
+			}
+		}
+
+		TArray<FNameEntryId> Ids;
+		auto CreateOneByOne = [&Strings]() { for (const FString& String : Strings[0]) { FName Name(*String, NAME_NO_NUMBER_INTERNAL); } };
+		auto CreateBatch = [&Strings, &Ids]() { CreateNameBatch(MakeViews(Strings[1]), Ids); };
+
+		const double NewOneByOne = Time(1, CreateOneByOne);
+		const double NewBatch = Time(1, CreateBatch);
+		const double ExistingOneByOne = Time(NumLookupRuns, CreateOneByOne);
+		const double ExistingBatch = Time(NumLookupRuns, CreateBatch);
+
+		AddInfo(FString::Printf(TEXT("%d new names: one by one %6.2fms, batch %6.2fms (%.2fx). Existing names: one by one %6.2fms, batch %6.2fms (%.2fx)"),
+			NumNames, NewOneByOne * 1000.0, NewBatch * 1000.0, NewOneByOne / NewBatch, ExistingOneByOne * 1000.0, ExistingBatch * 1000.0, ExistingOneByOne / ExistingBatch));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -30,6 +30,9 @@
 #include "Serialization/MemoryWriter.h"
 #include "Hash/CityHash.h"
 #include "Templates/AlignmentTemplates.h"
+#include "Async/ParallelFor.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include <atomic>
 
 PRAGMA_DISABLE_UNSAFE_TYPECAST_WARNINGS
 
@@ -45,6 +48,20 @@ PRAGMA_DISABLE_UNSAFE_TYPECAST_WARNINGS
 
 DEFINE_LOG_CATEGORY_STATIC(LogUnrealNames, Log, All);
 
+static bool GNameLockFreeLookup = true;
+static FAutoConsoleVariableRef CVarNameLockFreeLookup(
+	TEXT("Names.LockFreeLookup"),
+	GNameLockFreeLookup,
+	TEXT("Find existing FNames without taking the name pool shard locks, only inserting new names locks."),
+	ECVF_Default);
+
+static int32 GNameBatchParallelMinNum = 8192;
+static FAutoConsoleVariableRef CVarNameBatchParallelMinNum(
+	TEXT("Names.BatchParallelMinNum"),
+	GNameBatchParallelMinNum,
+	TEXT("Name batches with at least this many names are hashed and inserted into the name pool shards in parallel. 0 disables parallel batches."),
+	ECVF_Default);
+
 const TCHAR* LexToString(EName Ename)
 {
 	switch (Ename)
@@ -263,6 +280,10 @@ struct FNameSlot
 	bool operator==(FNameSlot Rhs) const { return IdAndHash == Rhs.IdAndHash; }
 
 	bool Used() const { return !!IdAndHash;  }
+
+	// Single untorn load / store for slots that are probed without holding the shard lock
+	FNameSlot LoadLockFree() const	{ FNameSlot Out; Out.IdAndHash = *reinterpret_cast<const volatile uint32*>(&IdAndHash); return Out; }
+	void Publish(FNameSlot Value)	{ *reinterpret_cast<volatile uint32*>(&IdAndHash) = Value.IdAndHash; }
 private:
 	uint32 IdAndHash = 0;
 };
@@ -690,6 +711,12 @@ public:
 	~FNamePoolShardBase()
 	{
 		FMemory::Free(Slots);
+		for (FNameSlot* Retired : RetiredSlots)
+		{
+			FMemory::Free(Retired);
+		}
+		RetiredSlots.Empty();
+		NumRetiredSlots = 0;
 		UsedSlots = 0;
 		CapacityMask = 0;
 		Slots = nullptr;
@@ -700,6 +727,7 @@ public:
 	uint32 Capacity() const	{ return CapacityMask + 1; }
 	uint32 NumCreated() const { return NumCreatedEntries; }
 	uint32 NumCreatedWide() const { return NumCreatedWideEntries; }
+	uint32 NumRetired() const { return NumRetiredSlots; }
 
 protected:
 	enum { LoadFactorQuotient = 9, LoadFactorDivisor = 10 }; // I.e. realloc slots when 90% full
@@ -712,6 +740,14 @@ protected:
 	uint32 NumCreatedEntries = 0;
 	uint32 NumCreatedWideEntries = 0;
 
+	// Odd while Grow() replaces Slots and CapacityMask, lets lock-free readers detect torn reads
+	std::atomic<uint32> SlotsVersion{0};
+
+	// Slot arrays replaced by Grow(), kept alive since lock-free readers might still be probing them.
+	// Capacity doubles so they never use more memory than the current slots.
+	TArray<FNameSlot*> RetiredSlots;
+	uint32 NumRetiredSlots = 0;
+
 
 	template<ENameCase Sensitivity>
 	FORCEINLINE static bool EntryEqualsValue(const FNameEntry& Entry, const FNameValue<Sensitivity>& Value)
@@ -726,6 +762,12 @@ class FNamePoolShard : public FNamePoolShardBase
 public:
 	FNameEntryId Find(const FNameValue<Sensitivity>& Value) const
 	{
+		FNameSlot Existing;
+		if (GNameLockFreeLookup && ProbeLockFree(Value, Existing))
+		{
+			return Existing.GetId();
+		}
+
 		FRWScopeLock _(Lock, FRWScopeLockType::SLT_ReadOnly);
 
 		return Probe(Value).GetId();
@@ -734,6 +776,13 @@ public:
 	template<class ScopeLock = FWriteScopeLock>
 	FORCEINLINE FNameEntryId Insert(const FNameValue<Sensitivity>& Value, bool& bCreatedNewEntry)
 	{
+		// Most names already exist, only take the lock when we might need to create one
+		FNameSlot Existing;
+		if (GNameLockFreeLookup && ProbeLockFree(Value, Existing) && Existing.Used())
+		{
+			return Existing.GetId();
+		}
+
 		ScopeLock _(Lock);
 		FNameSlot& Slot = Probe(Value);
 
@@ -748,6 +797,13 @@ public:
 
 	void InsertExistingEntry(FNameHash Hash, FNameEntryId ExistingId)
 	{
+		FNameSlot NewLookup(ExistingId, Hash.SlotProbeHash);
+		FNameSlot Existing;
+		if (GNameLockFreeLookup && ProbeLockFree(Hash.UnmaskedSlotIndex, [=](FNameSlot Old) { return Old == NewLookup; }, Existing) && Existing.Used())
+		{
+			return;
+		}
+
 		InsertExistingEntryImpl<FWriteScopeLock>(Hash, ExistingId);
 	}
 
@@ -862,7 +918,9 @@ private:
 	{
 		checkSlow(!UnusedSlot.Used());
 
-		UnusedSlot = NewValue;
+		// Make entry data visible before the slot, lock-free readers resolve any used slot they see
+		std::atomic_thread_fence(std::memory_order_release);
+		UnusedSlot.Publish(NewValue);
 
 		++UsedSlots;
 		if (UsedSlots * LoadFactorDivisor > LoadFactorQuotient * Capacity())
@@ -895,6 +953,11 @@ private:
 		TArrayView<FNameSlot> OldSlots(Slots, Capacity());
 		const uint32 OldUsedSlots = UsedSlots;
 
+		// Make lock-free readers fall back to the lock until the new slots are published
+		const uint32 OldVersion = SlotsVersion.load(std::memory_order_relaxed);
+		SlotsVersion.store(OldVersion + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
 		Slots = (FNameSlot*)FMemory::Malloc(NewCapacity * sizeof(FNameSlot), alignof(FNameSlot));
 		memset(Slots, 0, NewCapacity * sizeof(FNameSlot));
 		UsedSlots = 0;
@@ -932,7 +995,10 @@ private:
 
 		check(OldUsedSlots == UsedSlots);
 
-		FMemory::Free(OldSlots.GetData());
+		SlotsVersion.store(OldVersion + 2, std::memory_order_release);
+
+		RetiredSlots.Add(OldSlots.GetData());
+		NumRetiredSlots += OldSlots.Num();
 	}
 
 	void ProbePrefetch(const FNameValue<Sensitivity>& Value) const
@@ -970,6 +1036,53 @@ private:
 		}
 	}
 
+	/** Lock-free version of Probe(Value) */
+	FORCEINLINE bool ProbeLockFree(const FNameValue<Sensitivity>& Value, FNameSlot& OutSlot) const
+	{
+		return ProbeLockFree(Value.Hash.UnmaskedSlotIndex, 
+			[&](FNameSlot Slot)
+			{
+				if (Slot.GetProbeHash() != Value.Hash.SlotProbeHash)
+				{
+					return false;
+				}
+				// Pairs with the fence in ClaimSlot(), entry data must be visible before it's compared
+				std::atomic_thread_fence(std::memory_order_acquire);
+				return EntryEqualsValue<Sensitivity>(Entries->Resolve(Slot.GetId()), Value);
+			}, OutSlot);
+	}
+
+	/** 
+	 * Find slot that fulfills predicate or the first free slot without taking the lock.
+	 *
+	 * Slots inserted concurrently might be missed and an unused slot returned instead.
+	 * Slot arrays are retired rather than freed when growing, so probing a stale array is safe.
+	 *
+	 * @return false if the slot array was being replaced, caller must probe under lock instead
+	 */
+	template<class PredicateFn>
+	FORCEINLINE bool ProbeLockFree(uint32 UnmaskedSlotIndex, PredicateFn Predicate, FNameSlot& OutSlot) const
+	{
+		const uint32 Version = SlotsVersion.load(std::memory_order_acquire);
+		const FNameSlot* LocalSlots = *reinterpret_cast<FNameSlot* const volatile*>(&Slots);
+		const uint32 Mask = *reinterpret_cast<const volatile uint32*>(&CapacityMask);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if ((Version & 1) || SlotsVersion.load(std::memory_order_relaxed) != Version)
+		{
+			return false;
+		}
+
+		for (uint32 I = FNameHash::GetProbeStart(UnmaskedSlotIndex, Mask); true; I = (I + 1) & Mask)
+		{
+			const FNameSlot Slot = LocalSlots[I].LoadLockFree();
+			if (!Slot.Used() || Predicate(Slot))
+			{
+				OutSlot = Slot;
+				return true;
+			}
+		}
+	}
+
 	FORCENOINLINE // Doesn't impact performance and makes sampling profiles more informative
 	void RehashAndInsert(FNameSlot OldSlot)
 	{
@@ -1016,6 +1129,8 @@ public:
 	uint32			NumWideEntries() const;
 	uint32			NumBlocks() const { return Entries.NumBlocks(); }
 	uint32			NumSlots() const;
+	uint32			NumRetiredSlots() const;
+	void			RecordBatch(uint32 NumNames, bool bParallel);
 	void			LogStats(FOutputDevice& Ar) const;
 	uint8**			GetBlocksForDebugVisualizer() { return Entries.GetBlocksForDebugVisualizer(); }
 	TArray<const FNameEntry*> DebugDump() const;
@@ -1034,6 +1149,11 @@ private:
 	alignas(PLATFORM_CACHE_LINE_SIZE) FNameEntryId ENameToEntry[NAME_MaxHardcodedNameIndex] = {};
 	uint32 LargestEnameUnstableId;
 	TMap<FNameEntryId, EName, TInlineSetAllocator<MaxENames>> EntryToEName;
+
+	// Batch stats, only touched once per batch
+	std::atomic<uint32> NumBatches{0};
+	std::atomic<uint32> NumParallelBatches{0};
+	std::atomic<uint64> NumBatchedNames{0};
 };
 
 FNamePool::FNamePool()
@@ -1230,9 +1350,37 @@ uint32 FNamePool::NumSlots() const
 	return SlotCapacity;
 }
 
+uint32 FNamePool::NumRetiredSlots() const
+{
+	uint32 Out = 0;
+#if WITH_CASE_PRESERVING_NAME
+	for (const FNamePoolShardBase& Shard : DisplayShards)
+	{
+		Out += Shard.NumRetired();
+	}
+#endif
+	for (const FNamePoolShardBase& Shard : ComparisonShards)
+	{
+		Out += Shard.NumRetired();
+	}
+
+	return Out;
+}
+
+void FNamePool::RecordBatch(uint32 NumNames, bool bParallel)
+{
+	NumBatches.fetch_add(1, std::memory_order_relaxed);
+	NumParallelBatches.fetch_add(bParallel, std::memory_order_relaxed);
+	NumBatchedNames.fetch_add(NumNames, std::memory_order_relaxed);
+}
+
 void FNamePool::LogStats(FOutputDevice& Ar) const
 {
 	Ar.Logf(TEXT("%i FNames using in %ikB + %ikB"), NumEntries(), sizeof(FNamePool), Entries.NumBlocks() * FNameEntryAllocator::BlockSizeBytes / 1024);
+	Ar.Logf(TEXT("%u hash slots using %ukB, %ukB in slots retired by growing"), NumSlots(), static_cast<uint32>(NumSlots() * sizeof(FNameSlot) / 1024), static_cast<uint32>(NumRetiredSlots() * sizeof(FNameSlot) / 1024));
+	Ar.Logf(TEXT("%u name batches (%u parallel) with %llu names, lock-free lookup %s"), 
+		NumBatches.load(std::memory_order_relaxed), NumParallelBatches.load(std::memory_order_relaxed), NumBatchedNames.load(std::memory_order_relaxed),
+		GNameLockFreeLookup ? TEXT("enabled") : TEXT("disabled"));
 }
 
 TArray<const FNameEntry*> FNamePool::DebugDump() const
@@ -3159,56 +3307,106 @@ static void LoadSeparatedNameBatchInInputOrder(	TArray<FNameEntryId>& Out,
 	check(StringIt == Strings.end());
 }
 
+// Number of names to load into each shard
+using FShardBatchSizes = uint32[FNamePoolShards];
+
+static bool ShouldLoadBatchInParallel(int32 Num)
+{
+	return GNameBatchParallelMinNum > 0 && Num >= GNameBatchParallelMinNum && FTaskGraphInterface::IsRunning();
+}
+
+// Counting sort loads in shard order
+template<class LoadType>
+static void SortLoadsByShard(TArrayView<const LoadType> Loads, TArray<LoadType>& OutSorted, FShardBatchSizes& OutSizes)
+{
+	FMemory::Memzero(OutSizes);
+	for (const LoadType& Load : Loads)
+	{
+		++OutSizes[Load.In.Hash.ShardIndex];
+	}
+
+	uint32 SortIdx[FNamePoolShards];
+	uint32 NextIdx = 0;
+	for (uint32 ShardIdx = 0; ShardIdx < FNamePoolShards; ++ShardIdx)
+	{
+		SortIdx[ShardIdx] = NextIdx;
+		NextIdx += OutSizes[ShardIdx];
+	}
+
+	OutSorted.SetNumUninitialized(Loads.Num());
+	for (const LoadType& Load : Loads)
+	{
+		OutSorted[SortIdx[Load.In.Hash.ShardIndex]++] = Load;
+	}
+}
+
+// Stores one batch per shard. Each shard has its own lock so large batches are stored concurrently,
+// only creating new entries serializes on the entry allocator.
+//
 // @param Loads are sorted in shard order
 template<class LoadType>
-void LoadOneBatchPerShard(TArray<LoadType>& Loads)
+static void LoadShardBatches(TArrayView<LoadType> Loads, const FShardBatchSizes& Sizes, bool bParallel)
 {
 	FNamePool& Pool = GetNamePoolPostInit();
 
-	LoadType* BatchIt = &Loads[0];
-	for (LoadType& Load : Loads)
+	uint32 Offsets[FNamePoolShards];
+	uint32 Offset = 0;
+	for (uint32 ShardIdx = 0; ShardIdx < FNamePoolShards; ++ShardIdx)
 	{
-		if (Load.In.Hash.ShardIndex != BatchIt->In.Hash.ShardIndex)
-		{
-			Pool.StoreBatch(BatchIt->In.Hash.ShardIndex, TArrayView<LoadType>(BatchIt, &Load - BatchIt));
-			BatchIt = &Load;
-		}
+		Offsets[ShardIdx] = Offset;
+		Offset += Sizes[ShardIdx];
 	}
+	check(Offset == Loads.Num());
 
-	TArrayView<LoadType> LastBatch(BatchIt, &Loads.Last() + 1 - BatchIt);
-	Pool.StoreBatch(BatchIt->In.Hash.ShardIndex, LastBatch);
-
-	check(BatchIt + LastBatch.Num() == Loads.GetData() + Loads.Num());
+	ParallelForAdaptiveWithCost(FNamePoolShards, 
+		[&](int32 ShardIdx) { Pool.StoreBatch(ShardIdx, Loads.Slice(Offsets[ShardIdx], Sizes[ShardIdx])); },
+		[&](int32 ShardIdx) { return static_cast<float>(Sizes[ShardIdx]); },
+		/* MinBatchSize */ 4,
+		bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
 }
 
-
 #if WITH_CASE_PRESERVING_NAME
 
 FORCENOINLINE // To help profiling
-static void LoadDisplayNames(const TArray<FNameComparisonLoad>& ComparisonLoads)
+static void LoadDisplayNames(TArrayView<const FNameComparisonLoad> ComparisonLoads, bool bParallel)
 {
 	FNamePool& Pool = GetNamePoolPostInit();
 
 	// Hash display names and prepare load requests
 	TArray<FNameDisplayLoad> DisplayLoads;
-	DisplayLoads.Reserve(ComparisonLoads.Num());
-	for (const FNameComparisonLoad& ComparisonLoad : ComparisonLoads)
+	DisplayLoads.SetNumUninitialized(ComparisonLoads.Num());
+	ParallelForAdaptive(ComparisonLoads.Num(), [&](int32 Idx)
 	{
+		const FNameComparisonLoad& ComparisonLoad = ComparisonLoads[Idx];
 		FNameDisplayValue DisplayValue(ComparisonLoad.In.Name);
 		DisplayValue.ComparisonId = *ComparisonLoad.Out;
 
 		bool bReuseEntry = Pool.ReuseComparisonEntry(ComparisonLoad.bOutCreatedNewEntry, DisplayValue);
-		DisplayLoads.Emplace(FNameDisplayLoad {DisplayValue, ComparisonLoad.Out, bReuseEntry});
-	}
+		DisplayLoads[Idx] = FNameDisplayLoad {DisplayValue, ComparisonLoad.Out, bReuseEntry};
+	}, /* MinBatchSize */ 256, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
 
-	// Sort loads in shard order
-	Algo::HeapSort(DisplayLoads, [](const FNameDisplayLoad& A, const FNameDisplayLoad& B) { return A.In.Hash.ShardIndex < B.In.Hash.ShardIndex; });
+	TArray<FNameDisplayLoad> ShardSortedLoads;
+	FShardBatchSizes Sizes;
+	SortLoadsByShard<FNameDisplayLoad>(DisplayLoads, ShardSortedLoads, Sizes);
 
-	LoadOneBatchPerShard(DisplayLoads);
+	LoadShardBatches<FNameDisplayLoad>(ShardSortedLoads, Sizes, bParallel);
 }
 
 #endif  // WITH_CASE_PRESERVING_NAME
 
+// Loads shard sorted comparison names, then their display names
+static void LoadShardSortedNames(TArrayView<FNameComparisonLoad> ShardSortedLoads, const FShardBatchSizes& Sizes)
+{
+	const bool bParallel = ShouldLoadBatchInParallel(ShardSortedLoads.Num());
+	GetNamePoolPostInit().RecordBatch(ShardSortedLoads.Num(), bParallel);
+
+	LoadShardBatches(ShardSortedLoads, Sizes, bParallel);
+
+#if WITH_CASE_PRESERVING_NAME
+	LoadDisplayNames(ShardSortedLoads, bParallel);
+#endif
+}
+
 // Helper struct for loading part of a name batch into a shard
 struct FShardTarget
 {
@@ -3274,20 +3472,13 @@ static void LoadInterleavedNameBatchInShardOrder(	TArray<FNameEntryId>& Out,
 		++Target.SortIdx;
 	}
 	
-	// Loop over shard and load batches
-	FNamePool& Pool = GetNamePoolPostInit();
-	FNameComparisonLoad* LoadIt = ShardSortedLoads.GetData();
-	for (FShardTarget& Target : Targets)
+	FShardBatchSizes Sizes;
+	for (uint32 ShardIdx = 0; ShardIdx < FNamePoolShards; ++ShardIdx)
 	{
-		TArrayView<FNameComparisonLoad> Batch(LoadIt, Target.Num);
-		LoadIt += Target.Num;
-		Pool.StoreBatch(&Target - Targets, Batch);
+		Sizes[ShardIdx] = Targets[ShardIdx].Num;
 	}
-	check(LoadIt == ShardSortedLoads.GetData() + ShardSortedLoads.Num());
 
-#if WITH_CASE_PRESERVING_NAME
-	LoadDisplayNames(ShardSortedLoads);
-#endif
+	LoadShardSortedNames(ShardSortedLoads, Sizes);
 }
 
 static void LoadSeparatedNameBatchInShardOrder(	TArray<FNameEntryId>& Out,
@@ -3365,20 +3556,13 @@ static void LoadSeparatedNameBatchInShardOrder(	TArray<FNameEntryId>& Out,
 	}
 	check(UnsortedStringsIt == Strings.end());
 	
-	// Loop over shards and issue batch loads
-	FNamePool& Pool = GetNamePoolPostInit();
-	FNameComparisonLoad* LoadIt = ShardSortedLoads.GetData();
-	for (FExtendedShardTarget& Target : Targets)
+	FShardBatchSizes Sizes;
+	for (uint32 ShardIdx = 0; ShardIdx < FNamePoolShards; ++ShardIdx)
 	{
-		TArrayView<FNameComparisonLoad> Batch(LoadIt, Target.NumNames);
-		LoadIt += Target.NumNames;
-		Pool.StoreBatch(&Target - Targets, Batch);
+		Sizes[ShardIdx] = Targets[ShardIdx].NumNames;
 	}
-	check(LoadIt == ShardSortedLoads.GetData() + ShardSortedLoads.Num());
 
-#if WITH_CASE_PRESERVING_NAME
-	LoadDisplayNames(ShardSortedLoads);
-#endif
+	LoadShardSortedNames(ShardSortedLoads, Sizes);
 }
 
 void LoadNameBatch(TArray<FNameEntryId>& OutNames, TArrayView<const uint8> NameData, TArrayView<const uint8> HashData)
@@ -3548,6 +3732,113 @@ TFunction<TArray<FNameEntryId>()> LoadNameBatchAsync(FArchive& Ar, uint32 MaxWor
 	return []() { return TArray<FNameEntryId>(); };
 }
 
+static FNameStringView MakeBatchView(FAnsiStringView String, ANSICHAR*& NarrowIt)
+{
+	return FNameStringView(String.GetData(), String.Len());
+}
+
+// Narrows pure ANSI names like FName(const WIDECHAR*) does
+static FNameStringView MakeBatchView(FWideStringView String, ANSICHAR*& NarrowIt)
+{
+	if (IsWide(String.GetData(), String.Len()))
+	{
+		return FNameStringView(String.GetData(), String.Len());
+	}
+
+	ANSICHAR* Narrowed = NarrowIt;
+	for (int32 Idx = 0; Idx < String.Len(); ++Idx)
+	{
+		Narrowed[Idx] = static_cast<ANSICHAR>(String[Idx]);
+	}
+	NarrowIt += String.Len();
+
+	return FNameStringView(Narrowed, String.Len());
+}
+
+template<typename CharType>
+static void CreateNameBatchImpl(TArrayView<const TStringView<CharType>> Strings, TArray<FNameEntryId>& OutNames)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(CreateNameBatch);
+
+	FNamePool& Pool = GetNamePool();
+	const int32 Num = Strings.Num();
+	OutNames.SetNumUninitialized(Num);
+
+	TArray<ANSICHAR> NarrowBuffer;
+	if (sizeof(CharType) != sizeof(ANSICHAR))
+	{
+		int32 NumChars = 0;
+		for (const TStringView<CharType>& String : Strings)
+		{
+			NumChars += String.Len();
+		}
+		NarrowBuffer.SetNumUninitialized(NumChars);
+	}
+	ANSICHAR* NarrowIt = NarrowBuffer.GetData();
+
+	// Small batches aren't worth sorting, store them one by one
+	const bool bStoreInShardOrder = Num >= static_cast<int32>(FNamePoolShards);
+
+	TArray<FNameComparisonLoad> Loads;
+	Loads.SetNumUninitialized(bStoreInShardOrder ? Num : 0);
+	int32 NumLoads = 0;
+
+	for (int32 Idx = 0; Idx < Num; ++Idx)
+	{
+		FNameStringView Name = MakeBatchView(Strings[Idx], /* in-out */ NarrowIt);
+		if (Name.Len == 0)
+		{
+			OutNames[Idx] = FNameEntryId();
+		}
+		else if (Name.Len >= NAME_SIZE)
+		{
+			// Reports the error like FName constructors do
+			OutNames[Idx] = FNameHelper::Make(Name, FNAME_Add, NAME_NO_NUMBER_INTERNAL).GetDisplayIndex();
+		}
+		else if (!bStoreInShardOrder)
+		{
+			OutNames[Idx] = Pool.Store(Name);
+		}
+		else
+		{
+			// Hashed below
+			FNameComparisonLoad& Load = Loads[NumLoads++];
+			Load.In.Name = Name;
+			Load.Out = &OutNames[Idx];
+			Load.bInReuseComparisonEntry = false;
+			Load.bOutCreatedNewEntry = false;
+		}
+	}
+
+	if (NumLoads == 0)
+	{
+		return;
+	}
+	Loads.SetNum(NumLoads, /* allow shrinking */ false);
+
+	const bool bParallel = ShouldLoadBatchInParallel(NumLoads);
+	ParallelForAdaptive(NumLoads, [&Loads](int32 Idx)
+	{
+		Loads[Idx].In.Hash = HashName<ENameCase::IgnoreCase>(Loads[Idx].In.Name);
+	}, /* MinBatchSize */ 256, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	TArray<FNameComparisonLoad> ShardSortedLoads;
+	FShardBatchSizes Sizes;
+	SortLoadsByShard<FNameComparisonLoad>(Loads, ShardSortedLoads, Sizes);
+
+	LoadShardSortedNames(ShardSortedLoads, Sizes);
+}
+
+void CreateNameBatch(TArrayView<const FAnsiStringView> Strings, TArray<FNameEntryId>& OutNames)
+{
+	CreateNameBatchImpl(Strings, OutNames);
+}
+
+void CreateNameBatch(TArrayView<const FWideStringView> Strings, TArray<FNameEntryId>& OutNames)
+{
+	CreateNameBatchImpl(Strings, OutNames);
+}
+
 
 #if 0 && ALLOW_NAME_BATCH_SAVING  
 
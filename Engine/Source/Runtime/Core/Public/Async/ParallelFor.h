@@ -16,6 +16,8 @@
 #include "Async/TaskGraphInterfaces.h"
 #include "Misc/App.h"
 #include "Misc/Fork.h"
+#include "Algo/BinarySearch.h"
+#include "Containers/ArrayView.h"
 
 // Flags controlling the ParallelFor's behavior.
 enum class EParallelForFlags
@@ -313,6 +315,286 @@ namespace ParallelForImpl
 		Data->bExited = true;
 		// Data must live on until all of the tasks are cleared which might be long after this function exits
 	}
+
+	/**
+	 * Working data of ParallelForAdaptive, outlives the call like TParallelForData.
+	 * Every participant owns a range of indices and takes batches from its front. A participant that runs out steals
+	 * the back half of the largest range left, so the ranges keep splitting where the expensive indices are.
+	 */
+	template<typename FunctionType>
+	struct TParallelForAdaptiveData
+	{
+		/** Begin in the low and End in the high 32 bits, so owner and thieves agree with a single compare exchange. Padded, every owner hammers its own. */
+		struct FRange
+		{
+			volatile int64 Packed;
+			uint8 Padding[PLATFORM_CACHE_LINE_SIZE - sizeof(int64)];
+		};
+
+		int32 Num;
+		int32 MinBatchSize;
+		FunctionType Body;
+		/** Estimated cost of indices [0, Index), empty when there is no cost estimate */
+		TArray<double> CostPrefix;
+		TArray<FRange> Ranges;
+		FEvent* Event;
+		FThreadSafeCounter NextParticipant;
+		FThreadSafeCounter NumCompleted;
+		bool bExited;
+		bool bTriggered;
+
+		TParallelForAdaptiveData(int32 InNum, int32 InNumParticipants, int32 InMinBatchSize, FunctionType InBody, const TFunctionRef<float(int32)>* EstimateCost)
+			: Num(InNum)
+			, MinBatchSize(InMinBatchSize)
+			, Body(InBody)
+			, Event(FPlatformProcess::GetSynchEventFromPool(false))
+			, bExited(false)
+			, bTriggered(false)
+		{
+			check(Num > 0 && MinBatchSize > 0 && InNumParticipants > 0);
+
+			if (EstimateCost)
+			{
+				CostPrefix.SetNumUninitialized(Num + 1);
+				CostPrefix[0] = 0.0;
+				for (int32 Index = 0; Index < Num; Index++)
+				{
+					// zero cost would make ranges impossible to split
+					CostPrefix[Index + 1] = CostPrefix[Index] + FMath::Max((*EstimateCost)(Index), SMALL_NUMBER);
+				}
+			}
+
+			// equal shares to start with, helpers that start late have theirs stolen
+			Ranges.SetNumUninitialized(InNumParticipants);
+			int32 Begin = 0;
+			for (int32 Participant = 0; Participant < InNumParticipants; Participant++)
+			{
+				int32 End = Participant == InNumParticipants - 1 ? Num : Split(Begin, Num, InNumParticipants - Participant);
+				Ranges[Participant].Packed = Pack(Begin, End);
+				Begin = End;
+			}
+		}
+		~TParallelForAdaptiveData()
+		{
+			check(NumCompleted.GetValue() == Num);
+			check(bExited);
+			FPlatformProcess::ReturnSynchEventToPool(Event);
+		}
+
+		static FORCEINLINE int64 Pack(int32 Begin, int32 End)
+		{
+			return int64((uint64(uint32(End)) << 32) | uint64(uint32(Begin)));
+		}
+		static FORCEINLINE void Unpack(int64 Packed, int32& OutBegin, int32& OutEnd)
+		{
+			OutBegin = int32(uint32(uint64(Packed)));
+			OutEnd = int32(uint32(uint64(Packed) >> 32));
+		}
+
+		/** @return where the first 1 / Divisor of [Begin, End) ends, by cost if there is an estimate, never less than a batch */
+		int32 Split(int32 Begin, int32 End, int32 Divisor) const
+		{
+			int32 Result;
+			if (CostPrefix.Num())
+			{
+				const double Target = CostPrefix[Begin] + (CostPrefix[End] - CostPrefix[Begin]) / Divisor;
+				TArrayView<const double> Search(CostPrefix.GetData() + Begin + 1, End - Begin);
+				Result = Begin + 1 + Algo::LowerBound(Search, Target);
+			}
+			else
+			{
+				Result = Begin + (End - Begin) / Divisor;
+			}
+			return FMath::Clamp(Result, FMath::Min(Begin + MinBatchSize, End), End);
+		}
+
+		/** Takes the next batch from the front of our own range */
+		bool TakeBatch(int32 Participant, int32& OutBegin, int32& OutEnd)
+		{
+			volatile int64* Packed = &Ranges[Participant].Packed;
+			while (true)
+			{
+				const int64 LocalPacked = FPlatformAtomics::AtomicRead(Packed);
+				int32 Begin, End;
+				Unpack(LocalPacked, Begin, End);
+				if (Begin >= End)
+				{
+					return false;
+				}
+				// batches shrink as the range does, big ones while there is plenty left, small ones near the end for balance
+				const int32 BatchEnd = Split(Begin, End, 8);
+				if (FPlatformAtomics::InterlockedCompareExchange(Packed, Pack(BatchEnd, End), LocalPacked) == LocalPacked)
+				{
+					OutBegin = Begin;
+					OutEnd = BatchEnd;
+					return true;
+				}
+			}
+		}
+
+		/** Moves the back half of the largest range left into our own, which must be empty. @return false if there is nothing left to steal */
+		bool Steal(int32 Participant)
+		{
+			while (true)
+			{
+				int32 Victim = INDEX_NONE;
+				int64 VictimPacked = 0;
+				int32 VictimNum = 0;
+				for (int32 Index = 0; Index < Ranges.Num(); Index++)
+				{
+					const int64 LocalPacked = FPlatformAtomics::AtomicRead(&Ranges[Index].Packed);
+					int32 Begin, End;
+					Unpack(LocalPacked, Begin, End);
+					if (End - Begin > VictimNum)
+					{
+						Victim = Index;
+						VictimPacked = LocalPacked;
+						VictimNum = End - Begin;
+					}
+				}
+				if (Victim == INDEX_NONE)
+				{
+					return false;
+				}
+
+				int32 Begin, End;
+				Unpack(VictimPacked, Begin, End);
+				// a range of a single batch is taken whole, its owner might be busy with a long batch. Otherwise always leave the thief something.
+				const int32 Mid = VictimNum <= MinBatchSize ? Begin : FMath::Min(Split(Begin, End, 2), End - 1);
+				if (FPlatformAtomics::InterlockedCompareExchange(&Ranges[Victim].Packed, Pack(Begin, Mid), VictimPacked) == VictimPacked)
+				{
+					FPlatformAtomics::InterlockedExchange(&Ranges[Participant].Packed, Pack(Mid, End));
+					return true;
+				}
+			}
+		}
+
+		/** @return true if this call completed the last index */
+		bool Process(int32 Participant)
+		{
+			bool bCompletedLast = false;
+			FunctionType LocalBody(Body);
+			do
+			{
+				int32 Begin, End;
+				while (TakeBatch(Participant, Begin, End))
+				{
+					for (int32 Index = Begin; Index < End; Index++)
+					{
+						LocalBody(Index);
+					}
+					checkSlow(!bExited);
+					if (NumCompleted.Add(End - Begin) + (End - Begin) == Num)
+					{
+						bCompletedLast = true;
+					}
+				}
+			} while (Steal(Participant));
+			return bCompletedLast;
+		}
+	};
+
+	template<typename FunctionType>
+	class TParallelForAdaptiveTask
+	{
+		TSharedRef<TParallelForAdaptiveData<FunctionType>, ESPMode::ThreadSafe> Data;
+		ENamedThreads::Type DesiredThread;
+		int32 TasksToSpawn;
+	public:
+		TParallelForAdaptiveTask(TSharedRef<TParallelForAdaptiveData<FunctionType>, ESPMode::ThreadSafe>& InData, ENamedThreads::Type InDesiredThread, int32 InTasksToSpawn)
+			: Data(InData)
+			, DesiredThread(InDesiredThread)
+			, TasksToSpawn(InTasksToSpawn)
+		{
+		}
+		static FORCEINLINE TStatId GetStatId()
+		{
+			return GET_STATID(STAT_ParallelForTask);
+		}
+
+		FORCEINLINE ENamedThreads::Type GetDesiredThread()
+		{
+			return DesiredThread;
+		}
+
+		static FORCEINLINE ESubsequentsMode::Type GetSubsequentsMode()
+		{
+			return ESubsequentsMode::FireAndForget;
+		}
+		void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+		{
+			FMemMark Mark(FMemStack::Get());
+			// don't bother spreading out if someone finished everything already
+			if (TasksToSpawn && Data->NumCompleted.GetValue() < Data->Num)
+			{
+				TGraphTask<TParallelForAdaptiveTask<FunctionType>>::CreateTask().ConstructAndDispatchWhenReady(Data, DesiredThread, TasksToSpawn - 1);
+			}
+			const int32 Participant = Data->NextParticipant.Increment();
+			check(Participant < Data->Ranges.Num());
+			if (Data->Process(Participant))
+			{
+				checkSlow(!Data->bTriggered);
+				Data->bTriggered = true;
+				Data->Event->Trigger();
+			}
+		}
+	};
+
+	template<typename FunctionType>
+	inline void ParallelForAdaptiveInternal(int32 Num, FunctionType Body, const TFunctionRef<float(int32)>* EstimateCost, int32 MinBatchSize, EParallelForFlags Flags)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ParallelFor);
+		check(Num >= 0);
+		MinBatchSize = FMath::Max(MinBatchSize, 1);
+
+		int32 AnyThreadTasks = 0;
+		const bool bIsMultithread = FApp::ShouldUseThreadingForPerformance() || FForkProcessHelper::IsForkedMultithreadInstance();
+		if (Num > MinBatchSize && (Flags & EParallelForFlags::ForceSingleThread) == EParallelForFlags::None && bIsMultithread)
+		{
+			AnyThreadTasks = FMath::Min<int32>(FTaskGraphInterface::Get().GetNumWorkerThreads(), FMath::DivideAndRoundUp(Num, MinBatchSize) - 1);
+		}
+		if (!AnyThreadTasks)
+		{
+			// no threads, just do it and return
+			for (int32 Index = 0; Index < Num; Index++)
+			{
+				Body(Index);
+			}
+			return;
+		}
+
+		const bool bPumpRenderingThread         = (Flags & EParallelForFlags::PumpRenderingThread) != EParallelForFlags::None;
+		const bool bBackgroundPriority          = (Flags & EParallelForFlags::BackgroundPriority) != EParallelForFlags::None;
+		const ENamedThreads::Type DesiredThread = bBackgroundPriority ? ENamedThreads::AnyBackgroundThreadNormalTask : ENamedThreads::AnyHiPriThreadHiPriTask;
+
+		TParallelForAdaptiveData<FunctionType>* DataPtr = new TParallelForAdaptiveData<FunctionType>(Num, AnyThreadTasks + 1, MinBatchSize, Body, EstimateCost);
+		TSharedRef<TParallelForAdaptiveData<FunctionType>, ESPMode::ThreadSafe> Data = MakeShareable(DataPtr);
+		TGraphTask<TParallelForAdaptiveTask<FunctionType>>::CreateTask().ConstructAndDispatchWhenReady(Data, DesiredThread, AnyThreadTasks - 1);
+		// this thread is participant 0. It steals whatever the helpers have not started, so it only ever waits for batches
+		// that are already running somewhere else, which is what makes nesting safe even when every worker is busy.
+		if (!Data->Process(0))
+		{
+			if (bPumpRenderingThread && IsInActualRenderingThread())
+			{
+				while (!Data->Event->Wait(1))
+				{
+					FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GetRenderThread_Local());
+				}
+			}
+			else
+			{
+				Data->Event->Wait();
+			}
+			check(Data->bTriggered);
+		}
+		else
+		{
+			check(!Data->bTriggered);
+		}
+		check(Data->NumCompleted.GetValue() == Data->Num);
+		Data->bExited = true;
+		// Data must live on until all of the tasks are cleared which might be long after this function exits
+	}
 }
 
 /** 
@@ -383,3 +665,32 @@ inline void ParallelForWithPreWork(int32 Num, TFunctionRef<void(int32)> Body, TF
 {
 	ParallelForImpl::ParallelForWithPreWorkInternal(Num, Body, CurrentThreadWorkToDoBeforeHelping, Flags);
 }
+
+/**
+	*	Parallel for with dynamic load balancing, for bodies whose cost varies a lot from one index to the next.
+	*	Each thread owns a range of indices and takes batches from its front, a thread that runs out steals half of the largest range left.
+	*	The calling thread takes part and only ever waits for batches already running on other threads, so it is safe to nest.
+	*	@param Num; number of calls of Body; Body(0), Body(1)....Body(Num - 1)
+	*	@param Body; Function to call from multiple threads
+	*	@param MinBatchSize; Smallest number of indices handed out at once, raise it when Body is very cheap.
+	*	@param Flags; Used to customize the behavior of the ParallelFor if needed. Unbalanced is implied.
+	*	Notes: Please add stats around to calls to parallel for and within your lambda as appropriate. Do not clog the task graph with long running tasks or tasks that block.
+**/
+inline void ParallelForAdaptive(int32 Num, TFunctionRef<void(int32)> Body, int32 MinBatchSize = 1, EParallelForFlags Flags = EParallelForFlags::None)
+{
+	ParallelForImpl::ParallelForAdaptiveInternal(Num, Body, nullptr, MinBatchSize, Flags);
+}
+
+/**
+	*	Same as ParallelForAdaptive, but ranges are split by estimated cost instead of by number of indices.
+	*	Worth it when the cost of an index is known up front, e.g. the number of triangles, so the first split is already right.
+	*	@param Num; number of calls of Body; Body(0), Body(1)....Body(Num - 1)
+	*	@param Body; Function to call from multiple threads
+	*	@param EstimateCost; Relative cost of an index, called once per index on the calling thread before any work starts.
+	*	@param MinBatchSize; Smallest number of indices handed out at once, raise it when Body is very cheap.
+	*	@param Flags; Used to customize the behavior of the ParallelFor if needed. Unbalanced is implied.
+**/
+inline void ParallelForAdaptiveWithCost(int32 Num, TFunctionRef<void(int32)> Body, TFunctionRef<float(int32)> EstimateCost, int32 MinBatchSize = 1, EParallelForFlags Flags = EParallelForFlags::None)
+{
+	ParallelForImpl::ParallelForAdaptiveInternal(Num, Body, &EstimateCost, MinBatchSize, Flags);
+}
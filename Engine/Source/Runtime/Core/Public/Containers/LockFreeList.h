@@ -770,6 +770,31 @@ public:
 		return nullptr;
 	}
 
+	/**
+	 * Clears the stall bit of one stalled thread without pushing anything, for work made available outside of this queue.
+	 * @return index of the thread the caller must wake, or -1 if no thread is stalled
+	 */
+	int32 ClaimStalledThread()
+	{
+		while (true)
+		{
+			TDoublePtr LocalMasterState;
+			LocalMasterState.AtomicRead(MasterState);
+			int32 ThreadToWake = FindThreadToWake(LocalMasterState.GetPtr());
+			if (ThreadToWake < 0)
+			{
+				return -1;
+			}
+			TDoublePtr NewMasterState;
+			NewMasterState.AdvanceCounterAndState(LocalMasterState, 1);
+			NewMasterState.SetPtr(TurnOffBit(LocalMasterState.GetPtr(), ThreadToWake));
+			if (MasterState.InterlockedCompareExchange(NewMasterState, LocalMasterState))
+			{
+				return ThreadToWake;
+			}
+		}
+	}
+
 private:
 
 	static int32 FindThreadToWake(TLinkPtr Ptr)
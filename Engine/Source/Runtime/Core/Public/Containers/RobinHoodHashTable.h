@@ -0,0 +1,1244 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Misc/AssertionMacros.h"
+#include "Serialization/Archive.h"
+#include "Templates/ChooseClass.h"
+#include "Templates/MemoryOps.h"
+#include "Templates/TypeCompatibleBytes.h"
+#include "Templates/UnrealTemplate.h"
+
+/**
+ * Open addressing hash map and set with robin hood probing, mostly interface compatible with TMap and TSet.
+ *
+ * Elements live in a dense array and the hash table is a flat array of buckets holding a key hash and an element index.
+ * A lookup probes consecutive buckets and only touches an element once the full 31 bit hash matched, which is
+ * usually one cache miss for the buckets and one for the element. Robin hood ordering keeps probe sequences short
+ * and lets a missing key stop probing early, removal shifts the following buckets back so there are no tombstones.
+ *
+ * Element ids (FRobinHoodElementId) stay valid until the element is removed, other elements never move when
+ * adding or removing. Like TMap, references to elements are only valid until the next element is added.
+ *
+ * The Allocator is an array allocator (FDefaultAllocator, TInlineAllocator, ...) used for all internal arrays.
+ * KeyFuncs is used for GetKeyHash and Matches, its result is mixed before use so identity hashes of integers
+ * and pointers are fine.
+ */
+
+namespace RobinHoodHashTable_Private
+{
+	template<typename, typename, typename, typename>
+	class TRobinHoodHashTable;
+}
+
+/** Hash of a key as stored in a TRobinHoodMap or TRobinHoodSet, computed by ComputeHash for the ByHash functions. */
+class FRobinHoodHash
+{
+public:
+	FRobinHoodHash() : Hash(FreeHash) {}
+
+	FORCEINLINE bool operator==(FRobinHoodHash Other) const
+	{
+		return Hash == Other.Hash;
+	}
+
+	FORCEINLINE bool operator!=(FRobinHoodHash Other) const
+	{
+		return Hash != Other.Hash;
+	}
+
+private:
+	template<typename, typename, typename, typename>
+	friend class RobinHoodHashTable_Private::TRobinHoodHashTable;
+
+	FORCEINLINE explicit FRobinHoodHash(uint32 InHash) : Hash(InHash)
+	{
+		checkSlow(!(InHash & FreeHash));
+	}
+
+	FORCEINLINE bool IsFree() const
+	{
+		return Hash == FreeHash;
+	}
+
+	FORCEINLINE uint32 AsUInt() const
+	{
+		return Hash;
+	}
+
+	/** The top bit is never set in a key hash and marks free buckets and elements */
+	static constexpr uint32 FreeHash = 1u << 31;
+
+	uint32 Hash;
+};
+
+/** Identifies an element of a TRobinHoodMap or TRobinHoodSet until it is removed. */
+class FRobinHoodElementId
+{
+public:
+	FRobinHoodElementId() : Index(INDEX_NONE) {}
+	FORCEINLINE FRobinHoodElementId(int32 InIndex) : Index(InIndex) {}
+
+	FORCEINLINE int32 GetIndex() const
+	{
+		return Index;
+	}
+
+	FORCEINLINE bool IsValid() const
+	{
+		return Index != INDEX_NONE;
+	}
+
+	FORCEINLINE bool operator==(FRobinHoodElementId Other) const
+	{
+		return Index == Other.Index;
+	}
+
+	FORCEINLINE bool operator!=(FRobinHoodElementId Other) const
+	{
+		return Index != Other.Index;
+	}
+
+private:
+	int32 Index;
+};
+
+namespace RobinHoodHashTable_Private
+{
+	struct FUnitType
+	{
+	};
+
+	/** Finalizer of MurmurHash3, the bucket comes from the low bits and many GetTypeHash overloads return their input */
+	FORCEINLINE uint32 MixHash(uint32 Hash)
+	{
+		Hash ^= Hash >> 16;
+		Hash *= 0x85ebca6bu;
+		Hash ^= Hash >> 13;
+		Hash *= 0xc2b2ae35u;
+		Hash ^= Hash >> 16;
+		return Hash;
+	}
+
+	/** Map elements are key value pairs */
+	template<typename KeyType, typename ValueType>
+	struct TElementTraits
+	{
+		using ElementType = TPair<const KeyType, ValueType>;
+
+		static FORCEINLINE const KeyType& GetKey(const ElementType& Element)
+		{
+			return Element.Key;
+		}
+	};
+
+	/** Set elements are their own keys */
+	template<typename KeyType>
+	struct TElementTraits<KeyType, FUnitType>
+	{
+		using ElementType = const KeyType;
+
+		static FORCEINLINE const KeyType& GetKey(const KeyType& Element)
+		{
+			return Element;
+		}
+	};
+
+	template<typename KeyType, typename ValueType, typename KeyFuncs, typename Allocator>
+	class TRobinHoodHashTable
+	{
+	public:
+		using ElementType = typename TElementTraits<KeyType, ValueType>::ElementType;
+
+	private:
+		using StorageType = typename TRemoveConst<ElementType>::Type;
+
+		/** Slot of the open addressing table, free buckets have a free hash */
+		struct FBucket
+		{
+			FRobinHoodHash Hash;
+			uint32 Index = 0;
+		};
+
+		/** The table grows once it would be more than 4/5 full */
+		static constexpr uint64 LoadFactorNumerator = 4;
+		static constexpr uint64 LoadFactorDenominator = 5;
+		static constexpr int32 MinNumBuckets = 8;
+
+	public:
+		TRobinHoodHashTable() = default;
+
+		TRobinHoodHashTable(const TRobinHoodHashTable& Other)
+		{
+			CopyFrom(Other);
+		}
+
+		TRobinHoodHashTable(TRobinHoodHashTable&& Other)
+			: Elements(MoveTemp(Other.Elements))
+			, ElementHashes(MoveTemp(Other.ElementHashes))
+			, FreeIndices(MoveTemp(Other.FreeIndices))
+			, Buckets(MoveTemp(Other.Buckets))
+			, NumElements(Other.NumElements)
+		{
+			Other.Empty();
+		}
+
+		TRobinHoodHashTable& operator=(const TRobinHoodHashTable& Other)
+		{
+			if (this != &Other)
+			{
+				DestructElements();
+				CopyFrom(Other);
+			}
+			return *this;
+		}
+
+		TRobinHoodHashTable& operator=(TRobinHoodHashTable&& Other)
+		{
+			if (this != &Other)
+			{
+				DestructElements();
+				Elements = MoveTemp(Other.Elements);
+				ElementHashes = MoveTemp(Other.ElementHashes);
+				FreeIndices = MoveTemp(Other.FreeIndices);
+				Buckets = MoveTemp(Other.Buckets);
+				NumElements = Other.NumElements;
+				Other.Empty();
+			}
+			return *this;
+		}
+
+		~TRobinHoodHashTable()
+		{
+			DestructElements();
+		}
+
+		/** Hash of a key for the ByHash functions, can be computed before taking a lock that protects the container. */
+		FORCEINLINE FRobinHoodHash ComputeHash(const KeyType& Key) const
+		{
+			return FRobinHoodHash(MixHash(KeyFuncs::GetKeyHash(Key)) & ~FRobinHoodHash::FreeHash);
+		}
+
+		/** @return The number of elements. */
+		FORCEINLINE int32 Num() const
+		{
+			return NumElements;
+		}
+
+		/** @return One past the highest element id in use, for arrays indexed by element id. */
+		FORCEINLINE int32 GetMaxIndex() const
+		{
+			return Elements.Num();
+		}
+
+		FORCEINLINE bool IsValidId(FRobinHoodElementId Id) const
+		{
+			return Id.IsValid() && Id.GetIndex() < Elements.Num() && !ElementHashes[Id.GetIndex()].IsFree();
+		}
+
+		FORCEINLINE ElementType& GetByElementId(FRobinHoodElementId Id)
+		{
+			checkSlow(IsValidId(Id));
+			return GetElement(Id.GetIndex());
+		}
+
+		FORCEINLINE const ElementType& GetByElementId(FRobinHoodElementId Id) const
+		{
+			checkSlow(IsValidId(Id));
+			return GetElement(Id.GetIndex());
+		}
+
+		/** @return The id of the element with a key and its precomputed hash, or an invalid id. */
+		FORCEINLINE FRobinHoodElementId FindIdByHash(FRobinHoodHash HashValue, const KeyType& Key) const
+		{
+			checkSlow(HashValue == ComputeHash(Key));
+			const int32 BucketIndex = FindBucket(HashValue, Key);
+			return BucketIndex != INDEX_NONE ? FRobinHoodElementId(int32(Buckets[BucketIndex].Index)) : FRobinHoodElementId();
+		}
+
+		/** @return The id of the element with a key, or an invalid id. */
+		FORCEINLINE FRobinHoodElementId FindId(const KeyType& Key) const
+		{
+			return FindIdByHash(ComputeHash(Key), Key);
+		}
+
+		/**
+		 * Removes the element with a key and its precomputed hash.
+		 *
+		 * @return Whether the key was found.
+		 */
+		bool RemoveByHash(FRobinHoodHash HashValue, const KeyType& Key)
+		{
+			checkSlow(HashValue == ComputeHash(Key));
+			const int32 BucketIndex = FindBucket(HashValue, Key);
+			if (BucketIndex == INDEX_NONE)
+			{
+				return false;
+			}
+
+			RemoveElement(Buckets[BucketIndex].Index, uint32(BucketIndex));
+			return true;
+		}
+
+		/**
+		 * Removes an element by id, ids of the other elements stay the same.
+		 *
+		 * @return Whether the id was valid.
+		 */
+		bool RemoveByElementId(FRobinHoodElementId Id)
+		{
+			if (!IsValidId(Id))
+			{
+				return false;
+			}
+
+			const uint32 Index = uint32(Id.GetIndex());
+			const FRobinHoodHash HashValue = ElementHashes[Index];
+			const FBucket* BucketData = Buckets.GetData();
+			const uint32 Mask = GetBucketMask();
+			uint32 BucketIndex = HashValue.AsUInt() & Mask;
+			while (BucketData[BucketIndex].Index != Index || BucketData[BucketIndex].Hash != HashValue)
+			{
+				BucketIndex = (BucketIndex + 1) & Mask;
+			}
+
+			RemoveElement(Index, BucketIndex);
+			return true;
+		}
+
+		/**
+		 * Removes all elements, potentially leaving space allocated for an expected number of elements about to be added.
+		 *
+		 * @param ExpectedNumElements The number of elements about to be added.
+		 */
+		void Empty(int32 ExpectedNumElements = 0)
+		{
+			DestructElements();
+			Elements.Empty(ExpectedNumElements);
+			ElementHashes.Empty(ExpectedNumElements);
+			FreeIndices.Empty();
+			Buckets.Empty();
+			NumElements = 0;
+
+			if (ExpectedNumElements > 0)
+			{
+				Rehash(GetNumBucketsFor(ExpectedNumElements));
+			}
+		}
+
+		/** Removes all elements but keeps the allocations. */
+		void Reset()
+		{
+			DestructElements();
+			Elements.Reset();
+			ElementHashes.Reset();
+			FreeIndices.Reset();
+			for (FBucket& Bucket : Buckets)
+			{
+				Bucket = FBucket();
+			}
+			NumElements = 0;
+		}
+
+		/** Preallocates enough memory to contain Number elements without growing. */
+		void Reserve(int32 Number)
+		{
+			if (Number > NumElements)
+			{
+				Elements.Reserve(Number);
+				ElementHashes.Reserve(Number);
+				ConditionalGrow(Number);
+			}
+		}
+
+		/** Releases slack and shrinks the table to fit the current elements, element ids stay the same. */
+		void Shrink()
+		{
+			int32 NewMaxIndex = Elements.Num();
+			while (NewMaxIndex > 0 && ElementHashes[NewMaxIndex - 1].IsFree())
+			{
+				--NewMaxIndex;
+			}
+
+			if (NewMaxIndex < Elements.Num())
+			{
+				Elements.RemoveAt(NewMaxIndex, Elements.Num() - NewMaxIndex, false);
+				ElementHashes.RemoveAt(NewMaxIndex, ElementHashes.Num() - NewMaxIndex, false);
+				FreeIndices.RemoveAllSwap([NewMaxIndex](uint32 Index) { return Index >= uint32(NewMaxIndex); }, false);
+			}
+
+			Elements.Shrink();
+			ElementHashes.Shrink();
+			FreeIndices.Shrink();
+
+			const int32 NumBuckets = NumElements > 0 ? GetNumBucketsFor(NumElements) : 0;
+			if (NumBuckets < Buckets.Num())
+			{
+				Rehash(NumBuckets);
+			}
+		}
+
+		/**
+		 * Helper function to return the amount of memory allocated by this container.
+		 * Only returns the size of allocations made directly by the container, not the elements themselves.
+		 */
+		SIZE_T GetAllocatedSize() const
+		{
+			return Elements.GetAllocatedSize() + ElementHashes.GetAllocatedSize() + FreeIndices.GetAllocatedSize() + Buckets.GetAllocatedSize();
+		}
+
+		/** Tracks the container's memory use through an archive. */
+		void CountBytes(FArchive& Ar) const
+		{
+			Elements.CountBytes(Ar);
+			ElementHashes.CountBytes(Ar);
+			FreeIndices.CountBytes(Ar);
+			Buckets.CountBytes(Ar);
+		}
+
+	protected:
+		/** Iterates elements in element id order */
+		template<bool bConst>
+		class TBaseIterator
+		{
+		protected:
+			using TableType = typename TChooseClass<bConst, const TRobinHoodHashTable, TRobinHoodHashTable>::Result;
+			using ItElementType = typename TChooseClass<bConst, const ElementType, ElementType>::Result;
+
+		public:
+			FORCEINLINE explicit TBaseIterator(TableType& InTable, int32 InIndex = 0)
+				: Table(InTable)
+				, Index(InIndex)
+			{
+				SkipFree();
+			}
+
+			FORCEINLINE TBaseIterator& operator++()
+			{
+				++Index;
+				SkipFree();
+				return *this;
+			}
+
+			FORCEINLINE explicit operator bool() const
+			{
+				return Index < Table.Elements.Num();
+			}
+
+			FORCEINLINE bool operator!() const
+			{
+				return !(bool)*this;
+			}
+
+			FORCEINLINE bool operator==(const TBaseIterator& Rhs) const
+			{
+				return Index == Rhs.Index && &Table == &Rhs.Table;
+			}
+
+			FORCEINLINE bool operator!=(const TBaseIterator& Rhs) const
+			{
+				return Index != Rhs.Index || &Table != &Rhs.Table;
+			}
+
+			FORCEINLINE ItElementType& operator*() const
+			{
+				return Table.GetElement(Index);
+			}
+
+			FORCEINLINE ItElementType* operator->() const
+			{
+				return &Table.GetElement(Index);
+			}
+
+			FORCEINLINE FRobinHoodElementId GetId() const
+			{
+				return FRobinHoodElementId(Index);
+			}
+
+		protected:
+			FORCEINLINE void SkipFree()
+			{
+				while (Index < Table.Elements.Num() && Table.IsFreeElement(Index))
+				{
+					++Index;
+				}
+			}
+
+			TableType& Table;
+			int32 Index;
+		};
+
+	public:
+		/** Ranged-for support, removing elements while iterating needs CreateIterator and RemoveCurrent. */
+		FORCEINLINE TBaseIterator<false> begin()		{ return TBaseIterator<false>(*this); }
+		FORCEINLINE TBaseIterator<true> begin() const	{ return TBaseIterator<true>(*this); }
+		FORCEINLINE TBaseIterator<false> end()			{ return TBaseIterator<false>(*this, Elements.Num()); }
+		FORCEINLINE TBaseIterator<true> end() const		{ return TBaseIterator<true>(*this, Elements.Num()); }
+
+	protected:
+		/** Adds a new element if there is none with the key, ElementArgs construct the element. */
+		template<typename... ArgTypes>
+		FORCEINLINE FRobinHoodElementId FindOrAddIdImpl(FRobinHoodHash HashValue, const KeyType& Key, bool& bIsAlreadyInTable, ArgTypes&&... ElementArgs)
+		{
+			checkSlow(HashValue == ComputeHash(Key));
+			const int32 BucketIndex = FindBucket(HashValue, Key);
+			bIsAlreadyInTable = BucketIndex != INDEX_NONE;
+			if (bIsAlreadyInTable)
+			{
+				return FRobinHoodElementId(int32(Buckets[BucketIndex].Index));
+			}
+
+			return AddNew(HashValue, Forward<ArgTypes>(ElementArgs)...);
+		}
+
+		/** Adds a new element or replaces the one with the key in place, keeping its id. */
+		template<typename... ArgTypes>
+		FRobinHoodElementId AddOrReplace(FRobinHoodHash HashValue, const KeyType& Key, bool* bIsAlreadyInTablePtr, ArgTypes&&... ElementArgs)
+		{
+			checkSlow(HashValue == ComputeHash(Key));
+			const int32 BucketIndex = FindBucket(HashValue, Key);
+			if (bIsAlreadyInTablePtr)
+			{
+				*bIsAlreadyInTablePtr = BucketIndex != INDEX_NONE;
+			}
+
+			if (BucketIndex == INDEX_NONE)
+			{
+				return AddNew(HashValue, Forward<ArgTypes>(ElementArgs)...);
+			}
+
+			const uint32 Index = Buckets[BucketIndex].Index;
+			DestructItem(GetStorage(Index));
+			new (GetStorage(Index)) StorageType(Forward<ArgTypes>(ElementArgs)...);
+			checkSlow(ComputeHash(TElementTraits<KeyType, ValueType>::GetKey(GetElement(Index))) == HashValue);
+			return FRobinHoodElementId(int32(Index));
+		}
+
+		/** Adds an element whose key must not be in the table yet */
+		template<typename... ArgTypes>
+		FRobinHoodElementId AddNew(FRobinHoodHash HashValue, ArgTypes&&... ElementArgs)
+		{
+			ConditionalGrow(NumElements + 1);
+
+			uint32 Index;
+			if (FreeIndices.Num() > 0)
+			{
+				Index = FreeIndices.Pop(false);
+			}
+			else
+			{
+				Index = uint32(Elements.AddUninitialized());
+				ElementHashes.AddUninitialized();
+			}
+
+			new (GetStorage(Index)) StorageType(Forward<ArgTypes>(ElementArgs)...);
+			ElementHashes[Index] = HashValue;
+			++NumElements;
+
+			InsertIntoBuckets(FBucket{ HashValue, Index });
+			return FRobinHoodElementId(int32(Index));
+		}
+
+	private:
+		FORCEINLINE StorageType* GetStorage(uint32 Index) const
+		{
+			return (StorageType*)(Elements.GetData() + Index);
+		}
+
+		FORCEINLINE ElementType& GetElement(uint32 Index)
+		{
+			return *GetStorage(Index);
+		}
+
+		FORCEINLINE const ElementType& GetElement(uint32 Index) const
+		{
+			return *GetStorage(Index);
+		}
+
+		FORCEINLINE bool IsFreeElement(int32 Index) const
+		{
+			return ElementHashes[Index].IsFree();
+		}
+
+		FORCEINLINE const KeyType& GetKey(uint32 Index) const
+		{
+			return TElementTraits<KeyType, ValueType>::GetKey(GetElement(Index));
+		}
+
+		FORCEINLINE uint32 GetBucketMask() const
+		{
+			return uint32(Buckets.Num()) - 1;
+		}
+
+		/** How far a bucket is from the one its hash maps to */
+		static FORCEINLINE uint32 GetProbeDistance(const FBucket& Bucket, uint32 BucketIndex, uint32 Mask)
+		{
+			return (BucketIndex - Bucket.Hash.AsUInt()) & Mask;
+		}
+
+		FORCEINLINE int32 FindBucket(FRobinHoodHash HashValue, const KeyType& Key) const
+		{
+			if (NumElements == 0)
+			{
+				return INDEX_NONE;
+			}
+
+			const FBucket* RESTRICT BucketData = Buckets.GetData();
+			const uint32 Mask = GetBucketMask();
+			uint32 BucketIndex = HashValue.AsUInt() & Mask;
+			for (uint32 Distance = 0;; ++Distance)
+			{
+				const FBucket& Bucket = BucketData[BucketIndex];
+				if (Bucket.Hash == HashValue)
+				{
+					if (KeyFuncs::Matches(Key, GetKey(Bucket.Index)))
+					{
+						return int32(BucketIndex);
+					}
+				}
+				else if (Bucket.Hash.IsFree() || GetProbeDistance(Bucket, BucketIndex, Mask) < Distance)
+				{
+					// The key would have taken this bucket from an element closer to its own
+					return INDEX_NONE;
+				}
+
+				BucketIndex = (BucketIndex + 1) & Mask;
+			}
+		}
+
+		void InsertIntoBuckets(FBucket Insert)
+		{
+			FBucket* RESTRICT BucketData = Buckets.GetData();
+			const uint32 Mask = GetBucketMask();
+			uint32 BucketIndex = Insert.Hash.AsUInt() & Mask;
+			for (uint32 Distance = 0;; ++Distance)
+			{
+				FBucket& Bucket = BucketData[BucketIndex];
+				if (Bucket.Hash.IsFree())
+				{
+					Bucket = Insert;
+					return;
+				}
+
+				// Take the bucket from elements closer to their own, the displaced one keeps probing
+				const uint32 BucketDistance = GetProbeDistance(Bucket, BucketIndex, Mask);
+				if (BucketDistance < Distance)
+				{
+					Swap(Bucket, Insert);
+					Distance = BucketDistance;
+				}
+
+				BucketIndex = (BucketIndex + 1) & Mask;
+			}
+		}
+
+		void RemoveElement(uint32 Index, uint32 BucketIndex)
+		{
+			// Shift the following buckets of the probe sequence back instead of leaving a tombstone
+			FBucket* RESTRICT BucketData = Buckets.GetData();
+			const uint32 Mask = GetBucketMask();
+			for (;;)
+			{
+				const uint32 NextBucketIndex = (BucketIndex + 1) & Mask;
+				const FBucket& NextBucket = BucketData[NextBucketIndex];
+				if (NextBucket.Hash.IsFree() || GetProbeDistance(NextBucket, NextBucketIndex, Mask) == 0)
+				{
+					break;
+				}
+
+				BucketData[BucketIndex] = NextBucket;
+				BucketIndex = NextBucketIndex;
+			}
+			BucketData[BucketIndex] = FBucket();
+
+			DestructItem(GetStorage(Index));
+			ElementHashes[Index] = FRobinHoodHash();
+			--NumElements;
+
+			if (NumElements == 0)
+			{
+				Elements.Reset();
+				ElementHashes.Reset();
+				FreeIndices.Reset();
+			}
+			else if (Index == uint32(Elements.Num() - 1))
+			{
+				Elements.Pop(false);
+				ElementHashes.Pop(false);
+			}
+			else
+			{
+				FreeIndices.Add(Index);
+			}
+		}
+
+		static int32 GetNumBucketsFor(int32 Number)
+		{
+			int32 NumBuckets = MinNumBuckets;
+			while (uint64(Number) * LoadFactorDenominator > uint64(NumBuckets) * LoadFactorNumerator)
+			{
+				NumBuckets *= 2;
+			}
+			return NumBuckets;
+		}
+
+		FORCEINLINE void ConditionalGrow(int32 Number)
+		{
+			if (uint64(Number) * LoadFactorDenominator > uint64(Buckets.Num()) * LoadFactorNumerator)
+			{
+				Rehash(GetNumBucketsFor(Number));
+			}
+		}
+
+		void Rehash(int32 NumBuckets)
+		{
+			Buckets.Empty(NumBuckets);
+			Buckets.AddDefaulted(NumBuckets);
+
+			for (int32 Index = 0; Index < ElementHashes.Num(); ++Index)
+			{
+				if (!ElementHashes[Index].IsFree())
+				{
+					InsertIntoBuckets(FBucket{ ElementHashes[Index], uint32(Index) });
+				}
+			}
+		}
+
+		void DestructElements()
+		{
+			if (!TIsTriviallyDestructible<StorageType>::Value)
+			{
+				for (int32 Index = 0; Index < ElementHashes.Num(); ++Index)
+				{
+					if (!ElementHashes[Index].IsFree())
+					{
+						DestructItem(GetStorage(Index));
+					}
+				}
+			}
+		}
+
+		/** Copies into a table whose elements are already destructed */
+		void CopyFrom(const TRobinHoodHashTable& Other)
+		{
+			ElementHashes = Other.ElementHashes;
+			FreeIndices = Other.FreeIndices;
+			Buckets = Other.Buckets;
+			NumElements = Other.NumElements;
+
+			Elements.Reset(Other.Elements.Num());
+			Elements.AddUninitialized(Other.Elements.Num());
+			for (int32 Index = 0; Index < ElementHashes.Num(); ++Index)
+			{
+				if (!ElementHashes[Index].IsFree())
+				{
+					new (GetStorage(Index)) StorageType(Other.GetElement(Index));
+				}
+			}
+		}
+
+		TArray<TTypeCompatibleBytes<StorageType>, Allocator> Elements;
+		/** Hash of each element, free for removed elements */
+		TArray<FRobinHoodHash, Allocator> ElementHashes;
+		TArray<uint32, Allocator> FreeIndices;
+		/** Power of two sized open addressing table, empty until the first element is added */
+		TArray<FBucket, Allocator> Buckets;
+		int32 NumElements = 0;
+	};
+}
+
+/**
+ * A map of unique keys to values with the interface of TMap, see the top of this file for how it differs.
+ */
+template<typename KeyType, typename ValueType, typename Allocator = FDefaultAllocator, typename KeyFuncs = TDefaultMapHashableKeyFuncs<KeyType, ValueType, false>>
+class TRobinHoodMap : public RobinHoodHashTable_Private::TRobinHoodHashTable<KeyType, ValueType, KeyFuncs, Allocator>
+{
+	using Super = RobinHoodHashTable_Private::TRobinHoodHashTable<KeyType, ValueType, KeyFuncs, Allocator>;
+
+public:
+	using ElementType = typename Super::ElementType;
+
+	TRobinHoodMap() = default;
+	TRobinHoodMap(TRobinHoodMap&&) = default;
+	TRobinHoodMap(const TRobinHoodMap&) = default;
+	TRobinHoodMap& operator=(TRobinHoodMap&&) = default;
+	TRobinHoodMap& operator=(const TRobinHoodMap&) = default;
+
+	/**
+	 * Sets the value associated with a key.
+	 *
+	 * @return A reference to the value as stored in the map (only valid until the next element is added).
+	 */
+	FORCEINLINE ValueType& Add(const KeyType&  InKey, const ValueType&  InValue) { return Emplace(         InKey ,          InValue ); }
+	FORCEINLINE ValueType& Add(const KeyType&  InKey,       ValueType&& InValue) { return Emplace(         InKey , MoveTemp(InValue)); }
+	FORCEINLINE ValueType& Add(      KeyType&& InKey, const ValueType&  InValue) { return Emplace(MoveTemp(InKey),          InValue ); }
+	FORCEINLINE ValueType& Add(      KeyType&& InKey,       ValueType&& InValue) { return Emplace(MoveTemp(InKey), MoveTemp(InValue)); }
+
+	/** Sets a default value associated with a key. */
+	FORCEINLINE ValueType& Add(const KeyType&  InKey) { return Emplace(         InKey ); }
+	FORCEINLINE ValueType& Add(      KeyType&& InKey) { return Emplace(MoveTemp(InKey)); }
+
+	/** Sets the value associated with a key, an existing pair is replaced in place and keeps its element id. */
+	template<typename InitKeyType, typename InitValueType>
+	ValueType& Emplace(InitKeyType&& InKey, InitValueType&& InValue)
+	{
+		const KeyType& Key = InKey;
+		const FRobinHoodElementId Id = this->AddOrReplace(this->ComputeHash(Key), Key, nullptr, Forward<InitKeyType>(InKey), Forward<InitValueType>(InValue));
+		return this->GetByElementId(Id).Value;
+	}
+
+	template<typename InitKeyType>
+	ValueType& Emplace(InitKeyType&& InKey)
+	{
+		const KeyType& Key = InKey;
+		const FRobinHoodElementId Id = this->AddOrReplace(this->ComputeHash(Key), Key, nullptr, Forward<InitKeyType>(InKey), ValueType());
+		return this->GetByElementId(Id).Value;
+	}
+
+	/** @return A reference to the value associated with a key, adding a default constructed value if there is none. */
+	FORCEINLINE ValueType& FindOrAdd(const KeyType&  Key) { return FindOrAddImpl(         Key , ValueType()); }
+	FORCEINLINE ValueType& FindOrAdd(      KeyType&& Key) { return FindOrAddImpl(MoveTemp(Key), ValueType()); }
+
+	/** @return A reference to the value associated with a key, adding Value if there is none. */
+	FORCEINLINE ValueType& FindOrAdd(const KeyType&  Key, const ValueType&  Value) { return FindOrAddImpl(         Key ,          Value ); }
+	FORCEINLINE ValueType& FindOrAdd(const KeyType&  Key,       ValueType&& Value) { return FindOrAddImpl(         Key , MoveTemp(Value)); }
+	FORCEINLINE ValueType& FindOrAdd(      KeyType&& Key, const ValueType&  Value) { return FindOrAddImpl(MoveTemp(Key),          Value ); }
+	FORCEINLINE ValueType& FindOrAdd(      KeyType&& Key,       ValueType&& Value) { return FindOrAddImpl(MoveTemp(Key), MoveTemp(Value)); }
+
+	/** Id based FindOrAdd, the hash can be computed up front with ComputeHash. An existing value is left untouched. */
+	template<typename InitKeyType, typename InitValueType>
+	FORCEINLINE FRobinHoodElementId FindOrAddIdByHash(FRobinHoodHash HashValue, InitKeyType&& Key, InitValueType&& Value, bool& bIsAlreadyInMap)
+	{
+		return this->FindOrAddIdImpl(HashValue, Key, bIsAlreadyInMap, Forward<InitKeyType>(Key), Forward<InitValueType>(Value));
+	}
+
+	template<typename InitKeyType, typename InitValueType>
+	FORCEINLINE FRobinHoodElementId FindOrAddIdByHash(FRobinHoodHash HashValue, InitKeyType&& Key, InitValueType&& Value)
+	{
+		bool bIsAlreadyInMap;
+		return FindOrAddIdByHash(HashValue, Forward<InitKeyType>(Key), Forward<InitValueType>(Value), bIsAlreadyInMap);
+	}
+
+	template<typename InitKeyType, typename InitValueType>
+	FORCEINLINE FRobinHoodElementId FindOrAddId(InitKeyType&& Key, InitValueType&& Value, bool& bIsAlreadyInMap)
+	{
+		const FRobinHoodHash HashValue = this->ComputeHash(Key);
+		return FindOrAddIdByHash(HashValue, Forward<InitKeyType>(Key), Forward<InitValueType>(Value), bIsAlreadyInMap);
+	}
+
+	template<typename InitKeyType, typename InitValueType>
+	FORCEINLINE FRobinHoodElementId FindOrAddId(InitKeyType&& Key, InitValueType&& Value)
+	{
+		bool bIsAlreadyInMap;
+		return FindOrAddId(Forward<InitKeyType>(Key), Forward<InitValueType>(Value), bIsAlreadyInMap);
+	}
+
+	/** @return A pointer to the value associated with a key, or nullptr (only valid until the next element is added). */
+	FORCEINLINE ValueType* Find(const KeyType& Key)
+	{
+		return FindByHash(this->ComputeHash(Key), Key);
+	}
+
+	FORCEINLINE const ValueType* Find(const KeyType& Key) const
+	{
+		return const_cast<TRobinHoodMap*>(this)->Find(Key);
+	}
+
+	FORCEINLINE ValueType* FindByHash(FRobinHoodHash HashValue, const KeyType& Key)
+	{
+		const FRobinHoodElementId Id = this->FindIdByHash(HashValue, Key);
+		return Id.IsValid() ? &this->GetByElementId(Id).Value : nullptr;
+	}
+
+	FORCEINLINE const ValueType* FindByHash(FRobinHoodHash HashValue, const KeyType& Key) const
+	{
+		return const_cast<TRobinHoodMap*>(this)->FindByHash(HashValue, Key);
+	}
+
+	/** @return The value associated with a key, triggers an assertion if the key does not exist. */
+	FORCEINLINE ValueType& FindChecked(const KeyType& Key)
+	{
+		ValueType* Value = Find(Key);
+		check(Value != nullptr);
+		return *Value;
+	}
+
+	FORCEINLINE const ValueType& FindChecked(const KeyType& Key) const
+	{
+		const ValueType* Value = Find(Key);
+		check(Value != nullptr);
+		return *Value;
+	}
+
+	/** @return The value associated with a key, or a default constructed value if the key isn't in the map. */
+	FORCEINLINE ValueType FindRef(const KeyType& Key) const
+	{
+		if (const ValueType* Value = Find(Key))
+		{
+			return *Value;
+		}
+		return ValueType();
+	}
+
+	FORCEINLINE bool Contains(const KeyType& Key) const
+	{
+		return this->FindId(Key).IsValid();
+	}
+
+	/**
+	 * Removes the pair with a key.
+	 *
+	 * @return The number of pairs removed.
+	 */
+	FORCEINLINE int32 Remove(const KeyType& Key)
+	{
+		return this->RemoveByHash(this->ComputeHash(Key), Key) ? 1 : 0;
+	}
+
+	/**
+	 * Removes the pair with a key and moves the removed value to OutRemovedValue.
+	 *
+	 * @return Whether the key was found.
+	 */
+	bool RemoveAndCopyValue(const KeyType& Key, ValueType& OutRemovedValue)
+	{
+		const FRobinHoodElementId Id = this->FindId(Key);
+		if (!Id.IsValid())
+		{
+			return false;
+		}
+
+		OutRemovedValue = MoveTemp(this->GetByElementId(Id).Value);
+		this->RemoveByElementId(Id);
+		return true;
+	}
+
+	/** Removes the pair with a key and returns its value, triggers an assertion if the key does not exist. */
+	ValueType FindAndRemoveChecked(const KeyType& Key)
+	{
+		const FRobinHoodElementId Id = this->FindId(Key);
+		check(Id.IsValid());
+		ValueType OutRemovedValue = MoveTemp(this->GetByElementId(Id).Value);
+		this->RemoveByElementId(Id);
+		return OutRemovedValue;
+	}
+
+	/** @return Whether both maps have the same keys with equal values. */
+	bool OrderIndependentCompareEqual(const TRobinHoodMap& Other) const
+	{
+		if (this->Num() != Other.Num())
+		{
+			return false;
+		}
+
+		for (const ElementType& Pair : *this)
+		{
+			const ValueType* OtherValue = Other.Find(Pair.Key);
+			if (!OtherValue || !(*OtherValue == Pair.Value))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Adds all pairs of another map, values of the other map win for keys in both. */
+	void Append(const TRobinHoodMap& OtherMap)
+	{
+		this->Reserve(this->Num() + OtherMap.Num());
+		for (const ElementType& Pair : OtherMap)
+		{
+			Add(Pair.Key, Pair.Value);
+		}
+	}
+
+	/** Moves all pairs of another map into this one and empties the other map. */
+	void Append(TRobinHoodMap&& OtherMap)
+	{
+		this->Reserve(this->Num() + OtherMap.Num());
+		for (ElementType& Pair : OtherMap)
+		{
+			Add(MoveTemp(const_cast<KeyType&>(Pair.Key)), MoveTemp(Pair.Value));
+		}
+		OtherMap.Reset();
+	}
+
+	/**
+	 * Returns the keys contained within this map.
+	 *
+	 * @return The number of keys in the map.
+	 */
+	template<typename ArrayAllocator>
+	int32 GetKeys(TArray<KeyType, ArrayAllocator>& OutKeys) const
+	{
+		OutKeys.Reset(this->Num());
+		for (const ElementType& Pair : *this)
+		{
+			OutKeys.Add(Pair.Key);
+		}
+		return OutKeys.Num();
+	}
+
+	template<typename ArrayAllocator>
+	void GenerateKeyArray(TArray<KeyType, ArrayAllocator>& OutArray) const
+	{
+		OutArray.Empty(this->Num());
+		for (const ElementType& Pair : *this)
+		{
+			OutArray.Add(Pair.Key);
+		}
+	}
+
+	template<typename ArrayAllocator>
+	void GenerateValueArray(TArray<ValueType, ArrayAllocator>& OutArray) const
+	{
+		OutArray.Empty(this->Num());
+		for (const ElementType& Pair : *this)
+		{
+			OutArray.Add(Pair.Value);
+		}
+	}
+
+	FORCEINLINE       ValueType& operator[](const KeyType& Key)       { return FindChecked(Key); }
+	FORCEINLINE const ValueType& operator[](const KeyType& Key) const { return FindChecked(Key); }
+
+	class TConstIterator : public Super::template TBaseIterator<true>
+	{
+	public:
+		FORCEINLINE explicit TConstIterator(const TRobinHoodMap& InMap)
+			: Super::template TBaseIterator<true>(InMap)
+		{
+		}
+
+		FORCEINLINE const KeyType& Key() const		{ return (**this).Key; }
+		FORCEINLINE const ValueType& Value() const	{ return (**this).Value; }
+	};
+
+	class TIterator : public Super::template TBaseIterator<false>
+	{
+	public:
+		FORCEINLINE explicit TIterator(TRobinHoodMap& InMap)
+			: Super::template TBaseIterator<false>(InMap)
+		{
+		}
+
+		FORCEINLINE const KeyType& Key() const	{ return (**this).Key; }
+		FORCEINLINE ValueType& Value() const	{ return (**this).Value; }
+
+		/** Removes the current pair, the iterator moves on with the next increment. */
+		FORCEINLINE void RemoveCurrent()
+		{
+			this->Table.RemoveByElementId(this->GetId());
+		}
+	};
+
+	FORCEINLINE TIterator CreateIterator()				{ return TIterator(*this); }
+	FORCEINLINE TConstIterator CreateConstIterator() const	{ return TConstIterator(*this); }
+
+	/** Serializer, the format is the same as TMap's. */
+	friend FArchive& operator<<(FArchive& Ar, TRobinHoodMap& Map)
+	{
+		Map.CountBytes(Ar);
+		if (Ar.IsLoading())
+		{
+			int32 NewNumElements = 0;
+			Ar << NewNumElements;
+			Map.Empty(NewNumElements);
+			for (int32 ElementIndex = 0; ElementIndex < NewNumElements; ElementIndex++)
+			{
+				KeyType Key;
+				ValueType Value;
+				Ar << Key;
+				Ar << Value;
+				Map.Emplace(MoveTemp(Key), MoveTemp(Value));
+			}
+		}
+		else
+		{
+			int32 NumElements = Map.Num();
+			Ar << NumElements;
+			for (ElementType& Pair : Map)
+			{
+				Ar << const_cast<KeyType&>(Pair.Key);
+				Ar << Pair.Value;
+			}
+		}
+		return Ar;
+	}
+
+private:
+	template<typename InitKeyType, typename InitValueType>
+	FORCEINLINE ValueType& FindOrAddImpl(InitKeyType&& Key, InitValueType&& Value)
+	{
+		const FRobinHoodElementId Id = FindOrAddId(Forward<InitKeyType>(Key), Forward<InitValueType>(Value));
+		return this->GetByElementId(Id).Value;
+	}
+};
+
+/**
+ * A set of unique keys with the interface of TSet, see the top of this file for how it differs.
+ * Elements are their own keys, KeyFuncs::GetSetKey is not used.
+ */
+template<typename KeyType, typename KeyFuncs = DefaultKeyFuncs<KeyType, false>, typename Allocator = FDefaultAllocator>
+class TRobinHoodSet : public RobinHoodHashTable_Private::TRobinHoodHashTable<KeyType, RobinHoodHashTable_Private::FUnitType, KeyFuncs, Allocator>
+{
+	using Super = RobinHoodHashTable_Private::TRobinHoodHashTable<KeyType, RobinHoodHashTable_Private::FUnitType, KeyFuncs, Allocator>;
+
+public:
+	TRobinHoodSet() = default;
+	TRobinHoodSet(TRobinHoodSet&&) = default;
+	TRobinHoodSet(const TRobinHoodSet&) = default;
+	TRobinHoodSet& operator=(TRobinHoodSet&&) = default;
+	TRobinHoodSet& operator=(const TRobinHoodSet&) = default;
+
+	/**
+	 * Adds an element, replacing an equal one in place.
+	 *
+	 * @param bIsAlreadyInSetPtr Optional, set to whether an equal element was already in the set.
+	 * @return The id of the element.
+	 */
+	FORCEINLINE FRobinHoodElementId Add(const KeyType&  InKey, bool* bIsAlreadyInSetPtr = nullptr) { return Emplace(         InKey , bIsAlreadyInSetPtr); }
+	FORCEINLINE FRobinHoodElementId Add(      KeyType&& InKey, bool* bIsAlreadyInSetPtr = nullptr) { return Emplace(MoveTemp(InKey), bIsAlreadyInSetPtr); }
+
+	template<typename ArgType>
+	FRobinHoodElementId Emplace(ArgType&& Arg, bool* bIsAlreadyInSetPtr = nullptr)
+	{
+		const KeyType& Key = Arg;
+		return this->AddOrReplace(this->ComputeHash(Key), Key, bIsAlreadyInSetPtr, Forward<ArgType>(Arg));
+	}
+
+	/** Id based FindOrAdd, the hash can be computed up front with ComputeHash. An existing element is left untouched. */
+	template<typename InitKeyType>
+	FORCEINLINE FRobinHoodElementId FindOrAddIdByHash(FRobinHoodHash HashValue, InitKeyType&& Key, bool& bIsAlreadyInSet)
+	{
+		return this->FindOrAddIdImpl(HashValue, Key, bIsAlreadyInSet, Forward<InitKeyType>(Key));
+	}
+
+	template<typename InitKeyType>
+	FORCEINLINE FRobinHoodElementId FindOrAddIdByHash(FRobinHoodHash HashValue, InitKeyType&& Key)
+	{
+		bool bIsAlreadyInSet;
+		return FindOrAddIdByHash(HashValue, Forward<InitKeyType>(Key), bIsAlreadyInSet);
+	}
+
+	template<typename InitKeyType>
+	FORCEINLINE FRobinHoodElementId FindOrAddId(InitKeyType&& Key, bool& bIsAlreadyInSet)
+	{
+		const FRobinHoodHash HashValue = this->ComputeHash(Key);
+		return FindOrAddIdByHash(HashValue, Forward<InitKeyType>(Key), bIsAlreadyInSet);
+	}
+
+	template<typename InitKeyType>
+	FORCEINLINE FRobinHoodElementId FindOrAddId(InitKeyType&& Key)
+	{
+		bool bIsAlreadyInSet;
+		return FindOrAddId(Forward<InitKeyType>(Key), bIsAlreadyInSet);
+	}
+
+	/** @return A pointer to the element equal to Key, or nullptr (only valid until the next element is added). */
+	FORCEINLINE const KeyType* Find(const KeyType& Key) const
+	{
+		return FindByHash(this->ComputeHash(Key), Key);
+	}
+
+	FORCEINLINE const KeyType* FindByHash(FRobinHoodHash HashValue, const KeyType& Key) const
+	{
+		const FRobinHoodElementId Id = this->FindIdByHash(HashValue, Key);
+		return Id.IsValid() ? &this->GetByElementId(Id) : nullptr;
+	}
+
+	FORCEINLINE bool Contains(const KeyType& Key) const
+	{
+		return this->FindId(Key).IsValid();
+	}
+
+	/**
+	 * Removes the element equal to Key.
+	 *
+	 * @return The number of elements removed.
+	 */
+	FORCEINLINE int32 Remove(const KeyType& Key)
+	{
+		return this->RemoveByHash(this->ComputeHash(Key), Key) ? 1 : 0;
+	}
+
+	/** Adds all elements of another set. */
+	void Append(const TRobinHoodSet& OtherSet)
+	{
+		this->Reserve(this->Num() + OtherSet.Num());
+		for (const KeyType& Element : OtherSet)
+		{
+			Add(Element);
+		}
+	}
+
+	/** @return The elements as an array. */
+	TArray<KeyType> Array() const
+	{
+		TArray<KeyType> Result;
+		Result.Reserve(this->Num());
+		for (const KeyType& Element : *this)
+		{
+			Result.Add(Element);
+		}
+		return Result;
+	}
+
+	class TConstIterator : public Super::template TBaseIterator<true>
+	{
+	public:
+		FORCEINLINE explicit TConstIterator(const TRobinHoodSet& InSet)
+			: Super::template TBaseIterator<true>(InSet)
+		{
+		}
+	};
+
+	class TIterator : public Super::template TBaseIterator<false>
+	{
+	public:
+		FORCEINLINE explicit TIterator(TRobinHoodSet& InSet)
+			: Super::template TBaseIterator<false>(InSet)
+		{
+		}
+
+		/** Removes the current element, the iterator moves on with the next increment. */
+		FORCEINLINE void RemoveCurrent()
+		{
+			this->Table.RemoveByElementId(this->GetId());
+		}
+	};
+
+	FORCEINLINE TIterator CreateIterator()				{ return TIterator(*this); }
+	FORCEINLINE TConstIterator CreateConstIterator() const	{ return TConstIterator(*this); }
+
+	/** Serializer, the format is the same as TSet's. */
+	friend FArchive& operator<<(FArchive& Ar, TRobinHoodSet& Set)
+	{
+		Set.CountBytes(Ar);
+		if (Ar.IsLoading())
+		{
+			int32 NewNumElements = 0;
+			Ar << NewNumElements;
+			Set.Empty(NewNumElements);
+			for (int32 ElementIndex = 0; ElementIndex < NewNumElements; ElementIndex++)
+			{
+				KeyType Key;
+				Ar << Key;
+				Set.Add(MoveTemp(Key));
+			}
+		}
+		else
+		{
+			int32 NumElements = Set.Num();
+			Ar << NumElements;
+			for (const KeyType& Element : Set)
+			{
+				Ar << const_cast<KeyType&>(Element);
+			}
+		}
+		return Ar;
+	}
+};
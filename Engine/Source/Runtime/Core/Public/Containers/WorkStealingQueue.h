@@ -0,0 +1,110 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include <atomic>
+
+/**
+ * Fixed size Chase-Lev work stealing deque of pointers.
+ *
+ * The owning thread pushes and pops at the bottom (LIFO, so it keeps working on what it just produced while
+ * it is still in cache), any other thread steals from the top (FIFO, the oldest and usually largest work).
+ * Owner operations only touch the shared top index when the deque is nearly empty.
+ * Push fails when the deque is full, callers are expected to fall back to a shared queue.
+ *
+ * Based on "Correct and Efficient Work-Stealing for Weak Memory Models", Le, Pop, Cohen, Zappa Nardelli, 2013.
+ */
+template<typename T, uint32 Capacity>
+class TWorkStealingQueue
+{
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+	TWorkStealingQueue()
+		: Top(0)
+		, Bottom(0)
+	{
+		for (std::atomic<T*>& Item : Items)
+		{
+			Item.store(nullptr, std::memory_order_relaxed);
+		}
+	}
+
+	/** Owner only. @return false if the deque is full */
+	bool Push(T* Item)
+	{
+		checkSlow(Item);
+		const int64 LocalBottom = Bottom.load(std::memory_order_relaxed);
+		const int64 LocalTop = Top.load(std::memory_order_acquire);
+		if (LocalBottom - LocalTop >= int64(Capacity))
+		{
+			return false;
+		}
+		Items[LocalBottom & (Capacity - 1)].store(Item, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		Bottom.store(LocalBottom + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/** Owner only. @return the most recently pushed item or nullptr */
+	T* Pop()
+	{
+		const int64 LocalBottom = Bottom.load(std::memory_order_relaxed) - 1;
+		Bottom.store(LocalBottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64 LocalTop = Top.load(std::memory_order_relaxed);
+
+		T* Result = nullptr;
+		if (LocalTop <= LocalBottom)
+		{
+			Result = Items[LocalBottom & (Capacity - 1)].load(std::memory_order_relaxed);
+			if (LocalTop == LocalBottom)
+			{
+				// last item, race the thieves for it
+				if (!Top.compare_exchange_strong(LocalTop, LocalTop + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				{
+					Result = nullptr;
+				}
+				Bottom.store(LocalBottom + 1, std::memory_order_relaxed);
+			}
+		}
+		else
+		{
+			Bottom.store(LocalBottom + 1, std::memory_order_relaxed);
+		}
+		return Result;
+	}
+
+	/** Any thread. @return the oldest item, or nullptr if the deque is empty or another thread won the race for it */
+	T* Steal()
+	{
+		int64 LocalTop = Top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64 LocalBottom = Bottom.load(std::memory_order_acquire);
+		if (LocalTop < LocalBottom)
+		{
+			T* Result = Items[LocalTop & (Capacity - 1)].load(std::memory_order_relaxed);
+			if (Top.compare_exchange_strong(LocalTop, LocalTop + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			{
+				return Result;
+			}
+		}
+		return nullptr;
+	}
+
+	/** Any thread, only a guess unless called by the owner with no thieves around. */
+	bool IsEmpty() const
+	{
+		const int64 LocalTop = Top.load(std::memory_order_acquire);
+		const int64 LocalBottom = Bottom.load(std::memory_order_acquire);
+		return LocalBottom <= LocalTop;
+	}
+
+private:
+	/** Thieves contend on the top, keep it away from the owner's bottom */
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<int64> Top;
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<int64> Bottom;
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<T*> Items[Capacity];
+};
@@ -33,27 +33,57 @@
 
 #define DEFAULT_GMallocBinned2PerThreadCaches 1
 #define DEFAULT_GMallocBinned2LockFreeCaches 0
-#define DEFAULT_GMallocBinned2BundleCount 64
-#define DEFAULT_GMallocBinned2AllocExtra 32
-#define BINNED2_MAX_GMallocBinned2MaxBundlesBeforeRecycle 8
 
 #if !defined(AGGRESSIVE_MEMORY_SAVING)
 	#error "AGGRESSIVE_MEMORY_SAVING must be defined"
 #endif
-#if AGGRESSIVE_MEMORY_SAVING
-	#define DEFAULT_GMallocBinned2BundleSize 8192
+// Dedicated servers run many busy threads with plenty of memory, larger per-thread bundles mean fewer trips to the global recycler and the mutex
+#if UE_SERVER
+	#define DEFAULT_GMallocBinned2BundleCount 256
+	#define DEFAULT_GMallocBinned2AllocExtra 64
+	#define DEFAULT_GMallocBinned2BundleSize (4 * BINNED2_LARGE_ALLOC)
+	#define BINNED2_MAX_GMallocBinned2MaxBundlesBeforeRecycle 16
+	#define DEFAULT_GMallocBinned2ThreadCacheIdleTrimTime 30.0f
 #else
-	#define DEFAULT_GMallocBinned2BundleSize BINNED2_LARGE_ALLOC
+	#define DEFAULT_GMallocBinned2BundleCount 64
+	#define DEFAULT_GMallocBinned2AllocExtra 32
+	#if AGGRESSIVE_MEMORY_SAVING
+		#define DEFAULT_GMallocBinned2BundleSize 8192
+	#else
+		#define DEFAULT_GMallocBinned2BundleSize BINNED2_LARGE_ALLOC
+	#endif
+	#define BINNED2_MAX_GMallocBinned2MaxBundlesBeforeRecycle 8
+	#define DEFAULT_GMallocBinned2ThreadCacheIdleTrimTime 0.0f
+#endif
+
+// Lets UpdateStats reclaim the caches of idle threads. Every use of a thread cache then takes an uncontended per-thread lock.
+#ifndef BINNED2_IDLE_THREAD_CACHE_TRIM
+	#define BINNED2_IDLE_THREAD_CACHE_TRIM UE_SERVER
 #endif
 
+// Committed OS blocks kept by FMallocBinned2 for reuse by allocations of the same size.
+// FPooledVirtualMemoryAllocator decommits every block it gets back, so without this every large allocation and every small pool page costs syscalls.
+#ifndef BINNED2_LARGE_BLOCK_CACHE
+	#define BINNED2_LARGE_BLOCK_CACHE PLATFORM_UNIX
+#endif
+#define BINNED2_MAX_LARGE_BLOCK_CACHE_COUNT 256
+#if UE_SERVER
+	#define DEFAULT_GMallocBinned2LargeBlockCacheCount 256
+	#define DEFAULT_GMallocBinned2LargeBlockCacheSizeMB 512
+#else
+	#define DEFAULT_GMallocBinned2LargeBlockCacheCount 64
+	#define DEFAULT_GMallocBinned2LargeBlockCacheSizeMB 64
+#endif
 
-#define BINNED2_ALLOW_RUNTIME_TWEAKING 0
+#ifndef BINNED2_ALLOW_RUNTIME_TWEAKING
+	#define BINNED2_ALLOW_RUNTIME_TWEAKING UE_SERVER
+#endif
 #if BINNED2_ALLOW_RUNTIME_TWEAKING
 	extern CORE_API int32 GMallocBinned2PerThreadCaches;
-	extern CORE_API int32 GMallocBinned2BundleSize = DEFAULT_GMallocBinned2BundleSize;
-	extern CORE_API int32 GMallocBinned2BundleCount = DEFAULT_GMallocBinned2BundleCount;
-	extern CORE_API int32 GMallocBinned2MaxBundlesBeforeRecycle = BINNED2_MAX_GMallocBinned2MaxBundlesBeforeRecycle;
-	extern CORE_API int32 GMallocBinned2AllocExtra = DEFAULT_GMallocBinned2AllocExtra;
+	extern CORE_API int32 GMallocBinned2BundleSize;
+	extern CORE_API int32 GMallocBinned2BundleCount;
+	extern CORE_API int32 GMallocBinned2MaxBundlesBeforeRecycle;
+	extern CORE_API int32 GMallocBinned2AllocExtra;
 #else
 	#define GMallocBinned2PerThreadCaches DEFAULT_GMallocBinned2PerThreadCaches
 	#define GMallocBinned2BundleSize DEFAULT_GMallocBinned2BundleSize
@@ -261,6 +291,19 @@ class CORE_API FMallocBinned2 : public FMalloc
 
 	FCriticalSection Mutex;
 
+#if BINNED2_LARGE_BLOCK_CACHE
+	struct FCachedLargeBlock
+	{
+		void*  Ptr;
+		SIZE_T ByteSize;
+	};
+
+	// Oldest first, protected by Mutex
+	FCachedLargeBlock CachedLargeBlocks[BINNED2_MAX_LARGE_BLOCK_CACHE_COUNT];
+	uint32 NumCachedLargeBlocks;
+	SIZE_T CachedLargeBlocksTotal;
+#endif
+
 	FORCEINLINE bool IsOSAllocation(const void* Ptr)
 	{
 #if UE_USE_VERYLARGEPAGEALLOCATOR && !PLATFORM_UNIX
@@ -374,11 +417,41 @@ class CORE_API FMallocBinned2 : public FMalloc
 		static void ClearTLS();
 
 		FPerThreadFreeBlockLists() 
+			: ActivityCount(0)
+			, ActivityAtLastIdleCheck(0)
+			, ActivityAtLastIdleTrim(0)
+#if BINNED2_IDLE_THREAD_CACHE_TRIM
+			, LockState(0)
+#endif
 #if BINNED2_ALLOCATOR_STATS
-			: AllocatedMemory(0) 
+			, AllocatedMemory(0) 
 #endif
 		{ }
 
+		// Called by the owning thread on every trip to the shared pools, lets UpdateStats find threads that went idle
+		FORCEINLINE void MarkActive()
+		{
+			ActivityCount.Store(ActivityCount.Load(EMemoryOrder::Relaxed) + 1, EMemoryOrder::Relaxed);
+		}
+
+		// Taken by the owning thread around every use of the lists, and by UpdateStats to reclaim them from an idle thread.
+		// Never waits, whoever fails to take it leaves the lists alone and goes to the shared pools.
+		FORCEINLINE bool TryLock()
+		{
+#if BINNED2_IDLE_THREAD_CACHE_TRIM
+			int32 Expected = 0;
+			return LockState.CompareExchange(Expected, 1);
+#else
+			return true;
+#endif
+		}
+		FORCEINLINE void Unlock()
+		{
+#if BINNED2_IDLE_THREAD_CACHE_TRIM
+			LockState.Store(0);
+#endif
+		}
+
 		FORCEINLINE void* Malloc(uint32 InPoolIndex)
 		{
 			return FreeLists[InPoolIndex].PopFromFront(InPoolIndex);
@@ -407,6 +480,13 @@ class CORE_API FMallocBinned2 : public FMalloc
 		{
 			return FreeLists[InPoolIndex].PopBundles(InPoolIndex);
 		}
+		TAtomic<uint32> ActivityCount;
+		// Only accessed by UpdateStats with the registration mutex held
+		uint32 ActivityAtLastIdleCheck;
+		uint32 ActivityAtLastIdleTrim;
+#if BINNED2_IDLE_THREAD_CACHE_TRIM
+		TAtomic<int32> LockState;
+#endif
 #if BINNED2_ALLOCATOR_STATS
 	public:
 		int64 AllocatedMemory;
@@ -465,7 +545,7 @@ public:
 		if ((Size <= BINNED2_MAX_SMALL_POOL_SIZE) & (Alignment <= BINNED2_MINIMUM_ALIGNMENT)) // one branch, not two
 		{
 			FPerThreadFreeBlockLists* Lists = GMallocBinned2PerThreadCaches ? FPerThreadFreeBlockLists::Get() : nullptr;
-			if (Lists)
+			if (Lists && Lists->TryLock())
 			{
 				uint32 PoolIndex = BoundSizeToPoolIndex(Size);
 				uint32 BlockSize = PoolIndexToBlockSize(PoolIndex);
@@ -476,6 +556,7 @@ public:
 					Lists->AllocatedMemory += BlockSize;
 				}
 #endif
+				Lists->Unlock();
 			}
 		}
 		if (Result == nullptr)
@@ -546,7 +627,7 @@ public:
 		if (NewSize <= BINNED2_MAX_SMALL_POOL_SIZE && Alignment <= BINNED2_MINIMUM_ALIGNMENT) // one branch, not two
 		{
 			FPerThreadFreeBlockLists* Lists = GMallocBinned2PerThreadCaches ? FPerThreadFreeBlockLists::Get() : nullptr;
-			if (Lists && (!Ptr || !IsOSAllocation(Ptr)))
+			if (Lists && (!Ptr || !IsOSAllocation(Ptr)) && Lists->TryLock())
 			{
 				uint32 BlockSize = 0;
 				uint32 PoolIndex = 0;
@@ -561,6 +642,7 @@ public:
 					bCanFree = Free->IsCanaryOk();
 					if (NewSize && bCanFree && NewSize <= BlockSize && (PoolIndex == 0 || NewSize > PoolIndexToBlockSize(PoolIndex - 1)))
 					{
+						Lists->Unlock();
 						return Ptr;
 					}
 					bCanFree = bCanFree && Lists->CanFree(PoolIndex, BlockSize);
@@ -591,9 +673,11 @@ public:
 #endif
 						}
 
+						Lists->Unlock();
 						return Result;
 					}
 				}
+				Lists->Unlock();
 			}
 		}
 		void* Result = ReallocExternal(Ptr, NewSize, Alignment);
@@ -631,15 +715,20 @@ public:
 		if (!IsOSAllocation(Ptr))
 		{
 			FPerThreadFreeBlockLists* Lists = GMallocBinned2PerThreadCaches ? FPerThreadFreeBlockLists::Get() : nullptr;
-			if (Lists)
+			if (Lists && Lists->TryLock())
 			{
 				FFreeBlock* BasePtr = GetPoolHeaderFromPointer(Ptr);
 				int32 BlockSize = BasePtr->BlockSize;
-				if (BasePtr->IsCanaryOk() && Lists->Free(Ptr, BasePtr->PoolIndex, BasePtr->BlockSize))
-				{
+				const bool bPushed = BasePtr->IsCanaryOk() && Lists->Free(Ptr, BasePtr->PoolIndex, BasePtr->BlockSize);
 #if BINNED2_ALLOCATOR_STATS
+				if (bPushed)
+				{
 					Lists->AllocatedMemory -= BasePtr->BlockSize;
+				}
 #endif
+				Lists->Unlock();
+				if (bPushed)
+				{
 					return;
 				}
 			}
@@ -7,6 +7,7 @@
 #include "HAL/MemoryBase.h"
 #include "HAL/UnrealMemory.h"
 #include "Misc/ScopeLock.h"
+#include "HAL/PlatformTLS.h"
 
 #if !defined(UE_USE_MALLOC_REPLAY_PROXY)
 	// it is always enabled on Linux, but not always added to the malloc stack
@@ -45,6 +46,8 @@ private:
 		SIZE_T			Size;
 		/** Alignment as passed in - only valid for malloc/realloc. */
 		uint32			Alignment;
+		/** Thread that made the call, lets the replay run on as many threads as the recording. */
+		uint32			ThreadId;
 	};
 
 	/** Size of history not yet dumped to disk */
@@ -65,6 +68,7 @@ private:
 	/** Adds operation to history*/
 	void AddToHistory(const char *Op, void * PtrOut, void * PtrIn, SIZE_T Size, SIZE_T Alignment)
 	{
+		const uint32 ThreadId = FPlatformTLS::GetCurrentThreadId();
 		FScopeLock Lock(&HistoryLock);
 
 		HistoryCache[CurrentCacheIdx].Operation = Op;
@@ -72,6 +76,7 @@ private:
 		HistoryCache[CurrentCacheIdx].PointerIn = PtrIn;
 		HistoryCache[CurrentCacheIdx].Size = Size;
 		HistoryCache[CurrentCacheIdx].Alignment = Alignment;
+		HistoryCache[CurrentCacheIdx].ThreadId = ThreadId;
 
 		++CurrentCacheIdx;
 		if (CurrentCacheIdx > HistoryCacheSize - 1)
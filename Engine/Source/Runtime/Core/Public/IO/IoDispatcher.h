@@ -1056,6 +1056,8 @@ struct FIoContainerSettings
 	FGuid EncryptionKeyGuid;
 	FAES::FAESKey EncryptionKey;
 	FRSAKeyHandle SigningKey;
+	/** Trained zstd dictionary used when compressing with NAME_Zstd, shipped next to the container */
+	TArray<uint8> CompressionDictionary;
 	bool bGenerateDiffPatch = false;
 
 	bool IsCompressed() const
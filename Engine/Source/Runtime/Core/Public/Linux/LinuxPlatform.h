@@ -11,3 +11,4 @@
 #define PLATFORM_GLOBAL_LOG_CATEGORY			LogLinux
 
 #define PLATFORM_SUPPORTS_BORDERLESS_WINDOW		1
+#define PLATFORM_IMPLEMENTS_IO					1
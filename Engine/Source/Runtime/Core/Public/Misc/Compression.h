@@ -7,6 +7,7 @@
 #include "Templates/Atomic.h"
 #include "Misc/CompressionFlags.h"
 #include "HAL/CriticalSection.h"
+#include "Containers/ArrayView.h"
 
 class IMemoryReadStream;
 
@@ -102,6 +103,34 @@ struct FCompression
 
 	CORE_API static FName GetCompressionFormatFromDeprecatedFlags(ECompressionFlags DeprecatedFlags);
 
+	/**
+	 * Registers a trained Zstd dictionary. Frames compressed with a dictionary store its id, so once registered
+	 * any UncompressMemory call on such a frame finds it again. Dictionaries stay registered until exit.
+	 *
+	 * @param	DictionaryData				Dictionary as produced by TrainZstdDictionary or the zstd command line tool
+	 * @return	The dictionary id to pass to CompressMemoryWithZstdDictionary, 0 if the data is not a valid dictionary
+	 */
+	CORE_API static uint32 RegisterZstdDictionary(TArrayView<const uint8> DictionaryData);
+
+	/**
+	 * Compresses with NAME_Zstd using a registered dictionary. CompressMemory never uses a dictionary, its CompressionData
+	 * is the zlib bit window for most callers. Use CompressMemoryBound with NAME_Zstd to size CompressedBuffer.
+	 *
+	 * @param	DictionaryId				Id returned by RegisterZstdDictionary
+	 * @return true if compression succeeds, false if CompressedBuffer was too small or the dictionary is not registered
+	 */
+	CORE_API static bool CompressMemoryWithZstdDictionary(uint32 DictionaryId, void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize, ECompressionFlags Flags=COMPRESS_NoFlags);
+
+	/**
+	 * Trains a Zstd dictionary from samples of the data it will be used on (small blocks benefit the most).
+	 *
+	 * @param	Samples						Sample buffers, typically a few thousand compression blocks
+	 * @param	MaxDictionarySize			Upper bound on the dictionary size in bytes, 112KB is a good start
+	 * @param	OutDictionary				Trained dictionary
+	 * @return	true if training succeeded
+	 */
+	CORE_API static bool TrainZstdDictionary(TArrayView<const TArrayView<const uint8>> Samples, int32 MaxDictionarySize, TArray<uint8>& OutDictionary);
+
 private:
 	
 	/**
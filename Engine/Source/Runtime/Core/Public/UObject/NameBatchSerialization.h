@@ -42,4 +42,13 @@ CORE_API TArray<FNameEntryId> LoadNameBatch(FArchive& Ar);
 // @param Ar is drained synchronously
 // @param MaxWorkers > 0
 // @return function that waits before returning result, like a simple future.
-CORE_API TFunction<TArray<FNameEntryId>()> LoadNameBatchAsync(FArchive& Ar, uint32 MaxWorkers);
\ No newline at end of file
+CORE_API TFunction<TArray<FNameEntryId>()> LoadNameBatchAsync(FArchive& Ar, uint32 MaxWorkers);
+// Find or create plain names for many strings at once
+//
+// Like constructing FName(String, NAME_NO_NUMBER_INTERNAL) for each string, i.e. without parsing numbers,
+// but hashes large batches in parallel and inserts them one batch per name pool shard, in parallel.
+// Wide strings that only contain ANSI characters are stored as ANSI names.
+//
+// @param OutNames receives display entry ids in input order
+CORE_API void CreateNameBatch(TArrayView<const FAnsiStringView> Strings, TArray<FNameEntryId>& OutNames);
+CORE_API void CreateNameBatch(TArrayView<const FWideStringView> Strings, TArray<FNameEntryId>& OutNames);
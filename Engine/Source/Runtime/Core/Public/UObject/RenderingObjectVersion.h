@@ -127,6 +127,9 @@ struct CORE_API FRenderingObjectVersion
 		// Add a new virtual texture to support virtual texture light map on mobile
 		VirtualTexturedLightmapsV3,
 
+		// Added precomputed mesh cards for realtime GI surface cache to static mesh render data
+		RealtimeGIMeshCards,
+
 		// -----<new versions can be added above this line>-------------------------------------------------
 		VersionPlusOne,
 		LatestVersion = VersionPlusOne - 1
@@ -0,0 +1,202 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/ObjectRedirector.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/WeakObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace IncrementalGarbageCollectionTest
+{
+	/** Overrides a console variable for the lifetime of the scope */
+	struct FScopedConsoleVariable
+	{
+		IConsoleVariable* Variable;
+		FString OldValue;
+
+		FScopedConsoleVariable(const TCHAR* Name, int32 Value)
+			: Variable(IConsoleManager::Get().FindConsoleVariable(Name))
+		{
+			check(Variable);
+			OldValue = Variable->GetString();
+			Variable->Set(Value, ECVF_SetByCode);
+		}
+
+		~FScopedConsoleVariable()
+		{
+			Variable->Set(*OldValue, ECVF_SetByCode);
+		}
+	};
+
+	/** Redirectors are the simplest objects with a traced reference, DestinationObject */
+	static UObjectRedirector* NewNode()
+	{
+		return NewObject<UObjectRedirector>(GetTransientPackage(), NAME_None, RF_Transient);
+	}
+
+	static void GatherReachable(const TArray<UObjectRedirector*>& Roots, TSet<UObject*>& OutReachable)
+	{
+		OutReachable.Reset();
+		for (UObjectRedirector* Node : Roots)
+		{
+			while (Node && !OutReachable.Contains(Node))
+			{
+				OutReachable.Add(Node);
+				Node = static_cast<UObjectRedirector*>(Node->DestinationObject);
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIncrementalReachabilityTest, "System.CoreUObject.GarbageCollection.IncrementalReachability", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+/**
+ * Rewires chains of objects between every slice of an incremental reachability analysis, with and without the write
+ * barrier. Everything reachable when it completes must survive, objects nothing referenced at any point while it ran
+ * must be collected.
+ */
+bool FIncrementalReachabilityTest::RunTest(const FString& Parameters)
+{
+	using namespace IncrementalGarbageCollectionTest;
+
+	FScopedConsoleVariable AllowIncremental(TEXT("gc.AllowIncrementalReachability"), 1);
+	FScopedConsoleVariable BatchSize(TEXT("gc.IncrementalReachabilityBatchSize"), 8);
+	FScopedConsoleVariable Remark(TEXT("gc.IncrementalReachabilityRemark"), 1);
+
+	const int32 NumRoots = 8;
+	const int32 NumNodes = 2000;
+	const int32 NumCollections = 4;
+	const int32 MaxSlices = 1000000;
+	FRandomStream Random(42);
+
+	// finish anything pending so the first collection starts with the graph below
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	TArray<UObjectRedirector*> Roots;
+	for (int32 Index = 0; Index < NumRoots; Index++)
+	{
+		UObjectRedirector* Root = NewNode();
+		Root->AddToRoot();
+		Roots.Add(Root);
+	}
+
+	for (int32 Collection = 0; Collection < NumCollections; Collection++)
+	{
+		TArray<UObjectRedirector*> Nodes;
+		TArray<FWeakObjectPtr> WeakNodes;
+		for (int32 Index = 0; Index < NumNodes; Index++)
+		{
+			Nodes.Add(NewNode());
+			WeakNodes.Add(Nodes.Last());
+		}
+		// random chains, some of them hanging off the roots
+		for (UObjectRedirector* Node : Nodes)
+		{
+			Node->DestinationObject = Random.FRand() < 0.9f ? Nodes[Random.RandRange(0, NumNodes - 1)] : nullptr;
+		}
+		for (UObjectRedirector* Root : Roots)
+		{
+			Root->DestinationObject = Nodes[Random.RandRange(0, NumNodes - 1)];
+		}
+
+		TSet<UObject*> Reachable;
+		TSet<UObject*> EverReachable;
+		GatherReachable(Roots, Reachable);
+		EverReachable.Append(Reachable);
+
+		int32 NumSlices = 0;
+		while (!IncrementalCollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, 0.0f, true) && NumSlices++ < MaxSlices)
+		{
+			if (!IsIncrementalReachabilityAnalysisPending())
+			{
+				continue;
+			}
+
+			const int32 NumMutations = Random.RandRange(1, 4);
+			for (int32 Mutation = 0; Mutation < NumMutations; Mutation++)
+			{
+				const float Kind = Random.FRand();
+				UObjectRedirector* From = Nodes[Random.RandRange(0, Nodes.Num() - 1)];
+				if (Kind < 0.5f)
+				{
+					// move a reference, possibly to an object that hasn't been reached yet
+					UObjectRedirector* To = Nodes[Random.RandRange(0, NumNodes - 1)];
+					From->DestinationObject = To;
+					GCWriteBarrier(To);
+				}
+				else if (Kind < 0.7f)
+				{
+					// the same without the barrier, like native code writes it, found by the re-mark pass
+					From->DestinationObject = Nodes[Random.RandRange(0, NumNodes - 1)];
+				}
+				else if (Kind < 0.8f)
+				{
+					From->DestinationObject = nullptr;
+				}
+				else if (Kind < 0.9f)
+				{
+					// roots are scanned again when the analysis completes
+					Roots[Random.RandRange(0, NumRoots - 1)]->DestinationObject = Nodes[Random.RandRange(0, NumNodes - 1)];
+				}
+				else
+				{
+					// so are new objects, even when the references they hold were written without the barrier
+					UObjectRedirector* Created = NewNode();
+					Created->DestinationObject = Nodes[Random.RandRange(0, NumNodes - 1)];
+					From->DestinationObject = Created;
+					GCWriteBarrier(Created);
+					Nodes.Add(Created);
+					WeakNodes.Add(Created);
+				}
+			}
+
+			GatherReachable(Roots, Reachable);
+			EverReachable.Append(Reachable);
+		}
+		TestTrue(FString::Printf(TEXT("Collection %d finished"), Collection), NumSlices < MaxSlices);
+		AddInfo(FString::Printf(TEXT("Collection %d took %d slices"), Collection, NumSlices));
+
+		int32 NumDestroyedReachable = 0;
+		int32 NumKeptGarbage = 0;
+		for (int32 Index = 0; Index < Nodes.Num(); Index++)
+		{
+			const bool bAlive = WeakNodes[Index].IsValid();
+			if (Reachable.Contains(Nodes[Index]))
+			{
+				NumDestroyedReachable += !bAlive;
+			}
+			else if (Index < NumNodes && !EverReachable.Contains(Nodes[Index]))
+			{
+				NumKeptGarbage += bAlive;
+			}
+		}
+		TestEqual(FString::Printf(TEXT("Collection %d destroyed reachable objects"), Collection), NumDestroyedReachable, 0);
+		TestEqual(FString::Printf(TEXT("Collection %d kept unreferenced objects"), Collection), NumKeptGarbage, 0);
+		if (NumDestroyedReachable > 0)
+		{
+			// the survivors may point at destroyed objects now, don't touch them again
+			for (UObjectRedirector* Root : Roots)
+			{
+				Root->DestinationObject = nullptr;
+			}
+			break;
+		}
+	}
+
+	for (UObjectRedirector* Root : Roots)
+	{
+		Root->DestinationObject = nullptr;
+		Root->RemoveFromRoot();
+	}
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
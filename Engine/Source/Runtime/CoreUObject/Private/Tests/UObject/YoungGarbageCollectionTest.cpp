@@ -0,0 +1,134 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/ObjectRedirector.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/WeakObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace YoungGarbageCollectionTest
+{
+	/** Overrides a console variable for the lifetime of the scope */
+	struct FScopedConsoleVariable
+	{
+		IConsoleVariable* Variable;
+		FString OldValue;
+
+		FScopedConsoleVariable(const TCHAR* Name, int32 Value)
+			: Variable(IConsoleManager::Get().FindConsoleVariable(Name))
+		{
+			check(Variable);
+			OldValue = Variable->GetString();
+			Variable->Set(Value, ECVF_SetByCode);
+		}
+
+		~FScopedConsoleVariable()
+		{
+			Variable->Set(*OldValue, ECVF_SetByCode);
+		}
+	};
+
+	/** Redirectors are the simplest objects with a traced reference, DestinationObject */
+	static UObjectRedirector* NewNode(UObject* Destination = nullptr)
+	{
+		UObjectRedirector* Node = NewObject<UObjectRedirector>(GetTransientPackage(), NAME_None, RF_Transient);
+		Node->DestinationObject = Destination;
+		return Node;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYoungGarbageCollectionTest, "System.CoreUObject.GarbageCollection.MinorCollection", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+/**
+ * Minor collections destroy unreferenced young objects, keep young objects referenced from the remembered set and roots,
+ * and never touch old objects.
+ */
+bool FYoungGarbageCollectionTest::RunTest(const FString& Parameters)
+{
+	using namespace YoungGarbageCollectionTest;
+
+	FScopedConsoleVariable AllowMinorCollections(TEXT("gc.AllowMinorCollections"), 1);
+	// Verification finishes as a full collection, which would destroy the old objects checked below
+	FScopedConsoleVariable NoVerifyMinorCollections(TEXT("gc.VerifyMinorCollections"), 0);
+
+	// old objects, tracking young ones starts with this collection
+	UObjectRedirector* Root = NewNode();
+	Root->AddToRoot();
+	UObjectRedirector* OldReferencer = NewNode();
+	UObjectRedirector* OldOtherReferencer = NewNode(OldReferencer);
+	UObjectRedirector* OldGarbage = NewNode();
+	Root->DestinationObject = OldOtherReferencer;
+	UObjectRedirector* OtherRoot = NewNode(OldGarbage);
+	OtherRoot->AddToRoot();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	OtherRoot->DestinationObject = nullptr;
+
+	// young objects
+	FWeakObjectPtr Garbage = NewNode();
+	FWeakObjectPtr GarbageChain = NewNode(NewNode(Garbage.Get()));
+	UObjectRedirector* Remembered = NewNode(NewNode());
+	FWeakObjectPtr RememberedChild = Remembered->DestinationObject;
+	OldReferencer->DestinationObject = Remembered;
+	GCWriteBarrier(OldReferencer, Remembered);
+	UObjectRedirector* RememberedValue = NewNode();
+	OldOtherReferencer->DestinationObject = RememberedValue;
+	GCWriteBarrier(RememberedValue);
+	UObjectRedirector* YoungRoot = NewNode(NewNode());
+	YoungRoot->AddToRoot();
+	FWeakObjectPtr YoungRootChild = YoungRoot->DestinationObject;
+	FWeakObjectPtr DroppedFromRemembered = NewNode();
+	OtherRoot->DestinationObject = DroppedFromRemembered.Get();
+	GCWriteBarrier(OtherRoot, DroppedFromRemembered.Get());
+	OtherRoot->DestinationObject = nullptr;
+
+	FWeakObjectPtr WeakRemembered = Remembered;
+	FWeakObjectPtr WeakRememberedValue = RememberedValue;
+	FWeakObjectPtr WeakOldGarbage = OldGarbage;
+	if (!TestTrue(TEXT("Minor collection ran"), TryCollectYoungGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true)))
+	{
+		YoungRoot->RemoveFromRoot();
+		OtherRoot->RemoveFromRoot();
+		Root->RemoveFromRoot();
+		return false;
+	}
+
+	TestFalse(TEXT("Unreferenced young object"), Garbage.IsValid());
+	TestFalse(TEXT("Young object referenced by young garbage"), GarbageChain.IsValid());
+	TestFalse(TEXT("Young object no longer referenced by a remembered referencer"), DroppedFromRemembered.IsValid());
+	TestTrue(TEXT("Young object referenced by a remembered referencer"), WeakRemembered.IsValid());
+	TestTrue(TEXT("Young object referenced by a remembered young object"), RememberedChild.IsValid());
+	TestTrue(TEXT("Remembered young object"), WeakRememberedValue.IsValid());
+	TestTrue(TEXT("Young object referenced by a young root"), YoungRootChild.IsValid());
+	TestTrue(TEXT("Unreferenced old object"), WeakOldGarbage.IsValid());
+
+	// survivors are old now, they don't need the write barrier anymore and only full collections destroy them
+	OldReferencer->DestinationObject = nullptr;
+	TryCollectYoungGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+	TestTrue(TEXT("Promoted object after minor collection"), WeakRemembered.IsValid());
+
+	// references written without the barrier are found by verification
+	{
+		FScopedConsoleVariable VerifyMinorCollections(TEXT("gc.VerifyMinorCollections"), 1);
+		FWeakObjectPtr Unbarriered = NewNode();
+		OldReferencer->DestinationObject = Unbarriered.Get();
+		AddExpectedError(TEXT("Minor garbage collection missed"), EAutomationExpectedErrorFlags::Contains, 1);
+		TryCollectYoungGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+		TestTrue(TEXT("Young object referenced without the barrier with verification"), Unbarriered.IsValid());
+	}
+
+	YoungRoot->RemoveFromRoot();
+	OtherRoot->RemoveFromRoot();
+	Root->RemoveFromRoot();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	TestFalse(TEXT("Promoted object after full collection"), WeakRemembered.IsValid());
+	TestFalse(TEXT("Unreferenced old object after full collection"), WeakOldGarbage.IsValid());
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -596,9 +596,53 @@ public:
 	{
 		return !!(Options & EFastReferenceCollectorOptions::WithClusters);
 	}
+	constexpr static FORCEINLINE bool IsIncremental()
+	{
+		return !!(Options & EFastReferenceCollectorOptions::Incremental);
+	}
+
+	/** Incremental reachability analysis marks with its own GC flag so Unreachable keeps its meaning until the analysis completes */
+	static FORCEINLINE bool IsMarkedUnreachable(const FUObjectItem* ObjectItem)
+	{
+		return IsIncremental() ? ObjectItem->HasAnyGCFlags(EGCObjectFlags::MaybeUnreachable) : ObjectItem->IsUnreachable();
+	}
+	static FORCEINLINE void MarkUnreachable(FUObjectItem* ObjectItem)
+	{
+		if (IsIncremental())
+		{
+			ObjectItem->SetGCFlags(EGCObjectFlags::MaybeUnreachable);
+		}
+		else
+		{
+			ObjectItem->SetFlags(EInternalObjectFlags::Unreachable);
+		}
+	}
+	static FORCEINLINE void ClearMarkedUnreachable(FUObjectItem* ObjectItem)
+	{
+		if (IsIncremental())
+		{
+			ObjectItem->ClearGCFlags(EGCObjectFlags::MaybeUnreachable);
+		}
+		else
+		{
+			ObjectItem->ClearFlags(EInternalObjectFlags::Unreachable);
+		}
+	}
+	static FORCEINLINE bool ThisThreadAtomicallyClearedMarkedUnreachable(FUObjectItem* ObjectItem)
+	{
+		return IsIncremental() ? ObjectItem->ThisThreadAtomicallyClearedGCFlag(EGCObjectFlags::MaybeUnreachable) : ObjectItem->ThisThreadAtomicallyClearedRFUnreachable();
+	}
 
 	FGCReferenceProcessor()
+		: GrayObjects(nullptr)
+	{
+	}
+
+	/** Incremental processors queue every object they reach so the analysis can stop between any two batches */
+	explicit FGCReferenceProcessor(TArray<UObject*>& InGrayObjects)
+		: GrayObjects(&InGrayObjects)
 	{
+		static_assert(IsIncremental() && !IsParallel(), "Only single threaded incremental processors queue reached objects");
 	}
 
 	void SetCurrentObject(UObject* InObject)
@@ -655,9 +699,9 @@ public:
 				{
 					if (!ReferencedMutableObjectItem->IsPendingKill())
 					{
-						if (ReferencedMutableObjectItem->IsUnreachable())
+						if (IsMarkedUnreachable(ReferencedMutableObjectItem))
 						{
-							if (ReferencedMutableObjectItem->ThisThreadAtomicallyClearedRFUnreachable())
+							if (ThisThreadAtomicallyClearedMarkedUnreachable(ReferencedMutableObjectItem))
 							{
 								// Needs doing because this is either a normal unclustered object (clustered objects are never unreachable) or a cluster root
 								ObjectsToSerialize.Add(static_cast<UObject*>(ReferencedMutableObjectItem->Object));
@@ -676,10 +720,10 @@ public:
 							{
 								// Needs doing, we need to get its cluster root and process it too
 								FUObjectItem* ReferencedMutableObjectsClusterRootItem = GUObjectArray.IndexToObjectUnsafeForGC(ReferencedMutableObjectItem->GetOwnerIndex());
-								if (ReferencedMutableObjectsClusterRootItem->IsUnreachable())
+								if (IsMarkedUnreachable(ReferencedMutableObjectsClusterRootItem))
 								{
 									// The root is also maybe unreachable so process it and all the referenced clusters
-									if (ReferencedMutableObjectsClusterRootItem->ThisThreadAtomicallyClearedRFUnreachable())
+									if (ThisThreadAtomicallyClearedMarkedUnreachable(ReferencedMutableObjectsClusterRootItem))
 									{
 										MarkReferencedClustersAsReachable(ReferencedMutableObjectsClusterRootItem->GetClusterIndex(), ObjectsToSerialize);
 									}
@@ -696,10 +740,10 @@ public:
 				}
 				else if (!ReferencedMutableObjectItem->IsPendingKill())
 				{
-					if (ReferencedMutableObjectItem->IsUnreachable())
+					if (IsMarkedUnreachable(ReferencedMutableObjectItem))
 					{
 						// Needs doing because this is either a normal unclustered object (clustered objects are never unreachable) or a cluster root
-						ReferencedMutableObjectItem->ClearFlags(EInternalObjectFlags::Unreachable);
+						ClearMarkedUnreachable(ReferencedMutableObjectItem);
 						ObjectsToSerialize.Add(static_cast<UObject*>(ReferencedMutableObjectItem->Object));
 
 						// So is this a cluster root?
@@ -715,9 +759,9 @@ public:
 						
 						// If the root is also unreachable, process it and all its referenced clusters
 						FUObjectItem* ReferencedMutableObjectsClusterRootItem = GUObjectArray.IndexToObjectUnsafeForGC(ReferencedMutableObjectItem->GetOwnerIndex());
-						if (ReferencedMutableObjectsClusterRootItem->IsUnreachable())
+						if (IsMarkedUnreachable(ReferencedMutableObjectsClusterRootItem))
 						{
-							ReferencedMutableObjectsClusterRootItem->ClearFlags(EInternalObjectFlags::Unreachable);
+							ClearMarkedUnreachable(ReferencedMutableObjectsClusterRootItem);
 							MarkReferencedClustersAsReachable(ReferencedMutableObjectsClusterRootItem->GetClusterIndex(), ObjectsToSerialize);
 						}
 					}
@@ -755,14 +799,14 @@ public:
 					// This condition should get collapsed by the compiler based on the template argument
 					if (IsParallel())
 					{
-						if (ReferencedClusterRootObjectItem->IsUnreachable())
+						if (IsMarkedUnreachable(ReferencedClusterRootObjectItem))
 						{
-							ReferencedClusterRootObjectItem->ThisThreadAtomicallyClearedFlag( EInternalObjectFlags::Unreachable);
+							ThisThreadAtomicallyClearedMarkedUnreachable(ReferencedClusterRootObjectItem);
 						}
 					}
 					else
 					{
-						ReferencedClusterRootObjectItem->ClearFlags(EInternalObjectFlags::Unreachable);
+						ClearMarkedUnreachable(ReferencedClusterRootObjectItem);
 					}
 				}
 				else
@@ -798,8 +842,10 @@ public:
 	 * @param ReferencingObject UObject which owns the reference (can be NULL)
 	 * @param bAllowReferenceElimination	Whether to allow NULL'ing the reference if RF_PendingKill is set
 	*/
-	FORCEINLINE void HandleObjectReference(TArray<UObject*>& ObjectsToSerialize, const UObject * const ReferencingObject, UObject*& Object, const bool bAllowReferenceElimination)
+	FORCEINLINE void HandleObjectReference(TArray<UObject*>& InObjectsToSerialize, const UObject * const ReferencingObject, UObject*& Object, const bool bAllowReferenceElimination)
 	{
+		TArray<UObject*>& ObjectsToSerialize = IsIncremental() ? *GrayObjects : InObjectsToSerialize;
+
 		// Disregard NULL objects and perform very fast check to see whether object is part of permanent
 		// object pool and should therefore be disregarded. The check doesn't touch the object and is
 		// cache friendly as it's just a pointer compare against to globals.
@@ -828,12 +874,12 @@ public:
 			Object = NULL;
 		}
 		// Add encountered object reference to list of to be serialized objects if it hasn't already been added.
-		else if (ObjectItem->IsUnreachable())
+		else if (IsMarkedUnreachable(ObjectItem))
 		{
 			if (IsParallel())
 			{
 				// Mark it as reachable.
-				if (ObjectItem->ThisThreadAtomicallyClearedRFUnreachable())
+				if (ThisThreadAtomicallyClearedMarkedUnreachable(ObjectItem))
 				{
 					// Objects that are part of a GC cluster should never have the unreachable flag set!
 					checkSlow(ObjectItem->GetOwnerIndex() <= 0);
@@ -867,7 +913,7 @@ public:
 #endif
 
 				// Mark it as reachable.
-				ObjectItem->ClearUnreachable();
+				ClearMarkedUnreachable(ObjectItem);
 
 				// Objects that are part of a GC cluster should never have the unreachable flag set!
 				checkSlow(ObjectItem->GetOwnerIndex() <= 0);
@@ -903,15 +949,15 @@ public:
 				checkSlow(RootObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot));
 				if (IsParallel())
 				{
-					if (RootObjectItem->ThisThreadAtomicallyClearedRFUnreachable())
+					if (ThisThreadAtomicallyClearedMarkedUnreachable(RootObjectItem))
 					{
 						// Make sure all referenced clusters are marked as reachable too
 						MarkReferencedClustersAsReachable(RootObjectItem->GetClusterIndex(), ObjectsToSerialize);
 					}
 				}
-				else if (RootObjectItem->IsUnreachable())
+				else if (IsMarkedUnreachable(RootObjectItem))
 				{
-					RootObjectItem->ClearFlags(EInternalObjectFlags::Unreachable);
+					ClearMarkedUnreachable(RootObjectItem);
 					// Make sure all referenced clusters are marked as reachable too
 					MarkReferencedClustersAsReachable(RootObjectItem->GetClusterIndex(), ObjectsToSerialize);
 				}
@@ -964,6 +1010,10 @@ public:
 #endif // ENABLE_GC_OBJECT_CHECKS
 		HandleObjectReference(ObjectsToSerialize, ReferencingObject, Object, bAllowReferenceElimination);
 	}
+
+private:
+	/** Objects reached by an incremental processor that still need their references collected */
+	TArray<UObject*>* GrayObjects;
 };
 
 template <EFastReferenceCollectorOptions Options>
@@ -1130,10 +1180,12 @@ public:
 	/** 
 	 * Marks all objects that don't have KeepFlags and EInternalObjectFlags::GarbageCollectionKeepFlags as unreachable
 	 * This function is a template to speed up the case where we don't need to assemble the token stream (saves about 6ms on PS4)
+	 * Incremental reachability analysis marks them MaybeUnreachable instead.
 	 */
-	template <bool bParallel, bool bWithClusters>
+	template <bool bParallel, bool bWithClusters, bool bIncremental = false>
 	void MarkObjectsAsUnreachable(TArray<UObject*>& ObjectsToSerialize, const EObjectFlags KeepFlags)
 	{
+		typedef FGCReferenceProcessor<bIncremental ? (EFastReferenceCollectorOptions::WithClusters | EFastReferenceCollectorOptions::Incremental) : EFastReferenceCollectorOptions::WithClusters> FClusterReferenceProcessor;
 		const EInternalObjectFlags FastKeepFlags = EInternalObjectFlags::GarbageCollectionKeepFlags;
 		const int32 MaxNumberOfObjects = GUObjectArray.GetObjectArrayNum() - GUObjectArray.GetFirstGCIndex();
 		const int32 NumThreads = FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
@@ -1165,7 +1217,7 @@ public:
 					UObject* Object = (UObject*)ObjectItem->Object;
 
 					// We can't collect garbage during an async load operation and by now all unreachable objects should've been purged.
-					checkf(!ObjectItem->HasAnyFlags(EInternalObjectFlags::Unreachable|EInternalObjectFlags::PendingConstruction), TEXT("%s"), *Object->GetFullName());
+					checkf(!ObjectItem->HasAnyFlags(EInternalObjectFlags::Unreachable|EInternalObjectFlags::PendingConstruction) && !ObjectItem->HasAnyGCFlags(EGCObjectFlags::MaybeUnreachable), TEXT("%s"), *Object->GetFullName());
 
 					// Keep track of how many objects are around.
 					ObjectCountDuringMarkPhase++;
@@ -1229,7 +1281,7 @@ public:
 						}
 						else
 						{
-							ObjectItem->SetFlags(EInternalObjectFlags::Unreachable);
+							FClusterReferenceProcessor::MarkUnreachable(ObjectItem);
 						}
 					}
 					// Cluster objects 
@@ -1274,124 +1326,836 @@ public:
 				// DissolveClusterAndMarkObjectsAsUnreachable calls already dissolved its cluster
 				if (ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot))
 				{
-					GUObjectClusters.DissolveClusterAndMarkObjectsAsUnreachable(ObjectItem);
+					GUObjectClusters.DissolveClusterAndMarkObjectsAsUnreachable(ObjectItem, bIncremental);
 					GUObjectClusters.SetClustersNeedDissolving();
 				}
 			}
 		}
 
-		if (bWithClusters)
+		if (bWithClusters)
+		{
+			TArray<FUObjectItem*> KeepClusterRefs;
+			KeepClusterRefsList.PopAll(KeepClusterRefs);
+			for (FUObjectItem* ObjectItem : KeepClusterRefs)
+			{
+				if (ObjectItem->GetOwnerIndex() > 0)
+				{
+					checkSlow(!ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot));
+					bool bNeedsDoing = !ObjectItem->HasAnyFlags(EInternalObjectFlags::ReachableInCluster);
+					if (bNeedsDoing)
+					{
+						ObjectItem->SetFlags(EInternalObjectFlags::ReachableInCluster);
+						// Make sure cluster root object is reachable too
+						const int32 OwnerIndex = ObjectItem->GetOwnerIndex();
+						FUObjectItem* RootObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(OwnerIndex);
+						checkSlow(RootObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot));
+						// if it is reachable via keep flags we will do this below (or maybe already have)
+						if (FClusterReferenceProcessor::IsMarkedUnreachable(RootObjectItem)) 
+						{
+							FClusterReferenceProcessor::ClearMarkedUnreachable(RootObjectItem);
+							// Make sure all referenced clusters are marked as reachable too
+							FClusterReferenceProcessor::MarkReferencedClustersAsReachable(RootObjectItem->GetClusterIndex(), ObjectsToSerialize);
+						}
+					}
+				}
+				else
+				{
+					checkSlow(ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot));
+					// this thing is definitely not marked unreachable, so don't test it here
+					// Make sure all referenced clusters are marked as reachable too
+					FClusterReferenceProcessor::MarkReferencedClustersAsReachable(ObjectItem->GetClusterIndex(), ObjectsToSerialize);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Performs reachability analysis.
+	 *
+	 * @param KeepFlags		Objects with these flags will be kept regardless of being referenced or not
+	 */
+	void PerformReachabilityAnalysis(EObjectFlags KeepFlags, bool bForceSingleThreaded, bool bWithClusters)
+	{
+		LLM_SCOPE(ELLMTag::GC);
+
+		SCOPED_NAMED_EVENT(FRealtimeGC_PerformReachabilityAnalysis, FColor::Red);
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FRealtimeGC::PerformReachabilityAnalysis"), STAT_FArchiveRealtimeGC_PerformReachabilityAnalysis, STATGROUP_GC);
+
+		/** Growing array of objects that require serialization */
+		FGCArrayStruct* ArrayStruct = FGCArrayPool::Get().GetArrayStructFromPool();
+		TArray<UObject*>& ObjectsToSerialize = ArrayStruct->ObjectsToSerialize;
+
+		// Reset object count.
+		GObjectCountDuringLastMarkPhase.Reset();
+
+		// Make sure GC referencer object is checked for references to other objects even if it resides in permanent object pool
+		if (FPlatformProperties::RequiresCookedData() && FGCObject::GGCObjectReferencer && GUObjectArray.IsDisregardForGC(FGCObject::GGCObjectReferencer))
+		{
+			ObjectsToSerialize.Add(FGCObject::GGCObjectReferencer);
+		}
+
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			(this->*MarkObjectsFunctions[GetGCFunctionIndex(!bForceSingleThreaded, bWithClusters)])(ObjectsToSerialize, KeepFlags);
+			UE_LOG(LogGarbage, Verbose, TEXT("%f ms for MarkObjectsAsUnreachable Phase (%d Objects To Serialize)"), (FPlatformTime::Seconds() - StartTime) * 1000, ObjectsToSerialize.Num());
+		}
+
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			PerformReachabilityAnalysisOnObjects(ArrayStruct, bForceSingleThreaded, bWithClusters);
+			UE_LOG(LogGarbage, Verbose, TEXT("%f ms for Reachability Analysis"), (FPlatformTime::Seconds() - StartTime) * 1000);
+		}
+        
+		// Allowing external systems to add object roots. This can't be done through AddReferencedObjects
+		// because it may require tracing objects (via FGarbageCollectionTracer) multiple times
+		FCoreUObjectDelegates::TraceExternalRootsForReachabilityAnalysis.Broadcast(*this, KeepFlags, bForceSingleThreaded);
+
+		FGCArrayPool::Get().ReturnToPool(ArrayStruct);
+
+#if UE_BUILD_DEBUG
+		FGCArrayPool::Get().CheckLeaks();
+#endif
+	}
+
+	virtual void PerformReachabilityAnalysisOnObjects(FGCArrayStruct* ArrayStruct, bool bForceSingleThreaded, bool bWithClusters) override
+	{
+		(this->*ReachabilityAnalysisFunctions[GetGCFunctionIndex(!bForceSingleThreaded, bWithClusters)])(ArrayStruct);
+	}
+};
+#endif // UE_WITH_GC
+
+// Allow parallel GC to be overridden to single threaded via console command.
+static int32 GAllowParallelGC = 1;
+
+static FAutoConsoleVariableRef CVarAllowParallelGC(
+	TEXT("gc.AllowParallelGC"),
+	GAllowParallelGC,
+	TEXT("Used to control parallel GC."),
+	ECVF_Default
+);
+
+/** Returns true if Garbage Collection should be forced to run on a single thread */
+static bool ShouldForceSingleThreadedGC()
+{
+	const bool bForceSingleThreadedGC = !FApp::ShouldUseThreadingForPerformance() || !FPlatformProcess::SupportsMultithreading() ||
+#if PLATFORM_SUPPORTS_MULTITHREADED_GC
+	(FPlatformMisc::NumberOfCores() < 2 || GAllowParallelGC == 0 || PERF_DETAILED_PER_CLASS_GC_STATS);
+#else	//PLATFORM_SUPPORTS_MULTITHREADED_GC
+		true;
+#endif	//PLATFORM_SUPPORTS_MULTITHREADED_GC
+	return bForceSingleThreadedGC;
+}
+
+#if UE_WITH_GC
+
+static int32 GAllowIncrementalReachability = 0;
+static FAutoConsoleVariableRef CVarAllowIncrementalReachability(
+	TEXT("gc.AllowIncrementalReachability"),
+	GAllowIncrementalReachability,
+	TEXT("If enabled, IncrementalCollectGarbage spreads reachability analysis over several calls. ")
+	TEXT("Opt in only if all code running calls GCWriteBarrier for every traced UObject reference it writes outside of reflection, which not all engine code does, or an object referenced that way may be destroyed."),
+	ECVF_Default
+);
+
+static int32 GIncrementalReachabilityRemark = 0;
+static FAutoConsoleVariableRef CVarIncrementalReachabilityRemark(
+	TEXT("gc.IncrementalReachabilityRemark"),
+	GIncrementalReachabilityRemark,
+	TEXT("If enabled, completing an incremental reachability analysis collects references from every object reached so far once more, so references written without GCWriteBarrier while it ran are found. ")
+	TEXT("This costs about as much as a single threaded full reachability analysis in the last slice, use it to keep incremental reachability safe while tracking down writes that are missing the barrier."),
+	ECVF_Default
+);
+
+static int32 GIncrementalReachabilityBatchSize = 256;
+static FAutoConsoleVariableRef CVarIncrementalReachabilityBatchSize(
+	TEXT("gc.IncrementalReachabilityBatchSize"),
+	GIncrementalReachabilityBatchSize,
+	TEXT("Number of objects incremental reachability analysis collects references from between time limit checks."),
+	ECVF_Default
+);
+
+static int32 GVerifyIncrementalReachability = 0;
+static FAutoConsoleVariableRef CVarVerifyIncrementalReachability(
+	TEXT("gc.VerifyIncrementalReachability"),
+	GVerifyIncrementalReachability,
+	TEXT("If enabled, incremental reachability analysis is checked against a full one when it completes. Objects it missed are reported and kept."),
+	ECVF_Default
+);
+
+bool GIsIncrementalReachabilityPending = false;
+
+/**
+ * Reachability analysis spread over several IncrementalCollectGarbage calls.
+ *
+ * Objects are marked MaybeUnreachable up front and every object reached is queued as a gray object, each call collects
+ * references from gray objects until it runs out of time. Unreachable is only set once the analysis completes so weak
+ * pointers and object lookups keep working in between.
+ * Objects created in between are never marked, and together with roots and FGCObjects they are scanned again when the
+ * analysis completes. References written in between must go through GCWriteBarrier, which reflection and Blueprint
+ * assignments do but native code and containers generally don't. gc.IncrementalReachabilityRemark finds those by
+ * collecting references from every reached object again once the analysis completes, at the cost of a full mark.
+ */
+class FIncrementalReachabilityAnalysis : public FRealtimeGC, public FUObjectArray::FUObjectCreateListener
+{
+	typedef FGCReferenceProcessor<EFastReferenceCollectorOptions::WithClusters | EFastReferenceCollectorOptions::Incremental> FClusterReferenceProcessor;
+
+	/** Objects reached that still need their references collected, only touched with the GC lock held */
+	TArray<UObject*> GrayObjects;
+	/** Objects passed to the write barrier and objects created since the analysis started, from any thread */
+	TArray<UObject*> BarrierObjects;
+	TArray<UObject*> CreatedObjects;
+	FCriticalSection PendingObjectsCritical;
+
+	EObjectFlags KeepFlags;
+	bool bWithClusters;
+	bool bListening;
+
+	void AddGCObjectReferencer()
+	{
+		// Make sure GC referencer object is checked for references to other objects even if it resides in permanent object pool
+		if (FPlatformProperties::RequiresCookedData() && FGCObject::GGCObjectReferencer && GUObjectArray.IsDisregardForGC(FGCObject::GGCObjectReferencer))
+		{
+			GrayObjects.Add(FGCObject::GGCObjectReferencer);
+		}
+	}
+
+	/** Queues an object whether or not it has been reached already, the way roots are queued when the analysis starts */
+	void AddRoot(UObject* Object)
+	{
+		FUObjectItem* ObjectItem = GUObjectArray.ObjectToObjectItem(Object);
+		ObjectItem->ClearGCFlags(EGCObjectFlags::MaybeUnreachable);
+		GrayObjects.Add(Object);
+
+		if (bWithClusters)
+		{
+			if (ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot))
+			{
+				FClusterReferenceProcessor::MarkReferencedClustersAsReachable(ObjectItem->GetClusterIndex(), GrayObjects);
+			}
+			else if (ObjectItem->GetOwnerIndex() > 0)
+			{
+				ObjectItem->SetFlags(EInternalObjectFlags::ReachableInCluster);
+				FUObjectItem* RootObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(ObjectItem->GetOwnerIndex());
+				if (RootObjectItem->ThisThreadAtomicallyClearedGCFlag(EGCObjectFlags::MaybeUnreachable))
+				{
+					FClusterReferenceProcessor::MarkReferencedClustersAsReachable(RootObjectItem->GetClusterIndex(), GrayObjects);
+				}
+			}
+		}
+	}
+
+	/** Roots, FGCObjects and new objects don't go through the write barrier so they are scanned again before the analysis completes */
+	void AddRootsAgain()
+	{
+		AddGCObjectReferencer();
+
+		const EInternalObjectFlags RootFlags = EInternalObjectFlags::RootSet | EInternalObjectFlags::GarbageCollectionKeepFlags;
+		const EObjectFlags LocalKeepFlags = KeepFlags;
+		const int32 MaxNumberOfObjects = GUObjectArray.GetObjectArrayNum() - GUObjectArray.GetFirstGCIndex();
+		const int32 NumThreads = FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+		const int32 NumberOfObjectsPerThread = (MaxNumberOfObjects / NumThreads) + 1;
+		TArray<UObject*> Roots;
+		FCriticalSection RootsCritical;
+
+		ParallelFor(NumThreads, [&Roots, &RootsCritical, RootFlags, LocalKeepFlags, NumberOfObjectsPerThread, NumThreads, MaxNumberOfObjects](int32 ThreadIndex)
+		{
+			int32 FirstObjectIndex = ThreadIndex * NumberOfObjectsPerThread + GUObjectArray.GetFirstGCIndex();
+			int32 NumObjects = (ThreadIndex < (NumThreads - 1)) ? NumberOfObjectsPerThread : (MaxNumberOfObjects - (NumThreads - 1) * NumberOfObjectsPerThread);
+			int32 LastObjectIndex = FMath::Min(GUObjectArray.GetObjectArrayNum() - 1, FirstObjectIndex + NumObjects - 1);
+			TArray<UObject*> ThisThreadRoots;
+
+			for (int32 ObjectIndex = FirstObjectIndex; ObjectIndex <= LastObjectIndex; ++ObjectIndex)
+			{
+				FUObjectItem* ObjectItem = &GUObjectArray.GetObjectItemArrayUnsafe()[ObjectIndex];
+				UObject* Object = (UObject*)ObjectItem->Object;
+				// If KeepFlags is non zero this is going to be very slow due to cache misses
+				if (Object && (ObjectItem->HasAnyFlags(RootFlags) || (LocalKeepFlags != RF_NoFlags && !ObjectItem->IsPendingKill() && Object->HasAnyFlags(LocalKeepFlags))))
+				{
+					ThisThreadRoots.Add(Object);
+				}
+			}
+			if (ThisThreadRoots.Num())
+			{
+				FScopeLock RootsLock(&RootsCritical);
+				Roots.Append(ThisThreadRoots);
+			}
+		}, ShouldForceSingleThreadedGC());
+
+		{
+			FScopeLock Lock(&PendingObjectsCritical);
+			Roots.Append(CreatedObjects);
+			CreatedObjects.Empty();
+		}
+		for (UObject* Object : Roots)
+		{
+			AddRoot(Object);
+		}
+	}
+
+	template <EFastReferenceCollectorOptions CollectorOptions>
+	bool ProcessGrayObjects(bool bUseTimeLimit, float TimeLimit)
+	{
+		FGCReferenceProcessor<CollectorOptions> ReferenceProcessor(GrayObjects);
+		TFastReferenceCollector<
+			FGCReferenceProcessor<CollectorOptions>,
+			FGCCollector<CollectorOptions>,
+			FGCArrayPool,
+			CollectorOptions
+			> ReferenceCollector(ReferenceProcessor, FGCArrayPool::Get());
+		FGCArrayStruct* ArrayStruct = FGCArrayPool::Get().GetArrayStructFromPool();
+		TArray<UObject*> NewBarrierObjects;
+
+		const double StartTime = FPlatformTime::Seconds();
+		const int32 BatchSize = FMath::Max(1, GIncrementalReachabilityBatchSize);
+		bool bFinished = false;
+		while (true)
+		{
+			{
+				FScopeLock Lock(&PendingObjectsCritical);
+				Exchange(NewBarrierObjects, BarrierObjects);
+			}
+			for (UObject* Object : NewBarrierObjects)
+			{
+				ReferenceProcessor.HandleObjectReference(GrayObjects, nullptr, Object, false);
+			}
+			NewBarrierObjects.Reset();
+
+			if (GrayObjects.Num() == 0)
+			{
+				bFinished = true;
+				break;
+			}
+
+			// Most recently reached objects first keeps the gray list short, like a depth first traversal
+			const int32 NumObjects = FMath::Min(GrayObjects.Num(), BatchSize);
+			ArrayStruct->ObjectsToSerialize.Append(GrayObjects.GetData() + GrayObjects.Num() - NumObjects, NumObjects);
+			GrayObjects.RemoveAt(GrayObjects.Num() - NumObjects, NumObjects, false);
+			ReferenceCollector.CollectReferences(*ArrayStruct);
+			ArrayStruct->ObjectsToSerialize.Reset();
+
+			if (bUseTimeLimit && (FPlatformTime::Seconds() - StartTime) > TimeLimit)
+			{
+				break;
+			}
+		}
+
+		FGCArrayPool::Get().ReturnToPool(ArrayStruct);
+		return bFinished;
+	}
+
+	bool ProcessGrayObjects(bool bUseTimeLimit, float TimeLimit)
+	{
+		if (bWithClusters)
+		{
+			return ProcessGrayObjects<EFastReferenceCollectorOptions::Incremental | EFastReferenceCollectorOptions::WithClusters>(bUseTimeLimit, TimeLimit);
+		}
+		return ProcessGrayObjects<EFastReferenceCollectorOptions::Incremental>(bUseTimeLimit, TimeLimit);
+	}
+
+	/**
+	 * Queues every object reached so far. References written while the analysis ran without the write barrier may lead
+	 * from them to objects that are still MaybeUnreachable, collecting their references again with the GC lock held finds those.
+	 * Clustered objects are reached through their cluster root, like in a full reachability analysis.
+	 */
+	void AddReachedObjects()
+	{
+		const int32 MaxNumberOfObjects = GUObjectArray.GetObjectArrayNum() - GUObjectArray.GetFirstGCIndex();
+		const int32 NumThreads = FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+		const int32 NumberOfObjectsPerThread = (MaxNumberOfObjects / NumThreads) + 1;
+		TArray<UObject*> Reached;
+		FCriticalSection ReachedCritical;
+
+		ParallelFor(NumThreads, [&Reached, &ReachedCritical, NumberOfObjectsPerThread, NumThreads, MaxNumberOfObjects](int32 ThreadIndex)
+		{
+			int32 FirstObjectIndex = ThreadIndex * NumberOfObjectsPerThread + GUObjectArray.GetFirstGCIndex();
+			int32 NumObjects = (ThreadIndex < (NumThreads - 1)) ? NumberOfObjectsPerThread : (MaxNumberOfObjects - (NumThreads - 1) * NumberOfObjectsPerThread);
+			int32 LastObjectIndex = FMath::Min(GUObjectArray.GetObjectArrayNum() - 1, FirstObjectIndex + NumObjects - 1);
+			TArray<UObject*> ThisThreadReached;
+
+			for (int32 ObjectIndex = FirstObjectIndex; ObjectIndex <= LastObjectIndex; ++ObjectIndex)
+			{
+				FUObjectItem* ObjectItem = &GUObjectArray.GetObjectItemArrayUnsafe()[ObjectIndex];
+				if (ObjectItem->Object && ObjectItem->GetOwnerIndex() <= 0 && !ObjectItem->HasAnyGCFlags(EGCObjectFlags::MaybeUnreachable) && !ObjectItem->IsUnreachable())
+				{
+					ThisThreadReached.Add((UObject*)ObjectItem->Object);
+				}
+			}
+			if (ThisThreadReached.Num())
+			{
+				FScopeLock ReachedLock(&ReachedCritical);
+				Reached.Append(ThisThreadReached);
+			}
+		}, ShouldForceSingleThreadedGC());
+
+		AddGCObjectReferencer();
+		GrayObjects.Append(Reached);
+	}
+
+	/** Replaces MaybeUnreachable with NewFlags on every object */
+	static void ReplaceMaybeUnreachable(EInternalObjectFlags NewFlags)
+	{
+		const int32 MaxNumberOfObjects = GUObjectArray.GetObjectArrayNum() - GUObjectArray.GetFirstGCIndex();
+		const int32 NumThreads = FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+		const int32 NumberOfObjectsPerThread = (MaxNumberOfObjects / NumThreads) + 1;
+
+		ParallelFor(NumThreads, [NewFlags, NumberOfObjectsPerThread, NumThreads, MaxNumberOfObjects](int32 ThreadIndex)
+		{
+			int32 FirstObjectIndex = ThreadIndex * NumberOfObjectsPerThread + GUObjectArray.GetFirstGCIndex();
+			int32 NumObjects = (ThreadIndex < (NumThreads - 1)) ? NumberOfObjectsPerThread : (MaxNumberOfObjects - (NumThreads - 1) * NumberOfObjectsPerThread);
+			int32 LastObjectIndex = FMath::Min(GUObjectArray.GetObjectArrayNum() - 1, FirstObjectIndex + NumObjects - 1);
+
+			for (int32 ObjectIndex = FirstObjectIndex; ObjectIndex <= LastObjectIndex; ++ObjectIndex)
+			{
+				FUObjectItem* ObjectItem = &GUObjectArray.GetObjectItemArrayUnsafe()[ObjectIndex];
+				if (ObjectItem->HasAnyGCFlags(EGCObjectFlags::MaybeUnreachable))
+				{
+					ObjectItem->ClearGCFlags(EGCObjectFlags::MaybeUnreachable);
+					if (NewFlags != EInternalObjectFlags::None)
+					{
+						ObjectItem->SetFlags(NewFlags);
+					}
+				}
+			}
+		}, ShouldForceSingleThreadedGC());
+	}
+
+	/** Runs a full reachability analysis and reports what the incremental one would have destroyed while still referenced */
+	void Verify()
+	{
+		TArray<FUObjectItem*> MaybeUnreachableObjects;
+		for (int32 ObjectIndex = GUObjectArray.GetFirstGCIndex(); ObjectIndex < GUObjectArray.GetObjectArrayNum(); ++ObjectIndex)
+		{
+			FUObjectItem* ObjectItem = &GUObjectArray.GetObjectItemArrayUnsafe()[ObjectIndex];
+			if (ObjectItem->HasAnyGCFlags(EGCObjectFlags::MaybeUnreachable))
+			{
+				ObjectItem->ClearGCFlags(EGCObjectFlags::MaybeUnreachable);
+				MaybeUnreachableObjects.Add(ObjectItem);
+			}
+		}
+
+		// External roots have to be traced by a regular FRealtimeGC this time
+		FRealtimeGC TagUsedRealtimeGC;
+		TagUsedRealtimeGC.PerformReachabilityAnalysis(KeepFlags, ShouldForceSingleThreadedGC(), bWithClusters);
+
+		int32 NumMissed = 0;
+		for (FUObjectItem* ObjectItem : MaybeUnreachableObjects)
+		{
+			if (!ObjectItem->IsUnreachable())
+			{
+				UE_CLOG(NumMissed < 32, LogGarbage, Warning, TEXT("Incremental reachability analysis missed a reference to %s, it was written without GCWriteBarrier"), *static_cast<UObject*>(ObjectItem->Object)->GetFullName());
+				NumMissed++;
+			}
+		}
+		UE_CLOG(NumMissed > 0, LogGarbage, Error, TEXT("Incremental reachability analysis missed %d referenced objects"), NumMissed);
+	}
+
+public:
+	FIncrementalReachabilityAnalysis()
+		: KeepFlags(RF_NoFlags)
+		, bWithClusters(false)
+		, bListening(false)
+	{
+	}
+
+	EObjectFlags GetKeepFlags() const
+	{
+		return KeepFlags;
+	}
+
+	bool IsWithClusters() const
+	{
+		return bWithClusters;
+	}
+
+	/** Marks everything that isn't a root MaybeUnreachable. Called with the GC lock held */
+	void Begin(EObjectFlags InKeepFlags, bool bInWithClusters)
+	{
+		check(!GIsIncrementalReachabilityPending);
+		if (!bListening)
+		{
+			// Objects can't be created while we hold the GC lock so it's safe to add the listener here
+			GUObjectArray.AddUObjectCreateListener(this);
+			bListening = true;
+		}
+
+		KeepFlags = InKeepFlags;
+		bWithClusters = bInWithClusters;
+		GrayObjects.Reset();
+		{
+			FScopeLock Lock(&PendingObjectsCritical);
+			BarrierObjects.Reset();
+			CreatedObjects.Reset();
+		}
+
+		// Reset object count.
+		GObjectCountDuringLastMarkPhase.Reset();
+
+		AddGCObjectReferencer();
+		const bool bParallel = !ShouldForceSingleThreadedGC();
+		if (bWithClusters)
+		{
+			if (bParallel)
+			{
+				MarkObjectsAsUnreachable<true, true, true>(GrayObjects, KeepFlags);
+			}
+			else
+			{
+				MarkObjectsAsUnreachable<false, true, true>(GrayObjects, KeepFlags);
+			}
+		}
+		else
+		{
+			if (bParallel)
+			{
+				MarkObjectsAsUnreachable<true, false, true>(GrayObjects, KeepFlags);
+			}
+			else
+			{
+				MarkObjectsAsUnreachable<false, false, true>(GrayObjects, KeepFlags);
+			}
+		}
+
+		GIsIncrementalReachabilityPending = true;
+	}
+
+	/**
+	 * Collects references until there's nothing left to reach or the time limit runs out. Called with the GC lock held
+	 * @return true if there's nothing left to reach before Finish
+	 */
+	bool Tick(float TimeLimit)
+	{
+		check(GIsIncrementalReachabilityPending);
+		return ProcessGrayObjects(true, TimeLimit);
+	}
+
+	/** Completes the analysis and leaves the Unreachable flags the way PerformReachabilityAnalysis does. Called with the GC lock held */
+	void Finish()
+	{
+		check(GIsIncrementalReachabilityPending);
+		AddRootsAgain();
+		ProcessGrayObjects(false, 0.0f);
+		if (GIncrementalReachabilityRemark)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			AddReachedObjects();
+			const int32 NumReached = GrayObjects.Num();
+			ProcessGrayObjects(false, 0.0f);
+			UE_LOG(LogGarbage, Log, TEXT("%f ms for re-marking %d objects reached by incremental reachability analysis"), (FPlatformTime::Seconds() - StartTime) * 1000, NumReached);
+		}
+
+		// Allowing external systems to add object roots. This can't be done through AddReferencedObjects
+		// because it may require tracing objects (via FGarbageCollectionTracer) multiple times
+		FCoreUObjectDelegates::TraceExternalRootsForReachabilityAnalysis.Broadcast(*this, KeepFlags, true);
+
+		GIsIncrementalReachabilityPending = false;
+		if (GVerifyIncrementalReachability)
+		{
+			Verify();
+		}
+		else
+		{
+			ReplaceMaybeUnreachable(EInternalObjectFlags::Unreachable);
+		}
+	}
+
+	/** Throws away the analysis in progress. Called with the GC lock held */
+	void Cancel()
+	{
+		check(GIsIncrementalReachabilityPending);
+		GIsIncrementalReachabilityPending = false;
+		ReplaceMaybeUnreachable(EInternalObjectFlags::None);
+		GrayObjects.Empty();
+		FScopeLock Lock(&PendingObjectsCritical);
+		BarrierObjects.Empty();
+		CreatedObjects.Empty();
+	}
+
+	/** Write barrier, any thread */
+	void MarkAsReachable(UObject* Object)
+	{
+		if (GUObjectAllocator.ResidesInPermanentPool(Object))
+		{
+			return;
+		}
+		FUObjectItem* ObjectItem = GUObjectArray.ObjectToObjectItem(Object);
+		if (ObjectItem->HasAnyGCFlags(EGCObjectFlags::MaybeUnreachable) || (ObjectItem->GetOwnerIndex() > 0 && !ObjectItem->HasAnyFlags(EInternalObjectFlags::ReachableInCluster)))
+		{
+			// Marked the next time gray objects are processed, the GC lock prevents that from happening concurrently
+			FScopeLock Lock(&PendingObjectsCritical);
+			BarrierObjects.Add(Object);
+		}
+	}
+
+	//~ Begin FGarbageCollectionTracer Interface
+	virtual void PerformReachabilityAnalysisOnObjects(FGCArrayStruct* ArrayStruct, bool bForceSingleThreaded, bool bInWithClusters) override
+	{
+		for (UObject* Object : ArrayStruct->ObjectsToSerialize)
+		{
+			AddRoot(Object);
+		}
+		ProcessGrayObjects(false, 0.0f);
+	}
+	//~ End FGarbageCollectionTracer Interface
+
+	//~ Begin FUObjectCreateListener Interface
+	virtual void NotifyUObjectCreated(const class UObjectBase *Object, int32 Index) override
+	{
+		if (GIsIncrementalReachabilityPending)
+		{
+			FScopeLock Lock(&PendingObjectsCritical);
+			CreatedObjects.Add((UObject*)Object);
+		}
+	}
+
+	virtual void OnUObjectArrayShutdown() override
+	{
+		GUObjectArray.RemoveUObjectCreateListener(this);
+		bListening = false;
+	}
+	//~ End FUObjectCreateListener Interface
+};
+
+static FIncrementalReachabilityAnalysis GIncrementalReachabilityAnalysis;
+
+void MarkAsReachableForIncrementalGC(UObject* Object)
+{
+	GIncrementalReachabilityAnalysis.MarkAsReachable(Object);
+}
+
+static int32 GAllowMinorCollections = 0;
+static FAutoConsoleVariableRef CVarAllowMinorCollections(
+	TEXT("gc.AllowMinorCollections"),
+	GAllowMinorCollections,
+	TEXT("If enabled, objects created since the last garbage collection are tracked so TryCollectYoungGarbage can collect them without traversing older objects. ")
+	TEXT("Opt in only if all code running calls GCWriteBarrier for every UObject reference it writes outside of reflection, which not all engine code does, or a young object referenced only from an old one is destroyed. Takes effect after the next garbage collection."),
+	ECVF_Default
+);
+
+static int32 GVerifyMinorCollections = 0;
+static FAutoConsoleVariableRef CVarVerifyMinorCollections(
+	TEXT("gc.VerifyMinorCollections"),
+	GVerifyMinorCollections,
+	TEXT("If enabled, minor garbage collections are checked against a full reachability analysis, for finding writes that are missing GCWriteBarrier. Young objects they missed are reported and the collection continues as a full one."),
+	ECVF_Default
+);
+
+bool GIsTrackingYoungObjects = false;
+
+/**
+ * Reachability analysis limited to the young generation, the objects created since the last garbage collection.
+ *
+ * Only young objects are marked unreachable so the traversal stops at every reference to an older object. Roots are
+ * young objects with keep flags, FGCObjects, external tracers and the remembered set of references from older objects:
+ * the referencers passed to the write barrier, and young objects written where the referencer isn't known. Every young
+ * object is promoted once the analysis is done.
+ */
+class FYoungReachabilityAnalysis : public FRealtimeGC
+{
+	/** Old objects a young object was written to since the last garbage collection, from any thread */
+	TSet<UObject*> RememberedReferencers;
+	/** Young objects written to an unknown referencer since the last garbage collection, from any thread */
+	TArray<UObject*> RememberedObjects;
+	FCriticalSection RememberedObjectsCritical;
+
+	/** Young objects marked unreachable by the last analysis */
+	TArray<FUObjectItem*> UnreachableYoungObjects;
+
+public:
+	/** Write barrier, any thread */
+	void Remember(UObject* Object)
+	{
+		if (GUObjectAllocator.ResidesInPermanentPool(Object))
+		{
+			return;
+		}
+		// Remembered objects are old from now on, the next minor collection traces them instead
+		FUObjectItem* ObjectItem = GUObjectArray.ObjectToObjectItem(Object);
+		if (ObjectItem->HasAnyGCFlags(EGCObjectFlags::Young) && ObjectItem->ThisThreadAtomicallyClearedGCFlag(EGCObjectFlags::Young))
+		{
+			FScopeLock Lock(&RememberedObjectsCritical);
+			RememberedObjects.Add(Object);
+		}
+	}
+
+	/** Write barrier, any thread */
+	void RememberReferencer(UObject* Referencer, UObject* Object)
+	{
+		if (GUObjectAllocator.ResidesInPermanentPool(Object) || !GUObjectArray.ObjectToObjectItem(Object)->HasAnyGCFlags(EGCObjectFlags::Young))
+		{
+			return;
+		}
+		// Young referencers are traced anyway if they're reachable, unreachable ones are about to be destroyed
+		FUObjectItem* ReferencerItem = GUObjectArray.ObjectToObjectItem(Referencer);
+		if (!ReferencerItem->HasAnyGCFlags(EGCObjectFlags::Young) && !ReferencerItem->IsUnreachable())
+		{
+			FScopeLock Lock(&RememberedObjectsCritical);
+			RememberedReferencers.Add(Referencer);
+		}
+	}
+
+	/** Forgets remembered objects and promotes all young ones after a full reachability analysis. Called with the GC lock held */
+	void Reset()
+	{
 		{
-			TArray<FUObjectItem*> KeepClusterRefs;
-			KeepClusterRefsList.PopAll(KeepClusterRefs);
-			for (FUObjectItem* ObjectItem : KeepClusterRefs)
-			{
-				if (ObjectItem->GetOwnerIndex() > 0)
-				{
-					checkSlow(!ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot));
-					bool bNeedsDoing = !ObjectItem->HasAnyFlags(EInternalObjectFlags::ReachableInCluster);
-					if (bNeedsDoing)
-					{
-						ObjectItem->SetFlags(EInternalObjectFlags::ReachableInCluster);
-						// Make sure cluster root object is reachable too
-						const int32 OwnerIndex = ObjectItem->GetOwnerIndex();
-						FUObjectItem* RootObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(OwnerIndex);
-						checkSlow(RootObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot));
-						// if it is reachable via keep flags we will do this below (or maybe already have)
-						if (RootObjectItem->IsUnreachable()) 
-						{
-							RootObjectItem->ClearFlags(EInternalObjectFlags::Unreachable);
-							// Make sure all referenced clusters are marked as reachable too
-							FGCReferenceProcessor<EFastReferenceCollectorOptions::WithClusters>::MarkReferencedClustersAsReachable(RootObjectItem->GetClusterIndex(), ObjectsToSerialize);
-						}
-					}
-				}
-				else
-				{
-					checkSlow(ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot));
-					// this thing is definitely not marked unreachable, so don't test it here
-					// Make sure all referenced clusters are marked as reachable too
-					FGCReferenceProcessor<EFastReferenceCollectorOptions::WithClusters>::MarkReferencedClustersAsReachable(ObjectItem->GetClusterIndex(), ObjectsToSerialize);
-				}
-			}
+			FScopeLock Lock(&RememberedObjectsCritical);
+			RememberedReferencers.Reset();
+			RememberedObjects.Reset();
 		}
+		GUObjectArray.PromoteYoungObjects();
+		UnreachableYoungObjects.Reset();
 	}
 
-	/**
-	 * Performs reachability analysis.
-	 *
-	 * @param KeepFlags		Objects with these flags will be kept regardless of being referenced or not
-	 */
-	void PerformReachabilityAnalysis(EObjectFlags KeepFlags, bool bForceSingleThreaded, bool bWithClusters)
+	/** Marks unreachable young objects with EInternalObjectFlags::Unreachable. Called with the GC lock held */
+	void PerformYoungReachabilityAnalysis(EObjectFlags KeepFlags, bool bForceSingleThreaded)
 	{
 		LLM_SCOPE(ELLMTag::GC);
+		SCOPED_NAMED_EVENT(FYoungReachabilityAnalysis_PerformReachabilityAnalysis, FColor::Red);
 
-		SCOPED_NAMED_EVENT(FRealtimeGC_PerformReachabilityAnalysis, FColor::Red);
-		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FRealtimeGC::PerformReachabilityAnalysis"), STAT_FArchiveRealtimeGC_PerformReachabilityAnalysis, STATGROUP_GC);
-
-		/** Growing array of objects that require serialization */
 		FGCArrayStruct* ArrayStruct = FGCArrayPool::Get().GetArrayStructFromPool();
 		TArray<UObject*>& ObjectsToSerialize = ArrayStruct->ObjectsToSerialize;
 
-		// Reset object count.
-		GObjectCountDuringLastMarkPhase.Reset();
-
-		// Make sure GC referencer object is checked for references to other objects even if it resides in permanent object pool
-		if (FPlatformProperties::RequiresCookedData() && FGCObject::GGCObjectReferencer && GUObjectArray.IsDisregardForGC(FGCObject::GGCObjectReferencer))
+		// FGCObjects are never young, but they're few and may reference young objects
+		if (FGCObject::GGCObjectReferencer)
 		{
 			ObjectsToSerialize.Add(FGCObject::GGCObjectReferencer);
 		}
-
 		{
-			const double StartTime = FPlatformTime::Seconds();
-			(this->*MarkObjectsFunctions[GetGCFunctionIndex(!bForceSingleThreaded, bWithClusters)])(ObjectsToSerialize, KeepFlags);
-			UE_LOG(LogGarbage, Verbose, TEXT("%f ms for MarkObjectsAsUnreachable Phase (%d Objects To Serialize)"), (FPlatformTime::Seconds() - StartTime) * 1000, ObjectsToSerialize.Num());
+			FScopeLock Lock(&RememberedObjectsCritical);
+			for (UObject* Referencer : RememberedReferencers)
+			{
+				ObjectsToSerialize.Add(Referencer);
+			}
+			ObjectsToSerialize.Append(RememberedObjects);
+			RememberedReferencers.Reset();
+			RememberedObjects.Reset();
 		}
 
+		TArray<int32> YoungObjectIndices;
+		GUObjectArray.ExtractYoungObjectIndices(YoungObjectIndices);
+		UnreachableYoungObjects.Reset();
+		for (int32 ObjectIndex : YoungObjectIndices)
 		{
-			const double StartTime = FPlatformTime::Seconds();
-			PerformReachabilityAnalysisOnObjects(ArrayStruct, bForceSingleThreaded, bWithClusters);
-			UE_LOG(LogGarbage, Verbose, TEXT("%f ms for Reachability Analysis"), (FPlatformTime::Seconds() - StartTime) * 1000);
+			FUObjectItem* ObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(ObjectIndex);
+			// Skips stale and repeated indices, everything that is left gets promoted now
+			if (!ObjectItem->Object || !ObjectItem->HasAnyGCFlags(EGCObjectFlags::Young))
+			{
+				continue;
+			}
+			ObjectItem->ClearGCFlags(EGCObjectFlags::Young);
+
+			UObject* Object = static_cast<UObject*>(ObjectItem->Object);
+			checkf(!ObjectItem->HasAnyFlags(EInternalObjectFlags::Unreachable | EInternalObjectFlags::PendingConstruction), TEXT("%s"), *Object->GetFullName());
+
+			// Clustered objects are kept by their cluster until the next full collection. Loaded objects rarely die young
+			// and native code keeps them without the write barrier, LoadObject results especially.
+			const bool bKeep = ObjectItem->HasAnyFlags(EInternalObjectFlags::RootSet | EInternalObjectFlags::GarbageCollectionKeepFlags | EInternalObjectFlags::ClusterRoot) ||
+				ObjectItem->GetOwnerIndex() > 0 ||
+				Object->HasAnyFlags(RF_WasLoaded) ||
+				(KeepFlags != RF_NoFlags && !ObjectItem->IsPendingKill() && Object->HasAnyFlags(KeepFlags));
+			if (bKeep)
+			{
+				ObjectsToSerialize.Add(Object);
+			}
+			else
+			{
+				ObjectItem->SetFlags(EInternalObjectFlags::Unreachable);
+				UnreachableYoungObjects.Add(ObjectItem);
+			}
 		}
-        
+		UE_LOG(LogGarbage, Verbose, TEXT("%d young objects, %d roots"), YoungObjectIndices.Num(), ObjectsToSerialize.Num());
+
+		PerformReachabilityAnalysisOnObjects(ArrayStruct, bForceSingleThreaded, false);
+
 		// Allowing external systems to add object roots. This can't be done through AddReferencedObjects
 		// because it may require tracing objects (via FGarbageCollectionTracer) multiple times
 		FCoreUObjectDelegates::TraceExternalRootsForReachabilityAnalysis.Broadcast(*this, KeepFlags, bForceSingleThreaded);
 
 		FGCArrayPool::Get().ReturnToPool(ArrayStruct);
+	}
 
-#if UE_BUILD_DEBUG
-		FGCArrayPool::Get().CheckLeaks();
-#endif
+	/** Gathers unreachable objects for IncrementalPurgeGarbage without going through the whole object array */
+	void GatherUnreachableYoungObjects()
+	{
+		GUnreachableObjects.Reset();
+		GUnrechableObjectIndex = 0;
+		for (FUObjectItem* ObjectItem : UnreachableYoungObjects)
+		{
+			if (ObjectItem->IsUnreachable())
+			{
+				GUnreachableObjects.Add(ObjectItem);
+			}
+		}
+		UE_LOG(LogGarbage, Log, TEXT("%d young objects collected out of %d considered"), GUnreachableObjects.Num(), UnreachableYoungObjects.Num());
+		UnreachableYoungObjects.Reset();
+	}
+
+	/**
+	 * Runs a full reachability analysis over the result of the young one and reports young objects it would have destroyed
+	 * while still referenced. Leaves the Unreachable flags of the full analysis.
+	 */
+	void Verify(EObjectFlags KeepFlags, bool bForceSingleThreaded, bool bWithClusters)
+	{
+		for (FUObjectItem* ObjectItem : UnreachableYoungObjects)
+		{
+			ObjectItem->ClearFlags(EInternalObjectFlags::Unreachable);
+		}
+
+		FRealtimeGC TagUsedRealtimeGC;
+		TagUsedRealtimeGC.PerformReachabilityAnalysis(KeepFlags, bForceSingleThreaded, bWithClusters);
+
+		int32 NumMissed = 0;
+		for (FUObjectItem* ObjectItem : UnreachableYoungObjects)
+		{
+			if (!ObjectItem->IsUnreachable())
+			{
+				UE_CLOG(NumMissed < 32, LogGarbage, Warning, TEXT("Minor garbage collection missed a reference to %s, it was written without GCWriteBarrier"), *static_cast<UObject*>(ObjectItem->Object)->GetFullName());
+				NumMissed++;
+			}
+		}
+		UE_CLOG(NumMissed > 0, LogGarbage, Error, TEXT("Minor garbage collection missed %d referenced young objects"), NumMissed);
+		UnreachableYoungObjects.Reset();
 	}
 
+	//~ Begin FGarbageCollectionTracer Interface
 	virtual void PerformReachabilityAnalysisOnObjects(FGCArrayStruct* ArrayStruct, bool bForceSingleThreaded, bool bWithClusters) override
 	{
-		(this->*ReachabilityAnalysisFunctions[GetGCFunctionIndex(!bForceSingleThreaded, bWithClusters)])(ArrayStruct);
+		// Clustered objects are never young, and only need to be traced during full reachability analysis
+		FRealtimeGC::PerformReachabilityAnalysisOnObjects(ArrayStruct, bForceSingleThreaded, false);
 	}
+	//~ End FGarbageCollectionTracer Interface
 };
-#endif // UE_WITH_GC
 
-// Allow parallel GC to be overridden to single threaded via console command.
-static int32 GAllowParallelGC = 1;
+static FYoungReachabilityAnalysis GYoungReachabilityAnalysis;
 
-static FAutoConsoleVariableRef CVarAllowParallelGC(
-	TEXT("gc.AllowParallelGC"),
-	GAllowParallelGC,
-	TEXT("Used to control parallel GC."),
-	ECVF_Default
-);
+void RememberYoungObjectForGC(UObject* Object)
+{
+	GYoungReachabilityAnalysis.Remember(Object);
+}
 
-/** Returns true if Garbage Collection should be forced to run on a single thread */
-static bool ShouldForceSingleThreadedGC()
+void RememberReferencerForGC(UObject* Referencer, UObject* Object)
 {
-	const bool bForceSingleThreadedGC = !FApp::ShouldUseThreadingForPerformance() || !FPlatformProcess::SupportsMultithreading() ||
-#if PLATFORM_SUPPORTS_MULTITHREADED_GC
-	(FPlatformMisc::NumberOfCores() < 2 || GAllowParallelGC == 0 || PERF_DETAILED_PER_CLASS_GC_STATS);
-#else	//PLATFORM_SUPPORTS_MULTITHREADED_GC
-		true;
-#endif	//PLATFORM_SUPPORTS_MULTITHREADED_GC
-	return bForceSingleThreadedGC;
+	GYoungReachabilityAnalysis.RememberReferencer(Referencer, Object);
+}
+#else
+bool GIsIncrementalReachabilityPending = false;
+bool GIsTrackingYoungObjects = false;
+
+void MarkAsReachableForIncrementalGC(UObject* Object)
+{
+}
+
+void RememberYoungObjectForGC(UObject* Object)
+{
+}
+
+void RememberReferencerForGC(UObject* Referencer, UObject* Object)
+{
+}
+#endif // UE_WITH_GC
+
+bool IsIncrementalReachabilityAnalysisPending()
+{
+	return GIsIncrementalReachabilityPending;
 }
 
 void AcquireGCLock()
@@ -1931,13 +2695,75 @@ void GatherUnreachableObjects(bool bForceSingleThreaded)
 		ClusterItemsToDestroy.Num());
 }
 
+#if UE_WITH_GC
+static void FlushStreamingForGC()
+{
+	// Flush streaming before GC if requested
+	if (GFlushStreamingOnGC)
+	{
+		if (IsAsyncLoading())
+		{
+			UE_LOG(LogGarbage, Log, TEXT("CollectGarbageInternal() is flushing async loading"));
+		}
+		FGCCSyncObject::Get().GCUnlock();
+		FlushAsyncLoading();
+		FGCCSyncObject::Get().GCLock();
+	}
+}
+
+/** Whether GC clusters take part in the next reachability analysis, dissolves them if they have been disabled */
+static bool PrepareClustersForGC()
+{
+	// This can happen if someone disables clusters from the console (gc.CreateGCClusters)
+	if (!GCreateGCClusters && GUObjectClusters.GetNumAllocatedClusters())
+	{
+		GUObjectClusters.DissolveClusters(true);
+	}
+	// Run with GC clustering code enabled only if clustering is enabled and there's actual allocated clusters
+	return !!GCreateGCClusters && GUObjectClusters.GetNumAllocatedClusters();
+}
+
+/** Starts the reachability analysis IncrementalCollectGarbage continues, called with the GC lock held */
+static void BeginIncrementalReachabilityAnalysis(EObjectFlags KeepFlags)
+{
+	SCOPED_NAMED_EVENT(BeginIncrementalReachabilityAnalysis, FColor::Red);
+	LLM_SCOPE(ELLMTag::GC);
+
+	// We can't collect garbage while there's a load in progress. E.g. one potential issue is Import.XObject
+	check(!IsLoading());
+
+	FlushStreamingForGC();
+
+	// Route callbacks so we can ensure that we are e.g. not in the middle of loading something by flushing
+	// the async loading, etc...
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Broadcast();
+
+	FGCScopeLock GCLock;
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Objects can't be marked again before the previous purge has finished
+	if (GObjIncrementalPurgeIsInProgress || GObjPurgeIsRequired)
+	{
+		IncrementalPurgeGarbage(false);
+		FMemory::Trim();
+	}
+	check(!GObjIncrementalPurgeIsInProgress);
+	check(!GObjPurgeIsRequired);
+
+	GIncrementalReachabilityAnalysis.Begin(KeepFlags, PrepareClustersForGC());
+	UE_LOG(LogGarbage, Log, TEXT("%f ms for starting incremental reachability analysis"), (FPlatformTime::Seconds() - StartTime) * 1000);
+}
+#endif // UE_WITH_GC
+
 /** 
  * Deletes all unreferenced objects, keeping objects that have any of the passed in KeepFlags set
+ * Completes a pending incremental reachability analysis if it was started with the same KeepFlags
  *
  * @param	KeepFlags			objects with those flags will be kept regardless of being referenced or not
  * @param	bPerformFullPurge	if true, perform a full purge after the mark pass
+ * @param	bMinorCollection	if true, only objects created since the last garbage collection are considered
  */
-void CollectGarbageInternal(EObjectFlags KeepFlags, bool bPerformFullPurge)
+void CollectGarbageInternal(EObjectFlags KeepFlags, bool bPerformFullPurge, bool bMinorCollection = false)
 {
 #if !UE_WITH_GC
 	return;
@@ -1968,23 +2794,30 @@ void CollectGarbageInternal(EObjectFlags KeepFlags, bool bPerformFullPurge)
 	check(!IsLoading());
 
 	// Reset GC skip counter
-	GNumAttemptsSinceLastGC = 0;
+	if (!bMinorCollection)
+	{
+		GNumAttemptsSinceLastGC = 0;
+	}
+	check(!bMinorCollection || (GIsTrackingYoungObjects && !GIsIncrementalReachabilityPending));
 
-	// Flush streaming before GC if requested
-	if (GFlushStreamingOnGC)
+	// A pending incremental reachability analysis has already flushed streaming and routed the pre GC callbacks
+	const bool bFinishIncrementalReachability = GIsIncrementalReachabilityPending &&
+		KeepFlags == GIncrementalReachabilityAnalysis.GetKeepFlags() &&
+		GIncrementalReachabilityAnalysis.IsWithClusters() == (!!GCreateGCClusters && GUObjectClusters.GetNumAllocatedClusters());
+	if (GIsIncrementalReachabilityPending && !bFinishIncrementalReachability)
 	{
-		if (IsAsyncLoading())
-		{
-			UE_LOG(LogGarbage, Log, TEXT("CollectGarbageInternal() is flushing async loading"));
-		}
-		FGCCSyncObject::Get().GCUnlock();
-		FlushAsyncLoading();
-		FGCCSyncObject::Get().GCLock();
+		UE_LOG(LogGarbage, Log, TEXT("Restarting incremental reachability analysis with different settings as a full one"));
+		GIncrementalReachabilityAnalysis.Cancel();
 	}
 
-	// Route callbacks so we can ensure that we are e.g. not in the middle of loading something by flushing
-	// the async loading, etc...
-	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Broadcast();
+	if (!bFinishIncrementalReachability)
+	{
+		FlushStreamingForGC();
+
+		// Route callbacks so we can ensure that we are e.g. not in the middle of loading something by flushing
+		// the async loading, etc...
+		FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Broadcast();
+	}
 	GLastGCFrame = GFrameCounter;
 
 	{
@@ -1992,7 +2825,7 @@ void CollectGarbageInternal(EObjectFlags KeepFlags, bool bPerformFullPurge)
 		// This has to be unlocked before we call post GC callbacks
 		FGCScopeLock GCLock;
 
-		UE_LOG(LogGarbage, Log, TEXT("Collecting garbage%s"), IsAsyncLoading() ? TEXT(" while async loading") : TEXT(""));
+		UE_LOG(LogGarbage, Log, TEXT("Collecting %sgarbage%s"), bMinorCollection ? TEXT("young ") : TEXT(""), IsAsyncLoading() ? TEXT(" while async loading") : TEXT(""));
 
 		// Make sure previous incremental purge has finished or we do a full purge pass in case we haven't kicked one
 		// off yet since the last call to garbage collection.
@@ -2004,15 +2837,12 @@ void CollectGarbageInternal(EObjectFlags KeepFlags, bool bPerformFullPurge)
 		check(!GObjIncrementalPurgeIsInProgress);
 		check(!GObjPurgeIsRequired);
 
-		// This can happen if someone disables clusters from the console (gc.CreateGCClusters)
-		if (!GCreateGCClusters && GUObjectClusters.GetNumAllocatedClusters())
-		{
-			GUObjectClusters.DissolveClusters(true);
-		}
+		// Run with GC clustering code enabled only if clustering is enabled and there's actual allocated clusters
+		const bool bWithClusters = PrepareClustersForGC();
 
 #if VERIFY_DISREGARD_GC_ASSUMPTIONS
 		// Only verify assumptions if option is enabled. This avoids false positives in the Editor or commandlets.
-		if ((GUObjectArray.DisregardForGCEnabled() || GUObjectClusters.GetNumAllocatedClusters()) && GShouldVerifyGCAssumptions)
+		if ((GUObjectArray.DisregardForGCEnabled() || GUObjectClusters.GetNumAllocatedClusters()) && GShouldVerifyGCAssumptions && !bFinishIncrementalReachability && !bMinorCollection)
 		{
 			DECLARE_SCOPE_CYCLE_COUNTER(TEXT("CollectGarbageInternal.VerifyGCAssumptions"), STAT_CollectGarbageInternal_VerifyGCAssumptions, STATGROUP_GC);
 			const double StartTime = FPlatformTime::Seconds();
@@ -2026,10 +2856,27 @@ void CollectGarbageInternal(EObjectFlags KeepFlags, bool bPerformFullPurge)
 		// or detailed per class gc stats are enabled (not thread safe)
 		// Temporarily forcing single-threaded GC in the editor until Modify() can be safely removed from HandleObjectReference.
 		const bool bForceSingleThreadedGC = ShouldForceSingleThreadedGC();
-		// Run with GC clustering code enabled only if clustering is enabled and there's actual allocated clusters
-		const bool bWithClusters = !!GCreateGCClusters && GUObjectClusters.GetNumAllocatedClusters();
 
 		// Perform reachability analysis.
+		if (bFinishIncrementalReachability)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			GIncrementalReachabilityAnalysis.Finish();
+			UE_LOG(LogGarbage, Log, TEXT("%f ms for finishing incremental GC"), (FPlatformTime::Seconds() - StartTime) * 1000);
+		}
+		else if (bMinorCollection)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			GYoungReachabilityAnalysis.PerformYoungReachabilityAnalysis(KeepFlags, bForceSingleThreadedGC);
+			UE_LOG(LogGarbage, Log, TEXT("%f ms for minor GC"), (FPlatformTime::Seconds() - StartTime) * 1000);
+
+			if (GVerifyMinorCollections)
+			{
+				GYoungReachabilityAnalysis.Verify(KeepFlags, bForceSingleThreadedGC, bWithClusters);
+				bMinorCollection = false;
+			}
+		}
+		else
 		{
 			const double StartTime = FPlatformTime::Seconds();
 			FRealtimeGC TagUsedRealtimeGC;
@@ -2049,9 +2896,21 @@ void CollectGarbageInternal(EObjectFlags KeepFlags, bool bPerformFullPurge)
 		FCoreUObjectDelegates::PostReachabilityAnalysis.Broadcast();
 
 		{
-			GatherUnreachableObjects(bForceSingleThreadedGC);
+			if (bMinorCollection)
+			{
+				GYoungReachabilityAnalysis.GatherUnreachableYoungObjects();
+			}
+			else
+			{
+				GatherUnreachableObjects(bForceSingleThreadedGC);
+			}
 			NotifyUnreachableObjects(GUnreachableObjects);
 
+			// Everything that survived is old now, objects created from here on are young if minor collections are allowed
+			GYoungReachabilityAnalysis.Reset();
+			GUObjectArray.SetTrackYoungObjects(!!GAllowMinorCollections);
+			GIsTrackingYoungObjects = GUObjectArray.IsTrackingYoungObjects();
+
 			// This needs to happen after GatherUnreachableObjects since GatherUnreachableObjects can mark more (clustered) objects as unreachable
 			FGCArrayPool::Get().ClearWeakReferences(bPerformFullPurge);
 
@@ -2201,6 +3060,80 @@ bool TryCollectGarbage(EObjectFlags KeepFlags, bool bPerformFullPurge)
 	return bCanRunGC;
 }
 
+bool IncrementalCollectGarbage(EObjectFlags KeepFlags, float TimeLimit, bool bPerformFullPurge)
+{
+#if !UE_WITH_GC
+	return true;
+#else
+	if (GIsInitialLoad || (!GAllowIncrementalReachability && !GIsIncrementalReachabilityPending))
+	{
+		return TryCollectGarbage(KeepFlags, bPerformFullPurge);
+	}
+
+	// No other thread may be performing UObject operations while we're running
+	if (!FGCCSyncObject::Get().TryGCLock())
+	{
+		GNumAttemptsSinceLastGC++;
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	if (GIsIncrementalReachabilityPending && KeepFlags != GIncrementalReachabilityAnalysis.GetKeepFlags())
+	{
+		FGCScopeLock GCLock;
+		GIncrementalReachabilityAnalysis.Cancel();
+	}
+	if (!GIsIncrementalReachabilityPending)
+	{
+		BeginIncrementalReachabilityAnalysis(KeepFlags);
+	}
+
+	bool bFinished = false;
+	{
+		SCOPED_NAMED_EVENT(IncrementalReachabilityAnalysis, FColor::Red);
+		FGCScopeLock GCLock;
+		bFinished = GIncrementalReachabilityAnalysis.Tick(TimeLimit - float(FPlatformTime::Seconds() - StartTime));
+	}
+
+	if (bFinished)
+	{
+		// Everything left to do is bounded by the number of roots and objects created since the analysis started
+		CollectGarbageInternal(KeepFlags, bPerformFullPurge);
+	}
+
+	// Other threads are free to use UObjects
+	ReleaseGCLock();
+
+	return bFinished;
+#endif // UE_WITH_GC
+}
+
+bool TryCollectYoungGarbage(EObjectFlags KeepFlags, bool bPerformFullPurge)
+{
+#if !UE_WITH_GC
+	return false;
+#else
+	// Young objects are only tracked from the first garbage collection after minor collections have been allowed
+	if (GIsInitialLoad || !GAllowMinorCollections || !GIsTrackingYoungObjects || GIsIncrementalReachabilityPending)
+	{
+		return false;
+	}
+
+	// No other thread may be performing UObject operations while we're running
+	if (!FGCCSyncObject::Get().TryGCLock())
+	{
+		return false;
+	}
+
+	CollectGarbageInternal(KeepFlags, bPerformFullPurge, true);
+
+	// Other threads are free to use UObjects
+	ReleaseGCLock();
+
+	return true;
+#endif // UE_WITH_GC
+}
+
 void UObject::CallAddReferencedObjects(FReferenceCollector& Collector)
 {
 	GetClass()->CallAddReferencedObjects(this, Collector);
@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "UObject/LinkerLoad.h"
+#include "UObject/NameBatchSerialization.h"
 #include "HAL/FileManager.h"
 #include "Misc/Paths.h"
 #include "Stats/StatsMisc.h"
@@ -1538,19 +1539,63 @@ FLinkerLoad::ELinkerStatus FLinkerLoad::SerializeNameMap()
 	SCOPED_LOADTIMER(LinkerLoad_SerializeNameMap_ProcessingEntries);
 
 	NameMap.Reserve(NameCount);
+
+	// Read names into a batch and create them all at once, large name maps are hashed and inserted in parallel
+	TArray<WIDECHAR> BatchChars;
+	TArray<int32> BatchEnds;
+	TArray<FWideStringView> BatchStrings;
+	TArray<FNameEntryId> BatchIds;
+	auto CreateBatch = [&]()
+	{
+		int32 Begin = 0;
+		for (int32 End : BatchEnds)
+		{
+			BatchStrings.Emplace(BatchChars.GetData() + Begin, End - Begin);
+			Begin = End;
+		}
+
+		CreateNameBatch(BatchStrings, BatchIds);
+		NameMap.Append(BatchIds);
+
+		BatchChars.Reset();
+		BatchEnds.Reset();
+		BatchStrings.Reset();
+	};
+
 	FNameEntrySerialized NameEntry(ENAME_LinkerConstructor);
 	for (int32 Idx = NameMap.Num(); Idx < NameCount; ++Idx)
 	{
 		*this << NameEntry;
-		NameMap.Emplace(FName(NameEntry).GetDisplayIndex());
+		if (NameEntry.bIsWide)
+		{
+			BatchChars.Append(NameEntry.WideName, FCStringWide::Strlen(NameEntry.WideName));
+		}
+		else
+		{
+			for (const ANSICHAR* It = NameEntry.AnsiName; *It; ++It)
+			{
+				BatchChars.Add(static_cast<WIDECHAR>(*It));
+			}
+		}
+		BatchEnds.Add(BatchChars.Num());
 
 		constexpr int32 TimeSliceGranularity = 128;
+		constexpr int32 MaxBatchSize = 16384;
+		if (BatchEnds.Num() == MaxBatchSize)
+		{
+			CreateBatch();
+		}
+
 		if (Idx % TimeSliceGranularity == TimeSliceGranularity - 1 && 
-			NameMap.Num() != NameCount && IsTimeLimitExceeded(TEXT("serializing name map")))
+			Idx + 1 != NameCount && IsTimeLimitExceeded(TEXT("serializing name map")))
 		{
+			CreateBatch();
 			return LINKER_TimedOut;
 		}
 	}
+
+	CreateBatch();
+	check(NameMap.Num() == NameCount);
 	
 	return LINKER_Loaded;
 }
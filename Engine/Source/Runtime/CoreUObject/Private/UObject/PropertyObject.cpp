@@ -180,4 +180,5 @@ UObject* FObjectProperty::GetObjectPropertyValue(const void* PropertyValueAddres
 void FObjectProperty::SetObjectPropertyValue(void* PropertyValueAddress, UObject* Value) const
 {
 	SetPropertyValue(PropertyValueAddress, Value);
+	GCWriteBarrier(Value);
 }
@@ -82,6 +82,7 @@ FUObjectArray::FUObjectArray()
 , ObjLastNonGCIndex(INDEX_NONE)
 , MaxObjectsNotConsideredByGC(0)
 , OpenForDisregardForGC(!HACK_HEADER_GENERATOR)
+, bTrackYoungObjects(false)
 , MasterSerialNumber(START_SERIAL_NUMBER)
 {
 	GCoreObjectArrayForDebugVisualizers = &GUObjectArray.ObjObjects;
@@ -234,6 +235,11 @@ void FUObjectArray::AllocateUObjectIndex(UObjectBase* Object, bool bMergingThrea
 	ObjectItem->SetFlags(EInternalObjectFlags::PendingConstruction);
 	ObjectItem->Object = Object;		
 	Object->InternalIndex = Index;
+	if (bTrackYoungObjects && Index > ObjLastNonGCIndex)
+	{
+		ObjectItem->SetGCFlags(EGCObjectFlags::Young);
+		YoungObjectIndices.Add(Index);
+	}
 
 	UnlockInternalArray();
 
@@ -305,6 +311,35 @@ void FUObjectArray::FreeUObjectIndex(UObjectBase* Object)
 	}
 }
 
+void FUObjectArray::SetTrackYoungObjects(bool bTrack)
+{
+	if (!bTrack)
+	{
+		PromoteYoungObjects();
+	}
+	bTrackYoungObjects = bTrack;
+}
+
+void FUObjectArray::ExtractYoungObjectIndices(TArray<int32>& OutIndices)
+{
+	LockInternalArray();
+	OutIndices = MoveTemp(YoungObjectIndices);
+	YoungObjectIndices.Reset();
+	UnlockInternalArray();
+}
+
+void FUObjectArray::PromoteYoungObjects()
+{
+	LockInternalArray();
+	for (int32 Index : YoungObjectIndices)
+	{
+		// Objects destroyed since had their flags reset already
+		IndexToObject(Index)->ClearGCFlags(EGCObjectFlags::Young);
+	}
+	YoungObjectIndices.Reset();
+	UnlockInternalArray();
+}
+
 /**
  * Adds a creation listener
  *
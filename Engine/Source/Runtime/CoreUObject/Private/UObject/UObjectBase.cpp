@@ -216,6 +216,7 @@ void UObjectBase::LowLevelRename(FName NewName,UObject *NewOuter)
 	if (NewOuter)
 	{
 		OuterPrivate = NewOuter;
+		GCWriteBarrier(NewOuter);
 	}
 	HashObject(this);
 }
@@ -172,7 +172,7 @@ void FUObjectClusterContainer::DissolveCluster(FUObjectCluster& Cluster)
 	}
 }
 
-void FUObjectClusterContainer::DissolveClusterAndMarkObjectsAsUnreachable(FUObjectItem* RootObjectItem)
+void FUObjectClusterContainer::DissolveClusterAndMarkObjectsAsUnreachable(FUObjectItem* RootObjectItem, bool bMaybeUnreachable)
 {
 	const int32 OldClusterIndex = RootObjectItem->GetClusterIndex();
 	FUObjectCluster& Cluster = Clusters[OldClusterIndex];
@@ -189,8 +189,15 @@ void FUObjectClusterContainer::DissolveClusterAndMarkObjectsAsUnreachable(FUObje
 	{
 		FUObjectItem* ClusterObjectItem = GUObjectArray.IndexToObjectUnsafeForGC(ClusterObjectIndex);
 		ClusterObjectItem->SetOwnerIndex(0);
+		if (bMaybeUnreachable)
+		{
+			ClusterObjectItem->SetGCFlags(EGCObjectFlags::MaybeUnreachable);
+		}
+		else
+		{
 			ClusterObjectItem->SetFlags(EInternalObjectFlags::Unreachable);
 		}
+	}
 
 #if !UE_GCCLUSTER_VERBOSE_LOGGING
 	UObject* ClusterRootObject = static_cast<UObject*>(RootObjectItem->Object);
@@ -205,8 +212,15 @@ void FUObjectClusterContainer::DissolveClusterAndMarkObjectsAsUnreachable(FUObje
 		FUObjectItem* ReferencedByClusterRootItem = GUObjectArray.IndexToObjectUnsafeForGC(ReferencedByClusterRootIndex);
 		if (ReferencedByClusterRootItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot))
 		{
+			if (bMaybeUnreachable)
+			{
+				ReferencedByClusterRootItem->SetGCFlags(EGCObjectFlags::MaybeUnreachable);
+			}
+			else
+			{
 				ReferencedByClusterRootItem->SetFlags(EInternalObjectFlags::Unreachable);
-			DissolveClusterAndMarkObjectsAsUnreachable(ReferencedByClusterRootItem);
+			}
+			DissolveClusterAndMarkObjectsAsUnreachable(ReferencedByClusterRootItem, bMaybeUnreachable);
 		}
 	}
 }
@@ -711,6 +725,8 @@ public:
 					{
 						// If the object can't be in a cluster or is being loaded, adding to the mutable objects list (and we won't be processing it further)
 						Cluster.MutableObjects.AddUnique(GUObjectArray.ObjectToIndex(Object));
+						// Minor garbage collections don't trace clusters, remember young mutable objects instead
+						GCWriteBarrier(Object);
 					}
 				}
 			}
@@ -791,6 +807,7 @@ void UObjectBaseUtility::AddToCluster(UObjectBaseUtility* ClusterRootOrObjectFro
 			{
 				Cluster->MutableObjects.Add(ThisObjectIndex);
 			}
+			GCWriteBarrier(static_cast<UObject*>(this));
 		}
 	}
 }
@@ -472,6 +472,10 @@ class FGCCollector : public FReferenceCollector
 	{
 		return !!(Options & EFastReferenceCollectorOptions::WithClusters);
 	}
+	constexpr FORCEINLINE bool IsIncremental() const
+	{
+		return !!(Options & EFastReferenceCollectorOptions::Incremental);
+	}
 
 public:
 
@@ -495,6 +499,11 @@ public:
 	}
 	virtual bool MarkWeakObjectReferenceForClearing(UObject** WeakReference) override
 	{
+		// The referencing container may reallocate before an incremental analysis completes, keep these strong instead
+		if (IsIncremental())
+		{
+			return false;
+		}
 		// Track this references for later destruction if necessary. These should be relatively rare
 		ObjectArrayStruct.WeakReferences.Add(WeakReference);
 		return true;
@@ -20,6 +20,15 @@
 #define UE_GC_TRACK_OBJ_AVAILABLE (WITH_EDITOR)
 #endif
 
+/** Garbage collector bookkeeping kept in FUObjectItem::GCFlags, the EInternalObjectFlags bits are reserved */
+enum class EGCObjectFlags : int32
+{
+	None = 0,
+	MaybeUnreachable = 1 << 0, ///< Not reached yet by the incremental reachability analysis in progress
+	Young = 1 << 1, ///< Created since the last garbage collection, minor collections only consider these
+};
+ENUM_CLASS_FLAGS(EGCObjectFlags);
+
 /**
 * Single item in the UObject array.
 */
@@ -33,6 +42,8 @@ struct FUObjectItem
 	int32 ClusterRootIndex;	
 	// Weak Object Pointer Serial number associated with the object
 	int32 SerialNumber;
+	// Garbage collector flags (EGCObjectFlags), takes what is padding on 64 bit platforms
+	int32 GCFlags;
 
 #if STATS || ENABLE_STATNAMEDEVENTS_UOBJECT
 	/** Stat id of this object, 0 if nobody asked for it yet */
@@ -48,6 +59,7 @@ struct FUObjectItem
 		, Flags(0)
 		, ClusterRootIndex(0)
 		, SerialNumber(0)
+		, GCFlags(0)
 #if ENABLE_STATNAMEDEVENTS_UOBJECT
 		, StatIDStringStorage(nullptr)
 #endif
@@ -164,6 +176,48 @@ struct FUObjectItem
 		return !!(Flags & int32(InFlags));
 	}
 
+	FORCEINLINE void SetGCFlags(EGCObjectFlags FlagsToSet)
+	{
+		while (1)
+		{
+			int32 StartValue = GCFlags;
+			if ((StartValue & int32(FlagsToSet)) == int32(FlagsToSet) || FPlatformAtomics::InterlockedCompareExchange(&GCFlags, StartValue | int32(FlagsToSet), StartValue) == StartValue)
+			{
+				break;
+			}
+		}
+	}
+
+	FORCEINLINE void ClearGCFlags(EGCObjectFlags FlagsToClear)
+	{
+		ThisThreadAtomicallyClearedGCFlag(FlagsToClear);
+	}
+
+	/**
+	 * Uses atomics to clear the specified GC flag(s).
+	 * @return True if this call cleared the flag, false if it has been cleared by another thread.
+	 */
+	FORCEINLINE bool ThisThreadAtomicallyClearedGCFlag(EGCObjectFlags FlagToClear)
+	{
+		while (1)
+		{
+			int32 StartValue = GCFlags;
+			if (!(StartValue & int32(FlagToClear)))
+			{
+				return false;
+			}
+			if (FPlatformAtomics::InterlockedCompareExchange(&GCFlags, StartValue & ~int32(FlagToClear), StartValue) == StartValue)
+			{
+				return true;
+			}
+		}
+	}
+
+	FORCEINLINE bool HasAnyGCFlags(EGCObjectFlags InFlags) const
+	{
+		return !!(GCFlags & int32(InFlags));
+	}
+
 	FORCEINLINE void SetUnreachable()
 	{
 		ThisThreadAtomicallySetFlag(EInternalObjectFlags::Unreachable);
@@ -212,6 +266,7 @@ struct FUObjectItem
 		Flags = 0;
 		ClusterRootIndex = 0;
 		SerialNumber = 0;
+		GCFlags = 0;
 	}
 
 #if STATS || ENABLE_STATNAMEDEVENTS_UOBJECT
@@ -786,6 +841,28 @@ public:
 		return ObjFirstGCIndex;
 	}
 
+	/**
+	 * Starts or stops adding new objects to the young generation minor garbage collections are limited to.
+	 * Stopping promotes every young object. Called by the garbage collector with the GC lock held.
+	 */
+	void SetTrackYoungObjects(bool bTrack);
+
+	/** Whether new objects are added to the young generation */
+	FORCEINLINE bool IsTrackingYoungObjects() const
+	{
+		return bTrackYoungObjects;
+	}
+
+	/**
+	 * INTERNAL USE ONLY: takes the indices of all objects added to the young generation since it was last emptied.
+	 * Indices of objects destroyed since are stale and indices reused since are repeated, only items that still have
+	 * EGCObjectFlags::Young are young objects.
+	 */
+	void ExtractYoungObjectIndices(TArray<int32>& OutIndices);
+
+	/** Promotes every young object to the old generation. Called by the garbage collector with the GC lock held */
+	void PromoteYoungObjects();
+
 	/**
 	 * Adds a new listener for object creation
 	 *
@@ -1075,6 +1152,10 @@ private:
 	mutable FCriticalSection ObjObjectsCritical;
 	/** Available object indices.											*/
 	TArray<int32> ObjAvailableList;
+	/** If true new objects are added to the young generation.							*/
+	bool bTrackYoungObjects;
+	/** Indices of objects added to the young generation, guarded by ObjObjectsCritical.	*/
+	TArray<int32> YoungObjectIndices;
 #if UE_GC_TRACK_OBJ_AVAILABLE
 	/** Available object index count.										*/
 	FThreadSafeCounter ObjAvailableCount;
@@ -1180,8 +1261,8 @@ public:
 	 */
 	void DissolveClusters(bool bForceDissolveAllClusters = false);
 
-	/** Dissolve the specified cluster and all clusters that reference it */
-	void DissolveClusterAndMarkObjectsAsUnreachable(FUObjectItem* RootObjectItem);
+	/** Dissolve the specified cluster and all clusters that reference it, their objects are marked MaybeUnreachable for incremental reachability analysis */
+	void DissolveClusterAndMarkObjectsAsUnreachable(FUObjectItem* RootObjectItem, bool bMaybeUnreachable = false);
 
 	/*** Returns the minimum cluster size as specified in ini settings */
 	int32 GetMinClusterSize() const;
@@ -495,6 +495,89 @@ COREUOBJECT_API void CollectGarbage(EObjectFlags KeepFlags, bool bPerformFullPur
 */
 COREUOBJECT_API bool TryCollectGarbage(EObjectFlags KeepFlags, bool bPerformFullPurge = true);
 
+/**
+ * Performs garbage collection with reachability analysis spread over several calls if gc.AllowIncrementalReachability
+ * is enabled, otherwise same as TryCollectGarbage. Call it again every frame until it returns true.
+ *
+ * @param	KeepFlags			objects with those flags will be kept regardless of being referenced or not
+ * @param	TimeLimit			soft time limit for reachability analysis in this call
+ * @param	bPerformFullPurge	if true, perform a full purge after the mark pass
+ *
+ * @return true if garbage has been collected, false if reachability analysis is still in progress or GC is locked
+ */
+COREUOBJECT_API bool IncrementalCollectGarbage(EObjectFlags KeepFlags, float TimeLimit, bool bPerformFullPurge = false);
+
+/**
+ * Returns whether an incremental reachability analysis started by IncrementalCollectGarbage is in progress.
+ */
+COREUOBJECT_API bool IsIncrementalReachabilityAnalysisPending();
+
+/** Whether an incremental reachability analysis is in progress, use GCWriteBarrier rather than checking it directly */
+extern COREUOBJECT_API bool GIsIncrementalReachabilityPending;
+
+/** Marks an object reachable for the incremental reachability analysis in progress, use GCWriteBarrier */
+COREUOBJECT_API void MarkAsReachableForIncrementalGC(UObject* Object);
+
+/**
+ * Performs a minor garbage collection if gc.AllowMinorCollections is enabled: only objects created since the last
+ * garbage collection are considered and references are only followed between them.
+ *
+ * @param	KeepFlags			objects with those flags will be kept regardless of being referenced or not
+ * @param	bPerformFullPurge	if true, perform a full purge after the mark pass
+ *
+ * @return true if garbage has been collected, false if minor collections are disabled, waiting for a full garbage
+ *         collection to start tracking new objects, an incremental reachability analysis is in progress or GC is locked
+ */
+COREUOBJECT_API bool TryCollectYoungGarbage(EObjectFlags KeepFlags, bool bPerformFullPurge = false);
+
+/** Whether objects created now are tracked for minor garbage collections, use GCWriteBarrier rather than checking it directly */
+extern COREUOBJECT_API bool GIsTrackingYoungObjects;
+
+/** Keeps a young object for the next minor garbage collection, use GCWriteBarrier */
+COREUOBJECT_API void RememberYoungObjectForGC(UObject* Object);
+
+/** Traces Referencer in the next minor garbage collection if Object is young, use GCWriteBarrier */
+COREUOBJECT_API void RememberReferencerForGC(UObject* Referencer, UObject* Object);
+
+/**
+ * Write barrier for incremental reachability analysis and minor garbage collections. Native code that writes a UObject
+ * reference the garbage collector traces (UPROPERTY or AddReferencedObjects) must pass the new value, or it may be
+ * destroyed while still referenced. Writes through reflection and Blueprints already do.
+ */
+FORCEINLINE void GCWriteBarrier(UObject* Value)
+{
+	if (Value)
+	{
+		if (GIsIncrementalReachabilityPending)
+		{
+			MarkAsReachableForIncrementalGC(Value);
+		}
+		if (GIsTrackingYoungObjects)
+		{
+			RememberYoungObjectForGC(Value);
+		}
+	}
+}
+
+/**
+ * Write barrier for a reference held by Referencer. Minor garbage collections trace Referencer again rather than keep
+ * Value alive until the next one, so prefer this one when the referencer is known.
+ */
+FORCEINLINE void GCWriteBarrier(UObject* Referencer, UObject* Value)
+{
+	if (Value)
+	{
+		if (GIsIncrementalReachabilityPending)
+		{
+			MarkAsReachableForIncrementalGC(Value);
+		}
+		if (GIsTrackingYoungObjects)
+		{
+			RememberReferencerForGC(Referencer, Value);
+		}
+	}
+}
+
 /**
 * Calls ConditionalBeginDestroy on unreachable objects
 *
@@ -1604,6 +1604,9 @@ private:
 	/** Time in seconds (game time so we respect time dilation) since the last time we purged references to pending kill objects */
 	float TimeSinceLastPendingKillPurge;
 
+	/** Time in seconds (game time) since the last minor garbage collection of young objects */
+	float TimeSinceLastMinorCollection;
+
 	/** Whether a full purge has been triggered, so that the next GarbageCollect will do a full purge no matter what. */
 	bool bFullPurgeTriggered;
 
@@ -738,6 +738,7 @@ void AActor::PostLoad()
 	{
 		checkSlow(!Owner->Children.Contains(this));
 		Owner->Children.Add(this);
+		GCWriteBarrier(Owner, this);
 	}
 
 	if (GetLinkerUE4Version() < VER_UE4_PRIVATE_REMOTE_ROLE)
@@ -1676,6 +1677,7 @@ void AActor::SetOwner(AActor* NewOwner)
 		}
 
 		Owner = NewOwner;
+		GCWriteBarrier(this, NewOwner);
 		MARK_PROPERTY_DIRTY_FROM_NAME(AActor, Owner, this);
 
 		if (Owner != nullptr)
@@ -1683,6 +1685,7 @@ void AActor::SetOwner(AActor* NewOwner)
 			// add to new owner's Children array
 			checkSlow(!Owner->Children.Contains(this));
 			Owner->Children.Add(this);
+			GCWriteBarrier(Owner, this);
 		}
 
 		// mark all components for which Owner is relevant for visibility to be updated
@@ -2798,6 +2801,7 @@ void AActor::AddOwnedComponent(UActorComponent* Component)
 
 	bool bAlreadyInSet = false;
 	OwnedComponents.Add(Component, &bAlreadyInSet);
+	GCWriteBarrier(this, Component);
 
 	if (!bAlreadyInSet)
 	{
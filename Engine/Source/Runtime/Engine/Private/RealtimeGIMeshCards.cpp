@@ -0,0 +1,241 @@
+#include "RealtimeGIMeshCards.h"
+#include "StaticMeshResources.h"
+
+// surfaces along capture direction are split into two cards if the empty gap between them is larger than this (relative to mesh size)
+#define MIN_CARD_SPLIT_GAP (0.05f)
+
+// clusters whose area is smaller than this (relative to total area) don't get a card
+#define MIN_CARD_AREA (0.002f)
+
+// same order and direction as CalcCardCaptureViewRotationMatrix in renderer
+static const FVector CardCaptureDirections[CubeFace_MAX] =
+{
+	FVector(1, 0, 0),	// CubeFace_PosX
+	FVector(-1, 0, 0),	// CubeFace_NegX
+	FVector(0, 1, 0),	// CubeFace_PosY
+	FVector(0, -1, 0),	// CubeFace_NegY
+	FVector(0, 0, 1),	// CubeFace_PosZ
+	FVector(0, 0, -1),	// CubeFace_NegZ
+};
+
+struct FCardTriangle
+{
+	FBox Bounds;
+	float Area;
+};
+
+struct FCardCluster
+{
+	uint8 Face = 0;
+	float Area = 0;
+	FBox Bounds = FBox(ForceInit);
+	TArray<int32> Triangles;
+
+	// split candidate: triangles [0, SplitIndex) and [SplitIndex, Num) after sort by depth
+	int32 SplitIndex = INDEX_NONE;
+	float SplitScore = 0;
+};
+
+static float GetDepth(const FVector& Position, uint8 Face)
+{
+	return FVector::DotProduct(Position, CardCaptureDirections[Face]);
+}
+
+static void UpdateClusterBounds(FCardCluster& Cluster, const TArray<FCardTriangle>& Triangles)
+{
+	Cluster.Area = 0;
+	Cluster.Bounds = FBox(ForceInit);
+	for (int32 TriangleIndex : Cluster.Triangles)
+	{
+		Cluster.Area += Triangles[TriangleIndex].Area;
+		Cluster.Bounds += Triangles[TriangleIndex].Bounds;
+	}
+}
+
+// find the largest empty gap along capture direction, surfaces behind the gap are hidden from the card
+static void FindClusterSplit(FCardCluster& Cluster, const TArray<FCardTriangle>& Triangles, float MinGap)
+{
+	Cluster.SplitIndex = INDEX_NONE;
+	Cluster.SplitScore = 0;
+
+	// near to far from card's view
+	const uint8 Face = Cluster.Face;
+	Cluster.Triangles.Sort([&Triangles, Face](int32 A, int32 B)
+	{
+		return FMath::Min(GetDepth(Triangles[A].Bounds.Min, Face), GetDepth(Triangles[A].Bounds.Max, Face)) <
+			FMath::Min(GetDepth(Triangles[B].Bounds.Min, Face), GetDepth(Triangles[B].Bounds.Max, Face));
+	});
+
+	float FrontArea = 0;
+	float FarthestDepth = -MAX_flt;
+	for (int32 i = 0; i < Cluster.Triangles.Num() - 1; i++)
+	{
+		const FCardTriangle& Triangle = Triangles[Cluster.Triangles[i]];
+		const FCardTriangle& Next = Triangles[Cluster.Triangles[i + 1]];
+		FrontArea += Triangle.Area;
+		FarthestDepth = FMath::Max(FarthestDepth, FMath::Max(GetDepth(Triangle.Bounds.Min, Face), GetDepth(Triangle.Bounds.Max, Face)));
+
+		const float NextDepth = FMath::Min(GetDepth(Next.Bounds.Min, Face), GetDepth(Next.Bounds.Max, Face));
+		const float Gap = NextDepth - FarthestDepth;
+		if (Gap < MinGap)
+		{
+			continue;
+		}
+
+		// prefer big gap which separate large surfaces on both side
+		const float Score = Gap * FMath::Min(FrontArea, Cluster.Area - FrontArea);
+		if (Score > Cluster.SplitScore)
+		{
+			Cluster.SplitScore = Score;
+			Cluster.SplitIndex = i + 1;
+		}
+	}
+}
+
+void FRealtimeGIMeshCardsData::Build(const FStaticMeshLODResources& LODModel, const FBox& MeshBounds, int32 MaxNumCards)
+{
+	const FPositionVertexBuffer& PositionBuffer = LODModel.VertexBuffers.PositionVertexBuffer;
+	TArray<FVector> Positions;
+	Positions.SetNumUninitialized(PositionBuffer.GetNumVertices());
+	for (uint32 VertexIndex = 0; VertexIndex < PositionBuffer.GetNumVertices(); VertexIndex++)
+	{
+		Positions[VertexIndex] = PositionBuffer.VertexPosition(VertexIndex);
+	}
+
+	TArray<uint32> Indices;
+	const FIndexArrayView IndexBuffer = LODModel.IndexBuffer.GetArrayView();
+	for (const FStaticMeshSection& Section : LODModel.Sections)
+	{
+		for (uint32 Index = Section.FirstIndex; Index < Section.FirstIndex + Section.NumTriangles * 3; Index++)
+		{
+			Indices.Add(IndexBuffer[Index]);
+		}
+	}
+
+	Build(Positions, Indices, MeshBounds, MaxNumCards);
+}
+
+void FRealtimeGIMeshCardsData::Build(const TArray<FVector>& Positions, const TArray<uint32>& Indices, const FBox& MeshBounds, int32 MaxNumCards)
+{
+	Cards.Empty();
+
+	MaxNumCards = FMath::Min(MaxNumCards, REALTIMEGI_MAX_MESH_CARDS);
+	if (!MeshBounds.IsValid || MaxNumCards < CubeFace_MAX)
+	{
+		return;
+	}
+
+	// 1. assign each triangle to the card direction which see it most front-facing
+	TArray<FCardTriangle> Triangles;
+	FCardCluster Clusters[CubeFace_MAX];
+	float TotalArea = 0;
+
+	for (int32 TriangleIndex = 0; TriangleIndex < Indices.Num() / 3; TriangleIndex++)
+	{
+		const FVector P0 = Positions[Indices[TriangleIndex * 3 + 0]];
+		const FVector P1 = Positions[Indices[TriangleIndex * 3 + 1]];
+		const FVector P2 = Positions[Indices[TriangleIndex * 3 + 2]];
+
+		// same winding as mesh import, see FbxStaticMeshImport
+		const FVector Cross = (P1 - P2) ^ (P0 - P2);
+		const float Area = Cross.Size() * 0.5f;
+		if (Area < SMALL_NUMBER)
+		{
+			continue;
+		}
+
+		const FVector Normal = Cross.GetUnsafeNormal();
+		uint8 BestFace = 0;
+		float BestDot = -MAX_flt;
+		for (uint8 Face = 0; Face < CubeFace_MAX; Face++)
+		{
+			const float Dot = -FVector::DotProduct(Normal, CardCaptureDirections[Face]);
+			if (Dot > BestDot)
+			{
+				BestDot = Dot;
+				BestFace = Face;
+			}
+		}
+
+		FCardTriangle Triangle;
+		Triangle.Bounds = FBox(ForceInit);
+		Triangle.Bounds += P0;
+		Triangle.Bounds += P1;
+		Triangle.Bounds += P2;
+		Triangle.Area = Area;
+
+		Clusters[BestFace].Triangles.Add(Triangles.Add(Triangle));
+		TotalArea += Area;
+	}
+
+	if (Triangles.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FCardCluster> CardClusters;
+	for (uint8 Face = 0; Face < CubeFace_MAX; Face++)
+	{
+		Clusters[Face].Face = Face;
+		UpdateClusterBounds(Clusters[Face], Triangles);
+		if (Clusters[Face].Area >= TotalArea * MIN_CARD_AREA)
+		{
+			CardClusters.Add(MoveTemp(Clusters[Face]));
+		}
+	}
+
+	// 2. spend the remaining cards on clusters with interior surfaces hidden behind a gap
+	const FVector MeshSize = MeshBounds.GetSize();
+	for (FCardCluster& Cluster : CardClusters)
+	{
+		const float MinGap = FMath::Abs(FVector::DotProduct(MeshSize, CardCaptureDirections[Cluster.Face])) * MIN_CARD_SPLIT_GAP;
+		FindClusterSplit(Cluster, Triangles, MinGap);
+	}
+
+	while (CardClusters.Num() < MaxNumCards)
+	{
+		int32 BestCluster = INDEX_NONE;
+		for (int32 ClusterIndex = 0; ClusterIndex < CardClusters.Num(); ClusterIndex++)
+		{
+			const FCardCluster& Cluster = CardClusters[ClusterIndex];
+			if (Cluster.SplitIndex != INDEX_NONE && (BestCluster == INDEX_NONE || Cluster.SplitScore > CardClusters[BestCluster].SplitScore))
+			{
+				BestCluster = ClusterIndex;
+			}
+		}
+
+		if (BestCluster == INDEX_NONE)
+		{
+			break;
+		}
+
+		FCardCluster BackCluster;
+		BackCluster.Face = CardClusters[BestCluster].Face;
+		BackCluster.Triangles.Append(CardClusters[BestCluster].Triangles.GetData() + CardClusters[BestCluster].SplitIndex, CardClusters[BestCluster].Triangles.Num() - CardClusters[BestCluster].SplitIndex);
+		CardClusters[BestCluster].Triangles.SetNum(CardClusters[BestCluster].SplitIndex);
+
+		const float MinGap = FMath::Abs(FVector::DotProduct(MeshSize, CardCaptureDirections[BackCluster.Face])) * MIN_CARD_SPLIT_GAP;
+		UpdateClusterBounds(BackCluster, Triangles);
+		FindClusterSplit(BackCluster, Triangles, MinGap);
+		UpdateClusterBounds(CardClusters[BestCluster], Triangles);
+		FindClusterSplit(CardClusters[BestCluster], Triangles, MinGap);
+
+		CardClusters.Add(MoveTemp(BackCluster));
+	}
+
+	// 3. card cover the cluster with a little padding, but never go out of mesh bounds
+	const FVector Padding = MeshSize * 0.01f;
+	for (const FCardCluster& Cluster : CardClusters)
+	{
+		const FBox CardBox = FBox(
+			FVector::Max(Cluster.Bounds.Min - Padding, MeshBounds.Min),
+			FVector::Min(Cluster.Bounds.Max + Padding, MeshBounds.Max)
+		);
+
+		FRealtimeGIMeshCard Card;
+		Card.Center = CardBox.GetCenter();
+		Card.Size = CardBox.GetSize();
+		Card.Face = Cluster.Face;
+		Cards.Add(Card);
+	}
+}
@@ -94,6 +94,38 @@ static FAutoConsoleVariableRef CVarShaderCompilerMaxJobCacheMemoryPercent(
 	ECVF_Default
 );
 
+int32 GShaderCompilerJobCacheDisk = 0;
+static FAutoConsoleVariableRef CVarShaderCompilerJobCacheDisk(
+	TEXT("r.ShaderCompiler.JobCacheDisk"),
+	GShaderCompilerJobCacheDisk,
+	TEXT("if != 0, outputs of the shader compiler jobs will also be stored on disk and reused by later editor and cook sessions. Disabled by default. Read when the first jobs are submitted."),
+	ECVF_Default
+);
+
+FString GShaderCompilerJobCacheDiskPath;
+static FAutoConsoleVariableRef CVarShaderCompilerJobCacheDiskPath(
+	TEXT("r.ShaderCompiler.JobCacheDiskPath"),
+	GShaderCompilerJobCacheDiskPath,
+	TEXT("Directory of the on-disk shader compiler job cache, can be shared by several processes. If empty, Saved/ShaderJobCache of the project is used."),
+	ECVF_Default
+);
+
+int32 GShaderCompilerMaxJobCacheDiskSizeMB = 4 * 1024;
+static FAutoConsoleVariableRef CVarShaderCompilerMaxJobCacheDiskSizeMB(
+	TEXT("r.ShaderCompiler.MaxJobCacheDiskSizeMB"),
+	GShaderCompilerMaxJobCacheDiskSizeMB,
+	TEXT("if != 0, the least recently used entries of the on-disk shader compiler job cache will be deleted when it grows past this many megabytes (4GB by default). If 0, the size will be unlimited."),
+	ECVF_Default
+);
+
+int32 GShaderCompilerJobCacheDDC = 0;
+static FAutoConsoleVariableRef CVarShaderCompilerJobCacheDDC(
+	TEXT("r.ShaderCompiler.JobCacheDDC"),
+	GShaderCompilerJobCacheDDC,
+	TEXT("if != 0, outputs of the shader compiler jobs will also be stored in the derived data cache, so that they can be shared between machines. Disabled by default."),
+	ECVF_Default
+);
+
 int32 GShaderCompilerDumpCompileJobInputs = 0;
 static FAutoConsoleVariableRef CVarShaderCompilerDumpCompileJobInputs(
 	TEXT("r.ShaderCompiler.DumpCompileJobInputs"),
@@ -415,10 +447,47 @@ void FShaderCompileJobCollection::SubmitJobs(const TArray<FShaderCommonCompileJo
 				ParallelFor(InJobs.Num(), [&InJobs](int32 Index) { InJobs[Index]->GetInputHash(); });
 			}
 
+			// Load the jobs that are neither cached in memory nor in flight from the persistent cache, without holding the lock while reading files
+			TArray<TArray<uint8>> PersistentOutputs;
+			TArray<bool> PersistentOutputsFromDDC;
+			if (ShaderCompiler::IsJobCacheEnabled() && IsInGameThread())
+			{
+				PersistentJobsCache.Initialize();
+			}
+			if (ShaderCompiler::IsJobCacheEnabled() && PersistentJobsCache.IsEnabled())
+			{
+				TArray<int32> JobsToLoad;
+				{
+					FReadScopeLock Locker(Lock);
+					for (int32 JobIndex = 0; JobIndex < InJobs.Num(); ++JobIndex)
+					{
+						const FSHAHash& InputHash = InJobs[JobIndex]->GetInputHash();
+						if (!CompletedJobsCache.Contains(InputHash) && !JobsInFlight.Contains(InputHash))
+						{
+							JobsToLoad.Add(JobIndex);
+						}
+					}
+				}
+
+				PersistentOutputs.SetNum(InJobs.Num());
+				PersistentOutputsFromDDC.SetNumZeroed(InJobs.Num());
+				ParallelFor(JobsToLoad.Num(), [this, &InJobs, &JobsToLoad, &PersistentOutputs, &PersistentOutputsFromDDC](int32 Index)
+				{
+					const int32 JobIndex = JobsToLoad[Index];
+					PersistentJobsCache.Find(InJobs[JobIndex]->GetInputHash(), PersistentOutputs[JobIndex], &PersistentOutputsFromDDC[JobIndex]);
+				});
+			}
+
+			uint32 NumQueries = 0;
+			uint32 NumMemoryHits = 0;
+			uint32 NumDiskHits = 0;
+			uint32 NumDDCHits = 0;
+
 			FWriteScopeLock Locker(Lock);
 
-			for (FShaderCommonCompileJob* Job : InJobs)
+			for (int32 JobIndex = 0; JobIndex < InJobs.Num(); ++JobIndex)
 			{
+				FShaderCommonCompileJob* Job = InJobs[JobIndex];
 				check(Job->JobIndex != INDEX_NONE);
 				check(Job->Priority != EShaderCompileJobPriority::None);
 				check(Job->PendingPriority == EShaderCompileJobPriority::None);
@@ -429,6 +498,8 @@ void FShaderCompileJobCollection::SubmitJobs(const TArray<FShaderCommonCompileJo
 				{
 					const FSHAHash& InputHash = Job->GetInputHash();
 
+					++NumQueries;
+
 					// see if we can find the job in the cache first
 					if (TArray<uint8>* ExistingOutput = CompletedJobsCache.Find(InputHash))
 					{
@@ -438,6 +509,29 @@ void FShaderCompileJobCollection::SubmitJobs(const TArray<FShaderCommonCompileJo
 
 						// finish the job instantly
 						ProcessFinishedJob(Job, true);
+						++NumMemoryHits;
+
+						continue;
+					}
+					// then in what was loaded from the persistent cache
+					else if (PersistentOutputs.Num() && PersistentOutputs[JobIndex].Num())
+					{
+						UE_LOG(LogShaderCompilers, UE_SHADERCACHE_LOG_LEVEL, TEXT("Job with the ihash %s was compiled by an earlier session, processing it immediately."), *InputHash.ToString());
+						FMemoryReader MemReader(PersistentOutputs[JobIndex]);
+						Job->SerializeOutput(MemReader);
+
+						// keep it in memory too, duplicates of this job will likely follow
+						CompletedJobsCache.Add(InputHash, PersistentOutputs[JobIndex], 1);
+
+						ProcessFinishedJob(Job, true);
+						if (PersistentOutputsFromDDC[JobIndex])
+						{
+							++NumDDCHits;
+						}
+						else
+						{
+							++NumDiskHits;
+						}
 
 						continue;
 					}
@@ -477,6 +571,11 @@ void FShaderCompileJobCollection::SubmitJobs(const TArray<FShaderCommonCompileJo
 					++SubmittedJobsCount;
 				}
 			}
+
+			if (GShaderCompilerStats && NumQueries > 0)
+			{
+				GShaderCompilerStats->RegisterJobCacheQueries(NumQueries, NumMemoryHits, NumDiskHits, NumDDCHits);
+			}
 		}
 
 		UE_LOG(LogShaderCompilers, UE_SHADERCACHE_LOG_LEVEL, TEXT("Actual jobs submitted %d (of %d new), total outstanding jobs: %d."), SubmittedJobsCount, InJobs.Num(), NumOutstandingJobs.GetValue());
@@ -529,6 +628,12 @@ void FShaderCompileJobCollection::AddToCacheAndProcessPending(FShaderCommonCompi
 	FMemoryWriter Writer(Output);
 	FinishedJob->SerializeOutput(Writer);
 
+	// persist outside of the lock, so that writing the file doesn't hold up submitting and finishing other jobs
+	if (FinishedJob->bSucceeded && PersistentJobsCache.IsEnabled())
+	{
+		PersistentJobsCache.Add(InputHash, Output);
+	}
+
 	// TODO: reduce the scope - e.g. SerializeOutput and processing finished jobs can be moved out of it
 	FWriteScopeLock JobLocker(Lock);
 
@@ -581,6 +686,10 @@ void FShaderCompileJobCollection::LogCachingStats(bool bForceLogIgnoringTimeInve
 
 	FWriteScopeLock Locker(Lock);	// write lock because logging actually changes the cache state (in a minor way - updating the memory used - but still).
 	CompletedJobsCache.LogStats();
+	if (PersistentJobsCache.IsEnabled())
+	{
+		PersistentJobsCache.LogStats();
+	}
 	LastTimeStatsPrinted = FPlatformTime::Seconds();
 }
 
@@ -2362,6 +2471,14 @@ FShaderCompilerStats* GShaderCompilerStats = NULL;
 
 void FShaderCompilerStats::WriteStats()
 {
+	{
+		const FJobCacheStats CacheStats = GetJobCacheStats();
+		const uint64 NumHits = CacheStats.MemoryHits + CacheStats.DiskHits + CacheStats.DDCHits;
+		UE_LOG(LogShaderCompilers, Display, TEXT("Shader job cache: %llu jobs submitted, %llu hits in memory, %llu on disk, %llu in the DDC (%.2f%%), %llu compiled or deduplicated."),
+			CacheStats.Queries, CacheStats.MemoryHits, CacheStats.DiskHits, CacheStats.DDCHits,
+			CacheStats.Queries > 0 ? 100.0 * static_cast<double>(NumHits) / static_cast<double>(CacheStats.Queries) : 0.0, CacheStats.Queries - NumHits);
+	}
+
 #if ALLOW_DEBUG_FILES
 	{
 		FlushRenderingCommands(true);
@@ -2519,6 +2636,21 @@ void FShaderCompilerStats::RegisterCookedShaders(uint32 NumCooked, float Compile
 	}
 }
 
+void FShaderCompilerStats::RegisterJobCacheQueries(uint32 NumQueries, uint32 NumMemoryHits, uint32 NumDiskHits, uint32 NumDDCHits)
+{
+	FScopeLock Lock(&CompileStatsLock);
+	JobCacheStats.Queries += NumQueries;
+	JobCacheStats.MemoryHits += NumMemoryHits;
+	JobCacheStats.DiskHits += NumDiskHits;
+	JobCacheStats.DDCHits += NumDDCHits;
+}
+
+FShaderCompilerStats::FJobCacheStats FShaderCompilerStats::GetJobCacheStats()
+{
+	FScopeLock Lock(&CompileStatsLock);
+	return JobCacheStats;
+}
+
 void FShaderCompilerStats::RegisterCompiledShaders(uint32 NumCompiled, EShaderPlatform Platform, const FString MaterialPath, FString PermutationString)
 {
 	FScopeLock Lock(&CompileStatsLock);
@@ -6509,4 +6641,295 @@ void FShaderJobCache::LogStats()
 	UE_LOG(LogShaderCompilers, Display, TEXT("================================================"));
 }
 
+namespace ShaderJobDiskCache
+{
+	/** Identifies an entry file, change it when the layout below changes */
+	static const uint32 EntryMagic = 0x314A5353;	// "SSJ1"
+
+	/** Magic, input hash and CRC of the output, followed by the output */
+	static const int32 EntryHeaderSize = sizeof(uint32) + sizeof(FSHAHash::Hash) + sizeof(uint32);
+
+	static void WriteEntry(const FSHAHash& InputHash, const TArray<uint8>& Output, TArray<uint8>& OutEntry)
+	{
+		uint32 Magic = EntryMagic;
+		uint32 Crc = FCrc::MemCrc32(Output.GetData(), Output.Num());
+
+		OutEntry.Reset(EntryHeaderSize + Output.Num());
+		OutEntry.Append(reinterpret_cast<const uint8*>(&Magic), sizeof(Magic));
+		OutEntry.Append(InputHash.Hash, sizeof(InputHash.Hash));
+		OutEntry.Append(reinterpret_cast<const uint8*>(&Crc), sizeof(Crc));
+		OutEntry.Append(Output);
+	}
+
+	/** Returns false for truncated or corrupted entries, and entries of another input hash */
+	static bool ReadEntry(const FSHAHash& InputHash, const TArray<uint8>& Entry, TArray<uint8>& OutOutput)
+	{
+		if (Entry.Num() <= EntryHeaderSize)
+		{
+			return false;
+		}
+
+		uint32 Magic;
+		uint32 Crc;
+		FMemory::Memcpy(&Magic, Entry.GetData(), sizeof(Magic));
+		FMemory::Memcpy(&Crc, Entry.GetData() + EntryHeaderSize - sizeof(Crc), sizeof(Crc));
+		const uint8* Output = Entry.GetData() + EntryHeaderSize;
+		const int32 OutputSize = Entry.Num() - EntryHeaderSize;
+
+		if (Magic != EntryMagic ||
+			FMemory::Memcmp(Entry.GetData() + sizeof(Magic), InputHash.Hash, sizeof(InputHash.Hash)) != 0 ||
+			FCrc::MemCrc32(Output, OutputSize) != Crc)
+		{
+			return false;
+		}
+
+		OutOutput.Reset(OutputSize);
+		OutOutput.Append(Output, OutputSize);
+		return true;
+	}
+}
+
+void FShaderJobDiskCache::Initialize()
+{
+	if (bInitialized)
+	{
+		return;
+	}
+	check(IsInGameThread());
+	bInitialized = true;
+
+	bUseDisk = GShaderCompilerJobCacheDisk != 0;
+	bUseDDC = GShaderCompilerJobCacheDDC != 0;
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	// The input hash doesn't cover the compilers themselves, so outputs are keyed by the shader format versions as well
+	TMap<FString, uint32> FormatVersionMap = GetFormatVersionMap();
+	FormatVersionMap.KeySort(TLess<FString>());
+	FString VersionString = FString::Printf(TEXT("%s_%s_%d_%d"), GLOBALSHADERMAP_DERIVEDDATA_VER, MATERIALSHADERMAP_DERIVEDDATA_VER, ShaderCompileWorkerInputVersion, ShaderCompileWorkerOutputVersion);
+	for (const TPair<FString, uint32>& FormatVersion : FormatVersionMap)
+	{
+		VersionString += FString::Printf(TEXT("_%s_%u"), *FormatVersion.Key, FormatVersion.Value);
+	}
+	FSHAHash VersionHash;
+	FSHA1::HashBuffer(*VersionString, VersionString.Len() * sizeof(TCHAR), VersionHash.Hash);
+	VersionKey = VersionHash.ToString();
+
+	if (bUseDisk)
+	{
+		RootDirectory = FPaths::ConvertRelativePathToFull(GShaderCompilerJobCacheDiskPath.IsEmpty() ? FPaths::ProjectSavedDir() / TEXT("ShaderJobCache") : GShaderCompilerJobCacheDiskPath);
+		MaxDiskSize = static_cast<int64>(FMath::Max(GShaderCompilerMaxJobCacheDiskSizeMB, 0)) * 1024LL * 1024LL;
+
+		if (IFileManager::Get().MakeDirectory(*RootDirectory, true))
+		{
+			// measures the directory, and gets it below budget if another process left it bigger
+			Trim();
+		}
+		else
+		{
+			UE_LOG(LogShaderCompilers, Warning, TEXT("Unable to create the shader job cache directory '%s', the cache will not be stored on disk."), *RootDirectory);
+			bUseDisk = false;
+		}
+	}
+
+	UE_LOG(LogShaderCompilers, Display, TEXT("Shader job cache persisted %s%s%s, version %s."),
+		bUseDisk ? TEXT("in ") : TEXT(""), bUseDisk ? *RootDirectory : TEXT(""), bUseDDC ? (bUseDisk ? TEXT(" and the DDC") : TEXT("in the DDC")) : TEXT(""), *VersionKey);
+}
+
+FString FShaderJobDiskCache::GetEntryFilename(const FJobInputHash& Hash) const
+{
+	// spread the entries over 256 directories, so that none of them gets too big
+	const FString HashString = Hash.ToString();
+	return RootDirectory / VersionKey / HashString.Left(2) / HashString + TEXT(".sjc");
+}
+
+FString FShaderJobDiskCache::GetDDCKey(const FJobInputHash& Hash) const
+{
+	return FDerivedDataCacheInterface::BuildCacheKey(TEXT("SHADERJOB"), *VersionKey, *Hash.ToString());
+}
+
+bool FShaderJobDiskCache::Find(const FJobInputHash& Hash, FJobCachedOutput& OutContents, bool* bOutFromDDC)
+{
+	++TotalSearchAttempts;
+
+	if (bUseDisk)
+	{
+		const FString Filename = GetEntryFilename(Hash);
+		TArray<uint8> Entry;
+		if (FFileHelper::LoadFileToArray(Entry, *Filename, FILEREAD_Silent))
+		{
+			if (ShaderJobDiskCache::ReadEntry(Hash, Entry, OutContents))
+			{
+				// the modification time orders the entries for trimming
+				IFileManager::Get().SetTimeStamp(*Filename, FDateTime::UtcNow());
+				++TotalDiskHits;
+				TotalBytesRead += Entry.Num();
+				return true;
+			}
+
+			UE_LOG(LogShaderCompilers, Warning, TEXT("Shader job cache entry '%s' is corrupt, deleting it."), *Filename);
+			IFileManager::Get().Delete(*Filename, false, false, true);
+			++TotalCorruptEntries;
+		}
+	}
+
+	if (bUseDDC && GetDerivedDataCacheRef().GetSynchronous(*GetDDCKey(Hash), OutContents, TEXT("ShaderJobCache"_SV)))
+	{
+		++TotalDDCHits;
+		TotalBytesRead += OutContents.Num();
+		if (bUseDisk)
+		{
+			WriteEntry(Hash, OutContents);
+		}
+		if (bOutFromDDC)
+		{
+			*bOutFromDDC = true;
+		}
+		return true;
+	}
+
+	OutContents.Reset();
+	return false;
+}
+
+void FShaderJobDiskCache::Add(const FJobInputHash& Hash, const FJobCachedOutput& Contents)
+{
+	// the estimate only counts this process's writes since the last measure, see EstimatedDiskSize
+	if (bUseDisk && WriteEntry(Hash, Contents) && MaxDiskSize > 0 && EstimatedDiskSize.Load() > MaxDiskSize)
+	{
+		Trim();
+	}
+
+	if (bUseDDC)
+	{
+		GetDerivedDataCacheRef().Put(*GetDDCKey(Hash), Contents, TEXT("ShaderJobCache"_SV));
+	}
+}
+
+bool FShaderJobDiskCache::WriteEntry(const FJobInputHash& Hash, const FJobCachedOutput& Contents)
+{
+	const FString Filename = GetEntryFilename(Hash);
+
+	// another process, or a cloned job, already stored it
+	if (IFileManager::Get().FileExists(*Filename))
+	{
+		return false;
+	}
+
+	TArray<uint8> Entry;
+	ShaderJobDiskCache::WriteEntry(Hash, Contents, Entry);
+
+	// other processes must never read a partially written entry, so it is written under a unique name and then renamed
+	const FString TempFilename = FPaths::GetPath(Filename) / TEXT("temp.") + FGuid::NewGuid().ToString();
+	bool bWritten = FFileHelper::SaveArrayToFile(Entry, *TempFilename, &IFileManager::Get(), FILEWRITE_Silent) &&
+		IFileManager::Get().Move(*Filename, *TempFilename, false, false, false, true);
+	if (!bWritten)
+	{
+		// most likely another process won the race to store the same output
+		IFileManager::Get().Delete(*TempFilename, false, false, true);
+		return false;
+	}
+
+	++TotalWrites;
+	TotalBytesWritten += Entry.Num();
+	EstimatedDiskSize += Entry.Num();
+	return true;
+}
+
+void FShaderJobDiskCache::Trim()
+{
+	// another thread is already trimming
+	if (!bUseDisk || !TrimCS.TryLock())
+	{
+		return;
+	}
+
+	struct FEntry
+	{
+		FString Filename;
+		FDateTime LastUsed;
+		int64 Size;
+		bool bCurrentVersion;
+	};
+
+	const double StartTime = FPlatformTime::Seconds();
+	const FString CurrentVersionDirectory = RootDirectory / VersionKey / TEXT("");
+	TArray<FEntry> Entries;
+	int64 TotalSize = 0;
+	IFileManager::Get().IterateDirectoryStatRecursively(*RootDirectory, [&Entries, &TotalSize, &CurrentVersionDirectory](const TCHAR* Filename, const FFileStatData& StatData)
+	{
+		if (!StatData.bIsDirectory)
+		{
+			Entries.Add({ Filename, StatData.ModificationTime, StatData.FileSize, FCString::Strnicmp(Filename, *CurrentVersionDirectory, CurrentVersionDirectory.Len()) == 0 });
+			TotalSize += StatData.FileSize;
+		}
+		return true;
+	});
+
+	if (MaxDiskSize > 0 && TotalSize > MaxDiskSize)
+	{
+		// go 10% below the budget, so that the next trim is a while away. Entries of older compiler versions are never used, so they go first.
+		const int64 TargetSize = MaxDiskSize - MaxDiskSize / 10;
+		Entries.Sort([](const FEntry& A, const FEntry& B)
+		{
+			if (A.bCurrentVersion != B.bCurrentVersion)
+			{
+				return !A.bCurrentVersion;
+			}
+			return A.LastUsed < B.LastUsed;
+		});
+
+		uint64 NumDeleted = 0;
+		for (const FEntry& Entry : Entries)
+		{
+			if (TotalSize <= TargetSize)
+			{
+				break;
+			}
+
+			// entries that another process has open can't be deleted on some platforms, they are being used anyway
+			if (IFileManager::Get().Delete(*Entry.Filename, false, false, true))
+			{
+				TotalSize -= Entry.Size;
+				++NumDeleted;
+			}
+		}
+		TotalTrimmedEntries += NumDeleted;
+
+		UE_LOG(LogShaderCompilers, Display, TEXT("Trimmed the shader job cache in '%s' by %llu entries to %.2f MB, took %.2fs."),
+			*RootDirectory, NumDeleted, FUnitConversion::Convert(static_cast<double>(TotalSize), EUnit::Bytes, EUnit::Megabytes), FPlatformTime::Seconds() - StartTime);
+	}
+
+	EstimatedDiskSize = TotalSize;
+	TrimCS.Unlock();
+}
+
+/** Logs out the statistics */
+void FShaderJobDiskCache::LogStats()
+{
+	const uint64 NumHits = TotalDiskHits.Load() + TotalDDCHits.Load();
+	UE_LOG(LogShaderCompilers, Display, TEXT("=== FShaderJobDiskCache stats ==="));
+	UE_LOG(LogShaderCompilers, Display, TEXT("Total job queries %llu, among them disk hits %llu and DDC hits %llu (%.2f%%)"),
+		TotalSearchAttempts.Load(), TotalDiskHits.Load(), TotalDDCHits.Load(), (TotalSearchAttempts.Load() > 0) ? 100.0 * static_cast<double>(NumHits) / static_cast<double>(TotalSearchAttempts.Load()) : 0.0);
+	UE_LOG(LogShaderCompilers, Display, TEXT("Read %.2f MB, wrote %llu entries with %.2f MB, trimmed %llu entries, deleted %llu corrupt entries"),
+		FUnitConversion::Convert(static_cast<double>(TotalBytesRead.Load()), EUnit::Bytes, EUnit::Megabytes), TotalWrites.Load(),
+		FUnitConversion::Convert(static_cast<double>(TotalBytesWritten.Load()), EUnit::Bytes, EUnit::Megabytes), TotalTrimmedEntries.Load(), TotalCorruptEntries.Load());
+	if (bUseDisk)
+	{
+		const double DiskUsedMB = FUnitConversion::Convert(static_cast<double>(EstimatedDiskSize.Load()), EUnit::Bytes, EUnit::Megabytes);
+		if (MaxDiskSize > 0)
+		{
+			UE_LOG(LogShaderCompilers, Display, TEXT("Disk used: %.2f MB of %.2f MB budget in '%s'"),
+				DiskUsedMB, FUnitConversion::Convert(static_cast<double>(MaxDiskSize), EUnit::Bytes, EUnit::Megabytes), *RootDirectory);
+		}
+		else
+		{
+			UE_LOG(LogShaderCompilers, Display, TEXT("Disk used: %.2f MB in '%s', no size limit set"), DiskUsedMB, *RootDirectory);
+		}
+	}
+	UE_LOG(LogShaderCompilers, Display, TEXT("================================================"));
+}
+
 #undef LOCTEXT_NAMESPACE
@@ -1618,6 +1618,11 @@ void FStaticMeshRenderData::Serialize(FArchive& Ar, UStaticMesh* Owner, bool bCo
 	Ar << Bounds;
 	Ar << bLODsShareStaticLighting;
 
+	if (!Ar.IsLoading() || Ar.CustomVer(FRenderingObjectVersion::GUID) >= FRenderingObjectVersion::RealtimeGIMeshCards)
+	{
+		Ar << RealtimeGIMeshCards;
+	}
+
 	if (Ar.IsLoading() && Ar.CustomVer(FRenderingObjectVersion::GUID) < FRenderingObjectVersion::TextureStreamingMeshUVChannelData)
 	{
 		float DummyFactor;
@@ -2300,7 +2305,7 @@ static void SerializeBuildSettingsForDDC(FArchive& Ar, FMeshBuildSettings& Build
 // differences, etc.) replace the version GUID below with a new one.
 // In case of merge conflicts with DDC versions, you MUST generate a new GUID
 // and set this new GUID as the version.
-#define STATICMESH_DERIVEDDATA_VER TEXT("9CE2B6FB46754B699726C4AA1515F12E")
+#define STATICMESH_DERIVEDDATA_VER TEXT("138C68C1C2534CFD9AFF32F4BCA2ABD3")
 
 static const FString& GetStaticMeshDerivedDataVersion()
 {
@@ -2639,6 +2644,10 @@ void FStaticMeshRenderData::Cache(const ITargetPlatform* TargetPlatform, UStatic
 			}
 
 			ComputeUVDensities();
+			if (LODResources.Num() > 0)
+			{
+				RealtimeGIMeshCards.Build(LODResources[0], Bounds.GetBox());
+			}
 			if(Owner->bSupportUniformlyDistributedSampling)
 			{
 				BuildAreaWeighedSamplingData();
@@ -2961,6 +2970,8 @@ void FStaticMeshRenderData::GetResourceSizeEx(FResourceSizeEx& CumulativeResourc
 		}
 	}
 
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(RealtimeGIMeshCards.GetResourceSizeBytes());
+
 #if WITH_EDITORONLY_DATA
 	// If render data for multiple platforms is loaded, count it all.
 	if (NextCachedRenderData)
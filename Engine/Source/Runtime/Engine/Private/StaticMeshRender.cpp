@@ -1946,6 +1946,11 @@ void FStaticMeshSceneProxy::GetDistancefieldAtlasData(FBox& LocalVolumeBounds, F
 	}
 }
 
+const FRealtimeGIMeshCardsData* FStaticMeshSceneProxy::GetRealtimeGIMeshCards() const
+{
+	return RenderData && RenderData->RealtimeGIMeshCards.Cards.Num() > 0 ? &RenderData->RealtimeGIMeshCards : nullptr;
+}
+
 void FStaticMeshSceneProxy::GetDistanceFieldInstanceInfo(int32& NumInstances, float& BoundsSurfaceArea) const
 {
 	NumInstances = DistanceFieldData ? 1 : 0;
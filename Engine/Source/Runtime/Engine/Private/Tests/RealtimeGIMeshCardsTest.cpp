@@ -0,0 +1,134 @@
+#include "CoreMinimal.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Misc/AutomationTest.h"
+#include "RHIDefinitions.h"
+#include "RealtimeGIMeshCards.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RealtimeGIMeshCardsTest
+{
+	struct FTestMesh
+	{
+		TArray<FVector> Positions;
+		TArray<uint32> Indices;
+		FBox Bounds = FBox(ForceInit);
+
+		void AddQuad(const FVector& Origin, const FVector& U, const FVector& V, const FVector& Normal)
+		{
+			const uint32 Base = Positions.Num();
+			Positions.Add(Origin);
+			Positions.Add(Origin + U);
+			Positions.Add(Origin + U + V);
+			Positions.Add(Origin + V);
+			Bounds += Origin;
+			Bounds += Origin + U + V;
+
+			// flip winding to match the wanted normal
+			const bool bFlip = (((Positions[Base + 1] - Positions[Base + 2]) ^ (Positions[Base + 0] - Positions[Base + 2])) | Normal) < 0;
+			const uint32 Quad[6] = { 0, 1, 2, 0, 2, 3 };
+			for (int32 i = 0; i < 6; i += 3)
+			{
+				Indices.Add(Base + Quad[i]);
+				Indices.Add(Base + (bFlip ? Quad[i + 2] : Quad[i + 1]));
+				Indices.Add(Base + (bFlip ? Quad[i + 1] : Quad[i + 2]));
+			}
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRealtimeGIMeshCardsTest, "System.Engine.RealtimeGI.MeshCards", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRealtimeGIMeshCardsTest::RunTest(const FString& Parameters)
+{
+	using namespace RealtimeGIMeshCardsTest;
+
+	const FVector X(100, 0, 0);
+	const FVector Y(0, 100, 0);
+	const FVector Z(0, 0, 100);
+
+	// a plane facing up only need one card looking down
+	{
+		FTestMesh Mesh;
+		Mesh.AddQuad(FVector::ZeroVector, X, Y, FVector(0, 0, 1));
+
+		FRealtimeGIMeshCardsData Data;
+		Data.Build(Mesh.Positions, Mesh.Indices, Mesh.Bounds);
+		TestEqual(TEXT("Plane num cards"), Data.Cards.Num(), 1);
+		if (Data.Cards.Num() == 1)
+		{
+			TestEqual(TEXT("Plane card face"), (int32)Data.Cards[0].Face, (int32)CubeFace_NegZ);
+			TestTrue(TEXT("Plane card is thin"), Data.Cards[0].Size.Z < 1.0f);
+		}
+	}
+
+	// closed box get one card per side
+	{
+		FTestMesh Mesh;
+		Mesh.AddQuad(FVector::ZeroVector, Y, Z, FVector(-1, 0, 0));
+		Mesh.AddQuad(X, Y, Z, FVector(1, 0, 0));
+		Mesh.AddQuad(FVector::ZeroVector, X, Z, FVector(0, -1, 0));
+		Mesh.AddQuad(Y, X, Z, FVector(0, 1, 0));
+		Mesh.AddQuad(FVector::ZeroVector, X, Y, FVector(0, 0, -1));
+		Mesh.AddQuad(Z, X, Y, FVector(0, 0, 1));
+
+		FRealtimeGIMeshCardsData Data;
+		Data.Build(Mesh.Positions, Mesh.Indices, Mesh.Bounds);
+		TestEqual(TEXT("Box num cards"), Data.Cards.Num(), (int32)CubeFace_MAX);
+
+		uint32 FaceMask = 0;
+		for (const FRealtimeGIMeshCard& Card : Data.Cards)
+		{
+			FaceMask |= 1u << Card.Face;
+		}
+		TestEqual(TEXT("Box cover all faces"), FaceMask, (1u << CubeFace_MAX) - 1);
+	}
+
+	// interior wall hidden behind the front wall get its own card
+	{
+		FTestMesh Mesh;
+		Mesh.AddQuad(FVector::ZeroVector, Y, Z, FVector(-1, 0, 0));
+		Mesh.AddQuad(X, Y, Z, FVector(-1, 0, 0));
+
+		FRealtimeGIMeshCardsData Data;
+		Data.Build(Mesh.Positions, Mesh.Indices, Mesh.Bounds);
+		TestEqual(TEXT("Two walls num cards"), Data.Cards.Num(), 2);
+		for (const FRealtimeGIMeshCard& Card : Data.Cards)
+		{
+			TestEqual(TEXT("Two walls card face"), (int32)Card.Face, (int32)CubeFace_PosX);
+			TestTrue(TEXT("Two walls card fit one wall"), Card.Size.X < 10.0f);
+		}
+	}
+
+	// never exceed card budget
+	{
+		FTestMesh Mesh;
+		for (int32 i = 0; i < 16; i++)
+		{
+			Mesh.AddQuad(X * i, Y, Z, FVector(-1, 0, 0));
+		}
+
+		FRealtimeGIMeshCardsData Data;
+		Data.Build(Mesh.Positions, Mesh.Indices, Mesh.Bounds);
+		TestEqual(TEXT("Many walls use all cards"), Data.Cards.Num(), REALTIMEGI_MAX_MESH_CARDS);
+
+		// derived data round trip
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		Writer << Data;
+
+		FRealtimeGIMeshCardsData Loaded;
+		FMemoryReader Reader(Bytes);
+		Reader << Loaded;
+		TestEqual(TEXT("Serialize num cards"), Loaded.Cards.Num(), Data.Cards.Num());
+		for (int32 i = 0; i < FMath::Min(Loaded.Cards.Num(), Data.Cards.Num()); i++)
+		{
+			TestTrue(TEXT("Serialize card"), Loaded.Cards[i].Center == Data.Cards[i].Center && Loaded.Cards[i].Size == Data.Cards[i].Size && Loaded.Cards[i].Face == Data.Cards[i].Face);
+		}
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -1309,6 +1309,14 @@ static FAutoConsoleVariableRef CVarIncrementalGCTimePerFrame(
 	ECVF_Default
 );
 
+static float GTimeBetweenMinorCollections = 5.0f;
+static FAutoConsoleVariableRef CVarTimeBetweenMinorCollections(
+	TEXT("gc.TimeBetweenMinorCollections"),
+	GTimeBetweenMinorCollections,
+	TEXT("Time in seconds (game time) between minor garbage collections of young objects, when gc.AllowMinorCollections is enabled"),
+	ECVF_Default
+);
+
 void UEngine::PreGarbageCollect()
 {
 	ForEachObjectOfClass(UWorld::StaticClass(), [](UObject* WorldObj)
@@ -1427,6 +1435,7 @@ void UEngine::ConditionalCollectGarbage()
 				if (bHasAWorldBegunPlay)
 				{
 					TimeSinceLastPendingKillPurge += FApp::GetDeltaTime();
+					TimeSinceLastMinorCollection += FApp::GetDeltaTime();
 
 					const float TimeBetweenPurgingPendingKillObjects = GetTimeBetweenGarbageCollectionPasses();
 
@@ -1435,6 +1444,12 @@ void UEngine::ConditionalCollectGarbage()
 					{
 						bShouldDelayGarbageCollect = false;
 					}
+					// Continue incremental reachability analysis if one is in progress.
+					else if (IsIncrementalReachabilityAnalysisPending())
+					{
+						SCOPE_CYCLE_COUNTER(STAT_GCMarkTime);
+						PerformGarbageCollectionAndCleanupActors();
+					}
 					// Perform incremental purge update if it's pending or in progress.
 					else if (!IsIncrementalPurgePending()
 						// Purge reference to pending kill objects every now and so often.
@@ -1443,6 +1458,14 @@ void UEngine::ConditionalCollectGarbage()
 						SCOPE_CYCLE_COUNTER(STAT_GCMarkTime);
 						PerformGarbageCollectionAndCleanupActors();
 					}
+					// Collect objects that died young in between.
+					else if (!IsIncrementalPurgePending() && GTimeBetweenMinorCollections > 0.f && TimeSinceLastMinorCollection > GTimeBetweenMinorCollections && !IsAsyncLoading())
+					{
+						SCOPE_CYCLE_COUNTER(STAT_GCMarkTime);
+						// Does nothing unless gc.AllowMinorCollections is enabled, try again next time either way
+						TryCollectYoungGarbage(GARBAGE_COLLECTION_KEEPFLAGS, false);
+						TimeSinceLastMinorCollection = 0.0f;
+					}
 					else
 					{
 						SCOPE_CYCLE_COUNTER(STAT_GCSweepTime);
@@ -1478,8 +1501,8 @@ void UEngine::PerformGarbageCollectionAndCleanupActors()
 	// to block on loading the remaining data.
 	if (!IsAsyncLoading())
 	{
-		// Perform housekeeping.
-		if (TryCollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, false))
+		// Perform housekeeping. Reachability analysis shares the incremental purge time budget when gc.AllowIncrementalReachability is enabled.
+		if (IncrementalCollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, GIncrementalGCTimePerFrame, false))
 		{
 			ForEachObjectOfClass(UWorld::StaticClass(), [](UObject* World)
 			{
@@ -1488,6 +1511,7 @@ void UEngine::PerformGarbageCollectionAndCleanupActors()
 
 			// Reset counter.
 			TimeSinceLastPendingKillPurge = 0.0f;
+			TimeSinceLastMinorCollection = 0.0f;
 			bFullPurgeTriggered = false;
 			LastGCFrame = GFrameCounter;
 		}
@@ -576,6 +576,9 @@ public:
 
 	inline bool IsVisibleInRealtimeGI() const { return bVisibleInRealtimeGI; }
 
+	/** Precomputed surface cache card placement, nullptr if the primitive has none. */
+	virtual const class FRealtimeGIMeshCardsData* GetRealtimeGIMeshCards() const { return nullptr; }
+
 #if WITH_EDITOR
 	inline int32 GetNumUncachedStaticLightingInteractions() { return NumUncachedStaticLightingInteractions; }
 
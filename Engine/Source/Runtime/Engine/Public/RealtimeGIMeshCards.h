@@ -0,0 +1,48 @@
+// Mesh card placement for realtime GI surface cache, built offline with static mesh derived data.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FStaticMeshLODResources;
+
+// must not exceed MAX_CARDS_PER_MESH of renderer
+#define REALTIMEGI_MAX_MESH_CARDS (12)
+
+/** A card capture a cluster of surfaces facing the same direction, like a depth map of the cluster. */
+struct FRealtimeGIMeshCard
+{
+	/** Box in mesh local space covering the surface cluster. */
+	FVector Center = FVector::ZeroVector;
+	FVector Size = FVector::ZeroVector;
+
+	/** ECubeFace of the capture direction, the card see surfaces whose normal is opposite to it. */
+	uint8 Face = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FRealtimeGIMeshCard& Card)
+	{
+		Ar << Card.Center;
+		Ar << Card.Size;
+		Ar << Card.Face;
+		return Ar;
+	}
+};
+
+/** Precomputed mesh cards of a static mesh, empty means renderer fall back to six cards over local bounds. */
+class ENGINE_API FRealtimeGIMeshCardsData
+{
+public:
+	TArray<FRealtimeGIMeshCard> Cards;
+
+	/** Fit up to MaxNumCards cards to surface clusters of the LOD. */
+	void Build(const FStaticMeshLODResources& LODModel, const FBox& MeshBounds, int32 MaxNumCards = REALTIMEGI_MAX_MESH_CARDS);
+	void Build(const TArray<FVector>& Positions, const TArray<uint32>& Indices, const FBox& MeshBounds, int32 MaxNumCards = REALTIMEGI_MAX_MESH_CARDS);
+
+	SIZE_T GetResourceSizeBytes() const { return Cards.GetAllocatedSize(); }
+
+	friend FArchive& operator<<(FArchive& Ar, FRealtimeGIMeshCardsData& Data)
+	{
+		Ar << Data.Cards;
+		return Ar;
+	}
+};
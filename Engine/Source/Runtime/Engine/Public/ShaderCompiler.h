@@ -316,6 +316,12 @@ public:
 	/** Looks for the job in the cache, returns null if not found */
 	FJobCachedOutput* Find(const FJobInputHash& Hash);
 
+	/** Whether the job is in the cache, without counting it as a search attempt */
+	bool Contains(const FJobInputHash& Hash) const
+	{
+		return InputHashToOutput.Contains(Hash);
+	}
+
 	/** Adds a job output to the cache */
 	void Add(const FJobInputHash& Hash, const FJobCachedOutput& Contents, int InitialHitCount);
 
@@ -358,6 +364,78 @@ private:
 	uint64 CurrentlyAllocatedMemory = 0;
 };
 
+/**
+ * Persistent tier behind FShaderJobCache, so that jobs compiled by an earlier editor or cook session are not compiled again.
+ * Outputs are stored one file per input hash under r.ShaderCompiler.JobCacheDiskPath and/or in the DDC. Several processes can
+ * share the same directory: entries are written to a temporary file and renamed, and the least recently used ones are deleted
+ * when the directory grows past r.ShaderCompiler.MaxJobCacheDiskSizeMB.
+ */
+class FShaderJobDiskCache
+{
+public:
+	using FJobInputHash = FShaderJobCache::FJobInputHash;
+	using FJobCachedOutput = FShaderJobCache::FJobCachedOutput;
+
+	/** Reads the settings and measures the directory. Needs to be called on the game thread before the first Find() or Add(). */
+	void Initialize();
+
+	/** Whether either the disk or the DDC tier is used */
+	bool IsEnabled() const
+	{
+		return bUseDisk || bUseDDC;
+	}
+
+	/** Loads the job output from disk, then from the DDC, returns false if not found. Thread safe. */
+	bool Find(const FJobInputHash& Hash, FJobCachedOutput& OutContents, bool* bOutFromDDC = nullptr);
+
+	/** Stores the job output on disk and in the DDC. Thread safe. */
+	void Add(const FJobInputHash& Hash, const FJobCachedOutput& Contents);
+
+	/** Deletes the least recently used entries until the directory is below its budget */
+	void Trim();
+
+	/** Logs out the statistics */
+	void LogStats();
+
+private:
+	FString GetEntryFilename(const FJobInputHash& Hash) const;
+	FString GetDDCKey(const FJobInputHash& Hash) const;
+	bool WriteEntry(const FJobInputHash& Hash, const FJobCachedOutput& Contents);
+
+	bool bInitialized = false;
+	bool bUseDisk = false;
+	bool bUseDDC = false;
+
+	/** Root of the cache, entries of all compiler versions are trimmed together */
+	FString RootDirectory;
+
+	/** Hash of the shader format and DDC versions, outputs of other versions are never returned */
+	FString VersionKey;
+
+	/** Budget in bytes, 0 if unlimited */
+	int64 MaxDiskSize = 0;
+
+	/**
+	 * Size of the directory when it was last measured plus what this process wrote since.
+	 * Writes of other processes are only seen by the next measure, so concurrent cookers sharing the directory
+	 * can each fill the remaining budget before one of them trims, and the directory overshoots until then.
+	 */
+	TAtomic<int64> EstimatedDiskSize{ 0 };
+
+	/** Only one thread trims at a time, the others keep writing */
+	FCriticalSection TrimCS;
+
+	/** Statistics */
+	TAtomic<uint64> TotalSearchAttempts{ 0 };
+	TAtomic<uint64> TotalDiskHits{ 0 };
+	TAtomic<uint64> TotalDDCHits{ 0 };
+	TAtomic<uint64> TotalWrites{ 0 };
+	TAtomic<uint64> TotalBytesRead{ 0 };
+	TAtomic<uint64> TotalBytesWritten{ 0 };
+	TAtomic<uint64> TotalTrimmedEntries{ 0 };
+	TAtomic<uint64> TotalCorruptEntries{ 0 };
+};
+
 
 class FShaderCompileJobCollection
 {
@@ -498,6 +576,9 @@ private:
 	/** Cache for the completed jobs.*/
 	FShaderJobCache CompletedJobsCache;
 
+	/** Persistent cache for the completed jobs, looked up when CompletedJobsCache misses. */
+	FShaderJobDiskCache PersistentJobsCache;
+
 	/** Debugging - console command to print stats. */
 	class IConsoleObject* LogJobsCacheStatsCmd;
 };
@@ -881,9 +962,22 @@ public:
 	ENGINE_API const TSparseArray<ShaderCompilerStats>& GetShaderCompilerStats() { return CompileStats; }
 	ENGINE_API void WriteStats();
 
+	/** Results of looking up submitted jobs in the job caches, whatever was not a hit got compiled or waited for an identical job */
+	struct FJobCacheStats
+	{
+		uint64 Queries = 0;
+		uint64 MemoryHits = 0;
+		uint64 DiskHits = 0;
+		uint64 DDCHits = 0;
+	};
+
+	ENGINE_API void RegisterJobCacheQueries(uint32 NumQueries, uint32 NumMemoryHits, uint32 NumDiskHits, uint32 NumDDCHits);
+	ENGINE_API FJobCacheStats GetJobCacheStats();
+
 private:
 	FCriticalSection CompileStatsLock;
 	TSparseArray<ShaderCompilerStats> CompileStats;
+	FJobCacheStats JobCacheStats;
 };
 
 
@@ -34,6 +34,7 @@
 #include "Templates/UniquePtr.h"
 #include "WeightedRandomSampler.h"
 #include "PerPlatformProperties.h"
+#include "RealtimeGIMeshCards.h"
 
 class FDistanceFieldVolumeData;
 class UBodySetup;
@@ -611,6 +612,9 @@ public:
 	/** Bounds of the renderable mesh. */
 	FBoxSphereBounds Bounds;
 
+	/** Card placement for realtime GI surface cache, built from LOD 0. */
+	FRealtimeGIMeshCardsData RealtimeGIMeshCards;
+
 	bool IsInitialized() const
 	{
 		return bIsInitialized;
@@ -945,6 +949,7 @@ public:
 	virtual void GetDistanceFieldInstanceInfo(int32& NumInstances, float& BoundsSurfaceArea) const override;
 	virtual bool HasDistanceFieldRepresentation() const override;
 	virtual bool HasDynamicIndirectShadowCasterRepresentation() const override;
+	virtual const FRealtimeGIMeshCardsData* GetRealtimeGIMeshCards() const override;
 	virtual uint32 GetMemoryFootprint( void ) const override { return( sizeof( *this ) + GetAllocatedSize() ); }
 	uint32 GetAllocatedSize( void ) const { return( FPrimitiveSceneProxy::GetAllocatedSize() + LODs.GetAllocatedSize() ); }
 
@@ -1826,6 +1826,15 @@ void FDeferredShadingSceneRenderer::Render(FRHICommandListImmediate& RHICmdList)
 	}
 	// End early Shadow depth rendering
 
+	// RealtimeGI radiance cache on async compute only need shadow depths, kick it off right after them to overlap the base pass
+	bool bRealtimeGIRadianceCacheUpdated = false;
+	if (RealtimeGIEnable() && RealtimeGIUseAsyncCompute() && bCanOverlayRayTracingOutput && bOcclusionBeforeBasePass)
+	{
+		RealtimeGISceneUpdate(GraphBuilder, Scene, Views);
+		RealtimeGIVoxelLighting(GraphBuilder, *this, Scene, Views);
+		bRealtimeGIRadianceCacheUpdated = true;
+	}
+
 	const bool bShouldRenderSkyAtmosphere = ShouldRenderSkyAtmosphere(Scene, ViewFamily.EngineShowFlags);
 	const bool bShouldRenderVolumetricCloudBase = ShouldRenderVolumetricCloud(Scene, ViewFamily.EngineShowFlags);
 	const bool bShouldRenderVolumetricCloud = bShouldRenderVolumetricCloudBase && !ViewFamily.EngineShowFlags.VisualizeVolumetricCloudConservativeDensity;
@@ -2043,6 +2052,13 @@ void FDeferredShadingSceneRenderer::Render(FRHICommandListImmediate& RHICmdList)
 			RenderShadowDepthMaps(InRHICmdList);
 		});
 
+		if (RealtimeGIEnable() && RealtimeGIUseAsyncCompute())
+		{
+			RealtimeGISceneUpdate(GraphBuilder, Scene, Views);
+			RealtimeGIVoxelLighting(GraphBuilder, *this, Scene, Views);
+			bRealtimeGIRadianceCacheUpdated = true;
+		}
+
 		ComputeVolumetricFog(GraphBuilder, SceneTextures);
 		AddServiceLocalQueuePass(GraphBuilder);
 	}
@@ -2174,8 +2190,11 @@ void FDeferredShadingSceneRenderer::Render(FRHICommandListImmediate& RHICmdList)
 	// RealtimeGI
 	if (RealtimeGIEnable())
 	{
-		RealtimeGISceneUpdate(GraphBuilder, Scene, Views);
-		RealtimeGIVoxelLighting(GraphBuilder, *this, Scene, Views);
+		if (!bRealtimeGIRadianceCacheUpdated)
+		{
+			RealtimeGISceneUpdate(GraphBuilder, Scene, Views);
+			RealtimeGIVoxelLighting(GraphBuilder, *this, Scene, Views);
+		}
 		RealtimeGIScreenGather(GraphBuilder, Scene, Views, SceneTextures);
 	}
 
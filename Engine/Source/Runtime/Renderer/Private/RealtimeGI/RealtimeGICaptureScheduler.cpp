@@ -0,0 +1,57 @@
+#include "RealtimeGICaptureScheduler.h"
+
+float CalcCaptureRequestPriority(const FGICaptureRequest& Request, const TArray<FVector>& ViewOrigins, const FGICaptureBudget& Budget, uint32 FrameNumber)
+{
+	// distance to the nearest view surface, clamp to avoid infinity when view is inside bounds
+	float Distance = ViewOrigins.Num() > 0 ? MAX_flt : 1.0f;
+	for (const FVector& ViewOrigin : ViewOrigins)
+	{
+		Distance = FMath::Min(Distance, FVector::Dist(ViewOrigin, Request.BoundsOrigin) - Request.BoundsRadius);
+	}
+	Distance = FMath::Max(Distance, 1.0f);
+
+	const float ScreenSize = FMath::Max(Request.BoundsRadius, 1.0f) / Distance;
+	const float WaitFrames = FrameNumber > Request.RequestFrame ? float(FrameNumber - Request.RequestFrame) : 0.0f;
+	const float FirstCaptureBoost = Request.LastCaptureFrame == 0 ? Budget.FirstCaptureBoost : 1.0f;
+
+	return ScreenSize * (1.0f + WaitFrames * Budget.AgeWeight) * FirstCaptureBoost;
+}
+
+TArray<int32> ScheduleCaptureRequests(const TArray<FGICaptureRequest>& Requests, const TArray<FVector>& ViewOrigins, const FGICaptureBudget& Budget, uint32 FrameNumber)
+{
+	TArray<TPair<float, int32>> SortedRequests;	// (priority, index in Requests)
+	SortedRequests.Reserve(Requests.Num());
+	for (int32 Index = 0; Index < Requests.Num(); Index++)
+	{
+		SortedRequests.Add(TPair<float, int32>(CalcCaptureRequestPriority(Requests[Index], ViewOrigins, Budget, FrameNumber), Index));
+	}
+
+	// stable for same priority, keep queue order
+	SortedRequests.StableSort([](const TPair<float, int32>& A, const TPair<float, int32>& B)
+	{
+		return A.Key > B.Key;
+	});
+
+	TArray<int32> Result;
+	int64 UsedTexels = 0;
+	int64 UsedDraws = 0;
+	for (const TPair<float, int32>& SortedRequest : SortedRequests)
+	{
+		const FGICaptureRequest& Request = Requests[SortedRequest.Value];
+		const bool OverBudget =
+			UsedTexels + Request.NumTexels > Budget.MaxTexels ||
+			UsedDraws + Request.NumDraws > Budget.MaxDraws;
+
+		// smaller request may still fit, keep looking
+		if (OverBudget && Result.Num() > 0)
+		{
+			continue;
+		}
+
+		UsedTexels += Request.NumTexels;
+		UsedDraws += Request.NumDraws;
+		Result.Add(Request.Id);
+	}
+
+	return Result;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// a surface cache waiting for capture, only hold plain data so scheduling can run without render resources
+struct FGICaptureRequest
+{
+	int32 Id = INDEX_NONE;
+	FVector BoundsOrigin = FVector::ZeroVector;
+	float BoundsRadius = 0;
+	int32 NumTexels = 0;			// texels to render, sum of all cards
+	int32 NumDraws = 0;				// num of mesh batches, each batch draws all cards by instancing
+	uint32 RequestFrame = 0;		// frame when the request is queued
+	uint32 LastCaptureFrame = 0;	// 0 means never captured
+};
+
+struct FGICaptureBudget
+{
+	int32 MaxTexels = 0;
+	int32 MaxDraws = 0;
+	float AgeWeight = 0;			// priority boost per frame of waiting
+	float FirstCaptureBoost = 1;	// priority scale for surface cache never captured
+};
+
+// priority = projected size * waiting boost * first capture boost
+float CalcCaptureRequestPriority(const FGICaptureRequest& Request, const TArray<FVector>& ViewOrigins, const FGICaptureBudget& Budget, uint32 FrameNumber);
+
+// pick requests with highest priority until texel or draw budget is used up
+// the first pick is always accepted even if it is over budget, so huge surface cache will not starve
+// return selected request ids in priority order
+TArray<int32> ScheduleCaptureRequests(const TArray<FGICaptureRequest>& Requests, const TArray<FVector>& ViewOrigins, const FGICaptureBudget& Budget, uint32 FrameNumber);
@@ -21,6 +21,7 @@
 #include "DeferredShadingRenderer.h"
 #include "ReflectionEnvironmentCapture.h"
 #include "MeshPassProcessor.inl"
+#include "RenderGraphUtils.h"
 
 
 IMPLEMENT_GLOBAL_SHADER_PARAMETER_STRUCT(FRealtimeGICardCaptureParams, "CardCaptureParams");
@@ -172,6 +173,37 @@ void FRealtimeGICardCaptureMeshProcessor::Process(
 	);
 }
 
+void FRealtimeGIGPUScene::RealtimeGISurfaceCacheDefragPass(FRDGBuilder& GraphBuilder)
+{
+	if (SurfaceCacheAtlasMoves.Num() == 0 || SurfaceCacheAtlasNeedClear)
+	{
+		return;
+	}
+
+	RDG_EVENT_SCOPE(GraphBuilder, "RealtimeGISurfaceCacheDefrag");
+
+	// copy inside same texture is not allowed, go through a small scratch texture
+	FIntPoint ScratchSize = FIntPoint(0, 0);
+	for (const FGIAtlasMove& Move : SurfaceCacheAtlasMoves)
+	{
+		ScratchSize = ScratchSize.ComponentMax(Move.Src.Size);
+	}
+
+	for (int32 Slot = 0; Slot < RT_Num; Slot++)
+	{
+		FRDGTextureRef AtlasTexture = SurfaceCacheAtlas[Slot].RDGTexture;
+
+		FRDGTextureDesc ScratchDesc = FRDGTextureDesc::Create2D(ScratchSize, AtlasTexture->Desc.Format, FClearValueBinding::None, TexCreate_ShaderResource);
+		FRDGTextureRef ScratchTexture = GraphBuilder.CreateTexture(ScratchDesc, TEXT("SurfaceCacheDefragScratch"));
+
+		for (const FGIAtlasMove& Move : SurfaceCacheAtlasMoves)
+		{
+			AddCopyTexturePass(GraphBuilder, AtlasTexture, ScratchTexture, Move.Src.Min, FIntPoint::ZeroValue, Move.Src.Size);
+			AddCopyTexturePass(GraphBuilder, ScratchTexture, AtlasTexture, FIntPoint::ZeroValue, Move.Dst.Min, Move.Src.Size);
+		}
+	}
+}
+
 void FRealtimeGIGPUScene::RealtimeGISurfaceCacheCapturePass(FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View)
 {
 #if !ALLOW_EMPTY_DISPATCH_FOR_DEBUG
@@ -0,0 +1,131 @@
+#include "RealtimeGIDirtyChunks.h"
+
+static int32 WrapChunkIndex(int32 Index, int32 Num)
+{
+	Index = Index % Num;
+	return Index < 0 ? Index + Num : Index;
+}
+
+void FRealtimeGIDirtyChunks::Init(const FIntVector& InNumChunksInXYZ)
+{
+	const int32 NumChunks = InNumChunksInXYZ.X * InNumChunksInXYZ.Y * InNumChunksInXYZ.Z;
+	check(NumChunks > 0);
+
+	NumChunksInXYZ = InNumChunksInXYZ;
+	ChunkOffset = FIntVector(0, 0, 0);
+	DirtyBits.Init(false, NumChunks);
+	TimeStamps.SetNumZeroed(NumChunks);
+	Sequences.SetNumZeroed(NumChunks);
+	NextSequence = 0;
+	NumDirtyChunks = 0;
+}
+
+int32 FRealtimeGIDirtyChunks::ToPhysicalIndex(int32 Index1D) const
+{
+	const int32 SizeXY = NumChunksInXYZ.X * NumChunksInXYZ.Y;
+	const int32 Z = Index1D / SizeXY;
+	const int32 Y = (Index1D - Z * SizeXY) / NumChunksInXYZ.X;
+	const int32 X = Index1D - Z * SizeXY - Y * NumChunksInXYZ.X;
+
+	return WrapChunkIndex(X + ChunkOffset.X, NumChunksInXYZ.X) +
+		WrapChunkIndex(Y + ChunkOffset.Y, NumChunksInXYZ.Y) * NumChunksInXYZ.X +
+		WrapChunkIndex(Z + ChunkOffset.Z, NumChunksInXYZ.Z) * SizeXY;
+}
+
+int32 FRealtimeGIDirtyChunks::ToLogicalIndex(int32 PhysicalIndex) const
+{
+	const int32 SizeXY = NumChunksInXYZ.X * NumChunksInXYZ.Y;
+	const int32 Z = PhysicalIndex / SizeXY;
+	const int32 Y = (PhysicalIndex - Z * SizeXY) / NumChunksInXYZ.X;
+	const int32 X = PhysicalIndex - Z * SizeXY - Y * NumChunksInXYZ.X;
+
+	return WrapChunkIndex(X - ChunkOffset.X, NumChunksInXYZ.X) +
+		WrapChunkIndex(Y - ChunkOffset.Y, NumChunksInXYZ.Y) * NumChunksInXYZ.X +
+		WrapChunkIndex(Z - ChunkOffset.Z, NumChunksInXYZ.Z) * SizeXY;
+}
+
+bool FRealtimeGIDirtyChunks::IsDirty(int32 Index1D) const
+{
+	return DirtyBits[ToPhysicalIndex(Index1D)];
+}
+
+void FRealtimeGIDirtyChunks::MarkDirty(const FUpdateChunk& Chunk)
+{
+	const int32 PhysicalIndex = ToPhysicalIndex(Chunk.Index1D);
+	FBitReference DirtyBit = DirtyBits[PhysicalIndex];
+	if (DirtyBit)
+	{
+		return;
+	}
+
+	DirtyBit = true;
+	TimeStamps[PhysicalIndex] = Chunk.TimeStamp;
+	Sequences[PhysicalIndex] = NextSequence++;
+	NumDirtyChunks++;
+}
+
+bool FRealtimeGIDirtyChunks::PopOldest(FUpdateChunk& OutChunk)
+{
+	TArray<int32> Indices;
+	PopOldest(1, Indices);
+	if (Indices.Num() == 0)
+	{
+		return false;
+	}
+
+	// time stamp is kept after the bit is cleared
+	OutChunk.Index1D = Indices[0];
+	OutChunk.TimeStamp = TimeStamps[ToPhysicalIndex(Indices[0])];
+	return true;
+}
+
+void FRealtimeGIDirtyChunks::PopOldest(int32 MaxNum, TArray<int32>& OutIndices)
+{
+	OutIndices.Reset();
+	if (MaxNum <= 0 || NumDirtyChunks == 0)
+	{
+		return;
+	}
+
+	// pop always take the oldest, so sequences of dirty chunks are [NextSequence - NumDirtyChunks, NextSequence)
+	// place each chunk by its sequence instead of sorting, iterator skip whole empty words
+	const uint32 OldestSequence = NextSequence - NumDirtyChunks;
+	const int32 NumToPop = FMath::Min(MaxNum, NumDirtyChunks);
+	TArray<int32> OldestChunks;
+	OldestChunks.SetNumUninitialized(NumToPop);
+	for (TConstSetBitIterator<> It(DirtyBits); It; ++It)
+	{
+		const uint32 Order = Sequences[It.GetIndex()] - OldestSequence;
+		if (Order < (uint32)NumToPop)
+		{
+			OldestChunks[Order] = It.GetIndex();
+		}
+	}
+
+	for (int32 PhysicalIndex : OldestChunks)
+	{
+		DirtyBits[PhysicalIndex] = false;
+		OutIndices.Add(ToLogicalIndex(PhysicalIndex));
+	}
+	NumDirtyChunks -= NumToPop;
+}
+
+void FRealtimeGIDirtyChunks::Scroll(const FIntVector& DeltaChunk)
+{
+	ChunkOffset.X = WrapChunkIndex(ChunkOffset.X + DeltaChunk.X, NumChunksInXYZ.X);
+	ChunkOffset.Y = WrapChunkIndex(ChunkOffset.Y + DeltaChunk.Y, NumChunksInXYZ.Y);
+	ChunkOffset.Z = WrapChunkIndex(ChunkOffset.Z + DeltaChunk.Z, NumChunksInXYZ.Z);
+}
+
+void FRealtimeGIDirtyChunks::GetChunksWithTimeStamp(uint32 TimeStamp, TArray<int32>& OutIndices) const
+{
+	OutIndices.Reset();
+	for (TConstSetBitIterator<> It(DirtyBits); It; ++It)
+	{
+		if (TimeStamps[It.GetIndex()] == TimeStamp)
+		{
+			OutIndices.Add(ToLogicalIndex(It.GetIndex()));
+		}
+	}
+	OutIndices.Sort();
+}
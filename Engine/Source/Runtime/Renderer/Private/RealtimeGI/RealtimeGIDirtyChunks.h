@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FUpdateChunk
+{
+	int32 Index1D = 0;
+	uint32 TimeStamp = 0;
+};
+
+// dirty update chunks of a clip, one bit per chunk in toroidal address so volume scrolling is an offset
+// chunks are popped in the order they are first marked dirty, mark a dirty chunk again keep its order and time stamp
+class FRealtimeGIDirtyChunks
+{
+public:
+	void Init(const FIntVector& InNumChunksInXYZ);
+
+	bool HasDirtyChunks() const { return NumDirtyChunks > 0; }
+	int32 GetNumDirtyChunks() const { return NumDirtyChunks; }
+	bool IsDirty(int32 Index1D) const;
+
+	void MarkDirty(const FUpdateChunk& Chunk);
+	bool PopOldest(FUpdateChunk& OutChunk);
+	void PopOldest(int32 MaxNum, TArray<int32>& OutIndices);
+
+	// chunk index move by -DeltaChunk and wrap around, like the volume texture
+	void Scroll(const FIntVector& DeltaChunk);
+
+	// chunks marked dirty at this frame, in index order
+	void GetChunksWithTimeStamp(uint32 TimeStamp, TArray<int32>& OutIndices) const;
+
+protected:
+	int32 ToPhysicalIndex(int32 Index1D) const;
+	int32 ToLogicalIndex(int32 PhysicalIndex) const;
+
+	FIntVector NumChunksInXYZ = FIntVector(0, 0, 0);
+	FIntVector ChunkOffset = FIntVector(0, 0, 0);	// physical = (logical + offset) % NumChunksInXYZ
+
+	TBitArray<> DirtyBits;
+	TArray<uint32> TimeStamps;
+	TArray<uint32> Sequences;	// order of first mark, only compared relative to the oldest one so it can wrap around
+	uint32 NextSequence = 0;
+	int32 NumDirtyChunks = 0;
+};
@@ -82,6 +82,72 @@ static TAutoConsoleVariable<int32> CVarRealtimeGIAdaptiveSurfaceCacheNumPerFrame
 	ECVF_RenderThreadSafe
 );
 
+static TAutoConsoleVariable<int32> CVarRealtimeGISurfaceCacheDefragMovesPerFrame(
+	TEXT("r.RealtimeGI.SurfaceCacheDefragMovesPerFrame"),
+	4,
+	TEXT("Max num of card tiles moved by surface cache atlas defragmentation per frame, 0 to disable"),
+	ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<float> CVarRealtimeGISurfaceCacheEvictDistance(
+	TEXT("r.RealtimeGI.SurfaceCacheEvictDistance"),
+	20000.0,
+	TEXT("When atlas is full, surface cache whose objects are all farther than this distance to views can be evicted"),
+	ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<int32> CVarRealtimeGISurfaceCacheCaptureTexelBudget(
+	TEXT("r.RealtimeGI.SurfaceCacheCaptureTexelBudget"),
+	128 * 1024,
+	TEXT("Max num of surface cache texels to capture per frame"),
+	ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<int32> CVarRealtimeGISurfaceCacheCaptureDrawBudget(
+	TEXT("r.RealtimeGI.SurfaceCacheCaptureDrawBudget"),
+	64,
+	TEXT("Max num of mesh batches to draw for surface cache capture per frame"),
+	ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<float> CVarRealtimeGISurfaceCacheCaptureAgeWeight(
+	TEXT("r.RealtimeGI.SurfaceCacheCaptureAgeWeight"),
+	0.1,
+	TEXT("Capture priority boost per frame a surface cache waits in queue"),
+	ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<float> CVarRealtimeGISurfaceCacheFirstCaptureBoost(
+	TEXT("r.RealtimeGI.SurfaceCacheFirstCaptureBoost"),
+	4.0,
+	TEXT("Capture priority scale of surface cache never captured"),
+	ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<int32> CVarRealtimeGIUsePrecomputedMeshCards(
+	TEXT("r.RealtimeGI.UsePrecomputedMeshCards"),
+	1,
+	TEXT("Use mesh cards built with static mesh, otherwise use 6 cards over local bounds"),
+	ECVF_RenderThreadSafe
+);
+
+static const FRealtimeGIMeshCardsData* GetPrecomputedMeshCards(const FPrimitiveSceneProxy* Proxy)
+{
+	if (CVarRealtimeGIUsePrecomputedMeshCards.GetValueOnRenderThread() == 0)
+	{
+		return nullptr;
+	}
+
+	return Proxy->GetRealtimeGIMeshCards();
+}
+
+static TAutoConsoleVariable<int32> CVarRealtimeGIParallelSceneUpdate(
+	TEXT("r.RealtimeGI.ParallelSceneUpdate"),
+	1,
+	TEXT("Run GI scene bookkeeping in task graph parallel with InitViews"),
+	ECVF_RenderThreadSafe
+);
+
 static TAutoConsoleVariable<int32> CVarRealtimeGISurfaceCacheForceCapture(
 	TEXT("r.RealtimeGI.SurfaceCacheForceCapture"),
 	0,
@@ -89,6 +155,28 @@ static TAutoConsoleVariable<int32> CVarRealtimeGISurfaceCacheForceCapture(
 	ECVF_RenderThreadSafe
 );
 
+static TAutoConsoleVariable<float> CVarRealtimeGIShareClipmapDistance(
+	TEXT("r.RealtimeGI.ShareClipmapDistance"),
+	0.0,
+	TEXT("Views closer than this distance share one voxel clipmap and radiance cache centered on their average location, screen gather is still per view. 0 to disable"),
+	ECVF_RenderThreadSafe
+);
+
+// set by r.RealtimeGI.DumpMemory, report is printed by render thread at next scene update
+static bool GRealtimeGIDumpMemory = false;
+
+static FAutoConsoleCommand CmdRealtimeGIDumpMemory(
+	TEXT("r.RealtimeGI.DumpMemory"),
+	TEXT("Log gpu memory of realtime GI per view, shared clipmaps are listed once"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		ENQUEUE_RENDER_COMMAND(RealtimeGIDumpMemory)([](FRHICommandListImmediate&)
+		{
+			GRealtimeGIDumpMemory = true;
+		});
+	})
+);
+
 
 class FObjectInfoUpdateCS : public FGlobalShader
 {
@@ -98,7 +186,7 @@ public:
 
 	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
 		SHADER_PARAMETER(int, NumUpdateObjects)
-		SHADER_PARAMETER_SRV(StructuredBuffer, ObjectInfoUploadBuffer)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer, ObjectInfoUploadBuffer)
 		SHADER_PARAMETER_UAV(RWStructuredBuffer, RWObjectInfoBuffer)
 	END_SHADER_PARAMETER_STRUCT()
 
@@ -131,7 +219,7 @@ public:
 
 	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
 		SHADER_PARAMETER(int, NumRemovedObjects)
-		SHADER_PARAMETER_SRV(StructuredBuffer, RemovedObjectIdBuffer)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer, RemovedObjectIdBuffer)
 		SHADER_PARAMETER_UAV(RWStructuredBuffer, RWObjectInfoBuffer)
 	END_SHADER_PARAMETER_STRUCT()
 
@@ -163,9 +251,10 @@ public:
 	SHADER_USE_PARAMETER_STRUCT(FObjectInfoCompactCS, FGlobalShader);
 
 	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER(int, NumCompactUpdates)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer, CompactUpdateUploadBuffer)
 		SHADER_PARAMETER_SRV(StructuredBuffer, ObjectInfoBuffer)
 		SHADER_PARAMETER_UAV(RWStructuredBuffer, RWMiniObjectInfoBuffer)
-		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer, RWObjectInfoCounter)
 	END_SHADER_PARAMETER_STRUCT()
 
 	static const uint32 ThreadGroupSizeX = 8;
@@ -197,8 +286,8 @@ public:
 
 	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
 		SHADER_PARAMETER(int, SurfaceCacheNum)
-		SHADER_PARAMETER_SRV(StructuredBuffer, SurfaceCacheInfoUploadBuffer)
-		SHADER_PARAMETER_SRV(StructuredBuffer, CardInfoUploadBuffer)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer, SurfaceCacheInfoUploadBuffer)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer, CardInfoUploadBuffer)
 		SHADER_PARAMETER_UAV(RWStructuredBuffer, RWSurfaceCacheInfoBuffer)
 		SHADER_PARAMETER_UAV(RWStructuredBuffer, RWCardInfoBuffer)
 	END_SHADER_PARAMETER_STRUCT()
@@ -284,7 +373,7 @@ public:
 	FSurfaceCacheInfoGPUData(const FSurfaceCacheInfo& SurfaceCacheInfo)
 	{
 		SurfaceCacheId = SurfaceCacheInfo.SurfaceCacheId;
-		NumMeshCards = SurfaceCacheInfo.NumMeshCards;
+		NumMeshCards = SurfaceCacheInfo.IsResident() ? SurfaceCacheInfo.NumMeshCards : 0;	// evicted surface cache has no card
 		MeshCardResolution = SurfaceCacheInfo.MeshCardResolution;
 	}
 
@@ -400,6 +489,7 @@ void FSurfaceCacheInfo::Empty()
 	MeshCardResolution = 0;
 	CardCaptureMeshBatches.Empty();
 	LocalToCardMatrixs.Empty();
+	CardExtents.Empty();
 	CardUVTransforms.Empty();
 	ReferenceHolders.Empty();
 }
@@ -416,6 +506,9 @@ void FSurfaceCacheInfo::RemoveObjectReference(const FObjectInfo& ObjectInfo)
 
 void FRealtimeGIGPUScene::OnRendererSceneUpdatePrimitives(const TArray<FPrimitiveSceneInfo*>& AddedPrimitiveSceneInfos, const TArray<FPrimitiveSceneInfo*>& RemovedPrimitiveSceneInfos)
 {
+	// update task is reading pending queues
+	WaitForUpdateTask();
+
 	for (FPrimitiveSceneInfo* Primitive : RemovedPrimitiveSceneInfos)
 	{
 		const FPrimitiveComponentId& PrimitiveId = Primitive->Proxy->GetPrimitiveComponentId();
@@ -491,6 +584,11 @@ void FRealtimeGIGPUScene::FlushPrimitiveUpdateQueue()
 		}
 
 		int32 NewId = ObjectIdAllocator.AllocateElement(PrimitiveId);
+		if (NewId >= ObjectInfos.Num())
+		{
+			ObjectInfos.SetNum(ObjectIdAllocator.GetMaxNumElements());
+		}
+
 		ObjectInfos[NewId] = FObjectInfo(Primitive, NewId);
 		ObjectAddCommands.Add(NewId);
 		DirtyPrimitiveBounds.Add(Primitive->Proxy->GetBounds());
@@ -499,16 +597,23 @@ void FRealtimeGIGPUScene::FlushPrimitiveUpdateQueue()
 
 void FRealtimeGIGPUScene::PrepareSurfaceCacheCapture()
 {
+	// 0. defragment atlas before any release in this frame, so a moved tile never lands in a rect cleared in this frame
+	DefragmentSurfaceCacheAtlas();
+
 	// 1. handle object add, check if surface cache exist and do allocation
-	for (int32 ObjectId : ObjectAddCommands)
+	const TArray<int32> AddedObjectIds = ObjectAddCommands.Array();
+	const TArray<FSurfaceCacheKey> AddedObjectKeys = BuildSurfaceCacheKeys(AddedObjectIds);
+	for (int32 i = 0; i < AddedObjectIds.Num(); i++)
 	{
-		ReferenceSurfaceCache(ObjectInfos[ObjectId]);
+		ReferenceSurfaceCache(ObjectInfos[AddedObjectIds[i]], AddedObjectKeys[i]);
 	}
 
 	// 2. handle object update, check if material or vf change, if change we re allocate
-	for (int32 ObjectId : ObjectUpdateCommands)
+	const TArray<int32> UpdatedObjectIds = ObjectUpdateCommands.Array();
+	const TArray<FSurfaceCacheKey> UpdatedObjectKeys = BuildSurfaceCacheKeys(UpdatedObjectIds);
+	for (int32 i = 0; i < UpdatedObjectIds.Num(); i++)
 	{
-		ReferenceSurfaceCache(ObjectInfos[ObjectId]);
+		ReferenceSurfaceCache(ObjectInfos[UpdatedObjectIds[i]], UpdatedObjectKeys[i]);
 	}
 
 	// 3. handle object remove
@@ -521,61 +626,338 @@ void FRealtimeGIGPUScene::PrepareSurfaceCacheCapture()
 	TArray<int32> SurfaceCacheIds = SurfaceCacheAllocator.GetAllocatedElements();
 	const int32 NumSurfaceCacheToCheck = FMath::Min(SurfaceCacheIds.Num(), CVarRealtimeGIAdaptiveSurfaceCacheNumPerFrame.GetValueOnRenderThread());
 	const int32 StartIndex = FMath::RandRange(0, SurfaceCacheIds.Num());
+
+	// resolution of each surface cache only read its own reference objects, calculate in parallel
+	TArray<int32> RequireResolutions;
+	RequireResolutions.SetNumZeroed(NumSurfaceCacheToCheck);
+	ParallelFor(NumSurfaceCacheToCheck, [&](int32 i)
+	{
+		int32 Index = (StartIndex + i) % SurfaceCacheIds.Num();
+		RequireResolutions[i] = CalcSurfaceCacheResolution(SurfaceCacheIds[Index]);
+	});
+
+	// apply in order, this touches allocators
 	for (int32 i = 0; i < NumSurfaceCacheToCheck; i++)
 	{
 		int32 Index = (StartIndex + i) % SurfaceCacheIds.Num();
 		int32 SurfaceCacheId = SurfaceCacheIds[Index];
 
-		AdjustSurfaceCacheResolution(SurfaceCacheId);
+		AdjustSurfaceCacheResolution(SurfaceCacheId, RequireResolutions[i]);
 	}
 
-	// 5. gather mesh batches (step 1,2 will populate SurfaceCacheCaptureCommands)
+	// 5. pick requests within capture budget (step 1,2,4 will populate PendingSurfaceCacheCaptures)
+	ScheduleSurfaceCacheCapture();
+
+	// 6. gather mesh batches
+	TArray<int32> FailedSurfaceCacheIds;
 	for (int32 SurfaceCacheId : SurfaceCacheCaptureCommands)
 	{
 		GatherCardCaptureMeshElements(SurfaceCacheId);
-		AllocateSurfaceCacheTextureSpace(SurfaceCacheId);
+		if (!AllocateSurfaceCacheTextureSpace(SurfaceCacheId))
+		{
+			FailedSurfaceCacheIds.Add(SurfaceCacheId);
+		}
+	}
+
+	// atlas is full, surface cache stay non-resident and will retry in adaptive resolution check
+	for (int32 SurfaceCacheId : FailedSurfaceCacheIds)
+	{
+		SurfaceCacheCaptureCommands.Remove(SurfaceCacheId);
+		SurfaceCacheUpdateCommands.Add(SurfaceCacheId);
+	}
+
+	// 7. surface cache changed, voxels of all reference objects need update
+	for (int32 SurfaceCacheId : SurfaceCacheCaptureCommands)
+	{
+		FSurfaceCacheInfo& SurfaceCacheInfo = SurfaceCacheInfos[SurfaceCacheId];
+		SurfaceCacheInfo.LastCaptureFrame = GFrameNumberRenderThread;
+
+		for (int32 ObjectId : SurfaceCacheInfo.GetReferenceHolders())
+		{
+			DirtyPrimitiveBounds.Add(ObjectInfos[ObjectId].Primitive->Proxy->GetBounds());
+		}
 	}
 }
 
-void FRealtimeGIGPUScene::PreUpdate(FRDGBuilder& GraphBuilder, FScene* Scene, TArray<FViewInfo>& Views)
+void FRealtimeGIGPUScene::RequestSurfaceCacheCapture(const int32& SurfaceCacheId)
 {
-	// init all view
-	for (FViewInfo& View : Views)
+	// keep the first request frame, so waiting time keeps growing
+	if (!PendingSurfaceCacheCaptures.Contains(SurfaceCacheId))
+	{
+		PendingSurfaceCacheCaptures.Add(SurfaceCacheId, GFrameNumberRenderThread);
+	}
+
+	// slot may hold stale data of a released surface cache, upload as non-resident until captured
+	SurfaceCacheUpdateCommands.Add(SurfaceCacheId);
+}
+
+void FRealtimeGIGPUScene::ScheduleSurfaceCacheCapture()
+{
+	if (PendingSurfaceCacheCaptures.Num() == 0)
+	{
+		return;
+	}
+
+	FGICaptureBudget Budget;
+	Budget.MaxTexels = CVarRealtimeGISurfaceCacheCaptureTexelBudget.GetValueOnRenderThread();
+	Budget.MaxDraws = CVarRealtimeGISurfaceCacheCaptureDrawBudget.GetValueOnRenderThread();
+	Budget.AgeWeight = CVarRealtimeGISurfaceCacheCaptureAgeWeight.GetValueOnRenderThread();
+	Budget.FirstCaptureBoost = CVarRealtimeGISurfaceCacheFirstCaptureBoost.GetValueOnRenderThread();
+
+	// debug mode capture everything
+	if (CVarRealtimeGISurfaceCacheForceCapture.GetValueOnRenderThread() > 0)
 	{
-		View.RealtimeGIVoxelClipmap = GetOrCreatePerViewObject(VoxelClipmapViewMap, View.GetViewKey());
-		View.RealtimeGIRadianceCache = GetOrCreatePerViewObject(RadianceCacheViewMap, View.GetViewKey());
-		View.RealtimeGIScreenGatherPipeline = GetOrCreatePerViewObject(ScreenGatherPipelineViewMap, View.GetViewKey());
+		Budget.MaxTexels = MAX_int32;
+		Budget.MaxDraws = MAX_int32;
 	}
 
-	// do some init
+	const int32 DefaultResolution = CVarRealtimeGIMeshCardDefaultResolution.GetValueOnRenderThread();
+
+	TArray<FGICaptureRequest> Requests;
+	Requests.Reserve(PendingSurfaceCacheCaptures.Num());
+	for (const TPair<int32, uint32>& Pending : PendingSurfaceCacheCaptures)
+	{
+		FSurfaceCacheInfo& SurfaceCacheInfo = SurfaceCacheInfos[Pending.Key];
+		const int32 Resolution = SurfaceCacheInfo.MeshCardResolution > 0 ? SurfaceCacheInfo.MeshCardResolution : DefaultResolution;
+
+		FGICaptureRequest Request;
+		Request.Id = Pending.Key;
+		Request.RequestFrame = Pending.Value;
+		Request.LastCaptureFrame = SurfaceCacheInfo.LastCaptureFrame;
+
+		// shared surface cache use the reference object nearest to views
+		float MinDistance = MAX_flt;
+		for (int32 ObjectId : SurfaceCacheInfo.GetReferenceHolders())
+		{
+			const FObjectInfo& ObjectInfo = ObjectInfos[ObjectId];
+			const FBoxSphereBounds& WorldBound = ObjectInfo.Primitive->Proxy->GetBounds();
+			const FRealtimeGIMeshCardsData* MeshCards = GetPrecomputedMeshCards(ObjectInfo.Primitive->Proxy);
+			Request.NumDraws = ObjectInfo.SurfaceCacheKey.MaterialPointers.Num();
+			Request.NumTexels = Resolution * Resolution * (MeshCards ? MeshCards->Cards.Num() : CubeFace_MAX);
+
+			for (const FVector& ViewOrigin : ViewOrigins)
+			{
+				const float Distance = FVector::Dist(ViewOrigin, WorldBound.Origin) - WorldBound.SphereRadius;
+				if (Distance < MinDistance || Request.BoundsRadius == 0)
+				{
+					MinDistance = Distance;
+					Request.BoundsOrigin = WorldBound.Origin;
+					Request.BoundsRadius = WorldBound.SphereRadius;
+				}
+			}
+		}
+
+		Requests.Add(Request);
+	}
+
+	const TArray<int32> SelectedIds = ScheduleCaptureRequests(Requests, ViewOrigins, Budget, GFrameNumberRenderThread);
+	for (int32 SurfaceCacheId : SelectedIds)
+	{
+		PendingSurfaceCacheCaptures.Remove(SurfaceCacheId);
+		SurfaceCacheCaptureCommands.Add(SurfaceCacheId);
+	}
+}
+
+void FRealtimeGIGPUScene::DefragmentSurfaceCacheAtlas()
+{
+	const int32 MaxNumMoves = CVarRealtimeGISurfaceCacheDefragMovesPerFrame.GetValueOnRenderThread();
+
+	SurfaceCacheAtlasMoves.Reset();
+	SurfaceCacheAtlasAllocator.Defragment(MaxNumMoves, SurfaceCacheAtlasMoves);
+
+	for (const FGIAtlasMove& Move : SurfaceCacheAtlasMoves)
+	{
+		const int32 SurfaceCacheId = Move.Owner / MAX_CARDS_PER_MESH;
+		const int32 CardIndex = Move.Owner % MAX_CARDS_PER_MESH;
+
+		FSurfaceCacheInfo& SurfaceCacheInfo = SurfaceCacheInfos[SurfaceCacheId];
+		SurfaceCacheInfo.CardUVTransforms[CardIndex] = FVector4(Move.Dst.Size.X, Move.Dst.Size.Y, Move.Dst.Min.X, Move.Dst.Min.Y);
+		SurfaceCacheUpdateCommands.Add(SurfaceCacheId);
+
+		// texels are copied to new place before clear
+		SurfaceCacheClearCommands.Add(FVector4(Move.Src.Size.X, Move.Src.Size.Y, Move.Src.Min.X, Move.Src.Min.Y));
+	}
+}
+
+void FRealtimeGIGPUScene::BeginUpdateTask(const TArray<FViewInfo>& Views)
+{
+	// already issued in this frame
+	if (UpdateTaskIssued)
+	{
+		return;
+	}
+	UpdateTaskIssued = true;
+
+	ViewOrigins.Reset();
+	for (const FViewInfo& View : Views)
+	{
+		ViewOrigins.Add(View.ViewMatrices.GetViewOrigin());
+	}
+
+	if (CVarRealtimeGIParallelSceneUpdate.GetValueOnRenderThread() > 0)
+	{
+		UpdateTask = FFunctionGraphTask::CreateAndDispatchWhenReady([this]()
+		{
+			UpdateCPU();
+		}, TStatId(), nullptr, ENamedThreads::AnyHiPriThreadHiPriTask);
+	}
+	else
+	{
+		UpdateCPU();
+	}
+}
+
+void FRealtimeGIGPUScene::WaitForUpdateTask()
+{
+	if (UpdateTask.IsValid())
+	{
+		QUICK_SCOPE_CYCLE_COUNTER(STAT_RealtimeGIWaitForUpdateTask);
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(UpdateTask, ENamedThreads::GetRenderThread_Local());
+		UpdateTask = nullptr;
+	}
+
+	// every waiter may be followed by new queue entries, next BeginUpdateTask must flush them
+	// also covers a frame that returns before PostUpdate
+	UpdateTaskIssued = false;
+}
+
+void FRealtimeGIGPUScene::UpdateCPU()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_RealtimeGIUpdateCPU);
+
+	// do some init, cvar is initial capacity, allocator will grow when it is full
 	const int32 MaxObjectNum = CVarRealtimeGIMaxObjectNum.GetValueOnRenderThread();
 	ObjectIdAllocator.Init(MaxObjectNum);
 
-	// @TODO: change size
-	if (ObjectInfos.Num() == 0)
+	if (ObjectInfos.Num() < ObjectIdAllocator.GetMaxNumElements())
 	{
-		ObjectInfos.SetNum(MaxObjectNum);
+		ObjectInfos.SetNum(ObjectIdAllocator.GetMaxNumElements());
 	}
 
 	const int32 MaxSurfaceCacheNum = CVarRealtimeGIMaxSurfaceCacheNum.GetValueOnRenderThread();
 	SurfaceCacheAllocator.Init(MaxSurfaceCacheNum);
 
-	// @TODO: change size
-	if (SurfaceCacheInfos.Num() == 0)
+	if (SurfaceCacheInfos.Num() < SurfaceCacheAllocator.GetMaxNumElements())
 	{
-		SurfaceCacheInfos.SetNum(MaxSurfaceCacheNum);
+		SurfaceCacheInfos.SetNum(SurfaceCacheAllocator.GetMaxNumElements());
 	}
 
 	SurfaceCacheAtlasAllocator.Init(SurfaceCacheAtlasResolution);
+
+	FlushPrimitiveUpdateQueue();
+
+	PrepareSurfaceCacheCapture();
 }
 
-void FRealtimeGIGPUScene::Update(FRDGBuilder& GraphBuilder, FScene* Scene, TArray<FViewInfo>& Views)
+void FRealtimeGIGPUScene::PreUpdate(FRDGBuilder& GraphBuilder, FScene* Scene, TArray<FViewInfo>& Views)
 {
-	PreUpdate(GraphBuilder, Scene, Views);
+	// run inline if no one issued the task before
+	BeginUpdateTask(Views);
+	WaitForUpdateTask();
+
+	// group nearby views, each group share the clipmap and radiance cache of its first view
+	const float ShareDistance = CVarRealtimeGIShareClipmapDistance.GetValueOnRenderThread();
+	TArray<int32, TInlineAllocator<4>> ViewGroups;
+	TArray<FVector, TInlineAllocator<4>> GroupOrigins;
+	TArray<int32, TInlineAllocator<4>> GroupNumViews;
+	for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
+	{
+		int32 GroupIndex = INDEX_NONE;
+		for (int32 OtherIndex = 0; OtherIndex < ViewIndex && ShareDistance > 0; OtherIndex++)
+		{
+			const int32 OtherGroup = ViewGroups[OtherIndex];
+			if (OtherGroup == OtherIndex && FVector::Dist(Views[ViewIndex].ViewLocation, Views[OtherIndex].ViewLocation) <= ShareDistance)
+			{
+				GroupIndex = OtherGroup;
+				break;
+			}
+		}
 
-	FlushPrimitiveUpdateQueue();
+		if (GroupIndex == INDEX_NONE)
+		{
+			GroupIndex = ViewIndex;
+		}
+		ViewGroups.Add(GroupIndex);
+		GroupOrigins.Add(FVector::ZeroVector);
+		GroupNumViews.Add(0);
+		GroupOrigins[GroupIndex] += Views[ViewIndex].ViewLocation;
+		GroupNumViews[GroupIndex] += 1;
+	}
 
-	PrepareSurfaceCacheCapture();
+	// create all objects before taking pointers, map may grow during creation
+	for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
+	{
+		const uint32 ViewKey = Views[ViewIndex].GetViewKey();
+		if (ViewGroups[ViewIndex] == ViewIndex)
+		{
+			GetOrCreatePerViewObject(VoxelClipmapViewMap, ViewKey);
+			GetOrCreatePerViewObject(RadianceCacheViewMap, ViewKey);
+		}
+		GetOrCreatePerViewObject(ScreenGatherPipelineViewMap, ViewKey);
+	}
+
+	// init all view
+	for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
+	{
+		FViewInfo& View = Views[ViewIndex];
+		const int32 GroupIndex = ViewGroups[ViewIndex];
+		const uint32 GroupKey = Views[GroupIndex].GetViewKey();
+		View.RealtimeGIVoxelClipmap = VoxelClipmapViewMap.Find(GroupKey);
+		View.RealtimeGIRadianceCache = RadianceCacheViewMap.Find(GroupKey);
+		View.RealtimeGIScreenGatherPipeline = ScreenGatherPipelineViewMap.Find(View.GetViewKey());
+		View.bRealtimeGIClipmapOwner = GroupIndex == ViewIndex;
+		if (View.bRealtimeGIClipmapOwner)
+		{
+			View.RealtimeGIVoxelClipmap->ClipmapOrigin = GroupOrigins[GroupIndex] / GroupNumViews[GroupIndex];
+		}
+	}
+
+	if (GRealtimeGIDumpMemory)
+	{
+		GRealtimeGIDumpMemory = false;
+		DumpMemory(Views);
+	}
+}
+
+void FRealtimeGIGPUScene::DumpMemory(const TArray<FViewInfo>& Views)
+{
+	const double MB = 1.0 / (1024.0 * 1024.0);
+	uint64 TotalSize = 0;
+
+	UE_LOG(LogRenderer, Log, TEXT("RealtimeGI memory (%d views):"), Views.Num());
+	for (const FViewInfo& View : Views)
+	{
+		const uint64 ClipmapSize = View.RealtimeGIVoxelClipmap->GetGPUMemorySize();
+		const uint64 RadianceCacheSize = View.RealtimeGIRadianceCache->GetGPUMemorySize();
+		const uint64 ScreenGatherSize = View.RealtimeGIScreenGatherPipeline->GetGPUMemorySize();
+
+		// shared clipmap is counted by its owner view only
+		TotalSize += ScreenGatherSize + (View.bRealtimeGIClipmapOwner ? ClipmapSize + RadianceCacheSize : 0);
+
+		UE_LOG(LogRenderer, Log, TEXT("  View %u: VoxelClipmap %.2f MB, RadianceCache %.2f MB%s, ScreenGather %.2f MB"),
+			View.GetViewKey(),
+			ClipmapSize * MB,
+			RadianceCacheSize * MB,
+			View.bRealtimeGIClipmapOwner ? TEXT("") : TEXT(" (shared)"),
+			ScreenGatherSize * MB
+		);
+	}
+
+	uint64 SceneSize = 0;
+	for (int32 i = 0; i < RT_Num; i++)
+	{
+		SceneSize += GetPersistentTextureSize(SurfaceCacheAtlas[i]);
+	}
+	SceneSize += ObjectInfoBuffer.NumBytes + SurfaceCacheInfoBuffer.NumBytes + CardInfoBuffer.NumBytes + MiniObjectInfoBuffer.NumBytes;
+	TotalSize += SceneSize;
+
+	UE_LOG(LogRenderer, Log, TEXT("  Scene: SurfaceCache and object buffers %.2f MB"), SceneSize * MB);
+	UE_LOG(LogRenderer, Log, TEXT("  Total: %.2f MB"), TotalSize * MB);
+}
+
+void FRealtimeGIGPUScene::Update(FRDGBuilder& GraphBuilder, FScene* Scene, TArray<FViewInfo>& Views)
+{
+	PreUpdate(GraphBuilder, Scene, Views);
 
 	PrepareRenderResources(GraphBuilder, Scene);
 
@@ -583,11 +965,16 @@ void FRealtimeGIGPUScene::Update(FRDGBuilder& GraphBuilder, FScene* Scene, TArra
 
 	SyncSurfaceCacheInfosToGPU(GraphBuilder, Scene);
 
+	RealtimeGISurfaceCacheDefragPass(GraphBuilder);
+
 	RealtimeGISurfaceCacheCapturePass(GraphBuilder, Scene, Views[0]);	// Views[0] just for provide view uniform buffer
 
 	for (FViewInfo& View : Views)
 	{
-		View.RealtimeGIVoxelClipmap->Update(GraphBuilder, Scene, View);
+		if (View.bRealtimeGIClipmapOwner)
+		{
+			View.RealtimeGIVoxelClipmap->Update(GraphBuilder, Scene, View);
+		}
 	}
 
 	PostUpdate(GraphBuilder, Scene, Views);
@@ -606,6 +993,10 @@ void FRealtimeGIGPUScene::PostUpdate(FRDGBuilder& GraphBuilder, FScene* Scene, T
 	ObjectAddCommands.Empty();
 	SurfaceCacheCaptureCommands.Empty();
 	SurfaceCacheClearCommands.Empty();
+	SurfaceCacheUpdateCommands.Empty();
+	SurfaceCacheAtlasMoves.Reset();
+	SurfaceCacheEvictionCandidates.Reset();
+	SurfaceCacheEvictionCandidatesBuilt = false;
 	DirtyPrimitiveBounds.Empty();
 	PendingPrimitivesToAdd.Empty();
 	PendingPrimitivesToRemove.Empty();
@@ -614,12 +1005,23 @@ void FRealtimeGIGPUScene::PostUpdate(FRDGBuilder& GraphBuilder, FScene* Scene, T
 void FRealtimeGIGPUScene::PrepareRenderResources(FRDGBuilder& GraphBuilder, FScene* Scene)
 {
 	FRHICommandListImmediate& RHICmdList = GraphBuilder.RHICmdList;
-	const int32 MaxObjectNum = CVarRealtimeGIMaxObjectNum.GetValueOnRenderThread();
-	const int32 MaxSurfaceCacheNum = CVarRealtimeGIMaxSurfaceCacheNum.GetValueOnRenderThread();
+	const int32 MaxObjectNum = ObjectIdAllocator.GetMaxNumElements();
+	const int32 MaxSurfaceCacheNum = SurfaceCacheAllocator.GetMaxNumElements();
+
+	// allocator grow, re-create all buffers with new size
+	auto NeedResize = [](uint32 NumBytes, uint32 RequireNumBytes)
+	{
+		return NumBytes < RequireNumBytes;
+	};
+
+	ObjectInfoBufferResized = false;
+	SurfaceCacheInfoBufferResized = false;
 
 	// create buffer
-	if (ObjectInfoBuffer.NumBytes == 0)
+	if (NeedResize(ObjectInfoBuffer.NumBytes, sizeof(FObjectInfoGPUData) * MaxObjectNum))
 	{
+		ObjectInfoBufferResized = ObjectInfoBuffer.NumBytes > 0;
+		ObjectInfoBuffer.Release();
 		ObjectInfoBuffer.Initialize(
 			sizeof(FObjectInfoGPUData), MaxObjectNum,
 			BUF_Static,
@@ -627,10 +1029,7 @@ void FRealtimeGIGPUScene::PrepareRenderResources(FRDGBuilder& GraphBuilder, FSce
 		);
 
 		TArray<FObjectInfoGPUData> InitData;
-		for (int32 i = 0; i < MaxObjectNum; i++)
-		{
-			InitData.Add(FObjectInfoGPUData());
-		}
+		InitData.Init(FObjectInfoGPUData(), MaxObjectNum);
 
 		const int32 NumBytes = MaxObjectNum * sizeof(FObjectInfoGPUData);
 		FRHIStructuredBuffer* BufferRHI = ObjectInfoBuffer.Buffer;
@@ -640,26 +1039,10 @@ void FRealtimeGIGPUScene::PrepareRenderResources(FRDGBuilder& GraphBuilder, FSce
 		RHICmdList.UnlockStructuredBuffer(BufferRHI);
 	}
 
-	if (ObjectInfoUploadBuffer.NumBytes == 0)
-	{
-		ObjectInfoUploadBuffer.Initialize(
-			sizeof(FObjectInfoGPUData) * MaxObjectNum,
-			BUF_Dynamic,
-			TEXT("ObjectInfoUploadBuffer")
-		);
-	}
-
-	if (RemovedObjectIdBuffer.NumBytes == 0)
-	{
-		RemovedObjectIdBuffer.Initialize(
-			sizeof(int32) * MaxObjectNum,
-			BUF_Dynamic,
-			TEXT("RemovedObjectIdBuffer")
-		);
-	}
-
-	if (CardInfoBuffer.NumBytes == 0)
+	if (NeedResize(CardInfoBuffer.NumBytes, sizeof(FCardInfoGPUData) * MaxSurfaceCacheNum * MAX_CARDS_PER_MESH))
 	{
+		SurfaceCacheInfoBufferResized |= CardInfoBuffer.NumBytes > 0;
+		CardInfoBuffer.Release();
 		CardInfoBuffer.Initialize(
 			sizeof(FCardInfoGPUData), MaxSurfaceCacheNum * MAX_CARDS_PER_MESH,
 			BUF_Static,
@@ -667,17 +1050,9 @@ void FRealtimeGIGPUScene::PrepareRenderResources(FRDGBuilder& GraphBuilder, FSce
 		);
 	}
 
-	if (CardInfoUploadBuffer.NumBytes == 0)
-	{
-		CardInfoUploadBuffer.Initialize(
-			sizeof(FCardInfoGPUData) * MaxSurfaceCacheNum * MAX_CARDS_PER_MESH,
-			BUF_Dynamic,
-			TEXT("CardInfoUploadBuffer")
-		);
-	}
-
-	if (CardClearQuadUVTransformBuffer.NumBytes == 0)
+	if (NeedResize(CardClearQuadUVTransformBuffer.NumBytes, sizeof(FVector4) * MaxSurfaceCacheNum * MAX_CARDS_PER_MESH))
 	{
+		CardClearQuadUVTransformBuffer.Release();
 		CardClearQuadUVTransformBuffer.Initialize(
 			sizeof(FVector4) * MaxSurfaceCacheNum * MAX_CARDS_PER_MESH,
 			BUF_Dynamic,
@@ -685,8 +1060,10 @@ void FRealtimeGIGPUScene::PrepareRenderResources(FRDGBuilder& GraphBuilder, FSce
 		);
 	}
 
-	if (SurfaceCacheInfoBuffer.NumBytes == 0)
+	if (NeedResize(SurfaceCacheInfoBuffer.NumBytes, sizeof(FSurfaceCacheInfoGPUData) * MaxSurfaceCacheNum))
 	{
+		SurfaceCacheInfoBufferResized |= SurfaceCacheInfoBuffer.NumBytes > 0;
+		SurfaceCacheInfoBuffer.Release();
 		SurfaceCacheInfoBuffer.Initialize(
 			sizeof(FSurfaceCacheInfoGPUData), MaxSurfaceCacheNum,
 			BUF_Static,
@@ -694,28 +1071,29 @@ void FRealtimeGIGPUScene::PrepareRenderResources(FRDGBuilder& GraphBuilder, FSce
 		);
 	}
 
-	if (SurfaceCacheInfoUploadBuffer.NumBytes == 0)
-	{
-		SurfaceCacheInfoUploadBuffer.Initialize(
-			sizeof(FSurfaceCacheInfoGPUData) * MaxSurfaceCacheNum,
-			BUF_Dynamic,
-			TEXT("SurfaceCacheInfoUploadBuffer")
-		);
-	}
-
-	ObjectInfoCounter = GraphBuilder.CreateBuffer(
-		FRDGBufferDesc::CreateStructuredDesc(sizeof(int32), 1),
-		TEXT("ObjectInfoCounter")
-	);
-
-	if (MiniObjectInfoBuffer.NumBytes == 0)
+	if (NeedResize(MiniObjectInfoBuffer.NumBytes, sizeof(FMiniObjectInfoGPUData) * MaxObjectNum))
 	{
+		CompactObjectIds.MarkAllDirty();
+		MiniObjectInfoBuffer.Release();
 		MiniObjectInfoBuffer.Initialize(
 			sizeof(FMiniObjectInfoGPUData), MaxObjectNum,
 			BUF_Static,
 			TEXT("MiniObjectInfoBuffer")
 		);
 	}
+
+	// old data is lost with the old buffer, upload all living objects again
+	if (ObjectInfoBufferResized)
+	{
+		CompactObjectIds.MarkAllDirty();
+		for (int32 ObjectId : ObjectIdAllocator.GetAllocatedElements())
+		{
+			if (!ObjectAddCommands.Contains(ObjectId))
+			{
+				ObjectUpdateCommands.Add(ObjectId);
+			}
+		}
+	}
 	
 	SurfaceCacheAtlasNeedClear = false;
 	FIntPoint RTResolution = FIntPoint(SurfaceCacheAtlasResolution, SurfaceCacheAtlasResolution);
@@ -730,34 +1108,27 @@ void FRealtimeGIGPUScene::PrepareRenderResources(FRDGBuilder& GraphBuilder, FSce
 
 void FRealtimeGIGPUScene::SyncObjectInfosToGPU(FRDGBuilder& GraphBuilder, FScene* Scene)
 {
-	FRHICommandListImmediate& RHICmdList = GraphBuilder.RHICmdList;
-	const int32 MaxObjectNum = CVarRealtimeGIMaxObjectNum.GetValueOnRenderThread();
 	const int32 NumUpdateObjects = ObjectUpdateCommands.Num() + ObjectAddCommands.Num();
 	const int32 NumRemovedObjects = ObjectRemoveCommands.Num();
 
-	// 1. copy removed object id to gpu
-#if !ALLOW_EMPTY_DISPATCH_FOR_DEBUG
-	if(NumRemovedObjects > 0)
-#endif
-	{
-		FRHIStructuredBuffer* BufferRHI = RemovedObjectIdBuffer.Buffer;
-		int32 NumBytes = NumRemovedObjects * sizeof(int32);
-		TArray<int32> ObjectsToRemove = ObjectRemoveCommands.Array();
-
-		void* MappedRawData = RHICmdList.LockStructuredBuffer(BufferRHI, 0, NumBytes, RLM_WriteOnly);
-		FMemory::Memcpy(MappedRawData, ObjectsToRemove.GetData(), NumBytes);
-		RHICmdList.UnlockStructuredBuffer(BufferRHI);
-	}
-
-	// 2. remove and clear object infos in GPU
+	// 1. remove and clear object infos in GPU, keep compact array dense
+	// remove before add, a released id may be allocated again in same frame
 #if !ALLOW_EMPTY_DISPATCH_FOR_DEBUG
 	if (NumRemovedObjects > 0)
 #endif
 	{
+		FRealtimeGIUploadBuffer RemovedObjectIdUpload(sizeof(int32), TEXT("RemovedObjectIdBuffer"));
+		int32* UploadData = (int32*)RemovedObjectIdUpload.Begin(GraphBuilder, NumRemovedObjects);
+		for (const int32& ObjectId : ObjectRemoveCommands)
+		{
+			*UploadData++ = ObjectId;
+			CompactObjectIds.Remove(ObjectId);
+		}
+
 		TShaderMapRef<FObjectInfoRemoveCS> ComputeShader(GetGlobalShaderMap(Scene->GetFeatureLevel()));
 		auto* PassParameters = GraphBuilder.AllocParameters<FObjectInfoRemoveCS::FParameters>();
 		PassParameters->NumRemovedObjects = NumRemovedObjects;
-		PassParameters->RemovedObjectIdBuffer = RemovedObjectIdBuffer.SRV;
+		PassParameters->RemovedObjectIdBuffer = RemovedObjectIdUpload.End(GraphBuilder);
 		PassParameters->RWObjectInfoBuffer = ObjectInfoBuffer.UAV;
 
 		int32 NumGroups = FMath::CeilToInt(float(NumRemovedObjects) / float(FObjectInfoRemoveCS::ThreadGroupSizeX));
@@ -766,39 +1137,28 @@ void FRealtimeGIGPUScene::SyncObjectInfosToGPU(FRDGBuilder& GraphBuilder, FScene
 			ComputeShader, PassParameters, FIntVector(NumGroups, 1, 1));
 	}
 
-	// 3. copy object infos need to update & add to gpu
+	// 2. update new & modified object infos to GPU, records are written into the upload buffer directly
 #if !ALLOW_EMPTY_DISPATCH_FOR_DEBUG
 	if (NumUpdateObjects > 0)
 #endif
 	{
-		TArray<FObjectInfoGPUData> UpdateObjectInfos;
-
+		FRealtimeGIUploadBuffer ObjectInfoUpload(sizeof(FObjectInfoGPUData), TEXT("ObjectInfoUploadBuffer"));
+		FObjectInfoGPUData* UploadData = (FObjectInfoGPUData*)ObjectInfoUpload.Begin(GraphBuilder, NumUpdateObjects);
 		for (const int32& ObjectId : ObjectUpdateCommands)
 		{
-			UpdateObjectInfos.Add(FObjectInfoGPUData(ObjectInfos[ObjectId]));
+			*UploadData++ = FObjectInfoGPUData(ObjectInfos[ObjectId]);
+			CompactObjectIds.MarkDirty(ObjectId);
 		}
 		for (const int32& ObjectId : ObjectAddCommands)
 		{
-			UpdateObjectInfos.Add(FObjectInfoGPUData(ObjectInfos[ObjectId]));
+			*UploadData++ = FObjectInfoGPUData(ObjectInfos[ObjectId]);
+			CompactObjectIds.Add(ObjectId);
 		}
 
-		FRHIStructuredBuffer* BufferRHI = ObjectInfoUploadBuffer.Buffer;
-		int32 NumBytes = NumUpdateObjects * sizeof(FObjectInfoGPUData);
-
-		void* MappedRawData = RHICmdList.LockStructuredBuffer(BufferRHI, 0, NumBytes, RLM_WriteOnly);
-		FMemory::Memcpy(MappedRawData, UpdateObjectInfos.GetData(), NumBytes);
-		RHICmdList.UnlockStructuredBuffer(BufferRHI);
-	}
-
-	// 4. update new & modified object infos to GPU
-#if !ALLOW_EMPTY_DISPATCH_FOR_DEBUG
-	if (NumUpdateObjects > 0)
-#endif
-	{
 		TShaderMapRef<FObjectInfoUpdateCS> ComputeShader(GetGlobalShaderMap(Scene->GetFeatureLevel()));
 		auto* PassParameters = GraphBuilder.AllocParameters<FObjectInfoUpdateCS::FParameters>();
 		PassParameters->NumUpdateObjects = NumUpdateObjects;
-		PassParameters->ObjectInfoUploadBuffer = ObjectInfoUploadBuffer.SRV;
+		PassParameters->ObjectInfoUploadBuffer = ObjectInfoUpload.End(GraphBuilder);
 		PassParameters->RWObjectInfoBuffer = ObjectInfoBuffer.UAV;
 
 		const int32 NumGroups = FMath::CeilToInt(float(NumUpdateObjects) / float(FObjectInfoUpdateCS::ThreadGroupSizeX));
@@ -807,21 +1167,32 @@ void FRealtimeGIGPUScene::SyncObjectInfosToGPU(FRDGBuilder& GraphBuilder, FScene
 			ComputeShader, PassParameters, FIntVector(NumGroups, 1, 1));
 	}
 
-	// 5. shrink and compact the array
-	// [_, B, _, C, A, _, D, _, E] --> [B, C, A, D, E]
+	// 3. keep the compact array for culling, only changed slots are written
+	// [A, B, C, D] remove B, move D --> [A, D, C], write slot 1
+	TArray<int32> DirtyCompactIndices;
+	CompactObjectIds.PopDirtyIndices(DirtyCompactIndices);
+	check(CompactObjectIds.Num() == GetObjectNum());
+
+	const int32 NumCompactUpdates = DirtyCompactIndices.Num();
 #if !ALLOW_EMPTY_DISPATCH_FOR_DEBUG
-	if (NumRemovedObjects > 0 || NumUpdateObjects > 0)
+	if (NumCompactUpdates > 0)
 #endif
 	{
-		ClearCounterBuffer(GraphBuilder, Scene, ObjectInfoCounter, 1);
+		FRealtimeGIUploadBuffer CompactUpdateUpload(sizeof(FIntPoint), TEXT("CompactUpdateUploadBuffer"));
+		FIntPoint* UploadData = (FIntPoint*)CompactUpdateUpload.Begin(GraphBuilder, NumCompactUpdates);
+		for (int32 CompactIndex : DirtyCompactIndices)
+		{
+			*UploadData++ = FIntPoint(CompactIndex, CompactObjectIds.GetId(CompactIndex));
+		}
 
 		TShaderMapRef<FObjectInfoCompactCS> ComputeShader(GetGlobalShaderMap(Scene->GetFeatureLevel()));
 		FObjectInfoCompactCS::FParameters* PassParameters = GraphBuilder.AllocParameters<FObjectInfoCompactCS::FParameters>();
+		PassParameters->NumCompactUpdates = NumCompactUpdates;
+		PassParameters->CompactUpdateUploadBuffer = CompactUpdateUpload.End(GraphBuilder);
 		PassParameters->ObjectInfoBuffer = ObjectInfoBuffer.SRV;
 		PassParameters->RWMiniObjectInfoBuffer = MiniObjectInfoBuffer.UAV;
-		PassParameters->RWObjectInfoCounter = GraphBuilder.CreateUAV(ObjectInfoCounter);
 
-		const int32 NumGroups = FMath::CeilToInt(float(MaxObjectNum) / float(FObjectInfoCompactCS::ThreadGroupSizeX));
+		const int32 NumGroups = FMath::CeilToInt(float(NumCompactUpdates) / float(FObjectInfoCompactCS::ThreadGroupSizeX));
 		FComputeShaderUtils::AddPass(
 			GraphBuilder, RDG_EVENT_NAME("ObjectInfoCompact"),
 			ComputeShader, PassParameters, FIntVector(NumGroups, 1, 1));
@@ -831,71 +1202,60 @@ void FRealtimeGIGPUScene::SyncObjectInfosToGPU(FRDGBuilder& GraphBuilder, FScene
 void FRealtimeGIGPUScene::SyncSurfaceCacheInfosToGPU(FRDGBuilder& GraphBuilder, FScene* Scene)
 {
 	FRHICommandListImmediate& RHICmdList = GraphBuilder.RHICmdList;
-	const int32 SurfaceCacheNum = SurfaceCacheCaptureCommands.Num();
 
-	// 1. fill data: surface cache info
-	TArray<FSurfaceCacheInfoGPUData> SurfaceCacheInfoUploadData;
-	for (const int32& SurfaceCacheId : SurfaceCacheCaptureCommands)
+	// if buffer is re-created, upload all living surface caches again
+	TArray<int32> SurfaceCacheIdsToUpload;
+	if (SurfaceCacheInfoBufferResized)
 	{
-		const FSurfaceCacheInfo& SurfaceCacheInfo = SurfaceCacheInfos[SurfaceCacheId];
-		SurfaceCacheInfoUploadData.Add(FSurfaceCacheInfoGPUData(SurfaceCacheInfo));
+		SurfaceCacheIdsToUpload = SurfaceCacheAllocator.GetAllocatedElements();
 	}
-
-	// 2. upload surface cache info
-#if !ALLOW_EMPTY_DISPATCH_FOR_DEBUG
-	if (SurfaceCacheNum > 0)
-#endif
+	else
 	{
-		FRHIStructuredBuffer* BufferRHI = SurfaceCacheInfoUploadBuffer.Buffer;
-		int32 NumBytes = SurfaceCacheNum * sizeof(FSurfaceCacheInfoGPUData);
-
-		void* MappedRawData = RHICmdList.LockStructuredBuffer(BufferRHI, 0, NumBytes, RLM_WriteOnly);
-		FMemory::Memcpy(MappedRawData, SurfaceCacheInfoUploadData.GetData(), NumBytes);
-		RHICmdList.UnlockStructuredBuffer(BufferRHI);
-	}
-
-	// 3. fill data: mesh card data for each surface cache
-	int32 UploadDataOffset = 0;
-	TArray<FCardInfoGPUData> CardInfoUploadData;
-	CardInfoUploadData.SetNum(SurfaceCacheNum * MAX_CARDS_PER_MESH);
-
-	for (const int32& SurfaceCacheId : SurfaceCacheCaptureCommands)
-	{
-		const FSurfaceCacheInfo& SurfaceCacheInfo = SurfaceCacheInfos[SurfaceCacheId];
-		
-		for (int32 CardIndex = 0; CardIndex < SurfaceCacheInfo.NumMeshCards; CardIndex++)
+		SurfaceCacheIdsToUpload.Reserve(SurfaceCacheCaptureCommands.Num() + SurfaceCacheUpdateCommands.Num());
+		for (const int32& SurfaceCacheId : SurfaceCacheCaptureCommands)
 		{
-			FCardInfoGPUData& CardInfo = CardInfoUploadData[UploadDataOffset + CardIndex];
-			CardInfo.LocalToCardMatrix = SurfaceCacheInfo.LocalToCardMatrixs[CardIndex];
-			CardInfo.CardUVTransform = SurfaceCacheInfo.CardUVTransforms[CardIndex];
+			SurfaceCacheIdsToUpload.Add(SurfaceCacheId);
+		}
+		for (const int32& SurfaceCacheId : SurfaceCacheUpdateCommands)
+		{
+			if (!SurfaceCacheCaptureCommands.Contains(SurfaceCacheId))
+			{
+				SurfaceCacheIdsToUpload.Add(SurfaceCacheId);
+			}
 		}
-
-		UploadDataOffset += MAX_CARDS_PER_MESH;
 	}
+	const int32 SurfaceCacheNum = SurfaceCacheIdsToUpload.Num();
 
-	// 4. upload mesh card info
+	// 1. upload surface cache info and mesh card data for each surface cache, then copy to RW buffer
 #if !ALLOW_EMPTY_DISPATCH_FOR_DEBUG
 	if (SurfaceCacheNum > 0)
 #endif
 	{
-		FRHIStructuredBuffer* BufferRHI = CardInfoUploadBuffer.Buffer;
-		int32 NumBytes = SurfaceCacheNum * sizeof(FCardInfoGPUData) * MAX_CARDS_PER_MESH;
+		FRealtimeGIUploadBuffer SurfaceCacheInfoUpload(sizeof(FSurfaceCacheInfoGPUData), TEXT("SurfaceCacheInfoUploadBuffer"));
+		FRealtimeGIUploadBuffer CardInfoUpload(sizeof(FCardInfoGPUData), TEXT("CardInfoUploadBuffer"));
+		FSurfaceCacheInfoGPUData* SurfaceCacheInfoData = (FSurfaceCacheInfoGPUData*)SurfaceCacheInfoUpload.Begin(GraphBuilder, SurfaceCacheNum);
+		FCardInfoGPUData* CardInfoData = (FCardInfoGPUData*)CardInfoUpload.Begin(GraphBuilder, SurfaceCacheNum * MAX_CARDS_PER_MESH);
 
-		void* MappedRawData = RHICmdList.LockStructuredBuffer(BufferRHI, 0, NumBytes, RLM_WriteOnly);
-		FMemory::Memcpy(MappedRawData, CardInfoUploadData.GetData(), NumBytes);
-		RHICmdList.UnlockStructuredBuffer(BufferRHI);
-	}
+		for (const int32& SurfaceCacheId : SurfaceCacheIdsToUpload)
+		{
+			const FSurfaceCacheInfo& SurfaceCacheInfo = SurfaceCacheInfos[SurfaceCacheId];
+			*SurfaceCacheInfoData++ = FSurfaceCacheInfoGPUData(SurfaceCacheInfo);
+
+			const int32 NumResidentCards = SurfaceCacheInfo.IsResident() ? SurfaceCacheInfo.NumMeshCards : 0;
+			for (int32 CardIndex = 0; CardIndex < MAX_CARDS_PER_MESH; CardIndex++)
+			{
+				FCardInfoGPUData& CardInfo = CardInfoData[CardIndex];
+				CardInfo.LocalToCardMatrix = CardIndex < NumResidentCards ? SurfaceCacheInfo.LocalToCardMatrixs[CardIndex] : FMatrix::Identity;
+				CardInfo.CardUVTransform = CardIndex < NumResidentCards ? SurfaceCacheInfo.CardUVTransforms[CardIndex] : FVector4(0, 0, 0, 0);
+			}
+			CardInfoData += MAX_CARDS_PER_MESH;
+		}
 
-	// 5. copy data from transient buffer to RW buffer
-#if !ALLOW_EMPTY_DISPATCH_FOR_DEBUG
-	if (SurfaceCacheNum > 0)
-#endif
-	{
 		TShaderMapRef<FSurfaceCacheInfoUpdateCS> ComputeShader(GetGlobalShaderMap(Scene->GetFeatureLevel()));
 		FSurfaceCacheInfoUpdateCS::FParameters* PassParameters = GraphBuilder.AllocParameters<FSurfaceCacheInfoUpdateCS::FParameters>();
 		PassParameters->SurfaceCacheNum = SurfaceCacheNum;
-		PassParameters->SurfaceCacheInfoUploadBuffer = SurfaceCacheInfoUploadBuffer.SRV;
-		PassParameters->CardInfoUploadBuffer = CardInfoUploadBuffer.SRV;
+		PassParameters->SurfaceCacheInfoUploadBuffer = SurfaceCacheInfoUpload.End(GraphBuilder);
+		PassParameters->CardInfoUploadBuffer = CardInfoUpload.End(GraphBuilder);
 		PassParameters->RWSurfaceCacheInfoBuffer = SurfaceCacheInfoBuffer.UAV;
 		PassParameters->RWCardInfoBuffer = CardInfoBuffer.UAV;
 
@@ -905,7 +1265,7 @@ void FRealtimeGIGPUScene::SyncSurfaceCacheInfosToGPU(FRDGBuilder& GraphBuilder,
 			ComputeShader, PassParameters, FIntVector(NumGroups, 1, 1));
 	}
 
-	// 6. upload card clear list
+	// 2. upload card clear list
 	// note: we don't use indirect draw cause [newly added object's data] will override [removed object's data] in SurfaceCacheInfoBuffer
 #if !ALLOW_EMPTY_DISPATCH_FOR_DEBUG
 	if (SurfaceCacheClearCommands.Num() > 0)
@@ -925,15 +1285,16 @@ FVector4 FRealtimeGIGPUScene::CalcViewportInfo(const FSurfaceCacheInfo& SurfaceC
 	FVector4 CardSizeAndOffset = SurfaceCacheInfo.CardUVTransforms[CardIndex];
 	FVector4 UVTransform = CardSizeAndOffset / float(SurfaceCacheAtlasResolution);
 
-	float PaddingScale = (float(SurfaceCacheInfo.MeshCardResolution) - 1.0) / float(SurfaceCacheInfo.MeshCardResolution);	// padding 1 texel
+	float PaddingScaleX = (CardSizeAndOffset.X - 1.0) / CardSizeAndOffset.X;	// padding 1 texel
+	float PaddingScaleY = (CardSizeAndOffset.Y - 1.0) / CardSizeAndOffset.Y;
 	
 	// viewport center is (0, 0) but uv center is (0.5, 0.5)
 	float OffsetX = 0.5 * UVTransform.X;
 	float OffsetY = 0.5 * UVTransform.Y;
 
 	FVector4 Result = FVector4(
-		UVTransform.X * PaddingScale,
-		UVTransform.Y * PaddingScale,
+		UVTransform.X * PaddingScaleX,
+		UVTransform.Y * PaddingScaleY,
 		(UVTransform.Z + OffsetX) * 2.0 - 1.0,	// using this offset in clip space [-1, 1]
 		(UVTransform.W + OffsetY) * 2.0 - 1.0
 	);
@@ -950,23 +1311,41 @@ FVector4 FRealtimeGIGPUScene::CalcViewportInfo(const FSurfaceCacheInfo& SurfaceC
 
 }
 
-void FRealtimeGIGPUScene::ReferenceSurfaceCache(FObjectInfo& ObjectInfo)
+TArray<FSurfaceCacheKey> FRealtimeGIGPUScene::BuildSurfaceCacheKeys(const TArray<int32>& ObjectIds)
+{
+	// gather mesh batches and hash pointers, only read primitive so run in parallel
+	TArray<FSurfaceCacheKey> Result;
+	Result.SetNum(ObjectIds.Num());
+	ParallelFor(ObjectIds.Num(), [&](int32 i)
+	{
+		Result[i] = FSurfaceCacheKey(ObjectInfos[ObjectIds[i]].Primitive);
+	});
+
+	return Result;
+}
+
+void FRealtimeGIGPUScene::ReferenceSurfaceCache(FObjectInfo& ObjectInfo, const FSurfaceCacheKey& SurfaceCacheKey)
 {
-	FSurfaceCacheKey SurfaceCacheKey = FSurfaceCacheKey(ObjectInfo.Primitive);
 	int32 SurfaceCacheId = OBJECT_ID_INVALID;
 
 	// if not exist we allocate it
 	if (!SurfaceCacheAllocator.Find(SurfaceCacheKey, SurfaceCacheId))
 	{
 		SurfaceCacheId = SurfaceCacheAllocator.AllocateElement(SurfaceCacheKey);
+		if (SurfaceCacheId >= SurfaceCacheInfos.Num())
+		{
+			SurfaceCacheInfos.SetNum(SurfaceCacheAllocator.GetMaxNumElements());
+		}
+
 		SurfaceCacheInfos[SurfaceCacheId] = FSurfaceCacheInfo(SurfaceCacheId);
 
-		// build capture command 
-		SurfaceCacheCaptureCommands.Add(SurfaceCacheId);
+		// queue capture request
+		RequestSurfaceCacheCapture(SurfaceCacheId);
 	}
 
 	// same object will not ref twice, cause we use TSet in FSurfaceCacheInfo
 	SurfaceCacheInfos[SurfaceCacheId].AddObjectReference(ObjectInfo);
+	SurfaceCacheInfos[SurfaceCacheId].LastUsedFrame = GFrameNumberRenderThread;
 
 	// if surface cache change, release old item
 	if (ObjectInfo.SurfaceCacheKey != SurfaceCacheKey && ObjectInfo.SurfaceCacheId != OBJECT_ID_INVALID)
@@ -989,6 +1368,7 @@ void FRealtimeGIGPUScene::DeReferenceSurfaceCache(FObjectInfo& ObjectInfo)
 	{
 		SurfaceCacheAllocator.ReleaseElement(ObjectInfo.SurfaceCacheKey);
 		ReleaseSurfaceCacheTextureSpace(ObjectInfo.SurfaceCacheId);
+		PendingSurfaceCacheCaptures.Remove(ObjectInfo.SurfaceCacheId);
 		SurfaceCacheInfo.Empty();
 	}
 
@@ -997,7 +1377,7 @@ void FRealtimeGIGPUScene::DeReferenceSurfaceCache(FObjectInfo& ObjectInfo)
 	ObjectInfo.SurfaceCacheId = OBJECT_ID_INVALID;
 }
 
-void FRealtimeGIGPUScene::AllocateSurfaceCacheTextureSpace(const int32& SurfaceCacheId)
+bool FRealtimeGIGPUScene::AllocateSurfaceCacheTextureSpace(const int32& SurfaceCacheId)
 {
 	FSurfaceCacheInfo& SurfaceCacheInfo = SurfaceCacheInfos[SurfaceCacheId];
 
@@ -1007,12 +1387,62 @@ void FRealtimeGIGPUScene::AllocateSurfaceCacheTextureSpace(const int32& SurfaceC
 		SurfaceCacheInfo.MeshCardResolution = CVarRealtimeGIMeshCardDefaultResolution.GetValueOnRenderThread();
 	}
 
+	if (TryAllocateCardTiles(SurfaceCacheId))
+	{
+		return true;
+	}
+
+	// atlas is full, evict surface caches far from views until there is enough space
+	while (EvictLeastRecentlyUsedSurfaceCache(SurfaceCacheId))
+	{
+		if (TryAllocateCardTiles(SurfaceCacheId))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool FRealtimeGIGPUScene::TryAllocateCardTiles(const int32& SurfaceCacheId)
+{
+	FSurfaceCacheInfo& SurfaceCacheInfo = SurfaceCacheInfos[SurfaceCacheId];
+	check(SurfaceCacheInfo.CardUVTransforms.Num() == 0);
+
+	// all cards of a mesh share the same texel density, MeshCardResolution texels cover the longest side of local bounds
+	const FVector LocalBoundsSize = SurfaceCacheInfo.Primitive->Proxy->GetLocalBounds().GetBox().GetSize();
+	const float MaxExtent = FMath::Max(LocalBoundsSize.GetMax(), KINDA_SMALL_NUMBER);
+	const int32 Resolution = SurfaceCacheInfo.MeshCardResolution;
+
 	for (int32 CardIndex = 0; CardIndex < SurfaceCacheInfo.NumMeshCards; CardIndex++)
 	{
-		FStupidQuadTreeNode Node = SurfaceCacheAtlasAllocator.AllocateElement(SurfaceCacheInfo.MeshCardResolution);
-		FVector4 CardSizeAndOffset = FVector4(Node.Size, Node.Size, Node.Min.X, Node.Min.Y);
+		const FVector2D CardExtent = SurfaceCacheInfo.CardExtents[CardIndex];
+		FIntPoint TileSize;
+		TileSize.X = FMath::Clamp(FMath::CeilToInt(Resolution * CardExtent.X / MaxExtent), 1, Resolution);
+		TileSize.Y = FMath::Clamp(FMath::CeilToInt(Resolution * CardExtent.Y / MaxExtent), 1, Resolution);
+
+		const int32 Owner = SurfaceCacheId * MAX_CARDS_PER_MESH + CardIndex;
+		FGIAtlasTile Tile = SurfaceCacheAtlasAllocator.AllocateElement(TileSize, Owner);
+
+		// all or nothing, give back the cards already allocated
+		if (!Tile.IsValid())
+		{
+			for (const FVector4& CardSizeAndOffset : SurfaceCacheInfo.CardUVTransforms)
+			{
+				FGIAtlasTile FreeTile;
+				FreeTile.Size = FIntPoint(CardSizeAndOffset.X, CardSizeAndOffset.Y);
+				FreeTile.Min = FIntPoint(CardSizeAndOffset.Z, CardSizeAndOffset.W);
+				SurfaceCacheAtlasAllocator.ReleaseElement(FreeTile);
+			}
+			SurfaceCacheInfo.CardUVTransforms.Empty();
+			return false;
+		}
+
+		FVector4 CardSizeAndOffset = FVector4(Tile.Size.X, Tile.Size.Y, Tile.Min.X, Tile.Min.Y);
 		SurfaceCacheInfo.CardUVTransforms.Add(CardSizeAndOffset);
 	}
+
+	return true;
 }
 
 void FRealtimeGIGPUScene::ReleaseSurfaceCacheTextureSpace(const int32& SurfaceCacheId)
@@ -1023,24 +1453,87 @@ void FRealtimeGIGPUScene::ReleaseSurfaceCacheTextureSpace(const int32& SurfaceCa
 		return;
 	}
 
-	for (int32 CardIndex = 0; CardIndex < SurfaceCacheInfo.NumMeshCards; CardIndex++)
+	for (const FVector4& CardSizeAndOffset : SurfaceCacheInfo.CardUVTransforms)
 	{
-		FVector4 CardSizeAndOffset = SurfaceCacheInfo.CardUVTransforms[CardIndex];
 		SurfaceCacheClearCommands.Add(CardSizeAndOffset);
 
-		FStupidQuadTreeNode FreeNode;
-		FreeNode.Size = CardSizeAndOffset.X;	// x == y always
-		FreeNode.Min = FIntPoint(CardSizeAndOffset.Z, CardSizeAndOffset.W);
-		FreeNode.Max = FreeNode.Min + FIntPoint(CardSizeAndOffset.X, CardSizeAndOffset.Y);
-		FreeNode.Center = (FreeNode.Max + FreeNode.Min) / 2;
+		FGIAtlasTile FreeTile;
+		FreeTile.Size = FIntPoint(CardSizeAndOffset.X, CardSizeAndOffset.Y);
+		FreeTile.Min = FIntPoint(CardSizeAndOffset.Z, CardSizeAndOffset.W);
 
-		SurfaceCacheAtlasAllocator.ReleaseElement(FreeNode);
+		SurfaceCacheAtlasAllocator.ReleaseElement(FreeTile);
 	}
 
 	SurfaceCacheInfo.MeshCardResolution = 0;
 	SurfaceCacheInfo.CardUVTransforms.Empty();
 }
 
+bool FRealtimeGIGPUScene::IsSurfaceCacheInRange(const int32& SurfaceCacheId)
+{
+	FSurfaceCacheInfo& SurfaceCacheInfo = SurfaceCacheInfos[SurfaceCacheId];
+	const float EvictDistance = CVarRealtimeGISurfaceCacheEvictDistance.GetValueOnRenderThread();
+
+	for (int32 ObjectId : SurfaceCacheInfo.GetReferenceHolders())
+	{
+		const FBoxSphereBounds& WorldBound = ObjectInfos[ObjectId].Primitive->Proxy->GetBounds();
+		for (const FVector& ViewOrigin : ViewOrigins)
+		{
+			if (FVector::Dist(ViewOrigin, WorldBound.Origin) - WorldBound.SphereRadius < EvictDistance)
+			{
+				SurfaceCacheInfo.LastUsedFrame = GFrameNumberRenderThread;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+bool FRealtimeGIGPUScene::EvictLeastRecentlyUsedSurfaceCache(const int32& RequestSurfaceCacheId)
+{
+	// build candidates once per frame, the most recently used is at the end
+	if (!SurfaceCacheEvictionCandidatesBuilt)
+	{
+		SurfaceCacheEvictionCandidatesBuilt = true;
+		SurfaceCacheEvictionCandidates.Reset();
+
+		for (int32 SurfaceCacheId : SurfaceCacheAllocator.GetAllocatedElements())
+		{
+			if (SurfaceCacheInfos[SurfaceCacheId].IsResident() && !IsSurfaceCacheInRange(SurfaceCacheId))
+			{
+				SurfaceCacheEvictionCandidates.Add(SurfaceCacheId);
+			}
+		}
+
+		SurfaceCacheEvictionCandidates.Sort([this](const int32& A, const int32& B)
+		{
+			return SurfaceCacheInfos[A].LastUsedFrame > SurfaceCacheInfos[B].LastUsedFrame;
+		});
+	}
+
+	while (SurfaceCacheEvictionCandidates.Num() > 0)
+	{
+		const int32 SurfaceCacheId = SurfaceCacheEvictionCandidates.Pop(false);
+
+		// may be released or captured after candidates built
+		if (SurfaceCacheId == RequestSurfaceCacheId ||
+			!SurfaceCacheInfos[SurfaceCacheId].IsResident() ||
+			SurfaceCacheCaptureCommands.Contains(SurfaceCacheId))
+		{
+			continue;
+		}
+
+		// keep MeshCardResolution, re-capture with same size when back in range
+		const int32 MeshCardResolution = SurfaceCacheInfos[SurfaceCacheId].MeshCardResolution;
+		ReleaseSurfaceCacheTextureSpace(SurfaceCacheId);
+		SurfaceCacheInfos[SurfaceCacheId].MeshCardResolution = MeshCardResolution;
+		SurfaceCacheUpdateCommands.Add(SurfaceCacheId);
+		return true;
+	}
+
+	return false;
+}
+
 void FRealtimeGIGPUScene::GatherCardCaptureMeshElements(const int32& SurfaceCacheId)
 {
 	FSurfaceCacheInfo& SurfaceCacheInfo = SurfaceCacheInfos[SurfaceCacheId];
@@ -1051,20 +1544,38 @@ void FRealtimeGIGPUScene::GatherCardCaptureMeshElements(const int32& SurfaceCach
 	SurfaceCacheInfo.Primitive = ObjectInfo.Primitive;
 
 	// 1. setup mesh card placement and capture matrix
-	// @TODO: precomputed card placement
-	SurfaceCacheInfo.NumMeshCards = CubeFace_MAX;
-
 	const FBox& LocalBounds = SurfaceCacheInfo.Primitive->Proxy->GetLocalBounds().GetBox();
 	FVector LocalBoundsCenter = (LocalBounds.Max + LocalBounds.Min) * 0.5;
 	FVector LocalBoundsSize = LocalBounds.GetExtent() * 2.0;
 	LocalBoundsSize *= (1.0 + 1e-3);	// a little padding
+	const float Depth = LocalBoundsSize.GetMax();
 
 	SurfaceCacheInfo.LocalToCardMatrixs.Empty();
-	for (int32 CardIndex = 0; CardIndex < SurfaceCacheInfo.NumMeshCards; CardIndex++)
+	SurfaceCacheInfo.CardExtents.Empty();
+	auto AddMeshCard = [&](const FVector& CardCenter, const FVector& CardSize, ECubeFace Face)
+	{
+		SurfaceCacheInfo.LocalToCardMatrixs.Add(CalcCardCaptureViewProjectionMatrix(CardCenter, CardSize, Depth, Face));
+		SurfaceCacheInfo.CardExtents.Add(CalcCardCaptureExtent(CardSize, Face));
+	};
+
+	// cards fitted to surface clusters when building static mesh, fall back to 6 cards over local bounds
+	const FRealtimeGIMeshCardsData* MeshCards = GetPrecomputedMeshCards(SurfaceCacheInfo.Primitive->Proxy);
+	if (MeshCards)
+	{
+		for (const FRealtimeGIMeshCard& Card : MeshCards->Cards)
+		{
+			AddMeshCard(Card.Center, Card.Size * (1.0 + 1e-3), (ECubeFace)Card.Face);
+		}
+	}
+	else
 	{
-		FMatrix LocalToCard = CalcCardCaptureViewProjectionMatrix(LocalBoundsCenter, LocalBoundsSize, (ECubeFace)CardIndex);
-		SurfaceCacheInfo.LocalToCardMatrixs.Add(LocalToCard);
+		for (int32 CardIndex = 0; CardIndex < CubeFace_MAX; CardIndex++)
+		{
+			AddMeshCard(LocalBoundsCenter, LocalBoundsSize, (ECubeFace)CardIndex);
+		}
 	}
+	SurfaceCacheInfo.NumMeshCards = SurfaceCacheInfo.LocalToCardMatrixs.Num();
+	check(SurfaceCacheInfo.NumMeshCards <= MAX_CARDS_PER_MESH);
 
 	// 2. gather card capture mesh elements
 	SurfaceCacheInfo.CardCaptureMeshBatches.Empty();
@@ -1084,13 +1595,20 @@ void FRealtimeGIGPUScene::GatherCardCaptureMeshElements(const int32& SurfaceCach
 	}
 }
 
-void FRealtimeGIGPUScene::AdjustSurfaceCacheResolution(const int32& SurfaceCacheId)
+int32 FRealtimeGIGPUScene::CalcSurfaceCacheResolution(const int32& SurfaceCacheId)
 {
 	FSurfaceCacheInfo& SurfaceCacheInfo = SurfaceCacheInfos[SurfaceCacheId];
 	TArray<int32> ObjectIds = SurfaceCacheInfo.GetReferenceHolders();
 
-	const int32 MinResolution = SurfaceCacheAtlasAllocator.GetMinNodeSize();
-	const int32 MaxResolution = SurfaceCacheAtlasAllocator.GetMaxNodeSize();
+	// evicted or failed to allocate, only bring it back when objects are in range
+	const bool IsInRange = IsSurfaceCacheInRange(SurfaceCacheId);
+	if (!SurfaceCacheInfo.IsResident() && !IsInRange)
+	{
+		return 0;
+	}
+
+	const int32 MinResolution = SurfaceCacheAtlasAllocator.GetMinTileSize();
+	const int32 MaxResolution = SurfaceCacheAtlasAllocator.GetMaxTileSize();
 	int32 RequireResolution = 0;
 
 	// loop all reference objects to calculate max resolution
@@ -1130,26 +1648,37 @@ void FRealtimeGIGPUScene::AdjustSurfaceCacheResolution(const int32& SurfaceCache
 		RequireResolution = FMath::Clamp(RequireResolution, MinResolution, MaxResolution);
 	}
 
-	// if need change size or in debug mode
+	return RequireResolution;
+}
+
+void FRealtimeGIGPUScene::AdjustSurfaceCacheResolution(const int32& SurfaceCacheId, const int32& RequireResolution)
+{
+	// 0 means skip
+	if (RequireResolution == 0)
+	{
+		return;
+	}
+
+	FSurfaceCacheInfo& SurfaceCacheInfo = SurfaceCacheInfos[SurfaceCacheId];
+
+	// if need change size, not resident or in debug mode
 	if (SurfaceCacheInfo.MeshCardResolution != RequireResolution ||
+		!SurfaceCacheInfo.IsResident() ||
 		CVarRealtimeGISurfaceCacheForceCapture.GetValueOnRenderThread() > 0)
 	{
-		// need re-capture
+		// need re-capture, primitives are marked dirty when capture is scheduled
 		ReleaseSurfaceCacheTextureSpace(SurfaceCacheId);
-		SurfaceCacheCaptureCommands.Add(SurfaceCacheId);
-
-		// mark all primitives as dirty
-		for (int32 ObjectId : ObjectIds)
-		{
-			const FObjectInfo& ObjectInfo = ObjectInfos[ObjectId];
-			const FBoxSphereBounds& WorldBound = ObjectInfo.Primitive->Proxy->GetBounds();
-			DirtyPrimitiveBounds.Add(WorldBound);
-		}
+		RequestSurfaceCacheCapture(SurfaceCacheId);
 
 		SurfaceCacheInfo.MeshCardResolution = RequireResolution;
 	}
 }
 
+void RealtimeGIBeginSceneUpdate(FScene* Scene, const TArray<FViewInfo>& Views)
+{
+	Scene->RealtimeGIScene.BeginUpdateTask(Views);
+}
+
 void RealtimeGISceneUpdate(FRDGBuilder& GraphBuilder, FScene* Scene, TArray<FViewInfo>& Views)
 {
 	RDG_EVENT_SCOPE(GraphBuilder, "RealtimeGISceneUpdate");
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Math/IntVector.h"
+#include "Async/TaskGraphInterfaces.h"
 #include "RHI.h"
 #include "RenderResource.h"
 #include "UniformBuffer.h"
@@ -10,6 +11,8 @@
 #include "RendererInterface.h"
 #include "MeshDrawCommands.h"
 #include "StupidAllocator.h"
+#include "RealtimeGICaptureScheduler.h"
+#include "RealtimeGISceneUpload.h"
 #include "RealtimeGIShared.h"
 #include "RealtimeGIVoxelClipmap.h"
 #include "RealtimeGIVoxelLighting.h"
@@ -67,13 +70,19 @@ public:
 	int32 GetRefCount() { return ReferenceHolders.Num(); };
 	TArray<int32> GetReferenceHolders() { return ReferenceHolders.Array(); };
 
+	// all cards own texture space in atlas, surface cache may be evicted or fail to allocate
+	bool IsResident() const { return NumMeshCards > 0 && CardUVTransforms.Num() == NumMeshCards; };
+
 	const FPrimitiveSceneInfo* Primitive = nullptr;
 	int32 SurfaceCacheId = 0;
 	int32 NumMeshCards = 0;
 	int32 MeshCardResolution = 0;
 	TArray<FMeshBatch> CardCaptureMeshBatches;
 	TArray<FMatrix> LocalToCardMatrixs;
+	TArray<FVector2D> CardExtents;		// size of card's capture plane in local space
 	TArray<FVector4> CardUVTransforms;	// float4(SizeX, SizeY, OffsetX, OffsetY)
+	uint32 LastUsedFrame = 0;			// last frame any reference object is in range of views, for LRU eviction
+	uint32 LastCaptureFrame = 0;		// 0 means never captured
 
 protected:
 	TSet<int32> ReferenceHolders;	// object id share same surface cache in GI scene
@@ -83,9 +92,11 @@ class FRealtimeGIGPUScene
 {
 public:
 	FRealtimeGIGPUScene() {};
-	~FRealtimeGIGPUScene() {};
+	~FRealtimeGIGPUScene() { WaitForUpdateTask(); };
 
 	void OnRendererSceneUpdatePrimitives(const TArray<FPrimitiveSceneInfo*>& AddedPrimitiveSceneInfos, const TArray<FPrimitiveSceneInfo*>& RemovedPrimitiveSceneInfos);
+	void BeginUpdateTask(const TArray<FViewInfo>& Views);
+	void WaitForUpdateTask();
 	void PreUpdate(FRDGBuilder& GraphBuilder, FScene* Scene, TArray<FViewInfo>& Views);
 	void Update(FRDGBuilder& GraphBuilder, FScene* Scene, TArray<FViewInfo>& Views);
 	void PostUpdate(FRDGBuilder& GraphBuilder, FScene* Scene, TArray<FViewInfo>& Views);
@@ -93,23 +104,36 @@ public:
 
 	FRealtimeGIVoxelClipmap* GetVoxelClipmap(const uint32& ViewId);
 
+	// log gpu memory of per view objects and scene resources
+	void DumpMemory(const TArray<FViewInfo>& Views);
+
 protected:
+	void UpdateCPU();
 	void FlushPrimitiveUpdateQueue();
 	void PrepareSurfaceCacheCapture();
 	void PrepareRenderResources(FRDGBuilder& GraphBuilder, FScene* Scene);
 	void SyncObjectInfosToGPU(FRDGBuilder& GraphBuilder, FScene* Scene);
 	void SyncSurfaceCacheInfosToGPU(FRDGBuilder& GraphBuilder, FScene* Scene);
+	void RealtimeGISurfaceCacheDefragPass(FRDGBuilder& GraphBuilder);
 	void RealtimeGISurfaceCacheCapturePass(FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View);
 
 	FVector4 CalcViewportInfo(const FSurfaceCacheInfo& SurfaceCacheInfo, const int32& CardIndex);
-	void ReferenceSurfaceCache(FObjectInfo& ObjectInfo);
+	void ReferenceSurfaceCache(FObjectInfo& ObjectInfo, const FSurfaceCacheKey& SurfaceCacheKey);
+	TArray<FSurfaceCacheKey> BuildSurfaceCacheKeys(const TArray<int32>& ObjectIds);
 	void DeReferenceSurfaceCache(FObjectInfo& ObjectInfo);
-	void AllocateSurfaceCacheTextureSpace(const int32& SurfaceCacheId);
+	bool AllocateSurfaceCacheTextureSpace(const int32& SurfaceCacheId);
+	bool TryAllocateCardTiles(const int32& SurfaceCacheId);
 	void ReleaseSurfaceCacheTextureSpace(const int32& SurfaceCacheId);
+	bool EvictLeastRecentlyUsedSurfaceCache(const int32& RequestSurfaceCacheId);
+	bool IsSurfaceCacheInRange(const int32& SurfaceCacheId);
+	void DefragmentSurfaceCacheAtlas();
 	void GatherCardCaptureMeshElements(const int32& SurfaceCacheId);
-	void AdjustSurfaceCacheResolution(const int32& SurfaceCacheId);
+	int32 CalcSurfaceCacheResolution(const int32& SurfaceCacheId);
+	void AdjustSurfaceCacheResolution(const int32& SurfaceCacheId, const int32& RequireResolution);
+	void RequestSurfaceCacheCapture(const int32& SurfaceCacheId);
+	void ScheduleSurfaceCacheCapture();
 
-	// key is view id
+	// key is view id, views sharing a clipmap use the key of the first view in group
 	TMap<uint32, FRealtimeGIVoxelClipmap> VoxelClipmapViewMap;
 	TMap<uint32, FRealtimeGIRadianceCache> RadianceCacheViewMap;
 	TMap<uint32, FRealtimeGIScreenGatherPipeline> ScreenGatherPipelineViewMap;
@@ -117,9 +141,9 @@ protected:
 	TMap<FPrimitiveComponentId, FPrimitiveSceneInfo*> PendingPrimitivesToAdd;
 	TMap<FPrimitiveComponentId, FBoxSphereBounds> PendingPrimitivesToRemove;
 
-	FStupidLinearAllocator<FPrimitiveComponentId> ObjectIdAllocator;
-	FStupidLinearAllocator<FSurfaceCacheKey> SurfaceCacheAllocator;	// allocate mesh card descriptor in cpu
-	FStupidQuadTreeAllocator SurfaceCacheAtlasAllocator;			// allocate texture space in gpu
+	FGISlotAllocator<FPrimitiveComponentId> ObjectIdAllocator;
+	FGISlotAllocator<FSurfaceCacheKey> SurfaceCacheAllocator;		// allocate mesh card descriptor in cpu
+	FGIAtlasAllocator SurfaceCacheAtlasAllocator;					// allocate texture space in gpu
 
 	TArray<FObjectInfo> ObjectInfos;
 	TArray<FSurfaceCacheInfo> SurfaceCacheInfos;
@@ -129,26 +153,48 @@ protected:
 	TSet<int32> ObjectRemoveCommands;
 	TSet<int32> ObjectUpdateCommands;
 
+	// surface caches wait for capture, value is the frame of request
+	// only part of them are moved to SurfaceCacheCaptureCommands per frame, limited by capture budget
+	TMap<int32, uint32> PendingSurfaceCacheCaptures;
+
 	// commands to capture or clear surface cache, only store surface cache id
 	TSet<int32> SurfaceCacheCaptureCommands;
 	TArray<FVector4> SurfaceCacheClearCommands;
 
+	// surface cache info changed but no need to re-capture (tile moved or evicted), only store surface cache id
+	TSet<int32> SurfaceCacheUpdateCommands;
+
+	// tiles moved by atlas defragmentation in this frame, texels are copied before capture pass
+	TArray<FGIAtlasMove> SurfaceCacheAtlasMoves;
+
+	// surface caches can be evicted when atlas is full, sorted by LastUsedFrame, build once per frame on demand
+	TArray<int32> SurfaceCacheEvictionCandidates;
+	bool SurfaceCacheEvictionCandidatesBuilt = false;
+
+	TArray<FVector> ViewOrigins;
+
+	// cpu bookkeeping run in task graph, parallel with InitViews
+	// gpu scene is only touched by the task between BeginUpdateTask and WaitForUpdateTask
+	// the task read static meshes, so it is kicked after InitViews updated them
+	FGraphEventRef UpdateTask;
+	bool UpdateTaskIssued = false;
+
 	TArray<FBoxSphereBounds> DirtyPrimitiveBounds;
 
+	// set when gpu buffers are re-created by allocator grow, all allocated data need upload again
+	bool ObjectInfoBufferResized = false;
+	bool SurfaceCacheInfoBufferResized = false;
+
 	FRWBufferStructured ObjectInfoBuffer;
-	FByteAddressBuffer ObjectInfoUploadBuffer;
-	FByteAddressBuffer RemovedObjectIdBuffer;
 
 	// card placed in local space, so the update frequency of cards is lower than ObjectInfo
 	// for example: an object change transform, but card's placement will not change
 	FRWBufferStructured SurfaceCacheInfoBuffer;
-	FByteAddressBuffer SurfaceCacheInfoUploadBuffer;
 	FRWBufferStructured CardInfoBuffer;
-	FByteAddressBuffer CardInfoUploadBuffer;
 	FByteAddressBuffer CardClearQuadUVTransformBuffer;
 
-	// compact buffer for culling
-	FRDGBufferRef ObjectInfoCounter;
+	// compact buffer for culling, slot order is kept on cpu so only changed slots are written
+	FRealtimeGICompactIndexMap CompactObjectIds;
 	FRWBufferStructured MiniObjectInfoBuffer;
 
 	bool SurfaceCacheAtlasNeedClear = false;
@@ -160,4 +206,5 @@ protected:
 	friend class FRealtimeGIRadianceCache;
 };
 
+extern void RealtimeGIBeginSceneUpdate(FScene* Scene, const TArray<FViewInfo>& Views);
 extern void RealtimeGISceneUpdate(FRDGBuilder& GraphBuilder, FScene* Scene, TArray<FViewInfo>& Views);
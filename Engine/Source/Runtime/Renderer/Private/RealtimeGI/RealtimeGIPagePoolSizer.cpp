@@ -0,0 +1,39 @@
+#include "RealtimeGIPagePoolSizer.h"
+
+void FRealtimeGIPagePoolSizer::SetLimits(int32 InPagesPerSlice, int32 InMinSlices, int32 InMaxSlices)
+{
+	check(InPagesPerSlice > 0 && InMinSlices > 0);
+
+	PagesPerSlice = InPagesPerSlice;
+	MinSlices = InMinSlices;
+	MaxSlices = FMath::Max(InMaxSlices, InMinSlices);
+}
+
+int32 FRealtimeGIPagePoolSizer::Update(int32 NumSlices, const FVoxelPageStats& Stats)
+{
+	const int32 NumPages = NumSlices * PagesPerSlice;
+	int32 WantedSlices = NumSlices;
+
+	if (Stats.NumRequestedPages > NumPages * GrowThreshold)
+	{
+		// grow at least by half to avoid copying the pool every few frames
+		const int32 SlicesToFit = FMath::CeilToInt(Stats.NumRequestedPages / (GrowThreshold * PagesPerSlice));
+		WantedSlices = FMath::Max(NumSlices + FMath::Max(NumSlices / 2, 1), SlicesToFit);
+		NumLowOccupancyUpdates = 0;
+	}
+	else if (ShrinkDelay > 0 && Stats.NumUsedPages < NumPages * ShrinkThreshold)
+	{
+		// shrink to half occupied, far from both thresholds so it will not bounce back
+		if (++NumLowOccupancyUpdates >= ShrinkDelay)
+		{
+			WantedSlices = FMath::DivideAndRoundUp(Stats.NumUsedPages * 2, PagesPerSlice);
+			NumLowOccupancyUpdates = 0;
+		}
+	}
+	else
+	{
+		NumLowOccupancyUpdates = 0;
+	}
+
+	return FMath::Clamp(WantedSlices, MinSlices, MaxSlices);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// page residency read back from gpu, requested is more than used when the pool is full and some allocations fail
+struct FVoxelPageStats
+{
+	int32 NumUsedPages = 0;
+	int32 NumRequestedPages = 0;
+	int32 NumPages = 0;		// pool capacity when the stats are written
+};
+
+// decide how many z slices of pages the voxel pool need, only plain data so it can run without render resources
+// pool grow in z so allocated pages keep their address, shrink need to reset all pages
+class FRealtimeGIPagePoolSizer
+{
+public:
+	void SetLimits(int32 InPagesPerSlice, int32 InMinSlices, int32 InMaxSlices);
+	void Reset() { NumLowOccupancyUpdates = 0; }
+
+	// return wanted number of slices, same as NumSlices if pool size is fine
+	int32 Update(int32 NumSlices, const FVoxelPageStats& Stats);
+
+	float GrowThreshold = 0.9f;		// grow when requested pages exceed this ratio of capacity
+	float ShrinkThreshold = 0.25f;	// shrink when used pages stay below this ratio of capacity
+	int32 ShrinkDelay = 0;			// number of low occupancy updates in a row before shrink, 0 means never shrink
+
+protected:
+	int32 PagesPerSlice = 1;
+	int32 MinSlices = 1;
+	int32 MaxSlices = 1;
+	int32 NumLowOccupancyUpdates = 0;
+};
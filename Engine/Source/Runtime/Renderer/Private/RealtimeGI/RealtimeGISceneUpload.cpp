@@ -0,0 +1,118 @@
+#include "RealtimeGISceneUpload.h"
+#include "RenderGraphUtils.h"
+
+FRealtimeGIUploadBuffer::FRealtimeGIUploadBuffer(uint32 InNumBytesPerElement, const TCHAR* InDebugName)
+	: DebugName(InDebugName)
+	, NumBytesPerElement(InNumBytesPerElement)
+{
+	check(InNumBytesPerElement % 4 == 0);
+}
+
+void* FRealtimeGIUploadBuffer::Begin(FRDGBuilder& GraphBuilder, uint32 InNumElements)
+{
+	check(Data == nullptr);
+
+	// empty dispatch for debug still bind a buffer, keep one zeroed record
+	NumElements = FMath::Max(InNumElements, 1u);
+	Data = GraphBuilder.Alloc(NumElements * NumBytesPerElement, 16);
+	if (InNumElements == 0)
+	{
+		FMemory::Memzero(Data, NumBytesPerElement);
+	}
+	return Data;
+}
+
+FRDGBufferSRVRef FRealtimeGIUploadBuffer::End(FRDGBuilder& GraphBuilder)
+{
+	check(Data != nullptr);
+
+	// data is owned by the graph builder, no copy needed
+	FRDGBufferRef Buffer = CreateStructuredBuffer(GraphBuilder, DebugName, NumBytesPerElement, NumElements, Data, NumElements * NumBytesPerElement, ERDGInitialDataFlags::NoCopy);
+	Data = nullptr;
+	return GraphBuilder.CreateSRV(Buffer);
+}
+
+void FRealtimeGICompactIndexMap::Add(int32 Id)
+{
+	check(Id >= 0);
+	if (Id >= IdToCompactIndex.Num())
+	{
+		const int32 OldNum = IdToCompactIndex.Num();
+		IdToCompactIndex.SetNumUninitialized(FMath::Max(Id + 1, OldNum * 2));
+		for (int32 i = OldNum; i < IdToCompactIndex.Num(); i++)
+		{
+			IdToCompactIndex[i] = INDEX_NONE;
+		}
+	}
+
+	check(IdToCompactIndex[Id] == INDEX_NONE);
+	IdToCompactIndex[Id] = CompactIds.Add(Id);
+	MarkIndexDirty(IdToCompactIndex[Id]);
+}
+
+void FRealtimeGICompactIndexMap::Remove(int32 Id)
+{
+	const int32 CompactIndex = GetCompactIndex(Id);
+	if (CompactIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	// [A, B, C, D] remove B --> [A, D, C]
+	const int32 LastId = CompactIds.Last();
+	CompactIds.RemoveAtSwap(CompactIndex, 1, false);
+	IdToCompactIndex[Id] = INDEX_NONE;
+
+	if (LastId != Id)
+	{
+		IdToCompactIndex[LastId] = CompactIndex;
+		MarkIndexDirty(CompactIndex);
+	}
+}
+
+void FRealtimeGICompactIndexMap::MarkDirty(int32 Id)
+{
+	const int32 CompactIndex = GetCompactIndex(Id);
+	if (CompactIndex != INDEX_NONE)
+	{
+		MarkIndexDirty(CompactIndex);
+	}
+}
+
+void FRealtimeGICompactIndexMap::MarkAllDirty()
+{
+	for (int32 CompactIndex = 0; CompactIndex < CompactIds.Num(); CompactIndex++)
+	{
+		MarkIndexDirty(CompactIndex);
+	}
+}
+
+void FRealtimeGICompactIndexMap::MarkIndexDirty(int32 CompactIndex)
+{
+	if (CompactIndex >= DirtyBits.Num())
+	{
+		DirtyBits.Add(false, FMath::Max(CompactIndex + 1, DirtyBits.Num() * 2) - DirtyBits.Num());
+	}
+
+	if (!DirtyBits[CompactIndex])
+	{
+		DirtyBits[CompactIndex] = true;
+		DirtyIndices.Add(CompactIndex);
+	}
+}
+
+void FRealtimeGICompactIndexMap::PopDirtyIndices(TArray<int32>& OutIndices)
+{
+	OutIndices.Reset();
+	for (int32 CompactIndex : DirtyIndices)
+	{
+		DirtyBits[CompactIndex] = false;
+
+		// slot may be removed after marked
+		if (CompactIndex < CompactIds.Num())
+		{
+			OutIndices.Add(CompactIndex);
+		}
+	}
+	DirtyIndices.Reset();
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RHI.h"
+#include "RenderGraphBuilder.h"
+
+// per frame upload through the graph: records are written into graph builder memory and copied
+// into a pooled rdg buffer, the pool only hands a buffer out again once gpu is done reading it
+// so frames in flight and several scene renderers in one frame never overwrite each other
+class FRealtimeGIUploadBuffer
+{
+public:
+	FRealtimeGIUploadBuffer(uint32 InNumBytesPerElement, const TCHAR* InDebugName);
+
+	// memory for NumElements records, valid until the graph is executed
+	void* Begin(FRDGBuilder& GraphBuilder, uint32 NumElements);
+	FRDGBufferSRVRef End(FRDGBuilder& GraphBuilder);
+
+protected:
+	const TCHAR* DebugName = nullptr;
+	uint32 NumBytesPerElement = 0;
+	uint32 NumElements = 0;
+	void* Data = nullptr;
+};
+
+// dense array of object ids for gpu culling, remove swaps the last one into the hole
+// changed slots are recorded so gpu only copy them instead of compacting the whole object array
+class FRealtimeGICompactIndexMap
+{
+public:
+	void Add(int32 Id);
+	void Remove(int32 Id);
+	void MarkDirty(int32 Id);
+	void MarkAllDirty();
+
+	int32 Num() const { return CompactIds.Num(); }
+	int32 GetId(int32 CompactIndex) const { return CompactIds[CompactIndex]; }
+	int32 GetCompactIndex(int32 Id) const { return IdToCompactIndex.IsValidIndex(Id) ? IdToCompactIndex[Id] : INDEX_NONE; }
+
+	// dirty slots still inside the array, dirty state is cleared
+	void PopDirtyIndices(TArray<int32>& OutIndices);
+
+protected:
+	void MarkIndexDirty(int32 CompactIndex);
+
+	TArray<int32> IdToCompactIndex;
+	TArray<int32> CompactIds;
+	TArray<int32> DirtyIndices;
+	TBitArray<> DirtyBits;
+};
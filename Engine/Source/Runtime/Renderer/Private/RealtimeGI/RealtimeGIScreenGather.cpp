@@ -723,6 +723,24 @@ public:
 IMPLEMENT_GLOBAL_SHADER(FSpecularCompositePS, "/Engine/Private/RealtimeGI/ScreenGather.usf", "SpecularCompositePS", SF_Pixel);
 
 
+uint64 FRealtimeGIScreenGatherPipeline::GetGPUMemorySize() const
+{
+	uint64 Size = 0;
+	Size += GetPersistentTextureSize(NormalDepthHistory);
+	Size += GetPersistentTextureSize(SceneColorHistory);
+	for (int32 i = 0; i < 2; i++)
+	{
+		Size += GetPersistentTextureSize(TemporalReservoirDataA[i]);
+		Size += GetPersistentTextureSize(TemporalReservoirDataB[i]);
+		Size += GetPersistentTextureSize(TemporalReservoirDataC[i]);
+		Size += GetPersistentTextureSize(TemporalReservoirDataD[i]);
+	}
+	Size += GetPersistentTextureSize(DiffuseIndirectHistory);
+	Size += GetPersistentTextureSize(IndirectShadowHistory);
+	Size += GetPersistentTextureSize(SpecularIndirectHistory);
+	return Size;
+}
+
 void FRealtimeGIScreenGatherPipeline::Setup(TRDGUniformBufferRef<FSceneTextureUniformParameters> InSceneTexturesUniformBuffer)
 {
 	SceneTexturesUniformBuffer = InSceneTexturesUniformBuffer;
@@ -37,6 +37,8 @@ public:
 	void VisualizeRealtimeGIScreenGather(FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View, FRDGTextureRef SceneColorTexture, FRDGTextureRef SceneDepthTexture);
 	void RealtimeGICacheSceneColor(FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View, FRDGTextureRef SceneColorTexture);
 
+	uint64 GetGPUMemorySize() const;
+
 protected:
 	void PrepareRenderResources(FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View);
 	void NormalDepthDownsample(FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View);
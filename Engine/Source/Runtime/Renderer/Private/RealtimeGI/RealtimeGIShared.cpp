@@ -1,6 +1,7 @@
 #include "RealtimeGIShared.h"
 #include "RenderCore/Public/RenderTargetPool.h"
 #include "RenderCore/Public/RenderGraphBuilder.h"
+#include "RenderCore/Public/RenderGraphUtils.h"
 #include "RenderCore/Public/GlobalShader.h"
 #include "RenderCore/Public/ShaderParameterStruct.h"
 #include "Renderer/Private/ScenePrivate.h"
@@ -30,6 +31,18 @@ bool RealtimeGIUseDistanceField()
 	return CVarRealtimeGIUseDistanceField.GetValueOnRenderThread() > 0; 
 };
 
+TAutoConsoleVariable<int32> CVarRealtimeGIAsyncCompute(
+	TEXT("r.RealtimeGI.AsyncCompute"),
+	0,
+	TEXT("Run radiance cache update (voxel lighting and probe gather) on async compute, overlapping shadow depth and base pass"),
+	ECVF_RenderThreadSafe
+);
+
+bool RealtimeGIUseAsyncCompute()
+{
+	return GSupportsEfficientAsyncCompute && CVarRealtimeGIAsyncCompute.GetValueOnRenderThread() > 0;
+};
+
 int32 GetVolumeResolution(int32 ResolutionLevel)
 {
 	check(0 <= ResolutionLevel && ResolutionLevel < VR_Num);
@@ -81,29 +94,32 @@ FMatrix CalcCardCaptureViewRotationMatrix(ECubeFace Face)
 	return Result;
 }
 
-FMatrix CalcCardCaptureViewProjectionMatrix(FVector CardCenter, FVector Size, ECubeFace Face)
+FVector2D CalcCardCaptureExtent(FVector Size, ECubeFace Face)
 {
-	float Width = Size.GetMax();
-	float Height = Size.GetMax();
-	float Depth = Size.GetMax();
-
 	if (Face == CubeFace_NegX || Face == CubeFace_PosX)
 	{
-		Width = Size.Y;
-		Height = Size.Z;
+		return FVector2D(Size.Y, Size.Z);
 	}
 
 	if (Face == CubeFace_NegY || Face == CubeFace_PosY)
 	{
-		Width = Size.X;
-		Height = Size.Z;
+		return FVector2D(Size.X, Size.Z);
 	}
 
-	if (Face == CubeFace_NegZ || Face == CubeFace_PosZ)
-	{
-		Width = Size.X;
-		Height = Size.Y;
-	}
+	return FVector2D(Size.X, Size.Y);
+}
+
+FMatrix CalcCardCaptureViewProjectionMatrix(FVector CardCenter, FVector CardSize, float Depth, ECubeFace Face)
+{
+	FVector2D CardExtent = CalcCardCaptureExtent(CardSize, Face);
+	float Width = CardExtent.X;
+	float Height = CardExtent.Y;
+
+	// move view origin so near plane is at the front of card box, surfaces in front of it are clipped
+	const FMatrix ViewRotationMatrix = CalcCardCaptureViewRotationMatrix(Face);
+	const FVector ViewDirection = ViewRotationMatrix.GetColumn(2);
+	const float CardDepth = FMath::Abs(FVector::DotProduct(CardSize, ViewDirection));
+	const FVector ViewOrigin = CardCenter + ViewDirection * FMath::Max(Depth - CardDepth, 0.0f) * 0.5;
 
 	float NearPlane = Depth * -0.5;
 	float FarPlane = Depth * 0.5;
@@ -111,8 +127,8 @@ FMatrix CalcCardCaptureViewProjectionMatrix(FVector CardCenter, FVector Size, EC
 	float ZOffset = -NearPlane;
 
 	FViewMatrices::FMinimalInitializer CaptureViewInitOptions;
-	CaptureViewInitOptions.ViewRotationMatrix = CalcCardCaptureViewRotationMatrix(Face);
-	CaptureViewInitOptions.ViewOrigin = CardCenter;
+	CaptureViewInitOptions.ViewRotationMatrix = ViewRotationMatrix;
+	CaptureViewInitOptions.ViewOrigin = ViewOrigin;
 	CaptureViewInitOptions.ProjectionMatrix = FReversedZOrthoMatrix(Width * 0.5, Height * 0.5, ZScale, ZOffset);
 	// CaptureViewInitOptions.ProjectionMatrix = GetCubeProjectionMatrix(90.0 * 0.5f, 128, 0.1f);	// for debug
 	FViewMatrices CaptureViewMatrices = FViewMatrices(CaptureViewInitOptions);
@@ -173,6 +189,11 @@ FIntVector Int3Clamp(FIntVector Val, FIntVector MinVal, FIntVector MaxVal)
 	);
 }
 
+uint64 GetPersistentTextureSize(const FPersistentTexture& Texture)
+{
+	return Texture.PooledTexture.IsValid() ? Texture.PooledTexture->ComputeMemorySize() : 0;
+}
+
 bool Create2DTexFn(FRDGBuilder& GraphBuilder, FPersistentTexture& ExternalTex, FIntPoint Resolution, EPixelFormat PixelFormat, const TCHAR* DebugName, bool HasMip)
 {
 	bool IsFirstTimeCreate = false;
@@ -218,6 +239,28 @@ bool Create3DTexFn(FRDGBuilder& GraphBuilder, FPersistentTexture& ExternalTex, F
 	return IsFirstTimeCreate;
 }
 
+bool Grow3DTexFn(FRDGBuilder& GraphBuilder, FPersistentTexture& ExternalTex, FIntVector Resolution, EPixelFormat PixelFormat, const TCHAR* DebugName)
+{
+	TRefCountPtr<IPooledRenderTarget> OldPooledTex = ExternalTex.PooledTexture;
+	if (!Create3DTexFn(GraphBuilder, ExternalTex, Resolution, PixelFormat, DebugName))
+	{
+		return false;
+	}
+
+	// only copy when all axis grow, a smaller texture has nothing worth to keep
+	if (OldPooledTex.IsValid() && OldPooledTex->GetDesc().Format == PixelFormat)
+	{
+		const FIntVector OldResolution = OldPooledTex->GetDesc().GetSize();
+		if (OldResolution.X <= Resolution.X && OldResolution.Y <= Resolution.Y && OldResolution.Z <= Resolution.Z)
+		{
+			FRHICopyTextureInfo CopyInfo;
+			CopyInfo.Size = OldResolution;
+			AddCopyTexturePass(GraphBuilder, GraphBuilder.RegisterExternalTexture(OldPooledTex), ExternalTex.RDGTexture, CopyInfo);
+		}
+	}
+	return true;
+}
+
 class FCounterInitCS : public FGlobalShader
 {
 public:
@@ -250,7 +293,7 @@ public:
 };
 IMPLEMENT_GLOBAL_SHADER(FCounterInitCS, "/Engine/Private/RealtimeGI/RealtimeGICommon.usf", "CounterInitCS", SF_Compute);
 
-void ClearCounterBuffer(FRDGBuilder& GraphBuilder, FScene* Scene, FRDGBufferRef Buffer, int32 NumElements)
+void ClearCounterBuffer(FRDGBuilder& GraphBuilder, FScene* Scene, FRDGBufferRef Buffer, int32 NumElements, ERDGPassFlags PassFlags)
 {
 	TShaderMapRef<FCounterInitCS> ComputeShader(GetGlobalShaderMap(Scene->GetFeatureLevel()));
 	auto* PassParameters = GraphBuilder.AllocParameters<FCounterInitCS::FParameters>();
@@ -259,7 +302,7 @@ void ClearCounterBuffer(FRDGBuilder& GraphBuilder, FScene* Scene, FRDGBufferRef
 
 	const int32 NumGroups = FMath::CeilToInt(float(NumElements) / float(FCounterInitCS::ThreadGroupSizeX));
 	FComputeShaderUtils::AddPass(
-		GraphBuilder, RDG_EVENT_NAME("ClearCounterBuffer"),
+		GraphBuilder, RDG_EVENT_NAME("ClearCounterBuffer"), PassFlags,
 		ComputeShader, PassParameters, FIntVector(NumGroups, 1, 1));
 }
 
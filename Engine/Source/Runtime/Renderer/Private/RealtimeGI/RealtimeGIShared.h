@@ -2,12 +2,15 @@
 
 #include "CoreMinimal.h"
 #include "RendererInterface.h"
+#include "RenderGraphDefinitions.h"
 #include "Core/Public/Math/IntVector.h"
 #include "ReflectionEnvironment.h"
+#include "RealtimeGIMeshCards.h"
 
 #define OBJECT_ID_INVALID (-114514)
 
 #define MAX_CARDS_PER_MESH (12)
+static_assert(REALTIMEGI_MAX_MESH_CARDS <= MAX_CARDS_PER_MESH, "Precomputed mesh cards exceed card buffer layout");
 
 // we use uint64 to represent 4x4x4 voxel, so single block's size is 4
 #define VOXEL_BLOCK_SIZE (4)
@@ -82,11 +85,19 @@ bool RealtimeGIEnable();
 extern TAutoConsoleVariable<int32> CVarRealtimeGIUseDistanceField;
 bool RealtimeGIUseDistanceField();
 
+extern TAutoConsoleVariable<int32> CVarRealtimeGIAsyncCompute;
+bool RealtimeGIUseAsyncCompute();
+
 int32 GetVolumeResolution(int32 ResolutionLevel);
 
 FMatrix CalcCardCaptureViewRotationMatrix(ECubeFace Face);
 
-FMatrix CalcCardCaptureViewProjectionMatrix(FVector CardCenter, FVector Size, ECubeFace Face);
+// size of card's capture plane (width, height) in local space
+FVector2D CalcCardCaptureExtent(FVector Size, ECubeFace Face);
+
+// card capture a box in local space, depth range start from the box's front face and must be the same for all cards of a mesh
+// note: VoxelInjectCS assume depth range is max size of local bounds
+FMatrix CalcCardCaptureViewProjectionMatrix(FVector CardCenter, FVector CardSize, float Depth, ECubeFace Face);
 
 int32 Index3DTo1DLinear(const FIntVector& Index3D, FIntVector Size3D);
 FIntVector Index1DTo3DLinear(int32 Index1D, FIntVector Size3D);
@@ -103,9 +114,15 @@ struct FPersistentTexture
 	TRefCountPtr<IPooledRenderTarget> PooledTexture;	// create once
 };
 
+// gpu bytes of the pooled texture, 0 if not created yet
+uint64 GetPersistentTextureSize(const FPersistentTexture& Texture);
+
 bool Create2DTexFn(FRDGBuilder& GraphBuilder, FPersistentTexture& ExternalTex, FIntPoint Resolution, EPixelFormat PixelFormat, const TCHAR* DebugName, bool HasMip = false);
 bool Create3DTexFn(FRDGBuilder& GraphBuilder, FPersistentTexture& ExternalTex, FIntVector Resolution, EPixelFormat PixelFormat, const TCHAR* DebugName);
 
+// same as Create3DTexFn, but keep old content when texture grow
+bool Grow3DTexFn(FRDGBuilder& GraphBuilder, FPersistentTexture& ExternalTex, FIntVector Resolution, EPixelFormat PixelFormat, const TCHAR* DebugName);
+
 template<typename ElementType>
 void InitTexture3D(FRDGBuilder& GraphBuilder, FPersistentTexture& ExternalTex, FIntVector Size, ElementType InitValue)
 {
@@ -128,7 +145,7 @@ void InitTexture3D(FRDGBuilder& GraphBuilder, FPersistentTexture& ExternalTex, F
 	);
 }
 
-void ClearCounterBuffer(FRDGBuilder& GraphBuilder, FScene* Scene, FRDGBufferRef Buffer, int32 NumElements);
+void ClearCounterBuffer(FRDGBuilder& GraphBuilder, FScene* Scene, FRDGBufferRef Buffer, int32 NumElements, ERDGPassFlags PassFlags = ERDGPassFlags::Compute);
 
 void SimpleBlit(
 	FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View,
@@ -7,6 +7,8 @@
 #include "Renderer/Private/ScenePrivate.h"
 #include "SceneTextureParameters.h"
 #include "RealtimeGI/RealtimeGIScreenGather.h"
+#include "Async/ParallelFor.h"
+#include "RenderGraphUtils.h"
 
 // #pragma optimize ("", off)
 
@@ -96,6 +98,28 @@ static TAutoConsoleVariable<int32> CVarVolumeResolutionLevel(
 	ECVF_RenderThreadSafe
 );
 
+static TAutoConsoleVariable<int32> CVarVoxelPagePoolMinSlices(
+	TEXT("r.RealtimeGI.VoxelPagePoolMinSlices"),
+	8,
+	TEXT("Min number of 32x32 page slices in voxel pool, pool start with this size and grow when pages run out"),
+	ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<int32> CVarVoxelPagePoolMaxSlices(
+	TEXT("r.RealtimeGI.VoxelPagePoolMaxSlices"),
+	128,
+	TEXT("Max number of 32x32 page slices in voxel pool, voxels are dropped when pool is full at this size"),
+	ECVF_RenderThreadSafe
+);
+
+static TAutoConsoleVariable<int32> CVarVoxelPagePoolShrinkDelay(
+	TEXT("r.RealtimeGI.VoxelPagePoolShrinkDelay"),
+	0,
+	TEXT("Shrink voxel pool after this many readbacks in a row with less than a quarter pages used, 0 is never shrink\n")
+	TEXT("Shrink will reset the whole clipmap and voxelize again"),
+	ECVF_RenderThreadSafe
+);
+
 class FCullObjectToClipmapCS : public FGlobalShader
 {
 public:
@@ -283,6 +307,7 @@ public:
 		SHADER_PARAMETER_UAV(RWStructuredBuffer, RWVoxelPageReleaseList)
 		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer, RWNumPagesToReleaseCounter)
 		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer, RWIndirectArgs)
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWBuffer<int>, RWVoxelPageStats)
 	END_SHADER_PARAMETER_STRUCT()
 
 	static const uint32 ThreadGroupSizeX = 1;
@@ -341,6 +366,40 @@ public:
 };
 IMPLEMENT_GLOBAL_SHADER(FVoxelPageReleaseCS, "/Engine/Private/RealtimeGI/VoxelClipmapUpdate.usf", "VoxelPageReleaseCS", SF_Compute);
 
+class FGrowVoxelPageFreeListCS : public FGlobalShader
+{
+public:
+	DECLARE_GLOBAL_SHADER(FGrowVoxelPageFreeListCS);
+	SHADER_USE_PARAMETER_STRUCT(FGrowVoxelPageFreeListCS, FGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER(FIntVector, NumVoxelPagesInXYZ)
+		SHADER_PARAMETER(int32, OldMaxPageNum)
+		SHADER_PARAMETER_SRV(StructuredBuffer, OldVoxelPageFreeList)
+		SHADER_PARAMETER_UAV(RWStructuredBuffer, RWVoxelPageFreeList)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static const uint32 ThreadGroupSizeX = 64;
+	static const uint32 ThreadGroupSizeY = 1;
+	static const uint32 ThreadGroupSizeZ = 1;
+
+	using FPermutationDomain = TShaderPermutationDomain<>;
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return true;
+	}
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE_X"), ThreadGroupSizeX);
+		OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE_Y"), ThreadGroupSizeY);
+		OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE_Z"), ThreadGroupSizeZ);
+	}
+};
+IMPLEMENT_GLOBAL_SHADER(FGrowVoxelPageFreeListCS, "/Engine/Private/RealtimeGI/VoxelClipmapUpdate.usf", "GrowVoxelPageFreeListCS", SF_Compute);
+
 class FVisualizeVoxelPS : public FGlobalShader
 {
 public:
@@ -413,68 +472,36 @@ public:
 IMPLEMENT_GLOBAL_SHADER(FDistanceFieldPropagateCS, "/Engine/Private/RealtimeGI/VoxelClipmapUpdate.usf", "DistanceFieldPropagateCS", SF_Compute);
 
 
-bool FRealtimeGIVolumeInfo::HasChunksToUpdate()
+void FRealtimeGIVolumeInfo::InitUpdateChunks()
 {
-	return PendingUpdateChunks.size() > 0;
+	PendingUpdateChunks.Init(NumChunksInXYZ);
 }
 
-bool FRealtimeGIVolumeInfo::PopUpdateChunk(FUpdateChunk& OutElement)
+bool FRealtimeGIVolumeInfo::HasChunksToUpdate() const
 {
-	if (PendingUpdateChunks.size() == 0)
-	{
-		return false;
-	}
-
-	OutElement = PendingUpdateChunks.front();
-	PendingUpdateChunks.pop_front();
-	UpdateChunksLookUp.Remove(OutElement.Index1D);
-
-	return true;
+	return PendingUpdateChunks.HasDirtyChunks();
 }
 
 void FRealtimeGIVolumeInfo::PushUpdateChunk(const FUpdateChunk& InElement)
 {
-	bool IsAlreadyInSet = false;
-	UpdateChunksLookUp.Add(InElement.Index1D, &IsAlreadyInSet);
-	if (IsAlreadyInSet)
-	{
-		return;
-	}
-
-	PendingUpdateChunks.push_back(InElement);
+	PendingUpdateChunks.MarkDirty(InElement);
 }
 
-void FRealtimeGIVolumeInfo::PopulateUpdateChunkList()
+void FRealtimeGIVolumeInfo::ScrollUpdateChunks(const FIntVector& InDeltaChunk)
 {
-	const int32 MaxUpdateChunkPerFrame = CVarNumChunksToUpdatePerFrame.GetValueOnRenderThread();
-
-	ChunksToUpdate.Empty();
-
-	// fetch from pending queue
-	for (int32 i = 0; i < MaxUpdateChunkPerFrame; i++)
-	{
-		FUpdateChunk Chunk;
-		if (!PopUpdateChunk(Chunk))
-		{
-			break;
-		}
+	PendingUpdateChunks.Scroll(InDeltaChunk);
+}
 
-		ChunksToUpdate.Add(Chunk.Index1D);
-	}
+void FRealtimeGIVolumeInfo::PopulateUpdateChunkList(int32 MaxUpdateChunkPerFrame)
+{
+	// fetch oldest chunks from pending list
+	PendingUpdateChunks.PopOldest(MaxUpdateChunkPerFrame, ChunksToUpdate);
 }
 
 void FRealtimeGIVolumeInfo::PopulateUpdateChunkCleanupList(uint32 FrameIndex)
 {
-	ChunksToCleanup.Empty();
-
 	// if a chunk been marked as dirty in this frame, we cleanup it
-	for (const FUpdateChunk& DirtyChunk : PendingUpdateChunks)
-	{
-		if (DirtyChunk.TimeStamp == FrameIndex)
-		{
-			ChunksToCleanup.Add(DirtyChunk.Index1D);
-		}
-	}
+	PendingUpdateChunks.GetChunksWithTimeStamp(FrameIndex, ChunksToCleanup);
 }
 
 FVoxelRaytracingParameters FRealtimeGIVoxelClipmap::SetupVoxelRaytracingParameters(FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View, int32 ClipId)
@@ -516,6 +543,24 @@ FVoxelRaytracingParameters FRealtimeGIVoxelClipmap::SetupVoxelRaytracingParamete
 	return PassParameters;
 }
 
+uint64 FRealtimeGIVoxelClipmap::GetGPUMemorySize() const
+{
+	uint64 Size = 0;
+	Size += GetPersistentTextureSize(VoxelBitOccupyClipmap);
+	Size += GetPersistentTextureSize(VoxelPageClipmap);
+	Size += GetPersistentTextureSize(DistanceFieldClipmap[0]);
+	Size += GetPersistentTextureSize(DistanceFieldClipmap[1]);
+	Size += GetPersistentTextureSize(VoxelPoolBaseColor);
+	Size += GetPersistentTextureSize(VoxelPoolNormal);
+	Size += GetPersistentTextureSize(VoxelPoolEmissive);
+	Size += VoxelPageFreeList.NumBytes + VoxelPageReleaseList.NumBytes;
+	for (int32 ClipId = 0; ClipId < MAX_CLIP_NUM; ClipId++)
+	{
+		Size += UpdateChunkList[ClipId].NumBytes + UpdateChunkCleanupList[ClipId].NumBytes;
+	}
+	return Size;
+}
+
 void FRealtimeGIVoxelClipmap::Update(FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View)
 {
 	PrepareRenderResources(GraphBuilder, Scene, View);
@@ -544,7 +589,7 @@ void FRealtimeGIVoxelClipmap::Update(FRDGBuilder& GraphBuilder, FScene* Scene, F
 
 void FRealtimeGIVoxelClipmap::UpdateVolumePosition(FViewInfo& View, int32 ClipId)
 {
-	const FVector& ViewLocation = View.ViewLocation;
+	const FVector& ViewLocation = ClipmapOrigin;
 	FRealtimeGIVolumeInfo& VolumeInfo = ClipmapInfos[ClipId];
 
 	FVector VoxelGridSize = VolumeInfo.CoverRange / FVector(VolumeResolution);
@@ -580,31 +625,9 @@ void FRealtimeGIVoxelClipmap::MarkDirtyChunksToUpdate(FScene* Scene, FViewInfo&
 	FIntVector NumChunksInXYZ = Int3Div(VolumeResolution, VolumeInfo.UpdateChunkResolution);
 	FIntVector DeltaChunk = VolumeInfo.DeltaChunk;
 
-	// 1. move pending dirty chunks that haven't been update
-	TArray<FUpdateChunk> DirtyChunks;
-	while (VolumeInfo.HasChunksToUpdate())
-	{
-		FUpdateChunk UpdateChunk;
-		VolumeInfo.PopUpdateChunk(UpdateChunk);
-		DirtyChunks.Add(UpdateChunk);
-	}
-	for (FUpdateChunk& DirtyChunk : DirtyChunks)
-	{
-		FIntVector ChunkIndex3D = Index1DTo3DLinear(DirtyChunk.Index1D, NumChunksInXYZ);
-		FIntVector MovedChunkIndex3D = ChunkIndex3D - DeltaChunk;
-
-		MovedChunkIndex3D.X = MovedChunkIndex3D.X % NumChunksInXYZ.X;
-		MovedChunkIndex3D.Y = MovedChunkIndex3D.Y % NumChunksInXYZ.Y;
-		MovedChunkIndex3D.Z = MovedChunkIndex3D.Z % NumChunksInXYZ.Z;
-
-		MovedChunkIndex3D.X += (MovedChunkIndex3D.X < 0) ? NumChunksInXYZ.X : 0;
-		MovedChunkIndex3D.Y += (MovedChunkIndex3D.Y < 0) ? NumChunksInXYZ.Y : 0;
-		MovedChunkIndex3D.Z += (MovedChunkIndex3D.Z < 0) ? NumChunksInXYZ.Z : 0;
-
-		// we don't record time stamp here, cause this chunk is added before
-		DirtyChunk.Index1D = Index3DTo1DLinear(MovedChunkIndex3D, NumChunksInXYZ);
-		VolumeInfo.PushUpdateChunk(DirtyChunk);
-	}
+	// 1. move pending dirty chunks that haven't been update, chunks are stored in toroidal address so only offset changes
+	// we don't record time stamp here, cause these chunks are added before
+	VolumeInfo.ScrollUpdateChunks(DeltaChunk);
 
 	// 2. mark XZ plane's new coming chunks as dirty if volume move along Y axis
 	// for 8x8x8 block, we may mark [0~8, 0~1, 0~8] as dirty when volume move 2 block in Y axis
@@ -660,9 +683,14 @@ void FRealtimeGIVoxelClipmap::MarkDirtyChunksToUpdate(FScene* Scene, FViewInfo&
 	MarkChunkPlaneAsDirty(2);	// move in Z, dirty in XY
 
 	// 3. mark chunks as dirty when primitive move
-	for (const FBoxSphereBounds& Bound : Scene->RealtimeGIScene.DirtyPrimitiveBounds)
+	// rasterize bounds to chunks in parallel, then push in order so update queue is deterministic
+	const TArray<FBoxSphereBounds>& DirtyPrimitiveBounds = Scene->RealtimeGIScene.DirtyPrimitiveBounds;
+	TArray<TArray<int32>> DirtyChunkIndices;
+	DirtyChunkIndices.SetNum(DirtyPrimitiveBounds.Num());
+
+	ParallelFor(DirtyPrimitiveBounds.Num(), [&](int32 BoundIndex)
 	{
-		const FBox& Box = Bound.GetBox();
+		const FBox& Box = DirtyPrimitiveBounds[BoundIndex].GetBox();
 		FVector BoxMin = Box.Min - VoxelGridSize * 2;	// a little padding
 		FVector BoxMax = Box.Max + VoxelGridSize * 2;
 		FIntVector MinCornerChunk = FIntVector(FloorToInt3((BoxMin - VolumeInfo.Center) / ChunkSize)) + (NumChunksInXYZ / 2);
@@ -671,19 +699,28 @@ void FRealtimeGIVoxelClipmap::MarkDirtyChunksToUpdate(FScene* Scene, FViewInfo&
 		MinCornerChunk = Int3Clamp(MinCornerChunk, FIntVector(0, 0, 0), NumChunksInXYZ - FIntVector(1, 1, 1));
 		MaxCornerChunk = Int3Clamp(MaxCornerChunk, FIntVector(0, 0, 0), NumChunksInXYZ - FIntVector(1, 1, 1));
 
+		TArray<int32>& ChunkIndices = DirtyChunkIndices[BoundIndex];
 		for (int32 X = MinCornerChunk.X; X <= MaxCornerChunk.X; X++)
 		{
 			for (int32 Y = MinCornerChunk.Y; Y <= MaxCornerChunk.Y; Y++)
 			{
 				for (int32 Z = MinCornerChunk.Z; Z <= MaxCornerChunk.Z; Z++)
 				{
-					FUpdateChunk DirtyChunk;
-					DirtyChunk.Index1D = Index3DTo1DLinear(FIntVector(X, Y, Z), NumChunksInXYZ);
-					DirtyChunk.TimeStamp = FrameNumberRenderThread;
-					VolumeInfo.PushUpdateChunk(DirtyChunk);
+					ChunkIndices.Add(Index3DTo1DLinear(FIntVector(X, Y, Z), NumChunksInXYZ));
 				}
 			}
 		}
+	});
+
+	for (const TArray<int32>& ChunkIndices : DirtyChunkIndices)
+	{
+		for (int32 ChunkIndex : ChunkIndices)
+		{
+			FUpdateChunk DirtyChunk;
+			DirtyChunk.Index1D = ChunkIndex;
+			DirtyChunk.TimeStamp = FrameNumberRenderThread;
+			VolumeInfo.PushUpdateChunk(DirtyChunk);
+		}
 	}
 }
 
@@ -696,15 +733,40 @@ void FRealtimeGIVoxelClipmap::PrepareRenderResources(FRDGBuilder& GraphBuilder,
 	const int32 CVarVolumeResolution = GetVolumeResolution(CVarVolumeResolutionLevel.GetValueOnRenderThread());
 	const int32 VolumeResolutionOld = VolumeResolution.X;
 
+	// the grow pass of last frame is done
+	if (RetiredVoxelPageFreeList.NumBytes > 0)
+	{
+		RetiredVoxelPageFreeList.Release();
+	}
+
+	// decide voxel pool size from page residency of a few frames ago, ignore stats written before last resize
+	const int32 PagesPerSlice = NumVoxelPagesInXYZ.X * NumVoxelPagesInXYZ.Y;
+	const int32 PagePoolMinSlices = FMath::Max(CVarVoxelPagePoolMinSlices.GetValueOnRenderThread(), 1);
+	const int32 PagePoolMaxSlices = FMath::Max(CVarVoxelPagePoolMaxSlices.GetValueOnRenderThread(), PagePoolMinSlices);
+	PagePoolSizer.SetLimits(PagesPerSlice, PagePoolMinSlices, PagePoolMaxSlices);
+	PagePoolSizer.ShrinkDelay = CVarVoxelPagePoolShrinkDelay.GetValueOnRenderThread();
+
+	int32 NumPagePoolSlices = FMath::Clamp(NumVoxelPagesInXYZ.Z, PagePoolMinSlices, PagePoolMaxSlices);
+	bool PagePoolOverflow = false;
+	FVoxelPageStats PageStats;
+	if (ReadbackVoxelPageStats(PageStats) && PageStats.NumPages == PagesPerSlice * NumVoxelPagesInXYZ.Z)
+	{
+		PagePoolOverflow = PageStats.NumRequestedPages > PageStats.NumPages;
+		NumPagePoolSlices = PagePoolSizer.Update(NumVoxelPagesInXYZ.Z, PageStats);
+	}
+
 	bool NeedResetVolume = false;
 	NeedResetVolume |= (NumClips == 0);
 	NeedResetVolume |= (NumClips != CVarNumClips);
 	NeedResetVolume |= (CellSizeOld != CVarCellSize);
 	NeedResetVolume |= (VolumeResolutionOld != CVarVolumeResolution);
+	NeedResetVolume |= (NumPagePoolSlices < NumVoxelPagesInXYZ.Z);	// allocated pages may lie in the removed slices
 
 	if (NeedResetVolume)
 	{
 		NumClips = CVarNumClips;
+		NumVoxelPagesInXYZ.Z = NumPagePoolSlices;
+		PagePoolSizer.Reset();
 		ClipmapInfos.SetNum(NumClips);
 		VolumeResolution = FIntVector(CVarVolumeResolution, CVarVolumeResolution, CVarVolumeResolution);
 
@@ -719,6 +781,7 @@ void FRealtimeGIVoxelClipmap::PrepareRenderResources(FRDGBuilder& GraphBuilder,
 			VolumeInfo.NumChunksInXYZ = NumChunksInXYZ;
 			VolumeInfo.CoverRange = FVector(VolumeResolution) * CVarCellSize * (1 << ClipId);
 			VolumeInfo.Scrolling = FIntVector(0, 0, 0);
+			VolumeInfo.InitUpdateChunks();
 
 			// mark all chunks as dirty
 			for (int32 ChunkId = 0; ChunkId < UpdateChunkNum; ChunkId++)
@@ -740,6 +803,10 @@ void FRealtimeGIVoxelClipmap::PrepareRenderResources(FRDGBuilder& GraphBuilder,
 			VoxelPageClipmap.PooledTexture = nullptr;
 		}
 	}
+	else if (NumPagePoolSlices > NumVoxelPagesInXYZ.Z)
+	{
+		GrowVoxelPagePool(GraphBuilder, Scene, NumPagePoolSlices, PagePoolOverflow);
+	}
 
 	const int32 MaxObjectNumPerClip = Scene->RealtimeGIScene.ObjectIdAllocator.GetMaxNumElements();
 	const int32 MaxUpdateChunkPerFrame = CVarNumChunksToUpdatePerFrame.GetValueOnRenderThread();
@@ -812,11 +879,11 @@ void FRealtimeGIVoxelClipmap::PrepareRenderResources(FRDGBuilder& GraphBuilder,
 		InitTexture3D(GraphBuilder, VoxelPageClipmap, ClipmapResolution, PAGE_ID_INVALID);
 	}
 
-	// @TODO: adaptive size, now for 128*128*128*4 clipmap we use 32x32x32 block pages (128x128x128 total)
-	Create3DTexFn(GraphBuilder, VoxelPoolBaseColor, NumVoxelPagesInXYZ * VOXEL_BLOCK_SIZE, PF_R8G8B8A8, TEXT("VoxelPoolBaseColor"));
-	Create3DTexFn(GraphBuilder, VoxelPoolNormal, NumVoxelPagesInXYZ * VOXEL_BLOCK_SIZE, PF_FloatRGB, TEXT("VoxelPoolNormal"));
-	Create3DTexFn(GraphBuilder, VoxelPoolEmissive, NumVoxelPagesInXYZ * VOXEL_BLOCK_SIZE, PF_FloatRGB, TEXT("VoxelPoolEmissive"));
-
+	// pool grow in z slices of 32x32 pages, see PagePoolSizer
+	// normal is octahedral encoded in RG8, emissive in R11G11B10
+	Grow3DTexFn(GraphBuilder, VoxelPoolBaseColor, NumVoxelPagesInXYZ * VOXEL_BLOCK_SIZE, PF_R8G8B8A8, TEXT("VoxelPoolBaseColor"));
+	Grow3DTexFn(GraphBuilder, VoxelPoolNormal, NumVoxelPagesInXYZ * VOXEL_BLOCK_SIZE, PF_R8G8, TEXT("VoxelPoolNormal"));
+	Grow3DTexFn(GraphBuilder, VoxelPoolEmissive, NumVoxelPagesInXYZ * VOXEL_BLOCK_SIZE, PF_FloatRGB, TEXT("VoxelPoolEmissive"));
 
 	// free list
 	const int32 NumPages = NumVoxelPagesInXYZ.X * NumVoxelPagesInXYZ.Y * NumVoxelPagesInXYZ.Z;
@@ -842,13 +909,18 @@ void FRealtimeGIVoxelClipmap::PrepareRenderResources(FRDGBuilder& GraphBuilder,
 		RHICmdList.UnlockStructuredBuffer(BufferRHI);
 	}
 
-	// release list
-	if (VoxelPageReleaseList.NumBytes == 0)
+	// release list, pointer is reset to zero every frame so content is not kept when pool size change
+	if (VoxelPageReleaseList.NumBytes != NumBytesFreeList)
 	{
 		VoxelPageReleaseList.Initialize(
 			sizeof(int32), NumElementsFreeList,
 			BUF_Static, TEXT("VoxelPageReleaseList")
 		);
+
+		FRHIStructuredBuffer* BufferRHI = VoxelPageReleaseList.Buffer;
+		void* MappedRawData = RHICmdList.LockStructuredBuffer(BufferRHI, 0, NumBytesFreeList, RLM_WriteOnly);
+		FMemory::Memzero(MappedRawData, NumBytesFreeList);
+		RHICmdList.UnlockStructuredBuffer(BufferRHI);
 	}
 
 	VoxelPageReleaseIndirectArgs = GraphBuilder.CreateBuffer(
@@ -864,7 +936,7 @@ void FRealtimeGIVoxelClipmap::UploadChunkIds(FRDGBuilder& GraphBuilder, FScene*
 
 	// 1. populate array
 	ClipmapInfo.PopulateUpdateChunkCleanupList(FrameNumberRenderThread);
-	ClipmapInfo.PopulateUpdateChunkList();
+	ClipmapInfo.PopulateUpdateChunkList(CVarNumChunksToUpdatePerFrame.GetValueOnRenderThread());
 
 	const TArray<int32>& ChunksToUpdate = ClipmapInfo.ChunksToUpdate;
 	const TArray<int32>& ChunksToCleanup = ClipmapInfo.ChunksToCleanup;
@@ -1085,6 +1157,12 @@ void FRealtimeGIVoxelClipmap::ReleaseVoxelPage(FRDGBuilder& GraphBuilder, FScene
 		TEXT("NumPagesToReleaseCounter")
 	);
 
+	// used pages, requested pages, capacity, see FVoxelPageStats
+	FRDGBufferRef VoxelPageStats = GraphBuilder.CreateBuffer(
+		FRDGBufferDesc::CreateBufferDesc(sizeof(int32), 3),
+		TEXT("VoxelPageStats")
+	);
+
 	// 1. build indirect dispatch args
 	{
 		TShaderMapRef<FBuildVoxelPageReleaseIndirectArgsCS> ComputeShader(GetGlobalShaderMap(Scene->GetFeatureLevel()));
@@ -1095,6 +1173,7 @@ void FRealtimeGIVoxelClipmap::ReleaseVoxelPage(FRDGBuilder& GraphBuilder, FScene
 		PassParameters->RWVoxelPageReleaseList = VoxelPageReleaseList.UAV;
 		PassParameters->RWNumPagesToReleaseCounter = GraphBuilder.CreateUAV(NumPagesToReleaseCounter);
 		PassParameters->RWIndirectArgs = GraphBuilder.CreateUAV(VoxelPageReleaseIndirectArgs);
+		PassParameters->RWVoxelPageStats = GraphBuilder.CreateUAV(VoxelPageStats, PF_R32_SINT);
 
 		FComputeShaderUtils::AddPass(
 			GraphBuilder, RDG_EVENT_NAME("BuildVoxelPageReleaseIndirectArgs"),
@@ -1115,6 +1194,92 @@ void FRealtimeGIVoxelClipmap::ReleaseVoxelPage(FRDGBuilder& GraphBuilder, FScene
 			GraphBuilder, RDG_EVENT_NAME("VoxelPageRelease"),
 			ComputeShader, PassParameters, VoxelPageReleaseIndirectArgs, 0);
 	}
+
+	// 3. copy page residency to cpu, skip when all readbacks are still in flight
+	if (NumPendingVoxelPageStatsReadbacks < VOXEL_PAGE_STATS_READBACK_NUM)
+	{
+		TUniquePtr<FRHIGPUBufferReadback>& Readback = VoxelPageStatsReadbacks[VoxelPageStatsReadbackWriteIndex];
+		if (!Readback.IsValid())
+		{
+			Readback = MakeUnique<FRHIGPUBufferReadback>(TEXT("VoxelPageStatsReadback"));
+		}
+
+		AddEnqueueCopyPass(GraphBuilder, Readback.Get(), VoxelPageStats, sizeof(int32) * 3);
+		VoxelPageStatsReadbackWriteIndex = (VoxelPageStatsReadbackWriteIndex + 1) % VOXEL_PAGE_STATS_READBACK_NUM;
+		NumPendingVoxelPageStatsReadbacks++;
+	}
+}
+
+bool FRealtimeGIVoxelClipmap::ReadbackVoxelPageStats(FVoxelPageStats& OutStats)
+{
+	bool HasStats = false;
+
+	// from oldest to newest, keep the newest one which is ready
+	while (NumPendingVoxelPageStatsReadbacks > 0)
+	{
+		const int32 ReadIndex = (VoxelPageStatsReadbackWriteIndex - NumPendingVoxelPageStatsReadbacks + VOXEL_PAGE_STATS_READBACK_NUM) % VOXEL_PAGE_STATS_READBACK_NUM;
+		FRHIGPUBufferReadback* Readback = VoxelPageStatsReadbacks[ReadIndex].Get();
+		if (!Readback->IsReady())
+		{
+			break;
+		}
+
+		const int32* Data = (const int32*)Readback->Lock(sizeof(int32) * 3);
+		OutStats.NumUsedPages = Data[0];
+		OutStats.NumRequestedPages = Data[1];
+		OutStats.NumPages = Data[2];
+		Readback->Unlock();
+
+		NumPendingVoxelPageStatsReadbacks--;
+		HasStats = true;
+	}
+
+	return HasStats;
+}
+
+void FRealtimeGIVoxelClipmap::GrowVoxelPagePool(FRDGBuilder& GraphBuilder, FScene* Scene, int32 NumSlices, bool MarkAllChunksDirty)
+{
+	check(NumSlices > NumVoxelPagesInXYZ.Z);
+
+	const int32 OldMaxPageNum = NumVoxelPagesInXYZ.X * NumVoxelPagesInXYZ.Y * NumVoxelPagesInXYZ.Z;
+	NumVoxelPagesInXYZ.Z = NumSlices;
+	const int32 MaxPageNum = NumVoxelPagesInXYZ.X * NumVoxelPagesInXYZ.Y * NumVoxelPagesInXYZ.Z;
+
+	// 1. new pages are appended to free list, pool textures are copied later with the same page address
+	// grow pass read old free list after setup, so keep it alive until next frame
+	RetiredVoxelPageFreeList = VoxelPageFreeList;
+	VoxelPageFreeList.Initialize(
+		sizeof(int32), MaxPageNum + 1,
+		BUF_Static, TEXT("VoxelPageFreeList")
+	);
+
+	TShaderMapRef<FGrowVoxelPageFreeListCS> ComputeShader(GetGlobalShaderMap(Scene->GetFeatureLevel()));
+	auto* PassParameters = GraphBuilder.AllocParameters<FGrowVoxelPageFreeListCS::FParameters>();
+	PassParameters->NumVoxelPagesInXYZ = NumVoxelPagesInXYZ;
+	PassParameters->OldMaxPageNum = OldMaxPageNum;
+	PassParameters->OldVoxelPageFreeList = RetiredVoxelPageFreeList.SRV;
+	PassParameters->RWVoxelPageFreeList = VoxelPageFreeList.UAV;
+
+	FComputeShaderUtils::AddPass(
+		GraphBuilder, RDG_EVENT_NAME("GrowVoxelPageFreeList %d -> %d", OldMaxPageNum, MaxPageNum),
+		ComputeShader, PassParameters, FIntVector(FMath::DivideAndRoundUp(MaxPageNum + 1, (int32)FGrowVoxelPageFreeListCS::ThreadGroupSizeX), 1, 1));
+
+	// 2. voxels dropped when pool was full are injected again
+	// don't stamp with current frame, so these chunks are not cleaned up
+	if (MarkAllChunksDirty)
+	{
+		for (FRealtimeGIVolumeInfo& VolumeInfo : ClipmapInfos)
+		{
+			const int32 UpdateChunkNum = VolumeInfo.NumChunksInXYZ.X * VolumeInfo.NumChunksInXYZ.Y * VolumeInfo.NumChunksInXYZ.Z;
+			for (int32 ChunkId = 0; ChunkId < UpdateChunkNum; ChunkId++)
+			{
+				FUpdateChunk DirtyChunk;
+				DirtyChunk.Index1D = ChunkId;
+				DirtyChunk.TimeStamp = 0;
+				VolumeInfo.PushUpdateChunk(DirtyChunk);
+			}
+		}
+	}
 }
 
 void FRealtimeGIVoxelClipmap::DistanceFieldPropagate(FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View, int32 ClipId)
@@ -3,14 +3,12 @@
 #include "CoreMinimal.h"
 #include "RendererInterface.h"
 #include "MeshPassProcessor.h"
-#include <deque>
 #include "RealtimeGIShared.h"
+#include "RealtimeGIDirtyChunks.h"
+#include "RealtimeGIPagePoolSizer.h"
+#include "RHIGPUReadback.h"
 
-struct FUpdateChunk
-{
-	int32 Index1D = 0;
-	uint32 TimeStamp = 0;
-};
+#define VOXEL_PAGE_STATS_READBACK_NUM (4)
 
 class FRealtimeGIVolumeInfo
 {
@@ -18,11 +16,12 @@ public:
 	FRealtimeGIVolumeInfo() {};
 	~FRealtimeGIVolumeInfo() {};
 
-	bool HasChunksToUpdate();
-	bool PopUpdateChunk(FUpdateChunk& OutElement);
+	void InitUpdateChunks();
+	bool HasChunksToUpdate() const;
 	void PushUpdateChunk(const FUpdateChunk& InElement);
+	void ScrollUpdateChunks(const FIntVector& InDeltaChunk);
 
-	void PopulateUpdateChunkList();
+	void PopulateUpdateChunkList(int32 MaxUpdateChunkPerFrame);
 	void PopulateUpdateChunkCleanupList(uint32 FrameIndex);
 
 	FVector Center;
@@ -36,8 +35,7 @@ public:
 	TArray<int32> ChunksToCleanup;	// chunks to cleanup, when a chunk dirty it will be clean at cur frame
 
 protected:
-	std::deque<FUpdateChunk> PendingUpdateChunks;
-	TSet<int32> UpdateChunksLookUp;
+	FRealtimeGIDirtyChunks PendingUpdateChunks;
 };
 
 // per View's data
@@ -61,6 +59,11 @@ public:
 
 	FVoxelRaytracingParameters SetupVoxelRaytracingParameters(FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View, int32 ClipId = 0);
 
+	uint64 GetGPUMemorySize() const;
+
+	// clipmap follow this position instead of view location, it's the average location when several views share one clipmap
+	FVector ClipmapOrigin = FVector::ZeroVector;
+
 protected:
 	void UpdateVolumePosition(FViewInfo& View, int32 ClipId);
 	void MarkDirtyChunksToUpdate(FScene* Scene, FViewInfo& View, int32 ClipId);
@@ -71,6 +74,8 @@ protected:
 	void VoxelInject(FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View, int32 ClipId);
 	void DistanceFieldPropagate(FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View, int32 ClipId);
 	void ReleaseVoxelPage(FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View);
+	bool ReadbackVoxelPageStats(FVoxelPageStats& OutStats);
+	void GrowVoxelPagePool(FRDGBuilder& GraphBuilder, FScene* Scene, int32 NumSlices, bool MarkAllChunksDirty);
 
 	FPersistentTexture& GetDistanceFieldClipmap() { return DistanceFieldClipmap[(FrameNumberRenderThread + 0) % 2]; };
 	FPersistentTexture& GetDistanceFieldClipmapNextFrame() { return DistanceFieldClipmap[(FrameNumberRenderThread + 1) % 2]; };
@@ -102,12 +107,20 @@ protected:
 	// last element in list is pointer to next read write position
 	FRWBufferStructured VoxelPageFreeList;		// empty page id list
 	FRWBufferStructured VoxelPageReleaseList;	// pending pages to release at this frame
+	FRWBufferStructured RetiredVoxelPageFreeList;	// free list before pool grow, keep it until grow pass is done
 	FRDGBufferRef VoxelPageReleaseIndirectArgs;
 
+	// page residency is read back a few frames later, then pool grow or shrink in z slices
+	TUniquePtr<FRHIGPUBufferReadback> VoxelPageStatsReadbacks[VOXEL_PAGE_STATS_READBACK_NUM];
+	int32 VoxelPageStatsReadbackWriteIndex = 0;
+	int32 NumPendingVoxelPageStatsReadbacks = 0;
+	FRealtimeGIPagePoolSizer PagePoolSizer;
+
 	// sparse store per-voxel material attribute, all clips share same physic texture
 	// note: per-mesh material attribute is store in surface cache atlas, like BLAS
 	// voxel pool will store per-instance material attribute, like TLAS
-	FIntVector NumVoxelPagesInXYZ = FIntVector(32, 32, 32);
+	// z is number of slices, decided by PagePoolSizer
+	FIntVector NumVoxelPagesInXYZ = FIntVector(32, 32, 0);
 	FPersistentTexture VoxelPoolBaseColor;
 	FPersistentTexture VoxelPoolNormal;
 	FPersistentTexture VoxelPoolEmissive;
@@ -94,6 +94,10 @@ static TAutoConsoleVariable<float> CVarIrradianceProbeTemporalWeight(
 	ECVF_RenderThreadSafe
 );
 
+DECLARE_GPU_STAT(RealtimeGIVoxelLighting);
+DECLARE_GPU_STAT(RealtimeGIRadianceCacheVoxel);
+DECLARE_GPU_STAT(RealtimeGIRadianceCacheProbe);
+
 TGlobalResource<StencilingGeometry::TStencilSphereVertexBuffer<18, 12, FVector4>> GSphereVertexBuffer;
 TGlobalResource<StencilingGeometry::TStencilSphereIndexBuffer<18, 12>> GSphereIndexBuffer;
 
@@ -695,6 +699,21 @@ FProbeVolumeParameters FRealtimeGIRadianceCache::SetupProbeVolumeParameters(FRDG
 	return PassParameters;
 }
 
+uint64 FRealtimeGIRadianceCache::GetGPUMemorySize() const
+{
+	uint64 Size = 0;
+	Size += GetPersistentTextureSize(VoxelPoolRadiance);
+	Size += GetPersistentTextureSize(ProbeOffsetClipmap);
+	Size += GetPersistentTextureSize(IrradianceProbeClipmap);
+	Size += GetPersistentTextureSize(RadianceProbeAtlas);
+	Size += GetPersistentTextureSize(RadianceProbeDistanceAtlas);
+	Size += GetPersistentTextureSize(RadianceProbeOutput);
+	Size += GetPersistentTextureSize(RadianceProbeDistanceOutput);
+	Size += GetPersistentTextureSize(RadianceProbeIdClipmap);
+	Size += RadianceProbeFreeList.NumBytes + RadianceProbeReleaseList.NumBytes;
+	return Size;
+}
+
 void FRealtimeGIRadianceCache::Update(FRDGBuilder& GraphBuilder, FSceneRenderer& SceneRenderer, FScene* Scene, FViewInfo& View)
 {
 	FRealtimeGIGPUScene& VoxelScene = Scene->RealtimeGIScene;
@@ -702,6 +721,15 @@ void FRealtimeGIRadianceCache::Update(FRDGBuilder& GraphBuilder, FSceneRenderer&
 
 	PrepareRenderResources(GraphBuilder, Scene, View);
 
+	ComputePassFlags = RealtimeGIUseAsyncCompute() ? ERDGPassFlags::AsyncCompute : ERDGPassFlags::Compute;
+
+	// shadow depths and cleanup lists are not tracked by RDG, a counter clear on graphics pipe is the explicit fork point,
+	// so async chain never start before them. screen gather join back by reading probe and radiance textures
+	if (ComputePassFlags == ERDGPassFlags::AsyncCompute)
+	{
+		ClearCounterBuffer(GraphBuilder, Scene, ValidVoxelCounter, 1, ERDGPassFlags::Compute);
+	}
+
 	const int32 ClipIdMax = VoxelClipmap->NumClips - 1;
 	for (int32 ClipId = ClipIdMax; ClipId >= 0; ClipId -= 1)
 	{
@@ -713,11 +741,17 @@ void FRealtimeGIRadianceCache::Update(FRDGBuilder& GraphBuilder, FSceneRenderer&
 			continue;
 		}
 
-		CleanupDirtyUpdateChunk(GraphBuilder, Scene, View, ClipId);
+		{
+			RDG_GPU_STAT_SCOPE(GraphBuilder, RealtimeGIRadianceCacheVoxel);
+
+			CleanupDirtyUpdateChunk(GraphBuilder, Scene, View, ClipId);
 
-		PickValidVoxel(GraphBuilder, Scene, View, ClipId);
+			PickValidVoxel(GraphBuilder, Scene, View, ClipId);
 
-		VoxelLighting(GraphBuilder, SceneRenderer, Scene, View, ClipId);
+			VoxelLighting(GraphBuilder, SceneRenderer, Scene, View, ClipId);
+		}
+
+		RDG_GPU_STAT_SCOPE(GraphBuilder, RealtimeGIRadianceCacheProbe);
 
 		PickValidProbe(GraphBuilder, Scene, View, ClipId);
 
@@ -746,7 +780,7 @@ void FRealtimeGIRadianceCache::PrepareRenderResources(FRDGBuilder& GraphBuilder,
 	const FIntVector NumPagesInXYZ = View.RealtimeGIVoxelClipmap->NumVoxelPagesInXYZ;
 	FIntVector PoolSize = NumPagesInXYZ * VOXEL_BLOCK_SIZE;
 	PoolSize.Z *= 2;	// for two side voxel
-	Create3DTexFn(GraphBuilder, VoxelPoolRadiance, PoolSize, PF_FloatRGB, TEXT("VoxelPoolRadiance"));
+	Grow3DTexFn(GraphBuilder, VoxelPoolRadiance, PoolSize, PF_FloatRGB, TEXT("VoxelPoolRadiance"));
 
 	ValidVoxelCounter = GraphBuilder.CreateBuffer(
 		FRDGBufferDesc::CreateStructuredDesc(sizeof(int32), 1),
@@ -853,7 +887,7 @@ void FRealtimeGIRadianceCache::PrepareRenderResources(FRDGBuilder& GraphBuilder,
 
 void FRealtimeGIRadianceCache::PickValidVoxel(FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View, int32 ClipId)
 {
-	ClearCounterBuffer(GraphBuilder, Scene, ValidVoxelCounter, 1);
+	ClearCounterBuffer(GraphBuilder, Scene, ValidVoxelCounter, 1, ComputePassFlags);
 
 	FRealtimeGIGPUScene& VoxelScene = Scene->RealtimeGIScene;
 	FRealtimeGIVoxelClipmap* VoxelClipmap = View.RealtimeGIVoxelClipmap;
@@ -884,7 +918,7 @@ void FRealtimeGIRadianceCache::PickValidVoxel(FRDGBuilder& GraphBuilder, FScene*
 	);
 
 	FComputeShaderUtils::AddPass(
-		GraphBuilder, RDG_EVENT_NAME("PickValidVoxel"),
+		GraphBuilder, RDG_EVENT_NAME("PickValidVoxel"), ComputePassFlags,
 		ComputeShader, PassParameters, NumGroups
 	);
 }
@@ -922,7 +956,7 @@ void FRealtimeGIRadianceCache::VoxelLighting(FRDGBuilder& GraphBuilder, FSceneRe
 		PassParameters->RWIndirectArgs = GraphBuilder.CreateUAV(VoxelLightingIndirectArgs);
 
 		FComputeShaderUtils::AddPass(
-			GraphBuilder, RDG_EVENT_NAME("BuildVoxelLightingIndirectArgs"),
+			GraphBuilder, RDG_EVENT_NAME("BuildVoxelLightingIndirectArgs"), ComputePassFlags,
 			ComputeShader, PassParameters, FIntVector(1, 1, 1));
 	}
 
@@ -959,14 +993,14 @@ void FRealtimeGIRadianceCache::VoxelLighting(FRDGBuilder& GraphBuilder, FSceneRe
 		PassParameters->IndirectArgsBuffer = VoxelLightingIndirectArgs;
 
 		FComputeShaderUtils::AddPass(
-			GraphBuilder, RDG_EVENT_NAME("VoxelLighting"),
+			GraphBuilder, RDG_EVENT_NAME("VoxelLighting"), ComputePassFlags,
 			ComputeShader, PassParameters, VoxelLightingIndirectArgs, 0);
 	}
 }
 
 void FRealtimeGIRadianceCache::PickValidProbe(FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View, int32 ClipId)
 {
-	ClearCounterBuffer(GraphBuilder, Scene, ValidProbeCounter, 1);
+	ClearCounterBuffer(GraphBuilder, Scene, ValidProbeCounter, 1, ComputePassFlags);
 
 	FRealtimeGIGPUScene& VoxelScene = Scene->RealtimeGIScene;
 	FRealtimeGIVoxelClipmap* VoxelClipmap = View.RealtimeGIVoxelClipmap;
@@ -998,7 +1032,7 @@ void FRealtimeGIRadianceCache::PickValidProbe(FRDGBuilder& GraphBuilder, FScene*
 	);
 
 	FComputeShaderUtils::AddPass(
-		GraphBuilder, RDG_EVENT_NAME("PickValidProbe"),
+		GraphBuilder, RDG_EVENT_NAME("PickValidProbe"), ComputePassFlags,
 		ComputeShader, PassParameters, NumGroups
 	);
 }
@@ -1046,7 +1080,7 @@ void FRealtimeGIRadianceCache::RadianceProbeCapture(FRDGBuilder& GraphBuilder, F
 		);
 
 		FComputeShaderUtils::AddPass(
-			GraphBuilder, RDG_EVENT_NAME("RadianceProbeAllocate"),
+			GraphBuilder, RDG_EVENT_NAME("RadianceProbeAllocate"), ComputePassFlags,
 			ComputeShader, PassParameters, NumGroups
 		);
 	}
@@ -1070,7 +1104,7 @@ void FRealtimeGIRadianceCache::RadianceProbeCapture(FRDGBuilder& GraphBuilder, F
 
 		const FIntVector NumGroups = FIntVector(1, 1, 1);
 		FComputeShaderUtils::AddPass(
-			GraphBuilder, RDG_EVENT_NAME("BuildRadianceProbeReleaseAndCaptureIndirectArgs"),
+			GraphBuilder, RDG_EVENT_NAME("BuildRadianceProbeReleaseAndCaptureIndirectArgs"), ComputePassFlags,
 			ComputeShader, PassParameters, NumGroups
 		);
 	}
@@ -1086,7 +1120,7 @@ void FRealtimeGIRadianceCache::RadianceProbeCapture(FRDGBuilder& GraphBuilder, F
 		PassParameters->IndirectArgsBuffer = RadianceProbeReleaseIndirectArgs;
 
 		FComputeShaderUtils::AddPass(
-			GraphBuilder, RDG_EVENT_NAME("RadianceProbeRelease"),
+			GraphBuilder, RDG_EVENT_NAME("RadianceProbeRelease"), ComputePassFlags,
 			ComputeShader, PassParameters, RadianceProbeReleaseIndirectArgs, 0
 		);
 	}
@@ -1110,7 +1144,7 @@ void FRealtimeGIRadianceCache::RadianceProbeCapture(FRDGBuilder& GraphBuilder, F
 		NumPixelsToUpdateInXYZ.Y *= RadianceProbeResolution;
 
 		FComputeShaderUtils::AddPass(
-			GraphBuilder, RDG_EVENT_NAME("RadianceProbeRaytracing"),
+			GraphBuilder, RDG_EVENT_NAME("RadianceProbeRaytracing"), ComputePassFlags,
 			ComputeShader, PassParameters, RadianceProbeCaptureIndirectArgs, 0
 		);
 	}
@@ -1133,7 +1167,7 @@ void FRealtimeGIRadianceCache::RadianceProbeCapture(FRDGBuilder& GraphBuilder, F
 		NumPixelsToUpdateInXYZ.Y *= RadianceProbeResolution;
 
 		FComputeShaderUtils::AddPass(
-			GraphBuilder, RDG_EVENT_NAME("RadianceProbeOutputMerge"),
+			GraphBuilder, RDG_EVENT_NAME("RadianceProbeOutputMerge"), ComputePassFlags,
 			ComputeShader, PassParameters, RadianceProbeOutputMergeIndirectArgs, 0
 		);
 	}
@@ -1153,7 +1187,7 @@ void FRealtimeGIRadianceCache::RadianceToIrradiance(FRDGBuilder& GraphBuilder, F
 		PassParameters->RWIndirectArgs = GraphBuilder.CreateUAV(IrradianceProbeGatherIndirectArgs);
 
 		FComputeShaderUtils::AddPass(
-			GraphBuilder, RDG_EVENT_NAME("BuildRadianceToIrradianceIndirectArgs"),
+			GraphBuilder, RDG_EVENT_NAME("BuildRadianceToIrradianceIndirectArgs"), ComputePassFlags,
 			ComputeShader, PassParameters, FIntVector(1, 1, 1));
 	}
 
@@ -1172,7 +1206,7 @@ void FRealtimeGIRadianceCache::RadianceToIrradiance(FRDGBuilder& GraphBuilder, F
 		PassParameters->IndirectArgsBuffer = IrradianceProbeGatherIndirectArgs;
 
 		FComputeShaderUtils::AddPass(
-			GraphBuilder, RDG_EVENT_NAME("RadianceToIrradiance"),
+			GraphBuilder, RDG_EVENT_NAME("RadianceToIrradiance"), ComputePassFlags,
 			ComputeShader, PassParameters, IrradianceProbeGatherIndirectArgs, 0
 		);
 	}
@@ -1192,7 +1226,7 @@ void FRealtimeGIRadianceCache::IrradianceProbeGather(FRDGBuilder& GraphBuilder,
 		PassParameters->RWIndirectArgs = GraphBuilder.CreateUAV(IrradianceProbeGatherIndirectArgs);
 
 		FComputeShaderUtils::AddPass(
-			GraphBuilder, RDG_EVENT_NAME("BuildIrradianceProbeGatherIndirectArgs"),
+			GraphBuilder, RDG_EVENT_NAME("BuildIrradianceProbeGatherIndirectArgs"), ComputePassFlags,
 			ComputeShader, PassParameters, FIntVector(1, 1, 1));
 	}
 
@@ -1222,7 +1256,7 @@ void FRealtimeGIRadianceCache::IrradianceProbeGather(FRDGBuilder& GraphBuilder,
 		PassParameters->IndirectArgsBuffer = IrradianceProbeGatherIndirectArgs;
 
 		FComputeShaderUtils::AddPass(
-			GraphBuilder, RDG_EVENT_NAME("IrradianceProbeGather"),
+			GraphBuilder, RDG_EVENT_NAME("IrradianceProbeGather"), ComputePassFlags,
 			ComputeShader, PassParameters, IrradianceProbeGatherIndirectArgs, 0
 		);
 	}
@@ -1260,7 +1294,7 @@ void FRealtimeGIRadianceCache::CleanupDirtyUpdateChunk(FRDGBuilder& GraphBuilder
 		NumGroups.X *= NumDirtyChunks;	// we flatten chunks in x
 
 		FComputeShaderUtils::AddPass(
-			GraphBuilder, RDG_EVENT_NAME("ClearDirtyVoxelRadiance"),
+			GraphBuilder, RDG_EVENT_NAME("ClearDirtyVoxelRadiance"), ComputePassFlags,
 			ComputeShader, PassParameters, NumGroups
 		);
 	}
@@ -1283,7 +1317,7 @@ void FRealtimeGIRadianceCache::CleanupDirtyUpdateChunk(FRDGBuilder& GraphBuilder
 		NumGroups.X *= NumDirtyChunks;	// we flatten chunks in x
 
 		FComputeShaderUtils::AddPass(
-			GraphBuilder, RDG_EVENT_NAME("ClearDirtyProbeIrradiance"),
+			GraphBuilder, RDG_EVENT_NAME("ClearDirtyProbeIrradiance"), ComputePassFlags,
 			ComputeShader, PassParameters, NumGroups
 		);
 	}
@@ -1358,13 +1392,16 @@ void FRealtimeGIRadianceCache::VisualizeProbe(
 
 extern void RealtimeGIVoxelLighting(FRDGBuilder& GraphBuilder, FSceneRenderer& SceneRenderer, FScene* Scene, TArray<FViewInfo>& Views)
 {
-	RDG_EVENT_SCOPE(GraphBuilder, "RealtimeGIVoxelLighting");
-	DECLARE_GPU_STAT(RealtimeGIVoxelLighting);
+	RDG_EVENT_SCOPE(GraphBuilder, "RealtimeGIVoxelLighting%s", RealtimeGIUseAsyncCompute() ? TEXT("(AsyncCompute)") : TEXT(""));
 	RDG_GPU_STAT_SCOPE(GraphBuilder, RealtimeGIVoxelLighting);
 
 	for (FViewInfo& View : Views)
 	{
-		View.RealtimeGIRadianceCache->Update(GraphBuilder, SceneRenderer, Scene, View);
+		// views sharing a clipmap share the radiance cache too
+		if (View.bRealtimeGIClipmapOwner)
+		{
+			View.RealtimeGIRadianceCache->Update(GraphBuilder, SceneRenderer, Scene, View);
+		}
 	}
 }
 
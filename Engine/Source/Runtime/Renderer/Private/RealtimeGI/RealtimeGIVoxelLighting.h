@@ -32,6 +32,8 @@ public:
 
 	FProbeVolumeParameters SetupProbeVolumeParameters(FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View, int32 ClipId = 0);
 
+	uint64 GetGPUMemorySize() const;
+
 protected:
 	void PrepareRenderResources(FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View);
 	void PickValidVoxel(FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View, int32 ClipId);
@@ -42,6 +44,9 @@ protected:
 	void IrradianceProbeGather(FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View, int32 ClipId);
 	void CleanupDirtyUpdateChunk(FRDGBuilder& GraphBuilder, FScene* Scene, FViewInfo& View, int32 ClipId);
 
+	// Compute or AsyncCompute, chosen at each update
+	ERDGPassFlags ComputePassFlags = ERDGPassFlags::Compute;
+
 	int32 VoxelLightingCheckerBoardSize = 2;
 	FRDGBufferRef ValidVoxelCounter;
 	FRDGBufferRef ValidVoxelBuffer;
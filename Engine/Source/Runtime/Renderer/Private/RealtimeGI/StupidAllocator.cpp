@@ -1,188 +1,370 @@
 #include "StupidAllocator.h"
+#include "Algo/BinarySearch.h"
 
-#define NODE_INDEX_ROOT (0)
-#define INVALID_NODE (FStupidQuadTreeNode());
+// non-empty shelf can hold tile whose height is in [ShelfHeight / SHELF_HEIGHT_TOLERANCE, ShelfHeight]
+#define SHELF_HEIGHT_TOLERANCE (1.5f)
 
-bool IsNodeValid(const FStupidQuadTreeNode& InNode)
-{
-	return InNode.Size > 0;
-}
+// only defragment shelf whose occupancy is lower than this
+#define SHELF_DEFRAG_OCCUPANCY (0.5f)
 
-void FStupidQuadTreeAllocator::Init(int32 InAtlasResolution)
+void FGIAtlasAllocator::Init(int32 InAtlasResolution)
 {
 	if (AtlasResolution == 0)
 	{
 		AtlasResolution = InAtlasResolution;
-
-		// 64 + 16 + 4 + 1
-		int32 NumNodes = 0;
-		const int32 MinLevelNodeNum = FMath::Pow(AtlasResolution / MinNodeSize, 2);
-		for (int32 i = MinLevelNodeNum; i >= 1; i /= 4)
-		{
-			NumNodes += i;
-		}
-
-		NodeAllocationInfos.SetNum(NumNodes);
+		NextShelfY = 0;
+		AllocatedTexels = 0;
+		Shelves.Empty();
+		SpareSpans.Empty();
+
+		// a shelf is at least TileAlignment high, so this bound never grows
+		Shelves.Reserve(AtlasResolution / TileAlignment);
+		SpareSpans.Reserve(AtlasResolution / TileAlignment);
 	}
 
 	// @TODO: change size
 }
 
-void FStupidQuadTreeAllocator::ReleaseElement(const FStupidQuadTreeNode& FreeNode)
+FGIAtlasAllocator::FShelf FGIAtlasAllocator::MakeShelf(int32 Y, int32 Height)
 {
-	// invalid node
-	if (FreeNode.Size == 0)
+	FShelf Shelf;
+	Shelf.Y = Y;
+	Shelf.Height = Height;
+	if (SpareSpans.Num() > 0)
 	{
-		return;
+		Shelf.Spans = SpareSpans.Pop(false);
 	}
-
-	FStupidQuadTreeNode RootNode = GetRootNode();
-	ReleaseElementRecursive(RootNode, FreeNode);
+	else
+	{
+		Shelf.Spans.Reserve(GetMaxSpansPerShelf());
+	}
+	return Shelf;
 }
 
-FStupidQuadTreeNode FStupidQuadTreeAllocator::AllocateElement(int32 TargetSize)
+void FGIAtlasAllocator::RemoveShelf(int32 ShelfIndex)
 {
-	FStupidQuadTreeNode RootNode = GetRootNode();
+	TArray<FTileSpan>& Spans = Shelves[ShelfIndex].Spans;
+	Spans.Reset();
+	SpareSpans.Add(MoveTemp(Spans));
+	Shelves.RemoveAt(ShelfIndex, 1, false);
+}
 
-	FStupidQuadTreeNode Result = AllocateElementRecursive(RootNode, TargetSize);
+FIntPoint FGIAtlasAllocator::AlignTileSize(FIntPoint TargetSize) const
+{
+	FIntPoint Result;
+	Result.X = FMath::Max(Align(TargetSize.X, TileAlignment), TileAlignment);
+	Result.Y = FMath::Max(Align(TargetSize.Y, TileAlignment), TileAlignment);
 	return Result;
 }
 
-FStupidQuadTreeNode FStupidQuadTreeAllocator::GetRootNode()
+int32 FGIAtlasAllocator::FindShelf(int32 Y) const
 {
-	FStupidQuadTreeNode RootNode;
-	RootNode.Index = NODE_INDEX_ROOT;
-	RootNode.Size = AtlasResolution;
-	RootNode.Min = FIntPoint(0, 0);
-	RootNode.Max = FIntPoint(AtlasResolution, AtlasResolution);
-	RootNode.Center = (RootNode.Max + RootNode.Min) / 2;
-
-	return RootNode;
+	int32 Low = 0;
+	int32 High = Shelves.Num() - 1;
+	while (Low <= High)
+	{
+		const int32 Mid = (Low + High) / 2;
+		if (Shelves[Mid].Y == Y)
+		{
+			return Mid;
+		}
+
+		if (Shelves[Mid].Y < Y)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid - 1;
+		}
+	}
+
+	return INDEX_NONE;
 }
 
-TArray<FStupidQuadTreeNode> GetChildNodes(const FStupidQuadTreeNode& ParentNode)
+int32 FGIAtlasAllocator::FindGapInShelf(const FShelf& Shelf, int32 Width, int32& OutSpanIndex) const
 {
-	const int32 HalfSize = ParentNode.Size / 2;
-	const int32 NextLevelNodeIndexBase = ParentNode.Index * 4 + 1;
-
-	FStupidQuadTreeNode TopLeft;
-	TopLeft.Index = NextLevelNodeIndexBase + TC_TopLeft;
-	TopLeft.Size = HalfSize;
-	TopLeft.Min = ParentNode.Min + FIntPoint(0, 0) * HalfSize;
-	TopLeft.Max = ParentNode.Min + FIntPoint(1, 1) * HalfSize;
-	TopLeft.Center = (TopLeft.Max + TopLeft.Min) / 2;
-
-	FStupidQuadTreeNode TopRight;
-	TopRight.Index = NextLevelNodeIndexBase + TC_TopRight;
-	TopRight.Size = HalfSize;
-	TopRight.Min = ParentNode.Min + FIntPoint(1, 0) * HalfSize;
-	TopRight.Max = ParentNode.Min + FIntPoint(2, 1) * HalfSize;
-	TopRight.Center = (TopRight.Max + TopRight.Min) / 2;
-
-	FStupidQuadTreeNode BottomLeft;
-	BottomLeft.Index = NextLevelNodeIndexBase + TC_BottomLeft;
-	BottomLeft.Size = HalfSize;
-	BottomLeft.Min = ParentNode.Min + FIntPoint(0, 1) * HalfSize;
-	BottomLeft.Max = ParentNode.Min + FIntPoint(1, 2) * HalfSize;
-	BottomLeft.Center = (BottomLeft.Max + BottomLeft.Min) / 2;
-
-	FStupidQuadTreeNode BottomRight;
-	BottomRight.Index = NextLevelNodeIndexBase + TC_BottomRight;
-	BottomRight.Size = HalfSize;
-	BottomRight.Min = ParentNode.Min + FIntPoint(1, 1) * HalfSize;
-	BottomRight.Max = ParentNode.Min + FIntPoint(2, 2) * HalfSize;
-	BottomRight.Center = (BottomRight.Max + BottomRight.Min) / 2;
-
-	TArray<FStupidQuadTreeNode> Result;
-	Result.Add(TopLeft);
-	Result.Add(TopRight);
-	Result.Add(BottomLeft);
-	Result.Add(BottomRight);
-	return Result;
+	// not enough space even if all gaps are merged
+	if (AtlasResolution - Shelf.UsedWidth < Width)
+	{
+		return INDEX_NONE;
+	}
+
+	// first fit
+	int32 Cursor = 0;
+	for (int32 SpanIndex = 0; SpanIndex < Shelf.Spans.Num(); SpanIndex++)
+	{
+		const FTileSpan& Span = Shelf.Spans[SpanIndex];
+		if (Span.X - Cursor >= Width)
+		{
+			OutSpanIndex = SpanIndex;
+			return Cursor;
+		}
+		Cursor = Span.X + Span.Width;
+	}
+
+	if (AtlasResolution - Cursor >= Width)
+	{
+		OutSpanIndex = Shelf.Spans.Num();
+		return Cursor;
+	}
+
+	return INDEX_NONE;
 }
 
-void FStupidQuadTreeAllocator::UpdateAllocationInfoFromChild(const FStupidQuadTreeNode& ParentNode)
+FGIAtlasTile FGIAtlasAllocator::AllocateInShelf(int32 ShelfIndex, FIntPoint AlignedSize, int32 Owner)
 {
-	FNodeAllocationInfo& Parent = NodeAllocationInfos[ParentNode.Index];
+	FShelf& Shelf = Shelves[ShelfIndex];
+	check(Shelf.Height >= AlignedSize.Y);
 
-	const int32 NextLevelNodeIndexBase = ParentNode.Index * 4 + 1;
-	const FNodeAllocationInfo& Child0 = NodeAllocationInfos[NextLevelNodeIndexBase + 0];
-	const FNodeAllocationInfo& Child1 = NodeAllocationInfos[NextLevelNodeIndexBase + 1];
-	const FNodeAllocationInfo& Child2 = NodeAllocationInfos[NextLevelNodeIndexBase + 2];
-	const FNodeAllocationInfo& Child3 = NodeAllocationInfos[NextLevelNodeIndexBase + 3];
+	int32 SpanIndex = INDEX_NONE;
+	const int32 X = FindGapInShelf(Shelf, AlignedSize.X, SpanIndex);
+	if (X == INDEX_NONE)
+	{
+		return FGIAtlasTile();
+	}
 
-	bool IsAllChildsEmpty = Child0.IsEmpty && Child1.IsEmpty && Child2.IsEmpty && Child3.IsEmpty;
-	bool IsAllChildsFull = Child0.IsFull && Child1.IsFull && Child2.IsFull && Child3.IsFull;
+	FTileSpan Span;
+	Span.X = X;
+	Span.Width = AlignedSize.X;
+	Span.Height = AlignedSize.Y;
+	Span.Owner = Owner;
+	Shelf.Spans.Insert(Span, SpanIndex);
+	Shelf.UsedWidth += AlignedSize.X;
 
-	Parent.IsEmpty = IsAllChildsEmpty;
-	Parent.IsFull = IsAllChildsFull;
+	AllocatedTexels += AlignedSize.X * AlignedSize.Y;
+
+	FGIAtlasTile Result;
+	Result.Min = FIntPoint(X, Shelf.Y);
+	Result.Size = AlignedSize;
+	return Result;
 }
 
-FStupidQuadTreeNode FStupidQuadTreeAllocator::AllocateElementRecursive(const FStupidQuadTreeNode& CurLevelNode, int32 TargetSize)
+FGIAtlasTile FGIAtlasAllocator::AllocateInternal(FIntPoint AlignedSize, int32 Owner, int32 MaxShelfY, bool AllowNewShelf)
 {
-	FNodeAllocationInfo& NodeAllocationInfo = NodeAllocationInfos[CurLevelNode.Index];
+	const int32 MaxShelfHeight = FMath::CeilToInt(AlignedSize.Y * SHELF_HEIGHT_TOLERANCE);
+	int32 BestEmptyShelf = INDEX_NONE;
+	int32 FallbackShelf = INDEX_NONE;
 
-	if (NodeAllocationInfo.IsFull)
+	// 1. best fit in non-empty shelves with similar height, remember candidates for later steps
+	int32 BestShelf = INDEX_NONE;
+	for (int32 ShelfIndex = 0; ShelfIndex < Shelves.Num(); ShelfIndex++)
 	{
-		return INVALID_NODE;
+		const FShelf& Shelf = Shelves[ShelfIndex];
+		if (Shelf.Y >= MaxShelfY)
+		{
+			break;
+		}
+
+		if (Shelf.Height < AlignedSize.Y)
+		{
+			continue;
+		}
+
+		if (Shelf.IsEmpty())
+		{
+			if (BestEmptyShelf == INDEX_NONE || Shelf.Height < Shelves[BestEmptyShelf].Height)
+			{
+				BestEmptyShelf = ShelfIndex;
+			}
+			continue;
+		}
+
+		if (AtlasResolution - Shelf.UsedWidth < AlignedSize.X)
+		{
+			continue;
+		}
+
+		if (Shelf.Height <= MaxShelfHeight)
+		{
+			if (BestShelf == INDEX_NONE || Shelf.Height < Shelves[BestShelf].Height)
+			{
+				int32 SpanIndex = INDEX_NONE;
+				if (FindGapInShelf(Shelf, AlignedSize.X, SpanIndex) != INDEX_NONE)
+				{
+					BestShelf = ShelfIndex;
+				}
+			}
+		}
+		else if (FallbackShelf == INDEX_NONE)
+		{
+			FallbackShelf = ShelfIndex;
+		}
 	}
 
-	// allocate self
-	if (CurLevelNode.Size == TargetSize)
+	if (BestShelf != INDEX_NONE)
 	{
-		if (NodeAllocationInfo.IsEmpty)
+		return AllocateInShelf(BestShelf, AlignedSize, Owner);
+	}
+
+	// 2. reuse an empty shelf, split the remaining height into a new empty shelf
+	if (BestEmptyShelf != INDEX_NONE)
+	{
+		FShelf& Shelf = Shelves[BestEmptyShelf];
+		const int32 RemainHeight = Shelf.Height - AlignedSize.Y;
+		if (RemainHeight >= TileAlignment)
 		{
-			NodeAllocationInfo.IsEmpty = false;
-			NodeAllocationInfo.IsFull = true;
-			return CurLevelNode;
+			Shelf.Height = AlignedSize.Y;
+			Shelves.Insert(MakeShelf(Shelf.Y + AlignedSize.Y, RemainHeight), BestEmptyShelf + 1);
 		}
-		return INVALID_NODE;
+
+		return AllocateInShelf(BestEmptyShelf, AlignedSize, Owner);
+	}
+
+	// 3. open a new shelf on top
+	if (AllowNewShelf && NextShelfY + AlignedSize.Y <= AtlasResolution)
+	{
+		const int32 ShelfIndex = Shelves.Add(MakeShelf(NextShelfY, AlignedSize.Y));
+		NextShelfY += AlignedSize.Y;
+		return AllocateInShelf(ShelfIndex, AlignedSize, Owner);
 	}
 
-	// try allocate from childs
-	TArray<FStupidQuadTreeNode> ChildNodes = GetChildNodes(CurLevelNode);
-	for (FStupidQuadTreeNode& ChildNode : ChildNodes)
+	// 4. atlas is almost full, accept wasting height in a taller shelf
+	for (int32 ShelfIndex = FallbackShelf; ShelfIndex != INDEX_NONE && ShelfIndex < Shelves.Num(); ShelfIndex++)
 	{
-		FStupidQuadTreeNode Result = AllocateElementRecursive(ChildNode, TargetSize);
-		
-		// child allocate fail
-		if (!IsNodeValid(Result))
+		const FShelf& Shelf = Shelves[ShelfIndex];
+		if (Shelf.Y >= MaxShelfY)
+		{
+			break;
+		}
+
+		if (Shelf.IsEmpty() || Shelf.Height < AlignedSize.Y)
 		{
 			continue;
 		}
 
-		// if success, mark current node 's allocation flag
-		UpdateAllocationInfoFromChild(CurLevelNode);
-		return Result;
+		FGIAtlasTile Result = AllocateInShelf(ShelfIndex, AlignedSize, Owner);
+		if (Result.IsValid())
+		{
+			return Result;
+		}
 	}
 
-	return INVALID_NODE;
+	return FGIAtlasTile();
 }
 
-void FStupidQuadTreeAllocator::ReleaseElementRecursive(const FStupidQuadTreeNode& CurLevelNode, const FStupidQuadTreeNode& FreeNode)
+FGIAtlasTile FGIAtlasAllocator::AllocateElement(FIntPoint TargetSize, int32 Owner)
 {
-	FNodeAllocationInfo& NodeAllocationInfo = NodeAllocationInfos[CurLevelNode.Index];
-
-	// release self
-	if (FreeNode == CurLevelNode)
+	const FIntPoint AlignedSize = AlignTileSize(TargetSize);
+	if (AlignedSize.X > AtlasResolution || AlignedSize.Y > AtlasResolution)
 	{
-		check(NodeAllocationInfo.IsFull);
+		return FGIAtlasTile();
+	}
 
-		NodeAllocationInfo.IsEmpty = true;
-		NodeAllocationInfo.IsFull = false;
+	return AllocateInternal(AlignedSize, Owner, MAX_int32, true);
+}
+
+void FGIAtlasAllocator::ReleaseElement(const FGIAtlasTile& FreeTile)
+{
+	// invalid tile
+	if (!FreeTile.IsValid())
+	{
 		return;
 	}
 
-	// try release to childs
-	int32 ChildId = 0;
-	ChildId += (FreeNode.Center.X > CurLevelNode.Center.X) ? (0x01 << 0) : 0;	// left or right (爆了)
-	ChildId += (FreeNode.Center.Y > CurLevelNode.Center.Y) ? (0x01 << 1) : 0;	// top or bottom
+	const int32 ShelfIndex = FindShelf(FreeTile.Min.Y);
+	check(ShelfIndex != INDEX_NONE);
+
+	FShelf& Shelf = Shelves[ShelfIndex];
+	const int32 SpanIndex = Algo::LowerBoundBy(Shelf.Spans, FreeTile.Min.X, [](const FTileSpan& Span) { return Span.X; });
+	check(Shelf.Spans.IsValidIndex(SpanIndex) && Shelf.Spans[SpanIndex].X == FreeTile.Min.X);
+
+	const FTileSpan& Span = Shelf.Spans[SpanIndex];
+	check(Span.Width == FreeTile.Size.X && Span.Height == FreeTile.Size.Y);
+
+	AllocatedTexels -= Span.Width * Span.Height;
+	Shelf.UsedWidth -= Span.Width;
+	Shelf.Spans.RemoveAt(SpanIndex, 1, false);
+
+	if (Shelf.IsEmpty())
+	{
+		OnShelfEmpty(ShelfIndex);
+	}
+}
+
+void FGIAtlasAllocator::OnShelfEmpty(int32 ShelfIndex)
+{
+	// merge with empty neighbours, so a tall tile can reuse the space later
+	if (Shelves.IsValidIndex(ShelfIndex + 1) && Shelves[ShelfIndex + 1].IsEmpty())
+	{
+		Shelves[ShelfIndex].Height += Shelves[ShelfIndex + 1].Height;
+		RemoveShelf(ShelfIndex + 1);
+	}
+
+	if (Shelves.IsValidIndex(ShelfIndex - 1) && Shelves[ShelfIndex - 1].IsEmpty())
+	{
+		Shelves[ShelfIndex - 1].Height += Shelves[ShelfIndex].Height;
+		RemoveShelf(ShelfIndex);
+		ShelfIndex--;
+	}
+
+	// top shelf, give the space back
+	if (ShelfIndex == Shelves.Num() - 1)
+	{
+		NextShelfY = Shelves[ShelfIndex].Y;
+		RemoveShelf(ShelfIndex);
+	}
+}
 
-	TArray<FStupidQuadTreeNode> ChildNodes = GetChildNodes(CurLevelNode);
-	const FStupidQuadTreeNode& ChildNode = ChildNodes[ChildId];
+int32 FGIAtlasAllocator::Defragment(int32 MaxNumMoves, TArray<FGIAtlasMove>& OutMoves)
+{
+	if (MaxNumMoves <= 0)
+	{
+		return 0;
+	}
 
-	ReleaseElementRecursive(ChildNode, FreeNode);
+	// 1. pick the most sparse shelf, prefer higher one when occupancy is same
+	int32 SourceShelf = INDEX_NONE;
+	float MinOccupancy = SHELF_DEFRAG_OCCUPANCY;
+	for (int32 ShelfIndex = Shelves.Num() - 1; ShelfIndex >= 0; ShelfIndex--)
+	{
+		const FShelf& Shelf = Shelves[ShelfIndex];
+		if (Shelf.IsEmpty())
+		{
+			continue;
+		}
+
+		const float Occupancy = float(Shelf.UsedWidth) / float(AtlasResolution);
+		if (Occupancy < MinOccupancy)
+		{
+			MinOccupancy = Occupancy;
+			SourceShelf = ShelfIndex;
+		}
+	}
+
+	if (SourceShelf == INDEX_NONE)
+	{
+		return 0;
+	}
+
+	// 2. move tiles to lower shelves, from right to left so span index stay valid
+	const int32 SourceShelfY = Shelves[SourceShelf].Y;
+	int32 NumMoves = 0;
+	while (NumMoves < MaxNumMoves)
+	{
+		// shelf array may change after allocation (empty shelf split), find it again
+		SourceShelf = FindShelf(SourceShelfY);
+		if (SourceShelf == INDEX_NONE || Shelves[SourceShelf].IsEmpty())
+		{
+			break;
+		}
+
+		const FTileSpan Span = Shelves[SourceShelf].Spans.Last();
+		FGIAtlasMove Move;
+		Move.Owner = Span.Owner;
+		Move.Src.Min = FIntPoint(Span.X, SourceShelfY);
+		Move.Src.Size = FIntPoint(Span.Width, Span.Height);
+		Move.Dst = AllocateInternal(Move.Src.Size, Span.Owner, SourceShelfY, false);
+
+		if (!Move.Dst.IsValid())
+		{
+			break;
+		}
+
+		ReleaseElement(Move.Src);
+		OutMoves.Add(Move);
+		NumMoves++;
+	}
 
-	// update allocate flags
-	UpdateAllocationInfoFromChild(CurLevelNode);
+	return NumMoves;
 }
@@ -5,24 +5,22 @@
 #include "PrimitiveSceneInfo.h"
 #include <set>
 
+// dense slot allocator: slot ids are kept in a free list (LIFO, recently freed slot is reused first)
+// and a bit mask, so alloc / free is O(1) and no heap node is created per id
+// when no free slot left, capacity is doubled, caller should check GetMaxNumElements() and resize the data bind to slot
 template<typename KeyType>
-class FStupidLinearAllocator
+class FGISlotAllocator
 {
 public:
-	FStupidLinearAllocator() {};
+	FGISlotAllocator() {};
 
 	void Init(int32 NumElements)
 	{
-		if (MaxNumElements == 0)
+		// only grow, shrink would invalidate allocated slots
+		if (NumElements > MaxNumElements)
 		{
-			MaxNumElements = NumElements;
-			for (int32 i = 0; i < NumElements; i++)
-			{
-				UnusedElementIds.Enqueue(i);
-			}
+			Grow(NumElements);
 		}
-
-		// @TODO: change size
 	}
 
 	int32 ReleaseElement(const KeyType& KeyValue)
@@ -31,23 +29,31 @@ public:
 		bool RemoveSuccess = AllocatedElementIds.RemoveAndCopyValue(KeyValue, FreeId);
 		check(RemoveSuccess);
 
-		UnusedElementIds.Enqueue(FreeId);
+		AllocatedMask[FreeId] = false;
+		UnusedElementIds.Push(FreeId);
 		return FreeId;
 	}
 
 	int32 AllocateElement(const KeyType& KeyValue)
 	{
-		int32 Id = -1;
-		bool AllocateSuccess = UnusedElementIds.Dequeue(Id);
-		check(AllocateSuccess);
+		check(!AllocatedElementIds.Contains(KeyValue));
+
+		if (UnusedElementIds.Num() == 0)
+		{
+			Grow(FMath::Max(MaxNumElements * 2, MinNumElements));
+		}
+
+		int32 Id = UnusedElementIds.Pop(false);
+		AllocatedMask[Id] = true;
+		HighWaterMark = FMath::Max(HighWaterMark, Id + 1);
 
 		AllocatedElementIds.Add(KeyValue, Id);
 		return Id;
 	}
 
-	bool Find(const KeyType& KeyValue, int32& OutId)
+	bool Find(const KeyType& KeyValue, int32& OutId) const
 	{
-		int32* Id = AllocatedElementIds.Find(KeyValue);
+		const int32* Id = AllocatedElementIds.Find(KeyValue);
 		if (Id == nullptr)
 		{
 			return false;
@@ -57,83 +63,151 @@ public:
 		return true;
 	}
 
-	bool Find(const KeyType& KeyValue)
+	bool Find(const KeyType& KeyValue) const
 	{
-		int32 OutId = 0;
-		return Find(KeyValue, OutId);
+		return AllocatedElementIds.Contains(KeyValue);
 	}
 
-	int32 GetMaxNumElements() { return MaxNumElements; };
-	int32 GetAllocatedElementNums() { return AllocatedElementIds.Num(); };
-	TArray<int32> GetAllocatedElements()
+	bool IsAllocated(int32 Id) const
+	{
+		return Id >= 0 && Id < MaxNumElements && AllocatedMask[Id];
+	}
+
+	int32 GetMaxNumElements() const { return MaxNumElements; };
+	int32 GetAllocatedElementNums() const { return AllocatedElementIds.Num(); };
+
+	// all allocated slot id is less than this value, slot above it has never been used
+	int32 GetHighWaterMark() const { return HighWaterMark; };
+
+	// times of capacity change, caller can cache it to detect resize
+	uint32 GetGrowCount() const { return GrowCount; };
+
+	// slot id in ascending order
+	TArray<int32> GetAllocatedElements() const
 	{
 		TArray<int32> Result;
-		AllocatedElementIds.GenerateValueArray(Result);
+		Result.Reserve(AllocatedElementIds.Num());
+		for (TConstSetBitIterator<> It(AllocatedMask); It; ++It)
+		{
+			Result.Add(It.GetIndex());
+		}
 		return Result;
 	};
 
 protected:
-	TQueue<int32> UnusedElementIds;
+	void Grow(int32 NewMaxNumElements)
+	{
+		const int32 OldMaxNumElements = MaxNumElements;
+		MaxNumElements = NewMaxNumElements;
+		AllocatedMask.Add(false, NewMaxNumElements - OldMaxNumElements);
+		AllocatedElementIds.Reserve(NewMaxNumElements);
+
+		// push in reverse order so low id pop first, keep the slots dense
+		// new slots go to the bottom of stack, old free slots still pop before them
+		TArray<int32> NewUnusedElementIds;
+		NewUnusedElementIds.Reserve(NewMaxNumElements);
+		for (int32 i = NewMaxNumElements - 1; i >= OldMaxNumElements; i--)
+		{
+			NewUnusedElementIds.Add(i);
+		}
+		NewUnusedElementIds.Append(UnusedElementIds);
+		UnusedElementIds = MoveTemp(NewUnusedElementIds);
+
+		GrowCount++;
+	}
+
+	TArray<int32> UnusedElementIds;
+	TBitArray<> AllocatedMask;
 	TMap<KeyType, int32> AllocatedElementIds;
 	int32 MaxNumElements = 0;
-};
+	int32 HighWaterMark = 0;
+	uint32 GrowCount = 0;
 
-enum EStupidQuadTreeChild
-{
-	TC_TopLeft = 0,
-	TC_TopRight,
-	TC_BottomLeft,
-	TC_BottomRight,
-	Child_Num
+	static const int32 MinNumElements = 64;
 };
 
-struct FNodeAllocationInfo
+struct FGIAtlasTile
 {
-	FNodeAllocationInfo()
-		: IsEmpty(true)
-		, IsFull(false)
-	{
+	FIntPoint Min = { 0, 0 };
+	FIntPoint Size = { 0, 0 };
 
-	};
+	bool IsValid() const { return Size.X > 0 && Size.Y > 0; };
 
-	uint8 IsEmpty : 1;
-	uint8 IsFull : 1;
+	bool operator == (const FGIAtlasTile& Other) const
+	{
+		return Min == Other.Min && Size == Other.Size;
+	}
 };
 
-struct FStupidQuadTreeNode
+// a tile moved by defragmentation, caller need copy texels from Src to Dst
+struct FGIAtlasMove
 {
-	int32 Index = 0;
-	int32 Size = 0;
-	FIntPoint Min = { 0, 0 };
-	FIntPoint Max = { 0, 0 };
-	FIntPoint Center = { 0, 0 };
-
-	bool operator == (const FStupidQuadTreeNode& Other) const
-	{
-		return Min == Other.Min && Max == Other.Max;
-	}
+	int32 Owner = INDEX_NONE;
+	FGIAtlasTile Src;
+	FGIAtlasTile Dst;
 };
 
-class FStupidQuadTreeAllocator
+// shelf packing atlas allocator
+// atlas is split into horizontal shelves from bottom to top, each shelf hold tiles with similar height
+// tiles in a shelf are kept sorted by x, free space is the gap between tiles
+// span storage is reserved for the most tiles a shelf can hold and recycled with the shelf, so no heap allocation per operation once warmed up
+// supports rectangular tiles, every tile carries an owner id so defragmentation can report which tile moved
+class FGIAtlasAllocator
 {
 public:
-	FStupidQuadTreeAllocator() {};
+	FGIAtlasAllocator() {};
 
-	int32 GetMinNodeSize() { return MinNodeSize; };
-	int32 GetMaxNodeSize() { return MaxNodeSize; };
+	int32 GetMinTileSize() const { return MinTileSize; };
+	int32 GetMaxTileSize() const { return MaxTileSize; };
+	int32 GetAtlasResolution() const { return AtlasResolution; };
+	int32 GetAllocatedTexels() const { return AllocatedTexels; };
+	int32 GetNumShelves() const { return Shelves.Num(); };
 
 	void Init(int32 InAtlasResolution);
-	FStupidQuadTreeNode AllocateElement(int32 TargetSize);
-	void ReleaseElement(const FStupidQuadTreeNode& FreeNode);
+	FGIAtlasTile AllocateElement(FIntPoint TargetSize, int32 Owner);
+	void ReleaseElement(const FGIAtlasTile& FreeTile);
+
+	// move tiles out of the most sparse shelf into holes of lower shelves
+	// at most MaxNumMoves tiles are moved, moves are appended to OutMoves, return num of moves
+	int32 Defragment(int32 MaxNumMoves, TArray<FGIAtlasMove>& OutMoves);
 
 protected:
-	FStupidQuadTreeNode GetRootNode();
-	void UpdateAllocationInfoFromChild(const FStupidQuadTreeNode& ParentNode);
-	FStupidQuadTreeNode AllocateElementRecursive(const FStupidQuadTreeNode& CurLevelNode, int32 TargetSize);
-	void ReleaseElementRecursive(const FStupidQuadTreeNode& CurLevelNode, const FStupidQuadTreeNode& FreeNode);
+	struct FTileSpan
+	{
+		int32 X = 0;
+		int32 Width = 0;
+		int32 Height = 0;
+		int32 Owner = INDEX_NONE;
+	};
+
+	struct FShelf
+	{
+		int32 Y = 0;
+		int32 Height = 0;
+		int32 UsedWidth = 0;
+		TArray<FTileSpan> Spans;	// sorted by x
 
-	TArray<FNodeAllocationInfo> NodeAllocationInfos;
+		bool IsEmpty() const { return UsedWidth == 0; };
+	};
+
+	int32 GetMaxSpansPerShelf() const { return AtlasResolution / TileAlignment; };
+	FShelf MakeShelf(int32 Y, int32 Height);
+	void RemoveShelf(int32 ShelfIndex);
+
+	FIntPoint AlignTileSize(FIntPoint TargetSize) const;
+	int32 FindShelf(int32 Y) const;
+	int32 FindGapInShelf(const FShelf& Shelf, int32 Width, int32& OutSpanIndex) const;
+	FGIAtlasTile AllocateInShelf(int32 ShelfIndex, FIntPoint AlignedSize, int32 Owner);
+	FGIAtlasTile AllocateInternal(FIntPoint AlignedSize, int32 Owner, int32 MaxShelfY, bool AllowNewShelf);
+	void OnShelfEmpty(int32 ShelfIndex);
+
+	TArray<FShelf> Shelves;		// sorted by y, cover [0, NextShelfY) without gap
+	TArray<TArray<FTileSpan>> SpareSpans;	// span storage of removed shelves, reused by new ones
+	int32 NextShelfY = 0;
 	int32 AtlasResolution = 0;
-	const int32 MinNodeSize = 16;
-	const int32 MaxNodeSize = 128;
+	int32 AllocatedTexels = 0;
+
+	const int32 TileAlignment = 8;
+	const int32 MinTileSize = 16;
+	const int32 MaxTileSize = 128;
 };
@@ -1355,6 +1355,7 @@ public:
 	FRealtimeGIVoxelClipmap* RealtimeGIVoxelClipmap = nullptr;
 	FRealtimeGIRadianceCache* RealtimeGIRadianceCache = nullptr;
 	FRealtimeGIScreenGatherPipeline* RealtimeGIScreenGatherPipeline = nullptr;
+	bool bRealtimeGIClipmapOwner = false;	// first of the views sharing a clipmap, only it update clipmap and radiance cache
 
 #if RHI_RAYTRACING
 	TArray<FRayTracingGeometryInstance, SceneRenderingAllocator> RayTracingGeometryInstances;
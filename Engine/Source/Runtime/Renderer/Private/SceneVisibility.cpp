@@ -41,6 +41,7 @@
 #include "RectLightSceneProxy.h"
 #include "Math/Halton.h"
 #include "ProfilingDebugging/DiagnosticTable.h"
+#include "RealtimeGI/RealtimeGIGPUScene.h"
 
 /*------------------------------------------------------------------------------
 	Globals
@@ -4368,6 +4369,13 @@ bool FDeferredShadingSceneRenderer::InitViews(FRHICommandListImmediate& RHICmdLi
 
 	ComputeViewVisibility(RHICmdList, BasePassDepthStencilAccess, ViewCommandsPerView, DynamicIndexBufferForInitViews, DynamicVertexBufferForInitViews, DynamicReadBufferForInitViews);
 
+	// RealtimeGI scene bookkeeping read static meshes, kick it once they are updated above
+	// it runs in parallel with the rest of InitViews and is synced in RealtimeGISceneUpdate
+	if (RealtimeGIEnable())
+	{
+		RealtimeGIBeginSceneUpdate(Scene, Views);
+	}
+
 	RHICmdList.ImmediateFlush(EImmediateFlushType::DispatchToRHIThread);
 
 	// This has to happen before Scene->IndirectLightingCache.UpdateCache, since primitives in View.IndirectShadowPrimitives need ILC updates
@@ -0,0 +1,249 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "RealtimeGI/StupidAllocator.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRealtimeGISlotAllocatorTest, "System.Renderer.RealtimeGI.SlotAllocator", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRealtimeGISlotAllocatorTest::RunTest(const FString& Parameters)
+{
+	FGISlotAllocator<int32> Allocator;
+	Allocator.Init(4);
+	TestEqual(TEXT("Init capacity"), Allocator.GetMaxNumElements(), 4);
+
+	// slots are handed out dense, from low to high
+	for (int32 Key = 0; Key < 4; Key++)
+	{
+		TestEqual(TEXT("Dense allocation"), Allocator.AllocateElement(Key * 10), Key);
+	}
+	TestEqual(TEXT("Allocated num"), Allocator.GetAllocatedElementNums(), 4);
+	TestEqual(TEXT("No grow before full"), Allocator.GetGrowCount(), 1u);
+
+	// full, next allocation grows the capacity and keeps old slots
+	const int32 GrowId = Allocator.AllocateElement(40);
+	TestEqual(TEXT("Grow id"), GrowId, 4);
+	TestTrue(TEXT("Capacity grow"), Allocator.GetMaxNumElements() > 4);
+	TestEqual(TEXT("Grow count"), Allocator.GetGrowCount(), 2u);
+
+	int32 FoundId = -1;
+	TestTrue(TEXT("Find after grow"), Allocator.Find(20, FoundId) && FoundId == 2);
+	TestTrue(TEXT("IsAllocated after grow"), Allocator.IsAllocated(2));
+
+	// released slot is reused first
+	TestEqual(TEXT("Release"), Allocator.ReleaseElement(20), 2);
+	TestFalse(TEXT("Find released"), Allocator.Find(20));
+	TestFalse(TEXT("IsAllocated released"), Allocator.IsAllocated(2));
+	TestEqual(TEXT("Reuse released slot"), Allocator.AllocateElement(50), 2);
+
+	// allocated slots are reported in ascending order
+	TArray<int32> Allocated = Allocator.GetAllocatedElements();
+	TestEqual(TEXT("Allocated elements num"), Allocated.Num(), 5);
+	for (int32 i = 0; i < Allocated.Num(); i++)
+	{
+		TestEqual(TEXT("Allocated elements order"), Allocated[i], i);
+	}
+	TestEqual(TEXT("High water mark"), Allocator.GetHighWaterMark(), 5);
+
+	// random churn against a reference map
+	FRandomStream RandomStream(0x114514);
+	TMap<int32, int32> Reference;
+	TSet<int32> UsedIds;
+	for (int32 Step = 0; Step < 20000; Step++)
+	{
+		const int32 Key = 1000 + RandomStream.RandRange(0, 2047);
+		if (Reference.Contains(Key))
+		{
+			const int32 Id = Allocator.ReleaseElement(Key);
+			TestEqual(TEXT("Churn release id"), Id, Reference[Key]);
+			Reference.Remove(Key);
+			UsedIds.Remove(Id);
+		}
+		else
+		{
+			const int32 Id = Allocator.AllocateElement(Key);
+			if (UsedIds.Contains(Id))
+			{
+				AddError(FString::Printf(TEXT("Slot %d allocated twice"), Id));
+				return false;
+			}
+			Reference.Add(Key, Id);
+			UsedIds.Add(Id);
+		}
+	}
+
+	for (const TPair<int32, int32>& Pair : Reference)
+	{
+		int32 Id = -1;
+		TestTrue(TEXT("Churn find"), Allocator.Find(Pair.Key, Id) && Id == Pair.Value);
+		TestTrue(TEXT("Churn slot in range"), Id < Allocator.GetHighWaterMark() && Allocator.GetHighWaterMark() <= Allocator.GetMaxNumElements());
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRealtimeGISlotAllocatorPerfTest, "System.Renderer.RealtimeGI.SlotAllocatorPerf", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FRealtimeGISlotAllocatorPerfTest::RunTest(const FString& Parameters)
+{
+	const int32 NumLiveElements = 65536;
+	const int32 NumChurnOps = 1000000;
+
+	FGISlotAllocator<int32> Allocator;
+	Allocator.Init(1024);	// start small to include grow cost
+
+	TArray<int32> LiveKeys;
+	LiveKeys.Reserve(NumLiveElements);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	int32 NextKey = 0;
+	for (int32 i = 0; i < NumLiveElements; i++)
+	{
+		Allocator.AllocateElement(NextKey);
+		LiveKeys.Add(NextKey++);
+	}
+
+	const double FillTime = FPlatformTime::Seconds();
+
+	// 1M remove + add pairs, similar to primitives streaming in and out
+	FRandomStream RandomStream(0x114514);
+	for (int32 i = 0; i < NumChurnOps; i++)
+	{
+		const int32 Index = RandomStream.RandRange(0, LiveKeys.Num() - 1);
+		Allocator.ReleaseElement(LiveKeys[Index]);
+
+		Allocator.AllocateElement(NextKey);
+		LiveKeys[Index] = NextKey++;
+	}
+
+	const double EndTime = FPlatformTime::Seconds();
+
+	TestEqual(TEXT("Live elements"), Allocator.GetAllocatedElementNums(), NumLiveElements);
+	TestEqual(TEXT("Slots stay dense"), Allocator.GetHighWaterMark(), NumLiveElements);
+
+	AddInfo(FString::Printf(TEXT("Fill %d slots: %.2f ms, grow %u times"), NumLiveElements, (FillTime - StartTime) * 1000.0, Allocator.GetGrowCount()));
+	AddInfo(FString::Printf(TEXT("Churn %d remove/add: %.2f ms (%.1f ns per op)"), NumChurnOps, (EndTime - FillTime) * 1000.0, (EndTime - FillTime) * 1e9 / (NumChurnOps * 2)));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRealtimeGIAtlasAllocatorTest, "System.Renderer.RealtimeGI.AtlasAllocator", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRealtimeGIAtlasAllocatorTest::RunTest(const FString& Parameters)
+{
+	const int32 AtlasResolution = 256;
+
+	FGIAtlasAllocator Allocator;
+	Allocator.Init(AtlasResolution);
+
+	TMap<int32, FGIAtlasTile> Tiles;	// owner -> tile
+	auto IsOverlap = [](const FGIAtlasTile& A, const FGIAtlasTile& B)
+	{
+		return A.Min.X < B.Min.X + B.Size.X && B.Min.X < A.Min.X + A.Size.X &&
+			A.Min.Y < B.Min.Y + B.Size.Y && B.Min.Y < A.Min.Y + A.Size.Y;
+	};
+	auto ValidateTiles = [&]()
+	{
+		int32 NumTexels = 0;
+		for (const TPair<int32, FGIAtlasTile>& A : Tiles)
+		{
+			NumTexels += A.Value.Size.X * A.Value.Size.Y;
+			if (A.Value.Min.X < 0 || A.Value.Min.Y < 0 ||
+				A.Value.Min.X + A.Value.Size.X > AtlasResolution ||
+				A.Value.Min.Y + A.Value.Size.Y > AtlasResolution)
+			{
+				return false;
+			}
+
+			for (const TPair<int32, FGIAtlasTile>& B : Tiles)
+			{
+				if (A.Key != B.Key && IsOverlap(A.Value, B.Value))
+				{
+					return false;
+				}
+			}
+		}
+		return NumTexels == Allocator.GetAllocatedTexels();
+	};
+
+	// rectangular tiles are aligned, not squared
+	FGIAtlasTile Rect = Allocator.AllocateElement(FIntPoint(30, 12), 0);
+	TestTrue(TEXT("Rect tile valid"), Rect.IsValid());
+	TestEqual(TEXT("Rect tile size"), Rect.Size, FIntPoint(32, 16));
+	Tiles.Add(0, Rect);
+
+	// too big
+	TestFalse(TEXT("Oversize tile"), Allocator.AllocateElement(FIntPoint(AtlasResolution + 1, 8), 1).IsValid());
+
+	// fill the atlas with mixed size until full
+	FRandomStream RandomStream(0x1919);
+	int32 Owner = 1;
+	for (; Owner < 4096; Owner++)
+	{
+		const FIntPoint Size(RandomStream.RandRange(1, 8) * 8, RandomStream.RandRange(1, 8) * 8);
+		FGIAtlasTile Tile = Allocator.AllocateElement(Size, Owner);
+		if (!Tile.IsValid())
+		{
+			break;
+		}
+		Tiles.Add(Owner, Tile);
+	}
+	TestTrue(TEXT("Atlas get full"), Owner < 4096);
+	TestTrue(TEXT("No overlap after fill"), ValidateTiles());
+	TestTrue(TEXT("Reasonable occupancy"), Allocator.GetAllocatedTexels() > AtlasResolution * AtlasResolution / 3);
+
+	// free most tiles, leave sparse shelves behind
+	TArray<int32> Owners;
+	Tiles.GenerateKeyArray(Owners);
+	for (int32 i = 0; i < Owners.Num(); i++)
+	{
+		if (i % 4 != 0)
+		{
+			Allocator.ReleaseElement(Tiles[Owners[i]]);
+			Tiles.Remove(Owners[i]);
+		}
+	}
+	TestTrue(TEXT("No overlap after release"), ValidateTiles());
+
+	// defragment in bounded steps, apply moves like the gpu scene does
+	const int32 NumShelvesBefore = Allocator.GetNumShelves();
+	for (int32 Frame = 0; Frame < 256; Frame++)
+	{
+		TArray<FGIAtlasMove> Moves;
+		const int32 NumMoves = Allocator.Defragment(2, Moves);
+		TestTrue(TEXT("Bounded moves"), NumMoves <= 2 && NumMoves == Moves.Num());
+
+		for (const FGIAtlasMove& Move : Moves)
+		{
+			TestTrue(TEXT("Move source match"), Tiles.Contains(Move.Owner) && Tiles[Move.Owner] == Move.Src);
+			TestEqual(TEXT("Move keep size"), Move.Dst.Size, Move.Src.Size);
+			TestTrue(TEXT("Move to lower shelf"), Move.Dst.Min.Y < Move.Src.Min.Y);
+			Tiles[Move.Owner] = Move.Dst;
+		}
+
+		if (NumMoves == 0)
+		{
+			break;
+		}
+	}
+	TestTrue(TEXT("No overlap after defragment"), ValidateTiles());
+	TestTrue(TEXT("Defragment release shelves"), Allocator.GetNumShelves() <= NumShelvesBefore);
+
+	// release everything, atlas should be totally empty
+	for (const TPair<int32, FGIAtlasTile>& Pair : Tiles)
+	{
+		Allocator.ReleaseElement(Pair.Value);
+	}
+	TestEqual(TEXT("Empty texels"), Allocator.GetAllocatedTexels(), 0);
+	TestEqual(TEXT("Empty shelves"), Allocator.GetNumShelves(), 0);
+
+	// a full size tile fit again
+	TestTrue(TEXT("Full size tile after release"), Allocator.AllocateElement(FIntPoint(AtlasResolution, AtlasResolution), 0).IsValid());
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,112 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "RealtimeGI/RealtimeGICaptureScheduler.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRealtimeGICaptureSchedulerTest, "System.Renderer.RealtimeGI.CaptureScheduler", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRealtimeGICaptureSchedulerTest::RunTest(const FString& Parameters)
+{
+	const TArray<FVector> ViewOrigins = { FVector::ZeroVector };
+
+	FGICaptureBudget Budget;
+	Budget.MaxTexels = 64 * 64 * 6 * 4;
+	Budget.MaxDraws = 8;
+	Budget.AgeWeight = 0.1f;
+	Budget.FirstCaptureBoost = 4.0f;
+
+	auto MakeRequest = [](int32 Id, float Distance, uint32 RequestFrame, uint32 LastCaptureFrame)
+	{
+		FGICaptureRequest Request;
+		Request.Id = Id;
+		Request.BoundsOrigin = FVector(Distance, 0, 0);
+		Request.BoundsRadius = 100.0f;
+		Request.NumTexels = 64 * 64 * 6;
+		Request.NumDraws = 1;
+		Request.RequestFrame = RequestFrame;
+		Request.LastCaptureFrame = LastCaptureFrame;
+		return Request;
+	};
+
+	// nearer object first, never captured object beat recaptured one at same distance
+	{
+		TArray<FGICaptureRequest> Requests;
+		Requests.Add(MakeRequest(0, 10000.0f, 100, 50));
+		Requests.Add(MakeRequest(1, 1000.0f, 100, 50));
+		Requests.Add(MakeRequest(2, 10000.0f, 100, 0));
+
+		const TArray<int32> Selected = ScheduleCaptureRequests(Requests, ViewOrigins, Budget, 100);
+		TestEqual(TEXT("Select all within budget"), Selected.Num(), 3);
+		if (Selected.Num() == 3)
+		{
+			TestEqual(TEXT("Nearest first"), Selected[0], 1);
+			TestEqual(TEXT("First capture boost"), Selected[1], 2);
+			TestEqual(TEXT("Recapture last"), Selected[2], 0);
+		}
+	}
+
+	// texel budget and draw budget both limit the selection
+	{
+		TArray<FGICaptureRequest> Requests;
+		for (int32 Id = 0; Id < 16; Id++)
+		{
+			Requests.Add(MakeRequest(Id, 1000.0f + Id * 100.0f, 100, 0));
+		}
+
+		TArray<int32> Selected = ScheduleCaptureRequests(Requests, ViewOrigins, Budget, 100);
+		TestEqual(TEXT("Texel budget"), Selected.Num(), 4);
+
+		FGICaptureBudget DrawBudget = Budget;
+		DrawBudget.MaxTexels = MAX_int32;
+		DrawBudget.MaxDraws = 3;
+		Selected = ScheduleCaptureRequests(Requests, ViewOrigins, DrawBudget, 100);
+		TestEqual(TEXT("Draw budget"), Selected.Num(), 3);
+
+		// no overflow with unlimited budget
+		DrawBudget.MaxDraws = MAX_int32;
+		Selected = ScheduleCaptureRequests(Requests, ViewOrigins, DrawBudget, 100);
+		TestEqual(TEXT("Unlimited budget"), Selected.Num(), Requests.Num());
+	}
+
+	// request larger than budget is still accepted when it has the highest priority
+	{
+		TArray<FGICaptureRequest> Requests;
+		Requests.Add(MakeRequest(0, 500.0f, 100, 0));
+		Requests[0].NumTexels = Budget.MaxTexels * 2;
+		Requests.Add(MakeRequest(1, 5000.0f, 100, 0));
+
+		const TArray<int32> Selected = ScheduleCaptureRequests(Requests, ViewOrigins, Budget, 100);
+		TestTrue(TEXT("Huge request not starved"), Selected.Num() == 1 && Selected[0] == 0);
+	}
+
+	// a far request keeps aging until it wins over a steady stream of near ones
+	{
+		TArray<FGICaptureRequest> Requests;
+		Requests.Add(MakeRequest(0, 20000.0f, 0, 0));
+
+		FGICaptureBudget OneBudget = Budget;
+		OneBudget.MaxTexels = 64 * 64 * 6;
+
+		int32 CapturedFrame = INDEX_NONE;
+		for (uint32 Frame = 1; Frame < 10000; Frame++)
+		{
+			// new near object appear every frame
+			Requests.SetNum(1);
+			Requests.Add(MakeRequest(Frame, 1000.0f, Frame, 0));
+
+			const TArray<int32> Selected = ScheduleCaptureRequests(Requests, ViewOrigins, OneBudget, Frame);
+			TestEqual(TEXT("One capture per frame"), Selected.Num(), 1);
+			if (Selected.Num() > 0 && Selected[0] == 0)
+			{
+				CapturedFrame = Frame;
+				break;
+			}
+		}
+		TestTrue(TEXT("Far request not starved"), CapturedFrame != INDEX_NONE);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
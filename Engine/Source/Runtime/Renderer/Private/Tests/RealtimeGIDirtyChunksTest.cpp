@@ -0,0 +1,117 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "RealtimeGI/RealtimeGIDirtyChunks.h"
+#include "RealtimeGI/RealtimeGIShared.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RealtimeGIDirtyChunksTest
+{
+	class FTestDirtyChunks : public FRealtimeGIDirtyChunks
+	{
+	public:
+		void SetNextSequence(uint32 InNextSequence) { NextSequence = InNextSequence; }
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRealtimeGIDirtyChunksTest, "System.Renderer.RealtimeGI.DirtyChunks", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRealtimeGIDirtyChunksTest::RunTest(const FString& Parameters)
+{
+	using namespace RealtimeGIDirtyChunksTest;
+
+	const FIntVector NumChunksInXYZ(8, 8, 8);
+
+	auto MakeChunk = [](int32 Index1D, uint32 TimeStamp)
+	{
+		FUpdateChunk Chunk;
+		Chunk.Index1D = Index1D;
+		Chunk.TimeStamp = TimeStamp;
+		return Chunk;
+	};
+
+	// pop in the order of first mark, mark again doesn't change order or time stamp
+	{
+		FRealtimeGIDirtyChunks DirtyChunks;
+		DirtyChunks.Init(NumChunksInXYZ);
+		DirtyChunks.MarkDirty(MakeChunk(300, 1));
+		DirtyChunks.MarkDirty(MakeChunk(5, 1));
+		DirtyChunks.MarkDirty(MakeChunk(77, 1));
+		DirtyChunks.MarkDirty(MakeChunk(300, 2));
+		TestEqual(TEXT("Mark again is ignored"), DirtyChunks.GetNumDirtyChunks(), 3);
+
+		FUpdateChunk Chunk;
+		TestTrue(TEXT("Pop first"), DirtyChunks.PopOldest(Chunk) && Chunk.Index1D == 300 && Chunk.TimeStamp == 1);
+
+		// popped chunk go to the back when mark again
+		DirtyChunks.MarkDirty(MakeChunk(300, 3));
+
+		TArray<int32> Indices;
+		DirtyChunks.PopOldest(2, Indices);
+		TestTrue(TEXT("Pop oldest two"), Indices.Num() == 2 && Indices[0] == 5 && Indices[1] == 77);
+		TestTrue(TEXT("Pop rest"), DirtyChunks.PopOldest(Chunk) && Chunk.Index1D == 300 && Chunk.TimeStamp == 3);
+		TestFalse(TEXT("Empty"), DirtyChunks.HasDirtyChunks() || DirtyChunks.PopOldest(Chunk));
+	}
+
+	// scroll move index by -delta and wrap, order is kept
+	{
+		FRealtimeGIDirtyChunks DirtyChunks;
+		DirtyChunks.Init(NumChunksInXYZ);
+		DirtyChunks.MarkDirty(MakeChunk(Index3DTo1DLinear(FIntVector(0, 3, 7), NumChunksInXYZ), 1));
+		DirtyChunks.MarkDirty(MakeChunk(Index3DTo1DLinear(FIntVector(5, 0, 2), NumChunksInXYZ), 1));
+
+		DirtyChunks.Scroll(FIntVector(1, -1, 2));
+		DirtyChunks.MarkDirty(MakeChunk(Index3DTo1DLinear(FIntVector(1, 1, 1), NumChunksInXYZ), 2));
+		DirtyChunks.Scroll(FIntVector(-3, 0, 0));
+
+		TArray<int32> Indices;
+		DirtyChunks.PopOldest(8, Indices);
+		TestEqual(TEXT("Scroll num chunks"), Indices.Num(), 3);
+		if (Indices.Num() == 3)
+		{
+			TestEqual(TEXT("Scroll first"), Index1DTo3DLinear(Indices[0], NumChunksInXYZ), FIntVector(2, 4, 5));
+			TestEqual(TEXT("Scroll second"), Index1DTo3DLinear(Indices[1], NumChunksInXYZ), FIntVector(7, 1, 0));
+			TestEqual(TEXT("Scroll third"), Index1DTo3DLinear(Indices[2], NumChunksInXYZ), FIntVector(4, 1, 1));
+		}
+	}
+
+	// cleanup list only has chunks marked at the frame
+	{
+		FRealtimeGIDirtyChunks DirtyChunks;
+		DirtyChunks.Init(NumChunksInXYZ);
+		DirtyChunks.MarkDirty(MakeChunk(9, 1));
+		DirtyChunks.MarkDirty(MakeChunk(4, 2));
+		DirtyChunks.MarkDirty(MakeChunk(2, 2));
+		DirtyChunks.MarkDirty(MakeChunk(9, 2));
+		DirtyChunks.Scroll(FIntVector(0, 0, 1));
+
+		TArray<int32> Indices;
+		DirtyChunks.GetChunksWithTimeStamp(2, Indices);
+		const int32 ZStep = NumChunksInXYZ.X * NumChunksInXYZ.Y;
+		TestTrue(TEXT("Cleanup chunks"), Indices.Num() == 2 && Indices[0] == 2 + 7 * ZStep && Indices[1] == 4 + 7 * ZStep);
+	}
+
+	// sequence wrap around doesn't break order
+	{
+		FTestDirtyChunks DirtyChunks;
+		DirtyChunks.Init(FIntVector(2, 1, 1));
+		DirtyChunks.SetNextSequence(MAX_uint32 - 50);
+		for (uint32 i = 0; i < 100; i++)
+		{
+			DirtyChunks.MarkDirty(MakeChunk(i % 2, i));
+			DirtyChunks.MarkDirty(MakeChunk((i + 1) % 2, i));
+
+			FUpdateChunk Chunk;
+			DirtyChunks.PopOldest(Chunk);
+			if (Chunk.Index1D != int32(i % 2))
+			{
+				AddError(FString::Printf(TEXT("Wrong order at %u"), i));
+				break;
+			}
+		}
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
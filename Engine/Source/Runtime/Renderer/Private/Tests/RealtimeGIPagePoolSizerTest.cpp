@@ -0,0 +1,76 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "RealtimeGI/RealtimeGIPagePoolSizer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRealtimeGIPagePoolSizerTest, "System.Renderer.RealtimeGI.PagePoolSizer", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRealtimeGIPagePoolSizerTest::RunTest(const FString& Parameters)
+{
+	const int32 PagesPerSlice = 32 * 32;
+
+	auto MakeStats = [PagesPerSlice](int32 NumSlices, int32 NumUsedPages, int32 NumRequestedPages)
+	{
+		FVoxelPageStats Stats;
+		Stats.NumUsedPages = NumUsedPages;
+		Stats.NumRequestedPages = NumRequestedPages;
+		Stats.NumPages = NumSlices * PagesPerSlice;
+		return Stats;
+	};
+
+	// half full pool stay the same
+	{
+		FRealtimeGIPagePoolSizer Sizer;
+		Sizer.SetLimits(PagesPerSlice, 4, 64);
+		TestEqual(TEXT("Stable size"), Sizer.Update(8, MakeStats(8, 4 * PagesPerSlice, 4 * PagesPerSlice)), 8);
+	}
+
+	// overflow grow enough to fit all requests, but never over max
+	{
+		FRealtimeGIPagePoolSizer Sizer;
+		Sizer.SetLimits(PagesPerSlice, 4, 64);
+		TestEqual(TEXT("Grow by half"), Sizer.Update(8, MakeStats(8, 8 * PagesPerSlice, 8 * PagesPerSlice)), 12);
+
+		const int32 Wanted = Sizer.Update(8, MakeStats(8, 8 * PagesPerSlice, 30 * PagesPerSlice));
+		TestTrue(TEXT("Grow to fit requests"), Wanted * PagesPerSlice * Sizer.GrowThreshold >= 30 * PagesPerSlice);
+		TestEqual(TEXT("Grow clamp to max"), Sizer.Update(8, MakeStats(8, 8 * PagesPerSlice, 100 * PagesPerSlice)), 64);
+	}
+
+	// shrink only after low occupancy last long enough, and never below min
+	{
+		FRealtimeGIPagePoolSizer Sizer;
+		Sizer.SetLimits(PagesPerSlice, 4, 64);
+		Sizer.ShrinkDelay = 3;
+
+		const FVoxelPageStats LowStats = MakeStats(32, 2 * PagesPerSlice, 2 * PagesPerSlice);
+		TestEqual(TEXT("No shrink before delay 0"), Sizer.Update(32, LowStats), 32);
+		TestEqual(TEXT("No shrink before delay 1"), Sizer.Update(32, LowStats), 32);
+
+		// a busy update in between restart the count
+		TestEqual(TEXT("Busy update"), Sizer.Update(32, MakeStats(32, 16 * PagesPerSlice, 16 * PagesPerSlice)), 32);
+		TestEqual(TEXT("Delay restart 0"), Sizer.Update(32, LowStats), 32);
+		TestEqual(TEXT("Delay restart 1"), Sizer.Update(32, LowStats), 32);
+		TestEqual(TEXT("Shrink to half occupied"), Sizer.Update(32, LowStats), 4);
+
+		const FVoxelPageStats EmptyStats = MakeStats(8, 0, 0);
+		Sizer.Update(8, EmptyStats);
+		Sizer.Update(8, EmptyStats);
+		TestEqual(TEXT("Shrink clamp to min"), Sizer.Update(8, EmptyStats), 4);
+	}
+
+	// shrink is off by default
+	{
+		FRealtimeGIPagePoolSizer Sizer;
+		Sizer.SetLimits(PagesPerSlice, 4, 64);
+		for (int32 i = 0; i < 100; i++)
+		{
+			Sizer.Update(32, MakeStats(32, 0, 0));
+		}
+		TestEqual(TEXT("Never shrink"), Sizer.Update(32, MakeStats(32, 0, 0)), 32);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
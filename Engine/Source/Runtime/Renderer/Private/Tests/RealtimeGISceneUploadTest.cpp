@@ -0,0 +1,87 @@
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "RealtimeGI/RealtimeGISceneUpload.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRealtimeGICompactIndexMapTest, "System.Renderer.RealtimeGI.CompactIndexMap", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRealtimeGICompactIndexMapTest::RunTest(const FString& Parameters)
+{
+	// remove swap the last one into the hole, only the hole is dirty
+	{
+		FRealtimeGICompactIndexMap CompactIds;
+		CompactIds.Add(3);
+		CompactIds.Add(7);
+		CompactIds.Add(1);
+		CompactIds.Add(9);
+
+		TArray<int32> DirtyIndices;
+		CompactIds.PopDirtyIndices(DirtyIndices);
+		TestEqual(TEXT("Added slots are dirty"), DirtyIndices.Num(), 4);
+
+		CompactIds.Remove(7);
+		CompactIds.PopDirtyIndices(DirtyIndices);
+		TestTrue(TEXT("Hole is filled by last"), CompactIds.Num() == 3 && CompactIds.GetId(1) == 9 && CompactIds.GetCompactIndex(9) == 1);
+		TestTrue(TEXT("Only hole is dirty"), DirtyIndices.Num() == 1 && DirtyIndices[0] == 1);
+
+		CompactIds.Remove(1);
+		CompactIds.MarkDirty(3);
+		CompactIds.MarkDirty(3);
+		CompactIds.PopDirtyIndices(DirtyIndices);
+		TestTrue(TEXT("Remove last move nothing"), CompactIds.Num() == 2 && CompactIds.GetCompactIndex(1) == INDEX_NONE);
+		TestTrue(TEXT("Mark twice upload once"), DirtyIndices.Num() == 1 && DirtyIndices[0] == 0);
+	}
+
+	// gpu copy of dirty slots always match the cpu array
+	{
+		FRandomStream RandomStream(0x5EED);
+		FRealtimeGICompactIndexMap CompactIds;
+		TArray<int32> GPUCompactIds;
+		TSet<int32> LivingIds;
+
+		for (int32 Frame = 0; Frame < 200; Frame++)
+		{
+			const int32 NumOps = RandomStream.RandRange(0, 16);
+			for (int32 Op = 0; Op < NumOps; Op++)
+			{
+				const int32 Id = RandomStream.RandRange(0, 255);
+				if (LivingIds.Contains(Id))
+				{
+					CompactIds.Remove(Id);
+					LivingIds.Remove(Id);
+				}
+				else
+				{
+					CompactIds.Add(Id);
+					LivingIds.Add(Id);
+				}
+			}
+
+			TArray<int32> DirtyIndices;
+			CompactIds.PopDirtyIndices(DirtyIndices);
+			GPUCompactIds.SetNum(FMath::Max(GPUCompactIds.Num(), CompactIds.Num()));
+			for (int32 CompactIndex : DirtyIndices)
+			{
+				GPUCompactIds[CompactIndex] = CompactIds.GetId(CompactIndex);
+			}
+
+			TSet<int32> GPUIds;
+			for (int32 CompactIndex = 0; CompactIndex < CompactIds.Num(); CompactIndex++)
+			{
+				GPUIds.Add(GPUCompactIds[CompactIndex]);
+			}
+
+			if (CompactIds.Num() != LivingIds.Num() || GPUIds.Num() != LivingIds.Num() || GPUIds.Difference(LivingIds).Num() > 0)
+			{
+				AddError(FString::Printf(TEXT("Compact array mismatch at frame %d"), Frame));
+				break;
+			}
+		}
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
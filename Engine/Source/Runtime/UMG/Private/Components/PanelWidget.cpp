@@ -136,8 +136,10 @@ UPanelSlot* UPanelWidget::AddChild(UWidget* Content)
 	PanelSlot->Parent = this;
 
 	Content->Slot = PanelSlot;
+	GCWriteBarrier(Content, PanelSlot);
 
 	Slots.Add(PanelSlot);
+	GCWriteBarrier(this, PanelSlot);
 
 	OnSlotAdded(PanelSlot);
 